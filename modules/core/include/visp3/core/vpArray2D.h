@@ -258,8 +258,21 @@ public:
   }
 
 #if ((__cplusplus >= 201103L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 201103L))) // Check if cxx11 or higher
-  vpArray2D(vpArray2D<Type> &&A) noexcept
+  vpArray2D(vpArray2D<Type> &&A)
   {
+    if (A.hasInlineStorage()) {
+      // The elements of A live in A itself, they cannot be taken over and are copied into a new allocation
+      data = nullptr;
+      rowNum = 0;
+      colNum = 0;
+      rowPtrs = nullptr;
+      dsize = 0;
+      isMemoryOwner = true;
+      isRowPtrsOwner = true;
+      resize(A.rowNum, A.colNum, false, false);
+      std::copy(A.data, A.data + dsize, data);
+      return;
+    }
     rowNum = A.rowNum;
     colNum = A.colNum;
     rowPtrs = A.rowPtrs;
@@ -631,8 +644,12 @@ public:
   }
 
 #if ((__cplusplus >= 201103L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 201103L))) // Check if cxx11 or higher
-  vpArray2D<Type> &operator=(vpArray2D<Type> &&other) noexcept
+  vpArray2D<Type> &operator=(vpArray2D<Type> &&other)
   {
+    if (hasInlineStorage() || other.hasInlineStorage()) {
+      // Inline storage can neither be taken over nor replaced, copy the elements
+      return *this = static_cast<const vpArray2D<Type> &>(other);
+    }
     if (this != &other) {
       if (isMemoryOwner && data) {
         free(data);
@@ -1199,6 +1216,12 @@ public:
   }
 
 protected:
+  /*!
+   * Return true when the elements are stored in the object itself rather than on the heap or in the memory of
+   * another array. Such an array cannot give its memory away when moved.
+   */
+  virtual bool hasInlineStorage() const { return false; }
+
   //! Number of rows in the array
   unsigned int rowNum;
   //! Number of columns in the array
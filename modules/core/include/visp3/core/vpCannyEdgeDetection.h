@@ -47,6 +47,7 @@
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageFilter.h>
 #include <visp3/core/vpRGBa.h>
+#include <visp3/core/vpTime.h>
 
 // 3rd parties include
 #ifdef VISP_HAVE_NLOHMANN_JSON
@@ -59,9 +60,12 @@ BEGIN_VISP_NAMESPACE
  * It is possible to use a boolean mask to ignore some pixels of
  * the input gray-scale image.
  *
- * \warning If the stack size is not sufficient, a SEGFAULT can occur on some images which
- * are really over-exposed.
- * \note The maximum stack on MacOS seems to be 65532000 bytes, see https://stackoverflow.com/a/13261334
+ * The edge thinning, hysteresis thresholding and edge tracking steps process the image by horizontal stripes,
+ * one per thread. The edge tracking is an explicit-stack flood fill of the weak edge points 8-connected to a strong
+ * edge point, first within each stripe and then across the stripe borders, so that its memory footprint does not
+ * depend on the length of the edges. The computation time of each step of the last detection is available using
+ * getFilteringAndGradientTime(), getThresholdsComputationTime(), getEdgeThinningTime(),
+ * getHysteresisThresholdingTime() and getEdgeTrackingTime().
 */
 class VISP_EXPORT vpCannyEdgeDetection
 {
@@ -169,8 +173,6 @@ public:
   /**
    * \brief Detect the edges in an image.
    * Convert the color image into a gray-scale image.
-   * \warning If the stack size is not sufficient, a SEGFAULT can occur on some images which
-   * are really over-exposed.
    *
    * \param[in] I_color : An RGB image, in ViSP format.
    * \return vpImage<unsigned char> 255 means an edge, 0 means not an edge.
@@ -182,14 +184,17 @@ public:
   vpImage<unsigned char> detect(const vpImage<vpHSV<ArithmeticType, useFullScale>> &Ihsv)
   {
     // // Step 1 and 2: filter the image and compute the gradient, if not given by the user
+    double t = vpTime::measureTimeMs();
     if (!m_areGradientAvailable) {
       vpImage<vpHSV<ArithmeticType, useFullScale>> Iblur;
       vpImageFilter::gaussianBlur(Ihsv, Iblur, static_cast<unsigned int>(m_gaussianKernelSize), m_gaussianStdev, true, mp_mask);
       vpImageFilter::gradientFilter(Iblur, m_dIx, m_dIy, m_nbThread, mp_mask, m_filteringAndGradientType);
     }
     m_areGradientAvailable = false; // Reset for next call
+    m_filteringAndGradientTime = vpTime::measureTimeMs() - t;
 
     // // Step 3: edge thining
+    t = vpTime::measureTimeMs();
     float upperThreshold = m_upperThreshold;
     float lowerThreshold = m_lowerThreshold;
     if (upperThreshold < 0) {
@@ -203,6 +208,7 @@ public:
     }
     // To ensure that if lowerThreshold = 0, we reject null gradient points
     lowerThreshold = std::max<float>(lowerThreshold, std::numeric_limits<float>::epsilon());
+    m_thresholdsComputationTime = vpTime::measureTimeMs() - t;
 
     step3to5(Ihsv.getHeight(), Ihsv.getWidth(), lowerThreshold, upperThreshold);
     return m_edgeMap;
@@ -211,8 +217,6 @@ public:
 
   /**
    * \brief Detect the edges in a gray-scale image.
-   * \warning If the stack size is not sufficient, a SEGFAULT can occur on some images which
-   * are really over-exposed.
    *
    * \param[in] I : A gray-scale image, in ViSP format.
    * \return vpImage<unsigned char> 255 means an edge, 0 means not an edge.
@@ -323,17 +327,10 @@ public:
   }
 
   /**
-   * \brief Set the minimum stack size, expressed in bytes, due to the recursive algorithm.
-   * If not called, the stack size is left at its default value when running the
-   * Canny edge detection algorithm.
+   * \brief Set the minimum stack size, expressed in bytes.
    *
-   * \note The stack size is changed back to its original value after
-   * before leaving the detect() function.
-   * \note On Windows, the minimum stack size is defined at compilation time
-   * and cannot be changed during runtime.
-   * \note The maximum stack on MacOS seems to be 65532000 bytes, see https://stackoverflow.com/a/13261334
-   * \warning If the stack size is not sufficient, a SEGFAULT can occur on some images which
-   * are really over-exposed.
+   * \note Kept for backward compatibility: the edge tracking step is no longer recursive and
+   * the stack size is not modified by the detect() functions anymore.
    *
    * \param[in] requiredStackSize The required stack size, in bytes.
    */
@@ -396,10 +393,9 @@ public:
   }
 
   /**
-   * \brief Get the minimum stack size used by the algorithm.
+   * \brief Get the minimum stack size set by setMinimumStackSize().
    *
-   * \note On Windows, the minimum stack size is defined at compilation time
-   * and cannot be changed during runtime.
+   * \note Kept for backward compatibility, the algorithm does not depend on the stack size anymore.
    *
    * \return rlim_t The minimum stack size.
    */
@@ -446,16 +442,77 @@ public:
     return m_edgeMap;
   }
 
+  /**
+   * \brief Get the time spent by the last detection to filter the image and compute its gradients.
+   *
+   * \return The computation time in milliseconds, 0 when the gradients were given using setGradients().
+   */
+  inline double getFilteringAndGradientTime() const
+  {
+    return m_filteringAndGradientTime;
+  }
+
+  /**
+   * \brief Get the time spent by the last detection to compute the hysteresis thresholds.
+   *
+   * \return The computation time in milliseconds, close to 0 when the thresholds are set by the user.
+   */
+  inline double getThresholdsComputationTime() const
+  {
+    return m_thresholdsComputationTime;
+  }
+
+  /**
+   * \brief Get the time spent by the last detection in the edge thinning step.
+   *
+   * \return The computation time in milliseconds.
+   */
+  inline double getEdgeThinningTime() const
+  {
+    return m_edgeThinningTime;
+  }
+
+  /**
+   * \brief Get the time spent by the last detection in the hysteresis thresholding step.
+   *
+   * \return The computation time in milliseconds.
+   */
+  inline double getHysteresisThresholdingTime() const
+  {
+    return m_hysteresisThresholdingTime;
+  }
+
+  /**
+   * \brief Get the time spent by the last detection in the edge tracking step.
+   *
+   * \return The computation time in milliseconds.
+   */
+  inline double getEdgeTrackingTime() const
+  {
+    return m_edgeTrackingTime;
+  }
   //@}
 private:
   typedef enum EdgeType
   {
     STRONG_EDGE, /*!< This pixel exceeds the upper threshold of the double hysteresis phase, it is thus for sure an edge point.*/
     WEAK_EDGE,/*!< This pixel is between the lower and upper threshold of the double hysteresis phase, it is an edge point only if it is linked at some point to an edge point.*/
-    ON_CHECK, /*!< This pixel is currently tested to know if it is linked to a strong edge point.*/
     NOT_EDGE /*!< This pixel is surely not an edge.*/
   } EdgeType;
 
+  /**
+   * \brief Edge candidates of a horizontal stripe of the image, stored as a structure of arrays.
+   * The buffers keep their capacity from one detection to the next.
+   */
+  typedef struct vpEdgeCandidatesStripe
+  {
+    unsigned int m_rowStart; /*!< First row of the stripe.*/
+    unsigned int m_rowEnd; /*!< Row following the last row of the stripe.*/
+    std::vector<unsigned int> m_indices; /*!< Bitmap indices of the edge candidates, in raster order.*/
+    std::vector<float> m_gradients; /*!< Manhattan gradient of the edge candidates.*/
+    std::vector<unsigned int> m_stack; /*!< Explicit stack of the edge tracking.*/
+  } vpEdgeCandidatesStripe;
+
   // Filtering + gradient methods choice
   vpImageFilter::vpCannyFilteringAndGradientType m_filteringAndGradientType; /*!< Choice of the filter and
       gradient operator to apply before the edge detection step*/
@@ -476,7 +533,7 @@ private:
   vpImage<float> m_dIy; /*!< Y-axis gradient.*/
 
   // // Edge thining attributes
-  std::vector<std::pair<unsigned int, float> > m_edgeCandidateAndGradient; /*!< Map that contains point image coordinates and corresponding gradient value.*/
+  std::vector<vpEdgeCandidatesStripe> m_edgeCandidates; /*!< Edge candidates and corresponding gradient values, one set per stripe of the image.*/
 
   // // Hysteresis thresholding attributes
   float m_lowerThreshold; /*!< Lower threshold for the hysteresis step. If negative, it will be deduced
@@ -489,16 +546,22 @@ private:
 
   // // Edge tracking attributes
 #if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
-  rlim_t m_minStackSize; /*!< Minimum stack size, due to the recursivity used in this step of the algorithm.*/
+  rlim_t m_minStackSize; /*!< Minimum stack size, kept for backward compatibility.*/
 #endif
   bool m_storeListEdgePoints; /*!< If true, the vector \b m_edgePointsList will contain the list of the edge points resulting from the whole algorithm.*/
-  std::vector<unsigned int> m_activeEdgeCandidates; /*!< Vector that contains only the IDs of the edge candidates.*/
-  vpImage<EdgeType> m_edgePointsCandidates; /*!< Map that contains the strong edge points, i.e. the points for which we know for sure they are edge points,
+  vpImage<unsigned char> m_edgePointsCandidates; /*!< EdgeType map that contains the strong edge points, i.e. the points for which we know for sure they are edge points,
                                                 and the weak edge points, i.e. the points for which we still must determine if they are actual edge points.*/
   vpImage<unsigned char> m_edgeMap; /*!< Final edge map that results from the whole Canny algorithm.*/
   std::vector<vpImagePoint> m_edgePointsList; /*!< List of the edge points that belong to the final edge map.*/
   const vpImage<bool> *mp_mask; /*!< Mask that permits to consider only the pixels for which the mask is true.*/
 
+  // // Computation times of the last detection, in ms
+  double m_filteringAndGradientTime; /*!< Time spent filtering the image and computing its gradients.*/
+  double m_thresholdsComputationTime; /*!< Time spent computing the hysteresis thresholds.*/
+  double m_edgeThinningTime; /*!< Time spent in the edge thinning step.*/
+  double m_hysteresisThresholdingTime; /*!< Time spent in the hysteresis thresholding step.*/
+  double m_edgeTrackingTime; /*!< Time spent in the edge tracking step.*/
+
   float getGradientOrientation(const vpImage<float> &dIx, const vpImage<float> &dIy, const int &iter);
 
   void getInterpolWeightsAndOffsets(const float &gradientOrientation, float &alpha, float &beta, const int &nbCols,
@@ -550,10 +613,10 @@ private:
 
   /**
    * \brief Perform hysteresis thresholding.
-   * \details Edge candidates that are greater than \b m_upperThreshold are saved in \b m_strongEdgePoints
+   * \details Edge candidates that are greater than \b m_upperThreshold are marked as strong edges
    * and will be kept in the final edge map.
-   * Edge candidates that are between \b m_lowerThreshold and \b m_upperThreshold are saved in
-   * \b m_weakEdgePoints and will be kept in the final edge map only if they are connected
+   * Edge candidates that are between \b m_lowerThreshold and \b m_upperThreshold are marked as
+   * weak edges and will be kept in the final edge map only if they are connected
    * to a strong edge point.
    * Edge candidates that are below \b m_lowerThreshold are discarded.
    * \param[in] lowerThreshold Edge candidates that are below this threshold are definitely not
@@ -564,19 +627,21 @@ private:
   void performHysteresisThresholding(const float &lowerThreshold, const float &upperThreshold);
 
   /**
-   * \brief Search recursively for a strong edge in the neighborhood of a weak edge.
+   * \brief Promote to strong edges the weak edges 8-connected to the strong edges of the stack.
+   * \details The promoted points are pushed on the stack, which is empty when the method returns.
    *
-   * \param[in] coordinates : The coordinates we are checking.
-   * \return true We found a strong edge point in its 8-connected neighborhood.
-   * \return false We did not found a strong edge point in its 8-connected neighborhood.
+   * \param[inout] stack : The strong edge points from which the weak edges are searched.
+   * \param[in] rowStart : First row in which the weak edges are searched.
+   * \param[in] rowEnd : Row following the last row in which the weak edges are searched.
    */
-  bool recursiveSearchForStrongEdge(const unsigned int &coordinates);
+  void propagateStrongEdges(std::vector<unsigned int> &stack, const unsigned int &rowStart, const unsigned int &rowEnd);
 
   /**
    * \brief Perform edge tracking.
-   * \details For each weak edge, we will recursively check if they are 8-connected to a strong edge point.
-   * If so, the weak edge will be saved in \b m_strongEdgePoints and will be kept in the final edge map.
-   * Otherwise, the edge point will be discarded.
+   * \details The weak edges 8-connected to a strong edge point, directly or through other weak edges, become strong
+   * edges and are kept in the final edge map. Otherwise, the edge point will be discarded.
+   * The propagation is first performed in parallel within each stripe, then from the strong edges lying
+   * on both sides of the stripe borders.
    */
   void performEdgeTracking();
   //@}
@@ -0,0 +1,128 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * 2D array with a compile-time size stored in the object itself.
+ */
+
+/*!
+ * \file vpFixedSizeArray2D.h
+ * \brief 2D array with a compile-time size that does not use the heap.
+ */
+
+#ifndef VP_FIXED_SIZE_ARRAY2D_H
+#define VP_FIXED_SIZE_ARRAY2D_H
+
+#include <algorithm>
+
+#include <visp3/core/vpArray2D.h>
+#include <visp3/core/vpConfig.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpFixedSizeArray2D
+ * \ingroup group_core_matrices
+ *
+ * \brief 2D array of \e NbRows by \e NbCols elements whose data and row pointers are stored in the object itself
+ * rather than on the heap.
+ *
+ * This class is used as base class by the small transformation matrices (vpRotationMatrix, vpHomogeneousMatrix,
+ * vpVelocityTwistMatrix, vpForceTwistMatrix) whose size never changes. Constructing, copying or destroying such a
+ * matrix never allocates memory, which makes pose chains computed in a control or a tracking loop allocation-free.
+ *
+ * The array is seen by vpArray2D as a view on memory it does not own: it cannot be resized to another size, and
+ * copying or moving it, even through a vpArray2D rvalue reference, always copies the elements.
+ */
+template <class Type, unsigned int NbRows, unsigned int NbCols> class vpFixedSizeArray2D : public vpArray2D<Type>
+{
+public:
+  //! Number of rows known at compile time.
+  static constexpr unsigned int fixedRows = NbRows;
+  //! Number of columns known at compile time.
+  static constexpr unsigned int fixedCols = NbCols;
+  //! Number of elements known at compile time.
+  static constexpr unsigned int fixedSize = NbRows * NbCols;
+
+  /*!
+   * Create a \e NbRows by \e NbCols array whose elements are set to zero.
+   */
+  vpFixedSizeArray2D() : vpArray2D<Type>()
+  {
+    attachStorage();
+    std::fill(m_storage, m_storage + fixedSize, Type());
+  }
+
+  /*!
+   * Copy constructor. The elements are copied in the storage of the new array.
+   */
+  vpFixedSizeArray2D(const vpFixedSizeArray2D<Type, NbRows, NbCols> &A) : vpArray2D<Type>()
+  {
+    attachStorage();
+    std::copy(A.m_storage, A.m_storage + fixedSize, m_storage);
+  }
+
+  /*!
+   * Copy operator. Since both arrays have the same size, the elements are simply copied.
+   */
+  vpFixedSizeArray2D<Type, NbRows, NbCols> &operator=(const vpFixedSizeArray2D<Type, NbRows, NbCols> &A)
+  {
+    std::copy(A.m_storage, A.m_storage + fixedSize, m_storage);
+    return *this;
+  }
+
+  virtual ~vpFixedSizeArray2D()
+  {
+    // The storage is released with the object, make sure vpArray2D does not try to free it
+    this->data = nullptr;
+    this->rowPtrs = nullptr;
+  }
+
+protected:
+  bool hasInlineStorage() const VP_OVERRIDE { return true; }
+
+private:
+  void attachStorage()
+  {
+    for (unsigned int i = 0; i < NbRows; ++i) {
+      m_rowPtrs[i] = m_storage + (i * NbCols);
+    }
+    this->data = m_storage;
+    this->rowPtrs = m_rowPtrs;
+    this->rowNum = NbRows;
+    this->colNum = NbCols;
+    this->dsize = fixedSize;
+    this->isMemoryOwner = false;
+    this->isRowPtrsOwner = false;
+  }
+
+  Type m_storage[NbRows * NbCols];
+  Type *m_rowPtrs[NbRows];
+};
+END_VISP_NAMESPACE
+#endif
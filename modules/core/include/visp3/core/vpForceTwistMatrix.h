@@ -43,6 +43,7 @@ END_VISP_NAMESPACE
 
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpArray2D.h>
+#include <visp3/core/vpFixedSizeArray2D.h>
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <visp3/core/vpRotationMatrix.h>
@@ -178,7 +179,7 @@ BEGIN_VISP_NAMESPACE
   }
   \endcode
 */
-class VISP_EXPORT vpForceTwistMatrix : public vpArray2D<double>
+class VISP_EXPORT vpForceTwistMatrix : public vpFixedSizeArray2D<double, 6, 6>
 {
 public:
   // basic constructor
@@ -230,8 +231,6 @@ public:
     throw(vpException(vpException::fatalError, "Cannot resize a velocity twist matrix"));
   }
 
-private:
-  static const unsigned int constr_value_6;
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
   /*!
     @name Deprecated functions
@@ -58,6 +58,7 @@ class vpPoint;
 END_VISP_NAMESPACE
 
 #include <visp3/core/vpArray2D.h>
+#include <visp3/core/vpFixedSizeArray2D.h>
 #include <visp3/core/vpRotationMatrix.h>
 #include <visp3/core/vpThetaUVector.h>
 #include <visp3/core/vpPoseVector.h>
@@ -217,7 +218,7 @@ BEGIN_VISP_NAMESPACE
   {"cols":4,"data":[0.0,0.0,-1.0,0.1,0.0,-1.0,0.0,0.2,-1.0,0.0,0.0,0.3,0.0,0.0,0.0,1.0],"rows":4,"type":"vpHomogeneousMatrix"}
   \endcode
 */
-class VISP_EXPORT vpHomogeneousMatrix : public vpArray2D<double>
+class VISP_EXPORT vpHomogeneousMatrix : public vpFixedSizeArray2D<double, 4, 4>
 {
 public:
   vpHomogeneousMatrix();
@@ -434,8 +435,6 @@ public:
 
 protected:
   unsigned int m_index;
-private:
-  static const unsigned int constr_value_4;
 };
 
 #ifdef VISP_HAVE_NLOHMANN_JSON
@@ -42,6 +42,7 @@
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpEndian.h>
 #include <visp3/core/vpException.h>
+#include <visp3/core/vpImageAllocator.h>
 #include <visp3/core/vpImageException.h>
 #include <visp3/core/vpImagePoint.h>
 #include <visp3/core/vpRGBa.h>
@@ -55,7 +56,11 @@
 #include <iomanip> // std::setw
 #include <iostream>
 #include <math.h>
+#include <new>
 #include <string.h>
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <type_traits>
+#endif
 
 // Visual Studio 2010 or previous is missing inttypes.h
 #if defined(_MSC_VER) && (_MSC_VER < 1700)
@@ -126,6 +131,12 @@ std::ostream &operator<<(std::ostream &s, const vpImage<double> &I);
   value = I[i][j]; // Here we will get the pixel value at position (101, 80)
   \endcode
 
+  <h3>Memory allocation</h3> The bitmap and the row pointers are allocated with the
+  allocator returned by vpImageAllocator::getDefault(), aligned on 64 bytes. By default
+  it is the vpImagePool, which keeps the memory released by an image to reuse it
+  for the next image of a similar size, so that temporary images created at each
+  frame do not call malloc.
+
 */
 template <class Type> class vpImage
 {
@@ -361,6 +372,9 @@ public:
   //@}
 
 private:
+  template <class ElementType> static ElementType *allocateArray(unsigned int n);
+  template <class ElementType> static void deallocateArray(ElementType *array);
+
   unsigned int npixels; ///! number of pixel in the image
   unsigned int width;   ///! number of columns
   unsigned int height;  ///! number of rows
@@ -388,7 +402,7 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
 {
   if (h != this->height) {
     if (row != nullptr) {
-      delete[] row;
+      deallocateArray(row);
       row = nullptr;
     }
   }
@@ -396,7 +410,7 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
   if ((h != this->height) || (w != this->width)) {
     if (bitmap != nullptr) {
       if (hasOwnership) {
-        delete[] bitmap;
+        deallocateArray(bitmap);
       }
       bitmap = nullptr;
     }
@@ -408,14 +422,14 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
   npixels = width * height;
 
   if (bitmap == nullptr) {
-    bitmap = new Type[npixels];
+    bitmap = allocateArray<Type>(npixels);
     hasOwnership = true;
   }
   if (bitmap == nullptr) {
     throw(vpException(vpException::memoryAllocationError, "cannot allocate bitmap "));
   }
   if (row == nullptr) {
-    row = new Type *[height];
+    row = allocateArray<Type *>(height);
   }
   if (row == nullptr) {
     throw(vpException(vpException::memoryAllocationError, "cannot allocate row "));
@@ -433,7 +447,7 @@ template <class Type> void vpImage<Type>::init(Type *const array, unsigned int h
 {
   if (h != this->height) {
     if (row != nullptr) {
-      delete[] row;
+      deallocateArray(row);
       row = nullptr;
     }
   }
@@ -442,7 +456,7 @@ template <class Type> void vpImage<Type>::init(Type *const array, unsigned int h
   if ((copyData && ((h != this->height) || (w != this->width))) || (!copyData)) {
     if (bitmap != nullptr) {
       if (hasOwnership) {
-        delete[] bitmap;
+        deallocateArray(bitmap);
       }
       bitmap = nullptr;
     }
@@ -456,7 +470,7 @@ template <class Type> void vpImage<Type>::init(Type *const array, unsigned int h
 
   if (copyData) {
     if (bitmap == nullptr) {
-      bitmap = new Type[npixels];
+      bitmap = allocateArray<Type>(npixels);
     }
 
     if (bitmap == nullptr) {
@@ -472,7 +486,7 @@ template <class Type> void vpImage<Type>::init(Type *const array, unsigned int h
   }
 
   if (row == nullptr) {
-    row = new Type *[height];
+    row = allocateArray<Type *>(height);
   }
   if (row == nullptr) {
     throw(vpException(vpException::memoryAllocationError, "cannot allocate row "));
@@ -483,6 +497,42 @@ template <class Type> void vpImage<Type>::init(Type *const array, unsigned int h
   }
 }
 
+/*!
+  Allocate an array of \e n elements. Trivially destructible elements, which is the case of all the pixel types, are
+  allocated with vpImageAllocator::allocateBlock() so that the released bitmaps are recycled by the image pool.
+  Other types use new[].
+*/
+template <class Type>
+template <class ElementType> ElementType *vpImage<Type>::allocateArray(unsigned int n)
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  if (std::is_trivially_destructible<ElementType>::value) {
+    ElementType *array = static_cast<ElementType *>(vpImageAllocator::allocateBlock(n * sizeof(ElementType)));
+    // Default initialize the elements as new[] does, which does nothing for the fundamental types
+    for (unsigned int i = 0; i < n; ++i) {
+      ::new (static_cast<void *>(array + i)) ElementType;
+    }
+    return array;
+  }
+#endif
+  return new ElementType[n];
+}
+
+/*!
+  Release an array allocated by allocateArray().
+*/
+template <class Type>
+template <class ElementType> void vpImage<Type>::deallocateArray(ElementType *array)
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  if (std::is_trivially_destructible<ElementType>::value) {
+    vpImageAllocator::deallocateBlock(array);
+    return;
+  }
+#endif
+  delete[] array;
+}
+
 /*!
   \relates vpImage
 */
@@ -574,13 +624,13 @@ template <class Type> void vpImage<Type>::destroy()
 {
   if (bitmap != nullptr) {
     if (hasOwnership) {
-      delete[] bitmap;
+      deallocateArray(bitmap);
     }
     bitmap = nullptr;
   }
 
   if (row != nullptr) {
-    delete[] row;
+    deallocateArray(row);
     row = nullptr;
   }
 }
@@ -0,0 +1,163 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Memory allocator of the image bitmaps.
+ */
+
+/*!
+ * \file vpImageAllocator.h
+ * \brief Memory allocator of the image bitmaps, and default pool that recycles the released bitmaps.
+ */
+
+#ifndef VP_IMAGE_ALLOCATOR_H
+#define VP_IMAGE_ALLOCATOR_H
+
+#include <map>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_THREADS)
+#include <mutex>
+#endif
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpImageAllocator
+ *
+ * \ingroup group_core_image
+ *
+ * \brief Interface of the allocators used by vpImage to allocate its bitmap and its array of row pointers.
+ *
+ * The memory blocks returned by allocate() have to be aligned on vpImageAllocator::alignment bytes. By default the
+ * images use the vpImagePool singleton, that keeps the released blocks to give them back when an image of a similar
+ * size is allocated. Another allocator can be plugged with setDefault():
+ * \code
+ * class vpMyAllocator : public vpImageAllocator
+ * {
+ * public:
+ *   void *allocate(size_t size) VP_OVERRIDE { ... }
+ *   void deallocate(void *ptr, size_t size) VP_OVERRIDE { ... }
+ * };
+ *
+ * vpMyAllocator allocator;
+ * vpImageAllocator::setDefault(&allocator);
+ * \endcode
+ *
+ * Each block remembers the allocator that gave it, so that the default allocator can be changed while images are
+ * alive. An allocator has to outlive all the blocks it has allocated.
+ */
+class VISP_EXPORT vpImageAllocator
+{
+public:
+  //! Alignment in bytes of the blocks returned by allocate(), suitable for SIMD loads and cache lines.
+  static const size_t alignment = 64;
+
+  virtual ~vpImageAllocator() { }
+
+  /*!
+   * Allocate a block of \e size bytes aligned on vpImageAllocator::alignment bytes.
+   * \exception vpException::memoryAllocationError When the block cannot be allocated.
+   */
+  virtual void *allocate(size_t size) = 0;
+
+  /*!
+   * Release a block of \e size bytes previously returned by allocate().
+   */
+  virtual void deallocate(void *ptr, size_t size) = 0;
+
+  static void *allocateBlock(size_t size);
+  static void deallocateBlock(void *ptr);
+
+  static vpImageAllocator &getDefault();
+  static void setDefault(vpImageAllocator *allocator);
+};
+
+/*!
+ * \class vpImagePool
+ *
+ * \ingroup group_core_image
+ *
+ * \brief Default image allocator, that recycles the released blocks instead of returning them to the system.
+ *
+ * The sizes are rounded up to size classes, four per power of two, so that a block released by an image can be
+ * reused by an image of the same or of a slightly smaller size. Temporary images allocated at each frame by filters,
+ * conversions or trackers are then taken from the pool instead of calling malloc. The amount of memory kept in the
+ * pool is bounded, see setMaxCachedBytes().
+ *
+ * \code
+ * vpImagePool &pool = vpImagePool::getInstance();
+ * ...
+ * std::cout << "Pool hits: " << pool.getHits() << " misses: " << pool.getMisses() << std::endl;
+ * \endcode
+ *
+ * When ViSP is built with threads support, the pool can be used concurrently from several threads.
+ */
+class VISP_EXPORT vpImagePool : public vpImageAllocator
+{
+public:
+  vpImagePool();
+  virtual ~vpImagePool() VP_OVERRIDE;
+
+  void *allocate(size_t size) VP_OVERRIDE;
+  void deallocate(void *ptr, size_t size) VP_OVERRIDE;
+
+  void clear();
+
+  size_t getCachedBytes() const;
+  unsigned long getHits() const;
+  size_t getMaxCachedBytes() const;
+  unsigned long getMisses() const;
+
+  static vpImagePool &getInstance();
+  static size_t getSizeClass(size_t size);
+
+  void resetStatistics();
+  void setMaxCachedBytes(size_t max_bytes);
+
+private:
+  // Non copyable
+  vpImagePool(const vpImagePool &);
+  vpImagePool &operator=(const vpImagePool &);
+
+  void trim(size_t max_bytes);
+
+  //! Released blocks, sorted by size class
+  std::map<size_t, std::vector<void *> > m_freeBlocks;
+  size_t m_cachedBytes;
+  size_t m_maxCachedBytes;
+  unsigned long m_hits;
+  unsigned long m_misses;
+#if defined(VISP_HAVE_THREADS)
+  mutable std::mutex m_mutex;
+#endif
+};
+END_VISP_NAMESPACE
+#endif
@@ -481,27 +481,49 @@ public:
     g = static_cast<unsigned char>(dg);
     b = static_cast<unsigned char>(db);
   }
-  static void YUYVToRGBa(unsigned char *yuyv, unsigned char *rgba, unsigned int width, unsigned int height);
-  static void YUYVToRGB(unsigned char *yuyv, unsigned char *rgb, unsigned int width, unsigned int height);
+  static void YUYVToRGBa(unsigned char *yuyv, unsigned char *rgba, unsigned int width, unsigned int height,
+                         unsigned int nThreads = 0);
+  static void YUYVToRGB(unsigned char *yuyv, unsigned char *rgb, unsigned int width, unsigned int height,
+                        unsigned int nThreads = 0);
   static void YUYVToGrey(unsigned char *yuyv, unsigned char *grey, unsigned int size);
-  static void YUV411ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size);
-  static void YUV411ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size);
+  static void YUYVToGreyAndRGBa(unsigned char *yuyv, unsigned char *grey, unsigned char *rgba, unsigned int width,
+                                unsigned int height, unsigned int nThreads = 0);
+  static void YUV411ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size, unsigned int nThreads = 0);
+  static void YUV411ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size, unsigned int nThreads = 0);
   static void YUV411ToGrey(unsigned char *yuv, unsigned char *grey, unsigned int size);
-  static void YUV422ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size);
-  static void YUV422ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size);
+  static void YUV411ToGreyAndRGBa(unsigned char *yuv, unsigned char *grey, unsigned char *rgba, unsigned int size,
+                                  unsigned int nThreads = 0);
+  static void YUV422ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size, unsigned int nThreads = 0);
+  static void YUV422ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size, unsigned int nThreads = 0);
   static void YUV422ToGrey(unsigned char *yuv, unsigned char *grey, unsigned int size);
-  static void YUV420ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height);
-  static void YUV420ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height);
+  static void YUV422ToGreyAndRGBa(unsigned char *yuv, unsigned char *grey, unsigned char *rgba, unsigned int size,
+                                  unsigned int nThreads = 0);
+  static void YUV420ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height,
+                           unsigned int nThreads = 0);
+  static void YUV420ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height,
+                          unsigned int nThreads = 0);
   static void YUV420ToGrey(unsigned char *yuv, unsigned char *grey, unsigned int size);
+  static void YUV420ToGreyAndRGBa(unsigned char *yuv, unsigned char *grey, unsigned char *rgba, unsigned int width,
+                                  unsigned int height, unsigned int nThreads = 0);
 
-  static void YUV444ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size);
-  static void YUV444ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size);
+  static void YUV444ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size, unsigned int nThreads = 0);
+  static void YUV444ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size, unsigned int nThreads = 0);
   static void YUV444ToGrey(unsigned char *yuv, unsigned char *grey, unsigned int size);
+  static void YUV444ToGreyAndRGBa(unsigned char *yuv, unsigned char *grey, unsigned char *rgba, unsigned int size,
+                                  unsigned int nThreads = 0);
 
-  static void YV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height);
-  static void YV12ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height);
-  static void YVU9ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height);
-  static void YVU9ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height);
+  static void YV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height,
+                         unsigned int nThreads = 0);
+  static void YV12ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height,
+                        unsigned int nThreads = 0);
+  static void YV12ToGreyAndRGBa(unsigned char *yuv, unsigned char *grey, unsigned char *rgba, unsigned int width,
+                                unsigned int height, unsigned int nThreads = 0);
+  static void YVU9ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height,
+                         unsigned int nThreads = 0);
+  static void YVU9ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height,
+                        unsigned int nThreads = 0);
+  static void YVU9ToGreyAndRGBa(unsigned char *yuv, unsigned char *grey, unsigned char *rgba, unsigned int width,
+                                unsigned int height, unsigned int nThreads = 0);
   static void RGBToRGBa(unsigned char *rgb, unsigned char *rgba, unsigned int size);
   static void RGBaToRGB(unsigned char *rgba, unsigned char *rgb, unsigned int size);
 
@@ -39,11 +39,13 @@
 #ifndef VP_IMAGE_FILTER_H
 #define VP_IMAGE_FILTER_H
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <math.h>
 #include <string.h>
+#include <vector>
 
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpColorGetter.h>
@@ -721,46 +723,41 @@ public:
     const unsigned int inputHeight = I.getHeight(), inputWidth = I.getWidth();
     If.resize(inputHeight, inputWidth, 0.0);
 
-    if (convolve) {
-      const unsigned int stopHeight = inputHeight - half_size_y;
-      const unsigned int stopWidth = inputWidth - half_size_x;
-      for (unsigned int i = half_size_y; i < stopHeight; ++i) {
-        for (unsigned int j = half_size_x; j < stopWidth; ++j) {
-          // We have to compute the value for each pixel if we don't have a mask or for
-          // pixels for which the mask is true otherwise
-          bool computeVal = checkBooleanMask(p_mask, i, j);
-          if (computeVal) {
-            FilterType conv = 0;
+    if ((inputHeight <= (2 * half_size_y)) || (inputWidth <= (2 * half_size_x))) {
+      return;
+    }
 
-            for (unsigned int a = 0; a < size_y; ++a) {
-              for (unsigned int b = 0; b < size_x; ++b) {
-                FilterType val = static_cast<FilterType>(I[(i + half_size_y) - a][(j + half_size_x) - b]); // Convolution
-                conv += M[a][b] * val;
-              }
+    // Only pixels fully covered by the kernel are computed. Each output row is obtained by accumulating
+    // the kernel taps over whole contiguous lines, in the same order as the per-pixel sum.
+    const int startRow = static_cast<int>(half_size_y), stopRow = static_cast<int>(inputHeight - half_size_y);
+    const unsigned int nbCols = inputWidth - (2 * half_size_x);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel if (I.getSize() >= m_separableParallelMinSize)
+#endif
+    {
+      std::vector<FilterType> acc(nbCols);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif
+      for (int i = startRow; i < stopRow; ++i) {
+        std::fill(acc.begin(), acc.end(), static_cast<FilterType>(0));
+        for (unsigned int a = 0; a < size_y; ++a) {
+          // Convolution or correlation
+          const unsigned int r = convolve ? ((static_cast<unsigned int>(i) + half_size_y) - a) : ((static_cast<unsigned int>(i) - half_size_y) + a);
+          for (unsigned int b = 0; b < size_x; ++b) {
+            const ImageType *src = I[r] + (convolve ? ((2 * half_size_x) - b) : b);
+            const FilterType coef = M[a][b];
+            for (unsigned int j = 0; j < nbCols; ++j) {
+              acc[j] += coef * static_cast<FilterType>(src[j]);
             }
-            If[i][j] = conv;
           }
         }
-      }
-    }
-    else {
-      const unsigned int stopHeight = inputHeight - half_size_y;
-      const unsigned int stopWidth = inputWidth - half_size_x;
-      for (unsigned int i = half_size_y; i < stopHeight; ++i) {
-        for (unsigned int j = half_size_x; j < stopWidth; ++j) {
+        const unsigned int ui = static_cast<unsigned int>(i);
+        for (unsigned int j = 0; j < nbCols; ++j) {
           // We have to compute the value for each pixel if we don't have a mask or for
           // pixels for which the mask is true otherwise
-          bool computeVal = checkBooleanMask(p_mask, i, j);
-          if (computeVal) {
-            FilterType corr = 0;
-
-            for (unsigned int a = 0; a < size_y; ++a) {
-              for (unsigned int b = 0; b < size_x; ++b) {
-                FilterType val = static_cast<FilterType>(I[(i - half_size_y) + a][(j - half_size_x) + b]); // Correlation
-                corr += M[a][b] * val;
-              }
-            }
-            If[i][j] = corr;
+          if (checkBooleanMask(p_mask, ui, j + half_size_x)) {
+            If[ui][j + half_size_x] = acc[j];
           }
         }
       }
@@ -820,55 +817,49 @@ public:
     const unsigned int size = M.getRows();
     const unsigned int half_size = size / 2;
     const unsigned int height = I.getHeight(), width = I.getWidth();
-    const unsigned int stopV = height - half_size;
-    const unsigned int stopU = width - half_size;
 
     Iu.resize(height, width, 0.0);
     Iv.resize(height, width, 0.0);
 
-    if (convolve) {
-      for (unsigned int v = half_size; v < stopV; ++v) {
-        for (unsigned int u = half_size; u < stopU; ++u) {
-          // We have to compute the value for each pixel if we don't have a mask or for
-          // pixels for which the mask is true otherwise
-          bool computeVal = checkBooleanMask(p_mask, v, u);
-          if (computeVal) {
-            FilterType conv_u = 0;
-            FilterType conv_v = 0;
-
-            for (unsigned int a = 0; a < size; ++a) {
-              for (unsigned int b = 0; b < size; ++b) {
-                FilterType val = static_cast<FilterType>(I[(v + half_size) - a][(u + half_size) - b]); // Convolution
-                conv_u += M[a][b] * val;
-                conv_v += M[b][a] * val;
-              }
+    if ((height <= (2 * half_size)) || (width <= (2 * half_size))) {
+      return;
+    }
+
+    // Same row-based accumulation as filter(I, If, M, convolve, p_mask), with M for Iu and its transpose for Iv
+    const int startRow = static_cast<int>(half_size), stopRow = static_cast<int>(height - half_size);
+    const unsigned int nbCols = width - (2 * half_size);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel if (I.getSize() >= m_separableParallelMinSize)
+#endif
+    {
+      std::vector<FilterType> acc_u(nbCols), acc_v(nbCols);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif
+      for (int v = startRow; v < stopRow; ++v) {
+        std::fill(acc_u.begin(), acc_u.end(), static_cast<FilterType>(0));
+        std::fill(acc_v.begin(), acc_v.end(), static_cast<FilterType>(0));
+        for (unsigned int a = 0; a < size; ++a) {
+          // Convolution or correlation
+          const unsigned int r = convolve ? ((static_cast<unsigned int>(v) + half_size) - a) : ((static_cast<unsigned int>(v) - half_size) + a);
+          for (unsigned int b = 0; b < size; ++b) {
+            const ImageType *src = I[r] + (convolve ? ((2 * half_size) - b) : b);
+            const FilterType coef_u = M[a][b];
+            const FilterType coef_v = M[b][a];
+            for (unsigned int j = 0; j < nbCols; ++j) {
+              const FilterType val = static_cast<FilterType>(src[j]);
+              acc_u[j] += coef_u * val;
+              acc_v[j] += coef_v * val;
             }
-            Iu[v][u] = conv_u;
-            Iv[v][u] = conv_v;
           }
         }
-      }
-    }
-    else {
-      for (unsigned int v = half_size; v < stopV; ++v) {
-        for (unsigned int u = half_size; u < stopU; ++u) {
+        const unsigned int uv = static_cast<unsigned int>(v);
+        for (unsigned int j = 0; j < nbCols; ++j) {
           // We have to compute the value for each pixel if we don't have a mask or for
           // pixels for which the mask is true otherwise
-          bool computeVal = checkBooleanMask(p_mask, v, u);
-
-          if (computeVal) {
-            FilterType conv_u = 0;
-            FilterType conv_v = 0;
-
-            for (unsigned int a = 0; a < size; ++a) {
-              for (unsigned int b = 0; b < size; ++b) {
-                FilterType val = static_cast<FilterType>(I[(v - half_size) + a][(u - half_size) + b]); // Correlation
-                conv_u += M[a][b] * val;
-                conv_v += M[b][a] * val;
-              }
-            }
-            Iu[v][u] = conv_u;
-            Iv[v][u] = conv_v;
+          if (checkBooleanMask(p_mask, uv, j + half_size)) {
+            Iu[uv][j + half_size] = acc_u[j];
+            Iv[uv][j + half_size] = acc_v[j];
           }
         }
       }
@@ -903,6 +894,11 @@ public:
   template <typename ImageType, typename FilterType>
   static void filter(const vpImage<ImageType> &I, vpImage<FilterType> &GI, const FilterType *filter, unsigned int size, const vpImage<bool> *p_mask = nullptr)
   {
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+    if (separableFilter<ImageType, FilterType, FilterType>(I, GI, filter, size, p_mask)) {
+      return;
+    }
+#endif
     vpImage<FilterType> GIx;
     filterX<ImageType, FilterType>(I, GIx, filter, size, p_mask);
     filterY<FilterType, FilterType>(GIx, GI, filter, size, p_mask);
@@ -1102,6 +1098,9 @@ public:
   static void filterX(const vpImage<ImageType> &I, vpImage<OutputType> &dIx, const FilterType *filter, unsigned int size,
                       const vpImage<bool> *p_mask = nullptr)
   {
+    if (separableFilterX(I, dIx, filter, size, p_mask)) {
+      return;
+    }
     const unsigned int height = I.getHeight();
     const unsigned int width = I.getWidth();
     const int stop1J = static_cast<int>((size - 1) / 2);
@@ -1495,6 +1494,9 @@ public:
   static void filterY(const vpImage<ImageType> &I, vpImage<OutputType> &dIy, const FilterType *filter, unsigned int size,
                       const vpImage<bool> *p_mask = nullptr)
   {
+    if (separableFilterY(I, dIy, filter, size, p_mask)) {
+      return;
+    }
     const unsigned int height = I.getHeight(), width = I.getWidth();
     const unsigned int stop1I = (size - 1) / 2;
     const unsigned int stop2I = height - ((size - 1) / 2);
@@ -1787,10 +1789,12 @@ public:
 
     FilterType *fg = new FilterType[(size + 1) / 2];
     vpImageFilter::getGaussianKernel<FilterType>(fg, size, sigma, normalize);
-    vpImage<OutputType> GIx;
-    vpImageFilter::filterX<ImageType, OutputType>(I, GIx, fg, size, p_mask);
-    vpImageFilter::filterY<OutputType, OutputType>(GIx, GI, fg, size, p_mask);
-    GIx.destroy();
+    if (!separableFilter<ImageType, OutputType, OutputType>(I, GI, fg, size, p_mask)) {
+      vpImage<OutputType> GIx;
+      vpImageFilter::filterX<ImageType, OutputType>(I, GIx, fg, size, p_mask);
+      vpImageFilter::filterY<OutputType, OutputType>(GIx, GI, fg, size, p_mask);
+      GIx.destroy();
+    }
     delete[] fg;
   }
 #else
@@ -1994,6 +1998,9 @@ public:
   template <typename ImageType, typename FilterType>
   static void getGradX(const vpImage<ImageType> &I, vpImage<FilterType> &dIx, const FilterType *filter, unsigned int size, const vpImage<bool> *p_mask = nullptr)
   {
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+    separableGradX(I, dIx, filter, size, p_mask);
+#else
     const unsigned int height = I.getHeight(), width = I.getWidth();
     const unsigned int stop1J = (size - 1) / 2;
     const unsigned int stop2J = width - ((size - 1) / 2);
@@ -2023,6 +2030,7 @@ public:
         }
       }
     }
+#endif
   }
 
   /*!
@@ -2139,6 +2147,9 @@ public:
   template <typename ImageType, typename FilterType>
   static void getGradY(const vpImage<ImageType> &I, vpImage<FilterType> &dIy, const FilterType *filter, unsigned int size, const vpImage<bool> *p_mask = nullptr)
   {
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+    separableGradY(I, dIy, filter, size, p_mask);
+#else
     const unsigned int height = I.getHeight(), width = I.getWidth();
     const unsigned int stop1I = (size - 1) / 2;
     const unsigned int stop2I = height - ((size - 1) / 2);
@@ -2174,6 +2185,7 @@ public:
         }
       }
     }
+#endif
   }
 
   /*!
@@ -2930,6 +2942,397 @@ private:
     }
   }
 #endif
+#endif
+
+  /**
+   * \brief Minimum number of pixels of an image for the separable filtering engine to spread the rows over
+   * several threads.
+   */
+  static const unsigned int m_separableParallelMinSize;
+
+  /**
+   * \brief Minimum number of output rows processed by a tile of the fused separable filtering engine. The
+   * horizontally filtered lines of a tile are kept in a ring of \b size line buffers so that they stay in cache
+   * while the vertical pass consumes them.
+   */
+  static const unsigned int m_separableTileRows;
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  /**
+   * \brief Accumulate one tap of a symmetric (or anti-symmetric) filter over a line of pixels:
+   * \f$ acc[j] += coef \times (a[j] + b[j]) \f$, or \f$ acc[j] += coef \times (a[j] - b[j]) \f$ when \b isDerivative
+   * is true. The sum (or difference) is computed in the pixel type and then cast into \b FilterType, as the per-pixel
+   * helpers filterX() and derivativeFilterX() do, so that the engine gives the same results.
+   *
+   * \param[in] a The pixels at offset +i.
+   * \param[in] b The pixels at offset -i.
+   * \param[in] coef The filter coefficient of the tap.
+   * \param[inout] acc The accumulators.
+   * \param[in] n The number of pixels.
+   * \param[in] isDerivative If true, accumulate the difference instead of the sum.
+   */
+  template <typename ImageType, typename FilterType>
+  static void separableAccumulate(const ImageType *a, const ImageType *b, const FilterType &coef, FilterType *acc,
+                                  unsigned int n, bool isDerivative)
+  {
+    if (isDerivative) {
+      for (unsigned int j = 0; j < n; ++j) {
+        acc[j] += coef * static_cast<FilterType>(a[j] - b[j]);
+      }
+    }
+    else {
+      for (unsigned int j = 0; j < n; ++j) {
+        acc[j] += coef * static_cast<FilterType>(a[j] + b[j]);
+      }
+    }
+  }
+
+  static void separableAccumulate(const unsigned char *a, const unsigned char *b, const float &coef, float *acc,
+                                  unsigned int n, bool isDerivative);
+  static void separableAccumulate(const float *a, const float *b, const float &coef, float *acc, unsigned int n,
+                                  bool isDerivative);
+  static void separableAccumulate(const double *a, const double *b, const double &coef, double *acc, unsigned int n,
+                                  bool isDerivative);
+
+  /**
+   * \brief Mirror an index that falls outside [0; n[ the way the border helpers (filterXLeftBorder(),
+   * filterXRightBorder(), filterYTopBorder(), filterYBottomBorder()) do.
+   */
+  static inline int separableMirror(int k, int n)
+  {
+    if (k < 0) {
+      return -k;
+    }
+    if (k >= n) {
+      return (2 * n) - k - 1;
+    }
+    return k;
+  }
+
+  /**
+   * \brief Filter a whole row along the horizontal direction. The row is first copied with its mirrored borders in
+   * \b padded, so that the taps are accumulated on contiguous lines without any border test.
+   *
+   * \param[in] src The row to filter, of \b width pixels.
+   * \param[in] padded A buffer of at least width + size - 1 pixels.
+   * \param[out] acc The filtered row, of \b width values.
+   * \param[in] width The width of the row. It must be greater than (size - 1) / 2.
+   * \param[in] filter The coefficients of the filter.
+   * \param[in] size The size of the filter.
+   */
+  template <typename ImageType, typename FilterType>
+  static void separableRowX(const ImageType *src, ImageType *padded, FilterType *acc, unsigned int width,
+                            const FilterType *filter, unsigned int size)
+  {
+    const unsigned int stop = (size - 1) / 2;
+    ImageType *center = padded + stop;
+    std::copy(src, src + width, center);
+    for (unsigned int k = 1; k <= stop; ++k) {
+      center[-static_cast<int>(k)] = src[k];
+      center[(width - 1) + k] = src[width - k];
+    }
+    for (unsigned int j = 0; j < width; ++j) {
+      acc[j] = filter[0] * static_cast<FilterType>(center[j]);
+    }
+    for (unsigned int i = 1; i <= stop; ++i) {
+      separableAccumulate(center + i, center - i, filter[i], acc, width, false);
+    }
+  }
+
+  /**
+   * \brief Filter a whole row along the vertical direction.
+   *
+   * \param[in] rows The \b size lines centered on the row to compute: rows[(size - 1) / 2 + i] is the line at offset i.
+   * \param[out] acc The filtered row, of \b width values.
+   * \param[in] width The width of the lines.
+   * \param[in] filter The coefficients of the filter.
+   * \param[in] size The size of the filter.
+   * \param[in] isDerivative If true, apply the anti-symmetric filter of derivativeFilterY().
+   */
+  template <typename ImageType, typename FilterType>
+  static void separableColumn(const ImageType *const *rows, FilterType *acc, unsigned int width,
+                              const FilterType *filter, unsigned int size, bool isDerivative)
+  {
+    const unsigned int stop = (size - 1) / 2;
+    if (isDerivative) {
+      std::fill(acc, acc + width, static_cast<FilterType>(0));
+    }
+    else {
+      const ImageType *center = rows[stop];
+      for (unsigned int j = 0; j < width; ++j) {
+        acc[j] = filter[0] * static_cast<FilterType>(center[j]);
+      }
+    }
+    for (unsigned int i = 1; i <= stop; ++i) {
+      separableAccumulate(rows[stop + i], rows[stop - i], filter[i], acc, width, isDerivative);
+    }
+  }
+
+  /**
+   * \brief Write a filtered row in the destination row.
+   *
+   * \param[in] acc The filtered values.
+   * \param[out] dst The destination row.
+   * \param[in] mask The mask row if any, nullptr otherwise. Only the pixels for which it is true are written.
+   * \param[in] width The width of the row.
+   * \param[in] resetMasked If true, the pixels that are masked out are set to 0 instead of being left untouched.
+   */
+  template <typename FilterType, typename OutputType>
+  static void separableStore(const FilterType *acc, OutputType *dst, const bool *mask, unsigned int width,
+                             bool resetMasked)
+  {
+    if (mask == nullptr) {
+      for (unsigned int j = 0; j < width; ++j) {
+        dst[j] = static_cast<OutputType>(acc[j]);
+      }
+    }
+    else if (resetMasked) {
+      for (unsigned int j = 0; j < width; ++j) {
+        dst[j] = mask[j] ? static_cast<OutputType>(acc[j]) : static_cast<OutputType>(0);
+      }
+    }
+    else {
+      for (unsigned int j = 0; j < width; ++j) {
+        if (mask[j]) {
+          dst[j] = static_cast<OutputType>(acc[j]);
+        }
+      }
+    }
+  }
+
+  /**
+   * \brief Row-based horizontal filtering, used by filterX() for arithmetic images.
+   *
+   * \return false if the image is too small to be handled by the engine, in which case nothing has been done.
+   */
+  template <typename ImageType, typename OutputType, typename FilterType>
+  static typename std::enable_if<std::is_arithmetic<ImageType>::value &&std::is_arithmetic<OutputType>::value, bool>::type
+    separableFilterX(const vpImage<ImageType> &I, vpImage<OutputType> &dIx, const FilterType *filter, unsigned int size,
+                     const vpImage<bool> *p_mask)
+  {
+    const unsigned int height = I.getHeight(), width = I.getWidth();
+    const unsigned int stop = (size - 1) / 2;
+    if ((size == 0) || (stop >= width)) {
+      return false;
+    }
+    resizeAndInitializeIfNeeded(p_mask, height, width, dIx);
+    const int nbRows = static_cast<int>(height);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel if (I.getSize() >= m_separableParallelMinSize)
+#endif
+    {
+      std::vector<ImageType> padded(width + (2 * stop));
+      std::vector<FilterType> acc(width);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif
+      for (int i = 0; i < nbRows; ++i) {
+        const unsigned int r = static_cast<unsigned int>(i);
+        separableRowX(I[r], padded.data(), acc.data(), width, filter, size);
+        separableStore(acc.data(), dIx[r], (p_mask != nullptr) ? (*p_mask)[r] : nullptr, width, false);
+      }
+    }
+    return true;
+  }
+
+  template <typename ImageType, typename OutputType, typename FilterType>
+  static typename std::enable_if<!(std::is_arithmetic<ImageType>::value &&std::is_arithmetic<OutputType>::value), bool>::type
+    separableFilterX(const vpImage<ImageType> &, vpImage<OutputType> &, const FilterType *, unsigned int,
+                     const vpImage<bool> *)
+  {
+    return false;
+  }
+
+  /**
+   * \brief Row-based vertical filtering, used by filterY() for arithmetic images.
+   *
+   * \return false if the image is too small to be handled by the engine, in which case nothing has been done.
+   */
+  template <typename ImageType, typename OutputType, typename FilterType>
+  static typename std::enable_if<std::is_arithmetic<ImageType>::value &&std::is_arithmetic<OutputType>::value, bool>::type
+    separableFilterY(const vpImage<ImageType> &I, vpImage<OutputType> &dIy, const FilterType *filter, unsigned int size,
+                     const vpImage<bool> *p_mask)
+  {
+    const unsigned int height = I.getHeight(), width = I.getWidth();
+    const unsigned int stop = (size - 1) / 2;
+    if ((size == 0) || (stop >= height)) {
+      return false;
+    }
+    resizeAndInitializeIfNeeded(p_mask, height, width, dIy);
+    const int nbRows = static_cast<int>(height);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel if (I.getSize() >= m_separableParallelMinSize)
+#endif
+    {
+      std::vector<const ImageType *> rows((2 * stop) + 1);
+      std::vector<FilterType> acc(width);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif
+      for (int i = 0; i < nbRows; ++i) {
+        for (unsigned int k = 0; k < rows.size(); ++k) {
+          rows[k] = I[static_cast<unsigned int>(separableMirror((i - static_cast<int>(stop)) + static_cast<int>(k), nbRows))];
+        }
+        const unsigned int r = static_cast<unsigned int>(i);
+        separableColumn(rows.data(), acc.data(), width, filter, size, false);
+        separableStore(acc.data(), dIy[r], (p_mask != nullptr) ? (*p_mask)[r] : nullptr, width, false);
+      }
+    }
+    return true;
+  }
+
+  template <typename ImageType, typename OutputType, typename FilterType>
+  static typename std::enable_if<!(std::is_arithmetic<ImageType>::value &&std::is_arithmetic<OutputType>::value), bool>::type
+    separableFilterY(const vpImage<ImageType> &, vpImage<OutputType> &, const FilterType *, unsigned int,
+                     const vpImage<bool> *)
+  {
+    return false;
+  }
+
+  /**
+   * \brief Fused separable filtering: filterX() followed by filterY() without the intermediate image.
+   *
+   * The output rows are split in tiles of at least m_separableTileRows rows that are spread over the threads. Within a tile,
+   * each horizontally filtered line (of type \b TmpType, the type of the intermediate image of the two-pass version)
+   * is computed once into a ring of \b size line buffers, and each output row is obtained by the vertical pass on the
+   * lines of the ring. With a mask, the masked out pixels of the intermediate lines are set to 0, as they are in the
+   * intermediate image of the two-pass version, so that both give the same result.
+   *
+   * \return false if the image is too small to be handled by the engine, in which case nothing has been done.
+   */
+  template <typename ImageType, typename TmpType, typename OutputType, typename FilterType>
+  static typename std::enable_if<std::is_arithmetic<ImageType>::value &&std::is_arithmetic<TmpType>::value &&std::is_arithmetic<OutputType>::value, bool>::type
+    separableFilter(const vpImage<ImageType> &I, vpImage<OutputType> &GI, const FilterType *filter, unsigned int size,
+                    const vpImage<bool> *p_mask)
+  {
+    const unsigned int height = I.getHeight(), width = I.getWidth();
+    const unsigned int stop = (size - 1) / 2;
+    if ((size == 0) || (stop >= width) || (stop >= height)) {
+      return false;
+    }
+    resizeAndInitializeIfNeeded(p_mask, height, width, GI);
+    const int nbRows = static_cast<int>(height);
+    // The first lines of a tile are filtered horizontally by the previous tile too: make the tiles
+    // large enough with respect to the filter size to keep this overhead small
+    const unsigned int tileRows = std::max<unsigned int>(m_separableTileRows, 8 * size);
+    const int nbTiles = static_cast<int>((height + tileRows - 1) / tileRows);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel if (I.getSize() >= m_separableParallelMinSize)
+#endif
+    {
+      std::vector<ImageType> padded(width + (2 * stop));
+      std::vector<FilterType> acc(width);
+      std::vector<TmpType> ring(static_cast<size_t>(size) * width);
+      std::vector<const TmpType *> rows(size);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif
+      for (int t = 0; t < nbTiles; ++t) {
+        const int rowStart = t * static_cast<int>(tileRows);
+        const int rowStop = std::min<int>(rowStart + static_cast<int>(tileRows), nbRows);
+        const int firstLine = rowStart - static_cast<int>(stop);
+        int nextLine = firstLine;
+        for (int r = rowStart; r < rowStop; ++r) {
+          // Horizontal pass on the lines entering the window of the vertical pass
+          while (nextLine <= (r + static_cast<int>(stop))) {
+            const unsigned int srcRow = static_cast<unsigned int>(separableMirror(nextLine, nbRows));
+            TmpType *line = &ring[static_cast<size_t>((nextLine - firstLine) % static_cast<int>(size)) * width];
+            separableRowX(I[srcRow], padded.data(), acc.data(), width, filter, size);
+            separableStore(acc.data(), line, (p_mask != nullptr) ? (*p_mask)[srcRow] : nullptr, width, true);
+            ++nextLine;
+          }
+          // Vertical pass
+          for (unsigned int k = 0; k < size; ++k) {
+            rows[k] = &ring[static_cast<size_t>(((r - rowStart) + static_cast<int>(k)) % static_cast<int>(size)) * width];
+          }
+          const unsigned int ur = static_cast<unsigned int>(r);
+          separableColumn(rows.data(), acc.data(), width, filter, size, false);
+          separableStore(acc.data(), GI[ur], (p_mask != nullptr) ? (*p_mask)[ur] : nullptr, width, false);
+        }
+      }
+    }
+    return true;
+  }
+
+  template <typename ImageType, typename TmpType, typename OutputType, typename FilterType>
+  static typename std::enable_if<!(std::is_arithmetic<ImageType>::value &&std::is_arithmetic<TmpType>::value &&std::is_arithmetic<OutputType>::value), bool>::type
+    separableFilter(const vpImage<ImageType> &, vpImage<OutputType> &, const FilterType *, unsigned int,
+                    const vpImage<bool> *)
+  {
+    return false;
+  }
+
+  /**
+   * \brief Row-based gradient along the horizontal direction, used by getGradX().
+   * The columns closer to the border than (size - 1) / 2 are set to 0.
+   */
+  template <typename ImageType, typename FilterType>
+  static void separableGradX(const vpImage<ImageType> &I, vpImage<FilterType> &dIx, const FilterType *filter,
+                             unsigned int size, const vpImage<bool> *p_mask)
+  {
+    const unsigned int height = I.getHeight(), width = I.getWidth();
+    const unsigned int stop = (size - 1) / 2;
+    const unsigned int nbCols = (width > (2 * stop)) ? (width - (2 * stop)) : 0;
+    resizeAndInitializeIfNeeded(p_mask, height, width, dIx);
+    const int nbRows = static_cast<int>(height);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel if (I.getSize() >= m_separableParallelMinSize)
+#endif
+    {
+      std::vector<FilterType> acc(width, static_cast<FilterType>(0));
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif
+      for (int i = 0; i < nbRows; ++i) {
+        const unsigned int r = static_cast<unsigned int>(i);
+        if (nbCols > 0) {
+          const ImageType *center = I[r] + stop;
+          std::fill(acc.begin() + stop, acc.begin() + stop + nbCols, static_cast<FilterType>(0));
+          for (unsigned int k = 1; k <= stop; ++k) {
+            separableAccumulate(center + k, center - k, filter[k], acc.data() + stop, nbCols, true);
+          }
+        }
+        separableStore(acc.data(), dIx[r], (p_mask != nullptr) ? (*p_mask)[r] : nullptr, width, false);
+      }
+    }
+  }
+
+  /**
+   * \brief Row-based gradient along the vertical direction, used by getGradY().
+   * The rows closer to the border than (size - 1) / 2 are set to 0.
+   */
+  template <typename ImageType, typename FilterType>
+  static void separableGradY(const vpImage<ImageType> &I, vpImage<FilterType> &dIy, const FilterType *filter,
+                             unsigned int size, const vpImage<bool> *p_mask)
+  {
+    const unsigned int height = I.getHeight(), width = I.getWidth();
+    const int stop = static_cast<int>((size - 1) / 2);
+    resizeAndInitializeIfNeeded(p_mask, height, width, dIy);
+    const int nbRows = static_cast<int>(height);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel if (I.getSize() >= m_separableParallelMinSize)
+#endif
+    {
+      std::vector<const ImageType *> rows((2 * stop) + 1);
+      std::vector<FilterType> acc(width);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif
+      for (int i = 0; i < nbRows; ++i) {
+        const unsigned int r = static_cast<unsigned int>(i);
+        if ((i < stop) || (i >= (nbRows - stop))) {
+          std::fill(acc.begin(), acc.end(), static_cast<FilterType>(0));
+        }
+        else {
+          for (size_t k = 0; k < rows.size(); ++k) {
+            rows[k] = I[static_cast<unsigned int>((i - stop) + static_cast<int>(k))];
+          }
+          separableColumn(rows.data(), acc.data(), width, filter, size, true);
+        }
+        separableStore(acc.data(), dIy[r], (p_mask != nullptr) ? (*p_mask)[r] : nullptr, width, false);
+      }
+    }
+  }
 #endif
 };
 #if defined(__clang__)
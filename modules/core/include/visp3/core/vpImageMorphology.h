@@ -47,8 +47,10 @@
 
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <math.h>
 #include <string.h>
+#include <vector>
 
 #if defined(__clang__)
 // Mute warning : '\tparam' command used in a comment that is not attached to a template declaration [-Wdocumentation]
@@ -98,6 +100,36 @@ public:
   template <typename T>
   static void dilatation(vpImage<T> &I, const int &size);
 
+  template <typename T>
+  static void erosion(vpImage<T> &I, const int &width, const int &height);
+
+  template <typename T>
+  static void dilatation(vpImage<T> &I, const int &width, const int &height);
+
+  template <typename T>
+  static void opening(vpImage<T> &I, const int &size);
+
+  template <typename T>
+  static void opening(vpImage<T> &I, const int &width, const int &height);
+
+  template <typename T>
+  static void closing(vpImage<T> &I, const int &size);
+
+  template <typename T>
+  static void closing(vpImage<T> &I, const int &width, const int &height);
+
+  template <typename T>
+  static void topHat(vpImage<T> &I, const int &size);
+
+  template <typename T>
+  static void topHat(vpImage<T> &I, const int &width, const int &height);
+
+  template <typename T>
+  static void blackHat(vpImage<T> &I, const int &size);
+
+  template <typename T>
+  static void blackHat(vpImage<T> &I, const int &width, const int &height);
+
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
   /*!
     @name Deprecated functions
@@ -191,17 +223,44 @@ private:
   static void imageOperation(vpImage<T> &I, const T &null_value, vpPixelOperation<T> *operation, const vpConnexityType &connexity = CONNEXITY_4);
 
   /**
-   * \brief Modify the image by applying the \b operation on each of its elements on a \b size x \b size
-   * grid.
+   * \brief Modify the image by applying the min or max \b operation on each of its elements on a \b width x
+   * \b height grid. Pixels outside the image are ignored.
+   *
+   * The operation being separable, it is applied first on the rows then on the columns, each pass using the
+   * van Herk/Gil-Werman algorithm that needs 3 comparisons per pixel whatever the size of the kernel.
+   * Rows and column stripes are processed in parallel when OpenMP is available.
    *
    * \tparam T Any type such as double, unsigned char ...
+   * \tparam Operation vpPixelOperationMin or vpPixelOperationMax.
    * \param[out] I The image we want to modify.
-   * \param[in] operation The operation to apply to its elements on a the grid.
-   * \param[in] size Size of the kernel of the operation.
+   * \param[in] operation The operation to apply to its elements on the grid.
+   * \param[in] neutral The neutral element of the operation used to pad the image.
+   * \param[in] width Odd width of the kernel of the operation.
+   * \param[in] height Odd height of the kernel of the operation.
    */
-  template <typename T>
-  static void imageOperation(vpImage<T> &I, vpPixelOperation<T> *operation, const int &size = 3);
+  template <typename T, class Operation>
+  static void imageOperation(vpImage<T> &I, Operation &operation, const T &neutral, const int &width,
+                             const int &height);
+
+  /**
+   * \brief Running min or max of the kernel \b size over the \b length elements of \b src, that has to be
+   * padded on both sides by size / 2 neutral elements, with the van Herk/Gil-Werman algorithm.
+   */
+  template <typename T, class Operation>
+  static void lineOperation(Operation &operation, const T *src, unsigned int length, unsigned int size, T *prefix,
+                            T *suffix, T *dst);
+
+  /**
+   * \brief Element-wise operation \b dst = operation(\b a, \b b) on \b n elements.
+   */
+  template <typename T, class Operation>
+  static void rowOperation(Operation &operation, const T *a, const T *b, T *dst, unsigned int n);
+
+  static void rowOperation(vpPixelOperationMin<unsigned char> &operation, const unsigned char *a,
+                           const unsigned char *b, unsigned char *dst, unsigned int n);
 
+  static void rowOperation(vpPixelOperationMax<unsigned char> &operation, const unsigned char *a,
+                           const unsigned char *b, unsigned char *dst, unsigned int n);
 };
 
 /*!
@@ -467,43 +526,121 @@ void vpImageMorphology::dilatation(vpImage<T> &I, const vpConnexityType &connexi
   vpImageMorphology::imageOperation(I, std::numeric_limits<T>::min(), &operation, connexity);
 }
 
-template<typename T>
-void vpImageMorphology::imageOperation(vpImage<T> &I, vpPixelOperation<T> *operation, const int &size)
+template <typename T, class Operation>
+void vpImageMorphology::lineOperation(Operation &operation, const T *src, unsigned int length, unsigned int size,
+                                      T *prefix, T *suffix, T *dst)
 {
-  if ((size % 2) != 1) {
+  const unsigned int paddedLength = length + size - 1;
+  for (unsigned int i = 0; i < paddedLength; ++i) {
+    prefix[i] = ((i % size) == 0) ? src[i] : operation(prefix[i - 1], src[i]);
+  }
+  suffix[paddedLength - 1] = src[paddedLength - 1];
+  for (unsigned int i = paddedLength - 1; i > 0; --i) {
+    suffix[i - 1] = ((i % size) == 0) ? src[i - 1] : operation(suffix[i], src[i - 1]);
+  }
+  for (unsigned int i = 0; i < length; ++i) {
+    dst[i] = operation(suffix[i], prefix[i + size - 1]);
+  }
+}
+
+template <typename T, class Operation>
+void vpImageMorphology::rowOperation(Operation &operation, const T *a, const T *b, T *dst, unsigned int n)
+{
+  for (unsigned int i = 0; i < n; ++i) {
+    dst[i] = operation(a[i], b[i]);
+  }
+}
+
+template <typename T, class Operation>
+void vpImageMorphology::imageOperation(vpImage<T> &I, Operation &operation, const T &neutral, const int &width,
+                                       const int &height)
+{
+  if (((width % 2) != 1) || ((height % 2) != 1)) {
     throw(vpException(vpException::badValue, "Dilatation/erosion kernel must be odd."));
   }
 
-  const int width_in = static_cast<int>(I.getWidth());
-  const int height_in = static_cast<int>(I.getHeight());
-  int halfKernelSize = size / 2;
-  vpImage<T> J = I;
-
-  for (int r = 0; r < height_in; ++r) {
-    // Computing the rows we can explore without going outside the limits of the image
-    int r_iterator_start = -halfKernelSize, r_iterator_stop = halfKernelSize + 1;
-    if ((r - halfKernelSize) < 0) {
-      r_iterator_start = -r;
-    }
-    else if ((r + halfKernelSize) >= height_in) {
-      r_iterator_stop = height_in - r;
-    }
-    for (int c = 0; c < width_in; ++c) {
-      T value = I[r][c];
-      // Computing the columns we can explore without going outside the limits of the image
-      int c_iterator_start = -halfKernelSize, c_iterator_stop = halfKernelSize + 1;
-      if ((c - halfKernelSize) < 0) {
-        c_iterator_start = -c;
-      }
-      else if ((c + halfKernelSize) >= width_in) {
-        c_iterator_stop = width_in - c;
+  const unsigned int nbRows = I.getHeight();
+  const unsigned int nbCols = I.getWidth();
+  if ((nbRows == 0) || (nbCols == 0)) {
+    return;
+  }
+#if defined(VISP_HAVE_OPENMP)
+  const unsigned int minSizeForParallel = 256 * 256;
+  const bool useParallel = (nbRows * nbCols) >= minSizeForParallel;
+#endif
+
+  // Horizontal pass on each row
+  if (width > 1) {
+    const unsigned int kernelWidth = static_cast<unsigned int>(width);
+    const unsigned int half = kernelWidth / 2;
+    const unsigned int paddedLength = nbCols + (2 * half);
+    const int rows = static_cast<int>(nbRows);
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel if (useParallel)
+#endif
+    {
+      std::vector<T> buffer(3 * paddedLength, neutral);
+      T *src = &buffer[0];
+      T *prefix = src + paddedLength;
+      T *suffix = prefix + paddedLength;
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp for
+#endif
+      for (int r = 0; r < rows; ++r) {
+        T *row = I[r];
+        std::copy(row, row + nbCols, src + half);
+        lineOperation(operation, src, nbCols, kernelWidth, prefix, suffix, row);
       }
-      for (int r_iterator = r_iterator_start; r_iterator < r_iterator_stop; ++r_iterator) {
-        for (int c_iterator = c_iterator_start; c_iterator < c_iterator_stop; ++c_iterator) {
-          value = (*operation)(value, J[r + r_iterator][c + c_iterator]);
+    }
+  }
+
+  // Vertical pass done on stripes of columns, each row of a stripe being processed at once
+  if (height > 1) {
+    const unsigned int kernelHeight = static_cast<unsigned int>(height);
+    const unsigned int half = kernelHeight / 2;
+    const unsigned int paddedLength = nbRows + (2 * half);
+    const unsigned int stripeWidth = 256;
+    const int nbStripes = static_cast<int>((nbCols + stripeWidth - 1) / stripeWidth);
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel if (useParallel && (nbStripes > 1))
+#endif
+    {
+      std::vector<T> neutralRow(stripeWidth, neutral);
+      std::vector<T> prefixBuffer(static_cast<size_t>(paddedLength) * stripeWidth);
+      std::vector<T> suffixBuffer(static_cast<size_t>(paddedLength) * stripeWidth);
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp for
+#endif
+      for (int stripe = 0; stripe < nbStripes; ++stripe) {
+        const unsigned int c0 = static_cast<unsigned int>(stripe) * stripeWidth;
+        const unsigned int n = std::min<unsigned int>(stripeWidth, nbCols - c0);
+        // Row i of the padded column corresponds to the row i - half of the image
+        for (unsigned int i = 0; i < paddedLength; ++i) {
+          const T *src = ((i < half) || (i >= (nbRows + half))) ? &neutralRow[0] : (I[i - half] + c0);
+          T *prefix = &prefixBuffer[static_cast<size_t>(i) * stripeWidth];
+          if ((i % kernelHeight) == 0) {
+            std::copy(src, src + n, prefix);
+          }
+          else {
+            rowOperation(operation, prefix - stripeWidth, src, prefix, n);
+          }
+        }
+        for (unsigned int i = paddedLength; i > 0; --i) {
+          const unsigned int ii = i - 1;
+          const T *src = ((ii < half) || (ii >= (nbRows + half))) ? &neutralRow[0] : (I[ii - half] + c0);
+          T *suffix = &suffixBuffer[static_cast<size_t>(ii) * stripeWidth];
+          if ((ii == (paddedLength - 1)) || ((i % kernelHeight) == 0)) {
+            std::copy(src, src + n, suffix);
+          }
+          else {
+            rowOperation(operation, suffix + stripeWidth, src, suffix, n);
+          }
+        }
+        for (unsigned int r = 0; r < nbRows; ++r) {
+          rowOperation(operation, &suffixBuffer[static_cast<size_t>(r) * stripeWidth],
+                       &prefixBuffer[static_cast<size_t>(r + kernelHeight - 1) * stripeWidth], I[r] + c0, n);
         }
       }
-      I[r][c] = value;
     }
   }
 }
@@ -537,8 +674,7 @@ void vpImageMorphology::imageOperation(vpImage<T> &I, vpPixelOperation<T> *opera
 template <typename T>
 void vpImageMorphology::erosion(vpImage<T> &I, const int &size)
 {
-  vpPixelOperationMin<T> operation;
-  vpImageMorphology::imageOperation(I, &operation, size);
+  vpImageMorphology::erosion(I, size, size);
 }
 
 /**
@@ -568,9 +704,178 @@ void vpImageMorphology::erosion(vpImage<T> &I, const int &size)
  */
 template<typename T>
 void vpImageMorphology::dilatation(vpImage<T> &I, const int &size)
+{
+  vpImageMorphology::dilatation(I, size, size);
+}
+
+/*!
+ * \brief Erosion with a flat rectangular structuring element of \b width x \b height pixels, that
+ * corresponds to a min operator on the window centered on each pixel.
+ *
+ * The cost per pixel does not depend on the size of the structuring element.
+ *
+ * \tparam T Any type of image, except vpRGBa .
+ * \param[out] I The image to which the erosion must be applied.
+ * \param[in] width Odd width of the structuring element.
+ * \param[in] height Odd height of the structuring element.
+ *
+ * \sa dilatation(vpImage<T> &, const int &, const int &)
+ */
+template <typename T>
+void vpImageMorphology::erosion(vpImage<T> &I, const int &width, const int &height)
+{
+  vpPixelOperationMin<T> operation;
+  vpImageMorphology::imageOperation(I, operation, std::numeric_limits<T>::max(), width, height);
+}
+
+/*!
+ * \brief Dilatation with a flat rectangular structuring element of \b width x \b height pixels, that
+ * corresponds to a max operator on the window centered on each pixel.
+ *
+ * The cost per pixel does not depend on the size of the structuring element.
+ *
+ * \tparam T Any type of image, except vpRGBa .
+ * \param[out] I The image to which the dilatation must be applied.
+ * \param[in] width Odd width of the structuring element.
+ * \param[in] height Odd height of the structuring element.
+ *
+ * \sa erosion(vpImage<T> &, const int &, const int &)
+ */
+template <typename T>
+void vpImageMorphology::dilatation(vpImage<T> &I, const int &width, const int &height)
 {
   vpPixelOperationMax<T> operation;
-  vpImageMorphology::imageOperation(I, &operation, size);
+  const T neutral = std::numeric_limits<T>::is_integer ? std::numeric_limits<T>::min()
+    : static_cast<T>(-std::numeric_limits<T>::max());
+  vpImageMorphology::imageOperation(I, operation, neutral, width, height);
+}
+
+/*!
+ * \brief Opening, that is an erosion followed by a dilatation, with a flat square structuring element.
+ * It removes the bright details smaller than the structuring element.
+ *
+ * \tparam T Any type of image, except vpRGBa .
+ * \param[out] I The image to process.
+ * \param[in] size Odd size of the structuring element.
+ */
+template <typename T>
+void vpImageMorphology::opening(vpImage<T> &I, const int &size)
+{
+  vpImageMorphology::opening(I, size, size);
+}
+
+/*!
+ * \brief Opening, that is an erosion followed by a dilatation, with a flat rectangular structuring element.
+ * It removes the bright details smaller than the structuring element.
+ *
+ * \tparam T Any type of image, except vpRGBa .
+ * \param[out] I The image to process.
+ * \param[in] width Odd width of the structuring element.
+ * \param[in] height Odd height of the structuring element.
+ */
+template <typename T>
+void vpImageMorphology::opening(vpImage<T> &I, const int &width, const int &height)
+{
+  vpImageMorphology::erosion(I, width, height);
+  vpImageMorphology::dilatation(I, width, height);
+}
+
+/*!
+ * \brief Closing, that is a dilatation followed by an erosion, with a flat square structuring element.
+ * It removes the dark details smaller than the structuring element.
+ *
+ * \tparam T Any type of image, except vpRGBa .
+ * \param[out] I The image to process.
+ * \param[in] size Odd size of the structuring element.
+ */
+template <typename T>
+void vpImageMorphology::closing(vpImage<T> &I, const int &size)
+{
+  vpImageMorphology::closing(I, size, size);
+}
+
+/*!
+ * \brief Closing, that is a dilatation followed by an erosion, with a flat rectangular structuring element.
+ * It removes the dark details smaller than the structuring element.
+ *
+ * \tparam T Any type of image, except vpRGBa .
+ * \param[out] I The image to process.
+ * \param[in] width Odd width of the structuring element.
+ * \param[in] height Odd height of the structuring element.
+ */
+template <typename T>
+void vpImageMorphology::closing(vpImage<T> &I, const int &width, const int &height)
+{
+  vpImageMorphology::dilatation(I, width, height);
+  vpImageMorphology::erosion(I, width, height);
+}
+
+/*!
+ * \brief White top-hat, that is the difference between the image and its opening with a flat square
+ * structuring element. It keeps the bright details smaller than the structuring element.
+ *
+ * \tparam T Any type of image, except vpRGBa .
+ * \param[out] I The image to process.
+ * \param[in] size Odd size of the structuring element.
+ */
+template <typename T>
+void vpImageMorphology::topHat(vpImage<T> &I, const int &size)
+{
+  vpImageMorphology::topHat(I, size, size);
+}
+
+/*!
+ * \brief White top-hat, that is the difference between the image and its opening with a flat rectangular
+ * structuring element. It keeps the bright details smaller than the structuring element.
+ *
+ * \tparam T Any type of image, except vpRGBa .
+ * \param[out] I The image to process.
+ * \param[in] width Odd width of the structuring element.
+ * \param[in] height Odd height of the structuring element.
+ */
+template <typename T>
+void vpImageMorphology::topHat(vpImage<T> &I, const int &width, const int &height)
+{
+  vpImage<T> I_open = I;
+  vpImageMorphology::opening(I_open, width, height);
+  const unsigned int size = I.getSize();
+  for (unsigned int i = 0; i < size; ++i) {
+    I.bitmap[i] = static_cast<T>(I.bitmap[i] - I_open.bitmap[i]);
+  }
+}
+
+/*!
+ * \brief Black top-hat, that is the difference between the closing of the image with a flat square
+ * structuring element and the image. It keeps the dark details smaller than the structuring element.
+ *
+ * \tparam T Any type of image, except vpRGBa .
+ * \param[out] I The image to process.
+ * \param[in] size Odd size of the structuring element.
+ */
+template <typename T>
+void vpImageMorphology::blackHat(vpImage<T> &I, const int &size)
+{
+  vpImageMorphology::blackHat(I, size, size);
+}
+
+/*!
+ * \brief Black top-hat, that is the difference between the closing of the image with a flat rectangular
+ * structuring element and the image. It keeps the dark details smaller than the structuring element.
+ *
+ * \tparam T Any type of image, except vpRGBa .
+ * \param[out] I The image to process.
+ * \param[in] width Odd width of the structuring element.
+ * \param[in] height Odd height of the structuring element.
+ */
+template <typename T>
+void vpImageMorphology::blackHat(vpImage<T> &I, const int &width, const int &height)
+{
+  vpImage<T> I_close = I;
+  vpImageMorphology::closing(I_close, width, height);
+  const unsigned int size = I.getSize();
+  for (unsigned int i = 0; i < size; ++i) {
+    I.bitmap[i] = static_cast<T>(I_close.bitmap[i] - I.bitmap[i]);
+  }
 }
 END_VISP_NAMESPACE
 
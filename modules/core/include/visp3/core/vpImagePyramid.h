@@ -0,0 +1,142 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Gaussian image pyramid shared by the consumers of a same image.
+ */
+
+/*!
+ * \file vpImagePyramid.h
+ * \brief Gaussian image pyramid shared by the consumers of a same image.
+ */
+
+#ifndef VP_IMAGE_PYRAMID_H
+#define VP_IMAGE_PYRAMID_H
+
+#include <map>
+#include <memory>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+
+#if defined(VISP_HAVE_THREADS)
+#include <mutex>
+#endif
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpImagePyramid
+ *
+ * \ingroup group_core_image
+ *
+ * \brief Pyramid of a grayscale image, whose levels are computed once on demand and then shared by all the
+ * algorithms that process the same image.
+ *
+ * Level 0 is the original image. Each level \f$l>0\f$ has half the size of the level \f$l-1\f$, and is either:
+ * - Gaussian filtered and subsampled with vpImageFilter::getGaussPyramidal(), see getLevel(),
+ * - or only subsampled, keeping one pixel out of \f$2^l\f$ along each direction, see getDecimatedLevel().
+ *
+ * The image gradients of each Gaussian level can also be requested, see getGradX() and getGradY().
+ *
+ * Nothing is computed until it is requested, and each level is computed only once, so that a frame-scoped pyramid
+ * can be passed to several trackers or detectors without decimating the same image several times:
+ * \code
+ * vpImagePyramid pyramid;
+ * while (...) {
+ *   // Acquire a new image I
+ *   pyramid.init(I);
+ *   klt.track(pyramid);             // vpKlt
+ *   templateTracker.track(pyramid); // vpTemplateTracker
+ *   edgeTracker.track(pyramid);     // vpMbEdgeTracker
+ * }
+ * \endcode
+ *
+ * The images are shared between the copies of a pyramid, so that copying a pyramid does not copy its images. The
+ * copies are nevertheless independent: the levels computed afterwards in a copy, or a call to init() or clear(), do
+ * not affect the other copies.
+ *
+ * When ViSP is built with threads support, the levels can be requested concurrently from several threads.
+ */
+class VISP_EXPORT vpImagePyramid
+{
+public:
+  vpImagePyramid();
+  explicit vpImagePyramid(const vpImage<unsigned char> &I);
+  vpImagePyramid(const vpImagePyramid &pyramid);
+
+  void clear();
+
+  const vpImage<unsigned char> &getDecimatedLevel(unsigned int level) const;
+  const vpImage<float> &getGradX(unsigned int level) const;
+  const vpImage<float> &getGradY(unsigned int level) const;
+
+  /*!
+   * Get the height of a pyramid level.
+   * \param level : Pyramid level.
+   */
+  inline unsigned int getHeight(unsigned int level = 0) const { return m_I->getHeight() >> level; }
+
+  /*!
+   * Get the original image, that is the level 0 of the pyramid.
+   */
+  inline const vpImage<unsigned char> &getImage() const { return *m_I; }
+
+  const vpImage<unsigned char> &getLevel(unsigned int level) const;
+
+  /*!
+   * Get the width of a pyramid level.
+   * \param level : Pyramid level.
+   */
+  inline unsigned int getWidth(unsigned int level = 0) const { return m_I->getWidth() >> level; }
+
+  void init(const vpImage<unsigned char> &I);
+
+  vpImagePyramid &operator=(const vpImagePyramid &pyramid);
+
+  void swap(vpImagePyramid &pyramid);
+
+private:
+  const vpImage<unsigned char> &computeLevel(unsigned int level) const;
+  const vpImage<unsigned char> &computeDecimatedLevel(unsigned int level) const;
+  void checkLevel(unsigned int level) const;
+
+  typedef std::shared_ptr<vpImage<unsigned char> > vpImagePtr;
+  typedef std::shared_ptr<vpImage<float> > vpGradientPtr;
+
+  vpImagePtr m_I; //!< Original image
+  mutable std::map<unsigned int, vpImagePtr> m_levels; //!< Gaussian levels already computed
+  mutable std::map<unsigned int, vpImagePtr> m_decimatedLevels; //!< Decimated levels already computed
+  mutable std::map<unsigned int, vpGradientPtr> m_gradX; //!< Gradients along the columns already computed
+  mutable std::map<unsigned int, vpGradientPtr> m_gradY; //!< Gradients along the rows already computed
+#if defined(VISP_HAVE_THREADS)
+  mutable std::mutex m_mutex; //!< Protect the lazily computed levels
+#endif
+};
+END_VISP_NAMESPACE
+#endif
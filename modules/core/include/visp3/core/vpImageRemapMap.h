@@ -0,0 +1,128 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2026 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Precomputed fixed-point remapping table.
+ */
+
+/*!
+ * \file vpImageRemapMap.h
+ * \brief Precomputed fixed-point remapping table used by vpImageTools::remap().
+ */
+
+#ifndef VP_IMAGE_REMAP_MAP_H
+#define VP_IMAGE_REMAP_MAP_H
+
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpArray2D.h>
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpMatrix.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpImageRemapMap
+ * \ingroup group_core_image
+ *
+ * \brief Compact fixed-point remapping table for bilinear image resampling.
+ *
+ * For each destination pixel the table stores the index in the source bitmap of the upper-left pixel of the
+ * \f$ 2 \times 2 \f$ interpolation neighbourhood and the two bilinear weights quantized on
+ * vpImageRemapMap::weightBits bits. Destination pixels without source correspondence have an index equal to -1 and
+ * are set to 0 by vpImageTools::remap().
+ *
+ * The same table can be built from an undistortion model or from a warping matrix, so that an image stream can
+ * be undistorted or rectified by computing the geometry only once:
+ * \code
+ * vpImageRemapMap map;
+ * map.initUndistort(cam, I.getWidth(), I.getHeight());
+ * while (acquire(I)) {
+ *   vpImageTools::remap(I, map, I_undist);
+ * }
+ * \endcode
+ *
+ * \sa vpImageTools::remap(const vpImage<unsigned char> &, const vpImageRemapMap &, vpImage<unsigned char> &, unsigned int)
+ */
+class VISP_EXPORT vpImageRemapMap
+{
+public:
+  //! Number of bits of the bilinear weights.
+  static const unsigned int weightBits = 7;
+  //! Fixed-point value of a unit weight.
+  static const unsigned int weightOne = 1 << weightBits;
+
+  vpImageRemapMap();
+
+  /*!
+   * Get the bilinear weights, two per destination pixel stored as \f$ (\Delta u, \Delta v) \f$ pairs in
+   * \f$ [0, \f$ vpImageRemapMap::weightOne \f$ ] \f$.
+   */
+  inline const std::vector<unsigned char> &getWeights() const { return m_weights; }
+
+  //! Get the destination image height.
+  inline unsigned int getHeight() const { return m_height; }
+
+  /*!
+   * Get the source bitmap index of the upper-left pixel of the interpolation neighbourhood of each destination
+   * pixel, -1 when the destination pixel has no source correspondence.
+   */
+  inline const std::vector<int> &getOffsets() const { return m_offsets; }
+
+  //! Get the expected source image height.
+  inline unsigned int getSrcHeight() const { return m_srcHeight; }
+
+  //! Get the expected source image width.
+  inline unsigned int getSrcWidth() const { return m_srcWidth; }
+
+  //! Get the destination image width.
+  inline unsigned int getWidth() const { return m_width; }
+
+  void init(unsigned int srcWidth, unsigned int srcHeight, const vpArray2D<int> &mapU, const vpArray2D<int> &mapV,
+            const vpArray2D<float> &mapDu, const vpArray2D<float> &mapDv);
+
+  void initUndistort(const vpCameraParameters &cam, unsigned int width, unsigned int height);
+
+  void initWarp(const vpMatrix &T, unsigned int srcWidth, unsigned int srcHeight, unsigned int dstWidth,
+                unsigned int dstHeight, bool pixelCenter = false);
+
+private:
+  void resize(unsigned int srcWidth, unsigned int srcHeight, unsigned int dstWidth, unsigned int dstHeight);
+  void set(unsigned int index, double x, double y);
+
+  unsigned int m_srcWidth;
+  unsigned int m_srcHeight;
+  unsigned int m_width;
+  unsigned int m_height;
+  std::vector<int> m_offsets;
+  std::vector<unsigned char> m_weights;
+};
+END_VISP_NAMESPACE
+
+#endif
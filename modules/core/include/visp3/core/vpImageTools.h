@@ -50,6 +50,7 @@
 #include <visp3/core/vpHSV.h>
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageException.h>
+#include <visp3/core/vpImageRemapMap.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpRect.h>
 #include <visp3/core/vpRectOriented.h>
@@ -366,6 +367,10 @@ public:
                     const vpArray2D<float> &mapDu, const vpArray2D<float> &mapDv, vpImage<unsigned char> &Iundist);
   static void remap(const vpImage<vpRGBa> &I, const vpArray2D<int> &mapU, const vpArray2D<int> &mapV,
                     const vpArray2D<float> &mapDu, const vpArray2D<float> &mapDv, vpImage<vpRGBa> &Iundist);
+  static void remap(const vpImage<unsigned char> &I, const vpImageRemapMap &map, vpImage<unsigned char> &Idst,
+                    unsigned int nThreads = 0);
+  static void remap(const vpImage<vpRGBa> &I, const vpImageRemapMap &map, vpImage<vpRGBa> &Idst,
+                    unsigned int nThreads = 0);
 
   template <class Type>
   static void resize(const vpImage<Type> &I, vpImage<Type> &Ires, unsigned int width, unsigned int height,
@@ -387,10 +392,14 @@ public:
   static void undistort(const vpImage<Type> &I, vpArray2D<int> mapU, vpArray2D<int> mapV, vpArray2D<float> mapDu,
                         vpArray2D<float> mapDv, vpImage<Type> &newI);
 
+  template <class Type>
+  static void undistort(const vpImage<Type> &I, const vpImageRemapMap &map, vpImage<Type> &newI,
+                        unsigned int nThreads = 0);
+
   template <class Type>
   static void warpImage(const vpImage<Type> &src, const vpMatrix &T, vpImage<Type> &dst,
                         const vpImageInterpolationType &interpolation = INTERPOLATION_NEAREST,
-                        bool fixedPointArithmetic = true, bool pixelCenter = false);
+                        bool fixedPointArithmetic = true, bool pixelCenter = false, unsigned int nThreads = 0);
 
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
   /*!
@@ -1100,6 +1109,23 @@ void vpImageTools::undistort(const vpImage<Type> &I, vpArray2D<int> mapU, vpArra
   remap(I, mapU, mapV, mapDu, mapDv, newI);
 }
 
+/*!
+  Undistort an image with a precomputed fixed-point remapping table.
+
+  \param I : Input image to undistort.
+  \param map : Undistortion table built once with vpImageRemapMap::initUndistort().
+  \param newI : Undistorted image.
+  \param nThreads : Number of threads to use if OpenMP is available (zero will use the default number of threads).
+
+  \sa vpImageRemapMap, remap(const vpImage<unsigned char> &, const vpImageRemapMap &, vpImage<unsigned char> &, unsigned int)
+*/
+template <class Type>
+void vpImageTools::undistort(const vpImage<Type> &I, const vpImageRemapMap &map, vpImage<Type> &newI,
+                             unsigned int nThreads)
+{
+  remap(I, map, newI, nThreads);
+}
+
 /*!
   Flip vertically the input image and give the result in the output image.
 
@@ -51,10 +51,16 @@ BEGIN_VISP_NAMESPACE
   possible. Otherwise (e.g. the input image is too big) it fallbacks to the default implementation.
   \param pixelCenter : If true, pixel coordinates are at (0.5, 0.5), otherwise at (0,0). Fixed-point
   arithmetic cannot be used with `pixelCenter` option.
+  \param nThreads : Number of threads to use if OpenMP is available (zero will use the default number of threads).
+  Destination rows are warped in parallel, the result does not depend on the number of threads.
+
+  \note To warp a sequence of images with the same bilinear transformation, the geometry can be computed once with
+  vpImageRemapMap::initWarp() and applied with remap().
 */
 template <class Type>
 void vpImageTools::warpImage(const vpImage<Type> &src, const vpMatrix &T, vpImage<Type> &dst,
-                             const vpImageInterpolationType &interpolation, bool fixedPointArithmetic, bool pixelCenter)
+                             const vpImageInterpolationType &interpolation, bool fixedPointArithmetic, bool pixelCenter,
+                             unsigned int nThreads)
 {
   const unsigned int expectedNbCols = 3, expectedNbRows1stOpt = 2, expectedNbRows2ndOpt = 3;
   if (((T.getRows() != expectedNbRows1stOpt) && (T.getRows() != expectedNbRows2ndOpt)) || (T.getCols() != expectedNbCols)) {
@@ -100,6 +106,14 @@ void vpImageTools::warpImage(const vpImage<Type> &src, const vpMatrix &T, vpImag
       checkFixedPoint(dst.getWidth() - 1, dst.getHeight() - 1, M, affine);
   }
 
+#if defined(_OPENMP)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#else
+  (void)nThreads;
+#endif
+
   if (interp_NN) {
     // nearest neighbor interpolation
     warpNN(src, M, dst, affine, pixelCenter, fixedPointArithmetic);
@@ -137,9 +151,13 @@ void vpImageTools::warpNN(const vpImage<Type> &src, const vpMatrix &T, vpImage<T
     if (affine) {
       unsigned int dst_height = dst.getHeight();
       unsigned int dst_width = dst.getWidth();
-      for (unsigned int i = 0; i < dst_height; ++i) {
-        int32_t xi = a2_i32;
-        int32_t yi = a5_i32;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+      for (int i_ = 0; i_ < static_cast<int>(dst_height); ++i_) {
+        const unsigned int i = static_cast<unsigned int>(i_);
+        int32_t xi = a2_i32 + (static_cast<int32_t>(i) * a1_i32);
+        int32_t yi = a5_i32 + (static_cast<int32_t>(i) * a4_i32);
 
         for (unsigned int j = 0; j < dst_width; ++j) {
           if ((yi >= 0) && (yi < height_1_i32) && (xi >= 0) && (xi < width_1_i32)) {
@@ -154,9 +172,6 @@ void vpImageTools::warpNN(const vpImage<Type> &src, const vpMatrix &T, vpImage<T
           xi += a0_i32;
           yi += a3_i32;
         }
-
-        a2_i32 += a1_i32;
-        a5_i32 += a4_i32;
       }
     }
     else {
@@ -164,10 +179,14 @@ void vpImageTools::warpNN(const vpImage<Type> &src, const vpMatrix &T, vpImage<T
       unsigned int dst_width = dst.getWidth();
       int src_height = static_cast<int>(src.getHeight());
       int src_width = static_cast<int>(src.getWidth());
-      for (unsigned int i = 0; i < dst_height; ++i) {
-        int64_t xi = a2_i32;
-        int64_t yi = a5_i32;
-        int64_t wi = a8_i32;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+      for (int i_ = 0; i_ < static_cast<int>(dst_height); ++i_) {
+        const unsigned int i = static_cast<unsigned int>(i_);
+        int64_t xi = a2_i32 + (static_cast<int32_t>(i) * a1_i32);
+        int64_t yi = a5_i32 + (static_cast<int32_t>(i) * a4_i32);
+        int64_t wi = a8_i32 + (static_cast<int32_t>(i) * a7_i32);
 
         for (unsigned int j = 0; j < dst_width; ++j) {
           bool cond_on_y = (yi >= 0) && (yi <= ((src_height - 1) * wi));
@@ -187,10 +206,6 @@ void vpImageTools::warpNN(const vpImage<Type> &src, const vpMatrix &T, vpImage<T
           yi += a3_i32;
           wi += a6_i32;
         }
-
-        a2_i32 += a1_i32;
-        a5_i32 += a4_i32;
-        a8_i32 += a7_i32;
       }
     }
   }
@@ -210,7 +225,11 @@ void vpImageTools::warpNN(const vpImage<Type> &src, const vpMatrix &T, vpImage<T
 
     unsigned int dst_height = dst.getHeight();
     unsigned int dst_width = dst.getWidth();
-    for (unsigned int i = 0; i < dst_height; ++i) {
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i_ = 0; i_ < static_cast<int>(dst_height); ++i_) {
+      const unsigned int i = static_cast<unsigned int>(i_);
       for (unsigned int j = 0; j < dst_width; ++j) {
         double x = ((a0 * (centerCorner ? (j + 0.5) : j)) + (a1 * (centerCorner ? (i + 0.5) : i))) + a2;
         double y = ((a3 * (centerCorner ? (j + 0.5) : j)) + (a4 * (centerCorner ? (i + 0.5) : i))) + a5;
@@ -261,9 +280,13 @@ void vpImageTools::warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpIma
     if (affine) {
       unsigned int dst_height = dst.getHeight();
       unsigned int dst_width = dst.getWidth();
-      for (unsigned int i = 0; i < dst_height; ++i) {
-        int64_t xi_ = a2_i64;
-        int64_t yi_ = a5_i64;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+      for (int i_ = 0; i_ < static_cast<int>(dst_height); ++i_) {
+        const unsigned int i = static_cast<unsigned int>(i_);
+        int64_t xi_ = a2_i64 + (static_cast<int64_t>(i) * a1_i64);
+        int64_t yi_ = a5_i64 + (static_cast<int64_t>(i) * a4_i64);
 
         for (unsigned int j = 0; j < dst_width; ++j) {
           if ((yi_ >= 0) && (yi_ < height_i64) && (xi_ >= 0) && (xi_ < width_i64)) {
@@ -310,9 +333,6 @@ void vpImageTools::warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpIma
           xi_ += a0_i64;
           yi_ += a3_i64;
         }
-
-        a2_i64 += a1_i64;
-        a5_i64 += a4_i64;
       }
     }
     else {
@@ -320,10 +340,14 @@ void vpImageTools::warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpIma
       unsigned int dst_width = dst.getWidth();
       int src_height = static_cast<int>(src.getHeight());
       int src_width = static_cast<int>(src.getWidth());
-      for (unsigned int i = 0; i < dst_height; ++i) {
-        int64_t xi = a2_i64;
-        int64_t yi = a5_i64;
-        int64_t wi = a8_i64;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+      for (int i_ = 0; i_ < static_cast<int>(dst_height); ++i_) {
+        const unsigned int i = static_cast<unsigned int>(i_);
+        int64_t xi = a2_i64 + (static_cast<int64_t>(i) * a1_i64);
+        int64_t yi = a5_i64 + (static_cast<int64_t>(i) * a4_i64);
+        int64_t wi = a8_i64 + (static_cast<int64_t>(i) * a7_i64);
 
         for (unsigned int j = 0; j < dst_width; ++j) {
           bool cond_on_y = (yi >= 0) && (yi <= ((src_height - 1) * wi));
@@ -370,10 +394,6 @@ void vpImageTools::warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpIma
           yi += a3_i64;
           wi += a6_i64;
         }
-
-        a2_i64 += a1_i64;
-        a5_i64 += a4_i64;
-        a8_i64 += a7_i64;
       }
     }
   }
@@ -395,7 +415,11 @@ void vpImageTools::warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpIma
     unsigned int dst_width = dst.getWidth();
     int src_height = static_cast<int>(src.getHeight());
     int src_width = static_cast<int>(src.getWidth());
-    for (unsigned int i = 0; i < dst_height; ++i) {
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i_ = 0; i_ < static_cast<int>(dst_height); ++i_) {
+      const unsigned int i = static_cast<unsigned int>(i_);
       for (unsigned int j = 0; j < dst_width; ++j) {
         double x = (a0 * (centerCorner ? (j + 0.5) : j)) + (a1 * (centerCorner ? (i + 0.5) : i)) + a2;
         double y = (a3 * (centerCorner ? (j + 0.5) : j)) + (a4 * (centerCorner ? (i + 0.5) : i)) + a5;
@@ -477,9 +501,13 @@ inline void vpImageTools::warpLinearFixedPointNotCenter(const vpImage<vpRGBa> &s
     int src_height = static_cast<int>(src.getHeight());
     int src_width = static_cast<int>(src.getWidth());
     const unsigned char aChannelVal = 255;
-    for (unsigned int i = 0; i < dst_height; ++i) {
-      int64_t xi = a2_i64;
-      int64_t yi = a5_i64;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i_ = 0; i_ < static_cast<int>(dst_height); ++i_) {
+      const unsigned int i = static_cast<unsigned int>(i_);
+      int64_t xi = a2_i64 + (static_cast<int64_t>(i) * a1_i64);
+      int64_t yi = a5_i64 + (static_cast<int64_t>(i) * a4_i64);
 
       for (unsigned int j = 0; j < dst_width; ++j) {
         if ((yi >= 0) && (yi < height_i64) && (xi >= 0) && (xi < width_i64)) {
@@ -552,9 +580,6 @@ inline void vpImageTools::warpLinearFixedPointNotCenter(const vpImage<vpRGBa> &s
         xi += a0_i64;
         yi += a3_i64;
       }
-
-      a2_i64 += a1_i64;
-      a5_i64 += a4_i64;
     }
   }
   else {
@@ -563,10 +588,14 @@ inline void vpImageTools::warpLinearFixedPointNotCenter(const vpImage<vpRGBa> &s
     int src_height = static_cast<int>(src.getHeight());
     int src_width = static_cast<int>(src.getWidth());
     const unsigned char aChannelVal = 255;
-    for (unsigned int i = 0; i < dst_height; ++i) {
-      int64_t xi = a2_i64;
-      int64_t yi = a5_i64;
-      int64_t wi = a8_i64;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i_ = 0; i_ < static_cast<int>(dst_height); ++i_) {
+      const unsigned int i = static_cast<unsigned int>(i_);
+      int64_t xi = a2_i64 + (static_cast<int64_t>(i) * a1_i64);
+      int64_t yi = a5_i64 + (static_cast<int64_t>(i) * a4_i64);
+      int64_t wi = a8_i64 + (static_cast<int64_t>(i) * a7_i64);
 
       for (unsigned int j = 0; j < dst_width; ++j) {
         if ((yi >= 0) && (yi <= ((src_height - 1) * wi)) && (xi >= 0) &&
@@ -630,10 +659,6 @@ inline void vpImageTools::warpLinearFixedPointNotCenter(const vpImage<vpRGBa> &s
         yi += a3_i64;
         wi += a6_i64;
       }
-
-      a2_i64 += a1_i64;
-      a5_i64 += a4_i64;
-      a8_i64 += a7_i64;
     }
   }
 
@@ -663,7 +688,11 @@ inline void vpImageTools::warpLinear(const vpImage<vpRGBa> &src, const vpMatrix
     int src_height = static_cast<int>(src.getHeight());
     int src_width = static_cast<int>(src.getWidth());
     const unsigned char aChannelVal = 255;
-    for (unsigned int i = 0; i < dst_height; ++i) {
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i_ = 0; i_ < static_cast<int>(dst_height); ++i_) {
+      const unsigned int i = static_cast<unsigned int>(i_);
       for (unsigned int j = 0; j < dst_width; ++j) {
         double x = (a0 * (centerCorner ? (j + 0.5) : j)) + (a1 * (centerCorner ? (i + 0.5) : i)) + a2;
         double y = (a3 * (centerCorner ? (j + 0.5) : j)) + (a4 * (centerCorner ? (i + 0.5) : i)) + a5;
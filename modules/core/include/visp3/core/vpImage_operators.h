@@ -266,11 +266,11 @@ template <class Type> vpImage<Type> &vpImage<Type>::operator=(const vpImage<Type
 template <class Type> vpImage<Type> &vpImage<Type>::operator=(vpImage<Type> &&other)
 {
   if (row != nullptr) {
-    delete[] row;
+    deallocateArray(row);
   }
   row = other.row;
   if (bitmap != nullptr && hasOwnership) {
-    delete[] bitmap;
+    deallocateArray(bitmap);
   }
   bitmap = other.bitmap;
 
@@ -1276,6 +1276,12 @@ public:
 private:
   static unsigned int m_lapack_min_size;
   static const unsigned int m_lapack_min_size_default;
+  static const unsigned int m_builtin_gemm_min_size;
+
+  static void builtin_dgemm(unsigned int M, unsigned int N, unsigned int K, const double *a_data, unsigned int lda,
+                            const double *b_data, unsigned int ldb, double *c_data, unsigned int ldc);
+  static void builtin_dgemv(unsigned int M, unsigned int N, const double *a_data, unsigned int lda,
+                            const double *x_data, double *y_data);
 
 #if defined(VISP_HAVE_LAPACK)
   static void blas_dgemm(char trans_a, char trans_b, unsigned int M_, unsigned int N_, unsigned int K_, double alpha,
@@ -1303,6 +1309,7 @@ private:
 #if defined(VISP_USE_MSVC) && defined(visp_EXPORTS)
 const __declspec(selectany) unsigned int vpMatrix::m_lapack_min_size_default = 0;
 __declspec(selectany) unsigned int vpMatrix::m_lapack_min_size = vpMatrix::m_lapack_min_size_default;
+const __declspec(selectany) unsigned int vpMatrix::m_builtin_gemm_min_size = 16;
 #endif
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -41,6 +41,7 @@
 
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpArray2D.h>
+#include <visp3/core/vpFixedSizeArray2D.h>
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <visp3/core/vpPoseVector.h>
 #include <visp3/core/vpQuaternionVector.h>
@@ -126,7 +127,7 @@ BEGIN_VISP_NAMESPACE
   }
   \endcode
 */
-class VISP_EXPORT vpRotationMatrix : public vpArray2D<double>
+class VISP_EXPORT vpRotationMatrix : public vpFixedSizeArray2D<double, 3, 3>
 {
 public:
   vpRotationMatrix();
@@ -228,8 +229,6 @@ public:
 
 protected:
   unsigned int m_index;
-private:
-  static const unsigned int constr_val_3;
 };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
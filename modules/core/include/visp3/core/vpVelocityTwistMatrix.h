@@ -36,6 +36,7 @@
 
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpArray2D.h>
+#include <visp3/core/vpFixedSizeArray2D.h>
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <visp3/core/vpRotationMatrix.h>
@@ -171,7 +172,7 @@ class vpMatrix;
   }
   \endcode
 */
-class VISP_EXPORT vpVelocityTwistMatrix : public vpArray2D<double>
+class VISP_EXPORT vpVelocityTwistMatrix : public vpFixedSizeArray2D<double, 6, 6>
 {
   friend class vpMatrix;
 
@@ -244,8 +245,6 @@ public:
   VP_DEPRECATED void setIdentity();
 //@}
 #endif
-private:
-  static const unsigned constr_val_6;
 };
 END_VISP_NAMESPACE
 #endif
@@ -42,8 +42,10 @@
 #include <visp3/core/vpConfig.h>
 
 #ifndef VISP_SKIP_BAYER_CONVERSION
+#include <algorithm>
 #include <cassert>
-
+#include <limits>
+#include <vector>
 
 #include <visp3/core/vpMath.h>
 
@@ -51,65 +53,172 @@
 // "-Wunused-value"
 #define m_assert(msg, expr) assert(((void)(msg), (expr)))
 
-// Bilinear
-template <typename T> T demosaicPhiBilinear(const T *bayer, unsigned int width, unsigned int i, unsigned int j)
-{
-  return static_cast<T>(0.5f * bayer[(i - 1) * width + j] + 0.5f * bayer[(i + 1) * width + j]);
-}
+// Colors of the Bayer pixels, that are also the indexes of the channels in the RGBa image
+enum vpBayerColor { BAYER_RED = 0, BAYER_GREEN = 1, BAYER_BLUE = 2 };
 
-template <typename T> T demosaicThetaBilinear(const T *bayer, unsigned int width, unsigned int i, unsigned int j)
-{
-  return static_cast<T>(0.5f * bayer[i * width + j - 1] + 0.5f * bayer[i * width + j + 1]);
-}
-
-template <typename T> T demosaicCheckerBilinear(const T *bayer, unsigned int width, unsigned int i, unsigned int j)
-{
-  return static_cast<T>(0.25f * bayer[(i - 1) * width + j - 1] + 0.25f * bayer[(i - 1) * width + j + 1] +
-                        0.25f * bayer[(i + 1) * width + j - 1] + 0.25f * bayer[(i + 1) * width + j + 1]);
-}
+/*
+ * The interior of the image is processed row by row. For each row, the four interpolations are first computed for all
+ * the columns in contiguous buffers, using integer arithmetic so that the loops are vectorized by the compiler:
+ * - phi: vertical interpolation, used for the color of the pixels above and below a green pixel,
+ * - theta: horizontal interpolation, used for the color of the pixels at the left and right of a green pixel,
+ * - checker: diagonal interpolation, used for the red (blue) value of a blue (red) pixel,
+ * - cross: interpolation of the 4-neighbours, used for the green value of a red or blue pixel.
+ * The RGBa row is then built by picking the right buffer for each channel and each column parity, without any test on
+ * the pixel position.
+ *
+ * The integer expressions give exactly the same values as the float expressions of the bilinear and Malvar-He-Cutler
+ * formulas (truncation for bilinear, rounding and saturation for Malvar), since all the float intermediate values are
+ * exact.
+ */
 
-template <typename T> T demosaicCrossBilinear(const T *bayer, unsigned int width, unsigned int i, unsigned int j)
+// Bilinear
+template <typename T>
+void demosaicRowBilinear(const T *bayer, unsigned int width, unsigned int i, unsigned int j_begin, unsigned int j_end,
+                         T *phi, T *theta, T *checker, T *cross)
 {
-  return static_cast<T>(0.25f * bayer[(i - 1) * width + j] + 0.25f * bayer[i * width + j - 1] +
-                        0.25f * bayer[i * width + j + 1] + 0.25f * bayer[(i + 1) * width + j]);
+  const T *r_1 = bayer + (i - 1) * width;
+  const T *r0 = bayer + i * width;
+  const T *r1 = bayer + (i + 1) * width;
+  for (size_t j = j_begin; j < j_end; ++j) {
+    phi[j] = static_cast<T>((static_cast<int>(r_1[j]) + r1[j]) >> 1);
+    theta[j] = static_cast<T>((static_cast<int>(r0[j - 1]) + r0[j + 1]) >> 1);
+    checker[j] = static_cast<T>((static_cast<int>(r_1[j - 1]) + r_1[j + 1] + r1[j - 1] + r1[j + 1]) >> 2);
+    cross[j] = static_cast<T>((static_cast<int>(r_1[j]) + r0[j - 1] + r0[j + 1] + r1[j]) >> 2);
+  }
 }
 
 // Malvar
-template <typename T> T demosaicPhiMalvar(const T *bayer, unsigned int width, unsigned int i, unsigned int j)
+template <typename T> inline T demosaicSaturateMalvar(int v16, int max_value)
 {
-  return VISP_NAMESPACE_ADDRESSING vpMath::saturate<T>(
-      (-bayer[(i - 2) * width + j] - bayer[(i - 1) * width + j - 1] + 4 * bayer[(i - 1) * width + j] -
-       bayer[(i - 1) * width + j + 1] + 0.5f * bayer[i * width + j - 2] + 5 * bayer[i * width + j] +
-       0.5f * bayer[i * width + j + 2] - bayer[(i + 1) * width + j - 1] + 4 * bayer[(i + 1) * width + j] -
-       bayer[(i + 1) * width + j + 1] - bayer[(i + 2) * width + j]) *
-      0.125f);
+  // v16 is 16 times the interpolated value, rounded half away from zero and saturated. The negative values, for
+  // which the rounding differs, are saturated to 0 anyway.
+  const int v = (v16 + 8) >> 4;
+  return static_cast<T>(std::min<int>(std::max<int>(v, 0), max_value));
 }
 
-template <typename T> T demosaicThetaMalvar(const T *bayer, unsigned int width, unsigned int i, unsigned int j)
+template <typename T>
+void demosaicRowMalvar(const T *bayer, unsigned int width, unsigned int i, unsigned int j_begin, unsigned int j_end,
+                       T *phi, T *theta, T *checker, T *cross)
 {
-  return VISP_NAMESPACE_ADDRESSING vpMath::saturate<T>((0.5f * bayer[(i - 2) * width + j] - bayer[(i - 1) * width + j - 1] -
-                                                        bayer[(i - 1) * width + j + 1] - bayer[i * width + j - 2] + 4 * bayer[i * width + j - 1] +
-                                                        5 * bayer[i * width + j] + 4 * bayer[i * width + j + 1] - bayer[i * width + j + 2] -
-                                                        bayer[(i + 1) * width + j - 1] - bayer[(i + 1) * width + j + 1] +
-                                                        0.5f * bayer[(i + 2) * width + j]) *
-                             0.125f);
+  const int max_value = std::numeric_limits<T>::max();
+  const T *r_2 = bayer + (i - 2) * width;
+  const T *r_1 = bayer + (i - 1) * width;
+  const T *r0 = bayer + i * width;
+  const T *r1 = bayer + (i + 1) * width;
+  const T *r2 = bayer + (i + 2) * width;
+  // One loop per interpolation, so that the compiler can check at runtime that the output does not overlap the rows
+  for (size_t j = j_begin; j < j_end; ++j) {
+    const int diag = static_cast<int>(r_1[j - 1]) + r_1[j + 1] + r1[j - 1] + r1[j + 1];
+    phi[j] = demosaicSaturateMalvar<T>(2 * (5 * r0[j] + 4 * (r_1[j] + r1[j]) - diag - r_2[j] - r2[j]) + r0[j - 2] +
+                                       r0[j + 2], max_value);
+  }
+  for (size_t j = j_begin; j < j_end; ++j) {
+    const int diag = static_cast<int>(r_1[j - 1]) + r_1[j + 1] + r1[j - 1] + r1[j + 1];
+    theta[j] = demosaicSaturateMalvar<T>(2 * (5 * r0[j] + 4 * (r0[j - 1] + r0[j + 1]) - diag - r0[j - 2] - r0[j + 2]) +
+                                         r_2[j] + r2[j], max_value);
+  }
+  for (size_t j = j_begin; j < j_end; ++j) {
+    const int diag = static_cast<int>(r_1[j - 1]) + r_1[j + 1] + r1[j - 1] + r1[j + 1];
+    checker[j] = demosaicSaturateMalvar<T>(12 * r0[j] + 4 * diag - 3 * (r_2[j] + r2[j] + r0[j - 2] + r0[j + 2]),
+                                           max_value);
+  }
+  for (size_t j = j_begin; j < j_end; ++j) {
+    cross[j] = demosaicSaturateMalvar<T>(2 * (4 * r0[j] + 2 * (r_1[j] + r1[j] + r0[j - 1] + r0[j + 1]) - r_2[j] - r2[j] -
+                                              r0[j - 2] - r0[j + 2]), max_value);
+  }
 }
 
-template <typename T> T demosaicCheckerMalvar(const T *bayer, unsigned int width, unsigned int i, unsigned int j)
+/*
+ * Interleave the raw values and the interpolations of row \e i into the RGBa image. \e colors gives the color of the
+ * even and odd columns of the row.
+ */
+template <typename T>
+void demosaicInterleaveRow(const T *bayer, T *rgba, unsigned int width, unsigned int i, unsigned int j_begin,
+                           unsigned int j_end, const int colors[2], const T *phi, const T *theta, const T *checker,
+                           const T *cross)
 {
-  return VISP_NAMESPACE_ADDRESSING vpMath::saturate<T>(
-      (-1.5f * bayer[(i - 2) * width + j] + 2 * bayer[(i - 1) * width + j - 1] + 2 * bayer[(i - 1) * width + j + 1] -
-       1.5f * bayer[i * width + j - 2] + 6 * bayer[i * width + j] - 1.5f * bayer[i * width + j + 2] +
-       2 * bayer[(i + 1) * width + j - 1] + 2 * bayer[(i + 1) * width + j + 1] - 1.5f * bayer[(i + 2) * width + j]) *
-      0.125f);
+  const T *raw = bayer + i * width;
+  // Source of each channel for the even and odd columns
+  const T *src[2][3];
+  for (int p = 0; p < 2; ++p) {
+    for (int ch = 0; ch < 3; ++ch) {
+      if (ch == colors[p]) {
+        src[p][ch] = raw;
+      }
+      else if (colors[p] == BAYER_GREEN) {
+        src[p][ch] = (ch == colors[1 - p]) ? theta : phi;
+      }
+      else {
+        src[p][ch] = (ch == BAYER_GREEN) ? cross : checker;
+      }
+    }
+  }
+  const T *r0 = src[0][0], *g0 = src[0][1], *b0 = src[0][2];
+  const T *r1 = src[1][0], *g1 = src[1][1], *b1 = src[1][2];
+  T *dst = rgba + static_cast<size_t>(i) * width * 4;
+
+  unsigned int j = j_begin;
+  if ((j & 1) && (j < j_end)) {
+    dst[j * 4 + 0] = r1[j];
+    dst[j * 4 + 1] = g1[j];
+    dst[j * 4 + 2] = b1[j];
+    ++j;
+  }
+  for (; j + 1 < j_end; j += 2) {
+    dst[j * 4 + 0] = r0[j];
+    dst[j * 4 + 1] = g0[j];
+    dst[j * 4 + 2] = b0[j];
+    dst[j * 4 + 4] = r1[j + 1];
+    dst[j * 4 + 5] = g1[j + 1];
+    dst[j * 4 + 6] = b1[j + 1];
+  }
+  if (j < j_end) {
+    dst[j * 4 + 0] = r0[j];
+    dst[j * 4 + 1] = g0[j];
+    dst[j * 4 + 2] = b0[j];
+  }
 }
 
-template <typename T> T demosaicCrossMalvar(const T *bayer, unsigned int width, unsigned int i, unsigned int j)
+/*
+ * Demosaic the pixels that are at least \e border pixels away from the image borders. \e colors gives the color of
+ * the even and odd columns of the even and odd rows. The rows are split in stripes processed by the OpenMP threads.
+ */
+template <typename T, bool Malvar>
+void demosaicInteriorTpl(const T *bayer, T *rgba, unsigned int width, unsigned int height, unsigned int nThreads,
+                         const int colors[2][2])
 {
-  return VISP_NAMESPACE_ADDRESSING vpMath::saturate<T>((-bayer[(i - 2) * width + j] + 2 * bayer[(i - 1) * width + j] - bayer[i * width + j - 2] +
-                                                        2 * bayer[i * width + j - 1] + 4 * bayer[i * width + j] + 2 * bayer[i * width + j + 1] -
-                                                        bayer[i * width + j + 2] + 2 * bayer[(i + 1) * width + j] - bayer[(i + 2) * width + j]) *
-                             0.125f);
+  const unsigned int border = Malvar ? 2 : 1;
+  const int i_begin = static_cast<int>(border);
+  const int i_end = static_cast<int>(height - border);
+#if defined(_OPENMP) && (_OPENMP >= 200711) // OpenMP 3.1
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel
+#else
+  (void)nThreads;
+#endif
+  {
+    std::vector<T> buffer(static_cast<size_t>(width) * 4);
+    T *phi = &buffer[0];
+    T *theta = phi + width;
+    T *checker = theta + width;
+    T *cross = checker + width;
+#if defined(_OPENMP) && (_OPENMP >= 200711) // OpenMP 3.1
+#pragma omp for schedule(static)
+#endif
+    for (int i = i_begin; i < i_end; ++i) {
+      const unsigned int row = static_cast<unsigned int>(i);
+      if (Malvar) {
+        demosaicRowMalvar(bayer, width, row, border, width - border, phi, theta, checker, cross);
+      }
+      else {
+        demosaicRowBilinear(bayer, width, row, border, width - border, phi, theta, checker, cross);
+      }
+      demosaicInterleaveRow(bayer, rgba, width, row, border, width - border, colors[row % 2], phi, theta, checker,
+                            cross);
+    }
+  }
 }
 
 template <typename T>
@@ -202,38 +311,9 @@ void demosaicBGGRToRGBaBilinearTpl(const T *bggr, T *rgba, unsigned int width, u
     }
   }
 
-#if defined(_OPENMP) && (_OPENMP >= 200711) // OpenMP 3.1
-  if (nThreads > 0) {
-    omp_set_num_threads(static_cast<int>(nThreads));
-  }
-#pragma omp parallel for schedule(dynamic)
-#else
-  (void)nThreads;
-#endif
-  for (unsigned int i = 1; i < height - 1; ++i) {
-    for (unsigned int j = 1; j < width - 1; ++j) {
-      if (i % 2 == 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicCheckerBilinear(bggr, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossBilinear(bggr, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = bggr[i * width + j];
-      }
-      else if (i % 2 == 0 && j % 2 != 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicPhiBilinear(bggr, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = bggr[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicThetaBilinear(bggr, width, i, j);
-      }
-      else if (i % 2 != 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicThetaBilinear(bggr, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = bggr[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicPhiBilinear(bggr, width, i, j);
-      }
-      else {
-        rgba[(i * width + j) * 4 + 0] = bggr[i * width + j];
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossBilinear(bggr, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = demosaicCheckerBilinear(bggr, width, i, j);
-      }
-    }
-  }
+  // Interior pixels
+  const int colors[2][2] = { { BAYER_BLUE, BAYER_GREEN }, { BAYER_GREEN, BAYER_RED } };
+  demosaicInteriorTpl<T, false>(bggr, rgba, width, height, nThreads, colors);
 }
 
 template <typename T>
@@ -326,38 +406,9 @@ void demosaicGBRGToRGBaBilinearTpl(const T *gbrg, T *rgba, unsigned int width, u
     }
   }
 
-#if defined(_OPENMP) && (_OPENMP >= 200711) // OpenMP 3.1
-  if (nThreads > 0) {
-    omp_set_num_threads(static_cast<int>(nThreads));
-  }
-#pragma omp parallel for schedule(dynamic)
-#else
-  (void)nThreads;
-#endif
-  for (unsigned int i = 1; i < height - 1; ++i) {
-    for (unsigned int j = 1; j < width - 1; ++j) {
-      if (i % 2 == 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicPhiBilinear(gbrg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = gbrg[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicThetaBilinear(gbrg, width, i, j);
-      }
-      else if (i % 2 == 0 && j % 2 != 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicCheckerBilinear(gbrg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossBilinear(gbrg, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = gbrg[i * width + j];
-      }
-      else if (i % 2 != 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = gbrg[i * width + j];
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossBilinear(gbrg, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = demosaicCheckerBilinear(gbrg, width, i, j);
-      }
-      else {
-        rgba[(i * width + j) * 4 + 0] = demosaicThetaBilinear(gbrg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = gbrg[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicPhiBilinear(gbrg, width, i, j);
-      }
-    }
-  }
+  // Interior pixels
+  const int colors[2][2] = { { BAYER_GREEN, BAYER_BLUE }, { BAYER_RED, BAYER_GREEN } };
+  demosaicInteriorTpl<T, false>(gbrg, rgba, width, height, nThreads, colors);
 }
 
 template <typename T>
@@ -450,38 +501,9 @@ void demosaicGRBGToRGBaBilinearTpl(const T *grbg, T *rgba, unsigned int width, u
     }
   }
 
-#if defined(_OPENMP) && (_OPENMP >= 200711) // OpenMP 3.1
-  if (nThreads > 0) {
-    omp_set_num_threads(static_cast<int>(nThreads));
-  }
-#pragma omp parallel for schedule(dynamic)
-#else
-  (void)nThreads;
-#endif
-  for (unsigned int i = 1; i < height - 1; ++i) {
-    for (unsigned int j = 1; j < width - 1; ++j) {
-      if (i % 2 == 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicThetaBilinear(grbg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = grbg[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicPhiBilinear(grbg, width, i, j);
-      }
-      else if (i % 2 == 0 && j % 2 != 0) {
-        rgba[(i * width + j) * 4 + 0] = grbg[i * width + j];
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossBilinear(grbg, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = demosaicCheckerBilinear(grbg, width, i, j);
-      }
-      else if (i % 2 != 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicCheckerBilinear(grbg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossBilinear(grbg, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = grbg[i * width + j];
-      }
-      else {
-        rgba[(i * width + j) * 4 + 0] = demosaicPhiBilinear(grbg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = grbg[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicThetaBilinear(grbg, width, i, j);
-      }
-    }
-  }
+  // Interior pixels
+  const int colors[2][2] = { { BAYER_GREEN, BAYER_RED }, { BAYER_BLUE, BAYER_GREEN } };
+  demosaicInteriorTpl<T, false>(grbg, rgba, width, height, nThreads, colors);
 }
 
 template <typename T>
@@ -574,38 +596,9 @@ void demosaicRGGBToRGBaBilinearTpl(const T *rggb, T *rgba, unsigned int width, u
     }
   }
 
-#if defined(_OPENMP) && (_OPENMP >= 200711) // OpenMP 3.1
-  if (nThreads > 0) {
-    omp_set_num_threads(static_cast<int>(nThreads));
-  }
-#pragma omp parallel for schedule(dynamic)
-#else
-  (void)nThreads;
-#endif
-  for (unsigned int i = 1; i < height - 1; ++i) {
-    for (unsigned int j = 1; j < width - 1; ++j) {
-      if (i % 2 == 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = rggb[i * width + j];
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossBilinear(rggb, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = demosaicCheckerBilinear(rggb, width, i, j);
-      }
-      else if (i % 2 == 0 && j % 2 != 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicThetaBilinear(rggb, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = rggb[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicPhiBilinear(rggb, width, i, j);
-      }
-      else if (i % 2 != 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicPhiBilinear(rggb, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = rggb[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicThetaBilinear(rggb, width, i, j);
-      }
-      else {
-        rgba[(i * width + j) * 4 + 0] = demosaicCheckerBilinear(rggb, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossBilinear(rggb, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = rggb[i * width + j];
-      }
-    }
-  }
+  // Interior pixels
+  const int colors[2][2] = { { BAYER_RED, BAYER_GREEN }, { BAYER_GREEN, BAYER_BLUE } };
+  demosaicInteriorTpl<T, false>(rggb, rgba, width, height, nThreads, colors);
 }
 
 // Malvar
@@ -771,38 +764,9 @@ void demosaicBGGRToRGBaMalvarTpl(const T *bggr, T *rgba, unsigned int width, uns
     }
   }
 
-#if defined(_OPENMP) && (_OPENMP >= 200711) // OpenMP 3.1
-  if (nThreads > 0) {
-    omp_set_num_threads(static_cast<int>(nThreads));
-  }
-#pragma omp parallel for schedule(dynamic)
-#else
-  (void)nThreads;
-#endif
-  for (unsigned int i = 2; i < height - 2; ++i) {
-    for (unsigned int j = 2; j < width - 2; ++j) {
-      if (i % 2 == 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicCheckerMalvar(bggr, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossMalvar(bggr, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = bggr[i * width + j];
-      }
-      else if (i % 2 == 0 && j % 2 != 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicPhiMalvar(bggr, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = bggr[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicThetaMalvar(bggr, width, i, j);
-      }
-      else if (i % 2 != 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicThetaMalvar(bggr, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = bggr[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicPhiMalvar(bggr, width, i, j);
-      }
-      else {
-        rgba[(i * width + j) * 4 + 0] = bggr[i * width + j];
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossMalvar(bggr, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = demosaicCheckerMalvar(bggr, width, i, j);
-      }
-    }
-  }
+  // Interior pixels
+  const int colors[2][2] = { { BAYER_BLUE, BAYER_GREEN }, { BAYER_GREEN, BAYER_RED } };
+  demosaicInteriorTpl<T, true>(bggr, rgba, width, height, nThreads, colors);
 }
 
 template <typename T>
@@ -967,38 +931,9 @@ void demosaicGBRGToRGBaMalvarTpl(const T *gbrg, T *rgba, unsigned int width, uns
     }
   }
 
-#if defined(_OPENMP) && (_OPENMP >= 200711) // OpenMP 3.1
-  if (nThreads > 0) {
-    omp_set_num_threads(static_cast<int>(nThreads));
-  }
-#pragma omp parallel for schedule(dynamic)
-#else
-  (void)nThreads;
-#endif
-  for (unsigned int i = 2; i < height - 2; ++i) {
-    for (unsigned int j = 2; j < width - 2; ++j) {
-      if (i % 2 == 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicPhiMalvar(gbrg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = gbrg[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicThetaMalvar(gbrg, width, i, j);
-      }
-      else if (i % 2 == 0 && j % 2 != 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicCheckerMalvar(gbrg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossMalvar(gbrg, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = gbrg[i * width + j];
-      }
-      else if (i % 2 != 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = gbrg[i * width + j];
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossMalvar(gbrg, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = demosaicCheckerMalvar(gbrg, width, i, j);
-      }
-      else {
-        rgba[(i * width + j) * 4 + 0] = demosaicThetaMalvar(gbrg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = gbrg[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicPhiMalvar(gbrg, width, i, j);
-      }
-    }
-  }
+  // Interior pixels
+  const int colors[2][2] = { { BAYER_GREEN, BAYER_BLUE }, { BAYER_RED, BAYER_GREEN } };
+  demosaicInteriorTpl<T, true>(gbrg, rgba, width, height, nThreads, colors);
 }
 
 template <typename T>
@@ -1163,38 +1098,9 @@ void demosaicGRBGToRGBaMalvarTpl(const T *grbg, T *rgba, unsigned int width, uns
     }
   }
 
-#if defined(_OPENMP) && (_OPENMP >= 200711) // OpenMP 3.1
-  if (nThreads > 0) {
-    omp_set_num_threads(static_cast<int>(nThreads));
-  }
-#pragma omp parallel for schedule(dynamic)
-#else
-  (void)nThreads;
-#endif
-  for (unsigned int i = 2; i < height - 2; ++i) {
-    for (unsigned int j = 2; j < width - 2; ++j) {
-      if (i % 2 == 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicThetaMalvar(grbg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = grbg[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicPhiMalvar(grbg, width, i, j);
-      }
-      else if (i % 2 == 0 && j % 2 != 0) {
-        rgba[(i * width + j) * 4 + 0] = grbg[i * width + j];
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossMalvar(grbg, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = demosaicCheckerMalvar(grbg, width, i, j);
-      }
-      else if (i % 2 != 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicCheckerMalvar(grbg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossMalvar(grbg, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = grbg[i * width + j];
-      }
-      else {
-        rgba[(i * width + j) * 4 + 0] = demosaicPhiMalvar(grbg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = grbg[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicThetaMalvar(grbg, width, i, j);
-      }
-    }
-  }
+  // Interior pixels
+  const int colors[2][2] = { { BAYER_GREEN, BAYER_RED }, { BAYER_BLUE, BAYER_GREEN } };
+  demosaicInteriorTpl<T, true>(grbg, rgba, width, height, nThreads, colors);
 }
 
 template <typename T>
@@ -1359,38 +1265,9 @@ void demosaicRGGBToRGBaMalvarTpl(const T *rggb, T *rgba, unsigned int width, uns
     }
   }
 
-#if defined(_OPENMP) && (_OPENMP >= 200711) // OpenMP 3.1
-  if (nThreads > 0) {
-    omp_set_num_threads(static_cast<int>(nThreads));
-  }
-#pragma omp parallel for schedule(dynamic)
-#else
-  (void)nThreads;
-#endif
-  for (unsigned int i = 2; i < height - 2; ++i) {
-    for (unsigned int j = 2; j < width - 2; ++j) {
-      if (i % 2 == 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = rggb[i * width + j];
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossMalvar(rggb, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = demosaicCheckerMalvar(rggb, width, i, j);
-      }
-      else if (i % 2 == 0 && j % 2 != 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicThetaMalvar(rggb, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = rggb[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicPhiMalvar(rggb, width, i, j);
-      }
-      else if (i % 2 != 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicPhiMalvar(rggb, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = rggb[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicThetaMalvar(rggb, width, i, j);
-      }
-      else {
-        rgba[(i * width + j) * 4 + 0] = demosaicCheckerMalvar(rggb, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossMalvar(rggb, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = rggb[i * width + j];
-      }
-    }
-  }
+  // Interior pixels
+  const int colors[2][2] = { { BAYER_RED, BAYER_GREEN }, { BAYER_GREEN, BAYER_BLUE } };
+  demosaicInteriorTpl<T, true>(rggb, rgba, width, height, nThreads, colors);
 }
 
 #endif
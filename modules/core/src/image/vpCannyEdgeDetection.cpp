@@ -36,10 +36,6 @@
 #include <omp.h>
 #endif
 
-#ifdef VISP_USE_MSVC
-#pragma comment(linker, "/STACK:65532000") // Increase max recursion depth
-#endif
-
 #if (VISP_CXX_STANDARD == VISP_CXX_STANDARD_98) // Check if cxx98
 namespace
 {
@@ -120,9 +116,13 @@ vpCannyEdgeDetection::reinit()
   m_areGradientAvailable = false;
 
   // // Clearing the previous results
-  m_edgeCandidateAndGradient.clear();
-  m_activeEdgeCandidates.clear();
+  m_edgeCandidates.clear();
   m_edgePointsList.clear();
+  m_filteringAndGradientTime = 0.;
+  m_thresholdsComputationTime = 0.;
+  m_edgeThinningTime = 0.;
+  m_hysteresisThresholdingTime = 0.;
+  m_edgeTrackingTime = 0.;
   if (m_edgeMap.getSize() != 0) {
     m_edgeMap.resize(m_edgeMap.getRows(), m_edgeMap.getCols(), 0);
     m_edgePointsCandidates.resize(m_edgeMap.getRows(), m_edgeMap.getCols(), NOT_EDGE);
@@ -246,12 +246,15 @@ vpImage<unsigned char>
 vpCannyEdgeDetection::detect(const vpImage<unsigned char> &I)
 {
   // // Step 1 and 2: filter the image and compute the gradient, if not given by the user
+  double t = vpTime::measureTimeMs();
   if (!m_areGradientAvailable) {
     computeFilteringAndGradient(I);
   }
   m_areGradientAvailable = false; // Reset for next call
+  m_filteringAndGradientTime = vpTime::measureTimeMs() - t;
 
   // // Step 3: edge thining
+  t = vpTime::measureTimeMs();
   float upperThreshold = m_upperThreshold;
   float lowerThreshold = m_lowerThreshold;
   if (upperThreshold < 0) {
@@ -268,6 +271,7 @@ vpCannyEdgeDetection::detect(const vpImage<unsigned char> &I)
   }
   // To ensure that if lowerThreshold = 0, we reject null gradient points
   lowerThreshold = std::max<float>(lowerThreshold, std::numeric_limits<float>::epsilon());
+  m_thresholdsComputationTime = vpTime::measureTimeMs() - t;
 
   step3to5(I.getHeight(), I.getWidth(), lowerThreshold, upperThreshold);
 
@@ -277,60 +281,36 @@ vpCannyEdgeDetection::detect(const vpImage<unsigned char> &I)
 void
 vpCannyEdgeDetection::step3to5(const unsigned int &height, const unsigned int &width, const float &lowerThreshold, const float &upperThreshold)
 {
-#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
-  rlim_t initialStackSize = 0;
-  struct rlimit rl;
-  int result;
-  if (m_minStackSize > 0) {
-    // Check the current stack size
-    result = getrlimit(RLIMIT_STACK, &rl);
-    if (result == 0) {
-      initialStackSize = rl.rlim_cur;
-      if (rl.rlim_cur < m_minStackSize) {
-        // Increase stack size due to the recursive algorithm
-        rl.rlim_cur = m_minStackSize;
-        result = setrlimit(RLIMIT_STACK, &rl);
-        if (result != 0) {
-          throw(vpException(vpException::fatalError, "setrlimit returned result = %d\n", result));
-        }
-      }
-    }
-    else {
-      throw(vpException(vpException::fatalError, "getrlimit returned result = %d\n", result));
-    }
-  }
-#endif
   // // Clearing the previous results
   m_edgeMap.resize(height, width, 0);
-  m_edgeCandidateAndGradient.clear();
-  m_activeEdgeCandidates.clear();
-  m_edgePointsCandidates.resize(m_dIx.getRows(), m_dIx.getCols(), NOT_EDGE);
+  m_edgePointsCandidates.resize(m_dIx.getRows(), m_dIx.getCols(), static_cast<unsigned char>(NOT_EDGE));
   m_edgePointsList.clear();
-  if (m_storeListEdgePoints) {
-    m_edgePointsList.reserve(m_dIx.getSize() / 8);
+
+  // // Splitting the image in horizontal stripes, one per thread. The candidates buffers of the stripes
+  // // are kept from one call to the next to avoid reallocating them.
+  const unsigned int nbRows = m_dIx.getRows();
+  unsigned int nbStripes = static_cast<unsigned int>(std::max<int>(m_nbThread, 1));
+  nbStripes = std::max<unsigned int>(std::min<unsigned int>(nbStripes, nbRows), 1);
+  m_edgeCandidates.resize(nbStripes);
+  const unsigned int stripeHeight = nbRows / nbStripes, nbLongerStripes = nbRows % nbStripes;
+  for (unsigned int s = 0; s < nbStripes; ++s) {
+    m_edgeCandidates[s].m_rowStart = (s * stripeHeight) + std::min<unsigned int>(s, nbLongerStripes);
+    m_edgeCandidates[s].m_rowEnd = m_edgeCandidates[s].m_rowStart + stripeHeight + ((s < nbLongerStripes) ? 1 : 0);
   }
 
+  double t = vpTime::measureTimeMs();
   performEdgeThinning(lowerThreshold);
+  m_edgeThinningTime = vpTime::measureTimeMs() - t;
 
   // // Step 4: hysteresis thresholding
+  t = vpTime::measureTimeMs();
   performHysteresisThresholding(lowerThreshold, upperThreshold);
+  m_hysteresisThresholdingTime = vpTime::measureTimeMs() - t;
 
   // // Step 5: edge tracking
+  t = vpTime::measureTimeMs();
   performEdgeTracking();
-
-#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
-  if (m_minStackSize > 0) {
-    if (rl.rlim_cur > initialStackSize) {
-      // Reset stack size to its original value
-      rl.rlim_cur = initialStackSize;
-      result = setrlimit(RLIMIT_STACK, &rl);
-      if (result != 0) {
-        throw(vpException(vpException::fatalError, "setrlimit returned result = %d\n", result));
-
-      }
-    }
-  }
-#endif
+  m_edgeTrackingTime = vpTime::measureTimeMs() - t;
 }
 
 void
@@ -465,25 +445,17 @@ void
 vpCannyEdgeDetection::performEdgeThinning(const float &lowerThreshold)
 {
   const int nbCols = static_cast<int>(m_dIx.getCols());
-  const int size = static_cast<int>(m_dIx.getSize());
+  const int nbStripes = static_cast<int>(m_edgeCandidates.size());
 
-  int istart = 0, istop = size;
 #ifdef VISP_HAVE_OPENMP
-  int iam, nt, ipoints, npoints(size);
-#pragma omp parallel default(shared) private(iam, nt, ipoints, istart, istop) num_threads(m_nbThread)
-  {
-    iam = omp_get_thread_num();
-    nt = omp_get_num_threads();
-    ipoints = npoints / nt;
-    // size of partition
-    istart = iam * ipoints; // starting array index
-    if (iam == nt-1) {
-      // last thread may do more
-      ipoints = npoints - istart;
-    }
-    istop = istart + ipoints;
-    std::vector<std::pair<unsigned int, float> > localMemoryEdgeCandidates;
+#pragma omp parallel for num_threads(nbStripes) schedule(static, 1)
 #endif
+  for (int s = 0; s < nbStripes; ++s) {
+    vpEdgeCandidatesStripe &stripe = m_edgeCandidates[static_cast<std::size_t>(s)];
+    stripe.m_indices.clear();
+    stripe.m_gradients.clear();
+    const int istart = static_cast<int>(stripe.m_rowStart) * nbCols;
+    const int istop = static_cast<int>(stripe.m_rowEnd) * nbCols;
     bool ignore_current_pixel = false;
     bool grad_lower_threshold = false;
     for (int iter = istart; iter < istop; ++iter) {
@@ -529,192 +501,133 @@ vpCannyEdgeDetection::performEdgeThinning(const float &lowerThreshold)
 
           if ((grad >= gradPlus) && (grad >= gradMinus)) {
             // Keeping the edge point that has the highest gradient
-#ifdef VISP_HAVE_OPENMP
-            localMemoryEdgeCandidates.push_back(std::pair<unsigned int, float>(iter, grad));
-#else
-            m_edgeCandidateAndGradient.push_back(std::pair<unsigned int, float>(iter, grad));
-#endif
+            stripe.m_indices.push_back(static_cast<unsigned int>(iter));
+            stripe.m_gradients.push_back(grad);
           }
         }
       }
     }
-#ifdef VISP_HAVE_OPENMP
-#pragma omp critical
-    {
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-      m_edgeCandidateAndGradient.insert(
-        m_edgeCandidateAndGradient.end(),
-        std::make_move_iterator(localMemoryEdgeCandidates.begin()),
-        std::make_move_iterator(localMemoryEdgeCandidates.end())
-      );
-#else
-      m_edgeCandidateAndGradient.insert(
-        m_edgeCandidateAndGradient.end(),
-        localMemoryEdgeCandidates.begin(),
-        localMemoryEdgeCandidates.end()
-      );
-#endif
-    }
-#endif
-#ifdef VISP_HAVE_OPENMP
   }
-#endif
 }
 
 void
 vpCannyEdgeDetection::performHysteresisThresholding(const float &lowerThreshold, const float &upperThreshold)
 {
-  const int size = static_cast<int>(m_edgeCandidateAndGradient.size());
-  int istart = 0;
-  int istop = size;
+  const int nbStripes = static_cast<int>(m_edgeCandidates.size());
 
 #ifdef VISP_HAVE_OPENMP
-  int iam, nt, ipoints, npoints(size);
-#pragma omp parallel default(shared) private(iam, nt, ipoints, istart, istop) num_threads(m_nbThread)
-  {
-    iam = omp_get_thread_num();
-    nt = omp_get_num_threads();
-    ipoints = npoints / nt;
-    // size of partition
-    istart = iam * ipoints; // starting array index
-    if (iam == nt-1) {
-      // last thread may do more
-      ipoints = npoints - istart;
-    }
-    istop = istart + ipoints;
-    std::vector<unsigned int> localMemoryEdgeCandidates;
-#endif
-    for (int id = istart; id < istop; ++id) {
-      const std::pair<unsigned int, float> &candidate = m_edgeCandidateAndGradient[static_cast<std::size_t>(id)];
-      if (candidate.second >= upperThreshold) {
-#ifdef VISP_HAVE_OPENMP
-        localMemoryEdgeCandidates.push_back(candidate.first);
-#else
-        m_activeEdgeCandidates.push_back(candidate.first);
+#pragma omp parallel for num_threads(nbStripes) schedule(static, 1)
 #endif
-        m_edgePointsCandidates.bitmap[candidate.first] = STRONG_EDGE;
+  for (int s = 0; s < nbStripes; ++s) {
+    const vpEdgeCandidatesStripe &stripe = m_edgeCandidates[static_cast<std::size_t>(s)];
+    const std::size_t nbCandidates = stripe.m_indices.size();
+    for (std::size_t id = 0; id < nbCandidates; ++id) {
+      const float grad = stripe.m_gradients[id];
+      if (grad >= upperThreshold) {
+        m_edgePointsCandidates.bitmap[stripe.m_indices[id]] = static_cast<unsigned char>(STRONG_EDGE);
       }
-      else if ((candidate.second >= lowerThreshold) && (candidate.second < upperThreshold)) {
-#ifdef VISP_HAVE_OPENMP
-        localMemoryEdgeCandidates.push_back(candidate.first);
-#else
-        m_activeEdgeCandidates.push_back(candidate.first);
-#endif
-        m_edgePointsCandidates.bitmap[candidate.first] = WEAK_EDGE;
+      else if (grad >= lowerThreshold) {
+        m_edgePointsCandidates.bitmap[stripe.m_indices[id]] = static_cast<unsigned char>(WEAK_EDGE);
       }
     }
+  }
+}
 
-#ifdef VISP_HAVE_OPENMP
-#pragma omp critical
-    {
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-      m_activeEdgeCandidates.insert(
-        m_activeEdgeCandidates.end(),
-        std::make_move_iterator(localMemoryEdgeCandidates.begin()),
-        std::make_move_iterator(localMemoryEdgeCandidates.end())
-      );
-#else
-      m_activeEdgeCandidates.insert(
-        m_activeEdgeCandidates.end(),
-        localMemoryEdgeCandidates.begin(),
-        localMemoryEdgeCandidates.end()
-      );
-#endif
+void
+vpCannyEdgeDetection::propagateStrongEdges(std::vector<unsigned int> &stack, const unsigned int &rowStart,
+                                           const unsigned int &rowEnd)
+{
+  const unsigned int nbCols = m_edgePointsCandidates.getCols();
+  const unsigned char weak = static_cast<unsigned char>(WEAK_EDGE);
+  const unsigned char strong = static_cast<unsigned char>(STRONG_EDGE);
+  unsigned char *labels = m_edgePointsCandidates.bitmap;
+
+  while (!stack.empty()) {
+    const unsigned int coordinates = stack.back();
+    stack.pop_back();
+    const unsigned int row = coordinates / nbCols;
+    const unsigned int col = coordinates % nbCols;
+    const unsigned int rmin = (row > rowStart) ? (row - 1) : rowStart;
+    const unsigned int rmax = ((row + 1) < rowEnd) ? (row + 1) : (rowEnd - 1);
+    const unsigned int cmin = (col > 0) ? (col - 1) : 0;
+    const unsigned int cmax = ((col + 1) < nbCols) ? (col + 1) : (nbCols - 1);
+    for (unsigned int r = rmin; r <= rmax; ++r) {
+      for (unsigned int c = cmin; c <= cmax; ++c) {
+        const unsigned int neighbor = (r * nbCols) + c;
+        if (labels[neighbor] == weak) {
+          // The weak edge is 8-connected to a strong edge => it becomes a strong edge
+          labels[neighbor] = strong;
+          stack.push_back(neighbor);
+        }
+      }
     }
   }
-#endif
 }
 
 void
 vpCannyEdgeDetection::performEdgeTracking()
 {
   const unsigned char var_uc_255 = 255;
+  const unsigned char strong = static_cast<unsigned char>(STRONG_EDGE);
   const unsigned int nbCols = m_edgeMap.getCols();
+  const int nbStripes = static_cast<int>(m_edgeCandidates.size());
 
-  std::vector<unsigned int>::iterator it;
-  std::vector<unsigned int>::iterator m_edgePointsCandidates_end = m_activeEdgeCandidates.end();
-  for (it = m_activeEdgeCandidates.begin(); it != m_edgePointsCandidates_end; ++it) {
-    if (m_edgePointsCandidates.bitmap[*it] == STRONG_EDGE) {
-      if (m_storeListEdgePoints) {
-        if (m_edgeMap.bitmap[*it] != var_uc_255) {
-          // Edge point not added yet to the edge list
-          unsigned int row = *it / nbCols;
-          unsigned int col = *it % nbCols;
-          m_edgePointsList.push_back(vpImagePoint(row, col));
-        }
+  // // Propagating the strong edges within each stripe
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for num_threads(nbStripes) schedule(static, 1)
+#endif
+  for (int s = 0; s < nbStripes; ++s) {
+    vpEdgeCandidatesStripe &stripe = m_edgeCandidates[static_cast<std::size_t>(s)];
+    const std::size_t nbCandidates = stripe.m_indices.size();
+    stripe.m_stack.clear();
+    for (std::size_t id = 0; id < nbCandidates; ++id) {
+      if (m_edgePointsCandidates.bitmap[stripe.m_indices[id]] == strong) {
+        stripe.m_stack.push_back(stripe.m_indices[id]);
       }
-      m_edgeMap.bitmap[*it] = var_uc_255;
-    }
-    else if (m_edgePointsCandidates.bitmap[*it] == WEAK_EDGE) {
-      recursiveSearchForStrongEdge(*it);
     }
+    propagateStrongEdges(stripe.m_stack, stripe.m_rowStart, stripe.m_rowEnd);
   }
-}
 
-bool
-vpCannyEdgeDetection::recursiveSearchForStrongEdge(const unsigned int &coordinates)
-{
-  const int nbCols = static_cast<int>(m_dIx.getCols());
-  const int size = static_cast<int>(m_dIx.getSize());
-  const int coordAsInt = static_cast<int>(coordinates);
-  bool hasFoundStrongEdge = false;
-  m_edgePointsCandidates.bitmap[coordinates] = ON_CHECK;
-  bool test_row = false;
-  bool test_col = false;
-  bool test_drdc = false;
-  bool edge_in_image_limit = false;
-  int dr = -1;
-  while ((dr <= 1) && (!hasFoundStrongEdge)) {
-    int dc = -1;
-    while ((dc <= 1) && (!hasFoundStrongEdge)) {
-      // reset the check for the edge on image limit
-      edge_in_image_limit = false;
-
-      int iterTest = coordAsInt + dr * nbCols + dc;
-
-      // Checking if we are still looking for an edge in the limit of the image
-      test_row = (iterTest < 0) || (iterTest >= size);
-      test_col = ((iterTest - dc) / nbCols) != (iterTest / nbCols);
-      test_drdc = (dr == 0) && (dc == 0);
-      if (test_row || test_col || test_drdc) {
-        edge_in_image_limit = true;
-        // the continue is replaced by the test
-      }
-      if (edge_in_image_limit == false) {
-
-        try {
-          // Checking if the 8-neighbor point is in the list of edge candidates
-          EdgeType type_candidate = m_edgePointsCandidates.bitmap[iterTest];
-          if (type_candidate == STRONG_EDGE) {
-            // The 8-neighbor point is a strong edge => the weak edge becomes a strong edge
-            hasFoundStrongEdge = true;
-          }
-          else if (type_candidate == WEAK_EDGE) {
-            // Checking if the WEAK_EDGE neighbor has a STRONG_EDGE neighbor
-            hasFoundStrongEdge = recursiveSearchForStrongEdge(static_cast<unsigned int>(iterTest));
-          }
-        }
-        catch (...) {
-          // continue - nothing to do
+  // // Propagating the strong edges across the stripe borders. The weak edges that remain are connected to a strong
+  // // edge only through a path that crosses a border, next to which there is now a strong edge.
+  if (nbStripes > 1) {
+    std::vector<unsigned int> &stack = m_edgeCandidates[0].m_stack;
+    for (int s = 1; s < nbStripes; ++s) {
+      const unsigned int border = m_edgeCandidates[static_cast<std::size_t>(s)].m_rowStart;
+      for (unsigned int iter = (border - 1) * nbCols; iter < ((border + 1) * nbCols); ++iter) {
+        if (m_edgePointsCandidates.bitmap[iter] == strong) {
+          stack.push_back(iter);
         }
       }
-      ++dc;
     }
-    ++dr;
+    propagateStrongEdges(stack, 0, m_edgePointsCandidates.getRows());
   }
-  const unsigned char var_uc_255 = 255;
-  if (hasFoundStrongEdge) {
-    if (m_storeListEdgePoints) {
-      if (m_edgeMap.bitmap[coordinates] != var_uc_255) {
-        // Edge point not added yet to the edge list
-        unsigned int row = static_cast<unsigned int>(coordinates) / static_cast<unsigned int>(nbCols);
-        unsigned int col = static_cast<unsigned int>(coordinates) % static_cast<unsigned int>(nbCols);
-        m_edgePointsList.push_back(vpImagePoint(row, col));
+
+  // // Building the edge map and the edge-points list, in raster order
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for num_threads(nbStripes) schedule(static, 1)
+#endif
+  for (int s = 0; s < nbStripes; ++s) {
+    const vpEdgeCandidatesStripe &stripe = m_edgeCandidates[static_cast<std::size_t>(s)];
+    const std::size_t nbCandidates = stripe.m_indices.size();
+    for (std::size_t id = 0; id < nbCandidates; ++id) {
+      if (m_edgePointsCandidates.bitmap[stripe.m_indices[id]] == strong) {
+        m_edgeMap.bitmap[stripe.m_indices[id]] = var_uc_255;
+      }
+    }
+  }
+
+  if (m_storeListEdgePoints) {
+    for (int s = 0; s < nbStripes; ++s) {
+      const vpEdgeCandidatesStripe &stripe = m_edgeCandidates[static_cast<std::size_t>(s)];
+      const std::size_t nbCandidates = stripe.m_indices.size();
+      for (std::size_t id = 0; id < nbCandidates; ++id) {
+        const unsigned int coordinates = stripe.m_indices[id];
+        if (m_edgeMap.bitmap[coordinates] == var_uc_255) {
+          m_edgePointsList.push_back(vpImagePoint(coordinates / nbCols, coordinates % nbCols));
+        }
       }
     }
-    m_edgePointsCandidates.bitmap[coordinates] = STRONG_EDGE;
-    m_edgeMap.bitmap[coordinates] = var_uc_255;
   }
-  return hasFoundStrongEdge;
 }
 END_VISP_NAMESPACE
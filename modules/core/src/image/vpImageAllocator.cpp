@@ -0,0 +1,338 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Memory allocator of the image bitmaps.
+ */
+
+/*!
+ * \file vpImageAllocator.cpp
+ * \brief Memory allocator of the image bitmaps, and default pool that recycles the released bitmaps.
+ */
+
+#include <stdlib.h>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImageAllocator.h>
+
+BEGIN_VISP_NAMESPACE
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+/*!
+ * Header stored in front of each block returned by vpImageAllocator::allocateBlock(). Its size is the alignment so
+ * that the data that follows it keeps the alignment of the block.
+ */
+struct vpBlockHeader
+{
+  vpImageAllocator *allocator;
+  size_t size;
+};
+
+vpImageAllocator *g_defaultAllocator = nullptr;
+
+void *alignedMalloc(size_t size)
+{
+#if defined(_WIN32)
+  return _aligned_malloc(size, vpImageAllocator::alignment);
+#else
+  void *ptr = nullptr;
+  if (posix_memalign(&ptr, vpImageAllocator::alignment, size) != 0) {
+    return nullptr;
+  }
+  return ptr;
+#endif
+}
+
+void alignedFree(void *ptr)
+{
+#if defined(_WIN32)
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+ * Allocate a block of \e size bytes aligned on vpImageAllocator::alignment bytes with the default allocator.
+ * The block has to be released with deallocateBlock().
+ *
+ * \exception vpException::memoryAllocationError When the block cannot be allocated.
+ */
+void *vpImageAllocator::allocateBlock(size_t size)
+{
+  vpImageAllocator &allocator = getDefault();
+  const size_t total = size + alignment;
+  if (total < size) {
+    throw(vpException(vpException::memoryAllocationError, "Cannot allocate an image block of %lu bytes",
+                      static_cast<unsigned long>(size)));
+  }
+  unsigned char *base = static_cast<unsigned char *>(allocator.allocate(total));
+  vpBlockHeader *header = reinterpret_cast<vpBlockHeader *>(base);
+  header->allocator = &allocator;
+  header->size = total;
+  return base + alignment;
+}
+
+/*!
+ * Release a block returned by allocateBlock() to the allocator that allocated it. Does nothing if \e ptr is null.
+ */
+void vpImageAllocator::deallocateBlock(void *ptr)
+{
+  if (ptr == nullptr) {
+    return;
+  }
+  unsigned char *base = static_cast<unsigned char *>(ptr) - alignment;
+  vpBlockHeader *header = reinterpret_cast<vpBlockHeader *>(base);
+  header->allocator->deallocate(base, header->size);
+}
+
+/*!
+ * Return the allocator used by the images, by default vpImagePool::getInstance().
+ */
+vpImageAllocator &vpImageAllocator::getDefault()
+{
+  if (g_defaultAllocator != nullptr) {
+    return *g_defaultAllocator;
+  }
+  return vpImagePool::getInstance();
+}
+
+/*!
+ * Set the allocator used by the images allocated from now on. Set \e allocator to nullptr to come back to the
+ * default vpImagePool. The allocator is not copied and has to outlive all the images it allocates.
+ *
+ * \warning This function is not thread-safe: call it when no other thread allocates images, typically at the
+ * beginning of the program.
+ */
+void vpImageAllocator::setDefault(vpImageAllocator *allocator) { g_defaultAllocator = allocator; }
+
+vpImagePool::vpImagePool()
+  : m_freeBlocks(), m_cachedBytes(0), m_maxCachedBytes(128 * 1024 * 1024), m_hits(0), m_misses(0)
+#if defined(VISP_HAVE_THREADS)
+  , m_mutex()
+#endif
+{ }
+
+vpImagePool::~vpImagePool() { clear(); }
+
+/*!
+ * Return a block of at least \e size bytes, taken from the released blocks of the same size class if any, otherwise
+ * allocated from the system.
+ *
+ * \exception vpException::memoryAllocationError When the block cannot be allocated.
+ */
+void *vpImagePool::allocate(size_t size)
+{
+  const size_t size_class = getSizeClass(size);
+  {
+#if defined(VISP_HAVE_THREADS)
+    std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+    std::map<size_t, std::vector<void *> >::iterator it = m_freeBlocks.find(size_class);
+    if ((it != m_freeBlocks.end()) && (!it->second.empty())) {
+      void *ptr = it->second.back();
+      it->second.pop_back();
+      m_cachedBytes -= size_class;
+      ++m_hits;
+      return ptr;
+    }
+    ++m_misses;
+  }
+
+  void *ptr = alignedMalloc(size_class);
+  if (ptr == nullptr) {
+    // Give the cached blocks back to the system and retry
+    clear();
+    ptr = alignedMalloc(size_class);
+  }
+  if (ptr == nullptr) {
+    throw(vpException(vpException::memoryAllocationError, "Cannot allocate an image block of %lu bytes",
+                      static_cast<unsigned long>(size_class)));
+  }
+  return ptr;
+}
+
+/*!
+ * Keep the block for a next allocate() of the same size class, or give it back to the system when the pool already
+ * holds getMaxCachedBytes() bytes.
+ */
+void vpImagePool::deallocate(void *ptr, size_t size)
+{
+  if (ptr == nullptr) {
+    return;
+  }
+  const size_t size_class = getSizeClass(size);
+  {
+#if defined(VISP_HAVE_THREADS)
+    std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+    if ((m_cachedBytes + size_class) <= m_maxCachedBytes) {
+      m_freeBlocks[size_class].push_back(ptr);
+      m_cachedBytes += size_class;
+      return;
+    }
+  }
+  alignedFree(ptr);
+}
+
+/*!
+ * Give all the cached blocks back to the system.
+ */
+void vpImagePool::clear() { trim(0); }
+
+/*!
+ * Return the number of bytes of the released blocks kept by the pool.
+ */
+size_t vpImagePool::getCachedBytes() const
+{
+#if defined(VISP_HAVE_THREADS)
+  std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+  return m_cachedBytes;
+}
+
+/*!
+ * Return the number of allocations that reused a released block since the last resetStatistics().
+ */
+unsigned long vpImagePool::getHits() const
+{
+#if defined(VISP_HAVE_THREADS)
+  std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+  return m_hits;
+}
+
+/*!
+ * Return the maximum number of bytes of the released blocks kept by the pool. The default value is 128 MB.
+ */
+size_t vpImagePool::getMaxCachedBytes() const
+{
+#if defined(VISP_HAVE_THREADS)
+  std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+  return m_maxCachedBytes;
+}
+
+/*!
+ * Return the number of allocations that needed a new block from the system since the last resetStatistics().
+ */
+unsigned long vpImagePool::getMisses() const
+{
+#if defined(VISP_HAVE_THREADS)
+  std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+  return m_misses;
+}
+
+/*!
+ * Return the pool used by default by the images.
+ */
+vpImagePool &vpImagePool::getInstance()
+{
+  // Never destroyed, since images with a static storage duration may release their bitmap after the destruction of
+  // a static pool
+  static vpImagePool *pool = new vpImagePool;
+  return *pool;
+}
+
+/*!
+ * Return the size of the blocks allocated for \e size bytes. There are four size classes per power of two, that is
+ * the blocks are at most 25% larger than requested, and the size classes are multiples of
+ * vpImageAllocator::alignment bytes.
+ */
+size_t vpImagePool::getSizeClass(size_t size)
+{
+  if (size <= alignment) {
+    return alignment;
+  }
+  size_t power = alignment;
+  while ((power << 1) < size) {
+    power <<= 1;
+  }
+  const size_t step = (power / 4 > alignment) ? (power / 4) : alignment;
+  return ((size + step - 1) / step) * step;
+}
+
+/*!
+ * Reset the hits and misses counters.
+ */
+void vpImagePool::resetStatistics()
+{
+#if defined(VISP_HAVE_THREADS)
+  std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+  m_hits = 0;
+  m_misses = 0;
+}
+
+/*!
+ * Set the maximum number of bytes of the released blocks kept by the pool. The cached blocks beyond this limit are
+ * given back to the system. Set to 0 to disable the recycling of the blocks.
+ */
+void vpImagePool::setMaxCachedBytes(size_t max_bytes)
+{
+  {
+#if defined(VISP_HAVE_THREADS)
+    std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+    m_maxCachedBytes = max_bytes;
+  }
+  trim(max_bytes);
+}
+
+/*!
+ * Give cached blocks back to the system until the pool holds at most \e max_bytes bytes, starting with the largest.
+ */
+void vpImagePool::trim(size_t max_bytes)
+{
+  std::vector<void *> to_free;
+  {
+#if defined(VISP_HAVE_THREADS)
+    std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+    std::map<size_t, std::vector<void *> >::reverse_iterator it = m_freeBlocks.rbegin();
+    while ((m_cachedBytes > max_bytes) && (it != m_freeBlocks.rend())) {
+      while ((m_cachedBytes > max_bytes) && (!it->second.empty())) {
+        to_free.push_back(it->second.back());
+        it->second.pop_back();
+        m_cachedBytes -= it->first;
+      }
+      ++it;
+    }
+  }
+  for (size_t i = 0; i < to_free.size(); ++i) {
+    alignedFree(to_free[i]);
+  }
+}
+
+END_VISP_NAMESPACE
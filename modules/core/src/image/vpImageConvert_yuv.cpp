@@ -36,26 +36,393 @@
   \brief Various yuv formats to RGB and RGBa conversion.
 */
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <string.h>
+#include <vector>
 
 #include <visp3/core/vpConfig.h>
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpImageConvert.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#if defined _WIN32 && defined(_M_ARM64)
+#define _ARM64_DISTINCT_NEON_TYPES
+#include <Intrin.h>
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#elif (defined(__ARM_NEON__) || defined (__ARM_NEON)) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#else
+#define VISP_HAVE_NEON 0
+#endif
+
+BEGIN_VISP_NAMESPACE
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace
 {
-void vpSAT(int &c)
+/*
+ * The conversions are done in two stages. The chroma samples are first converted into the terms added to the
+ * luminance to get the R, G and B values, with the integer formulas of the original scalar code, and replicated for
+ * each pixel sharing the samples. The R, G and B values of a row are then computed with 16-bit saturated arithmetic,
+ * vectorized with SSE2 or NEON.
+ */
+
+// Number of pixels converted at once for the packed formats
+const unsigned int yuvPackedBlockSize = 4096;
+
+// Per-thread buffers with the luminance and the chroma terms of the pixels of a block
+struct vpYuvRowBuffer
+{
+  explicit vpYuvRowBuffer(unsigned int n) : y(n), dr(n), dg(n), db(n) { }
+
+  std::vector<unsigned char> y;
+  std::vector<short> dr;
+  std::vector<short> dg;
+  std::vector<short> db;
+};
+
+/*
+ * Chroma terms of the YUV 4:1:1, 4:2:2, 4:2:0, 4:4:4, YV12 and YVU9 formats, written for \e count pixels.
+ * The original equations
+ *   R = Y           + 1.402 V
+ *   G = Y - 0.344 U - 0.714 V
+ *   B = Y + 1.772 U
+ * are approximated by R = Y + 2 V', G = Y - U' - V', B = Y + 5 U' with U' = 0.354 U and V' = 0.707 V truncated to
+ * integers.
+ */
+inline void yuvChromaTerms(int u, int v, short *dr, short *dg, short *db, unsigned int count)
+{
+  const int val_128 = 128;
+  const int U = ((u - val_128) * 354) / 1000;
+  const int V = ((v - val_128) * 707) / 1000;
+  for (unsigned int k = 0; k < count; ++k) {
+    dr[k] = static_cast<short>(2 * V);
+    dg[k] = static_cast<short>(-U - V);
+    db[k] = static_cast<short>(5 * U);
+  }
+}
+
+// Chroma terms of the YUYV format, written for \e count pixels
+inline void yuyvChromaTerms(int u, int v, short *dr, short *dg, short *db, unsigned int count)
 {
-  const int val_255 = 255;
-  if (c < 0) {
-    c = 0;
+  const int val_128 = 128;
+  const int val_256 = 256;
+  const int cb = ((u - val_128) * 454) / val_256;
+  const int cg = (((u - val_128) * 88) + ((v - val_128) * 183)) / val_256;
+  const int cr = ((v - val_128) * 359) / val_256;
+  for (unsigned int k = 0; k < count; ++k) {
+    dr[k] = static_cast<short>(cr);
+    dg[k] = static_cast<short>(-cg);
+    db[k] = static_cast<short>(cb);
   }
-  else if (c > val_255) {
+}
 
-    c = val_255;
+inline unsigned char yuvSaturate(int c) { return static_cast<unsigned char>(std::min<int>(std::max<int>(c, 0), 255)); }
+
+/*
+ * Compute the RGB (\e alpha is false) or RGBa (\e alpha is true) values of \e n pixels from their luminance and
+ * chroma terms.
+ */
+void yuvToRGBRow(const unsigned char *y, const short *dr, const short *dg, const short *db, unsigned char *dst,
+                 unsigned int n, bool alpha)
+{
+  unsigned int j = 0;
+#if VISP_HAVE_SSE2
+  static const bool checkSSE2 = vpCPUFeatures::checkSSE2();
+  if (checkSSE2) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i a = _mm_set1_epi8(static_cast<char>(vpRGBa::alpha_default));
+    for (; (j + 16) <= n; j += 16) {
+      const __m128i vy = _mm_loadu_si128(reinterpret_cast<const __m128i *>(y + j));
+      const __m128i ylo = _mm_unpacklo_epi8(vy, zero);
+      const __m128i yhi = _mm_unpackhi_epi8(vy, zero);
+      // The packing saturates the values to [0, 255]
+      const __m128i r = _mm_packus_epi16(_mm_add_epi16(ylo, _mm_loadu_si128(reinterpret_cast<const __m128i *>(dr + j))),
+                                         _mm_add_epi16(yhi, _mm_loadu_si128(reinterpret_cast<const __m128i *>(dr + j + 8))));
+      const __m128i g = _mm_packus_epi16(_mm_add_epi16(ylo, _mm_loadu_si128(reinterpret_cast<const __m128i *>(dg + j))),
+                                         _mm_add_epi16(yhi, _mm_loadu_si128(reinterpret_cast<const __m128i *>(dg + j + 8))));
+      const __m128i b = _mm_packus_epi16(_mm_add_epi16(ylo, _mm_loadu_si128(reinterpret_cast<const __m128i *>(db + j))),
+                                         _mm_add_epi16(yhi, _mm_loadu_si128(reinterpret_cast<const __m128i *>(db + j + 8))));
+      if (alpha) {
+        const __m128i rg_lo = _mm_unpacklo_epi8(r, g);
+        const __m128i rg_hi = _mm_unpackhi_epi8(r, g);
+        const __m128i ba_lo = _mm_unpacklo_epi8(b, a);
+        const __m128i ba_hi = _mm_unpackhi_epi8(b, a);
+        __m128i *d = reinterpret_cast<__m128i *>(dst + (4 * j));
+        _mm_storeu_si128(d, _mm_unpacklo_epi16(rg_lo, ba_lo));
+        _mm_storeu_si128(d + 1, _mm_unpackhi_epi16(rg_lo, ba_lo));
+        _mm_storeu_si128(d + 2, _mm_unpacklo_epi16(rg_hi, ba_hi));
+        _mm_storeu_si128(d + 3, _mm_unpackhi_epi16(rg_hi, ba_hi));
+      }
+      else {
+        // There is no 3 channels interleaving with SSE2
+        unsigned char rgb[3][16];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(rgb[0]), r);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(rgb[1]), g);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(rgb[2]), b);
+        unsigned char *d = dst + (3 * j);
+        for (unsigned int k = 0; k < 16; ++k) {
+          d[3 * k] = rgb[0][k];
+          d[(3 * k) + 1] = rgb[1][k];
+          d[(3 * k) + 2] = rgb[2][k];
+        }
+      }
+    }
+  }
+#elif VISP_HAVE_NEON
+  for (; (j + 16) <= n; j += 16) {
+    const uint8x16_t vy = vld1q_u8(y + j);
+    const int16x8_t ylo = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(vy)));
+    const int16x8_t yhi = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(vy)));
+    // The narrowing saturates the values to [0, 255]
+    const uint8x16_t r = vcombine_u8(vqmovun_s16(vaddq_s16(ylo, vld1q_s16(dr + j))),
+                                     vqmovun_s16(vaddq_s16(yhi, vld1q_s16(dr + j + 8))));
+    const uint8x16_t g = vcombine_u8(vqmovun_s16(vaddq_s16(ylo, vld1q_s16(dg + j))),
+                                     vqmovun_s16(vaddq_s16(yhi, vld1q_s16(dg + j + 8))));
+    const uint8x16_t b = vcombine_u8(vqmovun_s16(vaddq_s16(ylo, vld1q_s16(db + j))),
+                                     vqmovun_s16(vaddq_s16(yhi, vld1q_s16(db + j + 8))));
+    if (alpha) {
+      uint8x16x4_t rgba;
+      rgba.val[0] = r;
+      rgba.val[1] = g;
+      rgba.val[2] = b;
+      rgba.val[3] = vdupq_n_u8(vpRGBa::alpha_default);
+      vst4q_u8(dst + (4 * j), rgba);
+    }
+    else {
+      uint8x16x3_t rgb;
+      rgb.val[0] = r;
+      rgb.val[1] = g;
+      rgb.val[2] = b;
+      vst3q_u8(dst + (3 * j), rgb);
+    }
+  }
+#endif
+  const unsigned int channels = alpha ? 4 : 3;
+  for (; j < n; ++j) {
+    unsigned char *d = dst + (channels * j);
+    d[0] = yuvSaturate(y[j] + dr[j]);
+    d[1] = yuvSaturate(y[j] + dg[j]);
+    d[2] = yuvSaturate(y[j] + db[j]);
+    if (alpha) {
+      d[3] = vpRGBa::alpha_default;
+    }
   }
 }
+
+/*
+ * Write the outputs of \e n pixels whose luminance is \e y and chroma terms are in \e buffer. \e grey and \e rgb are
+ * optional.
+ */
+void yuvOutputRow(const unsigned char *y, const vpYuvRowBuffer &buffer, unsigned int n, unsigned char *grey,
+                  unsigned char *rgb, unsigned int channels)
+{
+  if ((grey != nullptr) && (grey != y)) {
+    memcpy(grey, y, n);
+  }
+  if (rgb != nullptr) {
+    yuvToRGBRow(y, &buffer.dr[0], &buffer.dg[0], &buffer.db[0], rgb, n, channels == 4);
+  }
 }
 
-BEGIN_VISP_NAMESPACE
+// Layout of the groups of pixels of the packed formats: y0 u01 y1 v01
+struct vpYuyvLayout
+{
+  static const unsigned int pixels = 2;
+  static const unsigned int bytes = 4;
+
+  static void extract(const unsigned char *s, unsigned char *y, short *dr, short *dg, short *db)
+  {
+    y[0] = s[0];
+    y[1] = s[2];
+    yuyvChromaTerms(s[1], s[3], dr, dg, db, pixels);
+  }
+};
+
+// u01 y0 v01 y1
+struct vpYuv422Layout
+{
+  static const unsigned int pixels = 2;
+  static const unsigned int bytes = 4;
+
+  static void extract(const unsigned char *s, unsigned char *y, short *dr, short *dg, short *db)
+  {
+    y[0] = s[1];
+    y[1] = s[3];
+    yuvChromaTerms(s[0], s[2], dr, dg, db, pixels);
+  }
+};
+
+// u y0 y1 v y2 y3
+struct vpYuv411Layout
+{
+  static const unsigned int pixels = 4;
+  static const unsigned int bytes = 6;
+
+  static void extract(const unsigned char *s, unsigned char *y, short *dr, short *dg, short *db)
+  {
+    y[0] = s[1];
+    y[1] = s[2];
+    y[2] = s[4];
+    y[3] = s[5];
+    yuvChromaTerms(s[0], s[3], dr, dg, db, pixels);
+  }
+};
+
+// u y v
+struct vpYuv444Layout
+{
+  static const unsigned int pixels = 1;
+  static const unsigned int bytes = 3;
+
+  static void extract(const unsigned char *s, unsigned char *y, short *dr, short *dg, short *db)
+  {
+    y[0] = s[1];
+    yuvChromaTerms(s[0], s[2], dr, dg, db, pixels);
+  }
+};
+
+/*
+ * Packed formats, made of groups of pixels sharing the same chroma samples. The image is converted by blocks of
+ * yuvPackedBlockSize pixels, regardless of the rows. When the grey image is asked, the luminance is directly
+ * extracted in it.
+ */
+template <typename Layout> class vpYuvPackedFormat
+{
+public:
+  vpYuvPackedFormat(const unsigned char *src, unsigned int nbPixels, unsigned char *grey, unsigned char *rgb,
+                    unsigned int channels)
+    : m_src(src), m_nbPixels((nbPixels / Layout::pixels) * Layout::pixels), m_grey(grey), m_rgb(rgb),
+    m_channels(channels)
+  { }
+
+  unsigned int getBlockSize() const { return yuvPackedBlockSize; }
+  unsigned int getNbBlocks() const { return (m_nbPixels + yuvPackedBlockSize - 1) / yuvPackedBlockSize; }
+
+  void convert(unsigned int block, vpYuvRowBuffer &buffer) const
+  {
+    const unsigned int first = block * yuvPackedBlockSize;
+    const unsigned int n = std::min<unsigned int>(yuvPackedBlockSize, m_nbPixels - first);
+    const unsigned char *s = m_src + ((first / Layout::pixels) * Layout::bytes);
+    unsigned char *grey = (m_grey != nullptr) ? (m_grey + first) : nullptr;
+    unsigned char *y = (grey != nullptr) ? grey : &buffer.y[0];
+    for (unsigned int j = 0; j < n; j += Layout::pixels) {
+      Layout::extract(s, y + j, &buffer.dr[j], &buffer.dg[j], &buffer.db[j]);
+      s += Layout::bytes;
+    }
+    yuvOutputRow(y, buffer, n, grey, (m_rgb != nullptr) ? (m_rgb + (m_channels * first)) : nullptr, m_channels);
+  }
+
+private:
+  const unsigned char *m_src;
+  unsigned int m_nbPixels;
+  unsigned char *m_grey;
+  unsigned char *m_rgb;
+  unsigned int m_channels;
+};
+
+/*
+ * Planar formats, where a chroma sample is shared by a square of 2^shift x 2^shift pixels. A block is a row of chroma
+ * samples, whose terms are computed once for the 2^shift rows of pixels. As in the original code, the last rows and
+ * columns of an image whose size is not a multiple of 2^shift are not converted.
+ */
+class vpYuvPlanarFormat
+{
+public:
+  vpYuvPlanarFormat(const unsigned char *y, const unsigned char *u, const unsigned char *v, unsigned int width,
+                    unsigned int height, unsigned int shift, unsigned char *grey, unsigned char *rgb,
+                    unsigned int channels)
+    : m_y(y), m_u(u), m_v(v), m_width(width), m_height(height), m_shift(shift), m_grey(grey), m_rgb(rgb),
+    m_channels(channels)
+  { }
+
+  unsigned int getBlockSize() const { return m_width; }
+  unsigned int getNbBlocks() const { return m_height >> m_shift; }
+
+  void convert(unsigned int block, vpYuvRowBuffer &buffer) const
+  {
+    const unsigned int factor = 1U << m_shift;
+    const unsigned int chromaWidth = m_width >> m_shift;
+    const unsigned char *u = m_u + (block * chromaWidth);
+    const unsigned char *v = m_v + (block * chromaWidth);
+    for (unsigned int j = 0; j < chromaWidth; ++j) {
+      const unsigned int k = j << m_shift;
+      yuvChromaTerms(u[j], v[j], &buffer.dr[k], &buffer.dg[k], &buffer.db[k], factor);
+    }
+    for (unsigned int k = 0; k < factor; ++k) {
+      const unsigned int i = (block << m_shift) + k;
+      if (m_grey != nullptr) {
+        memcpy(m_grey + (i * m_width), m_y + (i * m_width), m_width);
+      }
+      yuvOutputRow(m_y + (i * m_width), buffer, chromaWidth << m_shift, nullptr,
+                   (m_rgb != nullptr) ? (m_rgb + (i * m_width * m_channels)) : nullptr, m_channels);
+    }
+  }
+
+private:
+  const unsigned char *m_y;
+  const unsigned char *m_u;
+  const unsigned char *m_v;
+  unsigned int m_width;
+  unsigned int m_height;
+  unsigned int m_shift;
+  unsigned char *m_grey;
+  unsigned char *m_rgb;
+  unsigned int m_channels;
+};
+
+// Convert the blocks of \e format, in parallel if OpenMP is available
+template <typename Format> void yuvConvert(const Format &format, unsigned int nThreads)
+{
+  const int nbBlocks = static_cast<int>(format.getNbBlocks());
+  if ((nbBlocks == 0) || (format.getBlockSize() == 0)) {
+    return;
+  }
+#if defined(_OPENMP)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel
+#else
+  (void)nThreads;
+#endif
+  {
+    vpYuvRowBuffer buffer(format.getBlockSize());
+#if defined(_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (int block = 0; block < nbBlocks; ++block) {
+      format.convert(static_cast<unsigned int>(block), buffer);
+    }
+  }
+}
+
+/*
+ * Convert a planar image, whose \e u and \e v planes are 2^shift times smaller in each direction. The rows of the grey
+ * image that are not covered by the chroma samples are also copied, as YUV420ToGrey() does.
+ */
+void yuvPlanarConvert(const unsigned char *yuv, const unsigned char *u, const unsigned char *v, unsigned int width,
+                      unsigned int height, unsigned int shift, unsigned char *grey, unsigned char *rgb,
+                      unsigned int channels, unsigned int nThreads)
+{
+  yuvConvert(vpYuvPlanarFormat(yuv, u, v, width, height, shift, grey, rgb, channels), nThreads);
+  if (grey != nullptr) {
+    const unsigned int rows = (height >> shift) << shift;
+    memcpy(grey + (rows * width), yuv + (rows * width), (height - rows) * width);
+  }
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /*!
   Convert an image from YUYV 4:2:2 (y0 u01 y1 v01 y2 u23 y3 v23 ...) to RGB32.
   Destination rgba memory area has to be allocated before.
@@ -66,66 +433,14 @@ BEGIN_VISP_NAMESPACE
   \param[out] rgba : Pointer to the RGB32 bitmap that should be allocated with a size of \e width * \e height * 4.
   \param[in] width : Image width.
   \param[in] height : Image height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 
-  \sa YUV422ToRGBa()
+  \sa YUV422ToRGBa(), YUYVToGreyAndRGBa()
 */
-void vpImageConvert::YUYVToRGBa(unsigned char *yuyv, unsigned char *rgba, unsigned int width, unsigned int height)
+void vpImageConvert::YUYVToRGBa(unsigned char *yuyv, unsigned char *rgba, unsigned int width, unsigned int height,
+                                unsigned int nThreads)
 {
-  unsigned char *s;
-  unsigned char *d;
-  int w, h;
-  int r, g, b, cr, cg, cb, y1, y2;
-  const int val_2 = 2;
-  const int val_88 = 88;
-  const int val_128 = 128;
-  const int val_183 = 183;
-  const int val_256 = 256;
-  const int val_359 = 359;
-  const int val_454 = 454;
-
-  h = static_cast<int>(height);
-  w = static_cast<int>(width);
-  s = yuyv;
-  d = rgba;
-  while (h--) {
-    int c = w / val_2;
-    while (c--) {
-      y1 = *s;
-      ++s;
-      cb = ((*s - val_128) * val_454) / val_256;
-      cg = (*s - val_128) * val_88;
-      ++s;
-      y2 = *s;
-      ++s;
-      cr = ((*s - val_128) * val_359) / val_256;
-      cg = (cg + ((*s - val_128) * val_183)) / val_256;
-      ++s;
-
-      r = y1 + cr;
-      b = y1 + cb;
-      g = y1 - cg;
-      vpSAT(r);
-      vpSAT(g);
-      vpSAT(b);
-
-      *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-      *d++ = vpRGBa::alpha_default;
-
-      r = y2 + cr;
-      b = y2 + cb;
-      g = y2 - cg;
-      vpSAT(r);
-      vpSAT(g);
-      vpSAT(b);
-
-      *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-      *d++ = vpRGBa::alpha_default;
-    }
-  }
+  yuvConvert(vpYuvPackedFormat<vpYuyvLayout>(yuyv, height * ((width / 2) * 2), nullptr, rgba, 4), nThreads);
 }
 
 /*!
@@ -136,64 +451,14 @@ void vpImageConvert::YUYVToRGBa(unsigned char *yuyv, unsigned char *rgba, unsign
   \param[out] rgb : Pointer to the RGB32 bitmap that should be allocated with a size of \e width * \e height * 3.
   \param[in] width : Image width.
   \param[in] height : Image height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 
   \sa YUV422ToRGB()
 */
-void vpImageConvert::YUYVToRGB(unsigned char *yuyv, unsigned char *rgb, unsigned int width, unsigned int height)
+void vpImageConvert::YUYVToRGB(unsigned char *yuyv, unsigned char *rgb, unsigned int width, unsigned int height,
+                               unsigned int nThreads)
 {
-  unsigned char *s;
-  unsigned char *d;
-  int h, w;
-  int r, g, b, cr, cg, cb, y1, y2;
-  const int val_2 = 2;
-  const int val_88 = 88;
-  const int val_128 = 128;
-  const int val_183 = 183;
-  const int val_256 = 256;
-  const int val_359 = 359;
-  const int val_454 = 454;
-
-  h = static_cast<int>(height);
-  w = static_cast<int>(width);
-  s = yuyv;
-  d = rgb;
-  while (h--) {
-    int c = w / val_2;
-    while (c--) {
-      y1 = *s;
-      ++s;
-      cb = ((*s - val_128) * val_454) / val_256;
-      cg = (*s - val_128) * val_88;
-      ++s;
-      y2 = *s;
-      ++s;
-      cr = ((*s - val_128) * val_359) / val_256;
-      cg = (cg + ((*s - val_128) * val_183)) / val_256;
-      ++s;
-
-      r = y1 + cr;
-      b = y1 + cb;
-      g = y1 - cg;
-      vpSAT(r);
-      vpSAT(g);
-      vpSAT(b);
-
-      *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-
-      r = y2 + cr;
-      b = y2 + cb;
-      g = y2 - cg;
-      vpSAT(r);
-      vpSAT(g);
-      vpSAT(b);
-
-      *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-    }
-  }
+  yuvConvert(vpYuvPackedFormat<vpYuyvLayout>(yuyv, height * ((width / 2) * 2), nullptr, rgb, 3), nThreads);
 }
 
 /*!
@@ -219,6 +484,23 @@ void vpImageConvert::YUYVToGrey(unsigned char *yuyv, unsigned char *grey, unsign
   }
 }
 
+/*!
+  Convert an image from YUYV 4:2:2 (y0 u01 y1 v01 y2 u23 y3 v23 ...) to both a grey and a RGB32 image in a single
+  pass. The results are the same as YUYVToGrey() and YUYVToRGBa().
+
+  \param[in] yuyv : Pointer to the bitmap containing the YUYV 4:2:2 data.
+  \param[out] grey : Pointer to the 8-bits grey bitmap that should be allocated with a size of \e width * \e height.
+  \param[out] rgba : Pointer to the RGB32 bitmap that should be allocated with a size of \e width * \e height * 4.
+  \param[in] width : Image width.
+  \param[in] height : Image height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
+*/
+void vpImageConvert::YUYVToGreyAndRGBa(unsigned char *yuyv, unsigned char *grey, unsigned char *rgba, unsigned int width,
+                                       unsigned int height, unsigned int nThreads)
+{
+  yuvConvert(vpYuvPackedFormat<vpYuyvLayout>(yuyv, height * ((width / 2) * 2), grey, rgba, 4), nThreads);
+}
+
 /*!
   Convert YUV 4:1:1 (u y1 y2 v y3 y4) images into RGBa images. The alpha
   component of the converted image is set to vpRGBa::alpha_default.
@@ -226,91 +508,11 @@ void vpImageConvert::YUYVToGrey(unsigned char *yuyv, unsigned char *grey, unsign
   \param[in] yuv : Pointer to the bitmap containing the YUV 4:1:1 data.
   \param[out] rgba : Pointer to the RGBA 32-bits bitmap that should be allocated with a size of width * height * 4.
   \param[in] size : Image size corresponding to width * height.
-
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 */
-void vpImageConvert::YUV411ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size)
+void vpImageConvert::YUV411ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size, unsigned int nThreads)
 {
-  const unsigned int val_128 = 128;
-  for (unsigned int i = size / 4; i; --i) {
-    int U = static_cast<int>((*yuv - val_128) * 0.354);
-    ++yuv;
-    int U5 = 5 * U;
-    int Y0 = *yuv;
-    ++yuv;
-    int Y1 = *yuv;
-    ++yuv;
-    int V = static_cast<int>((*yuv - val_128) * 0.707);
-    ++yuv;
-    int V2 = 2 * V;
-    int Y2 = *yuv;
-    ++yuv;
-    int Y3 = *yuv;
-    ++yuv;
-    int UV = -U - V;
-
-    // Original equations
-    // R = Y           + 1.402 V
-    // G = Y - 0.344 U - 0.714 V
-    // B = Y + 1.772 U
-    int R = Y0 + V2;
-    vpSAT(R);
-
-    int G = Y0 + UV;
-    vpSAT(G);
-
-    int B = Y0 + U5;
-    vpSAT(B);
-
-    *rgba++ = static_cast<unsigned char>(R);
-    *rgba++ = static_cast<unsigned char>(G);
-    *rgba++ = static_cast<unsigned char>(B);
-    *rgba++ = vpRGBa::alpha_default;
-
-    //---
-    R = Y1 + V2;
-    vpSAT(R);
-
-    G = Y1 + UV;
-    vpSAT(G);
-
-    B = Y1 + U5;
-    vpSAT(B);
-
-    *rgba++ = static_cast<unsigned char>(R);
-    *rgba++ = static_cast<unsigned char>(G);
-    *rgba++ = static_cast<unsigned char>(B);
-    *rgba++ = vpRGBa::alpha_default;
-
-    //---
-    R = Y2 + V2;
-    vpSAT(R);
-
-    G = Y2 + UV;
-    vpSAT(G);
-
-    B = Y2 + U5;
-    vpSAT(B);
-
-    *rgba++ = static_cast<unsigned char>(R);
-    *rgba++ = static_cast<unsigned char>(G);
-    *rgba++ = static_cast<unsigned char>(B);
-    *rgba++ = vpRGBa::alpha_default;
-
-    //---
-    R = Y3 + V2;
-    vpSAT(R);
-
-    G = Y3 + UV;
-    vpSAT(G);
-
-    B = Y3 + U5;
-    vpSAT(B);
-
-    *rgba++ = static_cast<unsigned char>(R);
-    *rgba++ = static_cast<unsigned char>(G);
-    *rgba++ = static_cast<unsigned char>(B);
-    *rgba++ = vpRGBa::alpha_default;
-  }
+  yuvConvert(vpYuvPackedFormat<vpYuv411Layout>(yuv, size, nullptr, rgba, 4), nThreads);
 }
 
 /*!
@@ -322,56 +524,13 @@ void vpImageConvert::YUV411ToRGBa(unsigned char *yuv, unsigned char *rgba, unsig
   \param[in] yuv : Pointer to the bitmap containing the YUV 4:2:2 data.
   \param[out] rgba : Pointer to the RGBA 32-bits bitmap that should be allocated with a size of width * height * 4.
   \param[in] size : Image size corresponding to width * height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 
   \sa YUYVToRGBa()
 */
-void vpImageConvert::YUV422ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size)
+void vpImageConvert::YUV422ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size, unsigned int nThreads)
 {
-  const unsigned int val_2 = 2;
-  const unsigned int val_128 = 128;
-  for (unsigned int i = size / val_2; i; --i) {
-    int U = static_cast<int>((*yuv - val_128) * 0.354);
-    ++yuv;
-    int U5 = 5 * U;
-    int Y0 = *yuv;
-    ++yuv;
-    int V = static_cast<int>((*yuv - val_128) * 0.707);
-    ++yuv;
-    int V2 = 2 * V;
-    int Y1 = *yuv;
-    ++yuv;
-    int UV = -U - V;
-
-    //---
-    int R = Y0 + V2;
-    vpSAT(R);
-
-    int G = Y0 + UV;
-    vpSAT(G);
-
-    int B = Y0 + U5;
-    vpSAT(B);
-
-    *rgba++ = static_cast<unsigned char>(R);
-    *rgba++ = static_cast<unsigned char>(G);
-    *rgba++ = static_cast<unsigned char>(B);
-    *rgba++ = vpRGBa::alpha_default;
-
-    //---
-    R = Y1 + V2;
-    vpSAT(R);
-
-    G = Y1 + UV;
-    vpSAT(G);
-
-    B = Y1 + U5;
-    vpSAT(B);
-
-    *rgba++ = static_cast<unsigned char>(R);
-    *rgba++ = static_cast<unsigned char>(G);
-    *rgba++ = static_cast<unsigned char>(B);
-    *rgba++ = vpRGBa::alpha_default;
-  }
+  yuvConvert(vpYuvPackedFormat<vpYuv422Layout>(yuv, size, nullptr, rgba, 4), nThreads);
 }
 
 /*!
@@ -410,54 +569,13 @@ void vpImageConvert::YUV411ToGrey(unsigned char *yuv, unsigned char *grey, unsig
   \param[in] yuv : Pointer to the bitmap containing the YUV 4:2:2 data.
   \param[out] rgb : Pointer to the 24-bits RGB bitmap that should be allocated with a size of width * height * 3.
   \param[in] size : Image size corresponding to width * height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 
   \sa YUYVToRGB()
 */
-void vpImageConvert::YUV422ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size)
+void vpImageConvert::YUV422ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size, unsigned int nThreads)
 {
-  const unsigned int val_2 = 2;
-  const unsigned int val_128 = 128;
-  for (unsigned int i = size / val_2; i; --i) {
-    int U = static_cast<int>((*yuv - val_128) * 0.354);
-    ++yuv;
-    int U5 = 5 * U;
-    int Y0 = *yuv;
-    ++yuv;
-    int V = static_cast<int>((*yuv - val_128) * 0.707);
-    ++yuv;
-    int V2 = 2 * V;
-    int Y1 = *yuv;
-    ++yuv;
-    int UV = -U - V;
-
-    //---
-    int R = Y0 + V2;
-    vpSAT(R);
-
-    int G = Y0 + UV;
-    vpSAT(G);
-
-    int B = Y0 + U5;
-    vpSAT(B);
-
-    *rgb++ = static_cast<unsigned char>(R);
-    *rgb++ = static_cast<unsigned char>(G);
-    *rgb++ = static_cast<unsigned char>(B);
-
-    //---
-    R = Y1 + V2;
-    vpSAT(R);
-
-    G = Y1 + UV;
-    vpSAT(G);
-
-    B = Y1 + U5;
-    vpSAT(B);
-
-    *rgb++ = static_cast<unsigned char>(R);
-    *rgb++ = static_cast<unsigned char>(G);
-    *rgb++ = static_cast<unsigned char>(B);
-  }
+  yuvConvert(vpYuvPackedFormat<vpYuv422Layout>(yuv, size, nullptr, rgb, 3), nThreads);
 }
 
 /*!
@@ -484,93 +602,49 @@ void vpImageConvert::YUV422ToGrey(unsigned char *yuv, unsigned char *grey, unsig
   }
 }
 
+/*!
+  Convert YUV 4:2:2 (u01 y0 v01 y1 u23 y2 v23 y3 ...) images into both a grey and a RGBa image in a single pass.
+  The results are the same as YUV422ToGrey() and YUV422ToRGBa().
+
+  \param[in] yuv : Pointer to the bitmap containing the YUV 4:2:2 data.
+  \param[out] grey : Pointer to the 8-bits grey bitmap that should be allocated with a size of width * height.
+  \param[out] rgba : Pointer to the RGBA 32-bits bitmap that should be allocated with a size of width * height * 4.
+  \param[in] size : Image size corresponding to width * height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
+*/
+void vpImageConvert::YUV422ToGreyAndRGBa(unsigned char *yuv, unsigned char *grey, unsigned char *rgba, unsigned int size,
+                                         unsigned int nThreads)
+{
+  yuvConvert(vpYuvPackedFormat<vpYuv422Layout>(yuv, size, grey, rgba, 4), nThreads);
+}
+
 /*!
   Convert YUV 4:1:1 (u y1 y2 v y3 y4) into a RGB 24bits image.
 
   \param[in] yuv : Pointer to the bitmap containing the YUV 4:1:1 data.
   \param[out] rgb : Pointer to the 24-bits RGB bitmap that should be allocated with a size of width * height * 3.
   \param[in] size : Image size corresponding to width * height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
+*/
+void vpImageConvert::YUV411ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size, unsigned int nThreads)
+{
+  yuvConvert(vpYuvPackedFormat<vpYuv411Layout>(yuv, size, nullptr, rgb, 3), nThreads);
+}
+
+/*!
+  Convert YUV 4:1:1 (u y1 y2 v y3 y4) images into both a grey and a RGBa image in a single pass. The results are the
+  same as YUV411ToGrey() and YUV411ToRGBa().
 
+  \param[in] yuv : Pointer to the bitmap containing the YUV 4:1:1 data.
+  \param[out] grey : Pointer to the 8-bits grey bitmap that should be allocated with a size of width * height.
+  \param[out] rgba : Pointer to the RGBA 32-bits bitmap that should be allocated with a size of width * height * 4.
+  \param[in] size : Image size corresponding to width * height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 */
-void vpImageConvert::YUV411ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size)
+void vpImageConvert::YUV411ToGreyAndRGBa(unsigned char *yuv, unsigned char *grey, unsigned char *rgba, unsigned int size,
+                                         unsigned int nThreads)
 {
-  const unsigned int val_128 = 128;
-  for (unsigned int i = size / 4; i; --i) {
-    int U = static_cast<int>((*yuv - val_128) * 0.354);
-    ++yuv;
-    int U5 = 5 * U;
-    int Y0 = *yuv;
-    ++yuv;
-    int Y1 = *yuv;
-    ++yuv;
-    int V = static_cast<int>((*yuv - val_128) * 0.707);
-    ++yuv;
-    int V2 = 2 * V;
-    int Y2 = *yuv;
-    ++yuv;
-    int Y3 = *yuv;
-    ++yuv;
-    int UV = -U - V;
-
-    // Original equations
-    // R = Y           + 1.402 V
-    // G = Y - 0.344 U - 0.714 V
-    // B = Y + 1.772 U
-    int R = Y0 + V2;
-    vpSAT(R);
-
-    int G = Y0 + UV;
-    vpSAT(G);
-
-    int B = Y0 + U5;
-    vpSAT(B);
-
-    *rgb++ = static_cast<unsigned char>(R);
-    *rgb++ = static_cast<unsigned char>(G);
-    *rgb++ = static_cast<unsigned char>(B);
-
-    //---
-    R = Y1 + V2;
-    vpSAT(R);
-
-    G = Y1 + UV;
-    vpSAT(G);
-
-    B = Y1 + U5;
-    vpSAT(B);
-
-    *rgb++ = static_cast<unsigned char>(R);
-    *rgb++ = static_cast<unsigned char>(G);
-    *rgb++ = static_cast<unsigned char>(B);
-
-    //---
-    R = Y2 + V2;
-    vpSAT(R);
-
-    G = Y2 + UV;
-    vpSAT(G);
-
-    B = Y2 + U5;
-    vpSAT(B);
-
-    *rgb++ = static_cast<unsigned char>(R);
-    *rgb++ = static_cast<unsigned char>(G);
-    *rgb++ = static_cast<unsigned char>(B);
-
-    //---
-    R = Y3 + V2;
-    vpSAT(R);
-
-    G = Y3 + UV;
-    vpSAT(G);
-
-    B = Y3 + U5;
-    vpSAT(B);
-
-    *rgb++ = static_cast<unsigned char>(R);
-    *rgb++ = static_cast<unsigned char>(G);
-    *rgb++ = static_cast<unsigned char>(B);
-  }
+  yuvConvert(vpYuvPackedFormat<vpYuv411Layout>(yuv, size, grey, rgba, 4), nThreads);
 }
 
 /*!
@@ -582,107 +656,13 @@ void vpImageConvert::YUV411ToRGB(unsigned char *yuv, unsigned char *rgb, unsigne
   \param[out] rgba : Pointer to the 32-bits RGBA bitmap that should be allocated with a size of width * height * 4.
   \param[in] width : Image width.
   \param[in] height : Image height.
-
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 */
-void vpImageConvert::YUV420ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height)
+void vpImageConvert::YUV420ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height,
+                                  unsigned int nThreads)
 {
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
-  const int val_2 = 2;
-  const int val_4 = 4;
-  const int val_5 = 5;
-  const int val_7 = 7;
-  unsigned int size = width * height;
-  unsigned char *iU = yuv + size;
-  unsigned char *iV = yuv + ((val_5 * size) / val_4);
-  const unsigned int halfHeight = height / val_2, halfWidth = width / val_2;
-  const unsigned int val_128 = 128;
-  for (unsigned int i = 0; i < halfHeight; ++i) {
-    for (unsigned int j = 0; j < halfWidth; ++j) {
-      U = static_cast<int>(((*iU) - val_128) * 0.354);
-      ++iU;
-      U5 = static_cast<int>(val_5) * U;
-      V = static_cast<int>(((*iV) - val_128) * 0.707);
-      ++iV;
-      V2 = static_cast<int>(val_2) * V;
-      UV = -U - V;
-      Y0 = *yuv;
-      ++yuv;
-      Y1 = *yuv;
-      yuv = yuv + (width - 1);
-      Y2 = *yuv;
-      ++yuv;
-      Y3 = *yuv;
-      yuv = (yuv - width) + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      vpSAT(R);
-
-      G = Y0 + UV;
-      vpSAT(G);
-
-      B = Y0 + U5;
-      vpSAT(B);
-
-      *rgba++ = static_cast<unsigned char>(R);
-      *rgba++ = static_cast<unsigned char>(G);
-      *rgba++ = static_cast<unsigned char>(B);
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y1 + V2;
-      vpSAT(R);
-
-      G = Y1 + UV;
-      vpSAT(G);
-
-      B = Y1 + U5;
-      vpSAT(B);
-
-      *rgba++ = static_cast<unsigned char>(R);
-      *rgba++ = static_cast<unsigned char>(G);
-      *rgba++ = static_cast<unsigned char>(B);
-      *rgba = vpRGBa::alpha_default;
-      rgba = (rgba + (val_4 * width)) - val_7;
-
-      //---
-      R = Y2 + V2;
-      vpSAT(R);
-
-      G = Y2 + UV;
-      vpSAT(G);
-
-      B = Y2 + U5;
-      vpSAT(B);
-
-      *rgba++ = static_cast<unsigned char>(R);
-      *rgba++ = static_cast<unsigned char>(G);
-      *rgba++ = static_cast<unsigned char>(B);
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y3 + V2;
-      vpSAT(R);
-
-      G = Y3 + UV;
-      vpSAT(G);
-
-      B = Y3 + U5;
-      vpSAT(B);
-
-      *rgba++ = static_cast<unsigned char>(R);
-      *rgba++ = static_cast<unsigned char>(G);
-      *rgba++ = static_cast<unsigned char>(B);
-      *rgba = vpRGBa::alpha_default;
-      rgba = (rgba - (val_4 * width)) + 1;
-    }
-    yuv += width;
-    rgba += val_4 * width;
-  }
+  const unsigned int size = width * height;
+  yuvPlanarConvert(yuv, yuv + size, yuv + ((5 * size) / 4), width, height, 1, nullptr, rgba, 4, nThreads);
 }
 
 /*!
@@ -692,103 +672,13 @@ void vpImageConvert::YUV420ToRGBa(unsigned char *yuv, unsigned char *rgba, unsig
   \param[out] rgb : Pointer to the 24-bits RGB bitmap that should be allocated with a size of width * height * 3.
   \param[in] width : Image width.
   \param[in] height : Image height.
-
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 */
-void vpImageConvert::YUV420ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height)
+void vpImageConvert::YUV420ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height,
+                                 unsigned int nThreads)
 {
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
-  const unsigned int val_2 = 2;
-  const unsigned int val_3 = 3;
-  const unsigned int val_4 = 4;
-  const unsigned int val_5 = 5;
-  unsigned int size = width * height;
-  unsigned char *iU = yuv + size;
-  unsigned char *iV = yuv + ((val_5 * size) / val_4);
-  const unsigned int halfHeight = height / val_2, halfWidth = width / val_2;
-  const unsigned int val_128 = 128;
-  for (unsigned int i = 0; i < halfHeight; ++i) {
-    for (unsigned int j = 0; j < halfWidth; ++j) {
-      U = static_cast<int>(((*iU) - val_128) * 0.354);
-      ++iU;
-      U5 = static_cast<int>(val_5) * U;
-      V = static_cast<int>(((*iV) - val_128) * 0.707);
-      ++iV;
-      V2 = static_cast<int>(val_2) * V;
-      UV = -U - V;
-      Y0 = *yuv;
-      ++yuv;
-      Y1 = *yuv;
-      yuv = yuv + (width - 1);
-      Y2 = *yuv;
-      ++yuv;
-      Y3 = *yuv;
-      yuv = (yuv - width) + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      vpSAT(R);
-
-      G = Y0 + UV;
-      vpSAT(G);
-
-      B = Y0 + U5;
-      vpSAT(B);
-
-      *rgb++ = static_cast<unsigned char>(R);
-      *rgb++ = static_cast<unsigned char>(G);
-      *rgb++ = static_cast<unsigned char>(B);
-
-      //---
-      R = Y1 + V2;
-      vpSAT(R);
-
-      G = Y1 + UV;
-      vpSAT(G);
-
-      B = Y1 + U5;
-      vpSAT(B);
-
-      *rgb++ = static_cast<unsigned char>(R);
-      *rgb++ = static_cast<unsigned char>(G);
-      *rgb = static_cast<unsigned char>(B);
-      rgb = rgb + ((val_3 * width) - val_5);
-
-      //---
-      R = Y2 + V2;
-      vpSAT(R);
-
-      G = Y2 + UV;
-      vpSAT(G);
-
-      B = Y2 + U5;
-      vpSAT(B);
-
-      *rgb++ = static_cast<unsigned char>(R);
-      *rgb++ = static_cast<unsigned char>(G);
-      *rgb++ = static_cast<unsigned char>(B);
-
-      //---
-      R = Y3 + V2;
-      vpSAT(R);
-
-      G = Y3 + UV;
-      vpSAT(G);
-
-      B = Y3 + U5;
-      vpSAT(B);
-
-      *rgb++ = static_cast<unsigned char>(R);
-      *rgb++ = static_cast<unsigned char>(G);
-      *rgb = static_cast<unsigned char>(B);
-      rgb = (rgb - (val_3 * width)) + 1;
-    }
-    yuv += width;
-    rgb += val_3 * width;
-  }
+  const unsigned int size = width * height;
+  yuvPlanarConvert(yuv, yuv + size, yuv + ((5 * size) / 4), width, height, 1, nullptr, rgb, 3, nThreads);
 }
 
 /*!
@@ -803,6 +693,24 @@ void vpImageConvert::YUV420ToGrey(unsigned char *yuv, unsigned char *grey, unsig
   memcpy(grey, yuv, size);
 }
 
+/*!
+  Convert YUV 4:2:0 [Y(NxM), U(N/2xM/2), V(N/2xM/2)] image into both a grey and a RGBa image in a single pass. The
+  results are the same as YUV420ToGrey() and YUV420ToRGBa().
+
+  \param[in] yuv : Pointer to the bitmap containing the YUV 4:2:0 data.
+  \param[out] grey : Pointer to the 8-bits grey bitmap that should be allocated with a size of width * height.
+  \param[out] rgba : Pointer to the 32-bits RGBA bitmap that should be allocated with a size of width * height * 4.
+  \param[in] width : Image width.
+  \param[in] height : Image height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
+*/
+void vpImageConvert::YUV420ToGreyAndRGBa(unsigned char *yuv, unsigned char *grey, unsigned char *rgba, unsigned int width,
+                                         unsigned int height, unsigned int nThreads)
+{
+  const unsigned int size = width * height;
+  yuvPlanarConvert(yuv, yuv + size, yuv + ((5 * size) / 4), width, height, 1, grey, rgba, 4, nThreads);
+}
+
 /*!
   Convert YUV 4:4:4 (u y v) image into a RGBa image.
 
@@ -811,39 +719,11 @@ void vpImageConvert::YUV420ToGrey(unsigned char *yuv, unsigned char *grey, unsig
   \param[in] yuv : Pointer to the bitmap containing the YUV 4:4:4 data.
   \param[out] rgba : Pointer to the 32-bits RGBA bitmap that should be allocated with a size of width * height * 4.
   \param[in] size : Image size corresponding to image width * height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 */
-void vpImageConvert::YUV444ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size)
+void vpImageConvert::YUV444ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size, unsigned int nThreads)
 {
-  const unsigned int val_128 = 128;
-  for (unsigned int i = 0; i < size; ++i) {
-    int U = static_cast<int>((*yuv - val_128) * 0.354);
-    ++yuv;
-    int U5 = 5 * U;
-    int Y = *yuv;
-    ++yuv;
-    int V = static_cast<int>((*yuv - val_128) * 0.707);
-    ++yuv;
-    int V2 = 2 * V;
-    int UV = -U - V;
-
-    // Original equations
-    // R = Y           + 1.402 V
-    // G = Y - 0.344 U - 0.714 V
-    // B = Y + 1.772 U
-    int R = Y + V2;
-    vpSAT(R);
-
-    int G = Y + UV;
-    vpSAT(G);
-
-    int B = Y + U5;
-    vpSAT(B);
-
-    *rgba++ = static_cast<unsigned char>(R);
-    *rgba++ = static_cast<unsigned char>(G);
-    *rgba++ = static_cast<unsigned char>(B);
-    *rgba++ = vpRGBa::alpha_default;
-  }
+  yuvConvert(vpYuvPackedFormat<vpYuv444Layout>(yuv, size, nullptr, rgba, 4), nThreads);
 }
 
 /*!
@@ -852,38 +732,11 @@ void vpImageConvert::YUV444ToRGBa(unsigned char *yuv, unsigned char *rgba, unsig
   \param[in] yuv : Pointer to the bitmap containing the YUV 4:4:4 data.
   \param[out] rgb : Pointer to the 24-bits RGB bitmap that should be allocated with a size of width * height * 3.
   \param[in] size : Image size corresponding to image width * height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 */
-void vpImageConvert::YUV444ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size)
+void vpImageConvert::YUV444ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size, unsigned int nThreads)
 {
-  const unsigned int val_128 = 128;
-  for (unsigned int i = 0; i < size; ++i) {
-    int U = static_cast<int>((*yuv - val_128) * 0.354);
-    ++yuv;
-    int U5 = 5 * U;
-    int Y = *yuv;
-    ++yuv;
-    int V = static_cast<int>((*yuv - val_128) * 0.707);
-    ++yuv;
-    int V2 = 2 * V;
-    int UV = -U - V;
-
-    // Original equations
-    // R = Y           + 1.402 V
-    // G = Y - 0.344 U - 0.714 V
-    // B = Y + 1.772 U
-    int R = Y + V2;
-    vpSAT(R);
-
-    int G = Y + UV;
-    vpSAT(G);
-
-    int B = Y + U5;
-    vpSAT(B);
-
-    *rgb++ = static_cast<unsigned char>(R);
-    *rgb++ = static_cast<unsigned char>(G);
-    *rgb++ = static_cast<unsigned char>(B);
-  }
+  yuvConvert(vpYuvPackedFormat<vpYuv444Layout>(yuv, size, nullptr, rgb, 3), nThreads);
 }
 
 /*!
@@ -903,6 +756,22 @@ void vpImageConvert::YUV444ToGrey(unsigned char *yuv, unsigned char *grey, unsig
   }
 }
 
+/*!
+  Convert YUV 4:4:4 (u y v) image into both a grey and a RGBa image in a single pass. The results are the same as
+  YUV444ToGrey() and YUV444ToRGBa().
+
+  \param[in] yuv : Pointer to the bitmap containing the YUV 4:4:4 data.
+  \param[out] grey : Pointer to the 8-bits grey bitmap that should be allocated with a size of width * height.
+  \param[out] rgba : Pointer to the 32-bits RGBA bitmap that should be allocated with a size of width * height * 4.
+  \param[in] size : Image size corresponding to image width * height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
+*/
+void vpImageConvert::YUV444ToGreyAndRGBa(unsigned char *yuv, unsigned char *grey, unsigned char *rgba, unsigned int size,
+                                         unsigned int nThreads)
+{
+  yuvConvert(vpYuvPackedFormat<vpYuv444Layout>(yuv, size, grey, rgba, 4), nThreads);
+}
+
 /*!
   Convert YV 1:2 [Y(NxM), V(N/2xM/2), U(N/2xM/2)] image into RGBa image.
 
@@ -912,107 +781,13 @@ void vpImageConvert::YUV444ToGrey(unsigned char *yuv, unsigned char *grey, unsig
   \param[out] rgba : Pointer to the 32-bits RGBA bitmap that should be allocated with a size of width * height * 4.
   \param[in] width : Image width.
   \param[in] height : Image height.
-
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 */
-void vpImageConvert::YV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height)
+void vpImageConvert::YV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height,
+                                unsigned int nThreads)
 {
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
-  const unsigned int val_2 = 2;
-  const unsigned int val_4 = 4;
-  const unsigned int val_5 = 5;
-  const unsigned int val_7 = 7;
-  unsigned int size = width * height;
-  unsigned char *iV = yuv + size;
-  unsigned char *iU = yuv + ((val_5 * size) / val_4);
-  const unsigned int halfHeight = height / val_2, halfWidth = width / val_2;
-  const unsigned int val_128 = 128;
-  for (unsigned int i = 0; i < halfHeight; ++i) {
-    for (unsigned int j = 0; j < halfWidth; ++j) {
-      U = static_cast<int>(((*iU) - val_128) * 0.354);
-      ++iU;
-      U5 = static_cast<int>(val_5) * U;
-      V = static_cast<int>(((*iV) - val_128) * 0.707);
-      ++iV;
-      V2 = static_cast<int>(val_2) * V;
-      UV = -U - V;
-      Y0 = *yuv;
-      ++yuv;
-      Y1 = *yuv;
-      yuv = yuv + (width - 1);
-      Y2 = *yuv;
-      ++yuv;
-      Y3 = *yuv;
-      yuv = (yuv - width) + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      vpSAT(R);
-
-      G = Y0 + UV;
-      vpSAT(G);
-
-      B = Y0 + U5;
-      vpSAT(B);
-
-      *rgba++ = static_cast<unsigned char>(R);
-      *rgba++ = static_cast<unsigned char>(G);
-      *rgba++ = static_cast<unsigned char>(B);
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y1 + V2;
-      vpSAT(R);
-
-      G = Y1 + UV;
-      vpSAT(G);
-
-      B = Y1 + U5;
-      vpSAT(B);
-
-      *rgba++ = static_cast<unsigned char>(R);
-      *rgba++ = static_cast<unsigned char>(G);
-      *rgba++ = static_cast<unsigned char>(B);
-      *rgba = 0;
-      rgba = rgba + ((val_4 * width) - val_7);
-
-      //---
-      R = Y2 + V2;
-      vpSAT(R);
-
-      G = Y2 + UV;
-      vpSAT(G);
-
-      B = Y2 + U5;
-      vpSAT(B);
-
-      *rgba++ = static_cast<unsigned char>(R);
-      *rgba++ = static_cast<unsigned char>(G);
-      *rgba++ = static_cast<unsigned char>(B);
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y3 + V2;
-      vpSAT(R);
-
-      G = Y3 + UV;
-      vpSAT(G);
-
-      B = Y3 + U5;
-      vpSAT(B);
-
-      *rgba++ = static_cast<unsigned char>(R);
-      *rgba++ = static_cast<unsigned char>(G);
-      *rgba++ = static_cast<unsigned char>(B);
-      *rgba = vpRGBa::alpha_default;
-      rgba = (rgba - (val_4 * width)) + 1;
-    }
-    yuv += width;
-    rgba += val_4 * width;
-  }
+  const unsigned int size = width * height;
+  yuvPlanarConvert(yuv, yuv + ((5 * size) / 4), yuv + size, width, height, 1, nullptr, rgba, 4, nThreads);
 }
 
 /*!
@@ -1022,128 +797,33 @@ void vpImageConvert::YV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigne
   \param[out] rgb : Pointer to the 24-bits RGB bitmap that should be allocated with a size of width * height * 3.
   \param[in] width : Image width.
   \param[in] height : Image height.
-
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 */
-void vpImageConvert::YV12ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int height, unsigned int width)
+void vpImageConvert::YV12ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height,
+                               unsigned int nThreads)
 {
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
-  const unsigned int val_2 = 2;
-  const unsigned int val_3 = 3;
-  const unsigned int val_4 = 4;
-  const unsigned int val_5 = 5;
-  unsigned int size = width * height;
-  unsigned char *iV = yuv + size;
-  unsigned char *iU = yuv + ((val_5 * size) / val_4);
-  const unsigned int halfHeight = height / val_2, halfWidth = width / val_2;
-  const unsigned int val_128 = 128;
-  for (unsigned int i = 0; i < halfHeight; ++i) {
-    for (unsigned int j = 0; j < halfWidth; ++j) {
-      U = static_cast<int>(((*iU) - val_128) * 0.354);
-      ++iU;
-      U5 = static_cast<int>(val_5) * U;
-      V = static_cast<int>(((*iV) - val_128) * 0.707);
-      ++iV;
-      V2 = static_cast<int>(val_2) * V;
-      UV = -U - V;
-      Y0 = *yuv;
-      ++yuv;
-      Y1 = *yuv;
-      yuv = yuv + (width - 1);
-      Y2 = *yuv;
-      ++yuv;
-      Y3 = *yuv;
-      yuv = (yuv - width) + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      vpSAT(R);
-
-      G = Y0 + UV;
-      vpSAT(G);
-
-      B = Y0 + U5;
-      vpSAT(B);
-
-      *rgb++ = static_cast<unsigned char>(R);
-      *rgb++ = static_cast<unsigned char>(G);
-      *rgb++ = static_cast<unsigned char>(B);
-
-      //---
-      R = Y1 + V2;
-      vpSAT(R);
-
-      G = Y1 + UV;
-      vpSAT(G);
-
-      B = Y1 + U5;
-      vpSAT(B);
-
-      *rgb++ = static_cast<unsigned char>(R);
-      *rgb++ = static_cast<unsigned char>(G);
-      *rgb = static_cast<unsigned char>(B);
-      rgb = rgb + ((val_3 * width) - val_5);
-
-      //---
-      R = Y2 + V2;
-      vpSAT(R);
-
-      G = Y2 + UV;
-      vpSAT(G);
-
-      B = Y2 + U5;
-      vpSAT(B);
-
-      *rgb++ = static_cast<unsigned char>(R);
-      *rgb++ = static_cast<unsigned char>(G);
-      *rgb++ = static_cast<unsigned char>(B);
-
-      //---
-      R = Y3 + V2;
-      vpSAT(R);
-
-      G = Y3 + UV;
-      vpSAT(G);
-
-      B = Y3 + U5;
-      vpSAT(B);
-
-      *rgb++ = static_cast<unsigned char>(R);
-      *rgb++ = static_cast<unsigned char>(G);
-      *rgb = static_cast<unsigned char>(B);
-      rgb = (rgb - (val_3 * width)) + 1;
-    }
-    yuv += width;
-    rgb += val_3 * width;
-  }
+  const unsigned int size = width * height;
+  yuvPlanarConvert(yuv, yuv + ((5 * size) / 4), yuv + size, width, height, 1, nullptr, rgb, 3, nThreads);
 }
 
-namespace
-{
-/**
-*
-* \brief Subroutine for YVU9 to RGBa conversion.
-*
-* \param[out] rgba : Pointer to the 32-bits RGBA bitmap that should be allocated with a size of width * height * 4.
-* \param[in] R : Value for the red channel.
-* \param[in] G : Value for the green channel.
-* \param[in] B : Value for the blue channel.
-* \param[in] a : Value for the alpha channel.
+/*!
+  Convert YV12 [Y(NxM), V(N/2xM/2), U(N/2xM/2)] image into both a grey and a RGBa image in a single pass. The grey
+  image is the Y plane, as given by YUV420ToGrey().
+
+  \param[in] yuv : Pointer to the bitmap containing the YV 1:2 data.
+  \param[out] grey : Pointer to the 8-bits grey bitmap that should be allocated with a size of width * height.
+  \param[out] rgba : Pointer to the 32-bits RGBA bitmap that should be allocated with a size of width * height * 4.
+  \param[in] width : Image width.
+  \param[in] height : Image height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 */
-void YVU9ToRGBasubroutine(unsigned char *rgba, int R, int G, int B, int a)
+void vpImageConvert::YV12ToGreyAndRGBa(unsigned char *yuv, unsigned char *grey, unsigned char *rgba, unsigned int width,
+                                       unsigned int height, unsigned int nThreads)
 {
-  vpSAT(R);
-  vpSAT(G);
-  vpSAT(B);
-  *rgba++ = static_cast<unsigned char>(R);
-  *rgba++ = static_cast<unsigned char>(G);
-  *rgba++ = static_cast<unsigned char>(B);
-  *rgba++ = a;
-}
+  const unsigned int size = width * height;
+  yuvPlanarConvert(yuv, yuv + ((5 * size) / 4), yuv + size, width, height, 1, grey, rgba, 4, nThreads);
 }
+
 /*!
   Convert YVU 9 [Y(NxM), V(N/4xM/4), U(N/4xM/4)] image into a RGBa image.
 
@@ -1153,363 +833,46 @@ void YVU9ToRGBasubroutine(unsigned char *rgba, int R, int G, int B, int a)
   \param[out] rgba : Pointer to the 32-bits RGBA bitmap that should be allocated with a size of width * height * 4.
   \param[in] width : Image width.
   \param[in] height : Image height.
-
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 */
-void vpImageConvert::YVU9ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height)
+void vpImageConvert::YVU9ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height,
+                                unsigned int nThreads)
 {
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3, Y4, Y5, Y6, Y7, Y8, Y9, Y10, Y11, Y12, Y13, Y14, Y15;
-  const unsigned int val_2 = 2;
-  const unsigned int val_3 = 3;
-  const unsigned int val_4 = 4;
-  const unsigned int val_5 = 5;
-  const unsigned int val_12 = 12;
-  const unsigned int val_15 = 15;
-  const unsigned int val_16 = 16;
-  const unsigned int val_17 = 17;
-  unsigned int size = width * height;
-  unsigned char *iV = yuv + size;
-  unsigned char *iU = yuv + ((val_17 * size) / val_16);
-  const unsigned int quarterHeight = height / val_4, quarterWidth = width / val_4;
-  const unsigned int val_128 = 128;
-  for (unsigned int i = 0; i < quarterHeight; ++i) {
-    for (unsigned int j = 0; j < quarterWidth; ++j) {
-      U = static_cast<int>(((*iU) - val_128) * 0.354);
-      ++iU;
-      U5 = static_cast<int>(val_5) * U;
-      V = static_cast<int>(((*iV) - val_128) * 0.707);
-      ++iV;
-      V2 = static_cast<int>(val_2) * V;
-      UV = -U - V;
-      Y0 = *yuv;
-      ++yuv;
-      Y1 = *yuv;
-      ++yuv;
-      Y2 = *yuv;
-      ++yuv;
-      Y3 = *yuv;
-      yuv = yuv + (width - val_3);
-      Y4 = *yuv;
-      ++yuv;
-      Y5 = *yuv;
-      ++yuv;
-      Y6 = *yuv;
-      ++yuv;
-      Y7 = *yuv;
-      yuv = yuv + (width - val_3);
-      Y8 = *yuv;
-      ++yuv;
-      Y9 = *yuv;
-      ++yuv;
-      Y10 = *yuv;
-      ++yuv;
-      Y11 = *yuv;
-      yuv = yuv + (width - val_3);
-      Y12 = *yuv;
-      ++yuv;
-      Y13 = *yuv;
-      ++yuv;
-      Y14 = *yuv;
-      ++yuv;
-      Y15 = *yuv;
-      yuv = (yuv - (val_3 * width)) + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      G = Y0 + UV;
-      B = Y0 + U5;
-      YVU9ToRGBasubroutine(rgba, R, G, B, vpRGBa::alpha_default);
-
-      //---
-      R = Y1 + V2;
-      G = Y1 + UV;
-      B = Y1 + U5;
-      YVU9ToRGBasubroutine(rgba, R, G, B, vpRGBa::alpha_default);
-
-      //---
-      R = Y2 + V2;
-      G = Y2 + UV;
-      B = Y2 + U5;
-      YVU9ToRGBasubroutine(rgba, R, G, B, vpRGBa::alpha_default);
-
-      //---
-      R = Y3 + V2;
-      G = Y3 + UV;
-      B = Y3 + U5;
-      YVU9ToRGBasubroutine(rgba, R, G, B, vpRGBa::alpha_default);
-      rgba = rgba + ((val_4 * width) - val_15);
-
-      R = Y4 + V2;
-      G = Y4 + UV;
-      B = Y4 + U5;
-      YVU9ToRGBasubroutine(rgba, R, G, B, vpRGBa::alpha_default);
-
-      //---
-      R = Y5 + V2;
-      G = Y5 + UV;
-      B = Y5 + U5;
-      YVU9ToRGBasubroutine(rgba, R, G, B, vpRGBa::alpha_default);
-
-      //---
-      R = Y6 + V2;
-      G = Y6 + UV;
-      B = Y6 + U5;
-      YVU9ToRGBasubroutine(rgba, R, G, B, vpRGBa::alpha_default);
-
-      //---
-      R = Y7 + V2;
-      G = Y7 + UV;
-      B = Y7 + U5;
-      YVU9ToRGBasubroutine(rgba, R, G, B, vpRGBa::alpha_default);
-      rgba = rgba + ((val_4 * width) - val_15);
-
-      R = Y8 + V2;
-      G = Y8 + UV;
-      B = Y8 + U5;
-      YVU9ToRGBasubroutine(rgba, R, G, B, vpRGBa::alpha_default);
-
-      //---
-      R = Y9 + V2;
-      G = Y9 + UV;
-      B = Y9 + U5;
-      YVU9ToRGBasubroutine(rgba, R, G, B, vpRGBa::alpha_default);
-
-      //---
-      R = Y10 + V2;
-      G = Y10 + UV;
-      B = Y10 + U5;
-      YVU9ToRGBasubroutine(rgba, R, G, B, vpRGBa::alpha_default);
-
-      //---
-      R = Y11 + V2;
-      G = Y11 + UV;
-      B = Y11 + U5;
-      YVU9ToRGBasubroutine(rgba, R, G, B, vpRGBa::alpha_default);
-      rgba = rgba + ((val_4 * width) - val_15);
-
-      R = Y12 + V2;
-      G = Y12 + UV;
-      B = Y12 + U5;
-      YVU9ToRGBasubroutine(rgba, R, G, B, vpRGBa::alpha_default);
-
-      //---
-      R = Y13 + V2;
-      G = Y13 + UV;
-      B = Y13 + U5;
-      YVU9ToRGBasubroutine(rgba, R, G, B, vpRGBa::alpha_default);
-
-      //---
-      R = Y14 + V2;
-      G = Y14 + UV;
-      B = Y14 + U5;
-      YVU9ToRGBasubroutine(rgba, R, G, B, vpRGBa::alpha_default);
-
-      //---
-      R = Y15 + V2;
-      G = Y15 + UV;
-      B = Y15 + U5;
-      YVU9ToRGBasubroutine(rgba, R, G, B, vpRGBa::alpha_default);
-      rgba = (rgba - (val_12 * width)) + 1;
-    }
-    yuv += val_3 * width;
-    rgba += val_12 * width;
-  }
+  const unsigned int size = width * height;
+  yuvPlanarConvert(yuv, yuv + ((17 * size) / 16), yuv + size, width, height, 2, nullptr, rgba, 4, nThreads);
 }
 
-namespace
-{
-/**
-*
-* \brief Subroutine for YVU9 to RGB conversion.
-*
-* \param rgb Pointer to the 24-bits RGB bitmap that should be allocated with a size of width * height * 3.
-* \param R Value for the red channel.
-* \param G Value for the green channel.
-* \param B Value for the blue channel.
+/*!
+  Convert YVU 9 [Y(NxM), V(N/4xM/4), U(N/4xM/4)] image into RGB image.
+
+  \param[in] yuv : Pointer to the bitmap containing the YVU 9 data.
+  \param[out] rgb : Pointer to the 24-bits RGB bitmap that should be allocated with a size of width * height * 3.
+  \param[in] width : Image width.
+  \param[in] height : Image height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 */
-void YVU9ToRGBsubroutine(unsigned char *rgb, int R, int G, int B)
+void vpImageConvert::YVU9ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height,
+                               unsigned int nThreads)
 {
-  vpSAT(R);
-  vpSAT(G);
-  vpSAT(B);
-  *rgb++ = static_cast<unsigned char>(R);
-  *rgb++ = static_cast<unsigned char>(G);
-  *rgb++ = static_cast<unsigned char>(B);
-}
+  const unsigned int size = width * height;
+  yuvPlanarConvert(yuv, yuv + ((17 * size) / 16), yuv + size, width, height, 2, nullptr, rgb, 3, nThreads);
 }
 
 /*!
-  Convert YV 1:2 [Y(NxM),  V(N/4xM/4), U(N/4xM/4)] image into RGB image.
+  Convert YVU 9 [Y(NxM), V(N/4xM/4), U(N/4xM/4)] image into both a grey and a RGBa image in a single pass. The grey
+  image is the Y plane.
 
-  \param[in] yuv : Pointer to the bitmap containing the YV 1:2 data.
-  \param[out] rgb : Pointer to the 24-bits RGB bitmap that should be allocated with a size of width * height * 3.
+  \param[in] yuv : Pointer to the bitmap containing the YVU 9 data.
+  \param[out] grey : Pointer to the 8-bits grey bitmap that should be allocated with a size of width * height.
+  \param[out] rgba : Pointer to the 32-bits RGBA bitmap that should be allocated with a size of width * height * 4.
   \param[in] width : Image width.
   \param[in] height : Image height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 */
-void vpImageConvert::YVU9ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int height, unsigned int width)
+void vpImageConvert::YVU9ToGreyAndRGBa(unsigned char *yuv, unsigned char *grey, unsigned char *rgba, unsigned int width,
+                                       unsigned int height, unsigned int nThreads)
 {
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3, Y4, Y5, Y6, Y7, Y8, Y9, Y10, Y11, Y12, Y13, Y14, Y15;
-  const unsigned int val_2 = 2;
-  const unsigned int val_3 = 3;
-  const unsigned int val_4 = 4;
-  const unsigned int val_5 = 5;
-  const unsigned int val_9 = 9;
-  const unsigned int val_11 = 11;
-  const unsigned int val_16 = 16;
-  const unsigned int val_17 = 17;
-  unsigned int size = width * height;
-  unsigned char *iV = yuv + size;
-  unsigned char *iU = yuv + ((val_17 * size) / val_16);
-  const unsigned int quarterHeight = height / val_4, quarterWidth = width / val_4;
-  const unsigned int val_128 = 128;
-  for (unsigned int i = 0; i < quarterHeight; ++i) {
-    for (unsigned int j = 0; j < quarterWidth; ++j) {
-      U = static_cast<int>((*iU - val_128) * 0.354);
-      ++iU;
-      U5 = static_cast<int>(val_5) * U;
-      V = static_cast<int>((*iV - val_128) * 0.707);
-      ++iV;
-      V2 = static_cast<int>(val_2) * V;
-      UV = -U - V;
-      Y0 = *yuv;
-      ++yuv;
-      Y1 = *yuv;
-      ++yuv;
-      Y2 = *yuv;
-      ++yuv;
-      Y3 = *yuv;
-      yuv = yuv + (width - val_3);
-      Y4 = *yuv;
-      ++yuv;
-      Y5 = *yuv;
-      ++yuv;
-      Y6 = *yuv;
-      ++yuv;
-      Y7 = *yuv;
-      yuv = yuv + (width - val_3);
-      Y8 = *yuv;
-      ++yuv;
-      Y9 = *yuv;
-      ++yuv;
-      Y10 = *yuv;
-      ++yuv;
-      Y11 = *yuv;
-      yuv = yuv + (width - val_3);
-      Y12 = *yuv;
-      ++yuv;
-      Y13 = *yuv;
-      ++yuv;
-      Y14 = *yuv;
-      ++yuv;
-      Y15 = *yuv;
-      yuv = (yuv - (val_3 * width)) + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      G = Y0 + UV;
-      B = Y0 + U5;
-      YVU9ToRGBsubroutine(rgb, R, G, B);
-
-      //---
-      R = Y1 + V2;
-      G = Y1 + UV;
-      B = Y1 + U5;
-      YVU9ToRGBsubroutine(rgb, R, G, B);
-
-      //---
-      R = Y2 + V2;
-      G = Y2 + UV;
-      B = Y2 + U5;
-      YVU9ToRGBsubroutine(rgb, R, G, B);
-
-      //---
-      R = Y3 + V2;
-      G = Y3 + UV;
-      B = Y3 + U5;
-      YVU9ToRGBsubroutine(rgb, R, G, B);
-      rgb = rgb + ((val_3 * width) - val_11);
-
-      R = Y4 + V2;
-      G = Y4 + UV;
-      B = Y4 + U5;
-      YVU9ToRGBsubroutine(rgb, R, G, B);
-
-      //---
-      R = Y5 + V2;
-      G = Y5 + UV;
-      B = Y5 + U5;
-      YVU9ToRGBsubroutine(rgb, R, G, B);
-
-      //---
-      R = Y6 + V2;
-      G = Y6 + UV;
-      B = Y6 + U5;
-      YVU9ToRGBsubroutine(rgb, R, G, B);
-
-      //---
-      R = Y7 + V2;
-      G = Y7 + UV;
-      B = Y7 + U5;
-      YVU9ToRGBsubroutine(rgb, R, G, B);
-      rgb = rgb + ((val_3 * width) - val_11);
-
-      R = Y8 + V2;
-      G = Y8 + UV;
-      B = Y8 + U5;
-      YVU9ToRGBsubroutine(rgb, R, G, B);
-
-      //---
-      R = Y9 + V2;
-      G = Y9 + UV;
-      B = Y9 + U5;
-      YVU9ToRGBsubroutine(rgb, R, G, B);
-
-      //---
-      R = Y10 + V2;
-      G = Y10 + UV;
-      B = Y10 + U5;
-      YVU9ToRGBsubroutine(rgb, R, G, B);
-
-      //---
-      R = Y11 + V2;
-      G = Y11 + UV;
-      B = Y11 + U5;
-      YVU9ToRGBsubroutine(rgb, R, G, B);
-      rgb = (rgb + (val_3 * width)) - val_11;
-
-      R = Y12 + V2;
-      G = Y12 + UV;
-      B = Y12 + U5;
-      YVU9ToRGBsubroutine(rgb, R, G, B);
-
-      //---
-      R = Y13 + V2;
-      G = Y13 + UV;
-      B = Y13 + U5;
-      YVU9ToRGBsubroutine(rgb, R, G, B);
-
-      //---
-      R = Y14 + V2;
-      G = Y14 + UV;
-      B = Y14 + U5;
-      YVU9ToRGBsubroutine(rgb, R, G, B);
-
-      //---
-      R = Y15 + V2;
-      G = Y15 + UV;
-      B = Y15 + U5;
-      YVU9ToRGBsubroutine(rgb, R, G, B);
-      rgb = (rgb - (val_9 * width)) + 1;
-    }
-    yuv += val_3 * width;
-    rgb += val_9 * width;
-  }
+  const unsigned int size = width * height;
+  yuvPlanarConvert(yuv, yuv + ((17 * size) / 16), yuv + size, width, height, 2, grey, rgba, 4, nThreads);
 }
 END_VISP_NAMESPACE
@@ -0,0 +1,182 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Row-based separable filtering engine.
+ */
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpImageFilter.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#if defined _WIN32 && defined(_M_ARM64)
+#define _ARM64_DISTINCT_NEON_TYPES
+#include <Intrin.h>
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#elif (defined(__ARM_NEON__) || defined (__ARM_NEON)) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#else
+#define VISP_HAVE_NEON 0
+#endif
+
+BEGIN_VISP_NAMESPACE
+
+const unsigned int vpImageFilter::m_separableParallelMinSize = 256 * 256;
+const unsigned int vpImageFilter::m_separableTileRows = 64;
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+// The sums are first computed in the pixel type and the products are not fused with the additions, so that the
+// vectorised taps give the same results as the scalar ones.
+void vpImageFilter::separableAccumulate(const unsigned char *a, const unsigned char *b, const float &coef, float *acc,
+                                        unsigned int n, bool isDerivative)
+{
+  unsigned int j = 0;
+#if VISP_HAVE_SSE2
+  static const bool checkSSE2 = vpCPUFeatures::checkSSE2();
+  if (checkSSE2) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 vcoef = _mm_set1_ps(coef);
+    for (; (j + 8) <= n; j += 8) {
+      const __m128i va = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(a + j)), zero);
+      const __m128i vb = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(b + j)), zero);
+      const __m128i v = isDerivative ? _mm_sub_epi16(va, vb) : _mm_add_epi16(va, vb);
+      // Sign extension of the 16-bit values to 32-bit
+      const __m128 vlo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+      const __m128 vhi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+      _mm_storeu_ps(acc + j, _mm_add_ps(_mm_loadu_ps(acc + j), _mm_mul_ps(vcoef, vlo)));
+      _mm_storeu_ps(acc + j + 4, _mm_add_ps(_mm_loadu_ps(acc + j + 4), _mm_mul_ps(vcoef, vhi)));
+    }
+  }
+#elif VISP_HAVE_NEON
+  const float32x4_t vcoef = vdupq_n_f32(coef);
+  for (; (j + 8) <= n; j += 8) {
+    const int16x8_t va = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(a + j)));
+    const int16x8_t vb = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(b + j)));
+    const int16x8_t v = isDerivative ? vsubq_s16(va, vb) : vaddq_s16(va, vb);
+    const float32x4_t vlo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+    const float32x4_t vhi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+    vst1q_f32(acc + j, vaddq_f32(vld1q_f32(acc + j), vmulq_f32(vcoef, vlo)));
+    vst1q_f32(acc + j + 4, vaddq_f32(vld1q_f32(acc + j + 4), vmulq_f32(vcoef, vhi)));
+  }
+#endif
+  if (isDerivative) {
+    for (; j < n; ++j) {
+      acc[j] += coef * static_cast<float>(a[j] - b[j]);
+    }
+  }
+  else {
+    for (; j < n; ++j) {
+      acc[j] += coef * static_cast<float>(a[j] + b[j]);
+    }
+  }
+}
+
+void vpImageFilter::separableAccumulate(const float *a, const float *b, const float &coef, float *acc, unsigned int n,
+                                        bool isDerivative)
+{
+  unsigned int j = 0;
+#if VISP_HAVE_SSE2
+  static const bool checkSSE2 = vpCPUFeatures::checkSSE2();
+  if (checkSSE2) {
+    const __m128 vcoef = _mm_set1_ps(coef);
+    for (; (j + 4) <= n; j += 4) {
+      const __m128 va = _mm_loadu_ps(a + j);
+      const __m128 vb = _mm_loadu_ps(b + j);
+      const __m128 v = isDerivative ? _mm_sub_ps(va, vb) : _mm_add_ps(va, vb);
+      _mm_storeu_ps(acc + j, _mm_add_ps(_mm_loadu_ps(acc + j), _mm_mul_ps(vcoef, v)));
+    }
+  }
+#elif VISP_HAVE_NEON
+  const float32x4_t vcoef = vdupq_n_f32(coef);
+  for (; (j + 4) <= n; j += 4) {
+    const float32x4_t va = vld1q_f32(a + j);
+    const float32x4_t vb = vld1q_f32(b + j);
+    const float32x4_t v = isDerivative ? vsubq_f32(va, vb) : vaddq_f32(va, vb);
+    vst1q_f32(acc + j, vaddq_f32(vld1q_f32(acc + j), vmulq_f32(vcoef, v)));
+  }
+#endif
+  if (isDerivative) {
+    for (; j < n; ++j) {
+      acc[j] += coef * (a[j] - b[j]);
+    }
+  }
+  else {
+    for (; j < n; ++j) {
+      acc[j] += coef * (a[j] + b[j]);
+    }
+  }
+}
+
+void vpImageFilter::separableAccumulate(const double *a, const double *b, const double &coef, double *acc,
+                                        unsigned int n, bool isDerivative)
+{
+  unsigned int j = 0;
+#if VISP_HAVE_SSE2
+  static const bool checkSSE2 = vpCPUFeatures::checkSSE2();
+  if (checkSSE2) {
+    const __m128d vcoef = _mm_set1_pd(coef);
+    for (; (j + 2) <= n; j += 2) {
+      const __m128d va = _mm_loadu_pd(a + j);
+      const __m128d vb = _mm_loadu_pd(b + j);
+      const __m128d v = isDerivative ? _mm_sub_pd(va, vb) : _mm_add_pd(va, vb);
+      _mm_storeu_pd(acc + j, _mm_add_pd(_mm_loadu_pd(acc + j), _mm_mul_pd(vcoef, v)));
+    }
+  }
+#elif VISP_HAVE_NEON
+  const float64x2_t vcoef = vdupq_n_f64(coef);
+  for (; (j + 2) <= n; j += 2) {
+    const float64x2_t va = vld1q_f64(a + j);
+    const float64x2_t vb = vld1q_f64(b + j);
+    const float64x2_t v = isDerivative ? vsubq_f64(va, vb) : vaddq_f64(va, vb);
+    vst1q_f64(acc + j, vaddq_f64(vld1q_f64(acc + j), vmulq_f64(vcoef, v)));
+  }
+#endif
+  if (isDerivative) {
+    for (; j < n; ++j) {
+      acc[j] += coef * (a[j] - b[j]);
+    }
+  }
+  else {
+    for (; j < n; ++j) {
+      acc[j] += coef * (a[j] + b[j]);
+    }
+  }
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+#endif
+
+END_VISP_NAMESPACE
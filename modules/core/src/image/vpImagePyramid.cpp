@@ -0,0 +1,303 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Gaussian image pyramid shared by the consumers of a same image.
+ */
+
+/*!
+ * \file vpImagePyramid.cpp
+ * \brief Gaussian image pyramid shared by the consumers of a same image.
+ */
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImagePyramid.h>
+
+BEGIN_VISP_NAMESPACE
+
+namespace
+{
+/*!
+ * Compute the gradient of an image, or a null gradient when the image is too small for the derivative filter.
+ */
+void computeGradient(const vpImage<unsigned char> &I, vpImage<float> &grad, bool alongX)
+{
+  // Half size of the derivative filter used by vpImageFilter::getGradX() and vpImageFilter::getGradY()
+  const unsigned int filterHalfSize = 3;
+  const unsigned int size = alongX ? I.getWidth() : I.getHeight();
+  if (size <= (2 * filterHalfSize)) {
+    grad.resize(I.getHeight(), I.getWidth(), 0.f);
+  }
+  else if (alongX) {
+    vpImageFilter::getGradX(I, grad);
+  }
+  else {
+    vpImageFilter::getGradY(I, grad);
+  }
+}
+}
+
+/*!
+ * Default constructor. The pyramid is empty until init() is called.
+ */
+vpImagePyramid::vpImagePyramid()
+  : m_I(std::make_shared<vpImage<unsigned char> >()), m_levels(), m_decimatedLevels(), m_gradX(), m_gradY()
+{ }
+
+/*!
+ * Create the pyramid of an image. No level is computed until it is requested.
+ * \param I : Original image, copied as the level 0 of the pyramid.
+ */
+vpImagePyramid::vpImagePyramid(const vpImage<unsigned char> &I)
+  : m_I(std::make_shared<vpImage<unsigned char> >(I)), m_levels(), m_decimatedLevels(), m_gradX(), m_gradY()
+{ }
+
+/*!
+ * Copy constructor. The original image and the levels already computed are shared with the copy, without copying
+ * the images.
+ */
+vpImagePyramid::vpImagePyramid(const vpImagePyramid &pyramid)
+  : m_I(), m_levels(), m_decimatedLevels(), m_gradX(), m_gradY()
+{
+  *this = pyramid;
+}
+
+/*!
+ * Copy operator. The original image and the levels already computed are shared with the copy, without copying the
+ * images.
+ */
+vpImagePyramid &vpImagePyramid::operator=(const vpImagePyramid &pyramid)
+{
+  if (this != &pyramid) {
+#if defined(VISP_HAVE_THREADS)
+    std::lock_guard<std::mutex> lock(pyramid.m_mutex);
+#endif
+    m_I = pyramid.m_I;
+    m_levels = pyramid.m_levels;
+    m_decimatedLevels = pyramid.m_decimatedLevels;
+    m_gradX = pyramid.m_gradX;
+    m_gradY = pyramid.m_gradY;
+  }
+  return *this;
+}
+
+/*!
+ * Throw an exception if a level is empty.
+ */
+void vpImagePyramid::checkLevel(unsigned int level) const
+{
+  if ((level >= (8 * sizeof(unsigned int))) || (getWidth(level) == 0) || (getHeight(level) == 0)) {
+    throw(vpException(vpException::dimensionError, "Cannot get level %d of a pyramid built on a %dx%d image", level,
+                      m_I->getWidth(), m_I->getHeight()));
+  }
+}
+
+/*!
+ * Remove the original image and all the computed levels.
+ */
+void vpImagePyramid::clear()
+{
+  m_I = std::make_shared<vpImage<unsigned char> >();
+  m_levels.clear();
+  m_decimatedLevels.clear();
+  m_gradX.clear();
+  m_gradY.clear();
+}
+
+/*!
+ * Compute a Gaussian level and all the missing levels below it. The mutex has to be locked by the caller.
+ */
+const vpImage<unsigned char> &vpImagePyramid::computeLevel(unsigned int level) const
+{
+  if (level == 0) {
+    return *m_I;
+  }
+  std::map<unsigned int, vpImagePtr>::const_iterator it = m_levels.find(level);
+  if (it != m_levels.end()) {
+    return *(it->second);
+  }
+  const vpImage<unsigned char> &prev = computeLevel(level - 1);
+  vpImagePtr I = std::make_shared<vpImage<unsigned char> >();
+  vpImageFilter::getGaussPyramidal(prev, *I);
+  m_levels[level] = I;
+  return *I;
+}
+
+/*!
+ * Compute a decimated level and all the missing levels below it. The mutex has to be locked by the caller.
+ */
+const vpImage<unsigned char> &vpImagePyramid::computeDecimatedLevel(unsigned int level) const
+{
+  if (level == 0) {
+    return *m_I;
+  }
+  std::map<unsigned int, vpImagePtr>::const_iterator it = m_decimatedLevels.find(level);
+  if (it != m_decimatedLevels.end()) {
+    return *(it->second);
+  }
+  const vpImage<unsigned char> &prev = computeDecimatedLevel(level - 1);
+  const unsigned int height = prev.getHeight() / 2, width = prev.getWidth() / 2;
+  vpImagePtr I = std::make_shared<vpImage<unsigned char> >(height, width);
+  for (unsigned int i = 0; i < height; ++i) {
+    const unsigned char *src = prev[2 * i];
+    unsigned char *dst = (*I)[i];
+    for (unsigned int j = 0; j < width; ++j) {
+      dst[j] = src[2 * j];
+    }
+  }
+  m_decimatedLevels[level] = I;
+  return *I;
+}
+
+/*!
+ * Get a level of the pyramid obtained by subsampling the original image, without filtering.
+ * The pixel (i, j) of the level \e l is the pixel \f$(2^l i, 2^l j)\f$ of the original image.
+ *
+ * \param level : Pyramid level. The level 0 is the original image.
+ * \return The decimated image. The reference remains valid until the pyramid is cleared, initialized again or
+ * destroyed.
+ * \exception vpException::dimensionError : When the level is empty.
+ */
+const vpImage<unsigned char> &vpImagePyramid::getDecimatedLevel(unsigned int level) const
+{
+  checkLevel(level);
+#if defined(VISP_HAVE_THREADS)
+  std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+  return computeDecimatedLevel(level);
+}
+
+/*!
+ * Get the gradient along the columns of a Gaussian level, computed with vpImageFilter::getGradX().
+ *
+ * \param level : Pyramid level.
+ * \return The gradient image. The reference remains valid until the pyramid is cleared, initialized again or
+ * destroyed.
+ * \exception vpException::dimensionError : When the level is empty.
+ */
+const vpImage<float> &vpImagePyramid::getGradX(unsigned int level) const
+{
+  checkLevel(level);
+#if defined(VISP_HAVE_THREADS)
+  std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+  std::map<unsigned int, vpGradientPtr>::const_iterator it = m_gradX.find(level);
+  if (it != m_gradX.end()) {
+    return *(it->second);
+  }
+  vpGradientPtr grad = std::make_shared<vpImage<float> >();
+  computeGradient(computeLevel(level), *grad, true);
+  m_gradX[level] = grad;
+  return *grad;
+}
+
+/*!
+ * Get the gradient along the rows of a Gaussian level, computed with vpImageFilter::getGradY().
+ *
+ * \param level : Pyramid level.
+ * \return The gradient image. The reference remains valid until the pyramid is cleared, initialized again or
+ * destroyed.
+ * \exception vpException::dimensionError : When the level is empty.
+ */
+const vpImage<float> &vpImagePyramid::getGradY(unsigned int level) const
+{
+  checkLevel(level);
+#if defined(VISP_HAVE_THREADS)
+  std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+  std::map<unsigned int, vpGradientPtr>::const_iterator it = m_gradY.find(level);
+  if (it != m_gradY.end()) {
+    return *(it->second);
+  }
+  vpGradientPtr grad = std::make_shared<vpImage<float> >();
+  computeGradient(computeLevel(level), *grad, false);
+  m_gradY[level] = grad;
+  return *grad;
+}
+
+/*!
+ * Get a Gaussian level of the pyramid, computed from the level below with vpImageFilter::getGaussPyramidal().
+ *
+ * \param level : Pyramid level. The level 0 is the original image.
+ * \return The level image. The reference remains valid until the pyramid is cleared, initialized again or
+ * destroyed.
+ * \exception vpException::dimensionError : When the level is empty.
+ */
+const vpImage<unsigned char> &vpImagePyramid::getLevel(unsigned int level) const
+{
+  checkLevel(level);
+#if defined(VISP_HAVE_THREADS)
+  std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+  return computeLevel(level);
+}
+
+/*!
+ * Initialize the pyramid with a new image. The levels computed for the previous image are removed. The copies of the
+ * pyramid keep the previous image and its levels.
+ * \param I : Original image, copied as the level 0 of the pyramid.
+ */
+void vpImagePyramid::init(const vpImage<unsigned char> &I)
+{
+  if (m_I.use_count() == 1) {
+    // The previous image is not shared, its memory is reused
+    *m_I = I;
+  }
+  else {
+    m_I = std::make_shared<vpImage<unsigned char> >(I);
+  }
+  m_levels.clear();
+  m_decimatedLevels.clear();
+  m_gradX.clear();
+  m_gradY.clear();
+}
+
+/*!
+ * Exchange the content of two pyramids without copying the images.
+ * \param pyramid : Pyramid to exchange with.
+ */
+void vpImagePyramid::swap(vpImagePyramid &pyramid)
+{
+  if (this != &pyramid) {
+#if defined(VISP_HAVE_THREADS)
+    std::lock(m_mutex, pyramid.m_mutex);
+    std::lock_guard<std::mutex> lock1(m_mutex, std::adopt_lock);
+    std::lock_guard<std::mutex> lock2(pyramid.m_mutex, std::adopt_lock);
+#endif
+    using std::swap;
+    swap(m_I, pyramid.m_I);
+    m_levels.swap(pyramid.m_levels);
+    m_decimatedLevels.swap(pyramid.m_decimatedLevels);
+    m_gradX.swap(pyramid.m_gradX);
+    m_gradY.swap(pyramid.m_gradY);
+  }
+}
+
+END_VISP_NAMESPACE
@@ -0,0 +1,211 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2026 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Precomputed fixed-point remapping table.
+ */
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImageRemapMap.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpMath.h>
+
+#include <algorithm>
+#include <limits>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+BEGIN_VISP_NAMESPACE
+
+const unsigned int vpImageRemapMap::weightBits;
+const unsigned int vpImageRemapMap::weightOne;
+
+/*!
+ * Default constructor, the table is empty.
+ */
+vpImageRemapMap::vpImageRemapMap()
+  : m_srcWidth(0), m_srcHeight(0), m_width(0), m_height(0), m_offsets(), m_weights()
+{ }
+
+/*!
+ * Build the table from the maps computed by vpImageTools::initUndistortMap(). As with
+ * vpImageTools::remap(const vpImage<unsigned char> &, const vpArray2D<int> &, const vpArray2D<int> &, const vpArray2D<float> &, const vpArray2D<float> &, vpImage<unsigned char> &),
+ * destination pixels whose interpolation neighbourhood is not fully inside the source image are set to 0.
+ *
+ * \param srcWidth : Width of the images that will be remapped.
+ * \param srcHeight : Height of the images that will be remapped.
+ * \param mapU : Map that contains at each destination coordinate the u-coordinate in the source image.
+ * \param mapV : Map that contains at each destination coordinate the v-coordinate in the source image.
+ * \param mapDu : Map that contains at each destination coordinate the \f$ \Delta u \f$ for the interpolation.
+ * \param mapDv : Map that contains at each destination coordinate the \f$ \Delta v \f$ for the interpolation.
+ */
+void vpImageRemapMap::init(unsigned int srcWidth, unsigned int srcHeight, const vpArray2D<int> &mapU,
+                           const vpArray2D<int> &mapV, const vpArray2D<float> &mapDu, const vpArray2D<float> &mapDv)
+{
+  const unsigned int height = mapU.getRows(), width = mapU.getCols();
+  if ((mapV.getRows() != height) || (mapV.getCols() != width) || (mapDu.getRows() != height) ||
+      (mapDu.getCols() != width) || (mapDv.getRows() != height) || (mapDv.getCols() != width)) {
+    throw(vpException(vpException::dimensionError, "Remapping maps must have the same size"));
+  }
+
+  resize(srcWidth, srcHeight, width, height);
+  const int src_width_1 = static_cast<int>(srcWidth) - 1, src_height_1 = static_cast<int>(srcHeight) - 1;
+  const int size = static_cast<int>(height * width);
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+  for (int k = 0; k < size; ++k) {
+    const int u = mapU.data[k], v = mapV.data[k];
+    if ((0 <= u) && (0 <= v) && (u < src_width_1) && (v < src_height_1)) {
+      set(static_cast<unsigned int>(k), u + static_cast<double>(mapDu.data[k]), v + static_cast<double>(mapDv.data[k]));
+    }
+  }
+}
+
+/*!
+ * Build the undistortion table of a camera.
+ *
+ * \param cam : Camera intrinsic parameters with distortion coefficients.
+ * \param width : Image width.
+ * \param height : Image height.
+ *
+ * \sa vpImageTools::initUndistortMap()
+ */
+void vpImageRemapMap::initUndistort(const vpCameraParameters &cam, unsigned int width, unsigned int height)
+{
+  vpArray2D<int> mapU, mapV;
+  vpArray2D<float> mapDu, mapDv;
+  vpImageTools::initUndistortMap(cam, width, height, mapU, mapV, mapDu, mapDv);
+  init(width, height, mapU, mapV, mapDu, mapDv);
+}
+
+/*!
+ * Build the table corresponding to vpImageTools::warpImage() with bilinear interpolation.
+ *
+ * \param T : Transformation / warping matrix, a `2x3` matrix for an affine transformation
+ * or a `3x3` matrix for a perspective transformation (homography).
+ * \param srcWidth : Width of the images that will be warped.
+ * \param srcHeight : Height of the images that will be warped.
+ * \param dstWidth : Width of the warped images.
+ * \param dstHeight : Height of the warped images.
+ * \param pixelCenter : If true, pixel coordinates are at (0.5, 0.5), otherwise at (0,0).
+ */
+void vpImageRemapMap::initWarp(const vpMatrix &T, unsigned int srcWidth, unsigned int srcHeight,
+                               unsigned int dstWidth, unsigned int dstHeight, bool pixelCenter)
+{
+  const unsigned int expectedNbCols = 3, expectedNbRows1stOpt = 2, expectedNbRows2ndOpt = 3;
+  if (((T.getRows() != expectedNbRows1stOpt) && (T.getRows() != expectedNbRows2ndOpt)) ||
+      (T.getCols() != expectedNbCols)) {
+    throw(vpException(vpException::dimensionError, "Input transformation must be a (2x3) or (3x3) matrix"));
+  }
+
+  vpMatrix H(3, 3);
+  H.eye();
+  H.insert(T, 0, 0);
+  const vpMatrix M = H.inverseByLU();
+
+  resize(srcWidth, srcHeight, dstWidth, dstHeight);
+  const int src_width = static_cast<int>(srcWidth), src_height = static_cast<int>(srcHeight);
+  const int dst_height = static_cast<int>(dstHeight);
+  const double offset = pixelCenter ? 0.5 : 0.0;
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+  for (int i = 0; i < dst_height; ++i) {
+    const double v = i + offset;
+    for (unsigned int j = 0; j < dstWidth; ++j) {
+      const double u = j + offset;
+      double w = (M[2][0] * u) + (M[2][1] * v) + M[2][2];
+      if (vpMath::nul(w, std::numeric_limits<double>::epsilon())) {
+        w = 1.0;
+      }
+      const double x = ((((M[0][0] * u) + (M[0][1] * v)) + M[0][2]) / w) - offset;
+      const double y = ((((M[1][0] * u) + (M[1][1] * v)) + M[1][2]) / w) - offset;
+
+      if ((x >= 0) && (y >= 0) && (x < src_width) && (y < src_height)) {
+        set((static_cast<unsigned int>(i) * dstWidth) + j, std::min<double>(x, src_width - 1),
+            std::min<double>(y, src_height - 1));
+      }
+    }
+  }
+}
+
+/*!
+ * \internal
+ * Allocate the table, all the destination pixels being initially without source correspondence.
+ */
+void vpImageRemapMap::resize(unsigned int srcWidth, unsigned int srcHeight, unsigned int dstWidth,
+                             unsigned int dstHeight)
+{
+  if ((srcWidth < 2) || (srcHeight < 2)) {
+    throw(vpException(vpException::dimensionError, "Source image must be at least 2x2 to be remapped"));
+  }
+  if ((static_cast<double>(srcWidth) * srcHeight) > std::numeric_limits<int>::max()) {
+    throw(vpException(vpException::dimensionError, "Source image is too large to be remapped"));
+  }
+
+  m_srcWidth = srcWidth;
+  m_srcHeight = srcHeight;
+  m_width = dstWidth;
+  m_height = dstHeight;
+  m_offsets.assign(static_cast<size_t>(dstWidth) * dstHeight, -1);
+  m_weights.assign(static_cast<size_t>(dstWidth) * dstHeight * 2, 0);
+}
+
+/*!
+ * \internal
+ * Store the source position \f$ (x, y) \f$, with \f$ 0 \leq x \leq width-1 \f$ and \f$ 0 \leq y \leq height-1 \f$,
+ * of a destination pixel. The position is rounded to the weight precision; on the last column or row the
+ * neighbourhood is shifted by one pixel with a unit weight, so that the remapping never reads outside the source
+ * image.
+ */
+void vpImageRemapMap::set(unsigned int index, double x, double y)
+{
+  const int xq = vpMath::round(x * weightOne), yq = vpMath::round(y * weightOne);
+  int x0 = xq >> weightBits, y0 = yq >> weightBits;
+  int du = xq & static_cast<int>(weightOne - 1), dv = yq & static_cast<int>(weightOne - 1);
+  if (x0 >= (static_cast<int>(m_srcWidth) - 1)) {
+    x0 = static_cast<int>(m_srcWidth) - 2;
+    du = static_cast<int>(weightOne);
+  }
+  if (y0 >= (static_cast<int>(m_srcHeight) - 1)) {
+    y0 = static_cast<int>(m_srcHeight) - 2;
+    dv = static_cast<int>(weightOne);
+  }
+
+  m_offsets[index] = (y0 * static_cast<int>(m_srcWidth)) + x0;
+  m_weights[2 * index] = static_cast<unsigned char>(du);
+  m_weights[(2 * index) + 1] = static_cast<unsigned char>(dv);
+}
+
+END_VISP_NAMESPACE
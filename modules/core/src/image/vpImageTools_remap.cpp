@@ -0,0 +1,272 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2026 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bilinear remapping with a precomputed fixed-point table.
+ */
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpImageRemapMap.h>
+#include <visp3/core/vpImageTools.h>
+
+#include <string.h>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#if defined _WIN32 && defined(_M_ARM64)
+#define _ARM64_DISTINCT_NEON_TYPES
+#include <Intrin.h>
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#elif (defined(__ARM_NEON__) || defined (__ARM_NEON)) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#else
+#define VISP_HAVE_NEON 0
+#endif
+
+BEGIN_VISP_NAMESPACE
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+const int remapWeightOne = static_cast<int>(vpImageRemapMap::weightOne);
+const int remapShift = 2 * static_cast<int>(vpImageRemapMap::weightBits);
+const int remapRound = 1 << (remapShift - 1);
+
+// The horizontal interpolation is kept with its full weightOne scale, which holds on 16 bits for 7-bit weights, and
+// the result is rounded only once after the vertical interpolation. The vectorised and the scalar paths give thus the
+// same values.
+inline unsigned char remapPixel(const unsigned char *src, unsigned int srcWidth, int offset, int du, int dv)
+{
+  const unsigned char *p = src + offset;
+  const int top = (p[0] * (remapWeightOne - du)) + (p[1] * du);
+  const int bottom = (p[srcWidth] * (remapWeightOne - du)) + (p[srcWidth + 1] * du);
+  return static_cast<unsigned char>(((top * (remapWeightOne - dv)) + (bottom * dv) + remapRound) >> remapShift);
+}
+
+void remapRow(const unsigned char *src, unsigned int srcWidth, const int *offsets, const unsigned char *weights,
+              unsigned char *dst, unsigned int n)
+{
+  unsigned int j = 0;
+#if VISP_HAVE_SSE2
+  static const bool checkSSE2 = vpCPUFeatures::checkSSE2();
+  if (checkSSE2) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i sign = _mm_set_epi16(0, -1, 0, -1, 0, -1, 0, -1);
+    const __m128i one = _mm_set_epi16(0, remapWeightOne, 0, remapWeightOne, 0, remapWeightOne, 0, remapWeightOne);
+    const __m128i round = _mm_set1_epi32(remapRound);
+    for (; (j + 8) <= n; j += 8) {
+      __m128i res[2];
+      for (unsigned int k = 0; k < 2; ++k) {
+        const int *o = offsets + j + (4 * k);
+        unsigned short pairs[8];
+        for (unsigned int l = 0; l < 4; ++l) {
+          const unsigned char *p = src + (o[l] < 0 ? 0 : o[l]);
+          memcpy(&pairs[l], p, sizeof(unsigned short));
+          memcpy(&pairs[l + 4], p + srcWidth, sizeof(unsigned short));
+        }
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pairs));
+        const __m128i top = _mm_unpacklo_epi8(v, zero);
+        const __m128i bottom = _mm_unpackhi_epi8(v, zero);
+
+        // (du, dv) pairs of the 4 pixels, then (weightOne - du, du) and (weightOne - dv, dv) pairs
+        const __m128i w =
+          _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(weights + (2 * (j + (4 * k))))), zero);
+        const __m128i du = _mm_shufflehi_epi16(_mm_shufflelo_epi16(w, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128i dv = _mm_shufflehi_epi16(_mm_shufflelo_epi16(w, _MM_SHUFFLE(3, 3, 1, 1)), _MM_SHUFFLE(3, 3, 1, 1));
+        const __m128i wx = _mm_add_epi16(one, _mm_sub_epi16(_mm_xor_si128(du, sign), sign));
+        const __m128i wy = _mm_add_epi16(one, _mm_sub_epi16(_mm_xor_si128(dv, sign), sign));
+
+        const __m128i tb = _mm_packs_epi32(_mm_madd_epi16(top, wx), _mm_madd_epi16(bottom, wx));
+        const __m128i col = _mm_unpacklo_epi16(tb, _mm_srli_si128(tb, 8));
+        res[k] = _mm_srli_epi32(_mm_add_epi32(_mm_madd_epi16(col, wy), round), remapShift);
+      }
+      const __m128i invalid =
+        _mm_packs_epi32(_mm_cmplt_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(offsets + j)), zero),
+                        _mm_cmplt_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(offsets + j + 4)), zero));
+      const __m128i pix = _mm_andnot_si128(invalid, _mm_packs_epi32(res[0], res[1]));
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + j), _mm_packus_epi16(pix, pix));
+    }
+  }
+#endif
+  for (; j < n; ++j) {
+    dst[j] = offsets[j] < 0 ? 0 : remapPixel(src, srcWidth, offsets[j], weights[2 * j], weights[(2 * j) + 1]);
+  }
+}
+
+void remapRow(const vpRGBa *src, unsigned int srcWidth, const int *offsets, const unsigned char *weights, vpRGBa *dst,
+              unsigned int n)
+{
+  unsigned int j = 0;
+#if VISP_HAVE_SSE2
+  static const bool checkSSE2 = vpCPUFeatures::checkSSE2();
+  if (checkSSE2) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi32(remapRound);
+    for (; j < n; ++j) {
+      if (offsets[j] < 0) {
+        dst[j] = vpRGBa(0);
+        continue;
+      }
+      // Both pixels of a row of the neighbourhood are loaded at once, one 16-bit lane per channel
+      const vpRGBa *p = src + offsets[j];
+      const __m128i top = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)), zero);
+      const __m128i bottom = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p + srcWidth)), zero);
+      const short du = static_cast<short>(weights[2 * j]), dv = static_cast<short>(weights[(2 * j) + 1]);
+      const short du_1 = static_cast<short>(remapWeightOne - du), dv_1 = static_cast<short>(remapWeightOne - dv);
+      const __m128i wx = _mm_set_epi16(du, du, du, du, du_1, du_1, du_1, du_1);
+      const __m128i wy = _mm_set_epi16(dv, dv_1, dv, dv_1, dv, dv_1, dv, dv_1);
+
+      __m128i ht = _mm_mullo_epi16(top, wx);
+      ht = _mm_add_epi16(ht, _mm_srli_si128(ht, 8));
+      __m128i hb = _mm_mullo_epi16(bottom, wx);
+      hb = _mm_add_epi16(hb, _mm_srli_si128(hb, 8));
+      const __m128i res =
+        _mm_srli_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(ht, hb), wy), round), remapShift);
+      const __m128i pix = _mm_packs_epi32(res, res);
+      const int rgba = _mm_cvtsi128_si32(_mm_packus_epi16(pix, pix));
+      memcpy(reinterpret_cast<unsigned char *>(dst + j), &rgba, sizeof(vpRGBa));
+    }
+  }
+#elif VISP_HAVE_NEON
+  for (; j < n; ++j) {
+    if (offsets[j] < 0) {
+      dst[j] = vpRGBa(0);
+      continue;
+    }
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(src + offsets[j]);
+    const uint16x8_t top = vmovl_u8(vld1_u8(p));
+    const uint16x8_t bottom = vmovl_u8(vld1_u8(p + (4 * srcWidth)));
+    const uint16_t du = weights[2 * j], dv = weights[(2 * j) + 1];
+    const uint16x8_t wx = vcombine_u16(vdup_n_u16(static_cast<uint16_t>(remapWeightOne - du)), vdup_n_u16(du));
+    const uint16x8_t mt = vmulq_u16(top, wx);
+    const uint16x8_t mb = vmulq_u16(bottom, wx);
+    const uint16x4_t ht = vadd_u16(vget_low_u16(mt), vget_high_u16(mt));
+    const uint16x4_t hb = vadd_u16(vget_low_u16(mb), vget_high_u16(mb));
+    const uint32x4_t acc = vmlal_n_u16(vmull_n_u16(ht, static_cast<uint16_t>(remapWeightOne - dv)), hb, dv);
+    const uint16x4_t res = vrshrn_n_u32(acc, remapShift);
+    const uint8x8_t pix = vmovn_u16(vcombine_u16(res, res));
+    vst1_lane_u32(reinterpret_cast<uint32_t *>(dst + j), vreinterpret_u32_u8(pix), 0);
+  }
+#endif
+  for (; j < n; ++j) {
+    if (offsets[j] < 0) {
+      dst[j] = vpRGBa(0);
+    }
+    else {
+      const unsigned char *p = reinterpret_cast<const unsigned char *>(src + offsets[j]);
+      unsigned char *q = reinterpret_cast<unsigned char *>(dst + j);
+      const unsigned int stride = 4 * srcWidth;
+      const int du = weights[2 * j], dv = weights[(2 * j) + 1];
+      for (unsigned int c = 0; c < 4; ++c) {
+        const int top = (p[c] * (remapWeightOne - du)) + (p[c + 4] * du);
+        const int bottom = (p[stride + c] * (remapWeightOne - du)) + (p[stride + c + 4] * du);
+        q[c] = static_cast<unsigned char>(((top * (remapWeightOne - dv)) + (bottom * dv) + remapRound) >> remapShift);
+      }
+    }
+  }
+}
+
+template <class Type>
+void remapImage(const vpImage<Type> &I, const vpImageRemapMap &map, vpImage<Type> &Idst, unsigned int nThreads)
+{
+  if ((I.getWidth() != map.getSrcWidth()) || (I.getHeight() != map.getSrcHeight())) {
+    throw(vpImageException(vpImageException::incorrectInitializationError,
+                           "Image size (%dx%d) does not match the remapping table (%dx%d)", I.getWidth(),
+                           I.getHeight(), map.getSrcWidth(), map.getSrcHeight()));
+  }
+
+  const unsigned int width = map.getWidth();
+  const int height = static_cast<int>(map.getHeight());
+  Idst.resize(map.getHeight(), width);
+  const int *offsets = map.getOffsets().empty() ? nullptr : &map.getOffsets()[0];
+  const unsigned char *weights = map.getWeights().empty() ? nullptr : &map.getWeights()[0];
+
+#if defined(_OPENMP)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for schedule(static)
+#else
+  (void)nThreads;
+#endif
+  for (int i = 0; i < height; ++i) {
+    const size_t start = static_cast<size_t>(i) * width;
+    remapRow(I.bitmap, I.getWidth(), offsets + start, weights + (2 * start), Idst.bitmap + start, width);
+  }
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Apply a precomputed fixed-point remapping table to a grayscale image, using bilinear interpolation.
+  Destination pixels without source correspondence are set to 0.
+
+  \param I : Input grayscale image, of size vpImageRemapMap::getSrcWidth() x vpImageRemapMap::getSrcHeight().
+  \param map : Remapping table built with vpImageRemapMap::initUndistort(), vpImageRemapMap::initWarp() or
+  vpImageRemapMap::init().
+  \param Idst : Output image, resized to vpImageRemapMap::getWidth() x vpImageRemapMap::getHeight().
+  \param nThreads : Number of threads to use if OpenMP is available (zero will use the default number of threads).
+
+  \exception vpImageException::incorrectInitializationError If the size of \e I does not match the table.
+*/
+void vpImageTools::remap(const vpImage<unsigned char> &I, const vpImageRemapMap &map, vpImage<unsigned char> &Idst,
+                         unsigned int nThreads)
+{
+  remapImage(I, map, Idst, nThreads);
+}
+
+/*!
+  Apply a precomputed fixed-point remapping table to a color image, using bilinear interpolation on the four
+  channels. Destination pixels without source correspondence are set to 0.
+
+  \param I : Input color image, of size vpImageRemapMap::getSrcWidth() x vpImageRemapMap::getSrcHeight().
+  \param map : Remapping table built with vpImageRemapMap::initUndistort(), vpImageRemapMap::initWarp() or
+  vpImageRemapMap::init().
+  \param Idst : Output image, resized to vpImageRemapMap::getWidth() x vpImageRemapMap::getHeight().
+  \param nThreads : Number of threads to use if OpenMP is available (zero will use the default number of threads).
+
+  \exception vpImageException::incorrectInitializationError If the size of \e I does not match the table.
+*/
+void vpImageTools::remap(const vpImage<vpRGBa> &I, const vpImageRemapMap &map, vpImage<vpRGBa> &Idst,
+                         unsigned int nThreads)
+{
+  remapImage(I, map, Idst, nThreads);
+}
+
+END_VISP_NAMESPACE
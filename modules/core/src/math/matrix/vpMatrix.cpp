@@ -116,6 +116,7 @@ void vpMatrix::blas_dsyev(char jobz, char uplo, unsigned int n_, double *a_data,
 #if !defined(VISP_USE_MSVC) || (defined(VISP_USE_MSVC) && !defined(VISP_BUILD_SHARED_LIBS))
 const unsigned int vpMatrix::m_lapack_min_size_default = 0;
 unsigned int vpMatrix::m_lapack_min_size = vpMatrix::m_lapack_min_size_default;
+const unsigned int vpMatrix::m_builtin_gemm_min_size = 16;
 #endif
 
 // Prototypes of specific functions
@@ -31,9 +31,39 @@
  * BLAS subroutines.
  */
 
+#include <algorithm>
+#include <vector>
+
 #include <visp3/core/vpConfig.h>
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpMatrix.h>
 
+#if defined(VISP_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#if defined __AVX__
+#include <immintrin.h>
+#define VISP_HAVE_AVX 1
+#endif
+
+#if defined _WIN32 && defined(_M_ARM64)
+#define _ARM64_DISTINCT_NEON_TYPES
+#include <Intrin.h>
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#elif (defined(__ARM_NEON__) || defined (__ARM_NEON)) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#else
+#define VISP_HAVE_NEON 0
+#endif
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
 #if defined(VISP_HAVE_LAPACK)
@@ -164,10 +194,315 @@ void vpMatrix::blas_dgemv(char trans, unsigned int M_, unsigned int N_, double a
 }
 #endif
 END_VISP_NAMESPACE
+#endif
+
+BEGIN_VISP_NAMESPACE
+namespace
+{
+// Register tile computed by the micro-kernels
+const unsigned int gemm_mr = 4;
+const unsigned int gemm_nr = 4;
+// Cache blocking: a kc x nr strip of B stays in L1, a mc x kc block of A in L2
+// and a kc x nc panel of B in L3
+const unsigned int gemm_mc = 96;
+const unsigned int gemm_kc = 256;
+const unsigned int gemm_nc = 2048;
+// Below this number of multiply-add the outer loop is not multithreaded
+const double gemm_parallel_min_flops = 64. * 64. * 64.;
+
+typedef void (*GemmKernel)(unsigned int kc, const double *a, const double *b, double *c);
+
+/*!
+  Scalar micro-kernel: c = a * b where a is a packed kc x mr strip and b a packed kc x nr strip.
+  The gemm_mr x gemm_nr result tile c is stored row-major.
+*/
+void gemmKernelScalar(unsigned int kc, const double *a, const double *b, double *c)
+{
+  double acc[gemm_mr * gemm_nr] = { 0. };
+  for (unsigned int k = 0; k < kc; ++k, a += gemm_mr, b += gemm_nr) {
+    for (unsigned int r = 0; r < gemm_mr; ++r) {
+      const double ar = a[r];
+      for (unsigned int j = 0; j < gemm_nr; ++j) {
+        acc[r * gemm_nr + j] += ar * b[j];
+      }
+    }
+  }
+  std::copy(acc, acc + gemm_mr * gemm_nr, c);
+}
+
+#if VISP_HAVE_SSE2
+void gemmKernelSSE2(unsigned int kc, const double *a, const double *b, double *c)
+{
+  __m128d c00 = _mm_setzero_pd(), c01 = _mm_setzero_pd();
+  __m128d c10 = _mm_setzero_pd(), c11 = _mm_setzero_pd();
+  __m128d c20 = _mm_setzero_pd(), c21 = _mm_setzero_pd();
+  __m128d c30 = _mm_setzero_pd(), c31 = _mm_setzero_pd();
+  for (unsigned int k = 0; k < kc; ++k, a += gemm_mr, b += gemm_nr) {
+    const __m128d b0 = _mm_loadu_pd(b);
+    const __m128d b1 = _mm_loadu_pd(b + 2);
+    __m128d ar = _mm_set1_pd(a[0]);
+    c00 = _mm_add_pd(c00, _mm_mul_pd(ar, b0));
+    c01 = _mm_add_pd(c01, _mm_mul_pd(ar, b1));
+    ar = _mm_set1_pd(a[1]);
+    c10 = _mm_add_pd(c10, _mm_mul_pd(ar, b0));
+    c11 = _mm_add_pd(c11, _mm_mul_pd(ar, b1));
+    ar = _mm_set1_pd(a[2]);
+    c20 = _mm_add_pd(c20, _mm_mul_pd(ar, b0));
+    c21 = _mm_add_pd(c21, _mm_mul_pd(ar, b1));
+    ar = _mm_set1_pd(a[3]);
+    c30 = _mm_add_pd(c30, _mm_mul_pd(ar, b0));
+    c31 = _mm_add_pd(c31, _mm_mul_pd(ar, b1));
+  }
+  _mm_storeu_pd(c, c00);
+  _mm_storeu_pd(c + 2, c01);
+  _mm_storeu_pd(c + 4, c10);
+  _mm_storeu_pd(c + 6, c11);
+  _mm_storeu_pd(c + 8, c20);
+  _mm_storeu_pd(c + 10, c21);
+  _mm_storeu_pd(c + 12, c30);
+  _mm_storeu_pd(c + 14, c31);
+}
+#endif
+
+#if VISP_HAVE_AVX
+void gemmKernelAVX(unsigned int kc, const double *a, const double *b, double *c)
+{
+  __m256d c0 = _mm256_setzero_pd(), c1 = _mm256_setzero_pd();
+  __m256d c2 = _mm256_setzero_pd(), c3 = _mm256_setzero_pd();
+  for (unsigned int k = 0; k < kc; ++k, a += gemm_mr, b += gemm_nr) {
+    const __m256d b0 = _mm256_loadu_pd(b);
+#if defined __FMA__
+    c0 = _mm256_fmadd_pd(_mm256_broadcast_sd(a), b0, c0);
+    c1 = _mm256_fmadd_pd(_mm256_broadcast_sd(a + 1), b0, c1);
+    c2 = _mm256_fmadd_pd(_mm256_broadcast_sd(a + 2), b0, c2);
+    c3 = _mm256_fmadd_pd(_mm256_broadcast_sd(a + 3), b0, c3);
 #else
-// Work around to avoid warning LNK4221: This object file does not define any
-// previously undefined public symbols
-void dummy_vpMatrix_blas() {}
+    c0 = _mm256_add_pd(c0, _mm256_mul_pd(_mm256_broadcast_sd(a), b0));
+    c1 = _mm256_add_pd(c1, _mm256_mul_pd(_mm256_broadcast_sd(a + 1), b0));
+    c2 = _mm256_add_pd(c2, _mm256_mul_pd(_mm256_broadcast_sd(a + 2), b0));
+    c3 = _mm256_add_pd(c3, _mm256_mul_pd(_mm256_broadcast_sd(a + 3), b0));
 #endif
+  }
+  _mm256_storeu_pd(c, c0);
+  _mm256_storeu_pd(c + 4, c1);
+  _mm256_storeu_pd(c + 8, c2);
+  _mm256_storeu_pd(c + 12, c3);
+}
+#endif
+
+#if VISP_HAVE_NEON
+void gemmKernelNeon(unsigned int kc, const double *a, const double *b, double *c)
+{
+  float64x2_t c00 = vdupq_n_f64(0.), c01 = vdupq_n_f64(0.);
+  float64x2_t c10 = vdupq_n_f64(0.), c11 = vdupq_n_f64(0.);
+  float64x2_t c20 = vdupq_n_f64(0.), c21 = vdupq_n_f64(0.);
+  float64x2_t c30 = vdupq_n_f64(0.), c31 = vdupq_n_f64(0.);
+  for (unsigned int k = 0; k < kc; ++k, a += gemm_mr, b += gemm_nr) {
+    const float64x2_t b0 = vld1q_f64(b);
+    const float64x2_t b1 = vld1q_f64(b + 2);
+    const float64x2_t a01 = vld1q_f64(a);
+    const float64x2_t a23 = vld1q_f64(a + 2);
+    c00 = vfmaq_laneq_f64(c00, b0, a01, 0);
+    c01 = vfmaq_laneq_f64(c01, b1, a01, 0);
+    c10 = vfmaq_laneq_f64(c10, b0, a01, 1);
+    c11 = vfmaq_laneq_f64(c11, b1, a01, 1);
+    c20 = vfmaq_laneq_f64(c20, b0, a23, 0);
+    c21 = vfmaq_laneq_f64(c21, b1, a23, 0);
+    c30 = vfmaq_laneq_f64(c30, b0, a23, 1);
+    c31 = vfmaq_laneq_f64(c31, b1, a23, 1);
+  }
+  vst1q_f64(c, c00);
+  vst1q_f64(c + 2, c01);
+  vst1q_f64(c + 4, c10);
+  vst1q_f64(c + 6, c11);
+  vst1q_f64(c + 8, c20);
+  vst1q_f64(c + 10, c21);
+  vst1q_f64(c + 12, c30);
+  vst1q_f64(c + 14, c31);
+}
+#endif
+
+/*!
+  Select the fastest micro-kernel supported both by the compiler flags and the running CPU.
+*/
+GemmKernel selectGemmKernel()
+{
+#if VISP_HAVE_AVX
+  if (vpCPUFeatures::checkAVX()) {
+    return gemmKernelAVX;
+  }
+#endif
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    return gemmKernelSSE2;
+  }
+#endif
+#if VISP_HAVE_NEON
+  return gemmKernelNeon;
+#else
+  return gemmKernelScalar;
+#endif
+}
+
+/*!
+  Pack the mc x kc block of A starting at a into strips of gemm_mr rows, each strip being stored
+  k-major. Missing rows of the last strip are zero padded.
+*/
+void packA(unsigned int mc, unsigned int kc, const double *a, unsigned int lda, double *packed)
+{
+  for (unsigned int i = 0; i < mc; i += gemm_mr) {
+    const unsigned int mr = std::min<unsigned int>(gemm_mr, mc - i);
+    for (unsigned int k = 0; k < kc; ++k) {
+      for (unsigned int r = 0; r < gemm_mr; ++r) {
+        *packed++ = (r < mr) ? a[(i + r) * lda + k] : 0.;
+      }
+    }
+  }
+}
+
+/*!
+  Pack the kc x nc panel of B starting at b into strips of gemm_nr columns, each strip being stored
+  k-major. Missing columns of the last strip are zero padded.
+*/
+void packB(unsigned int kc, unsigned int nc, const double *b, unsigned int ldb, double *packed)
+{
+  for (unsigned int j = 0; j < nc; j += gemm_nr) {
+    const unsigned int nr = std::min<unsigned int>(gemm_nr, nc - j);
+    for (unsigned int k = 0; k < kc; ++k) {
+      const double *bk = b + k * ldb + j;
+      for (unsigned int c = 0; c < gemm_nr; ++c) {
+        *packed++ = (c < nr) ? bk[c] : 0.;
+      }
+    }
+  }
+}
+} // namespace
+
+/*!
+  Built-in cache-blocked matrix-matrix product used when no Blas/Lapack third-party is available,
+  or when the matrices are too small to benefit from it.
+  Compute \f$ C = A B \f$ where \f$ A \f$ is a M by K, \f$ B \f$ a K by N and \f$ C \f$ a M by N
+  matrix, all stored row-major with respectively lda, ldb and ldc as leading dimension.
+
+  The operands are packed into cache-sized panels and the product is computed by a register tiled
+  micro-kernel that uses AVX, SSE2 or NEON instructions when available. For large products the rows
+  of C are distributed over the OpenMP threads.
+*/
+void vpMatrix::builtin_dgemm(unsigned int M, unsigned int N, unsigned int K, const double *a_data, unsigned int lda,
+                             const double *b_data, unsigned int ldb, double *c_data, unsigned int ldc)
+{
+  if ((M == 0) || (N == 0)) {
+    return;
+  }
+  if (K == 0) {
+    for (unsigned int i = 0; i < M; ++i) {
+      std::fill(c_data + i * ldc, c_data + i * ldc + N, 0.);
+    }
+    return;
+  }
+
+  static const GemmKernel kernel = selectGemmKernel();
+  const int nbBlocksM = static_cast<int>((M + gemm_mc - 1) / gemm_mc);
+#if defined(VISP_HAVE_OPENMP)
+  const bool useParallel = ((static_cast<double>(M) * N * K) > gemm_parallel_min_flops) && (nbBlocksM > 1);
+#endif
+  std::vector<double> packedB(static_cast<size_t>(gemm_kc) * (std::min<unsigned int>(gemm_nc, N) + gemm_nr));
+
+  for (unsigned int jc = 0; jc < N; jc += gemm_nc) {
+    const unsigned int nc = std::min<unsigned int>(gemm_nc, N - jc);
+    for (unsigned int pc = 0; pc < K; pc += gemm_kc) {
+      const unsigned int kc = std::min<unsigned int>(gemm_kc, K - pc);
+      const bool accumulate = (pc > 0);
+      packB(kc, nc, b_data + pc * ldb + jc, ldb, &packedB[0]);
+
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel if (useParallel)
+#endif
+      {
+        std::vector<double> packedA(static_cast<size_t>(gemm_mc + gemm_mr) * gemm_kc);
+        double tile[gemm_mr * gemm_nr];
+
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp for schedule(dynamic)
+#endif
+        for (int ib = 0; ib < nbBlocksM; ++ib) {
+          const unsigned int ic = static_cast<unsigned int>(ib) * gemm_mc;
+          const unsigned int mc = std::min<unsigned int>(gemm_mc, M - ic);
+          packA(mc, kc, a_data + ic * lda + pc, lda, &packedA[0]);
+
+          for (unsigned int jr = 0; jr < nc; jr += gemm_nr) {
+            const unsigned int nr = std::min<unsigned int>(gemm_nr, nc - jr);
+            const double *pb = &packedB[0] + jr * kc;
+            for (unsigned int ir = 0; ir < mc; ir += gemm_mr) {
+              const unsigned int mr = std::min<unsigned int>(gemm_mr, mc - ir);
+              kernel(kc, &packedA[0] + ir * kc, pb, tile);
+
+              double *c = c_data + (ic + ir) * ldc + jc + jr;
+              for (unsigned int r = 0; r < mr; ++r, c += ldc) {
+                const double *t = tile + r * gemm_nr;
+                if (accumulate) {
+                  for (unsigned int j = 0; j < nr; ++j) {
+                    c[j] += t[j];
+                  }
+                }
+                else {
+                  std::copy(t, t + nr, c);
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+/*!
+  Built-in matrix-vector product \f$ y = A x \f$ where \f$ A \f$ is a M by N row-major matrix
+  with lda as leading dimension. Each row is reduced with AVX, SSE2 or NEON instructions when
+  available, the rows being distributed over the OpenMP threads for large matrices.
+*/
+void vpMatrix::builtin_dgemv(unsigned int M, unsigned int N, const double *a_data, unsigned int lda,
+                             const double *x_data, double *y_data)
+{
+#if VISP_HAVE_SSE2
+  static const bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#endif
+  const int rows = static_cast<int>(M);
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for if ((static_cast<double>(M) * N) > gemm_parallel_min_flops)
+#endif
+  for (int i = 0; i < rows; ++i) {
+    const double *ai = a_data + static_cast<unsigned int>(i) * lda;
+    unsigned int j = 0;
+    double s = 0.;
+#if VISP_HAVE_SSE2
+    if (checkSSE2 && (N >= 4)) {
+      __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+      for (; j + 4 <= N; j += 4) {
+        s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(ai + j), _mm_loadu_pd(x_data + j)));
+        s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(ai + j + 2), _mm_loadu_pd(x_data + j + 2)));
+      }
+      double res[2];
+      _mm_storeu_pd(res, _mm_add_pd(s0, s1));
+      s = res[0] + res[1];
+    }
+#elif VISP_HAVE_NEON
+    if (N >= 4) {
+      float64x2_t s0 = vdupq_n_f64(0.), s1 = vdupq_n_f64(0.);
+      for (; j + 4 <= N; j += 4) {
+        s0 = vfmaq_f64(s0, vld1q_f64(ai + j), vld1q_f64(x_data + j));
+        s1 = vfmaq_f64(s1, vld1q_f64(ai + j + 2), vld1q_f64(x_data + j + 2));
+      }
+      s = vaddvq_f64(vaddq_f64(s0, s1));
+    }
+#endif
+    for (; j < N; ++j) {
+      s += ai[j] * x_data[j];
+    }
+    y_data[i] = s;
+  }
+}
+END_VISP_NAMESPACE
 
 #endif // #ifndef DOXYGEN_SHOULD_SKIP_THIS
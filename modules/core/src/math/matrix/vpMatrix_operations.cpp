@@ -132,13 +132,7 @@ void vpMatrix::multMatrixVector(const vpMatrix &A, const vpColVector &v, vpColVe
 #endif
   }
   else {
-    w = 0.0;
-    for (unsigned int j = 0; j < A.colNum; ++j) {
-      double vj = v[j]; // optimization em 5/12/2006
-      for (unsigned int i = 0; i < A.rowNum; ++i) {
-        w[i] += A.rowPtrs[i][j] * vj;
-      }
-    }
+    vpMatrix::builtin_dgemv(A.rowNum, A.colNum, A.data, A.colNum, v.data, w.data);
   }
 }
 
@@ -188,6 +182,12 @@ void vpMatrix::mult2Matrices(const vpMatrix &A, const vpMatrix &B, vpMatrix &C)
 #endif
 #endif
   }
+  else if ((A.getRows() >= vpMatrix::m_builtin_gemm_min_size) && (A.getCols() >= vpMatrix::m_builtin_gemm_min_size) &&
+           (B.getCols() >= vpMatrix::m_builtin_gemm_min_size)) {
+    // Cache-blocked product that pays off as soon as the matrices do not fit in the L1 cache
+    vpMatrix::builtin_dgemm(A.getRows(), B.getCols(), A.getCols(), A.data, A.getCols(), B.data, B.getCols(), C.data,
+                            C.getCols());
+  }
   else {
     const unsigned int BcolNum = B.getCols();
     const unsigned int BrowNum = B.getRows();
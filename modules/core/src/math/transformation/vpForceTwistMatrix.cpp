@@ -48,8 +48,6 @@
 
 BEGIN_VISP_NAMESPACE
 
-const unsigned int vpForceTwistMatrix::constr_value_6 = 6;
-
 /*!
   Copy operator.
 
@@ -88,7 +86,7 @@ void vpForceTwistMatrix::eye()
 /*!
   Initialize a force/torque twist transformation matrix to identity.
 */
-vpForceTwistMatrix::vpForceTwistMatrix() : vpArray2D<double>(constr_value_6, constr_value_6) { eye(); }
+vpForceTwistMatrix::vpForceTwistMatrix() : vpFixedSizeArray2D<double, 6, 6>() { eye(); }
 
 /*!
 
@@ -97,7 +95,7 @@ vpForceTwistMatrix::vpForceTwistMatrix() : vpArray2D<double>(constr_value_6, con
 
   \param F : Force/torque twist matrix used as initializer.
 */
-vpForceTwistMatrix::vpForceTwistMatrix(const vpForceTwistMatrix &F) : vpArray2D<double>(constr_value_6, constr_value_6) { *this = F; }
+vpForceTwistMatrix::vpForceTwistMatrix(const vpForceTwistMatrix &F) : vpFixedSizeArray2D<double, 6, 6>() { *this = F; }
 
 /*!
 
@@ -128,7 +126,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpForceTwistMatrix &F) : vpArray2D<
   \f]
 
 */
-vpForceTwistMatrix::vpForceTwistMatrix(const vpHomogeneousMatrix &M, bool full) : vpArray2D<double>(constr_value_6, constr_value_6)
+vpForceTwistMatrix::vpForceTwistMatrix(const vpHomogeneousMatrix &M, bool full) : vpFixedSizeArray2D<double, 6, 6>()
 {
   if (full) {
     buildFrom(M);
@@ -158,7 +156,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpHomogeneousMatrix &M, bool full)
 
 */
 vpForceTwistMatrix::vpForceTwistMatrix(const vpTranslationVector &t, const vpThetaUVector &thetau)
-  : vpArray2D<double>(constr_value_6, constr_value_6)
+  : vpFixedSizeArray2D<double, 6, 6>()
 {
   buildFrom(t, thetau);
 }
@@ -180,7 +178,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpTranslationVector &t, const vpThe
   \param thetau : \f$\theta u\f$ rotation vector used to initialize \f$R\f$.
 
 */
-vpForceTwistMatrix::vpForceTwistMatrix(const vpThetaUVector &thetau) : vpArray2D<double>(constr_value_6, constr_value_6) { buildFrom(thetau); }
+vpForceTwistMatrix::vpForceTwistMatrix(const vpThetaUVector &thetau) : vpFixedSizeArray2D<double, 6, 6>() { buildFrom(thetau); }
 
 /*!
 
@@ -202,7 +200,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpThetaUVector &thetau) : vpArray2D
 
 */
 vpForceTwistMatrix::vpForceTwistMatrix(const vpTranslationVector &t, const vpRotationMatrix &R)
-  : vpArray2D<double>(constr_value_6, constr_value_6)
+  : vpFixedSizeArray2D<double, 6, 6>()
 {
   buildFrom(t, R);
 }
@@ -224,7 +222,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpTranslationVector &t, const vpRot
   \param R : Rotation matrix.
 
 */
-vpForceTwistMatrix::vpForceTwistMatrix(const vpRotationMatrix &R) : vpArray2D<double>(constr_value_6, constr_value_6) { buildFrom(R); }
+vpForceTwistMatrix::vpForceTwistMatrix(const vpRotationMatrix &R) : vpFixedSizeArray2D<double, 6, 6>() { buildFrom(R); }
 
 /*!
 
@@ -253,7 +251,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpRotationMatrix &R) : vpArray2D<do
   radians and used to initialize the ratational matrix \f$R\f$.
 */
 vpForceTwistMatrix::vpForceTwistMatrix(double tx, double ty, double tz, double tux, double tuy, double tuz)
-  : vpArray2D<double>(constr_value_6, constr_value_6)
+  : vpFixedSizeArray2D<double, 6, 6>()
 {
   vpTranslationVector T(tx, ty, tz);
   vpThetaUVector tu(tux, tuy, tuz);
@@ -418,7 +416,13 @@ vpColVector vpForceTwistMatrix::operator*(const vpColVector &H) const
 */
 vpForceTwistMatrix &vpForceTwistMatrix::buildFrom(const vpTranslationVector &t, const vpRotationMatrix &R)
 {
-  vpMatrix skewaR = t.skew(t) * R;
+  // [t]_x R computed in place to avoid the allocation of intermediate matrices
+  const double skewaR[3][3] = { { (-t[2] * R[1][0]) + (t[1] * R[2][0]), (-t[2] * R[1][1]) + (t[1] * R[2][1]),
+                                  (-t[2] * R[1][2]) + (t[1] * R[2][2]) },
+                                { (t[2] * R[0][0]) - (t[0] * R[2][0]), (t[2] * R[0][1]) - (t[0] * R[2][1]),
+                                  (t[2] * R[0][2]) - (t[0] * R[2][2]) },
+                                { (-t[1] * R[0][0]) + (t[0] * R[1][0]), (-t[1] * R[0][1]) + (t[0] * R[1][1]),
+                                  (-t[1] * R[0][2]) + (t[0] * R[1][2]) } };
 
   const unsigned int val_3 = 3;
   const unsigned int index_3 = 3;
@@ -44,13 +44,12 @@
 #include <visp3/core/vpQuaternionVector.h>
 
 BEGIN_VISP_NAMESPACE
-const unsigned int vpHomogeneousMatrix::constr_value_4 = 4;
 /*!
   Construct an homogeneous matrix from a translation vector and quaternion
   rotation vector.
  */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpQuaternionVector &q)
-  : vpArray2D<double>(constr_value_4, constr_value_4)
+  : vpFixedSizeArray2D<double, 4, 4>()
 {
   const unsigned int index_3 = 3;
   buildFrom(t, q);
@@ -60,13 +59,13 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpQ
 /*!
   Default constructor that initialize an homogeneous matrix as identity.
 */
-vpHomogeneousMatrix::vpHomogeneousMatrix() : vpArray2D<double>(constr_value_4, constr_value_4), m_index(0) { eye(); }
+vpHomogeneousMatrix::vpHomogeneousMatrix() : vpFixedSizeArray2D<double, 4, 4>(), m_index(0) { eye(); }
 
 /*!
   Copy constructor that initialize an homogeneous matrix from another
   homogeneous matrix.
 */
-vpHomogeneousMatrix::vpHomogeneousMatrix(const vpHomogeneousMatrix &M) : vpArray2D<double>(constr_value_4, constr_value_4), m_index(0)
+vpHomogeneousMatrix::vpHomogeneousMatrix(const vpHomogeneousMatrix &M) : vpFixedSizeArray2D<double, 4, 4>(), m_index(0)
 {
   *this = M;
 }
@@ -76,7 +75,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const vpHomogeneousMatrix &M) : vpArray
   u}\f$ rotation vector.
  */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpThetaUVector &tu)
-  : vpArray2D<double>(constr_value_4, constr_value_4), m_index(0)
+  : vpFixedSizeArray2D<double, 4, 4>(), m_index(0)
 {
   const unsigned int index_3 = 3;
   buildFrom(t, tu);
@@ -88,7 +87,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpT
   matrix.
  */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpRotationMatrix &R)
-  : vpArray2D<double>(constr_value_4, constr_value_4), m_index(0)
+  : vpFixedSizeArray2D<double, 4, 4>(), m_index(0)
 {
   const unsigned int index_3 = 3;
   insert(R);
@@ -99,7 +98,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpR
 /*!
   Construct an homogeneous matrix from a pose vector.
  */
-vpHomogeneousMatrix::vpHomogeneousMatrix(const vpPoseVector &p) : vpArray2D<double>(constr_value_4, constr_value_4), m_index(0)
+vpHomogeneousMatrix::vpHomogeneousMatrix(const vpPoseVector &p) : vpFixedSizeArray2D<double, 4, 4>(), m_index(0)
 {
   const unsigned int index_0 = 0;
   const unsigned int index_1 = 1;
@@ -154,7 +153,7 @@ M:
 0  0  0  1
   \endcode
   */
-vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<float> &v) : vpArray2D<double>(constr_value_4, constr_value_4), m_index(0)
+vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<float> &v) : vpFixedSizeArray2D<double, 4, 4>(), m_index(0)
 {
   const unsigned int index_3 = 3;
   buildFrom(v);
@@ -203,7 +202,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<float> &v) : vpArray2
   \endcode
  */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const std::initializer_list<double> &list)
-  : vpArray2D<double>(4, 4), m_index(0)
+  : vpFixedSizeArray2D<double, 4, 4>(), m_index(0)
 {
   if (list.size() == 12) {
     std::copy(list.begin(), list.end(), data);
@@ -292,7 +291,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const std::initializer_list<double> &li
   0  0  0  1
   \endcode
   */
-vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<double> &v) : vpArray2D<double>(constr_value_4, constr_value_4), m_index(0)
+vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<double> &v) : vpFixedSizeArray2D<double, 4, 4>(), m_index(0)
 {
   const unsigned int index_3 = 3;
   buildFrom(v);
@@ -305,7 +304,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<double> &v) : vpArray
   u_z)^T\f$ rotation vector.
  */
 vpHomogeneousMatrix::vpHomogeneousMatrix(double tx, double ty, double tz, double tux, double tuy, double tuz)
-  : vpArray2D<double>(constr_value_4, constr_value_4), m_index(0)
+  : vpFixedSizeArray2D<double, 4, 4>(), m_index(0)
 {
   const unsigned int index_3 = 3;
   buildFrom(tx, ty, tz, tux, tuy, tuz);
@@ -589,21 +588,16 @@ vpHomogeneousMatrix vpHomogeneousMatrix::operator*(const vpHomogeneousMatrix &M)
 {
   vpHomogeneousMatrix p;
 
-  vpRotationMatrix R1, R2, R;
-  vpTranslationVector T1, T2, T;
-
-  extract(T1);
-  M.extract(T2);
-
-  extract(R1);
-  M.extract(R2);
-
-  R = R1 * R2;
-
-  T = (R1 * T2) + T1;
-
-  p.insert(T);
-  p.insert(R);
+  // R = R1 R2 and T = R1 T2 + T1 computed in place, the last row of p being already [0 0 0 1]
+  const unsigned int val_3 = 3;
+  for (unsigned int i = 0; i < val_3; ++i) {
+    const double *a = rowPtrs[i];
+    double *pi = p.rowPtrs[i];
+    for (unsigned int j = 0; j < val_3; ++j) {
+      pi[j] = (a[0] * M.rowPtrs[0][j]) + (a[1] * M.rowPtrs[1][j]) + (a[2] * M.rowPtrs[2][j]);
+    }
+    pi[val_3] = ((a[0] * M.rowPtrs[0][val_3]) + (a[1] * M.rowPtrs[1][val_3]) + (a[2] * M.rowPtrs[2][val_3])) + a[val_3];
+  }
 
   return p;
 }
@@ -1017,16 +1011,16 @@ vpHomogeneousMatrix vpHomogeneousMatrix::inverse() const
 {
   vpHomogeneousMatrix Mi;
 
-  vpRotationMatrix R;
-  extract(R);
-  vpTranslationVector T;
-  extract(T);
-
-  vpTranslationVector RtT;
-  RtT = -(R.t() * T);
-
-  Mi.insert(R.t());
-  Mi.insert(RtT);
+  // R^T and -R^T T computed in place, the last row of Mi being already [0 0 0 1]
+  const unsigned int val_3 = 3;
+  for (unsigned int i = 0; i < val_3; ++i) {
+    double *mi = Mi.rowPtrs[i];
+    for (unsigned int j = 0; j < val_3; ++j) {
+      mi[j] = rowPtrs[j][i];
+    }
+    mi[val_3] = -((rowPtrs[0][i] * rowPtrs[0][val_3]) + (rowPtrs[1][i] * rowPtrs[1][val_3]) +
+                  (rowPtrs[2][i] * rowPtrs[2][val_3]));
+  }
 
   return Mi;
 }
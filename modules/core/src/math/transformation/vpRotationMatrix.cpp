@@ -50,7 +50,6 @@
 #include <math.h>
 
 BEGIN_VISP_NAMESPACE
-const unsigned int vpRotationMatrix::constr_val_3 = 3;
 /*!
   Initialize the rotation matrix as identity.
 
@@ -510,35 +509,35 @@ bool vpRotationMatrix::isARotationMatrix(double threshold) const
 /*!
   Default constructor that initialise a 3-by-3 rotation matrix to identity.
 */
-vpRotationMatrix::vpRotationMatrix() : vpArray2D<double>(constr_val_3, constr_val_3), m_index(0) { eye(); }
+vpRotationMatrix::vpRotationMatrix() : vpFixedSizeArray2D<double, 3, 3>(), m_index(0) { eye(); }
 
 /*!
   Copy constructor that construct a 3-by-3 rotation matrix from another
   rotation matrix.
 */
-vpRotationMatrix::vpRotationMatrix(const vpRotationMatrix &M) : vpArray2D<double>(constr_val_3, constr_val_3), m_index(0) { (*this) = M; }
+vpRotationMatrix::vpRotationMatrix(const vpRotationMatrix &M) : vpFixedSizeArray2D<double, 3, 3>(), m_index(0) { (*this) = M; }
 
 /*!
   Construct a 3-by-3 rotation matrix from an homogeneous matrix.
 */
-vpRotationMatrix::vpRotationMatrix(const vpHomogeneousMatrix &M) : vpArray2D<double>(constr_val_3, constr_val_3), m_index(0) { buildFrom(M); }
+vpRotationMatrix::vpRotationMatrix(const vpHomogeneousMatrix &M) : vpFixedSizeArray2D<double, 3, 3>(), m_index(0) { buildFrom(M); }
 
 /*!
   Construct a 3-by-3 rotation matrix from \f$ \theta {\bf u}\f$ angle
   representation.
  */
-vpRotationMatrix::vpRotationMatrix(const vpThetaUVector &tu) : vpArray2D<double>(constr_val_3, constr_val_3), m_index(0) { buildFrom(tu); }
+vpRotationMatrix::vpRotationMatrix(const vpThetaUVector &tu) : vpFixedSizeArray2D<double, 3, 3>(), m_index(0) { buildFrom(tu); }
 
 /*!
   Construct a 3-by-3 rotation matrix from a pose vector.
  */
-vpRotationMatrix::vpRotationMatrix(const vpPoseVector &p) : vpArray2D<double>(constr_val_3, constr_val_3), m_index(0) { buildFrom(p); }
+vpRotationMatrix::vpRotationMatrix(const vpPoseVector &p) : vpFixedSizeArray2D<double, 3, 3>(), m_index(0) { buildFrom(p); }
 
 /*!
   Construct a 3-by-3 rotation matrix from \f$ R(z,y,z) \f$ Euler angle
   representation.
  */
-vpRotationMatrix::vpRotationMatrix(const vpRzyzVector &euler) : vpArray2D<double>(constr_val_3, constr_val_3), m_index(0)
+vpRotationMatrix::vpRotationMatrix(const vpRzyzVector &euler) : vpFixedSizeArray2D<double, 3, 3>(), m_index(0)
 {
   buildFrom(euler);
 }
@@ -547,24 +546,24 @@ vpRotationMatrix::vpRotationMatrix(const vpRzyzVector &euler) : vpArray2D<double
   Construct a 3-by-3 rotation matrix from \f$ R(x,y,z) \f$ Euler angle
   representation.
  */
-vpRotationMatrix::vpRotationMatrix(const vpRxyzVector &Rxyz) : vpArray2D<double>(constr_val_3, constr_val_3), m_index(0) { buildFrom(Rxyz); }
+vpRotationMatrix::vpRotationMatrix(const vpRxyzVector &Rxyz) : vpFixedSizeArray2D<double, 3, 3>(), m_index(0) { buildFrom(Rxyz); }
 
 /*!
   Construct a 3-by-3 rotation matrix from \f$ R(z,y,x) \f$ Euler angle
   representation.
  */
-vpRotationMatrix::vpRotationMatrix(const vpRzyxVector &Rzyx) : vpArray2D<double>(constr_val_3, constr_val_3), m_index(0) { buildFrom(Rzyx); }
+vpRotationMatrix::vpRotationMatrix(const vpRzyxVector &Rzyx) : vpFixedSizeArray2D<double, 3, 3>(), m_index(0) { buildFrom(Rzyx); }
 
 /*!
   Construct a 3-by-3 rotation matrix from a matrix that contains values corresponding to a rotation matrix.
 */
-vpRotationMatrix::vpRotationMatrix(const vpMatrix &R) : vpArray2D<double>(constr_val_3, constr_val_3), m_index(0) { *this = R; }
+vpRotationMatrix::vpRotationMatrix(const vpMatrix &R) : vpFixedSizeArray2D<double, 3, 3>(), m_index(0) { *this = R; }
 
 /*!
   Construct a 3-by-3 rotation matrix from \f$ \theta {\bf u}=(\theta u_x,
   \theta u_y, \theta u_z)^T\f$ angle representation.
  */
-vpRotationMatrix::vpRotationMatrix(double tux, double tuy, double tuz) : vpArray2D<double>(constr_val_3, constr_val_3), m_index(0)
+vpRotationMatrix::vpRotationMatrix(double tux, double tuy, double tuz) : vpFixedSizeArray2D<double, 3, 3>(), m_index(0)
 {
   buildFrom(tux, tuy, tuz);
 }
@@ -572,7 +571,7 @@ vpRotationMatrix::vpRotationMatrix(double tux, double tuy, double tuz) : vpArray
 /*!
   Construct a 3-by-3 rotation matrix from quaternion angle representation.
  */
-vpRotationMatrix::vpRotationMatrix(const vpQuaternionVector &q) : vpArray2D<double>(constr_val_3, constr_val_3), m_index(0) { buildFrom(q); }
+vpRotationMatrix::vpRotationMatrix(const vpQuaternionVector &q) : vpFixedSizeArray2D<double, 3, 3>(), m_index(0) { buildFrom(q); }
 
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
 /*!
@@ -601,8 +600,14 @@ vpRotationMatrix::vpRotationMatrix(const vpQuaternionVector &q) : vpArray2D<doub
   \endcode
  */
 vpRotationMatrix::vpRotationMatrix(const std::initializer_list<double> &list)
-  : vpArray2D<double>(3, 3, list), m_index(0)
+  : vpFixedSizeArray2D<double, 3, 3>(), m_index(0)
 {
+  if (list.size() != size()) {
+    throw(vpException(vpException::dimensionError,
+                      "Cannot create a rotation matrix from a list of %d elements instead of 9",
+                      static_cast<int>(list.size())));
+  }
+  std::copy(list.begin(), list.end(), data);
   if (!isARotationMatrix()) {
     if (isARotationMatrix(1e-3)) {
       orthogonalize();
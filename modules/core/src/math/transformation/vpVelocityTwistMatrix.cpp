@@ -46,7 +46,6 @@
 #include <visp3/core/vpVelocityTwistMatrix.h>
 
 BEGIN_VISP_NAMESPACE
-const unsigned int vpVelocityTwistMatrix::constr_val_6 = 6;
 /*!
   Copy operator that allow to set a velocity twist matrix from an other one.
 
@@ -86,7 +85,7 @@ void vpVelocityTwistMatrix::eye()
 /*!
   Initialize a velocity twist transformation matrix as identity.
 */
-vpVelocityTwistMatrix::vpVelocityTwistMatrix() : vpArray2D<double>(constr_val_6, constr_val_6) { eye(); }
+vpVelocityTwistMatrix::vpVelocityTwistMatrix() : vpFixedSizeArray2D<double, 6, 6>() { eye(); }
 
 /*!
   Initialize a velocity twist transformation matrix from another velocity
@@ -94,7 +93,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix() : vpArray2D<double>(constr_val_6,
 
   \param V : Velocity twist matrix used as initializer.
 */
-vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpVelocityTwistMatrix &V) : vpArray2D<double>(constr_val_6, constr_val_6) { *this = V; }
+vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpVelocityTwistMatrix &V) : vpFixedSizeArray2D<double, 6, 6>() { *this = V; }
 
 /*!
 
@@ -114,7 +113,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpVelocityTwistMatrix &V) : v
   {\bf 0}_{3\times 3} & {\bf R} \end{array} \right] \f]
 
 */
-vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpHomogeneousMatrix &M, bool full) : vpArray2D<double>(constr_val_6, constr_val_6)
+vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpHomogeneousMatrix &M, bool full) : vpFixedSizeArray2D<double, 6, 6>()
 {
   if (full) {
     buildFrom(M);
@@ -139,7 +138,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpHomogeneousMatrix &M, bool
 
 */
 vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpTranslationVector &t, const vpThetaUVector &thetau)
-  : vpArray2D<double>(constr_val_6, constr_val_6)
+  : vpFixedSizeArray2D<double, 6, 6>()
 {
   buildFrom(t, thetau);
 }
@@ -156,7 +155,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpTranslationVector &t, const
   vector \f$R\f$ .
 
 */
-vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpThetaUVector &thetau) : vpArray2D<double>(constr_val_6, constr_val_6)
+vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpThetaUVector &thetau) : vpFixedSizeArray2D<double, 6, 6>()
 {
   buildFrom(thetau);
 }
@@ -175,7 +174,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpThetaUVector &thetau) : vpA
 
 */
 vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpTranslationVector &t, const vpRotationMatrix &R)
-  : vpArray2D<double>(constr_val_6, constr_val_6)
+  : vpFixedSizeArray2D<double, 6, 6>()
 {
   buildFrom(t, R);
 }
@@ -191,7 +190,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpTranslationVector &t, const
   \param R : Rotation matrix.
 
 */
-vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpRotationMatrix &R) : vpArray2D<double>(constr_val_6, constr_val_6) { buildFrom(R); }
+vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpRotationMatrix &R) : vpFixedSizeArray2D<double, 6, 6>() { buildFrom(R); }
 
 /*!
 
@@ -215,7 +214,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpRotationMatrix &R) : vpArra
   radians and used to initialize the ratational matrix \f$R\f$.
 */
 vpVelocityTwistMatrix::vpVelocityTwistMatrix(double tx, double ty, double tz, double tux, double tuy, double tuz)
-  : vpArray2D<double>(constr_val_6, constr_val_6)
+  : vpFixedSizeArray2D<double, 6, 6>()
 {
   vpTranslationVector t(tx, ty, tz);
   vpThetaUVector tu(tux, tuy, tuz);
@@ -384,7 +383,13 @@ vpVelocityTwistMatrix &vpVelocityTwistMatrix::buildFrom(const vpRotationMatrix &
 */
 vpVelocityTwistMatrix &vpVelocityTwistMatrix::buildFrom(const vpTranslationVector &t, const vpRotationMatrix &R)
 {
-  vpMatrix skewaR = t.skew(t) * R;
+  // [t]_x R computed in place to avoid the allocation of intermediate matrices
+  const double skewaR[3][3] = { { (-t[2] * R[1][0]) + (t[1] * R[2][0]), (-t[2] * R[1][1]) + (t[1] * R[2][1]),
+                                  (-t[2] * R[1][2]) + (t[1] * R[2][2]) },
+                                { (t[2] * R[0][0]) - (t[0] * R[2][0]), (t[2] * R[0][1]) - (t[0] * R[2][1]),
+                                  (t[2] * R[0][2]) - (t[0] * R[2][2]) },
+                                { (-t[1] * R[0][0]) + (t[0] * R[1][0]), (-t[1] * R[0][1]) + (t[0] * R[1][1]),
+                                  (-t[1] * R[0][2]) + (t[0] * R[1][2]) } };
 
   const unsigned int index_3 = 3;
   const unsigned int val_3 = 3;
@@ -50,6 +50,7 @@
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpIoTools.h>
 #include <visp3/core/vpEndian.h>
+#include <visp3/core/vpUniRand.h>
 #include <visp3/io/vpImageIo.h>
 
 #ifdef ENABLE_VISP_NAMESPACE
@@ -1250,6 +1251,213 @@ TEST_CASE("Bayer conversion", "[image_conversion]")
 }
 #endif
 
+template <typename Type>
+void bayerFillRandom(std::vector<Type> &bayer, unsigned int max_value)
+{
+  vpUniRand rng;
+  for (size_t i = 0; i < bayer.size(); ++i) {
+    bayer[i] = static_cast<Type>(rng.uniform(0, static_cast<int>(max_value) + 1));
+  }
+}
+
+template <typename Type>
+bool bayerCheckThreads(void (*demosaic)(const Type *, Type *, unsigned int, unsigned int, unsigned int),
+                       const std::vector<Type> &bayer, unsigned int width, unsigned int height)
+{
+  std::vector<Type> rgba_ref(bayer.size() * 4), rgba(bayer.size() * 4);
+  demosaic(&bayer[0], &rgba_ref[0], width, height, 1);
+  for (unsigned int nThreads = 0; nThreads <= 4; ++nThreads) {
+    demosaic(&bayer[0], &rgba[0], width, height, nThreads);
+    if (rgba != rgba_ref) {
+      std::cout << "Different result with " << nThreads << " threads for a " << width << "x" << height << " image"
+        << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST_CASE("Bayer conversion interior pixels", "[image_conversion]")
+{
+  // Odd sizes to also check the last row and column
+  const unsigned int bayer_width = 67, bayer_height = 41;
+  std::vector<uint8_t> bayer(bayer_width * bayer_height);
+  bayerFillRandom(bayer, 255);
+
+  SECTION("Bilinear reference")
+  {
+    std::vector<uint8_t> rgba(bayer.size() * 4);
+    vpImageConvert::demosaicRGGBToRGBaBilinear(&bayer[0], &rgba[0], bayer_width, bayer_height);
+
+    bool same = true;
+    for (unsigned int i = 1; i < bayer_height - 1 && same; ++i) {
+      for (unsigned int j = 1; j < bayer_width - 1; ++j) {
+        const uint8_t *p = &bayer[i * bayer_width + j];
+        const uint8_t phi = static_cast<uint8_t>(0.5f * p[-static_cast<int>(bayer_width)] + 0.5f * p[bayer_width]);
+        const uint8_t theta = static_cast<uint8_t>(0.5f * p[-1] + 0.5f * p[1]);
+        const uint8_t checker = static_cast<uint8_t>(0.25f * p[-static_cast<int>(bayer_width) - 1] +
+                                                     0.25f * p[-static_cast<int>(bayer_width) + 1] +
+                                                     0.25f * p[bayer_width - 1] + 0.25f * p[bayer_width + 1]);
+        const uint8_t cross = static_cast<uint8_t>(0.25f * p[-static_cast<int>(bayer_width)] + 0.25f * p[-1] +
+                                                   0.25f * p[1] + 0.25f * p[bayer_width]);
+        uint8_t r = 0, g = 0, b = 0;
+        if (i % 2 == 0 && j % 2 == 0) {
+          r = *p;
+          g = cross;
+          b = checker;
+        }
+        else if (i % 2 == 0) {
+          r = theta;
+          g = *p;
+          b = phi;
+        }
+        else if (j % 2 == 0) {
+          r = phi;
+          g = *p;
+          b = theta;
+        }
+        else {
+          r = checker;
+          g = cross;
+          b = *p;
+        }
+        const uint8_t *q = &rgba[(i * bayer_width + j) * 4];
+        if (q[0] != r || q[1] != g || q[2] != b) {
+          std::cout << "Wrong RGGB bilinear interpolation at (" << i << ", " << j << ")" << std::endl;
+          same = false;
+          break;
+        }
+      }
+    }
+    CHECK(same);
+  }
+
+  SECTION("Same result whatever the number of threads")
+  {
+    std::vector<uint16_t> bayer_16U(bayer.size());
+    bayerFillRandom(bayer_16U, 4095);
+
+    for (unsigned int k = 0; k < 2; ++k) {
+      // Check also images that are too small to have interior pixels
+      const unsigned int w = (k == 0) ? bayer_width : 4, h = (k == 0) ? bayer_height : 5;
+      CHECK(bayerCheckThreads<uint8_t>(vpImageConvert::demosaicBGGRToRGBaBilinear, bayer, w, h));
+      CHECK(bayerCheckThreads<uint8_t>(vpImageConvert::demosaicGBRGToRGBaBilinear, bayer, w, h));
+      CHECK(bayerCheckThreads<uint8_t>(vpImageConvert::demosaicGRBGToRGBaBilinear, bayer, w, h));
+      CHECK(bayerCheckThreads<uint8_t>(vpImageConvert::demosaicRGGBToRGBaBilinear, bayer, w, h));
+      CHECK(bayerCheckThreads<uint8_t>(vpImageConvert::demosaicBGGRToRGBaMalvar, bayer, w, h));
+      CHECK(bayerCheckThreads<uint8_t>(vpImageConvert::demosaicGBRGToRGBaMalvar, bayer, w, h));
+      CHECK(bayerCheckThreads<uint8_t>(vpImageConvert::demosaicGRBGToRGBaMalvar, bayer, w, h));
+      CHECK(bayerCheckThreads<uint8_t>(vpImageConvert::demosaicRGGBToRGBaMalvar, bayer, w, h));
+      CHECK(bayerCheckThreads<uint16_t>(vpImageConvert::demosaicBGGRToRGBaBilinear, bayer_16U, w, h));
+      CHECK(bayerCheckThreads<uint16_t>(vpImageConvert::demosaicGBRGToRGBaBilinear, bayer_16U, w, h));
+      CHECK(bayerCheckThreads<uint16_t>(vpImageConvert::demosaicGRBGToRGBaBilinear, bayer_16U, w, h));
+      CHECK(bayerCheckThreads<uint16_t>(vpImageConvert::demosaicRGGBToRGBaBilinear, bayer_16U, w, h));
+      CHECK(bayerCheckThreads<uint16_t>(vpImageConvert::demosaicBGGRToRGBaMalvar, bayer_16U, w, h));
+      CHECK(bayerCheckThreads<uint16_t>(vpImageConvert::demosaicGBRGToRGBaMalvar, bayer_16U, w, h));
+      CHECK(bayerCheckThreads<uint16_t>(vpImageConvert::demosaicGRBGToRGBaMalvar, bayer_16U, w, h));
+      CHECK(bayerCheckThreads<uint16_t>(vpImageConvert::demosaicRGGBToRGBaMalvar, bayer_16U, w, h));
+    }
+  }
+}
+
+namespace
+{
+unsigned char yuvSaturate(int c) { return static_cast<unsigned char>(std::min<int>(std::max<int>(c, 0), 255)); }
+
+// Per pixel reference of the YUV 4:2:0 and YUV 4:2:2 conversions
+void yuvToRGBaRef(int y, int u, int v, unsigned char *rgba)
+{
+  const int U = static_cast<int>((u - 128) * 0.354);
+  const int V = static_cast<int>((v - 128) * 0.707);
+  rgba[0] = yuvSaturate(y + 2 * V);
+  rgba[1] = yuvSaturate(y - U - V);
+  rgba[2] = yuvSaturate(y + 5 * U);
+  rgba[3] = vpRGBa::alpha_default;
+}
+}
+
+TEST_CASE("YUV conversion", "[image_conversion]")
+{
+  // Width that is not a multiple of the vector size
+  const unsigned int yuv_width = 70, yuv_height = 46, size = yuv_width * yuv_height;
+  std::vector<unsigned char> yuv(size * 2);
+  vpUniRand rng;
+  for (size_t i = 0; i < yuv.size(); ++i) {
+    yuv[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+
+  SECTION("YUV 4:2:0")
+  {
+    std::vector<unsigned char> rgba(size * 4), rgba_ref(size * 4);
+    const unsigned char *u = &yuv[size], *v = &yuv[(5 * size) / 4];
+    for (unsigned int i = 0; i < yuv_height; ++i) {
+      for (unsigned int j = 0; j < yuv_width; ++j) {
+        const unsigned int k = ((i / 2) * (yuv_width / 2)) + (j / 2);
+        yuvToRGBaRef(yuv[(i * yuv_width) + j], u[k], v[k], &rgba_ref[((i * yuv_width) + j) * 4]);
+      }
+    }
+    vpImageConvert::YUV420ToRGBa(&yuv[0], &rgba[0], yuv_width, yuv_height);
+    CHECK(rgba == rgba_ref);
+
+    std::vector<unsigned char> grey(size), grey_ref(size);
+    vpImageConvert::YUV420ToGrey(&yuv[0], &grey_ref[0], size);
+    for (unsigned int nThreads = 1; nThreads <= 4; ++nThreads) {
+      std::fill(rgba.begin(), rgba.end(), 0);
+      vpImageConvert::YUV420ToGreyAndRGBa(&yuv[0], &grey[0], &rgba[0], yuv_width, yuv_height, nThreads);
+      CHECK(rgba == rgba_ref);
+      CHECK(grey == grey_ref);
+    }
+  }
+
+  SECTION("YUV 4:2:2")
+  {
+    std::vector<unsigned char> rgba(size * 4), rgba_ref(size * 4);
+    for (unsigned int i = 0; i < size; i += 2) {
+      const unsigned char *uyvy = &yuv[2 * i];
+      yuvToRGBaRef(uyvy[1], uyvy[0], uyvy[2], &rgba_ref[i * 4]);
+      yuvToRGBaRef(uyvy[3], uyvy[0], uyvy[2], &rgba_ref[(i + 1) * 4]);
+    }
+    vpImageConvert::YUV422ToRGBa(&yuv[0], &rgba[0], size);
+    CHECK(rgba == rgba_ref);
+
+    std::vector<unsigned char> grey(size), grey_ref(size);
+    vpImageConvert::YUV422ToGrey(&yuv[0], &grey_ref[0], size);
+    for (unsigned int nThreads = 1; nThreads <= 4; ++nThreads) {
+      std::fill(rgba.begin(), rgba.end(), 0);
+      vpImageConvert::YUV422ToGreyAndRGBa(&yuv[0], &grey[0], &rgba[0], size, nThreads);
+      CHECK(rgba == rgba_ref);
+      CHECK(grey == grey_ref);
+    }
+  }
+
+  SECTION("YUYV")
+  {
+    std::vector<unsigned char> rgba(size * 4), rgba_ref(size * 4), rgb(size * 3);
+    for (unsigned int i = 0; i < size; i += 2) {
+      const int y0 = yuv[2 * i], u = yuv[(2 * i) + 1] - 128, y1 = yuv[(2 * i) + 2], v = yuv[(2 * i) + 3] - 128;
+      const int cb = (u * 454) / 256, cg = ((u * 88) + (v * 183)) / 256, cr = (v * 359) / 256;
+      const int y[2] = { y0, y1 };
+      for (unsigned int k = 0; k < 2; ++k) {
+        unsigned char *p = &rgba_ref[(i + k) * 4];
+        p[0] = yuvSaturate(y[k] + cr);
+        p[1] = yuvSaturate(y[k] - cg);
+        p[2] = yuvSaturate(y[k] + cb);
+        p[3] = vpRGBa::alpha_default;
+      }
+    }
+    vpImageConvert::YUYVToRGBa(&yuv[0], &rgba[0], yuv_width, yuv_height, 3);
+    CHECK(rgba == rgba_ref);
+
+    vpImageConvert::YUYVToRGB(&yuv[0], &rgb[0], yuv_width, yuv_height);
+    bool same = true;
+    for (unsigned int i = 0; i < size; ++i) {
+      same = same && (rgb[3 * i] == rgba_ref[4 * i]) && (rgb[(3 * i) + 1] == rgba_ref[(4 * i) + 1]) &&
+        (rgb[(3 * i) + 2] == rgba_ref[(4 * i) + 2]);
+    }
+    CHECK(same);
+  }
+}
+
 template<typename Type>
 bool test_hsv(const std::vector<Type> &hue, const std::vector<Type> &saturation,
               const std::vector<Type> &value, const std::vector< std::vector<unsigned char> > &rgb_truth,
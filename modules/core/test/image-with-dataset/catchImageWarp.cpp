@@ -48,6 +48,7 @@
 #endif
 
 #include <iostream>
+#include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpImageTools.h>
 #include <visp3/core/vpIoTools.h>
 #include <visp3/io/vpImageIo.h>
@@ -63,6 +64,9 @@ static const double g_threshold_percentage = 0.9;
 static const double g_threshold_percentage_bilinear = 0.75;
 static const double g_threshold_percentage_pers = 0.75;
 static const double g_threshold_percentage_pers_bilinear = 0.65;
+// The remapping table quantizes the source positions on 7 bits and rounds the interpolated values
+static const double g_threshold_value_remap = 2.5;
+static const double g_threshold_percentage_remap = 0.999;
 
 VP_ATTRIBUTE_NO_DESTROY static const std::vector<vpImageTools::vpImageInterpolationType> interp_methods = {
   vpImageTools::INTERPOLATION_NEAREST,
@@ -719,6 +723,96 @@ TEST_CASE("Perspective warp on color", "[warp_image]")
   }
 }
 
+TEST_CASE("Multithreaded warp and remapping table", "[warp_image]")
+{
+  const std::string imgPath = vpIoTools::createFilePath(vpIoTools::getViSPImagesDataPath(), "Klimt/Klimt.ppm");
+  REQUIRE(vpIoTools::checkFilename(imgPath));
+
+  vpImage<vpRGBa> I_color;
+  vpImageIo::read(I_color, imgPath);
+  REQUIRE(I_color.getSize() > 0);
+  vpImage<unsigned char> I;
+  vpImageConvert::convert(I_color, I);
+
+  vpMatrix M(3, 3);
+  M.eye();
+  const double theta = vpMath::rad(20);
+  M[0][0] = 0.9 * cos(theta);
+  M[0][1] = -0.9 * sin(theta);
+  M[0][2] = I.getWidth() / 6.;
+  M[1][0] = 0.9 * sin(theta);
+  M[1][1] = 0.9 * cos(theta);
+  M[1][2] = -static_cast<double>(I.getHeight()) / 10;
+  M[2][0] = 1e-4;
+  M[2][1] = -5e-5;
+
+  std::vector<vpMatrix> transformations(2);
+  transformations[0].init(M, 0, 0, 2, 3);
+  transformations[1] = M;
+
+  for (size_t t = 0; t < transformations.size(); t++) {
+    SECTION(t == 0 ? "Affine" : "Perspective")
+    {
+      SECTION("Number of threads")
+      {
+        for (size_t i = 0; i < interp_methods.size(); i++) {
+          for (int fixedPoint = 0; fixedPoint < 2; fixedPoint++) {
+            vpImage<unsigned char> I_warp_1, I_warp_n;
+            vpImageTools::warpImage(I, transformations[t], I_warp_1, interp_methods[i], fixedPoint != 0, false, 1);
+            vpImageTools::warpImage(I, transformations[t], I_warp_n, interp_methods[i], fixedPoint != 0, false, 4);
+            CHECK(I_warp_1 == I_warp_n);
+
+            vpImage<vpRGBa> I_color_warp_1, I_color_warp_n;
+            vpImageTools::warpImage(I_color, transformations[t], I_color_warp_1, interp_methods[i], fixedPoint != 0,
+                                    false, 1);
+            vpImageTools::warpImage(I_color, transformations[t], I_color_warp_n, interp_methods[i], fixedPoint != 0,
+                                    false, 4);
+            CHECK(I_color_warp_1 == I_color_warp_n);
+          }
+        }
+      }
+
+      SECTION("Remapping table")
+      {
+        vpImageRemapMap map;
+        map.initWarp(transformations[t], I.getWidth(), I.getHeight(), I.getWidth(), I.getHeight());
+
+        vpImage<unsigned char> I_ref(I.getHeight(), I.getWidth(), 0), I_remap;
+        vpImageTools::warpImage(I, transformations[t], I_ref, vpImageTools::INTERPOLATION_LINEAR, false);
+        vpImageTools::remap(I, map, I_remap);
+        double percentage = 0.0;
+        CHECK(almostEqual(I_ref, I_remap, g_threshold_value_remap, g_threshold_percentage_remap, percentage));
+
+        vpImage<vpRGBa> I_color_ref(I.getHeight(), I.getWidth(), vpRGBa(0)), I_color_remap;
+        vpImageTools::warpImage(I_color, transformations[t], I_color_ref, vpImageTools::INTERPOLATION_LINEAR, false);
+        vpImageTools::remap(I_color, map, I_color_remap, 2);
+        CHECK(almostEqual(I_color_ref, I_color_remap, g_threshold_value_remap, g_threshold_percentage_remap, percentage));
+      }
+    }
+  }
+
+  SECTION("Undistortion table")
+  {
+    vpCameraParameters cam(600, 600, I.getWidth() / 2., I.getHeight() / 2., -0.25, 0.27);
+    vpArray2D<int> mapU, mapV;
+    vpArray2D<float> mapDu, mapDv;
+    vpImageTools::initUndistortMap(cam, I.getWidth(), I.getHeight(), mapU, mapV, mapDu, mapDv);
+    vpImageRemapMap map;
+    map.initUndistort(cam, I.getWidth(), I.getHeight());
+
+    vpImage<unsigned char> I_ref, I_undist;
+    vpImageTools::remap(I, mapU, mapV, mapDu, mapDv, I_ref);
+    vpImageTools::undistort(I, map, I_undist);
+    double percentage = 0.0;
+    CHECK(almostEqual(I_ref, I_undist, g_threshold_value_remap, g_threshold_percentage_remap, percentage));
+
+    vpImage<vpRGBa> I_color_ref, I_color_undist;
+    vpImageTools::remap(I_color, mapU, mapV, mapDu, mapDv, I_color_ref);
+    vpImageTools::undistort(I_color, map, I_color_undist);
+    CHECK(almostEqual(I_color_ref, I_color_undist, g_threshold_value_remap, g_threshold_percentage_remap, percentage));
+  }
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session;
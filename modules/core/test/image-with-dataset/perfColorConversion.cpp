@@ -316,6 +316,29 @@ TEST_CASE("Benchmark bgra to rgba (ViSP)", "[benchmark]")
   };
 }
 
+#ifndef VISP_SKIP_BAYER_CONVERSION
+TEST_CASE("Benchmark Bayer demosaicing (ViSP)", "[benchmark]")
+{
+  vpImage<unsigned char> I;
+  vpImageIo::read(I, imagePathGray);
+  vpImage<vpRGBa> I_rgba(I.getHeight(), I.getWidth());
+
+  BENCHMARK("Benchmark RGGB to rgba bilinear (ViSP)")
+  {
+    vpImageConvert::demosaicRGGBToRGBaBilinear(I.bitmap, reinterpret_cast<unsigned char *>(I_rgba.bitmap), I.getWidth(),
+                                               I.getHeight(), nThreads);
+    return I_rgba;
+  };
+
+  BENCHMARK("Benchmark RGGB to rgba Malvar (ViSP)")
+  {
+    vpImageConvert::demosaicRGGBToRGBaMalvar(I.bitmap, reinterpret_cast<unsigned char *>(I_rgba.bitmap), I.getWidth(),
+                                             I.getHeight(), nThreads);
+    return I_rgba;
+  };
+}
+#endif
+
 int main(int argc, char *argv[])
 {
   Catch::Session session;
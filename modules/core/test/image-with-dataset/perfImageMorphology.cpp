@@ -137,6 +137,68 @@ TEST_CASE("Benchmark binary image morphology", "[benchmark]")
   }
 }
 
+TEST_CASE("Benchmark gray image morphology with large structuring elements", "[benchmark]")
+{
+  std::string imagePath = vpIoTools::createFilePath(ipath, "Klimt/Klimt.pgm");
+  vpImage<unsigned char> I;
+  vpImageIo::read(I, imagePath);
+
+  const int sizes[] = { 3, 15, 31 };
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+    const int size = sizes[i];
+    vpImage<unsigned char> I_morpho = I, I_morpho_ref = I;
+    std::ostringstream oss;
+    oss << size << "x" << size;
+
+    BENCHMARK("Benchmark erosion " + oss.str() + " (naive code)")
+    {
+      I_morpho_ref = I;
+      common_tools::imageMorphologyRef(I_morpho_ref, size, size, true);
+      return I_morpho_ref;
+    };
+
+    BENCHMARK("Benchmark erosion " + oss.str() + " (ViSP)")
+    {
+      I_morpho = I;
+      vpImageMorphology::erosion(I_morpho, size);
+      return I_morpho;
+    };
+    CHECK((I_morpho_ref == I_morpho));
+
+    BENCHMARK("Benchmark opening " + oss.str() + " (ViSP)")
+    {
+      I_morpho = I;
+      vpImageMorphology::opening(I_morpho, size);
+      return I_morpho;
+    };
+
+    BENCHMARK("Benchmark top-hat " + oss.str() + " (ViSP)")
+    {
+      I_morpho = I;
+      vpImageMorphology::topHat(I_morpho, size);
+      return I_morpho;
+    };
+
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x030000) && defined(HAVE_OPENCV_IMGPROC)
+    cv::Mat img, imgMorph;
+    vpImageConvert::convert(I, img);
+    cv::Mat rect_SE = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(size, size));
+
+    BENCHMARK("Benchmark erosion " + oss.str() + " (OpenCV)")
+    {
+      cv::morphologyEx(img, imgMorph, cv::MORPH_ERODE, rect_SE);
+      return imgMorph;
+    };
+
+    BENCHMARK("Benchmark top-hat " + oss.str() + " (OpenCV)")
+    {
+      cv::morphologyEx(img, imgMorph, cv::MORPH_TOPHAT, rect_SE);
+      return imgMorph;
+    };
+#endif
+  }
+}
+
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x030000) && defined(HAVE_OPENCV_IMGPROC)
 TEST_CASE("Benchmark gray image morphology", "[benchmark]")
 {
@@ -45,6 +45,7 @@
 #include <catch2/catch_all.hpp>
 #endif
 
+#include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpImageTools.h>
 #include <visp3/core/vpIoTools.h>
 #include <visp3/io/vpImageIo.h>
@@ -341,6 +342,122 @@ TEST_CASE("Benchmark perspective warp on color image", "[benchmark]")
 #endif
 }
 
+TEST_CASE("Benchmark warp and remap at multiple resolutions", "[benchmark]")
+{
+  std::string imgPath = vpIoTools::createFilePath(ipath, "Klimt/Klimt.ppm");
+  REQUIRE(vpIoTools::checkFilename(imgPath));
+
+  vpImage<vpRGBa> I_klimt;
+  vpImageIo::read(I_klimt, imgPath);
+  REQUIRE(I_klimt.getSize() > 0);
+
+  const unsigned int widths[] = { 640, 1280, 1920 };
+  const unsigned int heights[] = { 480, 720, 1080 };
+  for (size_t r = 0; r < 3; r++) {
+    const unsigned int width = widths[r], height = heights[r];
+    const std::string res = " (" + std::to_string(width) + "x" + std::to_string(height) + ")";
+
+    vpImage<vpRGBa> I_color;
+    vpImageTools::resize(I_klimt, I_color, width, height, vpImageTools::INTERPOLATION_LINEAR);
+    vpImage<unsigned char> I;
+    vpImageConvert::convert(I_color, I);
+    vpImage<unsigned char> I_warp(height, width);
+    vpImage<vpRGBa> I_color_warp(height, width);
+
+    vpMatrix M_affine(2, 3);
+    M_affine.eye();
+    const double theta = vpMath::rad(30);
+    M_affine[0][0] = cos(theta);
+    M_affine[0][1] = -sin(theta);
+    M_affine[0][2] = width / 4;
+    M_affine[1][0] = sin(theta);
+    M_affine[1][1] = cos(theta);
+    M_affine[1][2] = -static_cast<double>(height) / 8;
+
+    vpMatrix M_perspective(3, 3);
+    M_perspective.eye();
+    M_perspective.insert(M_affine, 0, 0);
+    M_perspective[2][0] = 1e-4;
+    M_perspective[2][1] = -5e-5;
+
+    vpImageRemapMap map_warp;
+    map_warp.initWarp(M_perspective, width, height, width, height);
+
+    vpCameraParameters cam(0.8 * width, 0.8 * width, width / 2., height / 2., -0.25, 0.27);
+    vpArray2D<int> mapU, mapV;
+    vpArray2D<float> mapDu, mapDv;
+    vpImageTools::initUndistortMap(cam, width, height, mapU, mapV, mapDu, mapDv);
+    vpImageRemapMap map_undistort;
+    map_undistort.initUndistort(cam, width, height);
+
+    BENCHMARK("Benchmark affine warp (fixed-point) (bilinear) (1 thread)" + res)
+    {
+      vpImageTools::warpImage(I, M_affine, I_warp, vpImageTools::INTERPOLATION_LINEAR, true, false, 1);
+      return I_warp;
+    };
+
+    BENCHMARK("Benchmark affine warp (fixed-point) (bilinear)" + res)
+    {
+      vpImageTools::warpImage(I, M_affine, I_warp, vpImageTools::INTERPOLATION_LINEAR);
+      return I_warp;
+    };
+
+    BENCHMARK("Benchmark perspective warp (fixed-point) (bilinear) (1 thread)" + res)
+    {
+      vpImageTools::warpImage(I, M_perspective, I_warp, vpImageTools::INTERPOLATION_LINEAR, true, false, 1);
+      return I_warp;
+    };
+
+    BENCHMARK("Benchmark perspective warp (fixed-point) (bilinear)" + res)
+    {
+      vpImageTools::warpImage(I, M_perspective, I_warp, vpImageTools::INTERPOLATION_LINEAR);
+      return I_warp;
+    };
+
+    BENCHMARK("Benchmark perspective warp (remap table) (bilinear)" + res)
+    {
+      vpImageTools::remap(I, map_warp, I_warp);
+      return I_warp;
+    };
+
+    BENCHMARK("Benchmark perspective warp color (fixed-point) (bilinear)" + res)
+    {
+      vpImageTools::warpImage(I_color, M_perspective, I_color_warp, vpImageTools::INTERPOLATION_LINEAR);
+      return I_color_warp;
+    };
+
+    BENCHMARK("Benchmark perspective warp color (remap table) (bilinear)" + res)
+    {
+      vpImageTools::remap(I_color, map_warp, I_color_warp);
+      return I_color_warp;
+    };
+
+    BENCHMARK("Benchmark undistort (float maps)" + res)
+    {
+      vpImageTools::remap(I, mapU, mapV, mapDu, mapDv, I_warp);
+      return I_warp;
+    };
+
+    BENCHMARK("Benchmark undistort (remap table)" + res)
+    {
+      vpImageTools::undistort(I, map_undistort, I_warp);
+      return I_warp;
+    };
+
+    BENCHMARK("Benchmark undistort color (float maps)" + res)
+    {
+      vpImageTools::remap(I_color, mapU, mapV, mapDu, mapDv, I_color_warp);
+      return I_color_warp;
+    };
+
+    BENCHMARK("Benchmark undistort color (remap table)" + res)
+    {
+      vpImageTools::undistort(I_color, map_undistort, I_color_warp);
+      return I_color_warp;
+    };
+  }
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session;
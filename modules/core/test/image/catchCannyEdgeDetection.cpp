@@ -0,0 +1,146 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2026 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test Canny edge detection.
+ */
+
+/*!
+  \example catchCannyEdgeDetection.cpp
+
+  \brief Test Canny edge detection.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(VISP_BUILD_CATCH2)
+#include <catch_amalgamated.hpp>
+#else // Since v3.1.1
+#include <catch2/catch_all.hpp>
+#endif
+#include <visp3/core/vpCannyEdgeDetection.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+// Column of the edge chain at a given row, shifted by one pixel every 50 rows to test the 8-connexity
+unsigned int chainColumn(unsigned int row, unsigned int col) { return col + ((row / 50) % 2); }
+}
+
+TEST_CASE("Canny edge tracking", "[canny]")
+{
+  SECTION("Hysteresis thresholding along long edges")
+  {
+    const unsigned int height = 4000, width = 64;
+    const unsigned int colConnected = 10, colIsolated = 40, rowStart = 5, rowEnd = height - 5;
+    const float lowerThreshold = 20.f, upperThreshold = 50.f;
+    vpImage<unsigned char> I(height, width, 0);
+    vpImage<float> dIx(height, width, 0.f), dIy(height, width, 0.f);
+    for (unsigned int r = rowStart; r < rowEnd; ++r) {
+      // Weak edges, a single strong edge at the bottom of the first chain
+      dIx[r][chainColumn(r, colConnected)] = (r == (rowEnd - 1)) ? 100.f : 30.f;
+      dIx[r][chainColumn(r, colIsolated)] = 30.f;
+    }
+
+    for (int nbThread = 1; nbThread <= 4; nbThread += 3) {
+      vpCannyEdgeDetection detector(3, 1.f, 3, lowerThreshold, upperThreshold, 0.6f, 0.8f,
+                                    vpImageFilter::CANNY_GBLUR_SOBEL_FILTERING, true, nbThread);
+      // Detect twice to check that the buffers are correctly reset
+      for (unsigned int n = 0; n < 2; ++n) {
+        detector.setGradients(dIx, dIy);
+        vpImage<unsigned char> edgeMap = detector.detect(I);
+
+        bool success = true;
+        unsigned int nbEdgePoints = 0;
+        for (unsigned int r = 0; r < height; ++r) {
+          for (unsigned int c = 0; c < width; ++c) {
+            const bool isEdge = (r >= rowStart) && (r < rowEnd) && (c == chainColumn(r, colConnected));
+            success = success && ((edgeMap[r][c] == 255) == isEdge);
+            nbEdgePoints += (edgeMap[r][c] == 255) ? 1 : 0;
+          }
+        }
+        CHECK(success);
+        CHECK(nbEdgePoints == (rowEnd - rowStart));
+
+        const std::vector<vpImagePoint> &edgePoints = detector.getEdgePointsList();
+        CHECK(edgePoints.size() == nbEdgePoints);
+        CHECK(edgePoints.front() == vpImagePoint(rowStart, chainColumn(rowStart, colConnected)));
+        CHECK(detector.getFilteringAndGradientTime() >= 0.);
+        CHECK(detector.getEdgeTrackingTime() >= 0.);
+      }
+    }
+  }
+
+#if defined(VISP_HAVE_OPENMP)
+  SECTION("Number of threads")
+  {
+    const unsigned int height = 480, width = 640;
+    vpImage<unsigned char> I(height, width);
+    for (unsigned int r = 0; r < height; ++r) {
+      for (unsigned int c = 0; c < width; ++c) {
+        const double value = 128. + (60. * std::sin((r * 0.05) + (0.3 * std::sin(c * 0.02))) * std::cos(c * 0.031))
+          + (((r * 7919 + c * 104729) % 61) - 30.);
+        I[r][c] = static_cast<unsigned char>(std::max<double>(0., std::min<double>(255., value)));
+      }
+    }
+
+    vpCannyEdgeDetection detectorRef(5, 1.5f, 3, -1.f, -1.f, 0.6f, 0.8f, vpImageFilter::CANNY_GBLUR_SOBEL_FILTERING,
+                                     true, 1);
+    const vpImage<unsigned char> edgeMapRef = detectorRef.detect(I);
+    for (int nbThread = 2; nbThread <= 7; ++nbThread) {
+      vpCannyEdgeDetection detector(5, 1.5f, 3, -1.f, -1.f, 0.6f, 0.8f, vpImageFilter::CANNY_GBLUR_SOBEL_FILTERING,
+                                    true, nbThread);
+      const vpImage<unsigned char> edgeMap = detector.detect(I);
+      CHECK((edgeMap == edgeMapRef));
+      CHECK((detector.getEdgePointsList() == detectorRef.getEdgePointsList()));
+    }
+  }
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  std::cout << (numFailed ? "Test failed" : "Test succeed") << std::endl;
+  return numFailed;
+}
+
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -0,0 +1,175 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the allocation of the image bitmaps with vpImageAllocator and vpImagePool.
+ */
+/*!
+  \example catchImageAllocator.cpp
+
+  \brief Test the recycling of the image bitmaps by vpImagePool and the use of a custom vpImageAllocator.
+*/
+
+#include <iostream>
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <stdint.h>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageAllocator.h>
+
+#if defined(VISP_BUILD_CATCH2)
+#include <catch_amalgamated.hpp>
+#else // Since v3.1.1
+#include <catch2/catch_all.hpp>
+#endif
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+class vpCountingAllocator : public vpImageAllocator
+{
+public:
+  vpCountingAllocator() : m_allocated(0), m_deallocated(0), m_pool() { }
+
+  void *allocate(size_t size) VP_OVERRIDE
+  {
+    ++m_allocated;
+    return m_pool.allocate(size);
+  }
+
+  void deallocate(void *ptr, size_t size) VP_OVERRIDE
+  {
+    ++m_deallocated;
+    m_pool.deallocate(ptr, size);
+  }
+
+  unsigned int m_allocated;
+  unsigned int m_deallocated;
+  vpImagePool m_pool;
+};
+
+bool isAligned(const void *ptr) { return (reinterpret_cast<uintptr_t>(ptr) % vpImageAllocator::alignment) == 0; }
+}
+
+TEST_CASE("Size classes of the image pool", "[vpImagePool]")
+{
+  for (size_t size = 1; size < 100000; size += 7) {
+    const size_t size_class = vpImagePool::getSizeClass(size);
+    CHECK(size_class >= size);
+    CHECK(size_class % vpImageAllocator::alignment == 0);
+    // At most 25% larger than requested
+    CHECK(((size <= vpImageAllocator::alignment) || (4 * size_class <= 5 * size + 4 * vpImageAllocator::alignment)));
+  }
+  CHECK(vpImagePool::getSizeClass(640 * 480) == vpImagePool::getSizeClass(640 * 480 - 100));
+}
+
+TEST_CASE("Recycling of the image bitmaps", "[vpImagePool]")
+{
+  vpImagePool &pool = vpImagePool::getInstance();
+  pool.clear();
+  pool.resetStatistics();
+
+  {
+    vpImage<unsigned char> I(480, 640, 1);
+    CHECK(isAligned(I.bitmap));
+    CHECK(I[479][639] == 1);
+  }
+  // The bitmap and the row pointers are kept by the pool
+  CHECK(pool.getCachedBytes() > 480 * 640);
+  CHECK(pool.getMisses() == 2);
+  CHECK(pool.getHits() == 0);
+
+  for (unsigned int i = 0; i < 10; ++i) {
+    vpImage<unsigned char> I(480, 640, static_cast<unsigned char>(i));
+    CHECK(isAligned(I.bitmap));
+    CHECK(I[240][320] == i);
+  }
+  CHECK(pool.getMisses() == 2);
+  CHECK(pool.getHits() == 20);
+
+  SECTION("Resize reuses the released blocks")
+  {
+    vpImage<vpRGBa> I(100, 100);
+    CHECK(I[50][50] == vpRGBa(0, 0, 0, 0));
+    I.resize(200, 150);
+    I.resize(100, 100);
+    CHECK(pool.getHits() >= 21);
+    CHECK(isAligned(I.bitmap));
+  }
+
+  SECTION("Bounded cache")
+  {
+    pool.setMaxCachedBytes(1000);
+    CHECK(pool.getCachedBytes() <= 1000);
+    {
+      vpImage<float> I(100, 100);
+    }
+    CHECK(pool.getCachedBytes() <= 1000);
+    pool.setMaxCachedBytes(128 * 1024 * 1024);
+  }
+}
+
+TEST_CASE("Custom image allocator", "[vpImageAllocator]")
+{
+  vpCountingAllocator allocator;
+  vpImage<unsigned char> I_before(10, 10);
+  vpImageAllocator::setDefault(&allocator);
+  {
+    vpImage<double> I(20, 30, 2.);
+    CHECK(isAligned(I.bitmap));
+    CHECK(allocator.m_allocated == 2);
+    vpImage<double> I_copy = I;
+    CHECK(I_copy == I);
+    CHECK(allocator.m_allocated == 4);
+    // Blocks allocated before the change of allocator go back to their allocator
+    I_before.resize(20, 20);
+    CHECK(allocator.m_deallocated == 0);
+  }
+  vpImageAllocator::setDefault(nullptr);
+  CHECK(allocator.m_deallocated == 4);
+  I_before.destroy();
+  CHECK(allocator.m_deallocated == 6);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
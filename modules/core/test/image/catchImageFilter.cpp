@@ -0,0 +1,299 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2026 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the row-based separable filtering engine of vpImageFilter.
+ */
+/*!
+  \example catchImageFilter.cpp
+
+  \brief Compare the separable and 2D filters of vpImageFilter to per-pixel implementations.
+*/
+
+#include <iostream>
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <visp3/core/vpImageFilter.h>
+
+#if defined(VISP_BUILD_CATCH2)
+#include <catch_amalgamated.hpp>
+#else // Since v3.1.1
+#include <catch2/catch_all.hpp>
+#endif
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+template <typename Type> vpImage<Type> createImage(unsigned int height, unsigned int width)
+{
+  vpImage<Type> I(height, width);
+  for (unsigned int i = 0; i < height; ++i) {
+    for (unsigned int j = 0; j < width; ++j) {
+      I[i][j] = static_cast<Type>((i * 37 + j * 11 + ((i * j) % 23) * 7) % 256);
+    }
+  }
+  return I;
+}
+
+vpImage<bool> createMask(unsigned int height, unsigned int width)
+{
+  vpImage<bool> mask(height, width);
+  for (unsigned int i = 0; i < height; ++i) {
+    for (unsigned int j = 0; j < width; ++j) {
+      mask[i][j] = ((i + 2 * j) % 5) != 0;
+    }
+  }
+  return mask;
+}
+
+// Per-pixel separable filtering with mirrored borders, along X if alongX is true, along Y otherwise. It relies on
+// the per-pixel functions of vpImageFilter, which give the summation order of the former implementation.
+template <typename ImageType, typename OutputType, typename FilterType>
+void filterRef(const vpImage<ImageType> &I, vpImage<OutputType> &If, const FilterType *filter, unsigned int size,
+               const vpImage<bool> *p_mask, bool alongX)
+{
+  const unsigned int height = I.getHeight(), width = I.getWidth();
+  const unsigned int stop = (size - 1) / 2;
+  If.resize(height, width, static_cast<OutputType>(0));
+  for (unsigned int r = 0; r < height; ++r) {
+    for (unsigned int c = 0; c < width; ++c) {
+      if (p_mask && !(*p_mask)[r][c]) {
+        continue;
+      }
+      if (alongX) {
+        if (c < stop) {
+          vpImageFilter::filterXLeftBorder(I, If[r][c], r, c, filter, size);
+        }
+        else if (c >= width - stop) {
+          vpImageFilter::filterXRightBorder(I, If[r][c], r, c, filter, size);
+        }
+        else {
+          vpImageFilter::filterX(I, If[r][c], r, c, filter, size);
+        }
+      }
+      else {
+        if (r < stop) {
+          vpImageFilter::filterYTopBorder(I, If[r][c], r, c, filter, size);
+        }
+        else if (r >= height - stop) {
+          vpImageFilter::filterYBottomBorder(I, If[r][c], r, c, filter, size);
+        }
+        else {
+          vpImageFilter::filterY(I, If[r][c], r, c, filter, size);
+        }
+      }
+    }
+  }
+}
+
+// Per-pixel correlation or convolution restricted to the pixels fully covered by the kernel
+template <typename ImageType, typename FilterType>
+void filter2DRef(const vpImage<ImageType> &I, vpImage<FilterType> &If, const vpArray2D<FilterType> &M, bool convolve)
+{
+  const int half_y = static_cast<int>(M.getRows() / 2), half_x = static_cast<int>(M.getCols() / 2);
+  const int height = static_cast<int>(I.getHeight()), width = static_cast<int>(I.getWidth());
+  If.resize(I.getHeight(), I.getWidth(), 0);
+  for (int i = half_y; i < height - half_y; ++i) {
+    for (int j = half_x; j < width - half_x; ++j) {
+      FilterType sum = 0;
+      for (int a = 0; a < static_cast<int>(M.getRows()); ++a) {
+        for (int b = 0; b < static_cast<int>(M.getCols()); ++b) {
+          const int r = convolve ? (i + half_y - a) : (i - half_y + a);
+          const int c = convolve ? (j + half_x - b) : (j - half_x + b);
+          sum += M[a][b] * static_cast<FilterType>(I[r][c]);
+        }
+      }
+      If[i][j] = sum;
+    }
+  }
+}
+
+template <typename Type> double maxAbsDiff(const vpImage<Type> &I1, const vpImage<Type> &I2)
+{
+  REQUIRE(I1.getHeight() == I2.getHeight());
+  REQUIRE(I1.getWidth() == I2.getWidth());
+  double diff = 0;
+  for (unsigned int i = 0; i < I1.getSize(); ++i) {
+    diff = std::max(diff, std::fabs(static_cast<double>(I1.bitmap[i]) - static_cast<double>(I2.bitmap[i])));
+  }
+  return diff;
+}
+
+template <typename ImageType, typename FilterType> void checkSeparable(unsigned int height, unsigned int width)
+{
+  const vpImage<ImageType> I = createImage<ImageType>(height, width);
+  const vpImage<bool> mask = createMask(height, width);
+  const double tolerance = 0;
+
+  for (unsigned int size = 3; size <= 9; size += 2) {
+    std::vector<FilterType> filter((size + 1) / 2);
+    vpImageFilter::getGaussianKernel<FilterType>(filter.data(), size, 0, true);
+
+    for (int useMask = 0; useMask < 2; ++useMask) {
+      const vpImage<bool> *p_mask = useMask ? &mask : nullptr;
+      INFO("size: " << size << " mask: " << useMask << " image: " << height << "x" << width);
+
+      vpImage<FilterType> Ix, Ix_ref, Iy, Iy_ref, Ixy, Ixy_ref;
+      vpImageFilter::filterX(I, Ix, filter.data(), size, p_mask);
+      filterRef(I, Ix_ref, filter.data(), size, p_mask, true);
+      CHECK(maxAbsDiff(Ix, Ix_ref) <= tolerance);
+
+      vpImageFilter::filterY(I, Iy, filter.data(), size, p_mask);
+      filterRef(I, Iy_ref, filter.data(), size, p_mask, false);
+      CHECK(maxAbsDiff(Iy, Iy_ref) <= tolerance);
+
+      vpImageFilter::filter(I, Ixy, filter.data(), size, p_mask);
+      filterRef(Ix_ref, Ixy_ref, filter.data(), size, p_mask, false);
+      CHECK(maxAbsDiff(Ixy, Ixy_ref) <= tolerance);
+
+      vpImage<FilterType> GI;
+      vpImageFilter::gaussianBlur(I, GI, size, static_cast<FilterType>(0), true, p_mask);
+      CHECK(maxAbsDiff(GI, Ixy_ref) <= tolerance);
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("Separable filters", "[image_filter]")
+{
+  SECTION("unsigned char to float")
+  {
+    checkSeparable<unsigned char, float>(97, 131);
+    checkSeparable<unsigned char, float>(480, 640);
+  }
+  SECTION("unsigned char to double") { checkSeparable<unsigned char, double>(97, 131); }
+  SECTION("float to float") { checkSeparable<float, float>(97, 131); }
+  SECTION("double to double") { checkSeparable<double, double>(480, 640); }
+  SECTION("Small image")
+  {
+    // The largest kernel is as large as gaussianBlur() allows, the mirrored borders overlap
+    checkSeparable<unsigned char, float>(9, 9);
+  }
+}
+
+TEST_CASE("Gaussian blur of an unsigned char image", "[image_filter]")
+{
+  // The intermediate image is rounded to unsigned char as well
+  const vpImage<unsigned char> I = createImage<unsigned char>(240, 321);
+  const unsigned int size = 7;
+  std::vector<float> filter((size + 1) / 2);
+  vpImageFilter::getGaussianKernel<float>(filter.data(), size, 0, true);
+
+  vpImage<unsigned char> GI, GIx_ref, GI_ref;
+  vpImageFilter::gaussianBlur(I, GI, size);
+  filterRef(I, GIx_ref, filter.data(), size, nullptr, true);
+  filterRef(GIx_ref, GI_ref, filter.data(), size, nullptr, false);
+  CHECK(maxAbsDiff(GI, GI_ref) == 0);
+}
+
+TEST_CASE("Gradient filters", "[image_filter]")
+{
+  const vpImage<unsigned char> I = createImage<unsigned char>(120, 161);
+  const vpImage<bool> mask = createMask(120, 161);
+  const unsigned int size = 5;
+  const int stop = static_cast<int>((size - 1) / 2);
+  std::vector<float> filter((size + 1) / 2);
+  vpImageFilter::getGaussianDerivativeKernel<float>(filter.data(), size, 0, true);
+
+  for (int useMask = 0; useMask < 2; ++useMask) {
+    const vpImage<bool> *p_mask = useMask ? &mask : nullptr;
+    vpImage<float> dIx, dIy;
+    vpImageFilter::getGradX(I, dIx, filter.data(), size, p_mask);
+    vpImageFilter::getGradY(I, dIy, filter.data(), size, p_mask);
+
+    double diffX = 0, diffY = 0;
+    for (int r = 0; r < static_cast<int>(I.getHeight()); ++r) {
+      for (int c = 0; c < static_cast<int>(I.getWidth()); ++c) {
+        float gx = 0, gy = 0;
+        const bool computed = (p_mask == nullptr) || mask[r][c];
+        if (computed && (c >= stop) && (c < static_cast<int>(I.getWidth()) - stop)) {
+          for (int k = 1; k <= stop; ++k) {
+            gx += filter[k] * static_cast<float>(I[r][c + k] - I[r][c - k]);
+          }
+        }
+        if (computed && (r >= stop) && (r < static_cast<int>(I.getHeight()) - stop)) {
+          for (int k = 1; k <= stop; ++k) {
+            gy += filter[k] * static_cast<float>(I[r + k][c] - I[r - k][c]);
+          }
+        }
+        diffX = std::max(diffX, std::fabs(static_cast<double>(dIx[r][c] - gx)));
+        diffY = std::max(diffY, std::fabs(static_cast<double>(dIy[r][c] - gy)));
+      }
+    }
+    CHECK(diffX == 0);
+    CHECK(diffY == 0);
+  }
+}
+
+TEST_CASE("2D filters", "[image_filter]")
+{
+  const vpImage<unsigned char> I = createImage<unsigned char>(100, 133);
+  vpArray2D<double> M(3, 5);
+  for (unsigned int a = 0; a < M.getRows(); ++a) {
+    for (unsigned int b = 0; b < M.getCols(); ++b) {
+      M[a][b] = static_cast<double>(a * M.getCols() + b) - 6.5;
+    }
+  }
+
+  for (int convolve = 0; convolve < 2; ++convolve) {
+    vpImage<double> If, If_ref;
+    vpImageFilter::filter(I, If, M, convolve != 0);
+    filter2DRef(I, If_ref, M, convolve != 0);
+    CHECK(maxAbsDiff(If, If_ref) < 1e-9);
+  }
+
+  vpArray2D<double> K(5, 5);
+  for (unsigned int a = 0; a < K.getRows(); ++a) {
+    for (unsigned int b = 0; b < K.getCols(); ++b) {
+      K[a][b] = static_cast<double>(b) - 2. + 0.1 * static_cast<double>(a);
+    }
+  }
+  vpImage<double> Iu, Iv, Iu_ref, Iv_ref;
+  vpImageFilter::filter(I, Iu, Iv, K, false);
+  filter2DRef(I, Iu_ref, K, false);
+  filter2DRef(I, Iv_ref, K.t(), false);
+  CHECK(maxAbsDiff(Iu, Iu_ref) < 1e-9);
+  CHECK(maxAbsDiff(Iv, Iv_ref) < 1e-9);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -423,6 +423,81 @@ TEST_CASE("Gray image morphology", "[image_morphology]")
   }
 }
 
+TEST_CASE("Gray image morphology with rectangular structuring elements", "[image_morphology]")
+{
+  vpImage<unsigned char> I(83, 301);
+  common_tools::fill(I);
+
+  const int kernels[][2] = { { 1, 1 }, { 3, 3 }, { 5, 1 }, { 1, 7 }, { 15, 15 }, { 31, 9 }, { 3, 101 } };
+  for (size_t i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++) {
+    const int width = kernels[i][0], height = kernels[i][1];
+
+    SECTION("Erosion " + std::to_string(width) + "x" + std::to_string(height))
+    {
+      vpImage<unsigned char> I_morpho = I, I_morpho_ref = I;
+      vpImageMorphology::erosion(I_morpho, width, height);
+      common_tools::imageMorphologyRef(I_morpho_ref, width, height, true);
+      CHECK((I_morpho_ref == I_morpho));
+    }
+
+    SECTION("Dilatation " + std::to_string(width) + "x" + std::to_string(height))
+    {
+      vpImage<unsigned char> I_morpho = I, I_morpho_ref = I;
+      vpImageMorphology::dilatation(I_morpho, width, height);
+      common_tools::imageMorphologyRef(I_morpho_ref, width, height, false);
+      CHECK((I_morpho_ref == I_morpho));
+    }
+  }
+
+  SECTION("Float image")
+  {
+    vpImage<float> I_float(I.getHeight(), I.getWidth()), I_float_ref;
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      I_float.bitmap[i] = I.bitmap[i] - 127.5f;
+    }
+    I_float_ref = I_float;
+    vpImageMorphology::dilatation(I_float, 15, 3);
+
+    vpImage<unsigned char> I_morpho_ref = I;
+    common_tools::imageMorphologyRef(I_morpho_ref, 15, 3, false);
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      CHECK(I_float.bitmap[i] == I_morpho_ref.bitmap[i] - 127.5f);
+    }
+  }
+
+  SECTION("Opening, closing and top-hats")
+  {
+    const int size = 7;
+    vpImage<unsigned char> I_opening = I, I_closing = I, I_top_hat = I, I_black_hat = I;
+    vpImageMorphology::opening(I_opening, size);
+    vpImageMorphology::closing(I_closing, size);
+    vpImageMorphology::topHat(I_top_hat, size);
+    vpImageMorphology::blackHat(I_black_hat, size);
+
+    vpImage<unsigned char> I_opening_ref = I, I_closing_ref = I;
+    common_tools::imageMorphologyRef(I_opening_ref, size, size, true);
+    common_tools::imageMorphologyRef(I_opening_ref, size, size, false);
+    common_tools::imageMorphologyRef(I_closing_ref, size, size, false);
+    common_tools::imageMorphologyRef(I_closing_ref, size, size, true);
+    CHECK((I_opening_ref == I_opening));
+    CHECK((I_closing_ref == I_closing));
+
+    bool success = true;
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      success = success && (I_opening.bitmap[i] <= I.bitmap[i]) && (I.bitmap[i] <= I_closing.bitmap[i]);
+      success = success && (I_top_hat.bitmap[i] == I.bitmap[i] - I_opening.bitmap[i]);
+      success = success && (I_black_hat.bitmap[i] == I_closing.bitmap[i] - I.bitmap[i]);
+    }
+    CHECK(success);
+  }
+
+  SECTION("Even kernel size")
+  {
+    CHECK_THROWS_AS(vpImageMorphology::erosion(I, 4, 3), vpException);
+    CHECK_THROWS_AS(vpImageMorphology::dilatation(I, 3, 2), vpException);
+  }
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session;
@@ -0,0 +1,163 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2026 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test for vpImagePyramid class.
+ */
+/*!
+  \example catchImagePyramid.cpp
+
+  \brief Test vpImagePyramid functionalities.
+*/
+
+#include <iostream>
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImagePyramid.h>
+
+#if defined(VISP_BUILD_CATCH2)
+#include <catch_amalgamated.hpp>
+#else // Since v3.1.1
+#include <catch2/catch_all.hpp>
+#endif
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+vpImage<unsigned char> createImage(unsigned int height, unsigned int width)
+{
+  vpImage<unsigned char> I(height, width);
+  for (unsigned int i = 0; i < height; ++i) {
+    for (unsigned int j = 0; j < width; ++j) {
+      I[i][j] = static_cast<unsigned char>(((i * 7) + (j * 13) + ((i * j) % 17)) % 256);
+    }
+  }
+  return I;
+}
+}
+
+TEST_CASE("Gaussian levels", "[vpImagePyramid]")
+{
+  const vpImage<unsigned char> I = createImage(97, 130);
+  vpImagePyramid pyramid(I);
+
+  CHECK(pyramid.getImage() == I);
+  CHECK(&pyramid.getLevel(0) == &pyramid.getImage());
+
+  vpImage<unsigned char> expected = I;
+  for (unsigned int level = 1; level < 4; ++level) {
+    vpImage<unsigned char> next;
+    vpImageFilter::getGaussPyramidal(expected, next);
+    expected = next;
+
+    const vpImage<unsigned char> &I_level = pyramid.getLevel(level);
+    CHECK(I_level == expected);
+    CHECK(I_level.getWidth() == pyramid.getWidth(level));
+    CHECK(I_level.getHeight() == pyramid.getHeight(level));
+    // The level is computed only once
+    CHECK(&pyramid.getLevel(level) == &I_level);
+
+    vpImage<float> gradX, gradY;
+    vpImageFilter::getGradX(expected, gradX);
+    vpImageFilter::getGradY(expected, gradY);
+    CHECK(pyramid.getGradX(level) == gradX);
+    CHECK(pyramid.getGradY(level) == gradY);
+  }
+}
+
+TEST_CASE("Decimated levels", "[vpImagePyramid]")
+{
+  const vpImage<unsigned char> I = createImage(97, 130);
+  vpImagePyramid pyramid(I);
+
+  for (unsigned int level = 1; level < 4; ++level) {
+    const unsigned int scale = 1u << level;
+    const vpImage<unsigned char> &I_level = pyramid.getDecimatedLevel(level);
+    REQUIRE(I_level.getHeight() == (I.getHeight() / scale));
+    REQUIRE(I_level.getWidth() == (I.getWidth() / scale));
+    bool equal = true;
+    for (unsigned int i = 0; i < I_level.getHeight(); ++i) {
+      for (unsigned int j = 0; j < I_level.getWidth(); ++j) {
+        equal = equal && (I_level[i][j] == I[i * scale][j * scale]);
+      }
+    }
+    CHECK(equal);
+  }
+}
+
+TEST_CASE("Copy, swap and init", "[vpImagePyramid]")
+{
+  const vpImage<unsigned char> I1 = createImage(64, 80);
+  const vpImage<unsigned char> I2 = createImage(40, 50);
+  vpImagePyramid pyramid1(I1), pyramid2(I2);
+  const vpImage<unsigned char> I1_level = pyramid1.getLevel(2);
+  const vpImage<unsigned char> I2_level = pyramid2.getLevel(2);
+
+  vpImagePyramid copy(pyramid1);
+  CHECK(copy.getImage() == I1);
+  CHECK(copy.getLevel(2) == I1_level);
+  // The images are shared by the copy, which is not affected when the pyramid is initialized again
+  CHECK(&copy.getImage() == &pyramid1.getImage());
+  CHECK(&copy.getLevel(2) == &pyramid1.getLevel(2));
+  vpImagePyramid other(pyramid2);
+  other.init(I1);
+  CHECK(other.getLevel(2) == I1_level);
+  CHECK(pyramid2.getImage() == I2);
+  CHECK(pyramid2.getLevel(2) == I2_level);
+
+  pyramid1.swap(pyramid2);
+  CHECK(pyramid1.getImage() == I2);
+  CHECK(pyramid1.getLevel(2) == I2_level);
+  CHECK(pyramid2.getImage() == I1);
+  CHECK(pyramid2.getLevel(2) == I1_level);
+
+  pyramid2.init(I2);
+  CHECK(pyramid2.getLevel(2) == I2_level);
+
+  CHECK_THROWS_AS(pyramid2.getLevel(6), vpException);
+  pyramid2.clear();
+  CHECK_THROWS_AS(pyramid2.getLevel(0), vpException);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
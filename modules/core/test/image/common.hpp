@@ -532,6 +532,29 @@ void imageDilatationRef(vpImage<unsigned char> &I,
   }
 }
 
+// Min (erosion) or max (dilatation) over a width x height window, pixels outside the image being ignored
+void imageMorphologyRef(vpImage<unsigned char> &I, int width, int height, bool erosion)
+{
+  const vpImage<unsigned char> J = I;
+  const int rows = static_cast<int>(I.getHeight());
+  const int cols = static_cast<int>(I.getWidth());
+
+  for (int r = 0; r < rows; r++) {
+    for (int c = 0; c < cols; c++) {
+      unsigned char value = J[r][c];
+      for (int dr = -height / 2; dr <= height / 2; dr++) {
+        for (int dc = -width / 2; dc <= width / 2; dc++) {
+          if (r + dr >= 0 && r + dr < rows && c + dc >= 0 && c + dc < cols) {
+            value = erosion ? std::min<unsigned char>(value, J[r + dr][c + dc])
+                            : std::max<unsigned char>(value, J[r + dr][c + dc]);
+          }
+        }
+      }
+      I[r][c] = value;
+    }
+  }
+}
+
 void magicSquare(vpImage<unsigned char> &magic_square, int N)
 {
   magic_square.resize(static_cast<unsigned int>(N), static_cast<unsigned int>(N), 0);
@@ -40,6 +40,7 @@
 
 #if defined(VISP_HAVE_CATCH2)
 #include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpMatrix.h>
 
 #if defined(VISP_BUILD_CATCH2)
 #include <catch_amalgamated.hpp>
@@ -63,6 +64,21 @@ bool test_matrix_equal(const vpHomogeneousMatrix &M1, const vpHomogeneousMatrix
   return true;
 }
 
+bool test_matrix_equal(const vpMatrix &M1, const vpMatrix &M2, double epsilon = 1e-10)
+{
+  if ((M1.getRows() != M2.getRows()) || (M1.getCols() != M2.getCols())) {
+    return false;
+  }
+  for (unsigned int i = 0; i < M1.getRows(); i++) {
+    for (unsigned int j = 0; j < M1.getCols(); j++) {
+      if (!vpMath::equal(M1[i][j], M2[i][j], epsilon)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 TEST_CASE("vpHomogeneousMatrix re-orthogonalize rotation matrix", "[vpHomogeneousMatrix]")
 {
   CHECK_NOTHROW([]() {
@@ -228,6 +244,76 @@ TEST_CASE("vpHomogenousMatrix * vpRotationMatrix", "[operator*]")
   CHECK(success);
 }
 
+TEST_CASE("vpHomogeneousMatrix product and inverse", "[operator*]")
+{
+  vpHomogeneousMatrix a_M_b(0.1, -0.2, 0.5, vpMath::rad(10), vpMath::rad(-25), vpMath::rad(40));
+  vpHomogeneousMatrix b_M_c(-0.3, 0.05, 1.2, vpMath::rad(-60), vpMath::rad(5), vpMath::rad(15));
+
+  // Compare with the generic matrix product
+  vpMatrix a_M_c_truth = static_cast<vpMatrix>(a_M_b) * static_cast<vpMatrix>(b_M_c);
+  CHECK(test_matrix_equal(static_cast<vpMatrix>(a_M_b * b_M_c), a_M_c_truth));
+
+#if defined(VISP_HAVE_LAPACK) || defined(VISP_HAVE_EIGEN3) || defined(VISP_HAVE_OPENCV)
+  vpMatrix b_M_a_truth = static_cast<vpMatrix>(a_M_b).inverseByLU();
+  CHECK(test_matrix_equal(static_cast<vpMatrix>(a_M_b.inverse()), b_M_a_truth));
+#endif
+  CHECK(test_matrix_equal(a_M_b * a_M_b.inverse(), vpHomogeneousMatrix()));
+}
+
+TEST_CASE("vpHomogeneousMatrix fixed size storage", "[vpHomogeneousMatrix]")
+{
+  vpHomogeneousMatrix M(0.1, -0.2, 0.5, vpMath::rad(10), vpMath::rad(-25), vpMath::rad(40));
+  CHECK(M.getRows() == 4);
+  CHECK(M.getCols() == 4);
+  CHECK(M.size() == 16);
+
+  // A copy owns its own elements
+  vpHomogeneousMatrix M_copy(M);
+  CHECK(M_copy.data != M.data);
+  CHECK(test_matrix_equal(M_copy, M));
+  M_copy[0][3] = 2.;
+  CHECK(vpMath::equal(M[0][3], 0.1));
+
+  // Moving a matrix copies its elements
+  std::vector<vpHomogeneousMatrix> vec_M(3, M);
+  vec_M.push_back(std::move(M_copy));
+  vec_M.insert(vec_M.begin(), M);
+  for (size_t i = 0; i < vec_M.size(); ++i) {
+    CHECK(vec_M[i][0] == vec_M[i].data);
+    CHECK(vec_M[i][3] == vec_M[i].data + 12);
+  }
+  CHECK(vpMath::equal(vec_M.back()[0][3], 2.));
+
+  // Conversion to a dynamic size array
+  vpArray2D<double> A(M);
+  CHECK(A.data != M.data);
+  CHECK(A == static_cast<vpArray2D<double> >(M));
+
+  CHECK_THROWS(M.vpArray2D<double>::resize(3, 3));
+
+  // Moving through a dynamic size array reference cannot take over the inline storage
+  const vpHomogeneousMatrix M_ref(M);
+  {
+    vpHomogeneousMatrix M_tmp(M);
+    vpArray2D<double> A_moved(std::move(static_cast<vpArray2D<double> &>(M_tmp)));
+    CHECK(A_moved == static_cast<vpArray2D<double> >(M_ref));
+    CHECK(M_tmp.data == M_tmp[0]);
+    M_tmp[0][3] = 3.;
+    CHECK(vpMath::equal(A_moved[0][3], 0.1));
+
+    vpArray2D<double> A_assigned;
+    A_assigned = std::move(static_cast<vpArray2D<double> &>(M_tmp));
+    CHECK(A_assigned.data != M_tmp.data);
+    CHECK(vpMath::equal(A_assigned[0][3], 3.));
+  }
+  vpArray2D<double> A_src(static_cast<vpArray2D<double> >(M_ref));
+  vpHomogeneousMatrix M_dst;
+  static_cast<vpArray2D<double> &>(M_dst) = std::move(A_src);
+  CHECK(M_dst.data == M_dst[0]);
+  CHECK(M_dst.data != A_src.data);
+  CHECK(test_matrix_equal(M_dst, M_ref));
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session;
@@ -45,6 +45,8 @@
 #include <catch2/catch_all.hpp>
 #endif
 
+#include <limits>
+
 #include <visp3/core/vpMatrix.h>
 
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x030000)
@@ -201,6 +203,20 @@ vpColVector dgemv_regular(const vpMatrix &A, const vpColVector &v)
   return w;
 }
 
+// Disable Blas/Lapack during its lifetime to run the ViSP built-in code instead
+class BuiltinCodeGuard
+{
+public:
+  BuiltinCodeGuard() : m_lapackMinSize(vpMatrix::getLapackMatrixMinSize())
+  {
+    vpMatrix::setLapackMatrixMinSize(std::numeric_limits<unsigned int>::max());
+  }
+  ~BuiltinCodeGuard() { vpMatrix::setLapackMatrixMinSize(m_lapackMinSize); }
+
+private:
+  unsigned int m_lapackMinSize;
+};
+
 bool equalMatrix(const vpMatrix &A, const vpMatrix &B, double tol = 1e-9)
 {
   if (A.getRows() != B.getRows() || A.getCols() != B.getCols()) {
@@ -248,6 +264,20 @@ TEST_CASE("Benchmark matrix-matrix multiplication", "[benchmark]")
       };
       REQUIRE(equalMatrix(C, C_true));
 
+      vpMatrix C_builtin;
+      {
+        BuiltinCodeGuard builtin;
+        oss.str("");
+        oss << "(" << A.getRows() << "x" << A.getCols() << ")x(" << B.getRows() << "x" << B.getCols()
+          << ") - ViSP built-in";
+        BENCHMARK(oss.str().c_str())
+        {
+          C_builtin = A * B;
+          return C_builtin;
+        };
+      }
+      REQUIRE(equalMatrix(C_builtin, C_true));
+
       if (runBenchmarkAll) {
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x030000)
         cv::Mat matA(sz.first, sz.second, CV_64FC1);
@@ -301,6 +331,10 @@ TEST_CASE("Benchmark matrix-matrix multiplication", "[benchmark]")
     vpMatrix C_true = dgemm_regular(A, B);
     vpMatrix C = A * B;
     REQUIRE(equalMatrix(C, C_true));
+
+    BuiltinCodeGuard builtin;
+    C = A * B;
+    REQUIRE(equalMatrix(C, C_true));
   }
 }
 
@@ -614,6 +648,20 @@ TEST_CASE("Benchmark matrix-vector multiplication", "[benchmark]")
       };
       REQUIRE(equalMatrix(static_cast<vpMatrix>(C), static_cast<vpMatrix>(C_true)));
 
+      vpColVector C_builtin;
+      {
+        BuiltinCodeGuard builtin;
+        oss.str("");
+        oss << "(" << A.getRows() << "x" << A.getCols() << ")x(" << B.getRows() << "x" << B.getCols()
+          << ") - ViSP built-in";
+        BENCHMARK(oss.str().c_str())
+        {
+          C_builtin = A * B;
+          return C_builtin;
+        };
+      }
+      REQUIRE(equalMatrix(static_cast<vpMatrix>(C_builtin), static_cast<vpMatrix>(C_true)));
+
       if (runBenchmarkAll) {
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x030000)
         cv::Mat matA(sz.first, sz.second, CV_64FC1);
@@ -671,6 +719,10 @@ TEST_CASE("Benchmark matrix-vector multiplication", "[benchmark]")
     vpColVector C_true = dgemv_regular(A, B);
     vpColVector C = A * B;
     REQUIRE(equalMatrix(static_cast<vpMatrix>(C), static_cast<vpMatrix>(C_true)));
+
+    BuiltinCodeGuard builtin;
+    C = A * B;
+    REQUIRE(equalMatrix(static_cast<vpMatrix>(C), static_cast<vpMatrix>(C_true)));
   }
 }
 
@@ -1022,7 +1074,7 @@ int main(int argc, char *argv[])
   std::cout << "Default matrix/vector min size to enable Blas/Lapack optimization: " << lapackMinSize << std::endl;
 
   auto cli = session.cli()
-    | Catch::Clara::Opt(runBenchmark)["--benchmark"]("run benchmark comparing naive code with ViSP implementation")
+    | Catch::Clara::Opt(runBenchmark)["--benchmark"]("run benchmark comparing naive code with ViSP built-in and Blas/Lapack implementations")
     | Catch::Clara::Opt(runBenchmarkAll)["--benchmark-all"]("run benchmark comparing naive code with ViSP, OpenCV, Eigen implementation")
     | Catch::Clara::Opt(lapackMinSize, "min size")["--lapack-min-size"]("matrix/vector min size to enable blas/lapack usage");
 
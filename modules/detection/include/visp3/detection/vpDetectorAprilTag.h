@@ -255,6 +255,21 @@ BEGIN_VISP_NAMESPACE
  *   Pose: 0.08951250829  0.02243780207  0.306540622  1.998073197  2.061488008  -0.8699567948
  * \endcode
  *
+ * When the same tags are observed in a video stream, setAprilTagRoiTracking() enables a tracking mode where
+ * the quad detection runs only in padded regions of interest around the tag locations predicted from the previous
+ * detections, or from predicted poses given with setAprilTagRoiPrediction(). A full-frame search is performed when
+ * a tag is lost and at a configurable interval; getLastDetectionPath() indicates which search ran.
+ * \code
+ * vpDetectorAprilTag detector(vpDetectorAprilTag::TAG_36h11);
+ * detector.setAprilTagRoiTracking(true);
+ * while (grab(I)) {
+ *   detector.detect(I, tagSize, cam, cMo_vec);
+ *   if (detector.getLastDetectionPath() == vpDetectorAprilTag::FULL_FRAME_DETECTION) {
+ *     std::cout << "Full-frame detection" << std::endl;
+ *   }
+ * }
+ * \endcode
+ *
  * <h2 id="header-details" class="groupheader">Tutorials & Examples</h2>
  *
  * <b>Tutorials</b><br>
@@ -366,6 +381,15 @@ public:
     POSE_COUNT                       /*!< Number of methods; used to stop iterating when parsing from/to string. */
   };
 
+  /*!
+   * Image area searched by the last call to detect(), see setAprilTagRoiTracking().
+   */
+  enum vpDetectionPath
+  {
+    FULL_FRAME_DETECTION, /*!< The whole image has been searched for tags. */
+    ROI_DETECTION         /*!< Only the regions of interest around the predicted tag locations have been searched. */
+  };
+
   /**
    * @brief Cast a \b vpDetectorAprilTag::vpAprilTagFamily enum value into a \b std::stirng.
    *
@@ -453,6 +477,7 @@ public:
   }
 
   int getAprilTagHammingDistanceThreshold() const;
+  vpDetectionPath getLastDetectionPath() const;
   bool getPose(size_t tagIndex, double tagSize, const vpCameraParameters &cam, vpHomogeneousMatrix &cMo,
                vpHomogeneousMatrix *cMo2 = nullptr, double *projError = nullptr, double *projError2 = nullptr);
 
@@ -469,6 +494,7 @@ public:
   std::vector<std::vector<vpPoint> > getTagsPoints3D(const std::vector<int> &tagsId,
                                                      const std::map<int, double> &tagsSize) const;
 
+  bool isAprilTagRoiTracking() const;
   bool isZAlignedWithCameraAxis() const;
 
   void loadConfigFile(const std::string &configFile);
@@ -483,6 +509,9 @@ public:
   void setAprilTagQuadDecimate(float quadDecimate);
   void setAprilTagQuadSigma(float quadSigma);
   void setAprilTagRefineEdges(bool refineEdges);
+  void setAprilTagRoiPrediction(const std::vector<int> &tagsId, const std::vector<vpHomogeneousMatrix> &cMo_vec,
+                                double tagSize, const vpCameraParameters &cam);
+  void setAprilTagRoiTracking(bool enable, double roiMarginRatio = 0.5, unsigned int fullFrameInterval = 30);
 
 
   /*! Allow to enable the display of overlay tag information in the windows
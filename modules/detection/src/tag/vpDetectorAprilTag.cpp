@@ -78,6 +78,7 @@ extern "C" {
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMeterPixelConversion.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/detection/vpDetectorAprilTag.h>
@@ -341,7 +342,9 @@ public:
   Impl(const vpAprilTagFamily &tagFamily, const vpPoseEstimationMethod &method)
     : m_poseEstimationMethod(method), m_tagsId(), m_tagFamily(tagFamily), m_tagsDecisionMargin(),
     m_tagsHammingDistance(), m_td(nullptr), m_tf(nullptr),
-    m_detections(nullptr), m_decisionMarginThreshold(-1), m_hammingDistanceThreshold(2), m_zAlignedWithCameraFrame(false)
+    m_detections(nullptr), m_decisionMarginThreshold(-1), m_hammingDistanceThreshold(2), m_zAlignedWithCameraFrame(false),
+    m_roiTracking(false), m_roiMarginRatio(0.5), m_roiFullFrameInterval(30), m_nbConsecutiveRoiDetections(0),
+    m_lastDetectionPath(FULL_FRAME_DETECTION), m_trackedTagsId(), m_trackedTagsCorners(), m_predictedTagsCorners()
   {
     switch (m_tagFamily) {
     case TAG_36h10:
@@ -485,7 +488,11 @@ public:
     : m_poseEstimationMethod(o.m_poseEstimationMethod), m_tagsId(o.m_tagsId), m_tagFamily(o.m_tagFamily),
     m_tagsDecisionMargin(o.m_tagsDecisionMargin), m_tagsHammingDistance(o.m_tagsHammingDistance), m_td(nullptr),
     m_tf(nullptr), m_detections(nullptr), m_decisionMarginThreshold(o.m_decisionMarginThreshold),
-    m_hammingDistanceThreshold(o.m_hammingDistanceThreshold), m_zAlignedWithCameraFrame(o.m_zAlignedWithCameraFrame)
+    m_hammingDistanceThreshold(o.m_hammingDistanceThreshold), m_zAlignedWithCameraFrame(o.m_zAlignedWithCameraFrame),
+    m_roiTracking(o.m_roiTracking), m_roiMarginRatio(o.m_roiMarginRatio), m_roiFullFrameInterval(o.m_roiFullFrameInterval),
+    m_nbConsecutiveRoiDetections(o.m_nbConsecutiveRoiDetections), m_lastDetectionPath(o.m_lastDetectionPath),
+    m_trackedTagsId(o.m_trackedTagsId), m_trackedTagsCorners(o.m_trackedTagsCorners),
+    m_predictedTagsCorners(o.m_predictedTagsCorners)
   {
     switch (m_tagFamily) {
     case TAG_36h10:
@@ -803,7 +810,25 @@ public:
       m_detections = nullptr;
     }
 
-    m_detections = apriltag_detector_detect(m_td, &im);
+    bool roiDetection = m_roiTracking && (!m_predictedTagsCorners.empty()) &&
+      ((m_roiFullFrameInterval == 0) || (m_nbConsecutiveRoiDetections < m_roiFullFrameInterval));
+    if (roiDetection) {
+      roiDetection = detectInRois(I);
+      if (!roiDetection) {
+        // A predicted tag has been lost, fall back to a full-frame search
+        apriltag_detections_destroy(m_detections);
+        m_detections = nullptr;
+      }
+    }
+    if (roiDetection) {
+      ++m_nbConsecutiveRoiDetections;
+      m_lastDetectionPath = ROI_DETECTION;
+    }
+    else {
+      m_detections = apriltag_detector_detect(m_td, &im);
+      m_nbConsecutiveRoiDetections = 0;
+      m_lastDetectionPath = FULL_FRAME_DETECTION;
+    }
     int nb_detections = zarray_size(m_detections);
     bool detected = nb_detections > 0;
 
@@ -819,12 +844,7 @@ public:
       apriltag_detection_t *det;
       zarray_get(m_detections, i, &det);
 
-      if (m_decisionMarginThreshold > 0) {
-        if (det->decision_margin < m_decisionMarginThreshold) {
-          continue;
-        }
-      }
-      if (det->hamming > m_hammingDistanceThreshold) {
+      if (!isDetectionKept(det)) {
         continue;
       }
 
@@ -878,9 +898,151 @@ public:
       }
     }
 
+    if (m_roiTracking) {
+      updateRoiTracking(polygons);
+    }
+
     return detected;
   }
 
+  /*!
+   * Search the tags only in regions of interest around their predicted locations. The predicted quads bounding boxes
+   * are padded by m_roiMarginRatio times their size, and overlapping regions are merged so that a tag cannot be
+   * detected twice. The detections are expressed in the full image and stored in m_detections.
+   *
+   * \return false when less tags than predicted are found, true otherwise.
+   */
+  bool detectInRois(const vpImage<unsigned char> &I)
+  {
+    const int width = static_cast<int>(I.getWidth()), height = static_cast<int>(I.getHeight());
+    const double minPadding = 8.0;
+
+    // Padded bounding boxes of the predicted quads, as [u_min, v_min, u_max, v_max]
+    std::vector<std::vector<int> > rois;
+    size_t nb_predictions = m_predictedTagsCorners.size();
+    for (size_t i = 0; i < nb_predictions; ++i) {
+      const std::vector<vpImagePoint> &corners = m_predictedTagsCorners[i];
+      double u_min = corners[0].get_u(), u_max = u_min, v_min = corners[0].get_v(), v_max = v_min;
+      for (size_t j = 1; j < corners.size(); ++j) {
+        u_min = std::min<double>(u_min, corners[j].get_u());
+        u_max = std::max<double>(u_max, corners[j].get_u());
+        v_min = std::min<double>(v_min, corners[j].get_v());
+        v_max = std::max<double>(v_max, corners[j].get_v());
+      }
+      const double padding = (m_roiMarginRatio * std::max<double>(u_max - u_min, v_max - v_min)) + minPadding;
+      std::vector<int> roi(4);
+      roi[0] = std::max<int>(vpMath::round(u_min - padding), 0);
+      roi[1] = std::max<int>(vpMath::round(v_min - padding), 0);
+      roi[2] = std::min<int>(vpMath::round(u_max + padding), width - 1);
+      roi[3] = std::min<int>(vpMath::round(v_max + padding), height - 1);
+      if ((roi[0] < roi[2]) && (roi[1] < roi[3])) {
+        rois.push_back(roi);
+      }
+    }
+
+    bool merged = true;
+    while (merged) {
+      merged = false;
+      for (size_t i = 0; (i < rois.size()) && (!merged); ++i) {
+        for (size_t j = i + 1; (j < rois.size()) && (!merged); ++j) {
+          if ((rois[i][0] <= rois[j][2]) && (rois[j][0] <= rois[i][2]) && (rois[i][1] <= rois[j][3]) &&
+              (rois[j][1] <= rois[i][3])) {
+            rois[i][0] = std::min<int>(rois[i][0], rois[j][0]);
+            rois[i][1] = std::min<int>(rois[i][1], rois[j][1]);
+            rois[i][2] = std::max<int>(rois[i][2], rois[j][2]);
+            rois[i][3] = std::max<int>(rois[i][3], rois[j][3]);
+            rois.erase(rois.begin() + static_cast<std::ptrdiff_t>(j));
+            merged = true;
+          }
+        }
+      }
+    }
+
+    m_detections = zarray_create(sizeof(apriltag_detection_t *));
+    size_t nb_kept = 0;
+    size_t nb_rois = rois.size();
+    for (size_t i = 0; i < nb_rois; ++i) {
+      const int u0 = rois[i][0], v0 = rois[i][1];
+      // The region of interest shares the image buffer through the stride
+      image_u8_t im = {/*.width =*/rois[i][2] - u0 + 1,
+        /*.height =*/rois[i][3] - v0 + 1,
+        /*.stride =*/width,
+        /*.buf =*/I.bitmap + ((v0 * width) + u0) };
+      zarray_t *roi_detections = apriltag_detector_detect(m_td, &im);
+
+      int nb_roi_detections = zarray_size(roi_detections);
+      for (int j = 0; j < nb_roi_detections; ++j) {
+        apriltag_detection_t *det;
+        zarray_get(roi_detections, j, &det);
+
+        // Express the detection in the full image
+        const int nbCorners = 4;
+        for (int k = 0; k < nbCorners; ++k) {
+          det->p[k][0] += u0;
+          det->p[k][1] += v0;
+        }
+        det->c[0] += u0;
+        det->c[1] += v0;
+        const int nbCols = 3;
+        for (int k = 0; k < nbCols; ++k) {
+          MATD_EL(det->H, 0, k) += u0 * MATD_EL(det->H, 2, k);
+          MATD_EL(det->H, 1, k) += v0 * MATD_EL(det->H, 2, k);
+        }
+
+        if (isDetectionKept(det)) {
+          ++nb_kept;
+        }
+        zarray_add(m_detections, &det);
+      }
+      // Detections are now owned by m_detections
+      zarray_destroy(roi_detections);
+    }
+
+    return nb_kept >= nb_predictions;
+  }
+
+  bool isDetectionKept(const apriltag_detection_t *det) const
+  {
+    if ((m_decisionMarginThreshold > 0) && (det->decision_margin < m_decisionMarginThreshold)) {
+      return false;
+    }
+    return (det->hamming <= m_hammingDistanceThreshold);
+  }
+
+  /*!
+   * Predict the tags location in the next image, assuming a constant image motion of the corners of the tags
+   * that were already detected in the previous image.
+   */
+  void updateRoiTracking(const std::vector<std::vector<vpImagePoint> > &polygons)
+  {
+    size_t nb_tags = polygons.size();
+    m_predictedTagsCorners = polygons;
+    for (size_t i = 0; i < nb_tags; ++i) {
+      const vpImagePoint cog = (polygons[i][0] + polygons[i][2]) / 2.0;
+      double min_dist = vpImagePoint::distance(polygons[i][0], polygons[i][2]);
+      size_t matched = m_trackedTagsId.size();
+      size_t nb_tracked = m_trackedTagsId.size();
+      for (size_t j = 0; j < nb_tracked; ++j) {
+        if (m_trackedTagsId[j] == m_tagsId[i]) {
+          const vpImagePoint tracked_cog = (m_trackedTagsCorners[j][0] + m_trackedTagsCorners[j][2]) / 2.0;
+          const double dist = vpImagePoint::distance(cog, tracked_cog);
+          if (dist < min_dist) {
+            min_dist = dist;
+            matched = j;
+          }
+        }
+      }
+      if (matched < nb_tracked) {
+        size_t nb_corners = polygons[i].size();
+        for (size_t k = 0; k < nb_corners; ++k) {
+          m_predictedTagsCorners[i][k] += polygons[i][k] - m_trackedTagsCorners[matched][k];
+        }
+      }
+    }
+    m_trackedTagsId = m_tagsId;
+    m_trackedTagsCorners = polygons;
+  }
+
   void displayFrames(const vpImage<unsigned char> &I, const std::vector<vpHomogeneousMatrix> &cMo_vec,
                      const vpCameraParameters &cam, double size, const vpColor &color, unsigned int thickness) const
   {
@@ -1319,6 +1481,32 @@ public:
 
   bool getZAlignedWithCameraAxis() const { return m_zAlignedWithCameraFrame; }
 
+  vpDetectionPath getLastDetectionPath() const { return m_lastDetectionPath; }
+
+  void getRoiTrackingParameters(double &roiMarginRatio, unsigned int &fullFrameInterval) const
+  {
+    roiMarginRatio = m_roiMarginRatio;
+    fullFrameInterval = m_roiFullFrameInterval;
+  }
+
+  bool isRoiTracking() const { return m_roiTracking; }
+
+  void setRoiPrediction(const std::vector<std::vector<vpImagePoint> > &predictedCorners)
+  {
+    m_predictedTagsCorners = predictedCorners;
+  }
+
+  void setRoiTracking(bool enable, double roiMarginRatio, unsigned int fullFrameInterval)
+  {
+    m_roiTracking = enable;
+    m_roiMarginRatio = roiMarginRatio;
+    m_roiFullFrameInterval = fullFrameInterval;
+    m_nbConsecutiveRoiDetections = 0;
+    m_trackedTagsId.clear();
+    m_trackedTagsCorners.clear();
+    m_predictedTagsCorners.clear();
+  }
+
   std::vector<float> getTagsDecisionMargin() const { return m_tagsDecisionMargin; }
 
   std::vector<int> getTagsHammingDistance() const { return m_tagsHammingDistance; }
@@ -1409,6 +1597,14 @@ protected:
   float m_decisionMarginThreshold;
   int m_hammingDistanceThreshold;
   bool m_zAlignedWithCameraFrame;
+  bool m_roiTracking;
+  double m_roiMarginRatio;
+  unsigned int m_roiFullFrameInterval;
+  unsigned int m_nbConsecutiveRoiDetections;
+  vpDetectionPath m_lastDetectionPath;
+  std::vector<int> m_trackedTagsId;
+  std::vector<std::vector<vpImagePoint> > m_trackedTagsCorners;
+  std::vector<std::vector<vpImagePoint> > m_predictedTagsCorners;
 };
 
 namespace
@@ -1668,6 +1864,14 @@ void to_json(nlohmann::json &j, const vpDetectorAprilTag &detector)
   displayTagParams["color"] = vpColor::colorToString(detector.m_displayTagColor);
   displayTagParams["thickness"] = detector.m_displayTagThickness;
   j["display_tag"] = displayTagParams;
+  double roiMarginRatio = 0.5;
+  unsigned int roiFullFrameInterval = 30;
+  detector.m_impl->getRoiTrackingParameters(roiMarginRatio, roiFullFrameInterval);
+  nlohmann::json roiTrackingParams;
+  roiTrackingParams["status"] = detector.isAprilTagRoiTracking();
+  roiTrackingParams["margin_ratio"] = roiMarginRatio;
+  roiTrackingParams["full_frame_interval"] = roiFullFrameInterval;
+  j["roi_tracking"] = roiTrackingParams;
   j["timeout"] = detector.m_timeout_ms;
   j["z_aligned_with_camera_axis"] = zAxis;
 }
@@ -1713,6 +1917,15 @@ void from_json(const nlohmann::json &j, vpDetectorAprilTag &detector)
     auto thickness = displayTagParams.value("thickness", detector.m_displayTagThickness);
     detector.setDisplayTag(displayTag, color, thickness);
   }
+  if (j.contains("roi_tracking")) {
+    nlohmann::json roiTrackingParams = j.at("roi_tracking");
+    double roiMarginRatio = 0.5;
+    unsigned int roiFullFrameInterval = 30;
+    detector.m_impl->getRoiTrackingParameters(roiMarginRatio, roiFullFrameInterval);
+    detector.setAprilTagRoiTracking(roiTrackingParams.value("status", detector.isAprilTagRoiTracking()),
+                                    roiTrackingParams.value("margin_ratio", roiMarginRatio),
+                                    roiTrackingParams.value("full_frame_interval", roiFullFrameInterval));
+  }
   detector.setTimeout(j.value("timeout", detector.m_timeout_ms));
   detector.setZAlignedWithCameraAxis(j.value("z_aligned_with_camera_axis", zAxis));
 }
@@ -1997,6 +2210,17 @@ int vpDetectorAprilTag::getAprilTagHammingDistanceThreshold() const
   return m_impl->getAprilTagHammingDistanceThreshold();
 }
 
+/*!
+  Return the image area searched by the last call to detect(): the whole image, or only the regions of interest
+  around the predicted tag locations when the ROI tracking mode is enabled.
+
+  \sa setAprilTagRoiTracking()
+*/
+vpDetectorAprilTag::vpDetectionPath vpDetectorAprilTag::getLastDetectionPath() const
+{
+  return m_impl->getLastDetectionPath();
+}
+
 /*!
   Return the corners coordinates for the detected tags.
 
@@ -2168,6 +2392,10 @@ void vpDetectorAprilTag::setAprilTagFamily(const vpAprilTagFamily &tagFamily)
   bool refineEdges = true;
   m_impl->getRefineEdges(refineEdges);
   bool zAxis = m_impl->getZAlignedWithCameraAxis();
+  bool roiTracking = m_impl->isRoiTracking();
+  double roiMarginRatio = 0.5;
+  unsigned int roiFullFrameInterval = 30;
+  m_impl->getRoiTrackingParameters(roiMarginRatio, roiFullFrameInterval);
 
   delete m_impl;
   m_tagFamily = tagFamily;
@@ -2178,6 +2406,7 @@ void vpDetectorAprilTag::setAprilTagFamily(const vpAprilTagFamily &tagFamily)
   m_impl->setQuadSigma(quadSigma);
   m_impl->setRefineEdges(refineEdges);
   m_impl->setZAlignedWithCameraAxis(zAxis);
+  m_impl->setRoiTracking(roiTracking, roiMarginRatio, roiFullFrameInterval);
 }
 
 /*!
@@ -2257,6 +2486,72 @@ void vpDetectorAprilTag::setAprilTagRefineDecode(bool refineDecode)
 */
 void vpDetectorAprilTag::setAprilTagRefineEdges(bool refineEdges) { m_impl->setRefineEdges(refineEdges); }
 
+/*!
+  Set the tag locations used by the ROI tracking mode for the next call to detect(), from predicted tag poses,
+  for example obtained by integrating the motion of the camera since the last detection. This replaces the
+  prediction computed from the image motion of the previously detected tags.
+
+  \param tagsId : Id of the tags, as returned by getTagsId().
+  \param cMo_vec : Predicted pose of each tag, expressed with the same tag frame convention as the poses
+  returned by detect(), see setZAlignedWithCameraAxis().
+  \param tagSize : Tag size in meter, see detect().
+  \param cam : Camera intrinsic parameters.
+
+  \sa setAprilTagRoiTracking()
+*/
+void vpDetectorAprilTag::setAprilTagRoiPrediction(const std::vector<int> &tagsId,
+                                                  const std::vector<vpHomogeneousMatrix> &cMo_vec, double tagSize,
+                                                  const vpCameraParameters &cam)
+{
+  if (tagsId.size() != cMo_vec.size()) {
+    throw(vpException(vpException::dimensionError, "The number of tags id (%d) and tags pose (%d) differ",
+                      static_cast<int>(tagsId.size()), static_cast<int>(cMo_vec.size())));
+  }
+
+  std::map<int, double> tagsSize;
+  tagsSize[-1] = tagSize;
+  std::vector<std::vector<vpPoint> > tagsPoints3D = getTagsPoints3D(tagsId, tagsSize);
+  std::vector<std::vector<vpImagePoint> > predictedCorners;
+  size_t nb_tags = tagsPoints3D.size();
+  for (size_t i = 0; i < nb_tags; ++i) {
+    std::vector<vpImagePoint> corners;
+    bool inFront = true;
+    size_t nb_points = tagsPoints3D[i].size();
+    for (size_t j = 0; j < nb_points; ++j) {
+      vpPoint &pt = tagsPoints3D[i][j];
+      pt.project(cMo_vec[i]);
+      inFront = inFront && (pt.get_Z() > 0);
+      vpImagePoint ip;
+      vpMeterPixelConversion::convertPoint(cam, pt.get_x(), pt.get_y(), ip);
+      corners.push_back(ip);
+    }
+    if (inFront) {
+      predictedCorners.push_back(corners);
+    }
+  }
+  m_impl->setRoiPrediction(predictedCorners);
+}
+
+/*!
+  Enable or disable the ROI tracking mode, dedicated to the detection of the same tags in a video stream.
+
+  Once tags have been detected, the next call to detect() runs the AprilTag quad detection only inside
+  regions of interest (ROI) around the tag locations, predicted assuming a constant image motion of their
+  corners, or given by setAprilTagRoiPrediction(). The search falls back to the whole image when less tags than
+  predicted are found, when no tag is tracked, and every \e fullFrameInterval frames so that new tags are
+  detected. Use getLastDetectionPath() to know which search has been performed.
+
+  \param enable : When true, enable the ROI tracking mode. The tracked tags are forgotten in all cases.
+  \param roiMarginRatio : Padding added on each side of the bounding box of a predicted tag, expressed as a ratio
+  of its largest side.
+  \param fullFrameInterval : Maximum number of consecutive ROI detections before a full-frame detection is forced.
+  When set to 0, a full-frame detection only occurs when a tag is lost.
+*/
+void vpDetectorAprilTag::setAprilTagRoiTracking(bool enable, double roiMarginRatio, unsigned int fullFrameInterval)
+{
+  m_impl->setRoiTracking(enable, roiMarginRatio, fullFrameInterval);
+}
+
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
 /*!
   \deprecated Deprecated parameter from AprilTag 2 version.
@@ -2278,6 +2573,16 @@ void vpDetectorAprilTag::setZAlignedWithCameraAxis(bool zAlignedWithCameraFrame)
   m_impl->setZAlignedWithCameraAxis(zAlignedWithCameraFrame);
 }
 
+/*!
+ * Indicate if the ROI tracking mode is enabled.
+ * @return When true, tags are searched in regions of interest around their predicted location.
+ * \sa setAprilTagRoiTracking()
+ */
+bool vpDetectorAprilTag::isAprilTagRoiTracking() const
+{
+  return m_impl->isRoiTracking();
+}
+
 /*!
  * Indicate it z-axis of the tag frame is aligned with the camera frame or not.
  * @return When true, z-axis are aligned, false otherwise
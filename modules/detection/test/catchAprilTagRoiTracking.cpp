@@ -0,0 +1,225 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2026 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test AprilTag detection in ROI tracking mode.
+ */
+
+/*!
+  \example catchAprilTagRoiTracking.cpp
+
+  \brief Test AprilTag detection in ROI tracking mode.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && defined(VISP_HAVE_APRILTAG)
+
+#if defined(VISP_BUILD_CATCH2)
+#include <catch_amalgamated.hpp>
+#else // Since v3.1.1
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <algorithm>
+#include <iostream>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/detection/vpDetectorAprilTag.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+const unsigned int g_tagScale = 12;
+
+/*!
+ * Synthetic frame with the tags at their position at the given frame index, each tag moving with its own
+ * constant velocity.
+ */
+void createFrame(const std::vector<vpImage<unsigned char> > &tags, const std::vector<vpImagePoint> &origins,
+                 const std::vector<vpImagePoint> &velocities, unsigned int frame, vpImage<unsigned char> &I)
+{
+  I.resize(720, 1280, 200);
+  for (size_t i = 0; i < tags.size(); ++i) {
+    const vpImagePoint topLeft = origins[i] + (velocities[i] * static_cast<double>(frame));
+    const int i0 = vpMath::round(topLeft.get_i()), j0 = vpMath::round(topLeft.get_j());
+    for (unsigned int r = 0; r < tags[i].getHeight(); ++r) {
+      for (unsigned int c = 0; c < tags[i].getWidth(); ++c) {
+        I[static_cast<unsigned int>(i0) + r][static_cast<unsigned int>(j0) + c] = tags[i][r][c];
+      }
+    }
+  }
+}
+
+std::vector<int> sortedIds(const vpDetectorAprilTag &detector)
+{
+  std::vector<int> ids = detector.getTagsId();
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+bool sameCorners(vpDetectorAprilTag &detector, vpDetectorAprilTag &detectorRef, double tolerance)
+{
+  const std::vector<int> ids = detector.getTagsId(), idsRef = detectorRef.getTagsId();
+  const std::vector<std::vector<vpImagePoint> > corners = detector.getTagsCorners();
+  const std::vector<std::vector<vpImagePoint> > cornersRef = detectorRef.getTagsCorners();
+  for (size_t i = 0; i < ids.size(); ++i) {
+    const size_t iRef = static_cast<size_t>(std::find(idsRef.begin(), idsRef.end(), ids[i]) - idsRef.begin());
+    if (iRef == idsRef.size()) {
+      return false;
+    }
+    for (size_t k = 0; k < corners[i].size(); ++k) {
+      if (vpImagePoint::distance(corners[i][k], cornersRef[iRef][k]) > tolerance) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+TEST_CASE("AprilTag ROI tracking", "[apriltag_roi_tracking]")
+{
+  vpDetectorAprilTag detectorRef(vpDetectorAprilTag::TAG_36h11);
+  const int tagsId[] = { 0, 5, 12 };
+  std::vector<vpImage<unsigned char> > tags;
+  for (size_t i = 0; i < 3; ++i) {
+    vpImage<unsigned char> tag, tagBig;
+    detectorRef.getTagImage(tag, tagsId[i]);
+    tagBig.resize(tag.getHeight() * g_tagScale, tag.getWidth() * g_tagScale);
+    vpImageTools::resize(tag, tagBig, vpImageTools::INTERPOLATION_NEAREST);
+    tags.push_back(tagBig);
+  }
+  std::vector<vpImagePoint> origins, velocities;
+  origins.push_back(vpImagePoint(50, 60));
+  velocities.push_back(vpImagePoint(6, 9));
+  origins.push_back(vpImagePoint(400, 300));
+  velocities.push_back(vpImagePoint(-5, 4));
+  origins.push_back(vpImagePoint(200, 900));
+  velocities.push_back(vpImagePoint(3, -7));
+
+  const double cornersTolerance = 1.0;
+  const unsigned int fullFrameInterval = 4;
+  vpDetectorAprilTag detector(vpDetectorAprilTag::TAG_36h11);
+  detector.setAprilTagRoiTracking(true, 0.5, fullFrameInterval);
+  CHECK(detector.isAprilTagRoiTracking());
+
+  SECTION("Tags moving with a constant velocity")
+  {
+    vpImage<unsigned char> I;
+    for (unsigned int frame = 0; frame < 12; ++frame) {
+      createFrame(tags, origins, velocities, frame, I);
+      detectorRef.detect(I);
+      detector.detect(I);
+
+      const vpDetectorAprilTag::vpDetectionPath expectedPath = ((frame % (fullFrameInterval + 1)) == 0)
+        ? vpDetectorAprilTag::FULL_FRAME_DETECTION : vpDetectorAprilTag::ROI_DETECTION;
+      CHECK(detector.getLastDetectionPath() == expectedPath);
+      CHECK(detectorRef.getTagsId().size() == 3);
+      CHECK((sortedIds(detector) == sortedIds(detectorRef)));
+      CHECK(sameCorners(detector, detectorRef, cornersTolerance));
+    }
+  }
+
+  SECTION("Fall back to a full-frame detection on loss")
+  {
+    vpImage<unsigned char> I;
+    createFrame(tags, origins, velocities, 0, I);
+    detector.detect(I);
+    createFrame(tags, origins, velocities, 1, I);
+    detector.detect(I);
+    CHECK(detector.getLastDetectionPath() == vpDetectorAprilTag::ROI_DETECTION);
+
+    // The second tag disappears
+    std::vector<vpImage<unsigned char> > lostTags = tags;
+    lostTags[1] = 200;
+    createFrame(lostTags, origins, velocities, 2, I);
+    detectorRef.detect(I);
+    detector.detect(I);
+    CHECK(detector.getLastDetectionPath() == vpDetectorAprilTag::FULL_FRAME_DETECTION);
+    CHECK(detector.getTagsId().size() == 2);
+    CHECK((sortedIds(detector) == sortedIds(detectorRef)));
+
+    // Without predicted tags, the search is performed on the whole image
+    vpDetectorAprilTag detectorNoTag(vpDetectorAprilTag::TAG_36h11);
+    detectorNoTag.setAprilTagRoiTracking(true);
+    vpImage<unsigned char> I_empty(480, 640, 200);
+    CHECK(detectorNoTag.detect(I_empty) == false);
+    CHECK(detectorNoTag.getLastDetectionPath() == vpDetectorAprilTag::FULL_FRAME_DETECTION);
+    CHECK(detectorNoTag.detect(I_empty) == false);
+    CHECK(detectorNoTag.getLastDetectionPath() == vpDetectorAprilTag::FULL_FRAME_DETECTION);
+  }
+
+  SECTION("Prediction from the tag poses")
+  {
+    vpCameraParameters cam(900, 900, 640, 360);
+    const double tagSize = 0.05;
+    std::vector<vpHomogeneousMatrix> cMo_vec, cMo_vecRef;
+    // Static tags whose poses are predicted from the previous frame
+    vpImage<unsigned char> I;
+    createFrame(tags, origins, velocities, 3, I);
+    detector.detect(I, tagSize, cam, cMo_vec);
+    CHECK(detector.getLastDetectionPath() == vpDetectorAprilTag::FULL_FRAME_DETECTION);
+    detector.setAprilTagRoiPrediction(detector.getTagsId(), cMo_vec, tagSize, cam);
+    detector.detect(I, tagSize, cam, cMo_vec);
+    detectorRef.detect(I, tagSize, cam, cMo_vecRef);
+    CHECK(detector.getLastDetectionPath() == vpDetectorAprilTag::ROI_DETECTION);
+    CHECK((sortedIds(detector) == sortedIds(detectorRef)));
+    CHECK(sameCorners(detector, detectorRef, cornersTolerance));
+    CHECK(cMo_vec.size() == cMo_vecRef.size());
+
+    CHECK_THROWS_AS(detector.setAprilTagRoiPrediction(detector.getTagsId(), std::vector<vpHomogeneousMatrix>(),
+                                                      tagSize, cam), vpException);
+  }
+
+  SECTION("Copy and tag family change keep the tracking settings")
+  {
+    vpDetectorAprilTag detectorCpy(detector);
+    CHECK(detectorCpy.isAprilTagRoiTracking());
+    detectorCpy.setAprilTagFamily(vpDetectorAprilTag::TAG_36h11);
+    CHECK(detectorCpy.isAprilTagRoiTracking());
+    detectorCpy.setAprilTagRoiTracking(false);
+    CHECK_FALSE(detectorCpy.isAprilTagRoiTracking());
+  }
+}
+
+int main(int argc, const char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  std::cout << (numFailed ? "Test failed" : "Test succeed") << std::endl;
+  return numFailed;
+}
+
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -42,6 +42,7 @@
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageMorphology.h>
+#include <visp3/core/vpRect.h>
 #include <visp3/imgproc/vpContours.h>
 
 namespace VISP_NAMESPACE_NAME
@@ -586,6 +587,33 @@ VISP_EXPORT void unsharpMask(const  vpImage< vpRGBa> &I, vpImage< vpRGBa> &Ires,
 VISP_EXPORT void connectedComponents(const  vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
                                      const  vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
 
+/*!
+ * \ingroup group_imgproc_connected_components
+ *
+ * Perform connected components detection and compute the statistics of each component.
+ *
+ * Neighbor pixels with the same non-zero value belong to the same component. The components are labelled with a
+ * two-pass run-based union-find algorithm: the rows are first encoded as runs of pixels with the same value, the
+ * connected runs are merged, and the labels are written in a second pass. The labels are numbered from 1 in the
+ * raster order of the first pixel of each component.
+ *
+ * \param I : Input image (0 means background).
+ * \param labels : Label image that contain for each position the component label.
+ * \param nbComponents : Number of connected components.
+ * \param areas : Number of pixels of each component, the component with label `l` being at index `l-1`.
+ * \param boundingBoxes : Bounding box of each component.
+ * \param centroids : Center of gravity of each component.
+ * \param connexity : Type of connexity.
+ * \param nbThreads : Number of threads used to process stripes of rows in parallel. When set to 0, the number of
+ * threads is chosen by OpenMP. Only effective when ViSP is built with OpenMP support. The result does not depend on
+ * the number of threads.
+ */
+VISP_EXPORT void connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                                     std::vector<unsigned int> &areas, std::vector<vpRect> &boundingBoxes,
+                                     std::vector<vpImagePoint> &centroids,
+                                     const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4,
+                                     unsigned int nbThreads = 1);
+
 /*!
  * \ingroup group_imgproc_morph
  *
@@ -36,134 +36,235 @@
   \brief Basic connected components.
 */
 
-#include <queue>
+#include <algorithm>
+#include <vector>
+
 #include <visp3/imgproc/vpImgproc.h>
 
+#if defined(VISP_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
 namespace VISP_NAMESPACE_NAME
 {
-
-void getNeighbors(const vpImage<unsigned char> &I, std::queue<vpImagePoint> &listOfNeighbors, unsigned int i,
-                  unsigned int j, const vpImageMorphology::vpConnexityType &connexity);
-void visitNeighbors(vpImage<unsigned char> &I_copy, std::queue<vpImagePoint> &listOfNeighbors, vpImage<int> &labels,
-                    int current_label, const vpImageMorphology::vpConnexityType &connexity);
-void connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents, const vpImageMorphology::vpConnexityType &connexity);
-
-void getNeighbors(const vpImage<unsigned char> &I, std::queue<vpImagePoint> &listOfNeighbors, unsigned int i,
-                  unsigned int j, const vpImageMorphology::vpConnexityType &connexity)
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
 {
-  unsigned char currValue = I[i][j];
-
-  if (connexity == vpImageMorphology::CONNEXITY_4) {
-    // Top
-    if (I[i - 1][j] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i - 1, j));
-    }
+//! Maximal horizontal sequence of pixels with the same non-zero value
+struct vpRun
+{
+  unsigned int start; //!< Column of the first pixel
+  unsigned int end;   //!< Column after the last pixel
+  unsigned char value;
+};
 
-    // Left
-    if (I[i][j - 1] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i, j - 1));
-    }
+unsigned int findRoot(std::vector<unsigned int> &parent, unsigned int idx)
+{
+  while (parent[idx] != idx) {
+    parent[idx] = parent[parent[idx]]; // Path halving
+    idx = parent[idx];
+  }
+  return idx;
+}
 
-    // Right
-    if (I[i][j + 1] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i, j + 1));
-    }
+void unionRuns(std::vector<unsigned int> &parent, unsigned int idx1, unsigned int idx2)
+{
+  unsigned int root1 = findRoot(parent, idx1);
+  unsigned int root2 = findRoot(parent, idx2);
+  // The root of a set is always its first run in raster order
+  if (root1 < root2) {
+    parent[root2] = root1;
+  }
+  else if (root2 < root1) {
+    parent[root1] = root2;
+  }
+}
 
-    // Bottom
-    if (I[i + 1][j] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i + 1, j));
+void extractRuns(const unsigned char *row, unsigned int width, std::vector<vpRun> &runs)
+{
+  runs.clear();
+  unsigned int j = 0;
+  while (j < width) {
+    unsigned char value = row[j];
+    if (value == 0) {
+      ++j;
     }
-  }
-  else {
-    for (int cpt1 = -1; cpt1 <= 1; ++cpt1) {
-      for (int cpt2 = -1; cpt2 <= 1; ++cpt2) {
-        // Everything except the current position
-        if ((cpt1 != 0) || (cpt2 != 0)) {
-          if (I[static_cast<int>(i) + cpt1][static_cast<int>(j) + cpt2] == currValue) {
-            listOfNeighbors.push(vpImagePoint(static_cast<int>(i) + cpt1, static_cast<int>(j) + cpt2));
-          }
-        }
+    else {
+      vpRun run;
+      run.start = j;
+      run.value = value;
+      while ((j < width) && (row[j] == value)) {
+        ++j;
       }
+      run.end = j;
+      runs.push_back(run);
     }
   }
 }
 
-void visitNeighbors(vpImage<unsigned char> &I_copy, std::queue<vpImagePoint> &listOfNeighbors, vpImage<int> &labels,
-                    int current_label, const vpImageMorphology::vpConnexityType &connexity)
+/*!
+  Merge the runs of a row with the runs of the previous row. Two runs are connected when they have the same value
+  and when they overlap, or touch along a diagonal with the 8-connexity.
+*/
+void mergeRows(const std::vector<vpRun> &prevRuns, unsigned int prevOffset, const std::vector<vpRun> &runs,
+               unsigned int offset, unsigned int diagonal, std::vector<unsigned int> &parent)
 {
-  // Visit the neighbors
-  while (!listOfNeighbors.empty()) {
-    vpImagePoint imPt = listOfNeighbors.front();
-    unsigned int i = static_cast<unsigned int>(imPt.get_i());
-    unsigned int j = static_cast<unsigned int>(imPt.get_j());
-    listOfNeighbors.pop();
-
-    if (I_copy[i][j]) {
-      getNeighbors(I_copy, listOfNeighbors, i, j, connexity);
-
-      // Reset current position and set label
-      I_copy[i][j] = 0;
-      labels[i][j] = current_label;
+  size_t k_prev = 0;
+  for (size_t k = 0; k < runs.size(); ++k) {
+    const vpRun &run = runs[k];
+    // Skip the runs of the previous row that end before the current one
+    while ((k_prev < prevRuns.size()) && ((prevRuns[k_prev].end + diagonal) <= run.start)) {
+      ++k_prev;
+    }
+    for (size_t l = k_prev; (l < prevRuns.size()) && (prevRuns[l].start < (run.end + diagonal)); ++l) {
+      if (prevRuns[l].value == run.value) {
+        unionRuns(parent, static_cast<unsigned int>(offset + k), static_cast<unsigned int>(prevOffset + l));
+      }
     }
   }
 }
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
 
-void connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents, const vpImageMorphology::vpConnexityType &connexity)
+void connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                         std::vector<unsigned int> &areas, std::vector<vpRect> &boundingBoxes,
+                         std::vector<vpImagePoint> &centroids, const vpImageMorphology::vpConnexityType &connexity,
+                         unsigned int nbThreads)
 {
   if (I.getSize() == 0) {
     return;
   }
 
-  labels.resize(I.getHeight(), I.getWidth());
-
-  vpImage<unsigned char> I_copy(I.getHeight() + 2, I.getWidth() + 2);
-  // Copy and add border
-  unsigned int i_copy_height = I_copy.getHeight();
-  for (unsigned int i = 0; i < i_copy_height; ++i) {
-    if ((i == 0) || (i == (I_copy.getHeight() - 1))) {
-      memset(I_copy[i], 0, sizeof(unsigned char) * I_copy.getWidth());
-    }
-    else {
-      I_copy[i][0] = 0;
-      memcpy(I_copy[i] + 1, I[i - 1], sizeof(unsigned char) * I.getWidth());
-      I_copy[i][I_copy.getWidth() - 1] = 0;
-    }
-  }
+  const unsigned int height = I.getHeight();
+  const unsigned int width = I.getWidth();
+  const unsigned int diagonal = (connexity == vpImageMorphology::CONNEXITY_4) ? 0 : 1;
 
-  vpImage<int> labels_copy(I.getHeight() + 2, I.getWidth() + 2, 0);
+  int nbStripes = 1;
+#if defined(VISP_HAVE_OPENMP)
+  nbStripes = (nbThreads == 0) ? omp_get_max_threads() : static_cast<int>(nbThreads);
+#else
+  (void)nbThreads;
+#endif
+  nbStripes = std::max<int>(1, std::min<int>(nbStripes, static_cast<int>(height)));
 
-  int current_label = 1;
-  std::queue<vpImagePoint> listOfNeighbors;
+  // First pass: run-length encoding of each row
+  std::vector<std::vector<vpRun> > rowRuns(height);
+  int nbRows = static_cast<int>(height);
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nbStripes) if (nbStripes > 1)
+#endif
+  for (int i = 0; i < nbRows; ++i) {
+    extractRuns(I[i], width, rowRuns[i]);
+  }
 
-  unsigned int i_height = I.getHeight();
-  for (unsigned int cpt1 = 0; cpt1 < i_height; ++cpt1) {
-    unsigned int i = cpt1 + 1;
+  // Index of the first run of each row, runs are numbered in raster order
+  std::vector<unsigned int> rowOffsets(height + 1, 0);
+  for (unsigned int i = 0; i < height; ++i) {
+    rowOffsets[i + 1] = rowOffsets[i] + static_cast<unsigned int>(rowRuns[i].size());
+  }
+  const unsigned int nbRuns = rowOffsets[height];
+  std::vector<unsigned int> parent(nbRuns);
+  for (unsigned int k = 0; k < nbRuns; ++k) {
+    parent[k] = k;
+  }
 
-    unsigned int i_width = I.getWidth();
-    for (unsigned int cpt2 = 0; cpt2 < i_width; ++cpt2) {
-      unsigned int j = cpt2 + 1;
+  // Union of the connected runs. Each stripe of rows only modifies the sets of its own runs, the first row of each
+  // stripe is then merged with the last row of the previous stripe.
+  std::vector<int> stripeStarts(static_cast<size_t>(nbStripes) + 1);
+  for (int s = 0; s <= nbStripes; ++s) {
+    stripeStarts[s] = static_cast<int>((static_cast<long long>(height) * s) / nbStripes);
+  }
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nbStripes) if (nbStripes > 1)
+#endif
+  for (int s = 0; s < nbStripes; ++s) {
+    for (int i = stripeStarts[s] + 1; i < stripeStarts[s + 1]; ++i) {
+      mergeRows(rowRuns[i - 1], rowOffsets[i - 1], rowRuns[i], rowOffsets[i], diagonal, parent);
+    }
+  }
+  for (int s = 1; s < nbStripes; ++s) {
+    int i = stripeStarts[s];
+    mergeRows(rowRuns[i - 1], rowOffsets[i - 1], rowRuns[i], rowOffsets[i], diagonal, parent);
+  }
 
-      if (I_copy[i][j] && (labels_copy[i][j] == 0)) {
-        // Get all the neighbors relative to the current position
-        getNeighbors(I_copy, listOfNeighbors, i, j, connexity);
+  // Labels are given in raster order of the first pixel of each component, the statistics are accumulated per run
+  std::vector<int> runLabels(nbRuns);
+  std::vector<double> sum_i, sum_j;
+  std::vector<unsigned int> left, top, right, bottom;
+  areas.clear();
+  int current_label = 0;
+  for (unsigned int i = 0; i < height; ++i) {
+    for (size_t k = 0; k < rowRuns[i].size(); ++k) {
+      const vpRun &run = rowRuns[i][k];
+      unsigned int idx = rowOffsets[i] + static_cast<unsigned int>(k);
+      unsigned int root = findRoot(parent, idx);
+      int label = 0;
+      if (root == idx) {
+        label = ++current_label;
+        areas.push_back(0);
+        sum_i.push_back(0.0);
+        sum_j.push_back(0.0);
+        left.push_back(run.start);
+        top.push_back(i);
+        right.push_back(run.end - 1);
+        bottom.push_back(i);
+      }
+      else {
+        // The root has a lower index and has already been labelled
+        label = runLabels[root];
+      }
+      runLabels[idx] = label;
 
-        // Reset current position and set label
-        I_copy[i][j] = 0;
-        labels_copy[i][j] = current_label;
+      const unsigned int c = static_cast<unsigned int>(label - 1);
+      const unsigned int length = run.end - run.start;
+      areas[c] += length;
+      sum_i[c] += static_cast<double>(length) * i;
+      sum_j[c] += (static_cast<double>(length) * (run.start + run.end - 1)) / 2.0;
+      left[c] = std::min<unsigned int>(left[c], run.start);
+      right[c] = std::max<unsigned int>(right[c], run.end - 1);
+      bottom[c] = i;
+    }
+  }
+  nbComponents = current_label;
 
-        visitNeighbors(I_copy, listOfNeighbors, labels_copy, current_label, connexity);
+  boundingBoxes.resize(static_cast<size_t>(nbComponents));
+  centroids.resize(static_cast<size_t>(nbComponents));
+  for (size_t c = 0; c < static_cast<size_t>(nbComponents); ++c) {
+    boundingBoxes[c] = vpRect(left[c], top[c], (right[c] - left[c]) + 1, (bottom[c] - top[c]) + 1);
+    centroids[c] = vpImagePoint(sum_i[c] / areas[c], sum_j[c] / areas[c]);
+  }
 
-        // Increment label
-        ++current_label;
+  // Second pass: write the labels
+  labels.resize(height, width);
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nbStripes) if (nbStripes > 1)
+#endif
+  for (int i = 0; i < nbRows; ++i) {
+    int *labels_row = labels[i];
+    unsigned int j = 0;
+    for (size_t k = 0; k < rowRuns[i].size(); ++k) {
+      const vpRun &run = rowRuns[i][k];
+      for (; j < run.start; ++j) {
+        labels_row[j] = 0;
+      }
+      const int label = runLabels[rowOffsets[i] + k];
+      for (; j < run.end; ++j) {
+        labels_row[j] = label;
       }
     }
+    for (; j < width; ++j) {
+      labels_row[j] = 0;
+    }
   }
-  unsigned int labels_height = labels.getHeight();
-  for (unsigned int i = 0; i < labels_height; ++i) {
-    memcpy(labels[i], labels_copy[i + 1] + 1, sizeof(int) * labels.getWidth());
-  }
+}
 
-  nbComponents = current_label - 1;
+void connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                         const vpImageMorphology::vpConnexityType &connexity)
+{
+  std::vector<unsigned int> areas;
+  std::vector<vpRect> boundingBoxes;
+  std::vector<vpImagePoint> centroids;
+  connectedComponents(I, labels, nbComponents, areas, boundingBoxes, centroids, connexity, 1);
 }
 
 } // namespace
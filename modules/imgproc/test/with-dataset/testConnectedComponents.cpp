@@ -307,6 +307,38 @@ int main(int argc, const char **argv)
     std::cout << "Time: " << t << " ms" << std::endl;
     std::cout << "nbComponents=" << nbComponents << std::endl;
 
+    // Same labels with the statistics of the components, computed on stripes of rows in parallel
+    vpImage<int> labels_connex8_stats;
+    int nbComponents_stats = 0;
+    std::vector<unsigned int> areas;
+    std::vector<vpRect> boundingBoxes;
+    std::vector<vpImagePoint> centroids;
+    t = vpTime::measureTimeMs();
+    VISP_NAMESPACE_NAME::connectedComponents(I, labels_connex8_stats, nbComponents_stats, areas, boundingBoxes,
+                                             centroids, vpImageMorphology::CONNEXITY_8, 4);
+    t = vpTime::measureTimeMs() - t;
+    std::cout << "\n8-connexity connected components with statistics (4 threads):" << std::endl;
+    std::cout << "Time: " << t << " ms" << std::endl;
+    if ((nbComponents_stats != nbComponents) || !(labels_connex8_stats == labels_connex8)) {
+      throw vpException(vpException::fatalError, "Connected components with statistics differ");
+    }
+
+    std::vector<unsigned int> areas_check(static_cast<size_t>(nbComponents), 0);
+    for (unsigned int i = 0; i < labels_connex8.getHeight(); i++) {
+      for (unsigned int j = 0; j < labels_connex8.getWidth(); j++) {
+        int label = labels_connex8[i][j];
+        if (label != 0) {
+          areas_check[static_cast<size_t>(label - 1)]++;
+          if (!boundingBoxes[static_cast<size_t>(label - 1)].isInside(vpImagePoint(i, j))) {
+            throw vpException(vpException::fatalError, "Pixel outside of the bounding box of its component");
+          }
+        }
+      }
+    }
+    if (areas_check != areas) {
+      throw vpException(vpException::fatalError, "Wrong areas of the connected components");
+    }
+
     // Save results
     vpImage<vpRGBa> labels_connex4_color(labels_connex4.getHeight(), labels_connex4.getWidth(), vpRGBa(0, 0, 0, 0));
     for (unsigned int i = 0; i < labels_connex4.getHeight(); i++) {
@@ -104,6 +104,23 @@ BEGIN_VISP_NAMESPACE
  *   }
  * }
  * \endcode
+ *
+ * When images are read in sequence, decoding the files on the calling thread may be slower than the processing of
+ * the images. setPrefetch() enables a read-ahead mode where the next frames of the sequence are decoded by
+ * background threads into a pool of recycled images, while acquire() only hands over the frame that is already
+ * decoded. When the requested image is not the one expected, for example after setImageNumber() or
+ * acquire(I, image_number), the frames that were decoded in advance and that are no longer needed are recycled and
+ * the read-ahead restarts from the new position. The decoding time of the frames and the time spent by acquire() to
+ * get them are given by getDecodeTime(), getMeanDecodeTime() and getWaitTime().
+ * \code
+ *   vpDiskGrabber g("/local/soft/ViSP/ViSP-images/cube/image.%04d.pgm");
+ *   g.setPrefetch(4, 2); // Decode up to 4 images in advance with 2 threads
+ *   g.open(I);
+ *   while (...) {
+ *     g.acquire(I);
+ *     std::cout << "Decoded in " << g.getDecodeTime() << " ms, acquired in " << g.getWaitTime() << " ms" << std::endl;
+ *   }
+ * \endcode
 */
 class VISP_EXPORT vpDiskGrabber : public vpFrameGrabber
 {
@@ -122,6 +139,19 @@ private:
   std::string m_generic_name;
   std::string m_image_name;
 
+  unsigned int m_prefetch_size;    //!< number of images decoded in advance, 0 to disable read-ahead
+  unsigned int m_prefetch_threads; //!< number of decoding threads used for read-ahead
+  double m_decode_time;            //!< time in ms to decode the last image
+  double m_decode_time_sum;        //!< sum of the decoding times used to compute the mean
+  unsigned int m_decode_count;     //!< number of images used to compute the mean decoding time
+  double m_wait_time;              //!< time in ms spent by the last acquire() to get the image
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  class vpPrefetcher;
+  //! Frame pool and decoding threads, created by the first acquire() when read-ahead is enabled
+  vpPrefetcher *m_prefetcher;
+#endif
+
 public:
   /*!
    * Default constructor.
@@ -140,9 +170,9 @@ public:
 
   /*!
    * Destructor.
-   * In fact nothing to destroy...
+   * Stops the read-ahead threads if any.
    */
-  virtual ~vpDiskGrabber() VP_OVERRIDE { }
+  virtual ~vpDiskGrabber() VP_OVERRIDE;
 
   /*!
    * Copy operator.
@@ -214,11 +244,16 @@ public:
   void acquire(vpImage<float> &I, long image_number);
 
   /*!
-   * Not useful.
-   *
-   * Does nothing. Here for compatibility issue with the vpFrameGrabber class.
+   * Stops the read-ahead threads and releases the images decoded in advance.
+   * Does nothing when read-ahead is not enabled.
    */
-  void close() VP_OVERRIDE { }
+  void close() VP_OVERRIDE;
+
+  /*!
+   * Return the time in ms that was needed to decode the last acquired image, whether it was decoded in advance by a
+   * read-ahead thread or by acquire().
+   */
+  inline double getDecodeTime() const { return m_decode_time; }
 
   /*!
    * Return the current image number.
@@ -230,6 +265,25 @@ public:
    */
   inline std::string getImageName() const { return m_image_name; }
 
+  /*!
+   * Return the mean time in ms needed to decode an image, computed over all the acquired images.
+   */
+  inline double getMeanDecodeTime() const
+  {
+    return (m_decode_count > 0) ? (m_decode_time_sum / m_decode_count) : 0.;
+  }
+
+  /*!
+   * Return the number of images that are decoded in advance, see setPrefetch().
+   */
+  inline unsigned int getPrefetchSize() const { return m_prefetch_size; }
+
+  /*!
+   * Return the time in ms spent by the last acquire() to get the image. Without read-ahead it corresponds to the
+   * decoding time. With read-ahead it is close to zero when the image was already decoded.
+   */
+  inline double getWaitTime() const { return m_wait_time; }
+
   /*!
    * Read the first image of the sequence.
    * The image number is not incremented.
@@ -278,10 +332,23 @@ public:
    */
   void setNumberOfZero(unsigned int noz) { m_number_of_zero = noz; }
 
+  /*!
+   * Enable the read-ahead of the images of the sequence. Only grey level and color images are read in advance.
+   * Without threads support, images are always decoded by acquire().
+   *
+   * \param nb_frames : Number of images that are decoded in advance. Set to 0 to disable read-ahead.
+   * \param nb_threads : Number of decoding threads.
+   */
+  void setPrefetch(unsigned int nb_frames, unsigned int nb_threads = 1);
+
   /*!
    * Set the step between two images.
    */
   void setStep(long step) { m_image_step = step; }
+
+private:
+  std::string formatImageName(long image_number) const;
+  template <class Type> void readImage(vpImage<Type> &I);
 };
 
 END_VISP_NAMESPACE
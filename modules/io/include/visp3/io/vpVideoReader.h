@@ -238,6 +238,10 @@ private:
   //! The frame step
   long m_frameStep;
   double m_frameRate;
+  //! Number of images of a sequence decoded in advance
+  unsigned int m_prefetchSize;
+  //! Number of threads used to decode the images in advance
+  unsigned int m_prefetchThreads;
 
 public:
   vpVideoReader();
@@ -267,6 +271,8 @@ public:
   bool getFrame(vpImage<vpRGBa> &I, long frame);
   bool getFrame(vpImage<unsigned char> &I, long frame);
 
+  double getDecodeTime() const;
+
   /*!
    * Return the frame rate in Hz used to encode the video stream.
    *
@@ -322,6 +328,14 @@ public:
     return m_lastFrame;
   }
 
+  double getMeanDecodeTime() const;
+
+  /*!
+   * Return the number of images of a sequence that are decoded in advance, see setPrefetch().
+   */
+  inline unsigned int getPrefetchSize() const { return m_prefetchSize; }
+  double getWaitTime() const;
+
   /*!
    * Gets the frame step.
    *
@@ -384,6 +398,8 @@ public:
    */
   inline void setFrameStep(const long frame_step) { m_frameStep = frame_step; }
 
+  void setPrefetch(unsigned int nb_frames, unsigned int nb_threads = 1);
+
 private:
   vpVideoFormatType getFormat(const std::string &filename) const;
   static std::string getExtension(const std::string &filename);
@@ -165,10 +165,41 @@ BEGIN_VISP_NAMESPACE
     return 0;
   }
   \endcode
+
+  To record camera frames without stalling the acquisition loop, the writer can be switched in an asynchronous mode
+  with setAsynchronous() before open(). saveFrame() then copies the image into a pool of preallocated frames and
+  returns immediately, while worker threads encode and write the frames. The names of the files of an image sequence
+  are given at saveFrame() time, so that they follow the order of the calls whatever the worker that writes them. A
+  video file is always encoded by a single worker to keep the frames in order. When all the frames of the pool are
+  waiting to be written, saveFrame() either blocks or drops the new frame, see vpAsyncFullPolicy.
+
+  \code
+  vpVideoWriter writer;
+  writer.setFileName("./image/image%04d.png");
+  // 2 workers, a pool of 16 frames, drop the frames that cannot be queued
+  writer.setAsynchronous(2, 16, vpVideoWriter::ASYNC_DROP_WHEN_FULL);
+  writer.open(I);
+  for (; ; ) {
+    // Acquire I
+    writer.saveFrame(I); // Returns immediately
+  }
+  writer.close(); // Wait until all the queued frames are written
+  std::cout << writer.getDroppedFrameCount() << " frames were dropped" << std::endl;
+  \endcode
 */
 
 class VISP_EXPORT vpVideoWriter
 {
+public:
+  /*!
+    Behavior of saveFrame() in asynchronous mode when all the frames of the pool are waiting to be written.
+  */
+  typedef enum
+  {
+    ASYNC_BLOCK_WHEN_FULL, //!< Wait until a frame of the pool has been written.
+    ASYNC_DROP_WHEN_FULL   //!< Drop the new frame and count it in getDroppedFrameCount().
+  } vpAsyncFullPolicy;
+
 private:
 #if defined(VISP_HAVE_OPENCV) && \
     (((VISP_HAVE_OPENCV_VERSION < 0x030000) && defined(HAVE_OPENCV_HIGHGUI)) || \
@@ -216,11 +247,24 @@ private:
 
   int m_frameStep;
 
+  //! Number of encoder threads of the asynchronous mode, 0 when frames are written synchronously
+  unsigned int m_asyncWorkers;
+  //! Number of preallocated frames of the asynchronous mode
+  unsigned int m_asyncPoolSize;
+  vpAsyncFullPolicy m_asyncPolicy;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  class vpAsyncWriter;
+  //! Frame pool and encoder threads, created by open() in asynchronous mode
+  vpAsyncWriter *m_async;
+#endif
+
 public:
   vpVideoWriter();
   virtual ~vpVideoWriter();
 
   void close();
+  void flush();
 
   /*!
     Gets the current frame index.
@@ -233,6 +277,15 @@ public:
    */
   inline std::string getFrameName() const { return m_frameName; }
 
+  unsigned int getDroppedFrameCount() const;
+  unsigned int getMaxQueueDepth() const;
+  unsigned int getQueueDepth() const;
+
+  /*!
+   * Return true if the frames are written by worker threads, see setAsynchronous().
+   */
+  inline bool isAsynchronous() const { return m_asyncWorkers > 0; }
+
   void open(vpImage<vpRGBa> &I);
   void open(vpImage<unsigned char> &I);
   /*!
@@ -251,6 +304,8 @@ public:
   inline void setCodec(const int fourcc_codec) { m_fourcc = fourcc_codec; }
 #endif
 
+  void setAsynchronous(unsigned int nb_workers, unsigned int pool_size = 8,
+                       vpAsyncFullPolicy policy = ASYNC_BLOCK_WHEN_FULL);
   void setFileName(const std::string &filename);
   void setFirstFrameIndex(int first_frame);
 
@@ -277,8 +332,17 @@ public:
   inline void setFrameStep(const int frame_step) { m_frameStep = frame_step; }
 
 private:
+  // The frame pool and the threads cannot be shared
+  vpVideoWriter(const vpVideoWriter &);
+  vpVideoWriter &operator=(const vpVideoWriter &);
+
   vpVideoFormatType getFormat(const std::string &filename);
   static std::string getExtension(const std::string &filename);
+  bool isImageSequence() const;
+  void startAsynchronous(const vpImage<unsigned char> *I_grey, const vpImage<vpRGBa> *I_color);
+  void stopAsynchronous();
+  void writeFrame(const vpImage<vpRGBa> &I, const std::string &frameName);
+  void writeFrame(const vpImage<unsigned char> &I, const std::string &frameName);
 };
 
 END_VISP_NAMESPACE
@@ -32,24 +32,236 @@
  */
 
 #include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpTime.h>
 #include <visp3/io/vpDiskGrabber.h>
 
+#if defined(VISP_HAVE_THREADS)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
 BEGIN_VISP_NAMESPACE
 
+#if defined(VISP_HAVE_THREADS)
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*!
+  Pool of recycled images and decoding threads used by vpDiskGrabber to read images in advance.
+
+  Each slot of the pool holds one image identified by its file name and its type. request() gives the list of the
+  files that will be read next: the slots that do not belong to this window are recycled and the missing files are
+  queued so that the nearest ones are decoded first. take() hands over a decoded image by swapping it with the image
+  of the caller, which buffer is then reused for the next decoding.
+*/
+class vpDiskGrabber::vpPrefetcher
+{
+public:
+  vpPrefetcher(unsigned int nbThreads, unsigned int poolSize)
+    : m_slots(poolSize), m_order(0), m_stop(false), m_mutex(), m_condRequest(), m_condDecoded(), m_workers()
+  {
+    for (unsigned int i = 0; i < nbThreads; ++i) {
+      m_workers.push_back(std::thread(&vpPrefetcher::run, this));
+    }
+  }
+
+  ~vpPrefetcher()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_condRequest.notify_all();
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+      m_workers[i].join();
+    }
+  }
+
+  /*!
+    Recycle the slots that are not in the window given by \e names and queue the files of the window that are not
+    already decoded or being decoded. \e names are sorted from the nearest to the farthest file.
+  */
+  template <class Type> void request(const std::vector<std::string> &names, const vpImage<Type> &I)
+  {
+    const bool color = isColor(I);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    std::vector<bool> present(names.size(), false);
+    for (size_t s = 0; s < m_slots.size(); ++s) {
+      vpSlot &slot = m_slots[s];
+      if (slot.state == FREE) {
+        continue;
+      }
+      bool in_window = false;
+      if (slot.color == color) {
+        for (size_t i = 0; (i < names.size()) && !in_window; ++i) {
+          if (!present[i] && (slot.name == names[i])) {
+            present[i] = true;
+            in_window = true;
+          }
+        }
+      }
+      // A slot being decoded cannot be recycled now. It will be at the next request once decoded.
+      if (!in_window && (slot.state != DECODING)) {
+        slot.state = FREE;
+      }
+    }
+    bool queued = false;
+    for (size_t i = 0; i < names.size(); ++i) {
+      if (present[i]) {
+        continue;
+      }
+      vpSlot *slot = nullptr;
+      for (size_t s = 0; (s < m_slots.size()) && (slot == nullptr); ++s) {
+        if (m_slots[s].state == FREE) {
+          slot = &m_slots[s];
+        }
+      }
+      if (slot == nullptr) {
+        break;
+      }
+      slot->name = names[i];
+      slot->color = color;
+      slot->order = m_order++;
+      slot->state = REQUESTED;
+      queued = true;
+    }
+    lock.unlock();
+    if (queued) {
+      m_condRequest.notify_all();
+    }
+  }
+
+  /*!
+    Get the image read from file \e name. If the image is being decoded, wait for the end of the decoding.
+    \return false if the image is not available because it was not requested, not yet started or could not be
+    decoded. In that case the caller has to read the image by itself.
+  */
+  template <class Type> bool take(const std::string &name, vpImage<Type> &I, double &decode_time)
+  {
+    const bool color = isColor(I);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (size_t s = 0; s < m_slots.size(); ++s) {
+      vpSlot &slot = m_slots[s];
+      if ((slot.state == FREE) || (slot.color != color) || (slot.name != name)) {
+        continue;
+      }
+      if (slot.state == REQUESTED) {
+        // Not started yet: the caller decodes it right away rather than waiting for a worker
+        slot.state = FREE;
+        return false;
+      }
+      while (slot.state == DECODING) {
+        m_condDecoded.wait(lock);
+      }
+      const bool decoded = (slot.state == DECODED);
+      if (decoded) {
+        swap(I, image(slot, I));
+        decode_time = slot.decode_time;
+      }
+      slot.state = FREE;
+      return decoded;
+    }
+    return false;
+  }
+
+private:
+  typedef enum { FREE, REQUESTED, DECODING, DECODED, FAILED } vpSlotState;
+
+  struct vpSlot
+  {
+    vpSlot() : name(), color(false), state(FREE), order(0), decode_time(0.), I_grey(), I_color() { }
+
+    std::string name;
+    bool color;
+    vpSlotState state;
+    unsigned long order;
+    double decode_time;
+    vpImage<unsigned char> I_grey;
+    vpImage<vpRGBa> I_color;
+  };
+
+  static bool isColor(const vpImage<unsigned char> &) { return false; }
+  static bool isColor(const vpImage<vpRGBa> &) { return true; }
+  static vpImage<unsigned char> &image(vpSlot &slot, const vpImage<unsigned char> &) { return slot.I_grey; }
+  static vpImage<vpRGBa> &image(vpSlot &slot, const vpImage<vpRGBa> &) { return slot.I_color; }
+
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+      vpSlot *slot = nullptr;
+      for (size_t s = 0; s < m_slots.size(); ++s) {
+        if ((m_slots[s].state == REQUESTED) && ((slot == nullptr) || (m_slots[s].order < slot->order))) {
+          slot = &m_slots[s];
+        }
+      }
+      if (m_stop) {
+        return;
+      }
+      if (slot == nullptr) {
+        m_condRequest.wait(lock);
+        continue;
+      }
+      // The slot is owned by this worker until its state changes
+      slot->state = DECODING;
+      const std::string name = slot->name;
+      lock.unlock();
+
+      bool decoded = true;
+      double t = vpTime::measureTimeMs();
+      try {
+        if (slot->color) {
+          vpImageIo::read(slot->I_color, name);
+        }
+        else {
+          vpImageIo::read(slot->I_grey, name);
+        }
+      }
+      catch (...) {
+        // The error is raised again when the caller reads the file by itself
+        decoded = false;
+      }
+      t = vpTime::measureTimeMs() - t;
+
+      lock.lock();
+      slot->decode_time = t;
+      slot->state = decoded ? DECODED : FAILED;
+      m_condDecoded.notify_all();
+    }
+  }
+
+  std::vector<vpSlot> m_slots;
+  unsigned long m_order;
+  bool m_stop;
+  std::mutex m_mutex;
+  std::condition_variable m_condRequest;
+  std::condition_variable m_condDecoded;
+  std::vector<std::thread> m_workers;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+#endif
+
 vpDiskGrabber::vpDiskGrabber()
   : m_image_number(0), m_image_number_next(0), m_image_step(1), m_number_of_zero(0), m_directory("/tmp"),
-  m_base_name("I"), m_extension("pgm"), m_use_generic_name(false), m_generic_name("empty")
+  m_base_name("I"), m_extension("pgm"), m_use_generic_name(false), m_generic_name("empty"), m_prefetch_size(0),
+  m_prefetch_threads(1), m_decode_time(0.), m_decode_time_sum(0.), m_decode_count(0), m_wait_time(0.),
+  m_prefetcher(nullptr)
 {
   init = false;
 }
 
-vpDiskGrabber::vpDiskGrabber(const vpDiskGrabber &grabber) : vpFrameGrabber(grabber)
+vpDiskGrabber::vpDiskGrabber(const vpDiskGrabber &grabber) : vpFrameGrabber(grabber), m_prefetcher(nullptr)
 {
   *this = grabber;
 }
 
+vpDiskGrabber::~vpDiskGrabber() { close(); }
+
 vpDiskGrabber &vpDiskGrabber::operator=(const vpDiskGrabber &grabber)
 {
+  if (this == &grabber) {
+    return *this;
+  }
   m_image_number = grabber.m_image_number;
   m_image_number_next = grabber.m_image_number_next;
   m_image_step = grabber.m_image_step;
@@ -60,12 +272,23 @@ vpDiskGrabber &vpDiskGrabber::operator=(const vpDiskGrabber &grabber)
   m_use_generic_name = grabber.m_use_generic_name;
   m_generic_name = grabber.m_generic_name;
 
+  // The decoding threads are not shared, they are started again by the next acquire()
+  close();
+  m_prefetch_size = grabber.m_prefetch_size;
+  m_prefetch_threads = grabber.m_prefetch_threads;
+  m_decode_time = grabber.m_decode_time;
+  m_decode_time_sum = grabber.m_decode_time_sum;
+  m_decode_count = grabber.m_decode_count;
+  m_wait_time = grabber.m_wait_time;
+
   return *this;
 }
 
 vpDiskGrabber::vpDiskGrabber(const std::string &generic_name)
   : m_image_number(0), m_image_number_next(0), m_image_step(1), m_number_of_zero(0), m_directory("/tmp"),
-  m_base_name("I"), m_extension("pgm"), m_use_generic_name(true), m_generic_name(generic_name)
+  m_base_name("I"), m_extension("pgm"), m_use_generic_name(true), m_generic_name(generic_name), m_prefetch_size(0),
+  m_prefetch_threads(1), m_decode_time(0.), m_decode_time_sum(0.), m_decode_count(0), m_wait_time(0.),
+  m_prefetcher(nullptr)
 {
   init = false;
 }
@@ -73,7 +296,9 @@ vpDiskGrabber::vpDiskGrabber(const std::string &generic_name)
 vpDiskGrabber::vpDiskGrabber(const std::string &dir, const std::string &basename, long number, int step,
                              unsigned int noz, const std::string &ext)
   : m_image_number(number), m_image_number_next(number), m_image_step(step), m_number_of_zero(noz), m_directory(dir),
-  m_base_name(basename), m_extension(ext), m_use_generic_name(false), m_generic_name("empty"), m_image_name()
+  m_base_name(basename), m_extension(ext), m_use_generic_name(false), m_generic_name("empty"), m_image_name(),
+  m_prefetch_size(0), m_prefetch_threads(1), m_decode_time(0.), m_decode_time_sum(0.), m_decode_count(0),
+  m_wait_time(0.), m_prefetcher(nullptr)
 {
   init = false;
 }
@@ -127,19 +352,10 @@ void vpDiskGrabber::open(vpImage<float> &I)
 void vpDiskGrabber::acquire(vpImage<unsigned char> &I)
 {
   m_image_number = m_image_number_next;
-
-  if (m_use_generic_name) {
-    m_image_name = vpIoTools::formatString(m_generic_name, static_cast<unsigned int>(m_image_number));
-  }
-  else {
-    std::stringstream ss;
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(static_cast<int>(m_number_of_zero)) << m_image_number << "."
-      << m_extension;
-    m_image_name = ss.str();
-  }
-
+  m_image_name = formatImageName(m_image_number);
   m_image_number_next += m_image_step;
-  vpImageIo::read(I, m_image_name);
+
+  readImage(I);
 
   width = I.getWidth();
   height = I.getHeight();
@@ -148,20 +364,10 @@ void vpDiskGrabber::acquire(vpImage<unsigned char> &I)
 void vpDiskGrabber::acquire(vpImage<vpRGBa> &I)
 {
   m_image_number = m_image_number_next;
-
-  if (m_use_generic_name) {
-    m_image_name = vpIoTools::formatString(m_generic_name, static_cast<unsigned int>(m_image_number));
-  }
-  else {
-    std::stringstream ss;
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(static_cast<int>(m_number_of_zero)) << m_image_number << "."
-      << m_extension;
-    m_image_name = ss.str();
-  }
-
+  m_image_name = formatImageName(m_image_number);
   m_image_number_next += m_image_step;
 
-  vpImageIo::read(I, m_image_name);
+  readImage(I);
 
   width = I.getWidth();
   height = I.getHeight();
@@ -170,17 +376,7 @@ void vpDiskGrabber::acquire(vpImage<vpRGBa> &I)
 void vpDiskGrabber::acquire(vpImage<float> &I)
 {
   m_image_number = m_image_number_next;
-
-  if (m_use_generic_name) {
-    m_image_name = vpIoTools::formatString(m_generic_name, static_cast<unsigned int>(m_image_number));
-  }
-  else {
-    std::stringstream ss;
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(static_cast<int>(m_number_of_zero)) << m_image_number << "."
-      << m_extension;
-    m_image_name = ss.str();
-  }
-
+  m_image_name = formatImageName(m_image_number);
   m_image_number_next += m_image_step;
 
   std::string extension = vpIoTools::toLowerCase(vpIoTools::getFileExtension(m_image_name, true));
@@ -205,20 +401,10 @@ void vpDiskGrabber::acquire(vpImage<float> &I)
 void vpDiskGrabber::acquire(vpImage<unsigned char> &I, long image_number)
 {
   m_image_number = image_number;
-
-  if (m_use_generic_name) {
-    m_image_name = vpIoTools::formatString(m_generic_name, static_cast<unsigned int>(m_image_number));
-  }
-  else {
-    std::stringstream ss;
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(static_cast<int>(m_number_of_zero)) << m_image_number << "."
-      << m_extension;
-    m_image_name = ss.str();
-  }
-
+  m_image_name = formatImageName(m_image_number);
   m_image_number_next = m_image_number + m_image_step;
 
-  vpImageIo::read(I, m_image_name);
+  readImage(I);
 
   width = I.getWidth();
   height = I.getHeight();
@@ -227,20 +413,10 @@ void vpDiskGrabber::acquire(vpImage<unsigned char> &I, long image_number)
 void vpDiskGrabber::acquire(vpImage<vpRGBa> &I, long image_number)
 {
   m_image_number = image_number;
-
-  if (m_use_generic_name) {
-    m_image_name = vpIoTools::formatString(m_generic_name, static_cast<unsigned int>(m_image_number));
-  }
-  else {
-    std::stringstream ss;
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(static_cast<int>(m_number_of_zero)) << m_image_number << "."
-      << m_extension;
-    m_image_name = ss.str();
-  }
-
+  m_image_name = formatImageName(m_image_number);
   m_image_number_next = m_image_number + m_image_step;
 
-  vpImageIo::read(I, m_image_name);
+  readImage(I);
 
   width = I.getWidth();
   height = I.getHeight();
@@ -249,17 +425,7 @@ void vpDiskGrabber::acquire(vpImage<vpRGBa> &I, long image_number)
 void vpDiskGrabber::acquire(vpImage<float> &I, long image_number)
 {
   m_image_number = m_image_number_next;
-
-  if (m_use_generic_name) {
-    m_image_name = vpIoTools::formatString(m_generic_name, static_cast<unsigned int>(m_image_number));
-  }
-  else {
-    std::stringstream ss;
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(static_cast<int>(m_number_of_zero)) << image_number << "."
-      << m_extension;
-    m_image_name = ss.str();
-  }
-
+  m_image_name = formatImageName(image_number);
   m_image_number_next += m_image_step;
 
   vpImageIo::readPFM(I, m_image_name);
@@ -268,6 +434,71 @@ void vpDiskGrabber::acquire(vpImage<float> &I, long image_number)
   height = I.getHeight();
 }
 
+void vpDiskGrabber::close()
+{
+#if defined(VISP_HAVE_THREADS)
+  if (m_prefetcher != nullptr) {
+    delete m_prefetcher;
+    m_prefetcher = nullptr;
+  }
+#endif
+}
+
+/*!
+ * Build the name of the file that contains the image with number \e image_number.
+ */
+std::string vpDiskGrabber::formatImageName(long image_number) const
+{
+  if (m_use_generic_name) {
+    return vpIoTools::formatString(m_generic_name, static_cast<unsigned int>(image_number));
+  }
+  std::stringstream ss;
+  ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(static_cast<int>(m_number_of_zero))
+    << image_number << "." << m_extension;
+  return ss.str();
+}
+
+/*!
+ * Read the image from file getImageName(), or get it from the images decoded in advance, and update the decoding
+ * statistics. Then request the decoding of the next images of the sequence.
+ */
+template <class Type> void vpDiskGrabber::readImage(vpImage<Type> &I)
+{
+  double t = vpTime::measureTimeMs();
+  bool prefetched = false;
+#if defined(VISP_HAVE_THREADS)
+  if ((m_prefetcher == nullptr) && (m_prefetch_size > 0)) {
+    m_prefetcher = new vpPrefetcher(m_prefetch_threads, m_prefetch_size);
+  }
+  if (m_prefetcher != nullptr) {
+    prefetched = m_prefetcher->take(m_image_name, I, m_decode_time);
+  }
+#endif
+  if (!prefetched) {
+    vpImageIo::read(I, m_image_name);
+  }
+  m_wait_time = vpTime::measureTimeMs() - t;
+  if (!prefetched) {
+    m_decode_time = m_wait_time;
+  }
+  m_decode_time_sum += m_decode_time;
+  ++m_decode_count;
+
+#if defined(VISP_HAVE_THREADS)
+  if (m_prefetcher != nullptr) {
+    std::vector<std::string> next_names;
+    for (unsigned int i = 1; i <= m_prefetch_size; ++i) {
+      long next_number = m_image_number + (static_cast<long>(i) * m_image_step);
+      if (next_number < 0) {
+        break;
+      }
+      next_names.push_back(formatImageName(next_number));
+    }
+    m_prefetcher->request(next_names, I);
+  }
+#endif
+}
+
 void vpDiskGrabber::setImageNumber(long number)
 {
   m_image_number = number;
@@ -280,4 +511,20 @@ void vpDiskGrabber::setGenericName(const std::string &generic_name)
   m_use_generic_name = true;
 }
 
+void vpDiskGrabber::setPrefetch(unsigned int nb_frames, unsigned int nb_threads)
+{
+  if ((nb_frames > 0) && (nb_threads == 0)) {
+    throw(vpException(vpException::badValue, "Disk grabber read-ahead needs at least 1 decoding thread"));
+  }
+  if ((nb_frames != m_prefetch_size) || (nb_threads != m_prefetch_threads)) {
+    close();
+  }
+#if defined(VISP_HAVE_THREADS)
+  m_prefetch_size = nb_frames;
+#else
+  m_prefetch_size = 0;
+#endif
+  m_prefetch_threads = nb_threads;
+}
+
 END_VISP_NAMESPACE
@@ -57,7 +57,7 @@ BEGIN_VISP_NAMESPACE
 #endif
   m_formatType(FORMAT_UNKNOWN), m_videoName(), m_frameName(), m_initFileName(false), m_isOpen(false), m_frameCount(0),
   m_firstFrame(0), m_lastFrame(0), m_firstFrameIndexIsSet(false), m_lastFrameIndexIsSet(false), m_frameStep(1),
-  m_frameRate(0.)
+  m_frameRate(0.), m_prefetchSize(0), m_prefetchThreads(1)
 { }
 
 /*!
@@ -103,6 +103,8 @@ vpVideoReader &vpVideoReader::operator=(const vpVideoReader &reader)
   m_lastFrameIndexIsSet = reader.m_lastFrameIndexIsSet;
   m_frameStep = reader.m_frameStep;
   m_frameRate = reader.m_frameRate;
+  m_prefetchSize = reader.m_prefetchSize;
+  m_prefetchThreads = reader.m_prefetchThreads;
   return *this;
 }
 
@@ -163,6 +165,7 @@ void vpVideoReader::getProperties()
     m_imSequence = new vpDiskGrabber;
     m_imSequence->setGenericName(m_videoName.c_str());
     m_imSequence->setStep(m_frameStep);
+    m_imSequence->setPrefetch(m_prefetchSize, m_prefetchThreads);
     if (m_firstFrameIndexIsSet) {
       m_imSequence->setImageNumber(m_firstFrame);
     }
@@ -966,4 +969,58 @@ bool vpVideoReader::isVideoFormat() const
   }
 }
 
+/*!
+  Enables the read-ahead of the next images when reading a sequence of images: while acquire() returns the current
+  image, the next \e nb_frames images are decoded by \e nb_threads background threads into a pool of recycled images.
+  When getFrame() jumps to another frame, the images decoded in advance that are no longer needed are recycled and the
+  read-ahead restarts from the new frame index. See vpDiskGrabber::setPrefetch() for more details.
+
+  Read-ahead has no effect when reading a video file.
+
+  \param nb_frames : Number of images decoded in advance. Set to 0 to disable read-ahead.
+  \param nb_threads : Number of decoding threads.
+
+  \sa getDecodeTime(), getMeanDecodeTime(), getWaitTime()
+*/
+void vpVideoReader::setPrefetch(unsigned int nb_frames, unsigned int nb_threads)
+{
+  if (m_imSequence != nullptr) {
+    m_imSequence->setPrefetch(nb_frames, nb_threads);
+    m_prefetchSize = m_imSequence->getPrefetchSize();
+  }
+  else {
+    if ((nb_frames > 0) && (nb_threads == 0)) {
+      throw(vpException(vpException::badValue, "Video reader read-ahead needs at least 1 decoding thread"));
+    }
+    m_prefetchSize = nb_frames;
+  }
+  m_prefetchThreads = nb_threads;
+}
+
+/*!
+  Return the time in ms that was needed to decode the last image of a sequence of images, whether it was decoded in
+  advance or by acquire(). Return 0 when reading a video file.
+*/
+double vpVideoReader::getDecodeTime() const
+{
+  return (m_imSequence != nullptr) ? m_imSequence->getDecodeTime() : 0.;
+}
+
+/*!
+  Return the mean time in ms needed to decode an image of a sequence of images. Return 0 when reading a video file.
+*/
+double vpVideoReader::getMeanDecodeTime() const
+{
+  return (m_imSequence != nullptr) ? m_imSequence->getMeanDecodeTime() : 0.;
+}
+
+/*!
+  Return the time in ms spent by the last acquire() to get an image of a sequence of images. With read-ahead it is
+  close to zero when the image was already decoded. Return 0 when reading a video file.
+*/
+double vpVideoReader::getWaitTime() const
+{
+  return (m_imSequence != nullptr) ? m_imSequence->getWaitTime() : 0.;
+}
+
 END_VISP_NAMESPACE
@@ -43,8 +43,228 @@
 #include <opencv2/imgproc/imgproc.hpp>
 #endif
 
+#if defined(VISP_HAVE_THREADS)
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
 BEGIN_VISP_NAMESPACE
 
+#if defined(VISP_HAVE_THREADS)
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*!
+  Pool of preallocated frames and encoder threads used by vpVideoWriter in asynchronous mode.
+
+  The producer takes a free frame of the pool, copies the image into it and pushes it in the FIFO of pending frames.
+  The workers pop the pending frames, write them and give them back to the pool. An error raised by a worker is kept
+  and thrown to the producer by the next call to push() or flush().
+*/
+class vpVideoWriter::vpAsyncWriter
+{
+public:
+  vpAsyncWriter(vpVideoWriter &writer, unsigned int nbWorkers, unsigned int poolSize, vpAsyncFullPolicy policy,
+                const vpImage<unsigned char> *I_grey, const vpImage<vpRGBa> *I_color)
+    : m_writer(writer), m_policy(policy), m_frames(poolSize), m_free(), m_pending(), m_inProgress(0), m_maxDepth(0),
+    m_dropped(0), m_running(true), m_error(), m_mutex(), m_condPending(), m_condFree(), m_workers()
+  {
+    for (unsigned int i = 0; i < poolSize; ++i) {
+      // Preallocate the frames with the size of the image given to open()
+      if (I_grey != nullptr) {
+        m_frames[i].I_grey.resize(I_grey->getHeight(), I_grey->getWidth());
+      }
+      if (I_color != nullptr) {
+        m_frames[i].I_color.resize(I_color->getHeight(), I_color->getWidth());
+      }
+      m_free.push_back(poolSize - 1 - i);
+    }
+    for (unsigned int i = 0; i < nbWorkers; ++i) {
+      m_workers.push_back(std::thread(&vpAsyncWriter::run, this));
+    }
+  }
+
+  ~vpAsyncWriter() { stop(); }
+
+  unsigned int getDroppedFrameCount() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dropped;
+  }
+
+  unsigned int getMaxQueueDepth() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxDepth;
+  }
+
+  unsigned int getQueueDepth() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return depth();
+  }
+
+  bool isRunning() const { return m_running; }
+
+  /*!
+    Wait until all the pending frames are written.
+  */
+  void flush()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while ((depth() > 0) && !m_workers.empty()) {
+      m_condFree.wait(lock);
+    }
+    throwError();
+  }
+
+  /*!
+    Queue a copy of the image to be written in \e frameName.
+    \return false if the frame was dropped because the pool is full.
+  */
+  template <class Type> bool push(const vpImage<Type> &I, const std::string &frameName)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    throwError();
+    if (m_free.empty()) {
+      if (m_policy == ASYNC_DROP_WHEN_FULL) {
+        ++m_dropped;
+        return false;
+      }
+      while (m_free.empty() && m_error.empty()) {
+        m_condFree.wait(lock);
+      }
+      throwError();
+    }
+    const size_t index = m_free.back();
+    m_free.pop_back();
+    lock.unlock();
+
+    // The frame is owned by the producer until it is pushed in the pending FIFO
+    vpFrame &frame = m_frames[index];
+    copy(I, frame);
+    frame.name = frameName;
+
+    lock.lock();
+    m_pending.push_back(index);
+    m_maxDepth = std::max(m_maxDepth, depth());
+    lock.unlock();
+    m_condPending.notify_one();
+    return true;
+  }
+
+  /*!
+    Write the pending frames and stop the workers.
+  */
+  void stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_running = false;
+    }
+    m_condPending.notify_all();
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+      m_workers[i].join();
+    }
+    m_workers.clear();
+  }
+
+private:
+  struct vpFrame
+  {
+    vpFrame() : I_grey(), I_color(), isColor(false), name() { }
+
+    vpImage<unsigned char> I_grey;
+    vpImage<vpRGBa> I_color;
+    bool isColor;
+    std::string name;
+  };
+
+  static void copy(const vpImage<unsigned char> &I, vpFrame &frame)
+  {
+    frame.I_grey = I;
+    frame.isColor = false;
+  }
+
+  static void copy(const vpImage<vpRGBa> &I, vpFrame &frame)
+  {
+    frame.I_color = I;
+    frame.isColor = true;
+  }
+
+  //! Number of frames waiting or being written, to call with the mutex locked
+  unsigned int depth() const { return static_cast<unsigned int>(m_pending.size()) + m_inProgress; }
+
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+      while (m_pending.empty() && m_running) {
+        m_condPending.wait(lock);
+      }
+      if (m_pending.empty()) {
+        // Stopped and all the frames are written
+        return;
+      }
+      const size_t index = m_pending.front();
+      m_pending.pop_front();
+      ++m_inProgress;
+      lock.unlock();
+
+      std::string error;
+      const vpFrame &frame = m_frames[index];
+      try {
+        if (frame.isColor) {
+          m_writer.writeFrame(frame.I_color, frame.name);
+        }
+        else {
+          m_writer.writeFrame(frame.I_grey, frame.name);
+        }
+      }
+      catch (const std::exception &e) {
+        error = e.what();
+      }
+
+      lock.lock();
+      if (!error.empty() && m_error.empty()) {
+        m_error = error;
+      }
+      --m_inProgress;
+      m_free.push_back(index);
+      m_condFree.notify_all();
+    }
+  }
+
+  //! Throw the error raised by a worker if any, to call with the mutex locked
+  void throwError()
+  {
+    if (!m_error.empty()) {
+      std::string error = m_error;
+      m_error.clear();
+      throw(vpException(vpException::ioError, "Asynchronous video writer: " + error));
+    }
+  }
+
+  vpVideoWriter &m_writer;
+  vpAsyncFullPolicy m_policy;
+  std::vector<vpFrame> m_frames;
+  std::vector<size_t> m_free;
+  std::deque<size_t> m_pending;
+  unsigned int m_inProgress;
+  unsigned int m_maxDepth;
+  unsigned int m_dropped;
+  bool m_running;
+  std::string m_error;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_condPending;
+  std::condition_variable m_condFree;
+  std::vector<std::thread> m_workers;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+#endif
+
 /*!
   Basic constructor.
 */
@@ -56,7 +276,8 @@ vpVideoWriter::vpVideoWriter()
   m_writer(), m_framerate(25.0),
 #endif
   m_formatType(FORMAT_UNKNOWN), m_videoName(), m_frameName(), m_initFileName(false), m_isOpen(false), m_frameCount(0),
-  m_firstFrame(0), m_width(0), m_height(0), m_frameStep(1)
+  m_firstFrame(0), m_width(0), m_height(0), m_frameStep(1), m_asyncWorkers(0), m_asyncPoolSize(8),
+  m_asyncPolicy(ASYNC_BLOCK_WHEN_FULL), m_async(nullptr)
 {
 #if defined(VISP_HAVE_OPENCV) && \
     (((VISP_HAVE_OPENCV_VERSION < 0x030000) && defined(HAVE_OPENCV_HIGHGUI)) || \
@@ -72,7 +293,7 @@ vpVideoWriter::vpVideoWriter()
 /*!
   Basic destructor.
 */
-vpVideoWriter::~vpVideoWriter() {}
+vpVideoWriter::~vpVideoWriter() { stopAsynchronous(); }
 
 /*!
   It enables to set the path and the name of the video or sequence of images
@@ -145,6 +366,10 @@ void vpVideoWriter::open(vpImage<vpRGBa> &I)
 
   m_frameCount = m_firstFrame;
 
+  if (m_asyncWorkers > 0) {
+    startAsynchronous(nullptr, &I);
+  }
+
   m_isOpen = true;
 }
 
@@ -187,6 +412,10 @@ void vpVideoWriter::open(vpImage<unsigned char> &I)
 
   m_frameCount = m_firstFrame;
 
+  if (m_asyncWorkers > 0) {
+    startAsynchronous(&I, nullptr);
+  }
+
   m_isOpen = true;
 }
 
@@ -205,20 +434,21 @@ void vpVideoWriter::saveFrame(vpImage<vpRGBa> &I)
     throw(vpException(vpException::notInitialized, "The video has to be open first with video writer open() method"));
   }
 
-  if (m_formatType == FORMAT_PGM || m_formatType == FORMAT_PPM || m_formatType == FORMAT_JPEG ||
-      m_formatType == FORMAT_PNG) {
-    m_frameName = vpIoTools::formatString(m_videoName, static_cast<unsigned int>(m_frameCount));
-    vpImageIo::write(I, m_frameName);
+  std::string frameName = m_frameName;
+  if (isImageSequence()) {
+    frameName = vpIoTools::formatString(m_videoName, static_cast<unsigned int>(m_frameCount));
   }
-  else {
-#if defined(VISP_HAVE_OPENCV) && \
-    (((VISP_HAVE_OPENCV_VERSION < 0x030000) && defined(HAVE_OPENCV_HIGHGUI)) || \
-     ((VISP_HAVE_OPENCV_VERSION >= 0x030000) && defined(HAVE_OPENCV_VIDEOIO)))
-    cv::Mat matFrame;
-    vpImageConvert::convert(I, matFrame);
-    m_writer << matFrame;
-#endif
+#if defined(VISP_HAVE_THREADS)
+  if ((m_async != nullptr) && m_async->isRunning()) {
+    if (m_async->push(I, frameName)) {
+      m_frameName = frameName;
+    }
+    m_frameCount += m_frameStep;
+    return;
   }
+#endif
+  writeFrame(I, frameName);
+  m_frameName = frameName;
 
   m_frameCount += m_frameStep;
 }
@@ -238,10 +468,57 @@ void vpVideoWriter::saveFrame(vpImage<unsigned char> &I)
     throw(vpException(vpException::notInitialized, "The video has to be open first with video writer open() method"));
   }
 
-  if (m_formatType == FORMAT_PGM || m_formatType == FORMAT_PPM || m_formatType == FORMAT_JPEG ||
-      m_formatType == FORMAT_PNG) {
-    m_frameName = vpIoTools::formatString(m_videoName, static_cast<unsigned int>(m_frameCount));
-    vpImageIo::write(I, m_frameName);
+  std::string frameName = m_frameName;
+  if (isImageSequence()) {
+    frameName = vpIoTools::formatString(m_videoName, static_cast<unsigned int>(m_frameCount));
+  }
+#if defined(VISP_HAVE_THREADS)
+  if ((m_async != nullptr) && m_async->isRunning()) {
+    if (m_async->push(I, frameName)) {
+      m_frameName = frameName;
+    }
+    m_frameCount += m_frameStep;
+    return;
+  }
+#endif
+  writeFrame(I, frameName);
+  m_frameName = frameName;
+
+  m_frameCount += m_frameStep;
+}
+
+/*!
+  Writes the image in a file of the image sequence or as a frame of the video.
+
+  \param I : The image which has to be saved.
+  \param frameName : The name of the file when an image sequence is written.
+*/
+void vpVideoWriter::writeFrame(const vpImage<vpRGBa> &I, const std::string &frameName)
+{
+  if (isImageSequence()) {
+    vpImageIo::write(I, frameName);
+  }
+  else {
+#if defined(VISP_HAVE_OPENCV) && \
+    (((VISP_HAVE_OPENCV_VERSION < 0x030000) && defined(HAVE_OPENCV_HIGHGUI)) || \
+     ((VISP_HAVE_OPENCV_VERSION >= 0x030000) && defined(HAVE_OPENCV_VIDEOIO)))
+    cv::Mat matFrame;
+    vpImageConvert::convert(I, matFrame);
+    m_writer << matFrame;
+#endif
+  }
+}
+
+/*!
+  Writes the image in a file of the image sequence or as a frame of the video.
+
+  \param I : The image which has to be saved.
+  \param frameName : The name of the file when an image sequence is written.
+*/
+void vpVideoWriter::writeFrame(const vpImage<unsigned char> &I, const std::string &frameName)
+{
+  if (isImageSequence()) {
+    vpImageIo::write(I, frameName);
   }
   else {
 #if defined(VISP_HAVE_OPENCV) && \
@@ -260,18 +537,152 @@ void vpVideoWriter::saveFrame(vpImage<unsigned char> &I)
 #endif
 #endif
   }
-
-  m_frameCount += m_frameStep;
 }
 
 /*!
   Deallocates parameters use to write the video or the image sequence.
+
+  In asynchronous mode, waits until all the queued frames are written and stops the worker threads.
+  The statistics (getDroppedFrameCount(), getMaxQueueDepth()) remain available until the next call to open().
 */
 void vpVideoWriter::close()
 {
   if (!m_isOpen) {
     throw(vpException(vpException::notInitialized, "Cannot close video writer: not yet opened"));
   }
+#if defined(VISP_HAVE_THREADS)
+  if (m_async != nullptr) {
+    m_async->stop();
+    m_async->flush();
+  }
+#endif
+}
+
+/*!
+  In asynchronous mode, waits until all the frames queued by saveFrame() are written. Does nothing otherwise.
+
+  \exception vpException::ioError : If a frame could not be written by a worker thread.
+*/
+void vpVideoWriter::flush()
+{
+#if defined(VISP_HAVE_THREADS)
+  if (m_async != nullptr) {
+    m_async->flush();
+  }
+#endif
+}
+
+/*!
+  Switches the writer in asynchronous mode: saveFrame() copies the image into a pool of preallocated frames and
+  returns immediately, while \e nb_workers threads write the frames.
+
+  The names of the files of an image sequence are given when saveFrame() is called, so that the files follow the
+  order of the calls whatever the worker that writes them. A video file (AVI, MPEG, MPEG4, MOV) is encoded by a single
+  worker to keep the frames in order. When a frame is dropped, the frame counter is still incremented so that the
+  dropped frames appear as missing indexes in an image sequence.
+
+  This function has to be called before open(). When ViSP is built without threads support, the frames are always
+  written synchronously.
+
+  \param nb_workers : Number of encoder threads. 0 to write the frames synchronously, which is the default.
+  \param pool_size : Number of preallocated frames, that is the maximum number of frames waiting to be written.
+  \param policy : Behavior of saveFrame() when all the frames of the pool are waiting to be written.
+*/
+void vpVideoWriter::setAsynchronous(unsigned int nb_workers, unsigned int pool_size, vpAsyncFullPolicy policy)
+{
+  if (m_isOpen) {
+    throw(vpException(vpException::fatalError, "Video writer asynchronous mode has to be set before open()"));
+  }
+  if ((nb_workers > 0) && (pool_size == 0)) {
+    throw(vpException(vpException::badValue, "Video writer asynchronous mode needs a frame pool of at least 1 frame"));
+  }
+#if defined(VISP_HAVE_THREADS)
+  m_asyncWorkers = nb_workers;
+#else
+  m_asyncWorkers = 0;
+#endif
+  m_asyncPoolSize = pool_size;
+  m_asyncPolicy = policy;
+}
+
+/*!
+  Returns the number of frames dropped by saveFrame() in asynchronous mode with the
+  vpVideoWriter::ASYNC_DROP_WHEN_FULL policy since open().
+*/
+unsigned int vpVideoWriter::getDroppedFrameCount() const
+{
+#if defined(VISP_HAVE_THREADS)
+  if (m_async != nullptr) {
+    return m_async->getDroppedFrameCount();
+  }
+#endif
+  return 0;
+}
+
+/*!
+  Returns the maximum number of frames that were waiting or being written at the same time in asynchronous mode
+  since open().
+*/
+unsigned int vpVideoWriter::getMaxQueueDepth() const
+{
+#if defined(VISP_HAVE_THREADS)
+  if (m_async != nullptr) {
+    return m_async->getMaxQueueDepth();
+  }
+#endif
+  return 0;
+}
+
+/*!
+  Returns the number of frames that are waiting or being written in asynchronous mode.
+*/
+unsigned int vpVideoWriter::getQueueDepth() const
+{
+#if defined(VISP_HAVE_THREADS)
+  if (m_async != nullptr) {
+    return m_async->getQueueDepth();
+  }
+#endif
+  return 0;
+}
+
+/*!
+  Returns true if an image sequence is written, false if it is a video file.
+*/
+bool vpVideoWriter::isImageSequence() const
+{
+  return (m_formatType == FORMAT_PGM) || (m_formatType == FORMAT_PPM) || (m_formatType == FORMAT_JPEG) ||
+    (m_formatType == FORMAT_PNG);
+}
+
+/*!
+  Creates the frame pool and starts the worker threads of the asynchronous mode.
+  Only one of \e I_grey and \e I_color is not nullptr, it gives the size of the frames to preallocate.
+*/
+void vpVideoWriter::startAsynchronous(const vpImage<unsigned char> *I_grey, const vpImage<vpRGBa> *I_color)
+{
+  stopAsynchronous();
+#if defined(VISP_HAVE_THREADS)
+  // Frames of a video file have to be encoded in order
+  unsigned int nbWorkers = isImageSequence() ? m_asyncWorkers : 1;
+  m_async = new vpAsyncWriter(*this, nbWorkers, m_asyncPoolSize, m_asyncPolicy, I_grey, I_color);
+#else
+  (void)I_grey;
+  (void)I_color;
+#endif
+}
+
+/*!
+  Writes the pending frames and stops the worker threads of the asynchronous mode.
+*/
+void vpVideoWriter::stopAsynchronous()
+{
+#if defined(VISP_HAVE_THREADS)
+  if (m_async != nullptr) {
+    delete m_async;
+    m_async = nullptr;
+  }
+#endif
 }
 
 /*!
@@ -47,6 +47,8 @@
 #endif
 
 #include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpDiskGrabber.h>
+#include <visp3/io/vpImageIo.h>
 #include <visp3/io/vpVideoReader.h>
 #include <visp3/io/vpVideoWriter.h>
 
@@ -163,6 +165,139 @@ TEST_CASE("Test saving sequence of color images with step 2", "[color]")
   }
 }
 
+TEST_CASE("Test asynchronous saving of a sequence of images", "[async]")
+{
+  const std::string videoname = tmp + std::string("/async/I%04d.pgm");
+  const unsigned int nb_frames = 20;
+  vpImage<unsigned char> I(24, 32);
+
+  SECTION("Block when the pool is full")
+  {
+    vpVideoWriter writer;
+    writer.setFileName(videoname);
+    writer.setAsynchronous(3, 2, vpVideoWriter::ASYNC_BLOCK_WHEN_FULL);
+    writer.open(I);
+    for (unsigned int i = 0; i < nb_frames; ++i) {
+      I = static_cast<unsigned char>(i * 10);
+      writer.saveFrame(I);
+      CHECK(writer.getQueueDepth() <= 2);
+    }
+    writer.close();
+    CHECK(writer.getQueueDepth() == 0);
+    CHECK(writer.getMaxQueueDepth() <= 2);
+    CHECK(writer.getDroppedFrameCount() == 0);
+
+    // All the frames are written in order
+    for (unsigned int i = 0; i < nb_frames; ++i) {
+      vpImage<unsigned char> I_read;
+      vpImageIo::read(I_read, vpIoTools::formatString(videoname, i));
+      CHECK(I_read == vpImage<unsigned char>(24, 32, static_cast<unsigned char>(i * 10)));
+    }
+  }
+
+  SECTION("Drop when the pool is full")
+  {
+    vpVideoWriter writer;
+    writer.setFileName(videoname);
+    writer.setAsynchronous(1, 1, vpVideoWriter::ASYNC_DROP_WHEN_FULL);
+    writer.open(I);
+    for (unsigned int i = 0; i < nb_frames; ++i) {
+      writer.saveFrame(I);
+    }
+    writer.flush();
+    CHECK(writer.getQueueDepth() == 0);
+    CHECK(writer.getCurrentFrameIndex() == nb_frames);
+    writer.close();
+    CHECK(writer.getDroppedFrameCount() < nb_frames);
+  }
+
+  SECTION("Asynchronous mode has to be set before open()")
+  {
+    vpVideoWriter writer;
+    writer.setFileName(videoname);
+    writer.open(I);
+    CHECK_THROWS_AS(writer.setAsynchronous(2), vpException);
+  }
+}
+
+TEST_CASE("Test read-ahead of a sequence of images", "[prefetch]")
+{
+  const std::string dirname = tmp + std::string("/prefetch");
+  const std::string videoname = dirname + std::string("/I%04d.pgm");
+  const unsigned int nb_frames = 12;
+  vpIoTools::makeDirectory(dirname);
+  for (unsigned int i = 0; i < nb_frames; ++i) {
+    vpImage<unsigned char> I(24, 32, static_cast<unsigned char>(i * 10));
+    vpImageIo::write(I, vpIoTools::formatString(videoname, i));
+  }
+
+  SECTION("Read the sequence with vpDiskGrabber")
+  {
+    vpDiskGrabber grabber(videoname);
+    grabber.setPrefetch(3, 2);
+    CHECK(grabber.getPrefetchSize() == 3);
+    vpImage<unsigned char> I;
+    grabber.open(I);
+    for (unsigned int i = 0; i < nb_frames; ++i) {
+      grabber.acquire(I);
+      CHECK(grabber.getImageNumber() == static_cast<long>(i));
+      CHECK(I == vpImage<unsigned char>(24, 32, static_cast<unsigned char>(i * 10)));
+      CHECK(grabber.getDecodeTime() >= 0.);
+      CHECK(grabber.getWaitTime() >= 0.);
+    }
+    CHECK(grabber.getMeanDecodeTime() >= 0.);
+    // Reading past the end of the sequence raises the same error as without read-ahead
+    CHECK_THROWS(grabber.acquire(I));
+  }
+
+  SECTION("Switch between grey and color images")
+  {
+    vpDiskGrabber grabber(videoname);
+    grabber.setPrefetch(4);
+    vpImage<unsigned char> I_grey;
+    vpImage<vpRGBa> I_color;
+    for (unsigned int i = 0; i < nb_frames; ++i) {
+      const unsigned char value = static_cast<unsigned char>(i * 10);
+      if (i % 3 == 2) {
+        grabber.acquire(I_color);
+        CHECK(I_color == vpImage<vpRGBa>(24, 32, vpRGBa(value, value, value, vpRGBa::alpha_default)));
+      }
+      else {
+        grabber.acquire(I_grey);
+        CHECK(I_grey == vpImage<unsigned char>(24, 32, value));
+      }
+    }
+  }
+
+  SECTION("Seek in the sequence with vpVideoReader")
+  {
+    vpVideoReader reader;
+    reader.setFileName(videoname);
+    reader.setPrefetch(3, 2);
+    vpImage<unsigned char> I;
+    reader.open(I);
+    reader.acquire(I);
+    reader.acquire(I);
+    CHECK(reader.getFrameIndex() == 1);
+
+    CHECK(reader.getFrame(I, 7));
+    CHECK(I == vpImage<unsigned char>(24, 32, static_cast<unsigned char>(70)));
+    // After getFrame() the next acquire() reads the same frame again
+    reader.acquire(I);
+    CHECK(reader.getFrameIndex() == 7);
+    reader.acquire(I);
+    CHECK(reader.getFrameIndex() == 8);
+    CHECK(I == vpImage<unsigned char>(24, 32, static_cast<unsigned char>(80)));
+
+    CHECK(reader.getFrame(I, 2));
+    CHECK(I == vpImage<unsigned char>(24, 32, static_cast<unsigned char>(20)));
+    reader.acquire(I);
+    reader.acquire(I);
+    CHECK(reader.getFrameIndex() == 3);
+    CHECK(I == vpImage<unsigned char>(24, 32, static_cast<unsigned char>(30)));
+  }
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session; // There must be exactly one instance
@@ -0,0 +1,234 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * KLT (Kanade-Lucas-Tomasi) feature tracker working directly on ViSP images.
+ */
+
+/*!
+  \file vpKlt.h
+
+  \brief KLT (Kanade-Lucas-Tomasi) feature tracker working directly on ViSP
+  images, without third-party dependency.
+*/
+
+#ifndef VP_KLT_H
+#define VP_KLT_H
+
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpColor.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImagePoint.h>
+#include <visp3/core/vpImagePyramid.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpKlt
+ *
+ * \ingroup module_klt
+ *
+ * \brief KLT (Kanade-Lucas-Tomasi) feature tracker implemented in ViSP, that does not require OpenCV.
+ *
+ * The features are detected with the Shi-Tomasi (or Harris) criterion and tracked from one image to the next one with
+ * the pyramidal implementation of the Lucas-Kanade optical flow. The parameters and the functions are the same as
+ * the ones of vpKltOpencv, except that the images and the features are ViSP types:
+ * \code
+ * vpKlt klt;
+ * klt.setMaxFeatures(300);
+ * klt.setWindowSize(5);
+ * klt.setQuality(0.01);
+ * klt.setMinDistance(5);
+ * klt.setPyramidLevels(3);
+ * klt.initTracking(I);
+ * while (...) {
+ *   // Acquire a new image I
+ *   klt.track(I);
+ * }
+ * \endcode
+ *
+ * The Gaussian pyramid of the last tracked image is kept and used as the pyramid of the previous image during the
+ * next call to track(), so that each image is decimated only once. When the same image is also processed by other
+ * algorithms, a vpImagePyramid can be passed to initTracking() and track() instead of the image, so that the levels
+ * are shared with the other consumers of the pyramid. The features are tracked in parallel when ViSP is
+ * built with OpenMP, see setNbThreads().
+*/
+class VISP_EXPORT vpKlt
+{
+public:
+  vpKlt();
+
+  void addFeature(const float &x, const float &y);
+  void addFeature(const long &id, const float &x, const float &y);
+  void addFeature(const vpImagePoint &ip);
+
+  void display(const vpImage<unsigned char> &I, const vpColor &color = vpColor::red, unsigned int thickness = 1) const;
+  void display(const vpImage<vpRGBa> &I, const vpColor &color = vpColor::red, unsigned int thickness = 1) const;
+
+  //! Get the size of the averaging block used to compute the detection criterion.
+  int getBlockSize() const { return m_blockSize; }
+  void getFeature(const int &index, long &id, float &x, float &y) const;
+  //! Get the list of current features.
+  std::vector<vpImagePoint> getFeatures() const { return m_points[1]; }
+  //! Get the unique id of each feature.
+  std::vector<long> getFeaturesId() const { return m_points_id; }
+  //! Get the free parameter of the Harris detector.
+  double getHarrisFreeParameter() const { return m_harris_k; }
+  //! Get the maximum number of features to detect.
+  int getMaxFeatures() const { return m_maxCount; }
+  //! Get the maximum number of iterations of the Lucas-Kanade optical flow at each pyramid level.
+  int getMaxIterations() const { return m_maxIter; }
+  //! Get the minimal distance between the detected features.
+  double getMinDistance() const { return m_minDistance; }
+  //! Get the minimal eigen value threshold used to reject the features that cannot be tracked.
+  double getMinEigThreshold() const { return m_minEigThreshold; }
+  //! Get the number of current features.
+  int getNbFeatures() const { return static_cast<int>(m_points[1].size()); }
+  //! Get the number of previous features.
+  int getNbPrevFeatures() const { return static_cast<int>(m_points[0].size()); }
+  //! Get the number of threads used to track the features.
+  unsigned int getNbThreads() const { return m_nbThreads; }
+  //! Get the list of previous features.
+  std::vector<vpImagePoint> getPrevFeatures() const { return m_points[0]; }
+  //! Get the maximal pyramid level.
+  int getPyramidLevels() const { return m_pyrMaxLevel; }
+  //! Get the quality level of the detected features.
+  double getQuality() const { return m_qualityLevel; }
+  //! Get the size of the search window at each pyramid level.
+  int getWindowSize() const { return m_winSize; }
+
+  void initTracking(const vpImage<unsigned char> &I, const vpImage<bool> *mask = nullptr);
+  void initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts);
+  void initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts, const std::vector<long> &ids);
+  void initTracking(const vpImagePyramid &pyramid, const vpImage<bool> *mask = nullptr);
+
+  /*!
+   * Set the size of the averaging block used to compute the detection criterion.
+   * \param blockSize : Block size, 3 by default.
+   */
+  void setBlockSize(int blockSize) { m_blockSize = blockSize; }
+  /*!
+   * Set the free parameter of the Harris detector.
+   * \param harris_k : Free parameter, 0.04 by default.
+   */
+  void setHarrisFreeParameter(double harris_k) { m_harris_k = harris_k; }
+  void setInitialGuess(const std::vector<vpImagePoint> &guess_pts);
+  void setInitialGuess(const std::vector<vpImagePoint> &init_pts, const std::vector<vpImagePoint> &guess_pts,
+                       const std::vector<long> &fid);
+  /*!
+   * Set the maximum number of features to detect. If there are more features, the strongest ones are kept.
+   * \param maxCount : Maximum number of features, 500 by default. 0 means no limit.
+   */
+  void setMaxFeatures(int maxCount) { m_maxCount = maxCount; }
+  /*!
+   * Set the maximum number of iterations of the Lucas-Kanade optical flow at each pyramid level.
+   * \param maxIter : Maximum number of iterations, 20 by default.
+   */
+  void setMaxIterations(int maxIter) { m_maxIter = maxIter; }
+  /*!
+   * Set the minimal Euclidean distance between the detected features.
+   * \param minDistance : Minimal distance in pixels, 15 by default.
+   */
+  void setMinDistance(double minDistance) { m_minDistance = minDistance; }
+  /*!
+   * Set the minimal eigen value threshold. The features for which the minimal eigen value of the spatial gradient
+   * matrix, divided by the number of pixels of the window and expressed with intensities in [0, 1], is lower than
+   * this threshold are considered as lost.
+   * \param minEigThreshold : Threshold, 1e-4 by default.
+   */
+  void setMinEigThreshold(double minEigThreshold) { m_minEigThreshold = minEigThreshold; }
+  /*!
+   * Set the number of threads used to track the features. Only effective when ViSP is built with OpenMP.
+   * \param nbThreads : Number of threads, 1 by default. 0 means that the number of threads is chosen by OpenMP.
+   */
+  void setNbThreads(unsigned int nbThreads) { m_nbThreads = nbThreads; }
+  /*!
+   * Set the maximal pyramid level. If the level is zero, only the original image is used.
+   * \param pyrMaxLevel : Pyramid level, 3 by default.
+   */
+  void setPyramidLevels(int pyrMaxLevel) { m_pyrMaxLevel = pyrMaxLevel; }
+  /*!
+   * Set the minimal accepted quality of the detected features, as a fraction of the best detection criterion in
+   * the image. The features whose criterion is lower are rejected.
+   * \param qualityLevel : Quality level, 0.01 by default.
+   */
+  void setQuality(double qualityLevel) { m_qualityLevel = qualityLevel; }
+  /*!
+   * Set the stop criterion of the Lucas-Kanade optical flow: the iterations stop when the displacement of the
+   * feature is lower than this threshold.
+   * \param epsilon : Threshold in pixels, 0.03 by default.
+   */
+  void setStopCriteriaEpsilon(double epsilon) { m_epsilon = epsilon; }
+  /*!
+   * Set to true to use the Harris criterion instead of the minimal eigen value to detect the features.
+   * \param useHarrisDetector : 0 to use the minimal eigen value, 1 to use the Harris criterion (default).
+   */
+  void setUseHarris(int useHarrisDetector) { m_useHarrisDetector = useHarrisDetector; }
+  /*!
+   * Set the size of the search window at each pyramid level.
+   * \param winSize : Window size, 10 by default.
+   */
+  void setWindowSize(int winSize) { m_winSize = winSize; }
+
+  void suppressFeature(const int &index);
+
+  void track(const vpImage<unsigned char> &I);
+  void track(const vpImagePyramid &pyramid);
+
+protected:
+  vpImagePyramid m_pyramid[2];           //!< Gaussian pyramid of the previous [0] and current [1] image
+  std::vector<vpImagePoint> m_points[2]; //!< Previous [0] and current [1] feature location
+  std::vector<long> m_points_id;         //!< Feature id
+  std::vector<unsigned char> m_status;   //!< Tracking status of each feature during the last call to track()
+  int m_maxCount;                        //!< Max number of features
+  int m_winSize;                         //!< Window size
+  double m_qualityLevel;                 //!< Quality level
+  double m_minDistance;                  //!< Min distance between features
+  double m_minEigThreshold;              //!< Min eigen value threshold
+  double m_harris_k;                     //!< Harris parameter
+  int m_blockSize;                       //!< Block size
+  int m_useHarrisDetector;               //!< 1 to use the Harris detector
+  int m_pyrMaxLevel;                     //!< Pyramid max level
+  int m_maxIter;                         //!< Max number of iterations of the optical flow
+  double m_epsilon;                      //!< Stop criterion of the optical flow
+  unsigned int m_nbThreads;              //!< Number of threads used to track the features
+  long m_next_points_id;                 //!< Id for the next feature
+  bool m_initial_guess;                  //!< true when initial guess is provided
+
+  void getPyramidLevels(const vpImagePyramid &pyramid, std::vector<const vpImage<unsigned char> *> &levels) const;
+  void detectFeatures(const vpImage<unsigned char> &I, const vpImage<bool> *mask,
+                      std::vector<vpImagePoint> &features) const;
+  bool trackFeature(const std::vector<const vpImage<unsigned char> *> &prevLevels,
+                    const std::vector<const vpImage<unsigned char> *> &nextLevels, const vpImagePoint &prevPt,
+                    vpImagePoint &nextPt, std::vector<float> &buffer) const;
+  void trackPyramids(const vpImagePyramid &pyramid);
+};
+END_VISP_NAMESPACE
+#endif
@@ -0,0 +1,729 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * KLT (Kanade-Lucas-Tomasi) feature tracker working directly on ViSP images.
+ */
+
+/*!
+  \file vpKlt.cpp
+
+  \brief KLT (Kanade-Lucas-Tomasi) feature tracker working directly on ViSP
+  images, without third-party dependency.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+#include <visp3/core/vpDisplay.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpTrackingException.h>
+#include <visp3/klt/vpKlt.h>
+
+#if defined(VISP_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+BEGIN_VISP_NAMESPACE
+
+namespace
+{
+/*!
+ * Candidate feature found by the detector.
+ */
+struct vpKltCandidate
+{
+  float m_response;
+  unsigned int m_i;
+  unsigned int m_j;
+};
+
+bool compareCandidates(const vpKltCandidate &a, const vpKltCandidate &b)
+{
+  // Index used as tie-break to get a deterministic ordering
+  if (a.m_response != b.m_response) {
+    return a.m_response > b.m_response;
+  }
+  if (a.m_i != b.m_i) {
+    return a.m_i < b.m_i;
+  }
+  return a.m_j < b.m_j;
+}
+
+/*!
+ * Sample a rows x cols patch of \e I with bilinear interpolation, the top left sample being at the sub-pixel
+ * location (\e top + \e b, \e left + \e a). The interpolation weights are the same for all the samples, so that the
+ * inner loop only works on contiguous memory and can be vectorized by the compiler.
+ */
+void samplePatch(const vpImage<unsigned char> &I, int top, int left, float a, float b, int rows, int cols,
+                 float *patch)
+{
+  const float w00 = (1.f - a) * (1.f - b);
+  const float w01 = a * (1.f - b);
+  const float w10 = (1.f - a) * b;
+  const float w11 = a * b;
+  for (int r = 0; r < rows; ++r) {
+    const unsigned char *s0 = I[top + r] + left;
+    const unsigned char *s1 = I[top + r + 1] + left;
+    float *dst = patch + (r * cols);
+    for (int c = 0; c < cols; ++c) {
+      dst[c] = (w00 * s0[c]) + (w01 * s0[c + 1]) + (w10 * s1[c]) + (w11 * s1[c + 1]);
+    }
+  }
+}
+}
+
+/*!
+ * Default constructor. The default parameters are the same as the ones of vpKltOpencv.
+ */
+vpKlt::vpKlt()
+  : m_pyramid(), m_points(), m_points_id(), m_status(), m_maxCount(500), m_winSize(10), m_qualityLevel(0.01),
+  m_minDistance(15), m_minEigThreshold(1e-4), m_harris_k(0.04), m_blockSize(3), m_useHarrisDetector(1),
+  m_pyrMaxLevel(3), m_maxIter(20), m_epsilon(0.03), m_nbThreads(1), m_next_points_id(0), m_initial_guess(false)
+{ }
+
+/*!
+ * Add a new feature to the list of tracked features. Its id is automatically computed.
+ * \param x : Feature coordinate along the image columns.
+ * \param y : Feature coordinate along the image rows.
+ */
+void vpKlt::addFeature(const float &x, const float &y)
+{
+  m_points[1].push_back(vpImagePoint(y, x));
+  m_points_id.push_back(m_next_points_id++);
+}
+
+/*!
+ * Add a new feature to the list of tracked features.
+ * \param id : Feature id. It should be unique.
+ * \param x : Feature coordinate along the image columns.
+ * \param y : Feature coordinate along the image rows.
+ */
+void vpKlt::addFeature(const long &id, const float &x, const float &y)
+{
+  m_points[1].push_back(vpImagePoint(y, x));
+  m_points_id.push_back(id);
+  if (id >= m_next_points_id) {
+    m_next_points_id = id + 1;
+  }
+}
+
+/*!
+ * Add a new feature to the list of tracked features. Its id is automatically computed.
+ * \param ip : Feature location.
+ */
+void vpKlt::addFeature(const vpImagePoint &ip)
+{
+  m_points[1].push_back(ip);
+  m_points_id.push_back(m_next_points_id++);
+}
+
+/*!
+ * Get the levels of a pyramid used to track the features, from the full resolution image at level 0 up to the level
+ * given by setPyramidLevels(). The levels smaller than the search window are not used.
+ * \param pyramid : Image pyramid. The missing levels are computed.
+ * \param levels : Pointers to the pyramid levels.
+ */
+void vpKlt::getPyramidLevels(const vpImagePyramid &pyramid, std::vector<const vpImage<unsigned char> *> &levels) const
+{
+  const unsigned int minSize = static_cast<unsigned int>(std::max<int>(m_winSize, 1)) + 4;
+  const unsigned int maxLevel = static_cast<unsigned int>(std::max<int>(m_pyrMaxLevel, 0));
+  levels.clear();
+  levels.push_back(&pyramid.getImage());
+  for (unsigned int level = 1; level <= maxLevel; ++level) {
+    if ((pyramid.getWidth(level) < minSize) || (pyramid.getHeight(level) < minSize)) {
+      break;
+    }
+    levels.push_back(&pyramid.getLevel(level));
+  }
+}
+
+/*!
+ * Detect the features with the minimal eigen value (Shi-Tomasi) or the Harris criterion.
+ * The candidates are the local maxima of the criterion above the quality level, and they are kept from the
+ * strongest to the weakest when they are far enough from the already accepted features.
+ */
+void vpKlt::detectFeatures(const vpImage<unsigned char> &I, const vpImage<bool> *mask,
+                           std::vector<vpImagePoint> &features) const
+{
+  features.clear();
+  const int height = static_cast<int>(I.getHeight());
+  const int width = static_cast<int>(I.getWidth());
+  const int half = std::max<int>(m_blockSize, 1) / 2;
+  const int border = half + 2;
+  if ((height <= (2 * border)) || (width <= (2 * border))) {
+    return;
+  }
+
+  // Products of the Sobel derivatives
+  const size_t size = static_cast<size_t>(height) * static_cast<size_t>(width);
+  std::vector<float> dxx(size, 0.f), dxy(size, 0.f), dyy(size, 0.f);
+  for (int i = 1; i < (height - 1); ++i) {
+    const unsigned char *r0 = I[i - 1];
+    const unsigned char *r1 = I[i];
+    const unsigned char *r2 = I[i + 1];
+    float *pxx = &dxx[static_cast<size_t>(i) * width];
+    float *pxy = &dxy[static_cast<size_t>(i) * width];
+    float *pyy = &dyy[static_cast<size_t>(i) * width];
+    for (int j = 1; j < (width - 1); ++j) {
+      const float gx = static_cast<float>((r0[j + 1] - r0[j - 1]) + (2 * (r1[j + 1] - r1[j - 1])) + (r2[j + 1] - r2[j - 1]));
+      const float gy = static_cast<float>((r2[j - 1] - r0[j - 1]) + (2 * (r2[j] - r0[j])) + (r2[j + 1] - r0[j + 1]));
+      pxx[j] = gx * gx;
+      pxy[j] = gx * gy;
+      pyy[j] = gy * gy;
+    }
+  }
+
+  // Criterion computed on the sum of the products over the block
+  std::vector<float> response(size, 0.f);
+  std::vector<float> sxx(static_cast<size_t>(width)), sxy(static_cast<size_t>(width)), syy(static_cast<size_t>(width));
+  float maxResponse = 0.f;
+  for (int i = border; i < (height - border); ++i) {
+    std::fill(sxx.begin(), sxx.end(), 0.f);
+    std::fill(sxy.begin(), sxy.end(), 0.f);
+    std::fill(syy.begin(), syy.end(), 0.f);
+    for (int k = -half; k <= half; ++k) {
+      const size_t offset = static_cast<size_t>(i + k) * width;
+      for (int j = 0; j < width; ++j) {
+        sxx[j] += dxx[offset + j];
+        sxy[j] += dxy[offset + j];
+        syy[j] += dyy[offset + j];
+      }
+    }
+    float *resp = &response[static_cast<size_t>(i) * width];
+    for (int j = border; j < (width - border); ++j) {
+      float a = 0.f, b = 0.f, c = 0.f;
+      for (int k = -half; k <= half; ++k) {
+        a += sxx[j + k];
+        b += sxy[j + k];
+        c += syy[j + k];
+      }
+      float r;
+      if (m_useHarrisDetector) {
+        r = ((a * c) - (b * b)) - (static_cast<float>(m_harris_k) * (a + c) * (a + c));
+      }
+      else {
+        r = 0.5f * ((a + c) - std::sqrt(((a - c) * (a - c)) + (4.f * b * b)));
+      }
+      resp[j] = r;
+      maxResponse = std::max<float>(maxResponse, r);
+    }
+  }
+  if (maxResponse <= 0.f) {
+    return;
+  }
+
+  // Local maxima above the quality threshold
+  const float threshold = static_cast<float>(m_qualityLevel) * maxResponse;
+  std::vector<vpKltCandidate> candidates;
+  for (int i = border; i < (height - border); ++i) {
+    const float *r0 = &response[static_cast<size_t>(i - 1) * width];
+    const float *r1 = &response[static_cast<size_t>(i) * width];
+    const float *r2 = &response[static_cast<size_t>(i + 1) * width];
+    for (int j = border; j < (width - border); ++j) {
+      const float r = r1[j];
+      if ((r > threshold) && (r >= r0[j - 1]) && (r >= r0[j]) && (r >= r0[j + 1]) && (r >= r1[j - 1]) &&
+          (r >= r1[j + 1]) && (r >= r2[j - 1]) && (r >= r2[j]) && (r >= r2[j + 1])) {
+        if ((mask == nullptr) || (*mask)[i][j]) {
+          vpKltCandidate candidate;
+          candidate.m_response = r;
+          candidate.m_i = static_cast<unsigned int>(i);
+          candidate.m_j = static_cast<unsigned int>(j);
+          candidates.push_back(candidate);
+        }
+      }
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(), compareCandidates);
+
+  // Keep the strongest candidates separated by at least the min distance, using a grid of cells whose size is the
+  // min distance so that only the neighbouring cells have to be checked
+  const double minDistance = std::max<double>(m_minDistance, 0.);
+  const double minDistance2 = minDistance * minDistance;
+  const int cellSize = std::max<int>(static_cast<int>(std::ceil(minDistance)), 1);
+  const int gridWidth = (width + cellSize - 1) / cellSize;
+  const int gridHeight = (height + cellSize - 1) / cellSize;
+  std::vector<std::vector<size_t> > grid(static_cast<size_t>(gridWidth) * static_cast<size_t>(gridHeight));
+  const size_t maxCount = m_maxCount > 0 ? static_cast<size_t>(m_maxCount) : candidates.size();
+  for (size_t c = 0; (c < candidates.size()) && (features.size() < maxCount); ++c) {
+    const int i = static_cast<int>(candidates[c].m_i);
+    const int j = static_cast<int>(candidates[c].m_j);
+    const int ci = i / cellSize;
+    const int cj = j / cellSize;
+    bool accepted = true;
+    if (minDistance > 0.) {
+      for (int gi = std::max<int>(ci - 1, 0); (gi <= std::min<int>(ci + 1, gridHeight - 1)) && accepted; ++gi) {
+        for (int gj = std::max<int>(cj - 1, 0); (gj <= std::min<int>(cj + 1, gridWidth - 1)) && accepted; ++gj) {
+          const std::vector<size_t> &cell = grid[(static_cast<size_t>(gi) * gridWidth) + gj];
+          for (size_t k = 0; k < cell.size(); ++k) {
+            const double di = features[cell[k]].get_i() - i;
+            const double dj = features[cell[k]].get_j() - j;
+            if (((di * di) + (dj * dj)) < minDistance2) {
+              accepted = false;
+              break;
+            }
+          }
+        }
+      }
+    }
+    if (accepted) {
+      grid[(static_cast<size_t>(ci) * gridWidth) + cj].push_back(features.size());
+      features.push_back(vpImagePoint(i, j));
+    }
+  }
+}
+
+/*!
+ * Display the features in the image.
+ * \param I : Image where to display the features.
+ * \param color : Color used to display the features.
+ * \param thickness : Thickness of the drawings.
+ */
+void vpKlt::display(const vpImage<unsigned char> &I, const vpColor &color, unsigned int thickness) const
+{
+  for (size_t i = 0; i < m_points[1].size(); ++i) {
+    vpImagePoint ip(vpMath::round(m_points[1][i].get_i()), vpMath::round(m_points[1][i].get_j()));
+    vpDisplay::displayCross(I, ip, 10, color, thickness);
+
+    std::ostringstream id;
+    id << m_points_id[i];
+    ip.set_u(vpMath::round(m_points[1][i].get_u() + 5));
+    vpDisplay::displayText(I, ip, id.str(), color);
+  }
+}
+
+/*!
+ * Display the features in the image.
+ * \param I : Image where to display the features.
+ * \param color : Color used to display the features.
+ * \param thickness : Thickness of the drawings.
+ */
+void vpKlt::display(const vpImage<vpRGBa> &I, const vpColor &color, unsigned int thickness) const
+{
+  for (size_t i = 0; i < m_points[1].size(); ++i) {
+    vpImagePoint ip(vpMath::round(m_points[1][i].get_i()), vpMath::round(m_points[1][i].get_j()));
+    vpDisplay::displayCross(I, ip, 10, color, thickness);
+
+    std::ostringstream id;
+    id << m_points_id[i];
+    ip.set_u(vpMath::round(m_points[1][i].get_u() + 5));
+    vpDisplay::displayText(I, ip, id.str(), color);
+  }
+}
+
+/*!
+ * Get the coordinates of a feature.
+ * \param index : Index of the feature.
+ * \param id : Feature id.
+ * \param x : Feature coordinate along the image columns.
+ * \param y : Feature coordinate along the image rows.
+ */
+void vpKlt::getFeature(const int &index, long &id, float &x, float &y) const
+{
+  if ((index < 0) || (static_cast<size_t>(index) >= m_points[1].size())) {
+    throw(vpException(vpException::badValue, "Feature [%d] doesn't exist", index));
+  }
+
+  x = static_cast<float>(m_points[1][static_cast<size_t>(index)].get_u());
+  y = static_cast<float>(m_points[1][static_cast<size_t>(index)].get_v());
+  id = m_points_id[static_cast<size_t>(index)];
+}
+
+/*!
+ * Detect the features in the image and initialize the tracker.
+ * \param I : Input image.
+ * \param mask : Optional mask. When not null, the features are only detected where the mask is true.
+ */
+void vpKlt::initTracking(const vpImage<unsigned char> &I, const vpImage<bool> *mask)
+{
+  m_next_points_id = 0;
+  m_initial_guess = false;
+
+  for (size_t i = 0; i < 2; ++i) {
+    m_points[i].clear();
+  }
+  m_points_id.clear();
+
+  m_pyramid[1].init(I);
+  m_pyramid[0].clear();
+
+  detectFeatures(I, mask, m_points[1]);
+  for (size_t i = 0; i < m_points[1].size(); ++i) {
+    m_points_id.push_back(m_next_points_id++);
+  }
+}
+
+/*!
+ * Detect the features in the original image of a pyramid and initialize the tracker.
+ * \param pyramid : Pyramid of the input image. The levels used by the tracker are computed in this pyramid, so that
+ * they are available to its other consumers. The images of the pyramid are shared, not copied, see vpImagePyramid.
+ * \param mask : Optional mask. When not null, the features are only detected where the mask is true.
+ */
+void vpKlt::initTracking(const vpImagePyramid &pyramid, const vpImage<bool> *mask)
+{
+  m_next_points_id = 0;
+  m_initial_guess = false;
+
+  for (size_t i = 0; i < 2; ++i) {
+    m_points[i].clear();
+  }
+  m_points_id.clear();
+
+  m_pyramid[1] = pyramid;
+  m_pyramid[0].clear();
+
+  detectFeatures(pyramid.getImage(), mask, m_points[1]);
+  for (size_t i = 0; i < m_points[1].size(); ++i) {
+    m_points_id.push_back(m_next_points_id++);
+  }
+}
+
+/*!
+ * Initialize the tracker with a list of features. Their ids are automatically computed.
+ * \param I : Input image.
+ * \param pts : Features to track.
+ */
+void vpKlt::initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts)
+{
+  m_initial_guess = false;
+  m_points[1] = pts;
+  m_next_points_id = 0;
+  m_points_id.clear();
+  for (size_t i = 0; i < m_points[1].size(); ++i) {
+    m_points_id.push_back(m_next_points_id++);
+  }
+
+  m_pyramid[1].init(I);
+  m_pyramid[0].clear();
+}
+
+/*!
+ * Initialize the tracker with a list of features and their ids.
+ * \param I : Input image.
+ * \param pts : Features to track.
+ * \param ids : Feature ids. When the size differs from the number of features, the ids are automatically computed.
+ */
+void vpKlt::initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts,
+                         const std::vector<long> &ids)
+{
+  m_initial_guess = false;
+  m_points[1] = pts;
+  m_points_id.clear();
+
+  if (ids.size() != pts.size()) {
+    m_next_points_id = 0;
+    for (size_t i = 0; i < m_points[1].size(); ++i) {
+      m_points_id.push_back(m_next_points_id++);
+    }
+  }
+  else {
+    long max = 0;
+    for (size_t i = 0; i < m_points[1].size(); ++i) {
+      m_points_id.push_back(ids[i]);
+      if (ids[i] > max) {
+        max = ids[i];
+      }
+    }
+    m_next_points_id = max + 1;
+  }
+
+  m_pyramid[1].init(I);
+  m_pyramid[0].clear();
+}
+
+/*!
+ * Set the initial guess of the location of the features in the next image.
+ * \param guess_pts : Guessed location of the current features.
+ */
+void vpKlt::setInitialGuess(const std::vector<vpImagePoint> &guess_pts)
+{
+  if (guess_pts.size() != m_points[1].size()) {
+    throw(vpException(vpException::badValue,
+                      "Cannot set initial guess: size feature vector [%d] "
+                      "and guess vector [%d] doesn't match",
+                      m_points[1].size(), guess_pts.size()));
+  }
+
+  m_points[0] = m_points[1];
+  m_points[1] = guess_pts;
+  m_initial_guess = true;
+}
+
+/*!
+ * Set the features to track and the initial guess of their location in the next image.
+ * \param init_pts : Location of the features in the previous image.
+ * \param guess_pts : Guessed location of the features in the next image.
+ * \param fid : Feature ids.
+ */
+void vpKlt::setInitialGuess(const std::vector<vpImagePoint> &init_pts, const std::vector<vpImagePoint> &guess_pts,
+                            const std::vector<long> &fid)
+{
+  if (guess_pts.size() != init_pts.size()) {
+    throw(vpException(vpException::badValue,
+                      "Cannot set initial guess: size init vector [%d] and "
+                      "guess vector [%d] doesn't match",
+                      init_pts.size(), guess_pts.size()));
+  }
+
+  m_points[0] = init_pts;
+  m_points[1] = guess_pts;
+  m_points_id = fid;
+  m_initial_guess = true;
+}
+
+/*!
+ * Remove a feature from the list of tracked features.
+ * \param index : Index of the feature to remove.
+ */
+void vpKlt::suppressFeature(const int &index)
+{
+  if ((index < 0) || (static_cast<size_t>(index) >= m_points[1].size())) {
+    throw(vpException(vpException::badValue, "Feature [%d] doesn't exist", index));
+  }
+
+  m_points[1].erase(m_points[1].begin() + index);
+  m_points_id.erase(m_points_id.begin() + index);
+}
+
+/*!
+ * Track the features in a new image. The features that cannot be tracked are removed.
+ * \param I : Input image.
+ */
+void vpKlt::track(const vpImage<unsigned char> &I)
+{
+  if (m_points[1].size() == 0) {
+    throw vpTrackingException(vpTrackingException::fatalError, "Not enough key points to track.");
+  }
+
+  // The pyramid of the previous image is the one used during the previous call
+  m_pyramid[0].swap(m_pyramid[1]);
+  m_pyramid[1].init(I);
+
+  trackPyramids(m_pyramid[1]);
+}
+
+/*!
+ * Track the features in a new image given by its pyramid. The features that cannot be tracked are removed.
+ * \param pyramid : Pyramid of the input image. The levels used by the tracker are computed in this pyramid, so that
+ * they are available to its other consumers. The pyramid is kept as the pyramid of the previous image for the next
+ * call, sharing its images instead of copying them, so that it can be initialized again or destroyed after this call.
+ */
+void vpKlt::track(const vpImagePyramid &pyramid)
+{
+  if (m_points[1].size() == 0) {
+    throw vpTrackingException(vpTrackingException::fatalError, "Not enough key points to track.");
+  }
+
+  // The pyramid of the previous image is the one used during the previous call
+  m_pyramid[0].swap(m_pyramid[1]);
+
+  trackPyramids(pyramid);
+  m_pyramid[1] = pyramid;
+}
+
+/*!
+ * Track the features from the pyramid of the previous image to the one of the current image, and remove the features
+ * that are lost.
+ * \param pyramid : Pyramid of the current image. The levels used by the tracker are computed in this pyramid.
+ */
+void vpKlt::trackPyramids(const vpImagePyramid &pyramid)
+{
+  if (m_initial_guess) {
+    m_initial_guess = false;
+  }
+  else {
+    std::swap(m_points[1], m_points[0]);
+    m_points[1] = m_points[0];
+  }
+
+  const vpImagePyramid &prevPyramid = (m_pyramid[0].getImage().getSize() == 0) ? pyramid : m_pyramid[0];
+
+  std::vector<const vpImage<unsigned char> *> prevLevels, nextLevels;
+  getPyramidLevels(prevPyramid, prevLevels);
+  getPyramidLevels(pyramid, nextLevels);
+
+  const int nbPoints = static_cast<int>(m_points[0].size());
+  m_status.assign(m_points[0].size(), 0);
+
+#if defined(VISP_HAVE_OPENMP)
+  const int nbThreads = (m_nbThreads == 0) ? omp_get_max_threads() : static_cast<int>(m_nbThreads);
+#pragma omp parallel num_threads(nbThreads) if (nbThreads > 1)
+#endif
+  {
+    std::vector<float> buffer;
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp for schedule(dynamic, 16)
+#endif
+    for (int i = 0; i < nbPoints; ++i) {
+      const size_t idx = static_cast<size_t>(i);
+      m_status[idx] = trackFeature(prevLevels, nextLevels, m_points[0][idx], m_points[1][idx], buffer) ? 1 : 0;
+    }
+  }
+
+  // Remove points that are lost
+  for (int i = nbPoints - 1; i >= 0; --i) {
+    if (m_status[static_cast<size_t>(i)] == 0) { // point is lost
+      m_points[0].erase(m_points[0].begin() + i);
+      m_points[1].erase(m_points[1].begin() + i);
+      m_points_id.erase(m_points_id.begin() + i);
+    }
+  }
+}
+
+/*!
+ * Track a single feature with the pyramidal Lucas-Kanade optical flow, from the coarsest to the finest pyramid level.
+ *
+ * At each level, the template patch and its Scharr derivatives are computed once from the previous image, so that
+ * each iteration only needs to resample the current image and accumulate the mismatch vector.
+ *
+ * \param prevLevels : Pyramid levels of the previous image.
+ * \param nextLevels : Pyramid levels of the current image.
+ * \param prevPt : Feature location in the previous image.
+ * \param nextPt : Initial guess of the feature location in the current image, and estimated location on output.
+ * \param buffer : Work buffer, reused between the calls.
+ * \return true if the feature is tracked, false if it is lost.
+ */
+bool vpKlt::trackFeature(const std::vector<const vpImage<unsigned char> *> &prevLevels,
+                         const std::vector<const vpImage<unsigned char> *> &nextLevels, const vpImagePoint &prevPt,
+                         vpImagePoint &nextPt, std::vector<float> &buffer) const
+{
+  const int half = std::max<int>(m_winSize, 1) / 2;
+  const int side = (2 * half) + 1;
+  const int extSide = side + 2;
+  const int nbPixels = side * side;
+  buffer.resize(static_cast<size_t>((extSide * extSide) + (3 * nbPixels)));
+  float *tmpl = &buffer[0];
+  float *gradX = tmpl + (extSide * extSide);
+  float *gradY = gradX + nbPixels;
+  float *warped = gradY + nbPixels;
+
+  const int nbLevels = static_cast<int>(std::min<size_t>(prevLevels.size(), nextLevels.size()));
+  const int topLevel = nbLevels - 1;
+  const double topScale = 1. / static_cast<double>(1 << topLevel);
+  double nextX = nextPt.get_u() * topScale;
+  double nextY = nextPt.get_v() * topScale;
+  const float minEigScale = 1.f / (static_cast<float>(nbPixels) * 255.f * 255.f);
+  const double epsilon2 = m_epsilon * m_epsilon;
+
+  for (int level = topLevel; level >= 0; --level) {
+    if (level != topLevel) {
+      nextX *= 2.;
+      nextY *= 2.;
+    }
+    const vpImage<unsigned char> &I = *prevLevels[static_cast<size_t>(level)];
+    const vpImage<unsigned char> &J = *nextLevels[static_cast<size_t>(level)];
+    const double scale = 1. / static_cast<double>(1 << level);
+    const double prevX = prevPt.get_u() * scale;
+    const double prevY = prevPt.get_v() * scale;
+
+    // Template patch with a one pixel border for the derivatives
+    const int px = static_cast<int>(std::floor(prevX));
+    const int py = static_cast<int>(std::floor(prevY));
+    if (((px - half - 1) < 0) || ((py - half - 1) < 0) || ((px + half + 2) >= static_cast<int>(I.getWidth())) ||
+        ((py + half + 2) >= static_cast<int>(I.getHeight()))) {
+      if (level == 0) {
+        return false;
+      }
+      continue;
+    }
+    samplePatch(I, py - half - 1, px - half - 1, static_cast<float>(prevX - px), static_cast<float>(prevY - py),
+                extSide, extSide, tmpl);
+
+    // Scharr derivatives and spatial gradient matrix
+    float gxx = 0.f, gxy = 0.f, gyy = 0.f;
+    for (int r = 0; r < side; ++r) {
+      const float *t0 = tmpl + (r * extSide) + 1;
+      const float *t1 = t0 + extSide;
+      const float *t2 = t1 + extSide;
+      float *dx = gradX + (r * side);
+      float *dy = gradY + (r * side);
+      for (int c = 0; c < side; ++c) {
+        dx[c] = ((3.f * ((t0[c + 1] - t0[c - 1]) + (t2[c + 1] - t2[c - 1]))) + (10.f * (t1[c + 1] - t1[c - 1]))) / 32.f;
+        dy[c] = ((3.f * ((t2[c - 1] - t0[c - 1]) + (t2[c + 1] - t0[c + 1]))) + (10.f * (t2[c] - t0[c]))) / 32.f;
+      }
+      for (int c = 0; c < side; ++c) {
+        gxx += dx[c] * dx[c];
+        gxy += dx[c] * dy[c];
+        gyy += dy[c] * dy[c];
+      }
+    }
+
+    const float det = (gxx * gyy) - (gxy * gxy);
+    const float minEig = 0.5f * ((gxx + gyy) - std::sqrt(((gxx - gyy) * (gxx - gyy)) + (4.f * gxy * gxy)));
+    if (((minEig * minEigScale) < static_cast<float>(m_minEigThreshold)) || (det < std::numeric_limits<float>::epsilon())) {
+      if (level == 0) {
+        return false;
+      }
+      continue;
+    }
+    const double invDet = 1. / det;
+
+    for (int iter = 0; iter < m_maxIter; ++iter) {
+      const int nx = static_cast<int>(std::floor(nextX));
+      const int ny = static_cast<int>(std::floor(nextY));
+      if (((nx - half) < 0) || ((ny - half) < 0) || ((nx + half + 1) >= static_cast<int>(J.getWidth())) ||
+          ((ny + half + 1) >= static_cast<int>(J.getHeight()))) {
+        if (level == 0) {
+          return false;
+        }
+        break;
+      }
+      samplePatch(J, ny - half, nx - half, static_cast<float>(nextX - nx), static_cast<float>(nextY - ny), side, side,
+                  warped);
+
+      // Mismatch vector
+      float bx = 0.f, by = 0.f;
+      for (int r = 0; r < side; ++r) {
+        const float *t = tmpl + ((r + 1) * extSide) + 1;
+        const float *w = warped + (r * side);
+        const float *dx = gradX + (r * side);
+        const float *dy = gradY + (r * side);
+        for (int c = 0; c < side; ++c) {
+          const float diff = t[c] - w[c];
+          bx += diff * dx[c];
+          by += diff * dy[c];
+        }
+      }
+
+      const double deltaX = ((gyy * bx) - (gxy * by)) * invDet;
+      const double deltaY = ((gxx * by) - (gxy * bx)) * invDet;
+      nextX += deltaX;
+      nextY += deltaY;
+      if (((deltaX * deltaX) + (deltaY * deltaY)) < epsilon2) {
+        break;
+      }
+    }
+  }
+
+  nextPt.set_uv(nextX, nextY);
+  return true;
+}
+END_VISP_NAMESPACE
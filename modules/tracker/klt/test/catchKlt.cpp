@@ -0,0 +1,192 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2026 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the KLT tracking on synthetic images.
+ */
+
+/*!
+  \example catchKlt.cpp
+
+  \brief Test the KLT tracking of features on synthetically translated images, given as images or as pyramids.
+*/
+
+#include <iostream>
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <cmath>
+#include <map>
+
+#include <visp3/klt/vpKlt.h>
+
+#if defined(VISP_BUILD_CATCH2)
+#include <catch_amalgamated.hpp>
+#else // Since v3.1.1
+#include <catch2/catch_all.hpp>
+#endif
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+const double dx = 1.3;  // Translation between two consecutive images along the columns
+const double dy = -0.7; // Translation between two consecutive images along the rows
+const int nbFrames = 4;
+
+/*
+  Smooth texture translated by (tx, ty), so that the exact displacement of the features is known.
+*/
+vpImage<unsigned char> createTexturedImage(double tx, double ty)
+{
+  const unsigned int height = 240, width = 320;
+  vpImage<unsigned char> I(height, width);
+  for (unsigned int i = 0; i < height; ++i) {
+    for (unsigned int j = 0; j < width; ++j) {
+      const double x = j - tx, y = i - ty;
+      const double value =
+        128. + (60. * std::sin(0.21 * x) * std::cos(0.17 * y)) + (30. * std::sin((0.05 * x) + (0.08 * y)));
+      I[i][j] = vpMath::saturate<unsigned char>(value);
+    }
+  }
+  return I;
+}
+
+void initKlt(vpKlt &klt)
+{
+  klt.setMaxFeatures(100);
+  klt.setWindowSize(7);
+  klt.setQuality(0.01);
+  klt.setMinDistance(10);
+  klt.setHarrisFreeParameter(0.04);
+  klt.setBlockSize(5);
+  klt.setUseHarris(0);
+  klt.setPyramidLevels(2);
+}
+
+void checkDisplacement(const vpKlt &klt, const std::map<long, vpImagePoint> &initialFeatures, int frame)
+{
+  const std::vector<vpImagePoint> features = klt.getFeatures();
+  const std::vector<long> ids = klt.getFeaturesId();
+  REQUIRE(features.size() == ids.size());
+  CHECK(features.size() > 50);
+
+  for (size_t k = 0; k < features.size(); ++k) {
+    std::map<long, vpImagePoint>::const_iterator it = initialFeatures.find(ids[k]);
+    REQUIRE(it != initialFeatures.end());
+    CHECK(features[k].get_u() - it->second.get_u() == Catch::Approx(frame * dx).margin(0.1));
+    CHECK(features[k].get_v() - it->second.get_v() == Catch::Approx(frame * dy).margin(0.1));
+  }
+}
+
+std::map<long, vpImagePoint> getFeatures(const vpKlt &klt)
+{
+  const std::vector<vpImagePoint> features = klt.getFeatures();
+  const std::vector<long> ids = klt.getFeaturesId();
+  std::map<long, vpImagePoint> map;
+  for (size_t k = 0; k < features.size(); ++k) {
+    map[ids[k]] = features[k];
+  }
+  return map;
+}
+} // namespace
+
+TEST_CASE("KLT tracking of translated images", "[klt]")
+{
+  vpKlt klt;
+  initKlt(klt);
+
+  SECTION("Images")
+  {
+    klt.initTracking(createTexturedImage(0, 0));
+    const std::map<long, vpImagePoint> initialFeatures = getFeatures(klt);
+    for (int frame = 1; frame <= nbFrames; ++frame) {
+      klt.track(createTexturedImage(frame * dx, frame * dy));
+      checkDisplacement(klt, initialFeatures, frame);
+    }
+  }
+
+  SECTION("Pyramid initialized again at each image")
+  {
+    vpImagePyramid pyramid(createTexturedImage(0, 0));
+    klt.initTracking(pyramid);
+    const std::map<long, vpImagePoint> initialFeatures = getFeatures(klt);
+    for (int frame = 1; frame <= nbFrames; ++frame) {
+      pyramid.init(createTexturedImage(frame * dx, frame * dy));
+      klt.track(pyramid);
+      checkDisplacement(klt, initialFeatures, frame);
+    }
+  }
+
+  SECTION("New pyramid at each image")
+  {
+    klt.initTracking(vpImagePyramid(createTexturedImage(0, 0)));
+    const std::map<long, vpImagePoint> initialFeatures = getFeatures(klt);
+    for (int frame = 1; frame <= nbFrames; ++frame) {
+      vpImagePyramid pyramid;
+      pyramid.init(createTexturedImage(frame * dx, frame * dy));
+      klt.track(pyramid);
+      checkDisplacement(klt, initialFeatures, frame);
+    }
+  }
+
+  SECTION("Images and pyramids")
+  {
+    vpImagePyramid pyramid;
+    klt.initTracking(createTexturedImage(0, 0));
+    const std::map<long, vpImagePoint> initialFeatures = getFeatures(klt);
+    for (int frame = 1; frame <= nbFrames; ++frame) {
+      if (frame % 2) {
+        pyramid.init(createTexturedImage(frame * dx, frame * dy));
+        klt.track(pyramid);
+      }
+      else {
+        klt.track(createTexturedImage(frame * dx, frame * dy));
+      }
+      checkDisplacement(klt, initialFeatures, frame);
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  std::cout << (numFailed ? "Test failed" : "Test succeed") << std::endl;
+  return numFailed;
+}
+
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -158,6 +158,10 @@ protected:
   vpColVector m_w_depthDense;
   //! Weighted error
   vpColVector m_weightedError_depthDense;
+  //! Interaction matrix of each active face, kept to avoid reallocations
+  std::vector<vpMatrix> m_L_faces_depthDense;
+  //! Error of each active face, kept to avoid reallocations
+  std::vector<vpColVector> m_error_faces_depthDense;
 #if DEBUG_DISPLAY_DEPTH_DENSE
   vpDisplay *m_debugDisp_depthDense;
   vpImage<unsigned char> m_debugImage_depthDense;
@@ -169,7 +173,10 @@ protected:
 
   void computeVVS();
   virtual void computeVVSInit() VP_OVERRIDE;
+  void computeVVSInitResidu();
   virtual void computeVVSInteractionMatrixAndResidu() VP_OVERRIDE;
+  void computeVVSNormalEquations(const double *const w, vpMatrix &LTL, vpColVector &LTR) const;
+  void computeVVSResidu();
   virtual void computeVVSWeights();
   using vpMbTracker::computeVVSWeights;
 
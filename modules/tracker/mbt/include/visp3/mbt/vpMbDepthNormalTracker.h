@@ -76,6 +76,13 @@ public:
     return m_depthNormalFeatureEstimationMethod;
   }
 
+  /*!
+   * Return the number of threads used to extract the depth normal features of the faces.
+   *
+   * \sa setDepthNormalNbThreads()
+   */
+  virtual inline int getDepthNormalNbThreads() const { return m_depthNormalNbThreads; }
+
   virtual inline vpColVector getError() const VP_OVERRIDE { return m_error_depthNormal; }
 
   virtual std::vector<std::vector<double> > getModelForDisplay(unsigned int width, unsigned int height,
@@ -104,6 +111,8 @@ public:
 
   virtual void setDepthNormalFeatureEstimationMethod(const vpMbtFaceDepthNormal::vpFeatureEstimationType &method);
 
+  virtual void setDepthNormalNbThreads(int nbThreads);
+
   virtual void setDepthNormalPclPlaneEstimationMethod(int method);
 
   virtual void setDepthNormalPclPlaneEstimationRansacMaxIter(int maxIter);
@@ -156,6 +165,8 @@ protected:
   unsigned int m_depthNormalSamplingStepX;
   //! Sampling step in y-direction
   unsigned int m_depthNormalSamplingStepY;
+  //! Number of threads used to extract the features of the faces
+  int m_depthNormalNbThreads;
   //! If true, use Tukey robust M-Estimator
   bool m_depthNormalUseRobust;
   //! (s - s*)
@@ -183,6 +194,8 @@ protected:
   virtual void computeVVSInit() VP_OVERRIDE;
   virtual void computeVVSInteractionMatrixAndResidu() VP_OVERRIDE;
 
+  int getDepthNormalNbThreadsToUse() const;
+
   virtual std::vector<std::vector<double> > getFeaturesForDisplayDepthNormal();
 
   virtual void initCircle(const vpPoint &p1, const vpPoint &p2, const vpPoint &p3, double radius, int idFace = 0,
@@ -40,6 +40,7 @@
 #define vpMbEdgeTracker_HH
 
 #include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImagePyramid.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/mbt/vpMbTracker.h>
 #include <visp3/mbt/vpMbtDistanceCircle.h>
@@ -51,6 +52,7 @@
 #include <fstream>
 #include <iostream>
 #include <list>
+#include <map>
 #include <vector>
 
 #if defined(VISP_HAVE_COIN3D)
@@ -269,6 +271,9 @@ protected:
   //! of moving edges). Each element of the vector is for a scale (element 0 =
   //! level 0 = no subsampling).
   std::vector<std::list<vpMbtDistanceLine *> > lines;
+  //! Lines of each scale sorted by the X coordinate of their first extremity, used to find the lines already in
+  //! the model.
+  std::vector<std::multimap<double, vpMbtDistanceLine *> > m_linesIndex;
 
   //! Vector of the tracked circles.
   std::vector<std::list<vpMbtDistanceCircle *> > circles;
@@ -333,6 +338,10 @@ protected:
   vpRobust m_robust_edge;
   //! Display features
   std::vector<std::vector<double> > m_featuresToBeDisplayedEdge;
+  //! Pyramid given to track(const vpImagePyramid &), whose decimated levels are used to fill Ipyramid
+  const vpImagePyramid *m_imagePyramid;
+  //! True when the levels of Ipyramid belong to m_imagePyramid and must not be deleted
+  bool m_ipyramidShared;
 public:
   vpMbEdgeTracker();
   virtual ~vpMbEdgeTracker() VP_OVERRIDE;
@@ -490,6 +499,7 @@ public:
 
   virtual void track(const vpImage<unsigned char> &I) VP_OVERRIDE;
   virtual void track(const vpImage<vpRGBa> &I) VP_OVERRIDE;
+  void track(const vpImagePyramid &pyramid);
   //@}
 
 protected:
@@ -338,6 +338,15 @@ public:
    */
   virtual inline unsigned int getNbFeaturesKlt() const { return m_nb_feat_klt; }
 
+  virtual unsigned int getNbVVSResizes() const VP_OVERRIDE;
+
+  /*!
+   * Return the number of threads used by the parallel virtual visual-servoing scheme.
+   *
+   * \sa setNbParallelVVSThreads(), setUseParallelVVS()
+   */
+  virtual inline int getNbParallelVVSThreads() const { return m_nbParallelVVSThreads; }
+
   virtual unsigned int getNbPoints(unsigned int level = 0) const;
   virtual void getNbPoints(std::map<std::string, unsigned int> &mapOfNbPoints, unsigned int level = 0) const;
 
@@ -364,6 +373,20 @@ public:
 
   virtual int getTrackerType() const;
 
+  /*!
+   * Return true if the pose update is computed from normal equations accumulated on the fly.
+   *
+   * \sa setUseNormalEquations()
+   */
+  virtual inline bool getUseNormalEquations() const { return m_useNormalEquations; }
+
+  /*!
+   * Return true if the per-camera steps of the virtual visual-servoing scheme are run in parallel.
+   *
+   * \sa setUseParallelVVS()
+   */
+  virtual inline bool getUseParallelVVS() const { return m_useParallelVVS; }
+
   virtual void init(const vpImage<unsigned char> &I) VP_OVERRIDE;
 
 #ifdef VISP_HAVE_MODULE_GUI
@@ -420,6 +443,8 @@ public:
   virtual void initFromPose(const std::map<std::string, const vpImage<vpRGBa> *> &mapOfColorImages,
     const std::map<std::string, vpHomogeneousMatrix> &mapOfCameraPoses);
 
+  virtual bool isModelLoadedFromCache() const VP_OVERRIDE;
+
   virtual void loadConfigFile(const std::string &configFile, bool verbose = true) VP_OVERRIDE;
   virtual void loadConfigFile(const std::string &configFile1, const std::string &configFile2, bool verbose = true);
   virtual void loadConfigFile(const std::map<std::string, std::string> &mapOfConfigFiles, bool verbose = true);
@@ -488,6 +513,8 @@ public:
   virtual void setClipping(const unsigned int &flags1, const unsigned int &flags2);
   virtual void setClipping(const std::map<std::string, unsigned int> &mapOfClippingFlags);
 
+  virtual void setCompiledModelCache(bool enable, const std::string &directory = "") VP_OVERRIDE;
+
   virtual void setDepthDenseFilteringMaxDistance(double maxDistance);
   virtual void setDepthDenseFilteringMethod(int method);
   virtual void setDepthDenseFilteringMinDistance(double minDistance);
@@ -496,6 +523,7 @@ public:
 
   virtual void setDepthNormalFaceCentroidMethod(const vpMbtFaceDepthNormal::vpFaceCentroidType &method);
   virtual void setDepthNormalFeatureEstimationMethod(const vpMbtFaceDepthNormal::vpFeatureEstimationType &method);
+  virtual void setDepthNormalNbThreads(int nbThreads);
   virtual void setDepthNormalPclPlaneEstimationMethod(int method);
   virtual void setDepthNormalPclPlaneEstimationRansacMaxIter(int maxIter);
   virtual void setDepthNormalPclPlaneEstimationRansacThreshold(double threshold);
@@ -539,6 +567,17 @@ public:
   virtual void setMovingEdge(const vpMe &me1, const vpMe &me2);
   virtual void setMovingEdge(const std::map<std::string, vpMe> &mapOfMe);
 
+  /*!
+   * Set the number of threads used by the parallel virtual visual-servoing scheme.
+   *
+   * \param nb : Number of threads. If 0 or negative, the number of threads is set by OpenMP.
+   * In all cases, no more threads than the number of cameras are used.
+   *
+   * \note The parallel scheme has to be enabled with setUseParallelVVS().
+   * \sa setUseParallelVVS()
+   */
+  virtual inline void setNbParallelVVSThreads(int nb) { m_nbParallelVVSThreads = nb; }
+
   virtual void setNearClippingDistance(const double &dist) VP_OVERRIDE;
   virtual void setNearClippingDistance(const double &dist1, const double &dist2);
   virtual void setNearClippingDistance(const std::map<std::string, double> &mapOfDists);
@@ -581,6 +620,33 @@ public:
   virtual void setUseKltTracking(const std::string &name, const bool &useKltTracking);
 #endif
 
+  /*!
+   * Enable or disable the accumulation of the normal equations. When enabled, the 6x6 matrix
+   * \f$ \mathbf{L}^T \mathbf{W} \mathbf{L} \f$ and the vector \f$ \mathbf{L}^T \mathbf{W} \mathbf{e} \f$
+   * are accumulated feature by feature and camera by camera, instead of building and weighting the
+   * stacked interaction matrix of all the features. The interaction matrix of the dense depth features
+   * is never built. The estimated pose is the same up to rounding errors.
+   *
+   * \param use : True to accumulate the normal equations, false to use the stacked interaction matrix (default).
+   *
+   * \note The stacked interaction matrix is still used when the covariance matrix is computed,
+   * see setCovarianceComputation().
+   */
+  virtual inline void setUseNormalEquations(bool use) { m_useNormalEquations = use; }
+
+  /*!
+   * Enable or disable the parallel virtual visual-servoing scheme. When enabled, the interaction
+   * matrix, the residuals and the robust weights of each camera are computed concurrently and written
+   * into their own row block of the stacked system. The estimated pose is the same as with the
+   * sequential scheme.
+   *
+   * \param use : True to process the cameras in parallel, false to process them sequentially (default).
+   *
+   * \note Only effective when ViSP is built with OpenMP and when more than one camera is used.
+   * \sa setNbParallelVVSThreads()
+   */
+  virtual inline void setUseParallelVVS(bool use) { m_useParallelVVS = use; }
+
   virtual void testTracking() VP_OVERRIDE;
 
   virtual void track(const vpImage<unsigned char> &I) VP_OVERRIDE;
@@ -683,6 +749,8 @@ private:
     vpColVector m_w;
     //! Weighted error
     vpColVector m_weightedError;
+    //! If true, the interaction matrix of the dense depth features is not built
+    bool m_useNormalEquations;
 
     TrackerWrapper();
     explicit TrackerWrapper(int trackerType);
@@ -847,6 +915,49 @@ protected:
   unsigned int m_nb_feat_depthNormal;
   //! Number of depth dense features
   unsigned int m_nb_feat_depthDense;
+  //! If true, the per-camera steps of the VVS scheme are run in parallel
+  bool m_useParallelVVS;
+  //! Number of threads for the parallel VVS scheme, 0 to let OpenMP decide
+  int m_nbParallelVVSThreads;
+  //! Map of velocity twist matrices between each camera and the reference camera, kept between frames
+  std::map<std::string, vpVelocityTwistMatrix> m_mapOfVelocityTwist;
+  //! If true, the normal equations are accumulated instead of building the stacked interaction matrix
+  bool m_useNormalEquations;
+
+private:
+  //! Data of one camera used by the VVS scheme, kept from one iteration and one frame to another
+  struct vpVVSCamera
+  {
+    vpVVSCamera()
+      : tracker(nullptr), I(nullptr), cMcRef(), cVo(), start_index(0), num(0), den(0), LTL(6, 6), LTR(6)
+    { }
+
+    //! Tracker of the camera
+    TrackerWrapper *tracker;
+    //! Image of the camera
+    const vpImage<unsigned char> *I;
+    //! Transformation between the reference camera frame and the camera frame
+    vpHomogeneousMatrix cMcRef;
+    //! Velocity twist matrix between the reference camera frame and the camera frame
+    vpVelocityTwistMatrix cVo;
+    //! Index of the first row of the camera in the stacked system
+    unsigned int start_index;
+    //! Sum of the weighted squared residuals of the camera
+    double num;
+    //! Sum of the weights of the camera
+    double den;
+    //! Normal matrix of the camera expressed in the reference camera frame
+    vpMatrix LTL;
+    //! Right-hand side of the normal equations of the camera expressed in the reference camera frame
+    vpColVector LTR;
+  };
+  //! Per camera data of the VVS scheme
+  std::vector<vpVVSCamera> m_vvsCameras;
+
+  void computeVVSNormalEquations(vpVVSCamera &camera, const vpColVector *const w);
+  void computeVVSWeighting(TrackerWrapper *tracker, unsigned int start_index, vpColVector &W_true, double &num,
+    double &den);
+  int getNbVVSThreads(size_t nbCameras) const;
 };
 
 #ifdef VISP_HAVE_NLOHMANN_JSON
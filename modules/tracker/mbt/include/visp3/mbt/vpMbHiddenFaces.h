@@ -41,6 +41,7 @@
 #include <visp3/core/vpMeterPixelConversion.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/mbt/vpMbScanLine.h>
+#include <visp3/mbt/vpMbtBoundingVolumeHierarchy.h>
 #include <visp3/mbt/vpMbtPolygon.h>
 
 #ifdef VISP_HAVE_OGRE
@@ -86,6 +87,15 @@ private:
   //! Number of visible polygon
   unsigned int nbVisiblePolygon;
   vpMbScanLine scanlineRender;
+  //! If true, the bounding volume hierarchy is used to skip the polygons that are certainly back-facing or outside
+  //! the view frustum
+  bool m_useBvh;
+  //! Bounding volume hierarchy over the polygons, built again when polygons are added or removed
+  vpMbtBoundingVolumeHierarchy m_bvh;
+  //! Facing of the polygons computed with the bounding volume hierarchy
+  std::vector<unsigned char> m_bvhFacing;
+  //! Polygons entirely outside the view frustum computed with the bounding volume hierarchy
+  std::vector<bool> m_bvhOutside;
 
 #ifdef VISP_HAVE_OGRE
   vpImage<unsigned char> ogreBackground;
@@ -102,6 +112,8 @@ private:
                                  bool not_used = false, unsigned int width = 0, unsigned int height = 0,
                                  const vpCameraParameters &cam = vpCameraParameters());
 
+  void updateBoundingVolumeHierarchy();
+
 public:
   vpMbHiddenFaces();
   virtual ~vpMbHiddenFaces();
@@ -124,6 +136,13 @@ public:
 
   vpMbScanLine &getMbScanLineRenderer() { return scanlineRender; }
 
+  /*!
+   * Return true if the bounding volume hierarchy is used to compute the visibility and the clipping of the polygons.
+   *
+   * \sa setUseBoundingVolumeHierarchy()
+   */
+  bool getUseBoundingVolumeHierarchy() const { return m_useBvh; }
+
 #ifdef VISP_HAVE_OGRE
   void displayOgre(const vpHomogeneousMatrix &cMo);
 #endif
@@ -273,6 +292,26 @@ public:
   unsigned int setVisible(const vpHomogeneousMatrix &cMo, const double &angleAppears, const double &angleDisappears,
                           bool &changed);
 
+  /*!
+   * Enable or disable the bounding volume hierarchy used by setVisible() and computeClippedPolygons() to skip the
+   * polygons that are certainly back-facing or outside the view frustum, see vpMbtBoundingVolumeHierarchy. The
+   * results are the same with or without the hierarchy, only the camera frame coordinates of the skipped polygons
+   * are not updated. Enabled by default.
+   *
+   * The hierarchy is built from the polygons the first time it is needed, and built again when polygons are added
+   * or removed. It has to be built again with invalidateBoundingVolumeHierarchy() if the points of the polygons are
+   * modified.
+   *
+   * \param useBvh : True to use the bounding volume hierarchy.
+   */
+  void setUseBoundingVolumeHierarchy(bool useBvh) { m_useBvh = useBvh; }
+
+  /*!
+   * Build the bounding volume hierarchy again the next time it is used, to take into account a modification of the
+   * points of the polygons.
+   */
+  void invalidateBoundingVolumeHierarchy() { m_bvh.clear(); }
+
 #ifdef VISP_HAVE_OGRE
   unsigned int setVisibleOgre(unsigned int width, unsigned int height, const vpCameraParameters &cam,
                               const vpHomogeneousMatrix &cMo, const double &angleAppears, const double &angleDisappears,
@@ -292,7 +331,8 @@ public:
  * Basic constructor.
  */
 template <class PolygonType>
-vpMbHiddenFaces<PolygonType>::vpMbHiddenFaces() : Lpol(), nbVisiblePolygon(0), scanlineRender()
+vpMbHiddenFaces<PolygonType>::vpMbHiddenFaces()
+  : Lpol(), nbVisiblePolygon(0), scanlineRender(), m_useBvh(true), m_bvh(), m_bvhFacing(), m_bvhOutside()
 {
 #ifdef VISP_HAVE_OGRE
   ogreInitialised = false;
@@ -340,7 +380,8 @@ template <class PolygonType> vpMbHiddenFaces<PolygonType>::~vpMbHiddenFaces()
  */
 template <class PolygonType>
 vpMbHiddenFaces<PolygonType>::vpMbHiddenFaces(const vpMbHiddenFaces<PolygonType> &copy)
-  : Lpol(), nbVisiblePolygon(copy.nbVisiblePolygon), scanlineRender(copy.scanlineRender)
+  : Lpol(), nbVisiblePolygon(copy.nbVisiblePolygon), scanlineRender(copy.scanlineRender), m_useBvh(copy.m_useBvh),
+  m_bvh(copy.m_bvh), m_bvhFacing(), m_bvhOutside()
 #ifdef VISP_HAVE_OGRE
   ,
   ogreBackground(copy.ogreBackground), ogreInitialised(copy.ogreInitialised), nbRayAttempts(copy.nbRayAttempts),
@@ -360,6 +401,8 @@ template <class PolygonType> void swap(vpMbHiddenFaces<PolygonType> &first, vpMb
   swap(first.Lpol, second.Lpol);
   swap(first.nbVisiblePolygon, second.nbVisiblePolygon);
   swap(first.scanlineRender, second.scanlineRender);
+  swap(first.m_useBvh, second.m_useBvh);
+  swap(first.m_bvh, second.m_bvh);
 #ifdef VISP_HAVE_OGRE
   swap(first.ogreInitialised, second.ogreInitialised);
   swap(first.nbRayAttempts, second.nbRayAttempts);
@@ -409,6 +452,7 @@ template <class PolygonType> void vpMbHiddenFaces<PolygonType>::addPolygon(Polyg
 template <class PolygonType> void vpMbHiddenFaces<PolygonType>::reset()
 {
   nbVisiblePolygon = 0;
+  m_bvh.clear();
   for (unsigned int i = 0; i < Lpol.size(); i++) {
     if (Lpol[i] != nullptr) {
       delete Lpol[i];
@@ -451,12 +495,26 @@ template <class PolygonType> void vpMbHiddenFaces<PolygonType>::reset()
 template <class PolygonType>
 void vpMbHiddenFaces<PolygonType>::computeClippedPolygons(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam)
 {
+  // The polygons usually share the same clipping parameters: the ones that are entirely outside of the clipping
+  // planes of the first polygon have an empty clipped polygon
+  bool useBvh = m_useBvh && !Lpol.empty();
+  if (useBvh) {
+    updateBoundingVolumeHierarchy();
+    m_bvh.computeOutsideFrustum(cMo, cam, Lpol[0]->getClipping(), Lpol[0]->getNearClippingDistance(),
+                                Lpol[0]->getFarClippingDistance(), m_bvhOutside);
+  }
+
   for (unsigned int i = 0; i < Lpol.size(); i++) {
     // For fast result we could just clip visible polygons.
     // However clipping all of them gives us the possibility to return more
     // information in the scanline visibility results
     //    if(Lpol[i]->isVisible())
-    {
+    if (useBvh && m_bvhOutside[i] && (Lpol[i]->getClipping() == Lpol[0]->getClipping()) &&
+        (Lpol[i]->getNearClippingDistance() == Lpol[0]->getNearClippingDistance()) &&
+        (Lpol[i]->getFarClippingDistance() == Lpol[0]->getFarClippingDistance())) {
+      Lpol[i]->polyClipped.clear();
+    }
+    else {
       Lpol[i]->changeFrame(cMo);
       Lpol[i]->computePolygonClipped(cam);
     }
@@ -550,15 +608,49 @@ unsigned int vpMbHiddenFaces<PolygonType>::setVisiblePrivate(const vpHomogeneous
 #endif
   }
 
+  // Without Ogre, the polygons that are certainly back-facing or front-facing are classified by the bounding volume
+  // hierarchy, the other ones are tested individually
+  const bool useBvh = m_useBvh && !useOgre && !Lpol.empty();
+  if (useBvh) {
+    updateBoundingVolumeHierarchy();
+    m_bvh.computeFacing(cMo, angleAppears, angleDisappears, m_bvhFacing);
+  }
+
   for (unsigned int i = 0; i < Lpol.size(); i++) {
-    // std::cout << "Calling poly: " << i << std::endl;
-    if (computeVisibility(cMo, angleAppears, angleDisappears, changed, useOgre, not_used, width, height, cam, cameraPos,
-                          i))
+    PolygonType *polygon = Lpol[i];
+    const bool oriented = (polygon->getNbPoint() > 2) && polygon->isPolygonOriented();
+    if (useBvh && oriented && (m_bvhFacing[i] == vpMbtBoundingVolumeHierarchy::BACK_FACING)) {
+      changed = changed || polygon->isvisible;
+      polygon->isvisible = false;
+      polygon->isappearing = false;
+    }
+    else if (useBvh && oriented && !polygon->useLod &&
+             (m_bvhFacing[i] == vpMbtBoundingVolumeHierarchy::FRONT_FACING)) {
+      polygon->changeFrame(cMo);
+      changed = changed || !polygon->isvisible;
+      polygon->isvisible = true;
+      polygon->isappearing = false;
+      nbVisiblePolygon++;
+    }
+    else if (computeVisibility(cMo, angleAppears, angleDisappears, changed, useOgre, not_used, width, height, cam,
+                               cameraPos, i)) {
       nbVisiblePolygon++;
+    }
   }
   return nbVisiblePolygon;
 }
 
+/*!
+ * Build the bounding volume hierarchy if it has not been built yet or if polygons were added or removed.
+ */
+template <class PolygonType> void vpMbHiddenFaces<PolygonType>::updateBoundingVolumeHierarchy()
+{
+  if (m_bvh.getNbPolygons() != Lpol.size()) {
+    std::vector<const vpPolygon3D *> polygons(Lpol.begin(), Lpol.end());
+    m_bvh.build(polygons);
+  }
+}
+
 /*!
  * Compute the visibility of a given face index.
  *
@@ -89,9 +89,9 @@ public:
   //! Structure to define a scanline intersection.
   struct vpMbScanLineSegment
   {
-    vpMbScanLineSegment() : type(START), edge(), p(0), P1(0), P2(0), Z1(0), Z2(0), ID(0), b_sample_Y(false) { }
+    vpMbScanLineSegment() : type(START), edge(0), p(0), P1(0), P2(0), Z1(0), Z2(0), ID(0), b_sample_Y(false) { }
     vpMbScanLineType type;
-    vpMbScanLineEdge edge;
+    unsigned int edge; // Index of the edge in the edges of the rendered scene
     double p;      // This value can be either x or y-coordinate value depending if
                    // the structure is used in X or Y-axis scanlines computation.
     double P1, P2; // Same comment as previous value.
@@ -143,6 +143,7 @@ private:
   vpImage<int> primitive_ids;
   std::map<vpMbScanLineEdge, std::set<int>, vpMbScanLineEdgeComparator> visibility_samples;
   double depthTreshold;
+  int m_nbThreads;
 
 public:
 #if (defined(VISP_HAVE_X11) || defined(VISP_HAVE_GDI)) && defined(DEBUG_DISP)
@@ -168,6 +169,11 @@ public:
   */
   double getDepthTreshold() { return depthTreshold; }
   unsigned int getMaskBorder() { return maskBorder; }
+  /*!
+    Return the number of stripes of scanlines rendered in parallel, see
+    setNbThreads().
+  */
+  int getNbThreads() const { return m_nbThreads; }
   const vpImage<unsigned char> &getMask() const { return mask; }
   const vpImage<int> &getPrimitiveIDs() const { return primitive_ids; }
 
@@ -183,23 +189,20 @@ public:
   */
   void setDepthTreshold(const double &treshold) { depthTreshold = treshold; }
   void setMaskBorder(const unsigned int &mb) { maskBorder = mb; }
+  void setNbThreads(int nbThreads);
 
 private:
   void createScanLinesFromLocals(std::vector<std::vector<vpMbScanLineSegment> > &scanlines,
                                  std::vector<std::vector<vpMbScanLineSegment> > &localScanlines,
-                                 const unsigned int &size);
-
-  void drawLineY(const vpColVector &a, const vpColVector &b, const vpMbScanLineEdge &line_ID, const int ID,
-                 std::vector<std::vector<vpMbScanLineSegment> > &scanlines);
-
-  void drawLineX(const vpColVector &a, const vpColVector &b, const vpMbScanLineEdge &line_ID, const int ID,
-                 std::vector<std::vector<vpMbScanLineSegment> > &scanlines);
+                                 unsigned int first, unsigned int last);
 
-  void drawPolygonY(const std::vector<std::pair<vpPoint, unsigned int> > &polygon, const int ID,
-                    std::vector<std::vector<vpMbScanLineSegment> > &scanlines);
+  void drawLine(unsigned int axis, const double *a, const double *b, unsigned int edge, const int ID,
+                unsigned int first, unsigned int last, std::vector<std::vector<vpMbScanLineSegment> > &scanlines);
 
-  void drawPolygonX(const std::vector<std::pair<vpPoint, unsigned int> > &polygon, const int ID,
-                    std::vector<std::vector<vpMbScanLineSegment> > &scanlines);
+  void drawPolygon(unsigned int axis, const std::vector<double> &points, const std::vector<unsigned int> &edges,
+                   const int ID, unsigned int first, unsigned int last,
+                   std::vector<std::vector<vpMbScanLineSegment> > &scanlines,
+                   std::vector<std::vector<vpMbScanLineSegment> > &localScanlines);
 
   // Static functions
   static vpMbScanLineEdge makeMbScanLineEdge(const vpPoint &a, const vpPoint &b);
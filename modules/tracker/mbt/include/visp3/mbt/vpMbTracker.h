@@ -55,7 +55,9 @@
 #include <visp3/core/vpRGBa.h>
 #include <visp3/core/vpRobust.h>
 #include <visp3/mbt/vpMbHiddenFaces.h>
+#include <visp3/mbt/vpMbtCompiledModel.h>
 #include <visp3/mbt/vpMbtPolygon.h>
+#include <visp3/mbt/vpMbtVVSWorkspace.h>
 
 #include <visp3/mbt/vpMbtDistanceCircle.h>
 #include <visp3/mbt/vpMbtDistanceCylinder.h>
@@ -203,6 +205,8 @@ protected:
 
   //! Distance line primitives for projection error
   std::vector<vpMbtDistanceLine *> m_projectionErrorLines;
+  //! Projection error lines sorted by the X coordinate of their first extremity, see findLines()
+  std::multimap<double, vpMbtDistanceLine *> m_projectionErrorLinesIndex;
   //! Distance cylinder primitives for projection error
   std::vector<vpMbtDistanceCylinder *> m_projectionErrorCylinders;
   //! Distance circle primitive for projection error
@@ -234,6 +238,14 @@ protected:
   bool m_sodb_init_called;
   //! Random number generator used in vpMbtDistanceLine::buildFrom()
   vpUniRand m_rand;
+  //! Buffers reused by the virtual visual servoing stage from one iteration and one frame to another
+  vpMbtVVSWorkspace m_vvsWorkspace;
+  //! If true, loadModel() reads and writes the compiled model cache
+  bool m_compiledModelCache;
+  //! Directory of the compiled model cache files, empty to write them next to the model files
+  std::string m_compiledModelCacheDirectory;
+  //! True if the last model was loaded from the compiled model cache
+  bool m_modelLoadedFromCache;
 
 public:
   vpMbTracker();
@@ -258,6 +270,13 @@ public:
   */
   virtual void getCameraParameters(vpCameraParameters &cam) const { cam = m_cam; }
 
+  /*!
+    Return true if the compiled model cache is used by loadModel().
+
+    \sa setCompiledModelCache()
+  */
+  virtual inline bool getCompiledModelCache() const { return m_compiledModelCache; }
+
   /*!
     Get the clipping used and defined in
     vpPolygon3D::vpMbtPolygonClippingType.
@@ -378,6 +397,16 @@ public:
   */
   virtual inline unsigned int getNbPolygon() const { return static_cast<unsigned int>(faces.size()); }
 
+  /*!
+    Get the number of buffers of the virtual visual servoing workspace whose size changed during the last call to
+    track(). These buffers are only resized, and thus reallocated, when the number of features changes, so that this
+    number is 0 once the number of tracked features is stable. Other heap allocations of the tracker, like the ones
+    of the feature extraction, are not counted.
+
+    \return Number of workspace buffer resizes during the last call to track().
+  */
+  virtual inline unsigned int getNbVVSResizes() const { return m_vvsWorkspace.getNbResizes(); }
+
   /*!
     Get the near distance for clipping.
 
@@ -466,6 +495,14 @@ public:
   virtual void initFromPose(const vpImage<unsigned char> &I, const vpPoseVector &cPo);
   virtual void initFromPose(const vpImage<vpRGBa> &I_color, const vpPoseVector &cPo);
 
+  /*!
+    Return true if the last model loaded with loadModel() was read from the compiled model cache instead of being
+    parsed.
+
+    \sa setCompiledModelCache()
+  */
+  virtual inline bool isModelLoadedFromCache() const { return m_modelLoadedFromCache; }
+
   virtual void loadModel(const std::string &modelFile, bool verbose = false,
                          const vpHomogeneousMatrix &od_M_o = vpHomogeneousMatrix());
 
@@ -500,6 +537,8 @@ public:
 
   virtual void setClipping(const unsigned int &flags);
 
+  virtual void setCompiledModelCache(bool enable, const std::string &directory = "");
+
   /*!
     Set if the covariance matrix has to be computed.
 
@@ -831,15 +870,25 @@ protected:
                                         vpColVector &R, const vpColVector &error, vpColVector &error_prev,
                                         vpColVector &LTR, double &mu, vpColVector &v, const vpColVector *const w = nullptr,
                                         vpColVector *const m_w_prev = nullptr);
+  virtual void computeVVSPoseEstimationFromNormalEquations(const bool isoJoIdentity, unsigned int iter, vpMatrix &LTL,
+                                                           vpColVector &LTR, const vpColVector &error,
+                                                           vpColVector &error_prev, double &mu, vpColVector &v,
+                                                           const vpColVector *const w = nullptr,
+                                                           vpColVector *const m_w_prev = nullptr);
   virtual void computeVVSWeights(vpRobust &robust, const vpColVector &error, vpColVector &w);
+  void computeVVSPoseUpdate(const bool isoJoIdentity, unsigned int iter, const vpMatrix &LTL, const vpColVector &LTR,
+                            const vpColVector &error, vpColVector &error_prev, double &mu, vpColVector &v,
+                            const vpColVector *const w, vpColVector *const m_w_prev);
 
 #ifdef VISP_HAVE_COIN3D
-  virtual void extractGroup(SoVRMLGroup *sceneGraphVRML2, vpHomogeneousMatrix &transform, int &idFace);
+  virtual void extractGroup(SoVRMLGroup *sceneGraphVRML2, vpHomogeneousMatrix &transform, int &idFace,
+                            vpMbtCompiledModel &model);
   virtual void extractFaces(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
+                            vpMbtCompiledModel &model, const std::string &polygonName = "");
+  virtual void extractLines(SoVRMLIndexedLineSet *line_set, int &idFace, vpMbtCompiledModel &model,
                             const std::string &polygonName = "");
-  virtual void extractLines(SoVRMLIndexedLineSet *line_set, int &idFace, const std::string &polygonName = "");
   virtual void extractCylinders(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
-                                const std::string &polygonName = "");
+                                vpMbtCompiledModel &model, const std::string &polygonName = "");
 #endif
 
   vpPoint getGravityCenter(const std::vector<vpPoint> &_pts) const;
@@ -905,6 +954,8 @@ protected:
   virtual void initFaceFromCorners(vpMbtPolygon &polygon) = 0;
   virtual void initFaceFromLines(vpMbtPolygon &polygon) = 0;
 
+  void initFromCompiledModel(const vpMbtCompiledModel &model, int &startIdFace);
+
   void initProjectionErrorCircle(const vpPoint &p1, const vpPoint &p2, const vpPoint &p3, double radius, int idFace = 0,
                                  const std::string &name = "");
   void initProjectionErrorCylinder(const vpPoint &p1, const vpPoint &p2, double radius, int idFace = 0,
@@ -924,8 +975,17 @@ protected:
 
   void removeCommentsAndEmptyLines(std::ifstream &fileId);
 
+  std::string getCompiledModelFilename(const std::string &modelFile) const;
+
+  void parseCAOModel(const std::string &modelFile, std::vector<std::string> &vectorOfModelFilename,
+                     vpMbtCompiledModel &model, int &idFace, bool verbose, bool parent,
+                     const vpHomogeneousMatrix &od_M_o);
   std::map<std::string, std::string> parseParameters(std::string &endLine);
+  void parseVRMLModel(const std::string &modelFile, vpMbtCompiledModel &model);
+  void printModelStatistics(const std::string &modelFile, bool verbose) const;
 
+  void findLines(const std::multimap<double, vpMbtDistanceLine *> &index, const vpPoint &P1, const vpPoint &P2,
+                 std::vector<vpMbtDistanceLine *> &matches) const;
   bool samePoint(const vpPoint &P1, const vpPoint &P2) const;
 };
 END_VISP_NAMESPACE
@@ -0,0 +1,143 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2026 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bounding volume hierarchy over the polygons of a model-based tracker CAD model.
+ */
+
+/*!
+ * \file vpMbtBoundingVolumeHierarchy.h
+ * \brief Bounding volume hierarchy over the polygons of a model-based tracker CAD model.
+ */
+
+#ifndef VP_MBT_BOUNDING_VOLUME_HIERARCHY_H
+#define VP_MBT_BOUNDING_VOLUME_HIERARCHY_H
+
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpPolygon3D.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpMbtBoundingVolumeHierarchy
+ * \ingroup group_mbt_faces
+ *
+ * \brief Bounding volume hierarchy over the polygons of a CAD model, used by vpMbHiddenFaces to skip the polygons
+ * that are certainly back-facing or outside the view frustum.
+ *
+ * The hierarchy is built once from the object frame coordinates of the polygons. Each node stores a bounding sphere
+ * of its polygons and a cone that contains their normals, so that a single test per node tells if all its polygons
+ * are back-facing (or front-facing) with respect to the camera position, or entirely outside one of the clipping
+ * planes. The tests are conservative: when the decision is too close to a threshold, the polygons are reported as
+ * undetermined and have to be tested individually, so that the result of the culling is exactly the one of the
+ * per-polygon tests.
+ *
+ * The facing of a polygon only depends on the position of its viewpoint in the object frame, see computeFacing().
+ * Each decision taken by computeFacing() remains valid as long as the viewpoints move less than a distance that
+ * depends on the margin of the decision, so the classification of the previous call is reused as is while the camera
+ * stays within the smallest of these distances, which is the usual case when the visibility is computed several times
+ * for the same pose or between close poses.
+ */
+class VISP_EXPORT vpMbtBoundingVolumeHierarchy
+{
+public:
+  //! Facing of a polygon with respect to the camera, see computeFacing().
+  typedef enum
+  {
+    UNDETERMINED = 0, //!< The polygon has to be tested individually.
+    BACK_FACING = 1,  //!< The angle between the polygon normal and the line of sight is larger than the angles.
+    FRONT_FACING = 2  //!< The angle between the polygon normal and the line of sight is smaller than the angles.
+  } vpFacingType;
+
+  vpMbtBoundingVolumeHierarchy();
+
+  void build(const std::vector<const vpPolygon3D *> &polygons);
+  void clear();
+
+  void computeFacing(const vpHomogeneousMatrix &cMo, double angleAppears, double angleDisappears,
+                     std::vector<unsigned char> &facing);
+  void computeOutsideFrustum(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam, unsigned int clippingFlag,
+                             double distNearClip, double distFarClip, std::vector<bool> &outside) const;
+
+  /*!
+   * Return the number of polygons the hierarchy was built from.
+   */
+  inline unsigned int getNbPolygons() const { return static_cast<unsigned int>(m_spheres.size() / 4); }
+
+private:
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  typedef struct vpNode
+  {
+    double m_sphere[4];     // Bounding sphere: center and radius
+    double m_axis[3];       // Axis of the cone of the normals
+    double m_coneAngle;     // Half-angle of the cone of the normals, negative if the node has no oriented polygon
+    double m_viewOffset[2]; // Range of the viewpoint offsets of its oriented polygons, see computeFacing()
+    unsigned int m_first;   // First polygon of the node in m_order
+    unsigned int m_count;   // Number of polygons of the node
+    int m_left;             // Children, -1 for a leaf
+    int m_right;
+  } vpNode;
+
+  int buildNode(unsigned int first, unsigned int count, const std::vector<double> &bounds);
+  void computeFacing(int node, const double cameraPos[3], const double viewAxis[3], double angleMin, double angleMax,
+                     std::vector<unsigned char> &facing, double &safeDistance) const;
+  void computeOutsideFrustum(int node, const std::vector<double> &planes, std::vector<bool> &outside) const;
+  vpFacingType facingOf(const double sphere[4], const double axis[3], double coneAngle, const double viewpoint[3],
+                        double viewpointRadius, double angleMin, double angleMax, double &safeDistance) const;
+  bool isOutsideOf(const double sphere[4], const std::vector<double> &planes) const;
+  void setRange(const vpNode &node, vpFacingType type, std::vector<unsigned char> &facing) const;
+#endif
+
+  //! Nodes of the hierarchy, the root is the first one.
+  std::vector<vpNode> m_nodes;
+  //! Polygon indexes ordered so that the polygons of a node are contiguous.
+  std::vector<unsigned int> m_order;
+  //! Bounding sphere of each polygon, as (cx, cy, cz, radius) quadruplets.
+  std::vector<double> m_spheres;
+  //! Unit normal of each polygon, as (nx, ny, nz) triplets.
+  std::vector<double> m_normals;
+  //! True if the normal of the polygon is defined (at least three non aligned points).
+  std::vector<bool> m_hasNormal;
+  //! Offset of the viewpoint of each polygon along the optical axis, see computeFacing().
+  std::vector<double> m_viewOffsets;
+  //! Camera position and optical axis in the object frame and angles used to compute m_lastFacing.
+  double m_lastCameraPos[3];
+  double m_lastViewAxis[3];
+  double m_lastAngleAppears;
+  double m_lastAngleDisappears;
+  //! Distance the viewpoints can move without changing the decisions of m_lastFacing.
+  double m_lastSafeDistance;
+  //! Classification computed by the last traversal of the hierarchy, empty if there is none.
+  std::vector<unsigned char> m_lastFacing;
+};
+END_VISP_NAMESPACE
+#endif
@@ -0,0 +1,240 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Compiled representation of a model-based tracker CAD model.
+ */
+
+/*!
+ * \file vpMbtCompiledModel.h
+ * \brief Compiled representation of a model-based tracker CAD model.
+ */
+
+#ifndef VP_MBT_COMPILED_MODEL_H
+#define VP_MBT_COMPILED_MODEL_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpPoint.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpMbtCompiledModel
+ * \ingroup group_mbt_trackers
+ *
+ * \brief Compiled representation of a CAD model loaded by vpMbTracker::loadModel().
+ *
+ * Parsing a .cao or a .wrl file produces a flat table of 3D points and the ordered list of the primitives
+ * (faces, segments, cylinders and circles) to create in the tracker, each primitive referencing its points by
+ * index. The level of detail parameters that are not explicitly given in the model file are left unset so that
+ * they are resolved with the tracker settings when the model is instantiated.
+ *
+ * Once the primitives are known, computeTopology() welds the points that share the same coordinates, builds the
+ * list of the unique segments of the model with the faces adjacent to each of them, and computes the normal of
+ * each face.
+ *
+ * The compiled model can be saved in a versioned binary file and loaded back without parsing the model again.
+ * The binary file stores the size and the CRC-32 of every source file (the main model file and the files it
+ * includes with the \c load() keyword) and the transformation applied to the model points, so that isUpToDate()
+ * can tell if the cached model can still be used. The data are stored in contiguous arrays, in the byte order of
+ * the machine that wrote them; a file written on a machine with another byte order is rejected.
+ *
+ * This class is used by vpMbTracker when the compiled model cache is enabled with
+ * vpMbTracker::setCompiledModelCache().
+ */
+class VISP_EXPORT vpMbtCompiledModel
+{
+public:
+  //! Type of a model primitive.
+  typedef enum
+  {
+    POLYGON_FROM_LINES,  //!< Face described by a list of segments, initialized with initFaceFromLines().
+    POLYGON_FROM_POINTS, //!< Face described by a list of points, initialized with initFaceFromCorners().
+    SEGMENT,             //!< Segment that does not belong to a face.
+    CYLINDER,            //!< Cylinder described by two points on its axis and its radius.
+    CIRCLE               //!< Circle described by its center, two points on its plane and its radius.
+  } vpPrimitiveType;
+
+  //! Level of detail parameters explicitly given in the model file for a primitive.
+  typedef enum
+  {
+    NO_PARAMETER = 0x00,     //!< All the parameters are resolved with the tracker settings.
+    USE_LOD = 0x01,          //!< The \c useLod parameter is given.
+    MIN_POLYGON_AREA = 0x02, //!< The \c minPolygonAreaThreshold parameter is given.
+    MIN_LINE_LENGTH = 0x04   //!< The \c minLineLengthThreshold parameter is given.
+  } vpParameterFlag;
+
+  //! Model primitive.
+  typedef struct vpPrimitive
+  {
+    vpPrimitiveType m_type;          //!< Type of the primitive.
+    int m_idFace;                    //!< Index of the first face of the primitive, relative to the model.
+    unsigned int m_firstIndex;       //!< Position of the first point index in getIndices().
+    unsigned int m_nbIndices;        //!< Number of point indices.
+    double m_radius;                 //!< Radius of a cylinder or of a circle.
+    unsigned int m_parameters;       //!< Combination of vpParameterFlag.
+    bool m_useLod;                   //!< Value of the \c useLod parameter.
+    double m_minPolygonAreaThreshold; //!< Value of the \c minPolygonAreaThreshold parameter.
+    double m_minLineLengthThreshold; //!< Value of the \c minLineLengthThreshold parameter.
+    std::string m_name;              //!< Name of the primitive.
+  } vpPrimitive;
+
+  vpMbtCompiledModel();
+
+  unsigned int addPoint(double oX, double oY, double oZ);
+  void addPrimitive(vpPrimitiveType type, int idFace, const std::vector<unsigned int> &indices, double radius,
+                    const std::string &name, unsigned int parameters, bool useLod, double minPolygonAreaThreshold,
+                    double minLineLengthThreshold);
+  void addSource(const std::string &filename);
+  void clear();
+  void computeTopology();
+
+  /*!
+   * Return the list of the faces adjacent to a segment, given as indexes in getPrimitives().
+   * \param edge : Index of the segment in [0, getNbEdges()-1].
+   */
+  inline std::vector<unsigned int> getEdgeFaces(unsigned int edge) const
+  {
+    return std::vector<unsigned int>(m_edgeFaces.begin() + m_edgeFacesOffsets[edge],
+                                     m_edgeFaces.begin() + m_edgeFacesOffsets[edge + 1]);
+  }
+  /*!
+   * Return the indexes of the welded points that are the extremities of a segment.
+   * \param edge : Index of the segment in [0, getNbEdges()-1].
+   * \param p1 : Index of the first extremity in getPoint().
+   * \param p2 : Index of the second extremity in getPoint().
+   */
+  inline void getEdge(unsigned int edge, unsigned int &p1, unsigned int &p2) const
+  {
+    p1 = m_edges[2 * edge];
+    p2 = m_edges[2 * edge + 1];
+  }
+  /*!
+   * Return the point indexes of all the primitives.
+   */
+  inline const std::vector<unsigned int> &getIndices() const { return m_indices; }
+  /*!
+   * Return the number of points.
+   */
+  inline unsigned int getNbPoints() const { return static_cast<unsigned int>(m_points.size() / 3); }
+  /*!
+   * Return the number of unique segments of the model, computed by computeTopology().
+   */
+  inline unsigned int getNbEdges() const { return static_cast<unsigned int>(m_edges.size() / 2); }
+  vpColVector getNormal(unsigned int primitive) const;
+  vpPoint getPoint(unsigned int index) const;
+  /*!
+   * Return the ordered list of primitives.
+   */
+  inline const std::vector<vpPrimitive> &getPrimitives() const { return m_primitives; }
+  std::vector<unsigned int> getPrimitiveEdges(unsigned int primitive) const;
+  /*!
+   * Return the list of the source files of the model.
+   */
+  inline std::vector<std::string> getSources() const
+  {
+    std::vector<std::string> sources;
+    for (size_t i = 0; i < m_sources.size(); ++i) {
+      sources.push_back(m_sources[i].m_filename);
+    }
+    return sources;
+  }
+  void getStatistics(unsigned int &nbPoints, unsigned int &nbLines, unsigned int &nbPolygonLines,
+                     unsigned int &nbPolygonPoints, unsigned int &nbCylinders, unsigned int &nbCircles) const;
+  /*!
+   * Return the transformation applied to the points of the model file.
+   */
+  inline vpHomogeneousMatrix getTransformation() const { return m_od_M_o; }
+  /*!
+   * Return the index of the welded point that has the same coordinates as a point.
+   * \param index : Index of the point in getPoint().
+   */
+  inline unsigned int getWeldedPoint(unsigned int index) const { return m_weldedPoints[index]; }
+
+  bool isUpToDate(const vpHomogeneousMatrix &od_M_o) const;
+  bool load(const std::string &filename);
+  void save(const std::string &filename) const;
+
+  void setStatistics(unsigned int nbPoints, unsigned int nbLines, unsigned int nbPolygonLines,
+                     unsigned int nbPolygonPoints, unsigned int nbCylinders, unsigned int nbCircles);
+  /*!
+   * Set the transformation applied to the points of the model file.
+   */
+  inline void setTransformation(const vpHomogeneousMatrix &od_M_o) { m_od_M_o = od_M_o; }
+
+  //! Version of the binary format written by save().
+  static const uint32_t formatVersion;
+
+private:
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  typedef struct vpSource
+  {
+    std::string m_filename;
+    uint64_t m_size;
+    uint32_t m_crc;
+  } vpSource;
+
+  static bool computeChecksum(const std::string &filename, uint64_t &size, uint32_t &crc);
+#endif
+
+  //! Coordinates of the points, stored as (oX, oY, oZ) triplets.
+  std::vector<double> m_points;
+  //! Ordered list of primitives.
+  std::vector<vpPrimitive> m_primitives;
+  //! Point indexes of the primitives.
+  std::vector<unsigned int> m_indices;
+  //! Source files with their size and CRC-32.
+  std::vector<vpSource> m_sources;
+  //! Transformation applied to the points of the model file.
+  vpHomogeneousMatrix m_od_M_o;
+  //! Statistics printed by vpMbTracker when the model is loaded: points, lines, polygon lines, polygon points,
+  //! cylinders and circles.
+  unsigned int m_statistics[6];
+  //! For each point, index of the first point with the same coordinates.
+  std::vector<unsigned int> m_weldedPoints;
+  //! Extremities of the unique segments, as pairs of welded point indexes.
+  std::vector<unsigned int> m_edges;
+  //! Offsets of the segments of each primitive in m_primitiveEdges (size: number of primitives + 1).
+  std::vector<unsigned int> m_primitiveEdgesOffsets;
+  //! Segments of the primitives, in the order they are added to the tracker.
+  std::vector<unsigned int> m_primitiveEdges;
+  //! Offsets of the adjacent faces of each segment in m_edgeFaces (size: number of segments + 1).
+  std::vector<unsigned int> m_edgeFacesOffsets;
+  //! Faces adjacent to the segments.
+  std::vector<unsigned int> m_edgeFaces;
+  //! Normals of the faces, as (nx, ny, nz) triplets; zero for the primitives that are not faces.
+  std::vector<double> m_normals;
+};
+END_VISP_NAMESPACE
+#endif
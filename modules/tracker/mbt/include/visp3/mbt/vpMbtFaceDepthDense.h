@@ -134,6 +134,9 @@ public:
                               const vpImage<bool> *mask = nullptr);
 
   void computeInteractionMatrixAndResidu(const vpHomogeneousMatrix &cMo, vpMatrix &L, vpColVector &error);
+  void computeNormalEquations(const double *const error, const double *const w, vpMatrix &LTL,
+                              vpColVector &LTR) const;
+  void computeResidu(const vpHomogeneousMatrix &cMo, double *const error);
 
   void computeVisibility();
   void computeVisibilityDisplay();
@@ -0,0 +1,115 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Workspace of the virtual visual-servoing stage of the model-based trackers.
+ */
+
+/*!
+ * \file vpMbtVVSWorkspace.h
+ * \brief Workspace of the virtual visual-servoing stage of the model-based trackers.
+ */
+
+#ifndef VP_MBT_VVS_WORKSPACE_H
+#define VP_MBT_VVS_WORKSPACE_H
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpVelocityTwistMatrix.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpMbtVVSWorkspace
+ * \ingroup group_mbt_trackers
+ *
+ * \brief Buffers used by the virtual visual-servoing (VVS) stage of the model-based trackers.
+ *
+ * The workspace is owned by the tracker and kept from one iteration to another and from one frame to another.
+ * Its buffers are only reallocated when the number of features changes, so that once the number of features is
+ * stable the VVS stage does not allocate memory for its matrices and vectors anymore.
+ *
+ * Each resize of a buffer of the workspace that changes its size is counted. The counter is reset by the tracker at
+ * the beginning of each virtual visual-servoing, i.e. once per call to track(), and can be retrieved with
+ * vpMbTracker::getNbVVSResizes(). Only the buffers of the workspace are counted, not the other heap allocations of
+ * the tracker.
+ */
+class VISP_EXPORT vpMbtVVSWorkspace
+{
+public:
+  vpMbtVVSWorkspace();
+
+  /*!
+   * Return the number of buffer resizes since the last call to resetNbResizes().
+   */
+  inline unsigned int getNbResizes() const { return m_nbResizes; }
+
+  /*!
+   * Reset the counter of buffer resizes.
+   */
+  inline void resetNbResizes() { m_nbResizes = 0; }
+
+  void resize(vpMatrix &M, unsigned int nrows, unsigned int ncols);
+  void resize(vpColVector &v_, unsigned int nrows);
+
+  //! \f$ \mathbf{L}^T \mathbf{L} \f$ normal matrix (6x6)
+  vpMatrix LTL;
+  //! \f$ \mathbf{L}^T \mathbf{R} \f$ vector (6x1)
+  vpColVector LTR;
+  //! Velocity estimated at the current iteration (6x1)
+  vpColVector v;
+  //! Residuals at the previous iteration, used by the Levenberg-Marquardt scheme
+  vpColVector error_prev;
+  //! Robust weights at the previous iteration, used by the Levenberg-Marquardt scheme
+  vpColVector w_prev;
+  //! Pose at the previous iteration
+  vpHomogeneousMatrix cMo_prev;
+  //! Weights used to compute the covariance matrix
+  vpColVector W_true;
+  //! Interaction matrix used to compute the covariance matrix
+  vpMatrix L_true;
+  //! Interaction matrix expressed with the estimated dof, used to compute the covariance matrix
+  vpMatrix LVJ_true;
+  //! Velocity twist matrix between the camera and the object frames
+  vpVelocityTwistMatrix cVo;
+  //! Product of the velocity twist matrix by the estimated dof matrix (6x6)
+  vpMatrix VJ;
+  //! Interaction matrix expressed with the estimated dof
+  vpMatrix LVJ;
+  //! Damped normal matrix of the Levenberg-Marquardt scheme (6x6)
+  vpMatrix LTLmuI;
+  //! Pseudo-inverse of the normal matrix (6x6)
+  vpMatrix LTL_pinv;
+
+private:
+  unsigned int m_nbResizes;
+};
+END_VISP_NAMESPACE
+#endif
@@ -57,7 +57,8 @@ BEGIN_VISP_NAMESPACE
   vpMbDepthDenseTracker::vpMbDepthDenseTracker()
   : vpMbTracker(), m_depthDenseHiddenFacesDisplay(), m_depthDenseListOfActiveFaces(), m_denseDepthNbFeatures(0), m_depthDenseFaces(),
   m_depthDenseSamplingStepX(2), m_depthDenseSamplingStepY(2), m_error_depthDense(), m_L_depthDense(),
-  m_robust_depthDense(), m_w_depthDense(), m_weightedError_depthDense()
+  m_robust_depthDense(), m_w_depthDense(), m_weightedError_depthDense(), m_L_faces_depthDense(),
+  m_error_faces_depthDense()
 #if DEBUG_DISPLAY_DEPTH_DENSE
   ,
   m_debugDisp_depthDense(nullptr), m_debugImage_depthDense()
@@ -124,8 +125,16 @@ void vpMbDepthDenseTracker::addFace(vpMbtPolygon &polygon, bool alreadyClose)
     return;
   }
 
-  // Copy hidden faces
-  m_depthDenseHiddenFacesDisplay = faces;
+  // Copy hidden faces. While the model is loaded the faces are only appended, so only the new ones are copied
+  std::vector<vpMbtPolygon *> &displayPolygons = m_depthDenseHiddenFacesDisplay.getPolygon();
+  if (m_depthDenseFaces.empty() || (displayPolygons.size() > faces.size())) {
+    m_depthDenseHiddenFacesDisplay = faces;
+  }
+  else {
+    for (unsigned int i = static_cast<unsigned int>(displayPolygons.size()); i < faces.size(); ++i) {
+      displayPolygons.push_back(new vpMbtPolygon(*faces[i]));
+    }
+  }
 
   vpMbtFaceDepthDense *normal_face = new vpMbtFaceDepthDense;
   normal_face->m_hiddenFace = &faces;
@@ -188,21 +197,27 @@ void vpMbDepthDenseTracker::computeVVS()
   double normRes_1 = -1;
   unsigned int iter = 0;
 
+  m_vvsWorkspace.resetNbResizes();
   computeVVSInit();
 
-  vpColVector error_prev(m_denseDepthNbFeatures);
-  vpMatrix LTL;
-  vpColVector LTR, v;
+  // Buffers are taken from the workspace to avoid to create them at each frame
+  vpColVector &error_prev = m_vvsWorkspace.error_prev;
+  m_vvsWorkspace.resize(error_prev, m_denseDepthNbFeatures);
+  vpMatrix &LTL = m_vvsWorkspace.LTL;
+  vpColVector &LTR = m_vvsWorkspace.LTR;
+  vpColVector &v = m_vvsWorkspace.v;
 
   double mu = m_initialMu;
-  vpHomogeneousMatrix cMo_prev;
+  vpHomogeneousMatrix &cMo_prev = m_vvsWorkspace.cMo_prev;
+  cMo_prev.eye();
 
   bool isoJoIdentity = m_isoJoIdentity; // Backup since it can be modified if L is not full rank
   if (isoJoIdentity)
     oJo.eye();
 
   vpVelocityTwistMatrix cVo;
-  vpMatrix L_true, LVJ_true;
+  vpMatrix &L_true = m_vvsWorkspace.L_true;
+  vpMatrix &LVJ_true = m_vvsWorkspace.LVJ_true;
 
   while (std::fabs(normRes_1 - normRes) > m_stopCriteriaEpsilon && (iter < m_maxIter)) {
     computeVVSInteractionMatrixAndResidu();
@@ -214,6 +229,7 @@ void vpMbDepthDenseTracker::computeVVS()
       computeVVSWeights();
 
       if (computeCovariance) {
+        m_vvsWorkspace.resize(L_true, m_L_depthDense.getRows(), m_L_depthDense.getCols());
         L_true = m_L_depthDense;
         if (!isoJoIdentity) {
           cVo.buildFrom(m_cMo);
@@ -276,6 +292,51 @@ void vpMbDepthDenseTracker::computeVVS()
 }
 
 void vpMbDepthDenseTracker::computeVVSInit()
+{
+  computeVVSInitResidu();
+
+  m_vvsWorkspace.resize(m_L_depthDense, m_denseDepthNbFeatures, 6);
+
+  // Per face buffers, reallocated only when the number of features of a face changes
+  if (m_L_faces_depthDense.size() != m_depthDenseListOfActiveFaces.size()) {
+    m_L_faces_depthDense.resize(m_depthDenseListOfActiveFaces.size());
+    m_error_faces_depthDense.resize(m_depthDenseListOfActiveFaces.size());
+  }
+  for (size_t i = 0; i < m_depthDenseListOfActiveFaces.size(); ++i) {
+    unsigned int nbFeatures = m_depthDenseListOfActiveFaces[i]->getNbFeatures();
+    m_vvsWorkspace.resize(m_L_faces_depthDense[i], nbFeatures, nbFeatures > 0 ? 6 : 0);
+    m_vvsWorkspace.resize(m_error_faces_depthDense[i], nbFeatures);
+  }
+}
+
+void vpMbDepthDenseTracker::computeVVSInteractionMatrixAndResidu()
+{
+  if (m_L_faces_depthDense.size() != m_depthDenseListOfActiveFaces.size()) {
+    m_L_faces_depthDense.resize(m_depthDenseListOfActiveFaces.size());
+    m_error_faces_depthDense.resize(m_depthDenseListOfActiveFaces.size());
+  }
+
+  unsigned int start_index = 0;
+  for (size_t i = 0; i < m_depthDenseListOfActiveFaces.size(); ++i) {
+    vpMbtFaceDepthDense *face = m_depthDenseListOfActiveFaces[i];
+
+    vpMatrix &L_face = m_L_faces_depthDense[i];
+    vpColVector &error = m_error_faces_depthDense[i];
+
+    face->computeInteractionMatrixAndResidu(m_cMo, L_face, error);
+
+    m_error_depthDense.insert(start_index, error);
+    m_L_depthDense.insert(L_face, start_index, 0);
+
+    start_index += error.getRows();
+  }
+}
+
+/*!
+  Initialize the buffers of the residuals and of the weights, without the buffers of the interaction matrix.
+  Used when the normal equations are accumulated with computeVVSNormalEquations().
+*/
+void vpMbDepthDenseTracker::computeVVSInitResidu()
 {
   m_denseDepthNbFeatures = 0;
 
@@ -285,30 +346,51 @@ void vpMbDepthDenseTracker::computeVVSInit()
     m_denseDepthNbFeatures += face->getNbFeatures();
   }
 
-  m_L_depthDense.resize(m_denseDepthNbFeatures, 6, false, false);
-  m_error_depthDense.resize(m_denseDepthNbFeatures, false);
-  m_weightedError_depthDense.resize(m_denseDepthNbFeatures, false);
+  m_vvsWorkspace.resize(m_error_depthDense, m_denseDepthNbFeatures);
+  m_vvsWorkspace.resize(m_weightedError_depthDense, m_denseDepthNbFeatures);
 
-  m_w_depthDense.resize(m_denseDepthNbFeatures, false);
+  m_vvsWorkspace.resize(m_w_depthDense, m_denseDepthNbFeatures);
   m_w_depthDense = 1;
 }
 
-void vpMbDepthDenseTracker::computeVVSInteractionMatrixAndResidu()
+/*!
+  Accumulate the normal equations of the dense depth features from the residuals computed with computeVVSResidu().
+
+  \param w : Pointer to the weights of the dense depth features, or nullptr to use unit weights.
+  \param LTL : 6x6 matrix where \f$ \sum w^2 \mathbf{l} \mathbf{l}^T \f$ is added.
+  \param LTR : 6-dim vector where \f$ \sum w^2 e \mathbf{l} \f$ is added.
+*/
+void vpMbDepthDenseTracker::computeVVSNormalEquations(const double *const w, vpMatrix &LTL, vpColVector &LTR) const
 {
   unsigned int start_index = 0;
   for (std::vector<vpMbtFaceDepthDense *>::const_iterator it = m_depthDenseListOfActiveFaces.begin();
        it != m_depthDenseListOfActiveFaces.end(); ++it) {
     vpMbtFaceDepthDense *face = *it;
+    unsigned int nbFeatures = face->getNbFeatures();
+    if (nbFeatures > 0) {
+      face->computeNormalEquations(m_error_depthDense.data + start_index, w != nullptr ? w + start_index : nullptr,
+                                   LTL, LTR);
+    }
 
-    vpMatrix L_face;
-    vpColVector error;
-
-    face->computeInteractionMatrixAndResidu(m_cMo, L_face, error);
+    start_index += nbFeatures;
+  }
+}
 
-    m_error_depthDense.insert(start_index, error);
-    m_L_depthDense.insert(L_face, start_index, 0);
+/*!
+  Compute the residuals of the dense depth features for the current pose, without building the interaction matrix.
+*/
+void vpMbDepthDenseTracker::computeVVSResidu()
+{
+  unsigned int start_index = 0;
+  for (std::vector<vpMbtFaceDepthDense *>::const_iterator it = m_depthDenseListOfActiveFaces.begin();
+       it != m_depthDenseListOfActiveFaces.end(); ++it) {
+    vpMbtFaceDepthDense *face = *it;
+    unsigned int nbFeatures = face->getNbFeatures();
+    if (nbFeatures > 0) {
+      face->computeResidu(m_cMo, m_error_depthDense.data + start_index);
+    }
 
-    start_index += error.getRows();
+    start_index += nbFeatures;
   }
 }
 
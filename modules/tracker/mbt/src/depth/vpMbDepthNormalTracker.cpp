@@ -45,6 +45,10 @@
 #include <visp3/mbt/vpMbDepthNormalTracker.h>
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
 
+#if defined(VISP_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
 #if DEBUG_DISPLAY_DEPTH_NORMAL
 #include <visp3/gui/vpDisplayGDI.h>
 #include <visp3/gui/vpDisplayX.h>
@@ -59,7 +63,7 @@ BEGIN_VISP_NAMESPACE
   m_depthNormalHiddenFacesDisplay(), m_depthNormalListOfActiveFaces(), m_depthNormalListOfDesiredFeatures(),
   m_depthNormalFaces(), m_depthNormalPclPlaneEstimationMethod(2), m_depthNormalPclPlaneEstimationRansacMaxIter(200),
   m_depthNormalPclPlaneEstimationRansacThreshold(0.001), m_depthNormalSamplingStepX(2), m_depthNormalSamplingStepY(2),
-  m_depthNormalUseRobust(false), m_error_depthNormal(), m_featuresToBeDisplayedDepthNormal(), m_L_depthNormal(),
+  m_depthNormalNbThreads(1), m_depthNormalUseRobust(false), m_error_depthNormal(), m_featuresToBeDisplayedDepthNormal(), m_L_depthNormal(),
   m_robust_depthNormal(), m_w_depthNormal(), m_weightedError_depthNormal()
 #if DEBUG_DISPLAY_DEPTH_NORMAL
   ,
@@ -90,8 +94,16 @@ void vpMbDepthNormalTracker::addFace(vpMbtPolygon &polygon, bool alreadyClose)
     return;
   }
 
-  // Copy hidden faces
-  m_depthNormalHiddenFacesDisplay = faces;
+  // Copy hidden faces. While the model is loaded the faces are only appended, so only the new ones are copied
+  std::vector<vpMbtPolygon *> &displayPolygons = m_depthNormalHiddenFacesDisplay.getPolygon();
+  if (m_depthNormalFaces.empty() || (displayPolygons.size() > faces.size())) {
+    m_depthNormalHiddenFacesDisplay = faces;
+  }
+  else {
+    for (unsigned int i = static_cast<unsigned int>(displayPolygons.size()); i < faces.size(); ++i) {
+      displayPolygons.push_back(new vpMbtPolygon(*faces[i]));
+    }
+  }
 
   vpMbtFaceDepthNormal *normal_face = new vpMbtFaceDepthNormal;
   normal_face->m_hiddenFace = &faces;
@@ -340,6 +352,20 @@ void vpMbDepthNormalTracker::display(const vpImage<vpRGBa> &I, const vpHomogeneo
   }
 }
 
+/*!
+  Return the number of threads to use to extract the features of the faces, 1
+  if they are processed sequentially.
+*/
+int vpMbDepthNormalTracker::getDepthNormalNbThreadsToUse() const
+{
+#if defined(VISP_HAVE_OPENMP)
+  int nbThreads = m_depthNormalNbThreads > 0 ? m_depthNormalNbThreads : omp_get_max_threads();
+  return std::max<int>(1, std::min<int>(nbThreads, static_cast<int>(m_depthNormalFaces.size())));
+#else
+  return 1;
+#endif
+}
+
 std::vector<std::vector<double> > vpMbDepthNormalTracker::getFeaturesForDisplayDepthNormal()
 {
   std::vector<std::vector<double> > features;
@@ -621,17 +647,23 @@ void vpMbDepthNormalTracker::segmentPointCloud(const pcl::PointCloud<pcl::PointX
   std::vector<std::vector<vpImagePoint> > roiPts_vec;
 #endif
 
-  for (std::vector<vpMbtFaceDepthNormal *>::iterator it = m_depthNormalFaces.begin(); it != m_depthNormalFaces.end();
-       ++it) {
-    vpMbtFaceDepthNormal *face = *it;
+  // The features of the faces are extracted in parallel, and gathered in the order of the faces
+  const int nbFaces = static_cast<int>(m_depthNormalFaces.size());
+  std::vector<vpColVector> desired_features_vec(m_depthNormalFaces.size());
+  std::vector<unsigned char> activated_faces(m_depthNormalFaces.size(), 0);
+#if defined(VISP_HAVE_OPENMP) && !DEBUG_DISPLAY_DEPTH_NORMAL
+  const int nbThreads = getDepthNormalNbThreadsToUse();
+#pragma omp parallel for num_threads(nbThreads) schedule(dynamic) if (nbThreads > 1)
+#endif
+  for (int i = 0; i < nbFaces; ++i) {
+    vpMbtFaceDepthNormal *face = m_depthNormalFaces[static_cast<size_t>(i)];
 
     if (face->isVisible() && face->isTracked()) {
-      vpColVector desired_features;
 
 #if DEBUG_DISPLAY_DEPTH_NORMAL
       std::vector<std::vector<vpImagePoint> > roiPts_vec_;
 #endif
-      if (face->computeDesiredFeatures(m_cMo, point_cloud->width, point_cloud->height, point_cloud, desired_features,
+      if (face->computeDesiredFeatures(m_cMo, point_cloud->width, point_cloud->height, point_cloud, desired_features_vec[static_cast<size_t>(i)],
                                        m_depthNormalSamplingStepX, m_depthNormalSamplingStepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
                                        ,
@@ -639,8 +671,7 @@ void vpMbDepthNormalTracker::segmentPointCloud(const pcl::PointCloud<pcl::PointX
 #endif
                                        ,
                                        m_mask)) {
-        m_depthNormalListOfDesiredFeatures.push_back(desired_features);
-        m_depthNormalListOfActiveFaces.push_back(face);
+        activated_faces[static_cast<size_t>(i)] = 1;
 
 #if DEBUG_DISPLAY_DEPTH_NORMAL
         roiPts_vec.insert(roiPts_vec.end(), roiPts_vec_.begin(), roiPts_vec_.end());
@@ -649,6 +680,13 @@ void vpMbDepthNormalTracker::segmentPointCloud(const pcl::PointCloud<pcl::PointX
     }
   }
 
+  for (size_t i = 0; i < m_depthNormalFaces.size(); ++i) {
+    if (activated_faces[i]) {
+      m_depthNormalListOfDesiredFeatures.push_back(desired_features_vec[i]);
+      m_depthNormalListOfActiveFaces.push_back(m_depthNormalFaces[i]);
+    }
+  }
+
 #if DEBUG_DISPLAY_DEPTH_NORMAL
   vpDisplay::display(m_debugImage_depthNormal);
 
@@ -684,18 +722,24 @@ void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &p
   std::vector<std::vector<vpImagePoint> > roiPts_vec;
 #endif
 
-  for (std::vector<vpMbtFaceDepthNormal *>::iterator it = m_depthNormalFaces.begin(); it != m_depthNormalFaces.end();
-       ++it) {
-    vpMbtFaceDepthNormal *face = *it;
+  // The features of the faces are extracted in parallel, and gathered in the order of the faces
+  const int nbFaces = static_cast<int>(m_depthNormalFaces.size());
+  std::vector<vpColVector> desired_features_vec(m_depthNormalFaces.size());
+  std::vector<unsigned char> activated_faces(m_depthNormalFaces.size(), 0);
+#if defined(VISP_HAVE_OPENMP) && !DEBUG_DISPLAY_DEPTH_NORMAL
+  const int nbThreads = getDepthNormalNbThreadsToUse();
+#pragma omp parallel for num_threads(nbThreads) schedule(dynamic) if (nbThreads > 1)
+#endif
+  for (int i = 0; i < nbFaces; ++i) {
+    vpMbtFaceDepthNormal *face = m_depthNormalFaces[static_cast<size_t>(i)];
 
     if (face->isVisible() && face->isTracked()) {
-      vpColVector desired_features;
 
 #if DEBUG_DISPLAY_DEPTH_NORMAL
       std::vector<std::vector<vpImagePoint> > roiPts_vec_;
 #endif
 
-      if (face->computeDesiredFeatures(m_cMo, width, height, point_cloud, desired_features, m_depthNormalSamplingStepX,
+      if (face->computeDesiredFeatures(m_cMo, width, height, point_cloud, desired_features_vec[static_cast<size_t>(i)], m_depthNormalSamplingStepX,
                                        m_depthNormalSamplingStepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
                                        ,
@@ -703,8 +747,7 @@ void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &p
 #endif
                                        ,
                                        m_mask)) {
-        m_depthNormalListOfDesiredFeatures.push_back(desired_features);
-        m_depthNormalListOfActiveFaces.push_back(face);
+        activated_faces[static_cast<size_t>(i)] = 1;
 
 #if DEBUG_DISPLAY_DEPTH_NORMAL
         roiPts_vec.insert(roiPts_vec.end(), roiPts_vec_.begin(), roiPts_vec_.end());
@@ -713,6 +756,13 @@ void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &p
     }
   }
 
+  for (size_t i = 0; i < m_depthNormalFaces.size(); ++i) {
+    if (activated_faces[i]) {
+      m_depthNormalListOfDesiredFeatures.push_back(desired_features_vec[i]);
+      m_depthNormalListOfActiveFaces.push_back(m_depthNormalFaces[i]);
+    }
+  }
+
 #if DEBUG_DISPLAY_DEPTH_NORMAL
   vpDisplay::display(m_debugImage_depthNormal);
 
@@ -747,18 +797,24 @@ void vpMbDepthNormalTracker::segmentPointCloud(const vpMatrix &point_cloud, unsi
   std::vector<std::vector<vpImagePoint> > roiPts_vec;
 #endif
 
-  for (std::vector<vpMbtFaceDepthNormal *>::iterator it = m_depthNormalFaces.begin(); it != m_depthNormalFaces.end();
-       ++it) {
-    vpMbtFaceDepthNormal *face = *it;
+  // The features of the faces are extracted in parallel, and gathered in the order of the faces
+  const int nbFaces = static_cast<int>(m_depthNormalFaces.size());
+  std::vector<vpColVector> desired_features_vec(m_depthNormalFaces.size());
+  std::vector<unsigned char> activated_faces(m_depthNormalFaces.size(), 0);
+#if defined(VISP_HAVE_OPENMP) && !DEBUG_DISPLAY_DEPTH_NORMAL
+  const int nbThreads = getDepthNormalNbThreadsToUse();
+#pragma omp parallel for num_threads(nbThreads) schedule(dynamic) if (nbThreads > 1)
+#endif
+  for (int i = 0; i < nbFaces; ++i) {
+    vpMbtFaceDepthNormal *face = m_depthNormalFaces[static_cast<size_t>(i)];
 
     if (face->isVisible() && face->isTracked()) {
-      vpColVector desired_features;
 
 #if DEBUG_DISPLAY_DEPTH_NORMAL
       std::vector<std::vector<vpImagePoint> > roiPts_vec_;
 #endif
 
-      if (face->computeDesiredFeatures(m_cMo, width, height, point_cloud, desired_features, m_depthNormalSamplingStepX,
+      if (face->computeDesiredFeatures(m_cMo, width, height, point_cloud, desired_features_vec[static_cast<size_t>(i)], m_depthNormalSamplingStepX,
                                        m_depthNormalSamplingStepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
                                        ,
@@ -766,8 +822,7 @@ void vpMbDepthNormalTracker::segmentPointCloud(const vpMatrix &point_cloud, unsi
 #endif
                                        ,
                                        m_mask)) {
-        m_depthNormalListOfDesiredFeatures.push_back(desired_features);
-        m_depthNormalListOfActiveFaces.push_back(face);
+        activated_faces[static_cast<size_t>(i)] = 1;
 
 #if DEBUG_DISPLAY_DEPTH_NORMAL
         roiPts_vec.insert(roiPts_vec.end(), roiPts_vec_.begin(), roiPts_vec_.end());
@@ -776,6 +831,13 @@ void vpMbDepthNormalTracker::segmentPointCloud(const vpMatrix &point_cloud, unsi
     }
   }
 
+  for (size_t i = 0; i < m_depthNormalFaces.size(); ++i) {
+    if (activated_faces[i]) {
+      m_depthNormalListOfDesiredFeatures.push_back(desired_features_vec[i]);
+      m_depthNormalListOfActiveFaces.push_back(m_depthNormalFaces[i]);
+    }
+  }
+
 #if DEBUG_DISPLAY_DEPTH_NORMAL
   vpDisplay::display(m_debugImage_depthNormal);
 
@@ -864,6 +926,17 @@ void vpMbDepthNormalTracker::setDepthNormalSamplingStep(unsigned int stepX, unsi
   m_depthNormalSamplingStepY = stepY;
 }
 
+/*!
+  Set the number of threads used to extract the depth normal features of the
+  faces, that is to segment the point cloud and to estimate the plane of each
+  visible face. The result does not depend on the number of threads.
+
+  \param nbThreads : Number of threads. 1 (default) processes the faces
+  sequentially, a value lower or equal to 0 uses the number of threads given
+  by OpenMP. Without OpenMP the faces are always processed sequentially.
+*/
+void vpMbDepthNormalTracker::setDepthNormalNbThreads(int nbThreads) { m_depthNormalNbThreads = nbThreads; }
+
 // void vpMbDepthNormalTracker::setDepthNormalUseRobust(bool use) {
 //  m_depthNormalUseRobust = use;
 //}
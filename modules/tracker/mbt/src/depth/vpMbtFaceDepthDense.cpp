@@ -836,6 +836,110 @@ void vpMbtFaceDepthDense::computeInteractionMatrixAndResidu(const vpHomogeneousM
   }
 }
 
+/*!
+  Accumulate the contribution of the face to the normal equations of the pose estimation, without building its
+  interaction matrix. The interaction matrix of a point \f$ \mathbf{p} \f$ of the face is
+  \f$ \mathbf{l}^T = (\mathbf{n}^T, (\mathbf{p} \times \mathbf{n})^T) \f$ where \f$ \mathbf{n} \f$ is the
+  normal of the plane, so that only the sums over the points of \f$ w^2 \f$, \f$ w^2 e \f$,
+  \f$ w^2 (\mathbf{p} \times \mathbf{n}) \f$, \f$ w^2 e (\mathbf{p} \times \mathbf{n}) \f$ and
+  \f$ w^2 (\mathbf{p} \times \mathbf{n}) (\mathbf{p} \times \mathbf{n})^T \f$ are needed.
+
+  \param error : Pointer to the residuals of the face, computed with computeResidu().
+  \param w : Pointer to the weights of the face, or nullptr to use unit weights.
+  \param LTL : 6x6 matrix where \f$ \sum w^2 \mathbf{l} \mathbf{l}^T \f$ is added.
+  \param LTR : 6-dim vector where \f$ \sum w^2 e \mathbf{l} \f$ is added.
+*/
+void vpMbtFaceDepthDense::computeNormalEquations(const double *const error, const double *const w, vpMatrix &LTL,
+                                                 vpColVector &LTR) const
+{
+  if (m_pointCloudFace.empty()) {
+    return;
+  }
+
+  const double nx = m_planeCamera.getA();
+  const double ny = m_planeCamera.getB();
+  const double nz = m_planeCamera.getC();
+
+  double sw = 0, swe = 0;
+  double sa1 = 0, sa2 = 0, sa3 = 0;
+  double sea1 = 0, sea2 = 0, sea3 = 0;
+  double sa11 = 0, sa12 = 0, sa13 = 0, sa22 = 0, sa23 = 0, sa33 = 0;
+
+  const size_t nbFeatures = m_pointCloudFace.size() / 3;
+  const double *ptr_point_cloud = &m_pointCloudFace[0];
+  for (size_t i = 0; i < nbFeatures; ++i, ptr_point_cloud += 3) {
+    const double x = ptr_point_cloud[0];
+    const double y = ptr_point_cloud[1];
+    const double z = ptr_point_cloud[2];
+
+    const double a1 = (nz * y) - (ny * z);
+    const double a2 = (nx * z) - (nz * x);
+    const double a3 = (ny * x) - (nx * y);
+
+    const double w2 = (w != nullptr) ? w[i] * w[i] : 1.0;
+    const double w2e = w2 * error[i];
+    const double w2a1 = w2 * a1;
+    const double w2a2 = w2 * a2;
+    const double w2a3 = w2 * a3;
+
+    sw += w2;
+    swe += w2e;
+    sa1 += w2a1;
+    sa2 += w2a2;
+    sa3 += w2a3;
+    sea1 += w2e * a1;
+    sea2 += w2e * a2;
+    sea3 += w2e * a3;
+    sa11 += w2a1 * a1;
+    sa12 += w2a1 * a2;
+    sa13 += w2a1 * a3;
+    sa22 += w2a2 * a2;
+    sa23 += w2a2 * a3;
+    sa33 += w2a3 * a3;
+  }
+
+  const double n[3] = { nx, ny, nz };
+  const double sa[3] = { sa1, sa2, sa3 };
+  const double saa[3][3] = { { sa11, sa12, sa13 }, { sa12, sa22, sa23 }, { sa13, sa23, sa33 } };
+  for (unsigned int i = 0; i < 3; ++i) {
+    for (unsigned int j = 0; j < 3; ++j) {
+      LTL[i][j] += sw * n[i] * n[j];
+      LTL[i][j + 3] += n[i] * sa[j];
+      LTL[i + 3][j] += sa[i] * n[j];
+      LTL[i + 3][j + 3] += saa[i][j];
+    }
+    LTR[i] += swe * n[i];
+  }
+  LTR[3] += sea1;
+  LTR[4] += sea2;
+  LTR[5] += sea3;
+}
+
+/*!
+  Compute the residuals of the face for the given pose, without building its interaction matrix.
+  The plane equation expressed in the camera frame is updated and used by computeNormalEquations().
+
+  \param cMo : Current pose.
+  \param error : Pointer to the residuals of the face, with getNbFeatures() elements.
+*/
+void vpMbtFaceDepthDense::computeResidu(const vpHomogeneousMatrix &cMo, double *const error)
+{
+  // Transform the plane equation for the current pose
+  m_planeCamera = m_planeObject;
+  m_planeCamera.changeFrame(cMo);
+
+  const double nx = m_planeCamera.getA();
+  const double ny = m_planeCamera.getB();
+  const double nz = m_planeCamera.getC();
+  const double D = m_planeCamera.getD();
+
+  const size_t nbFeatures = m_pointCloudFace.size() / 3;
+  for (size_t i = 0; i < nbFeatures; ++i) {
+    error[i] = D + (nx * m_pointCloudFace[3 * i]) + (ny * m_pointCloudFace[3 * i + 1]) +
+      (nz * m_pointCloudFace[3 * i + 2]);
+  }
+}
+
 void vpMbtFaceDepthDense::computeROI(const vpHomogeneousMatrix &cMo, unsigned int width, unsigned int height,
                                      std::vector<vpImagePoint> &roiPts
 #if DEBUG_DISPLAY_DEPTH_DENSE
@@ -1615,12 +1615,15 @@ void vpMbtFaceDepthNormal::estimatePlaneEquationSVD(const std::vector<double> &p
   unsigned int max_iter = 10;
   double prev_error = 1e3;
   double error = 1e3 - 1;
+  const size_t nbPoints = point_cloud_face.size() / 3;
 
-  std::vector<double> weights(point_cloud_face.size() / 3, 1.0);
-  std::vector<double> residues(point_cloud_face.size() / 3);
-  vpMatrix M(static_cast<unsigned int>(point_cloud_face.size() / 3), 3);
+  std::vector<double> weights(nbPoints, 1.0);
+  std::vector<double> residues(nbPoints);
   vpMbtTukeyEstimator<double> tukey;
   vpColVector normal;
+  vpMatrix J(3, 3);
+  vpColVector W;
+  vpMatrix V;
 
   for (unsigned int iter = 0; iter < max_iter && std::fabs(error - prev_error) > 1e-6; iter++) {
     if (iter != 0) {
@@ -1635,12 +1638,12 @@ void vpMbtFaceDepthNormal::estimatePlaneEquationSVD(const std::vector<double> &p
       double B = m_planeCamera.getB();
       double C = m_planeCamera.getC();
       double D = m_planeCamera.getD();
+      const double inv_norm = 1.0 / sqrt(A * A + B * B + C * C);
 
       // Compute distance point to estimated plane
-      for (size_t i = 0; i < point_cloud_face.size() / 3; i++) {
+      for (size_t i = 0; i < nbPoints; i++) {
         residues[i] = std::fabs(A * point_cloud_face[3 * i] + B * point_cloud_face[3 * i + 1] +
-                                C * point_cloud_face[3 * i + 2] + D) /
-          sqrt(A * A + B * B + C * C);
+                                C * point_cloud_face[3 * i + 2] + D) * inv_norm;
       }
 
       tukey.MEstimator(residues, weights, 1e-4);
@@ -1651,7 +1654,7 @@ void vpMbtFaceDepthNormal::estimatePlaneEquationSVD(const std::vector<double> &p
     double centroid_x = 0.0, centroid_y = 0.0, centroid_z = 0.0;
     double total_w = 0.0;
 
-    for (size_t i = 0; i < point_cloud_face.size() / 3; i++) {
+    for (size_t i = 0; i < nbPoints; i++) {
       centroid_x += weights[i] * point_cloud_face[3 * i];
       centroid_y += weights[i] * point_cloud_face[3 * i + 1];
       centroid_z += weights[i] * point_cloud_face[3 * i + 2];
@@ -1662,17 +1665,32 @@ void vpMbtFaceDepthNormal::estimatePlaneEquationSVD(const std::vector<double> &p
     centroid_y /= total_w;
     centroid_z /= total_w;
 
-    // Minimization
-    for (size_t i = 0; i < point_cloud_face.size() / 3; i++) {
-      M[static_cast<unsigned int>(i)][0] = weights[i] * (point_cloud_face[3 * i] - centroid_x);
-      M[static_cast<unsigned int>(i)][1] = weights[i] * (point_cloud_face[3 * i + 1] - centroid_y);
-      M[static_cast<unsigned int>(i)][2] = weights[i] * (point_cloud_face[3 * i + 2] - centroid_z);
+    // Minimization: the second order moments of the weighted points around the centroid are accumulated directly,
+    // instead of building the matrix of the weighted centered points to compute its normal matrix
+    double sum_xx = 0.0, sum_xy = 0.0, sum_xz = 0.0, sum_yy = 0.0, sum_yz = 0.0, sum_zz = 0.0;
+    for (size_t i = 0; i < nbPoints; i++) {
+      const double dx = weights[i] * (point_cloud_face[3 * i] - centroid_x);
+      const double dy = weights[i] * (point_cloud_face[3 * i + 1] - centroid_y);
+      const double dz = weights[i] * (point_cloud_face[3 * i + 2] - centroid_z);
+
+      sum_xx += dx * dx;
+      sum_xy += dx * dy;
+      sum_xz += dx * dz;
+      sum_yy += dy * dy;
+      sum_yz += dy * dz;
+      sum_zz += dz * dz;
     }
 
-    vpMatrix J = M.t() * M;
+    J[0][0] = sum_xx;
+    J[0][1] = sum_xy;
+    J[0][2] = sum_xz;
+    J[1][0] = sum_xy;
+    J[1][1] = sum_yy;
+    J[1][2] = sum_yz;
+    J[2][0] = sum_xz;
+    J[2][1] = sum_yz;
+    J[2][2] = sum_zz;
 
-    vpColVector W;
-    vpMatrix V;
     J.svd(W, V);
 
     double smallestSv = W[0];
@@ -1699,10 +1717,10 @@ void vpMbtFaceDepthNormal::estimatePlaneEquationSVD(const std::vector<double> &p
     // Compute error points to estimated plane
     prev_error = error;
     error = 0.0;
-    for (size_t i = 0; i < point_cloud_face.size() / 3; i++) {
+    const double inv_norm = 1.0 / sqrt(A * A + B * B + C * C);
+    for (size_t i = 0; i < nbPoints; i++) {
       residues[i] = std::fabs(A * point_cloud_face[3 * i] + B * point_cloud_face[3 * i + 1] +
-                              C * point_cloud_face[3 * i + 2] + D) /
-        sqrt(A * A + B * B + C * C);
+                              C * point_cloud_face[3 * i + 2] + D) * inv_norm;
       error += weights[i] * residues[i];
     }
     error /= total_w;
@@ -1715,7 +1733,7 @@ void vpMbtFaceDepthNormal::estimatePlaneEquationSVD(const std::vector<double> &p
   centroid.resize(3, false);
   double total_w = 0.0;
 
-  for (size_t i = 0; i < point_cloud_face.size() / 3; i++) {
+  for (size_t i = 0; i < nbPoints; i++) {
     centroid[0] += weights[i] * point_cloud_face[3 * i];
     centroid[1] += weights[i] * point_cloud_face[3 * i + 1];
     centroid[2] += weights[i] * point_cloud_face[3 * i + 2];
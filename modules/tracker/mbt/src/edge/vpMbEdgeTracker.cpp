@@ -61,11 +61,11 @@ BEGIN_VISP_NAMESPACE
   Basic constructor
 */
 vpMbEdgeTracker::vpMbEdgeTracker()
-  : me(), lines(1), circles(1), cylinders(1), nline(0), ncircle(0), ncylinder(0), nbvisiblepolygone(0),
+  : me(), lines(1), m_linesIndex(1), circles(1), cylinders(1), nline(0), ncircle(0), ncylinder(0), nbvisiblepolygone(0),
   percentageGdPt(0.4), scales(1), Ipyramid(0), scaleLevel(0), nbFeaturesForProjErrorComputation(0), m_factor(),
   m_robustLines(), m_robustCylinders(), m_robustCircles(), m_wLines(), m_wCylinders(), m_wCircles(), m_errorLines(),
   m_errorCylinders(), m_errorCircles(), m_L_edge(), m_error_edge(), m_w_edge(), m_weightedError_edge(),
-  m_robust_edge(), m_featuresToBeDisplayedEdge()
+  m_robust_edge(), m_featuresToBeDisplayedEdge(), m_imagePyramid(nullptr), m_ipyramidShared(false)
 {
   scales[0] = true;
 
@@ -195,19 +195,22 @@ void vpMbEdgeTracker::computeVVS(const vpImage<unsigned char> &I_, unsigned int
   //   initial cMo: \n" << cMo << std::endl;
 
   /*** Second phase ***/
-  vpHomogeneousMatrix cMoPrev;
-  vpColVector W_true(nbrow);
-  vpMatrix L_true;
-  vpMatrix LVJ_true;
+  // Buffers are taken from the workspace to avoid to create them at each iteration and each frame
+  vpHomogeneousMatrix &cMoPrev = m_vvsWorkspace.cMo_prev;
+  cMoPrev.eye();
+  vpColVector &W_true = m_vvsWorkspace.W_true;
+  m_vvsWorkspace.resize(W_true, nbrow);
+  W_true = 0;
+  vpMatrix &L_true = m_vvsWorkspace.L_true;
+  vpMatrix &LVJ_true = m_vvsWorkspace.LVJ_true;
 
   double mu = m_initialMu;
-  vpColVector m_error_prev;
-  vpColVector m_w_prev;
+  vpColVector &m_error_prev = m_vvsWorkspace.error_prev;
+  vpColVector &m_w_prev = m_vvsWorkspace.w_prev;
 
-  // To avoid to create these matrices each iteration
-  vpMatrix LTL;
-  vpColVector LTR;
-  vpColVector v;
+  vpMatrix &LTL = m_vvsWorkspace.LTL;
+  vpColVector &LTR = m_vvsWorkspace.LTR;
+  vpColVector &v = m_vvsWorkspace.v;
 
   iter = 0;
   m_w_edge = 1;
@@ -223,10 +226,10 @@ void vpMbEdgeTracker::computeVVS(const vpImage<unsigned char> &I_, unsigned int
     if (!reStartFromLastIncrement) {
       computeVVSWeights();
 
-      L_true = m_L_edge;
       vpVelocityTwistMatrix cVo;
 
       if (computeCovariance) {
+        m_vvsWorkspace.resize(L_true, m_L_edge.getRows(), m_L_edge.getCols());
         L_true = m_L_edge;
         if (!isoJoIdentity) {
           cVo.buildFrom(m_cMo);
@@ -738,29 +741,29 @@ void vpMbEdgeTracker::computeVVSInit()
                               "No data found to compute the interaction matrix...");
   }
 
-  m_L_edge.resize(nbrow, 6, false, false);
-  m_error_edge.resize(nbrow, false);
+  m_vvsWorkspace.resize(m_L_edge, nbrow, 6);
+  m_vvsWorkspace.resize(m_error_edge, nbrow);
 
-  m_weightedError_edge.resize(nbrow, false);
-  m_w_edge.resize(nbrow, false);
+  m_vvsWorkspace.resize(m_weightedError_edge, nbrow);
+  m_vvsWorkspace.resize(m_w_edge, nbrow);
   m_w_edge = 1;
-  m_factor.resize(nbrow, false);
+  m_vvsWorkspace.resize(m_factor, nbrow);
   m_factor = 1;
 
   m_robustLines.setMinMedianAbsoluteDeviation(2.0 / m_cam.get_px());
   m_robustCylinders.setMinMedianAbsoluteDeviation(2.0 / m_cam.get_px());
   m_robustCircles.setMinMedianAbsoluteDeviation(vpMath::sqr(2.0 / m_cam.get_px()));
 
-  m_wLines.resize(nberrors_lines, false);
+  m_vvsWorkspace.resize(m_wLines, nberrors_lines);
   m_wLines = 1;
-  m_wCylinders.resize(nberrors_cylinders, false);
+  m_vvsWorkspace.resize(m_wCylinders, nberrors_cylinders);
   m_wCylinders = 1;
-  m_wCircles.resize(nberrors_circles, false);
+  m_vvsWorkspace.resize(m_wCircles, nberrors_circles);
   m_wCircles = 1;
 
-  m_errorLines.resize(nberrors_lines, false);
-  m_errorCylinders.resize(nberrors_cylinders, false);
-  m_errorCircles.resize(nberrors_circles, false);
+  m_vvsWorkspace.resize(m_errorLines, nberrors_lines);
+  m_vvsWorkspace.resize(m_errorCylinders, nberrors_cylinders);
+  m_vvsWorkspace.resize(m_errorCircles, nberrors_circles);
 }
 
 void vpMbEdgeTracker::computeVVSInteractionMatrixAndResidu()
@@ -1026,6 +1029,7 @@ void vpMbEdgeTracker::testTracking()
  */
 void vpMbEdgeTracker::track(const vpImage<unsigned char> &I)
 {
+  m_vvsWorkspace.resetNbResizes();
   initPyramid(I, Ipyramid);
 
   unsigned int lvl = static_cast<unsigned int>(scales.size());
@@ -1129,6 +1133,29 @@ void vpMbEdgeTracker::track(const vpImage<vpRGBa> &I)
   track(m_I);
 }
 
+/*!
+  Compute each state of the tracking procedure for all the feature sets, on
+  an image given by its pyramid. The levels used by the multi-scale tracking
+  (see setScales()) are taken from the decimated levels of the pyramid, so
+  that they are shared with the other consumers of the same image.
+
+  If the tracking is considered as failed an exception is thrown.
+
+  \param pyramid : Pyramid of the image.
+ */
+void vpMbEdgeTracker::track(const vpImagePyramid &pyramid)
+{
+  m_imagePyramid = &pyramid;
+  try {
+    vpMbEdgeTracker::track(pyramid.getImage());
+  }
+  catch (...) {
+    m_imagePyramid = nullptr;
+    throw;
+  }
+  m_imagePyramid = nullptr;
+}
+
 /*!
  Initialize the tracking.
 
@@ -2004,19 +2031,29 @@ void vpMbEdgeTracker::addLine(vpPoint &P1, vpPoint &P2, int polygon, std::string
     bool already_here = false;
     vpMbtDistanceLine *l;
 
+    if (m_linesIndex.size() != lines.size()) {
+      m_linesIndex.resize(lines.size());
+    }
+    std::vector<vpMbtDistanceLine *> matches;
     for (unsigned int i = 0; i < scales.size(); i += 1) {
       if (scales[i]) {
         downScale(i);
-        for (std::list<vpMbtDistanceLine *>::const_iterator it = lines[i].begin(); it != lines[i].end(); ++it) {
-          l = *it;
-          if ((samePoint(*(l->p1), P1) && samePoint(*(l->p2), P2)) ||
-              (samePoint(*(l->p1), P2) && samePoint(*(l->p2), P1))) {
-            already_here = true;
-            l->addPolygon(polygon);
-            l->hiddenface = &faces;
+        // The index is rebuilt if the lines were modified without this function
+        if (m_linesIndex[i].size() != lines[i].size()) {
+          m_linesIndex[i].clear();
+          for (std::list<vpMbtDistanceLine *>::const_iterator it = lines[i].begin(); it != lines[i].end(); ++it) {
+            m_linesIndex[i].insert(std::make_pair((*it)->p1->get_oX(), *it));
           }
         }
 
+        findLines(m_linesIndex[i], P1, P2, matches);
+        for (size_t k = 0; k < matches.size(); ++k) {
+          l = matches[k];
+          already_here = true;
+          l->addPolygon(polygon);
+          l->hiddenface = &faces;
+        }
+
         if (!already_here) {
           l = new vpMbtDistanceLine;
 
@@ -2041,6 +2078,7 @@ void vpMbEdgeTracker::addLine(vpPoint &P1, vpPoint &P2, int polygon, std::string
 
           nline += 1;
           lines[i].push_back(l);
+          m_linesIndex[i].insert(std::make_pair(l->p1->get_oX(), l));
         }
         upScale(i);
       }
@@ -2758,6 +2796,15 @@ void vpMbEdgeTracker::initPyramid(const vpImage<unsigned char> &I_,
 {
   _pyramid.resize(scales.size());
 
+  // Use the levels of the pyramid given to track(const vpImagePyramid &) rather than computing new ones
+  m_ipyramidShared = (m_imagePyramid != nullptr) && (&I_ == &m_imagePyramid->getImage());
+  if (m_ipyramidShared) {
+    for (unsigned int i = 0; i < _pyramid.size(); i += 1) {
+      _pyramid[i] = scales[i] ? &m_imagePyramid->getDecimatedLevel(i) : nullptr;
+    }
+    return;
+  }
+
   if (scales[0]) {
     _pyramid[0] = &I_;
   }
@@ -2793,13 +2840,14 @@ void vpMbEdgeTracker::cleanPyramid(std::vector<const vpImage<unsigned char> *> &
   if (_pyramid.size() > 0) {
     _pyramid[0] = nullptr;
     for (unsigned int i = 1; i < _pyramid.size(); i += 1) {
-      if (_pyramid[i] != nullptr) {
+      if ((_pyramid[i] != nullptr) && (!m_ipyramidShared)) {
         delete _pyramid[i];
         _pyramid[i] = nullptr;
       }
     }
     _pyramid.resize(0);
   }
+  m_ipyramidShared = false;
 }
 
 /*!
@@ -39,6 +39,16 @@
 #include <visp3/core/vpIoTools.h>
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
 
+#include <exception>
+
+#if defined(VISP_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+#if defined(VISP_HAVE_SIMDLIB)
+#include <Simd/SimdLib.h>
+#endif
+
 #ifdef VISP_HAVE_NLOHMANN_JSON
 #include VISP_NLOHMANN_JSON(json.hpp)
 using json = nlohmann::json; //! json namespace shortcut
@@ -48,7 +58,8 @@ BEGIN_VISP_NAMESPACE
 vpMbGenericTracker::vpMbGenericTracker()
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
   m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
-  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0)
+  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0), m_useParallelVVS(false),
+  m_nbParallelVVSThreads(0), m_mapOfVelocityTwist(), m_useNormalEquations(false), m_vvsCameras()
 {
   m_mapOfTrackers["Camera"] = new TrackerWrapper(EDGE_TRACKER);
 
@@ -69,7 +80,8 @@ vpMbGenericTracker::vpMbGenericTracker()
 vpMbGenericTracker::vpMbGenericTracker(unsigned int nbCameras, int trackerType)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
   m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
-  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0)
+  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0), m_useParallelVVS(false),
+  m_nbParallelVVSThreads(0), m_mapOfVelocityTwist(), m_useNormalEquations(false), m_vvsCameras()
 {
   if (nbCameras == 0) {
     throw vpException(vpTrackingException::fatalError, "Cannot use no camera!");
@@ -108,7 +120,8 @@ vpMbGenericTracker::vpMbGenericTracker(unsigned int nbCameras, int trackerType)
 vpMbGenericTracker::vpMbGenericTracker(const std::vector<int> &trackerTypes)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
   m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
-  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0)
+  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0), m_useParallelVVS(false),
+  m_nbParallelVVSThreads(0), m_mapOfVelocityTwist(), m_useNormalEquations(false), m_vvsCameras()
 {
   if (trackerTypes.empty()) {
     throw vpException(vpException::badValue, "There is no camera!");
@@ -149,7 +162,8 @@ vpMbGenericTracker::vpMbGenericTracker(const std::vector<std::string> &cameraNam
   const std::vector<int> &trackerTypes)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
   m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
-  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0)
+  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0), m_useParallelVVS(false),
+  m_nbParallelVVSThreads(0), m_mapOfVelocityTwist(), m_useNormalEquations(false), m_vvsCameras()
 {
   if (cameraNames.size() != trackerTypes.size() || cameraNames.empty()) {
     throw vpException(vpTrackingException::badValue,
@@ -289,6 +303,16 @@ void vpMbGenericTracker::computeProjectionError()
 
 void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages)
 {
+  // The covariance matrix is computed from the stacked interaction matrix
+  const bool useNormalEquations = m_useNormalEquations && !computeCovariance;
+
+  m_vvsWorkspace.resetNbResizes();
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+    it != m_mapOfTrackers.end(); ++it) {
+    it->second->m_vvsWorkspace.resetNbResizes();
+    it->second->m_useNormalEquations = useNormalEquations;
+  }
+
   computeVVSInit(mapOfImages);
 
   if (m_error.getRows() < 4) {
@@ -299,44 +323,40 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
   double normRes_1 = -1;
   unsigned int iter = 0;
 
-  vpMatrix LTL;
-  vpColVector LTR, v;
-  vpColVector error_prev;
+  // Buffers are taken from the workspace to avoid to create them at each frame
+  vpMatrix &LTL = m_vvsWorkspace.LTL;
+  vpColVector &LTR = m_vvsWorkspace.LTR;
+  vpColVector &v = m_vvsWorkspace.v;
+  vpColVector &error_prev = m_vvsWorkspace.error_prev;
 
   double mu = m_initialMu;
-  vpHomogeneousMatrix cMo_prev;
+  vpHomogeneousMatrix &cMo_prev = m_vvsWorkspace.cMo_prev;
+  cMo_prev.eye();
 
   bool isoJoIdentity = m_isoJoIdentity; // Backup since it can be modified if L is not full rank
   if (isoJoIdentity)
     oJo.eye();
 
   // Covariance
-  vpColVector W_true(m_error.getRows());
-  vpMatrix L_true, LVJ_true;
+  vpColVector &W_true = m_vvsWorkspace.W_true;
+  m_vvsWorkspace.resize(W_true, m_error.getRows());
+  W_true = 0;
+  vpMatrix &L_true = m_vvsWorkspace.L_true;
+  vpMatrix &LVJ_true = m_vvsWorkspace.LVJ_true;
 
-  // Create the map of VelocityTwistMatrices
-  std::map<std::string, vpVelocityTwistMatrix> mapOfVelocityTwist;
+  // Update the map of VelocityTwistMatrices, the map is kept from one frame to another
   for (std::map<std::string, vpHomogeneousMatrix>::const_iterator it = m_mapOfCameraTransformationMatrix.begin();
     it != m_mapOfCameraTransformationMatrix.end(); ++it) {
-    vpVelocityTwistMatrix cVo;
-    cVo.buildFrom(it->second);
-    mapOfVelocityTwist[it->first] = cVo;
+    m_mapOfVelocityTwist[it->first].buildFrom(it->second);
   }
 
-  double factorEdge = m_mapOfFeatureFactors[EDGE_TRACKER];
-#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
-  double factorKlt = m_mapOfFeatureFactors[KLT_TRACKER];
-#endif
-  double factorDepth = m_mapOfFeatureFactors[DEPTH_NORMAL_TRACKER];
-  double factorDepthDense = m_mapOfFeatureFactors[DEPTH_DENSE_TRACKER];
-
   m_nb_feat_edge = 0;
   m_nb_feat_klt = 0;
   m_nb_feat_depthNormal = 0;
   m_nb_feat_depthDense = 0;
 
   while (std::fabs(normRes_1 - normRes) > m_stopCriteriaEpsilon && (iter < m_maxIter)) {
-    computeVVSInteractionMatrixAndResidu(mapOfImages, mapOfVelocityTwist);
+    computeVVSInteractionMatrixAndResidu(mapOfImages, m_mapOfVelocityTwist);
 
     bool reStartFromLastIncrement = false;
     computeVVSCheckLevenbergMarquardt(iter, m_error, error_prev, cMo_prev, mu, reStartFromLastIncrement);
@@ -359,6 +379,7 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
       computeVVSWeights();
 
       if (computeCovariance) {
+        m_vvsWorkspace.resize(L_true, m_L.getRows(), m_L.getCols());
         L_true = m_L;
         if (!isoJoIdentity) {
           vpVelocityTwistMatrix cVo;
@@ -377,7 +398,20 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
           cVo.buildFrom(m_cMo);
 
           vpMatrix K; // kernel
-          unsigned int rank = (m_L * cVo).kernel(K);
+          unsigned int rank = 0;
+          if (useNormalEquations) {
+            // Same kernel as L * cVo, the singular values of L^T L being the squared singular values of L
+            vpMatrix LTL_unweighted(6, 6);
+            for (size_t i = 0; i < m_vvsCameras.size(); ++i) {
+              computeVVSNormalEquations(m_vvsCameras[i], nullptr);
+              LTL_unweighted += m_vvsCameras[i].LTL;
+            }
+            vpMatrix V(cVo);
+            rank = (V.t() * LTL_unweighted * V).kernel(K, 1e-12);
+          }
+          else {
+            rank = (m_L * cVo).kernel(K);
+          }
           if (rank == 0) {
             throw vpException(vpException::fatalError, "Rank=0, cannot estimate the pose !");
           }
@@ -392,89 +426,52 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
       }
 
       // Weighting
+      // Partial sums are accumulated per camera and summed in a fixed order, so that the result does not depend on
+      // the number of threads
+      int nbCameras = static_cast<int>(m_vvsCameras.size());
+#if defined(VISP_HAVE_OPENMP)
+      int nbThreads = getNbVVSThreads(m_vvsCameras.size());
+#pragma omp parallel for num_threads(nbThreads) if (nbThreads > 1)
+#endif
+      for (int i = 0; i < nbCameras; ++i) {
+        vpVVSCamera &camera = m_vvsCameras[i];
+        camera.num = 0;
+        camera.den = 0;
+        computeVVSWeighting(camera.tracker, camera.start_index, W_true, camera.num, camera.den);
+      }
+
       double num = 0;
       double den = 0;
+      for (size_t i = 0; i < m_vvsCameras.size(); ++i) {
+        num += m_vvsCameras[i].num;
+        den += m_vvsCameras[i].den;
+      }
 
-      unsigned int start_index = 0;
-      for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-        it != m_mapOfTrackers.end(); ++it) {
-        TrackerWrapper *tracker = it->second;
-
-        if (tracker->m_trackerType & EDGE_TRACKER) {
-          for (unsigned int i = 0; i < tracker->m_error_edge.getRows(); i++) {
-            double wi = tracker->m_w_edge[i] * tracker->m_factor[i] * factorEdge;
-            W_true[start_index + i] = wi;
-            m_weightedError[start_index + i] = wi * m_error[start_index + i];
-
-            num += wi * vpMath::sqr(m_error[start_index + i]);
-            den += wi;
-
-            for (unsigned int j = 0; j < m_L.getCols(); j++) {
-              m_L[start_index + i][j] *= wi;
-            }
-          }
-
-          start_index += tracker->m_error_edge.getRows();
-        }
-
-#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
-        if (tracker->m_trackerType & KLT_TRACKER) {
-          for (unsigned int i = 0; i < tracker->m_error_klt.getRows(); i++) {
-            double wi = tracker->m_w_klt[i] * factorKlt;
-            W_true[start_index + i] = wi;
-            m_weightedError[start_index + i] = wi * m_error[start_index + i];
-
-            num += wi * vpMath::sqr(m_error[start_index + i]);
-            den += wi;
-
-            for (unsigned int j = 0; j < m_L.getCols(); j++) {
-              m_L[start_index + i][j] *= wi;
-            }
-          }
+      normRes_1 = normRes;
+      normRes = sqrt(num / den);
 
-          start_index += tracker->m_error_klt.getRows();
-        }
+      if (useNormalEquations) {
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nbThreads) if (nbThreads > 1)
 #endif
-
-        if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-          for (unsigned int i = 0; i < tracker->m_error_depthNormal.getRows(); i++) {
-            double wi = tracker->m_w_depthNormal[i] * factorDepth;
-            W_true[start_index + i] = wi;
-            m_weightedError[start_index + i] = wi * m_error[start_index + i];
-
-            num += wi * vpMath::sqr(m_error[start_index + i]);
-            den += wi;
-
-            for (unsigned int j = 0; j < m_L.getCols(); j++) {
-              m_L[start_index + i][j] *= wi;
-            }
-          }
-
-          start_index += tracker->m_error_depthNormal.getRows();
+        for (int i = 0; i < nbCameras; ++i) {
+          computeVVSNormalEquations(m_vvsCameras[i], &W_true);
         }
 
-        if (tracker->m_trackerType & DEPTH_DENSE_TRACKER) {
-          for (unsigned int i = 0; i < tracker->m_error_depthDense.getRows(); i++) {
-            double wi = tracker->m_w_depthDense[i] * factorDepthDense;
-            W_true[start_index + i] = wi;
-            m_weightedError[start_index + i] = wi * m_error[start_index + i];
-
-            num += wi * vpMath::sqr(m_error[start_index + i]);
-            den += wi;
-
-            for (unsigned int j = 0; j < m_L.getCols(); j++) {
-              m_L[start_index + i][j] *= wi;
-            }
-          }
-
-          start_index += tracker->m_error_depthDense.getRows();
+        m_vvsWorkspace.resize(LTL, 6, 6);
+        m_vvsWorkspace.resize(LTR, 6);
+        LTL = 0;
+        LTR = 0;
+        for (size_t i = 0; i < m_vvsCameras.size(); ++i) {
+          LTL += m_vvsCameras[i].LTL;
+          LTR += m_vvsCameras[i].LTR;
         }
-      }
-
-      normRes_1 = normRes;
-      normRes = sqrt(num / den);
 
-      computeVVSPoseEstimation(isoJoIdentity, iter, m_L, LTL, m_weightedError, m_error, error_prev, LTR, mu, v);
+        computeVVSPoseEstimationFromNormalEquations(isoJoIdentity, iter, LTL, LTR, m_error, error_prev, mu, v);
+      }
+      else {
+        computeVVSPoseEstimation(isoJoIdentity, iter, m_L, LTL, m_weightedError, m_error, error_prev, LTR, mu, v);
+      }
 
       cMo_prev = m_cMo;
 
@@ -550,11 +547,17 @@ void vpMbGenericTracker::computeVVSInit(std::map<std::string, const vpImage<unsi
     nbFeatures += tracker->m_error.getRows();
   }
 
-  m_L.resize(nbFeatures, 6, false, false);
-  m_error.resize(nbFeatures, false);
+  // The stacked interaction matrix is not needed when the normal equations are accumulated
+  if (m_useNormalEquations && !computeCovariance) {
+    m_vvsWorkspace.resize(m_L, 0, 0);
+  }
+  else {
+    m_vvsWorkspace.resize(m_L, nbFeatures, 6);
+  }
+  m_vvsWorkspace.resize(m_error, nbFeatures);
 
-  m_weightedError.resize(nbFeatures, false);
-  m_w.resize(nbFeatures, false);
+  m_vvsWorkspace.resize(m_weightedError, nbFeatures);
+  m_vvsWorkspace.resize(m_w, nbFeatures);
   m_w = 1;
 }
 
@@ -569,42 +572,307 @@ void vpMbGenericTracker::computeVVSInteractionMatrixAndResidu(
   std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
   std::map<std::string, vpVelocityTwistMatrix> &mapOfVelocityTwist)
 {
-  unsigned int start_index = 0;
+  // Look up everything that is needed for each camera before processing them, since the cameras can be processed
+  // concurrently and the std::map containers must not be accessed from several threads. The per-camera data are
+  // kept from one iteration to another to avoid reallocations.
+  if (m_vvsCameras.size() != m_mapOfTrackers.size()) {
+    m_vvsCameras.resize(m_mapOfTrackers.size());
+  }
 
+  unsigned int start_index = 0;
+  size_t idx = 0;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-    it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
+    it != m_mapOfTrackers.end(); ++it, ++idx) {
+    vpVVSCamera &camera = m_vvsCameras[idx];
+    camera.tracker = it->second;
+    camera.I = mapOfImages[it->first];
+    camera.cMcRef = m_mapOfCameraTransformationMatrix[it->first];
+    camera.cVo = mapOfVelocityTwist[it->first];
+    camera.start_index = start_index;
+
+    // The number of features of each camera is set in computeVVSInit()
+    start_index += it->second->m_error.getRows();
+  }
+
+  int nbCameras = static_cast<int>(m_vvsCameras.size());
+  std::exception_ptr exception;
+#if defined(VISP_HAVE_OPENMP)
+  int nbThreads = getNbVVSThreads(m_vvsCameras.size());
+#pragma omp parallel for num_threads(nbThreads) if (nbThreads > 1)
+#endif
+  for (int i = 0; i < nbCameras; ++i) {
+    try {
+      vpVVSCamera &camera = m_vvsCameras[i];
+      TrackerWrapper *tracker = camera.tracker;
 
-    tracker->m_cMo = m_mapOfCameraTransformationMatrix[it->first] * m_cMo;
+      tracker->m_cMo = camera.cMcRef * m_cMo;
 #if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
-    vpHomogeneousMatrix c_curr_tTc_curr0 =
-      m_mapOfCameraTransformationMatrix[it->first] * m_cMo * tracker->c0Mo.inverse();
-    tracker->ctTc0 = c_curr_tTc_curr0;
+      vpHomogeneousMatrix c_curr_tTc_curr0 = camera.cMcRef * m_cMo * tracker->c0Mo.inverse();
+      tracker->ctTc0 = c_curr_tTc_curr0;
 #endif
 
-    tracker->computeVVSInteractionMatrixAndResidu(mapOfImages[it->first]);
-
-    if (tracker->m_L.getRows() > 0) {
-      m_L.insert(tracker->m_L * mapOfVelocityTwist[it->first], start_index, 0);
-      m_error.insert(start_index, tracker->m_error);
+      tracker->computeVVSInteractionMatrixAndResidu(camera.I);
 
-      start_index += tracker->m_error.getRows();
+      // Each camera writes L * cVo and its residuals into its own row block of the stacked system
+      const unsigned int nbRows = tracker->m_L.getRows();
+      if (nbRows > 0 && !tracker->m_useNormalEquations) {
+#if defined(VISP_HAVE_SIMDLIB)
+        SimdMatMulTwist(tracker->m_L.data, nbRows, camera.cVo.data, m_L[camera.start_index]);
+#else
+        for (unsigned int r = 0; r < nbRows; ++r) {
+          const double *L_row = tracker->m_L[r];
+          double *L_stacked_row = m_L[camera.start_index + r];
+          for (unsigned int c = 0; c < 6; ++c) {
+            double s = 0;
+            for (unsigned int k = 0; k < 6; ++k) {
+              s += L_row[k] * camera.cVo[k][c];
+            }
+            L_stacked_row[c] = s;
+          }
+        }
+#endif
+      }
+      if (tracker->m_error.getRows() > 0) {
+        m_error.insert(camera.start_index, tracker->m_error);
+      }
+    }
+    catch (...) {
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp critical(vpMbGenericTracker_computeVVS)
+#endif
+      if (!exception) {
+        exception = std::current_exception();
+      }
     }
   }
+
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
 }
 
 void vpMbGenericTracker::computeVVSWeights()
 {
-  unsigned int start_index = 0;
+  // The start index of each camera has been set in computeVVSInteractionMatrixAndResidu()
+  int nbCameras = static_cast<int>(m_vvsCameras.size());
+#if defined(VISP_HAVE_OPENMP)
+  int nbThreads = getNbVVSThreads(m_vvsCameras.size());
+#pragma omp parallel for num_threads(nbThreads) if (nbThreads > 1)
+#endif
+  for (int i = 0; i < nbCameras; ++i) {
+    m_vvsCameras[i].tracker->computeVVSWeights();
+    m_w.insert(m_vvsCameras[i].start_index, m_vvsCameras[i].tracker->m_w);
+  }
+}
+
+namespace
+{
+/*!
+  Accumulate \f$ \sum w_i^2 \mathbf{l}_i \mathbf{l}_i^T \f$ and \f$ \sum w_i^2 e_i \mathbf{l}_i \f$ over the rows
+  of a n x 6 interaction matrix. Only the upper triangular part of LTL is accumulated.
+*/
+void accumulateNormalEquations(const double *L, unsigned int nbRows, const double *error, const double *w,
+                               double LTL[6][6], double LTR[6])
+{
+  for (unsigned int i = 0; i < nbRows; ++i, L += 6) {
+    const double w2 = (w != nullptr) ? w[i] * w[i] : 1.0;
+    const double w2e = w2 * error[i];
+    for (unsigned int r = 0; r < 6; ++r) {
+      const double w2l = w2 * L[r];
+      LTR[r] += w2e * L[r];
+      for (unsigned int c = r; c < 6; ++c) {
+        LTL[r][c] += w2l * L[c];
+      }
+    }
+  }
+}
+} // namespace
+
+/*!
+  Compute the normal equations of one camera from its residuals and its interaction matrix, expressed in the
+  reference camera frame: \f$ \mathbf{V}^T \mathbf{L}^T \mathbf{W} \mathbf{L} \mathbf{V} \f$ and
+  \f$ \mathbf{V}^T \mathbf{L}^T \mathbf{W} \mathbf{e} \f$ with \f$ \mathbf{V} \f$ the velocity twist matrix
+  between the reference camera frame and the camera frame. The interaction matrix of the dense depth features is
+  not built, their contribution is accumulated directly from the point clouds.
+
+  \param camera : Camera data, whose LTL and LTR are computed.
+  \param w : Weights of the stacked system, or nullptr to use unit weights.
+*/
+void vpMbGenericTracker::computeVVSNormalEquations(vpVVSCamera &camera, const vpColVector *const w)
+{
+  TrackerWrapper *tracker = camera.tracker;
+  const double *ptr_w = (w != nullptr) ? w->data + camera.start_index : nullptr;
 
+  // Features other than the dense depth ones, whose rows are stored first in the interaction matrix of the camera
+  double A[6][6] = { { 0 } };
+  double b[6] = { 0 };
+  const unsigned int nbRows = tracker->m_L.getRows();
+  if (nbRows > 0) {
+    accumulateNormalEquations(tracker->m_L.data, nbRows, m_error.data + camera.start_index, ptr_w, A, b);
+  }
+  for (unsigned int r = 0; r < 6; ++r) {
+    for (unsigned int c = 0; c < 6; ++c) {
+      camera.LTL[r][c] = (c >= r) ? A[r][c] : A[c][r];
+    }
+    camera.LTR[r] = b[r];
+  }
+
+  if (tracker->m_trackerType & DEPTH_DENSE_TRACKER) {
+    tracker->computeVVSNormalEquations(ptr_w != nullptr ? ptr_w + nbRows : nullptr, camera.LTL, camera.LTR);
+  }
+
+  // Change of frame: V^T (L^T W L) V and V^T (L^T W e)
+  const vpVelocityTwistMatrix &V = camera.cVo;
+  for (unsigned int r = 0; r < 6; ++r) {
+    for (unsigned int c = 0; c < 6; ++c) {
+      double s = 0;
+      for (unsigned int k = 0; k < 6; ++k) {
+        s += camera.LTL[r][k] * V[k][c];
+      }
+      A[r][c] = s;
+    }
+  }
+  for (unsigned int r = 0; r < 6; ++r) {
+    for (unsigned int c = 0; c < 6; ++c) {
+      double s = 0;
+      for (unsigned int k = 0; k < 6; ++k) {
+        s += V[k][r] * A[k][c];
+      }
+      camera.LTL[r][c] = s;
+    }
+    double s = 0;
+    for (unsigned int k = 0; k < 6; ++k) {
+      s += V[k][r] * camera.LTR[k];
+    }
+    b[r] = s;
+  }
+  for (unsigned int r = 0; r < 6; ++r) {
+    camera.LTR[r] = b[r];
+  }
+}
+
+/*!
+  Apply the robust weights and the feature factors of one camera to its row block of the stacked interaction
+  matrix and residuals.
+
+  \param tracker : Tracker of the camera.
+  \param start_index : Index of the first row of the camera in the stacked system.
+  \param W_true : Weights of the stacked system, used to compute the covariance.
+  \param num : Accumulated sum of the weighted squared residuals.
+  \param den : Accumulated sum of the weights.
+*/
+void vpMbGenericTracker::computeVVSWeighting(TrackerWrapper *tracker, unsigned int start_index, vpColVector &W_true,
+  double &num, double &den)
+{
+  if (tracker->m_trackerType & EDGE_TRACKER) {
+    double factorEdge = m_mapOfFeatureFactors.find(EDGE_TRACKER)->second;
+    for (unsigned int i = 0; i < tracker->m_error_edge.getRows(); i++) {
+      double wi = tracker->m_w_edge[i] * tracker->m_factor[i] * factorEdge;
+      W_true[start_index + i] = wi;
+      m_weightedError[start_index + i] = wi * m_error[start_index + i];
+
+      num += wi * vpMath::sqr(m_error[start_index + i]);
+      den += wi;
+
+      for (unsigned int j = 0; j < m_L.getCols(); j++) {
+        m_L[start_index + i][j] *= wi;
+      }
+    }
+
+    start_index += tracker->m_error_edge.getRows();
+  }
+
+#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
+  if (tracker->m_trackerType & KLT_TRACKER) {
+    double factorKlt = m_mapOfFeatureFactors.find(KLT_TRACKER)->second;
+    for (unsigned int i = 0; i < tracker->m_error_klt.getRows(); i++) {
+      double wi = tracker->m_w_klt[i] * factorKlt;
+      W_true[start_index + i] = wi;
+      m_weightedError[start_index + i] = wi * m_error[start_index + i];
+
+      num += wi * vpMath::sqr(m_error[start_index + i]);
+      den += wi;
+
+      for (unsigned int j = 0; j < m_L.getCols(); j++) {
+        m_L[start_index + i][j] *= wi;
+      }
+    }
+
+    start_index += tracker->m_error_klt.getRows();
+  }
+#endif
+
+  if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
+    double factorDepth = m_mapOfFeatureFactors.find(DEPTH_NORMAL_TRACKER)->second;
+    for (unsigned int i = 0; i < tracker->m_error_depthNormal.getRows(); i++) {
+      double wi = tracker->m_w_depthNormal[i] * factorDepth;
+      W_true[start_index + i] = wi;
+      m_weightedError[start_index + i] = wi * m_error[start_index + i];
+
+      num += wi * vpMath::sqr(m_error[start_index + i]);
+      den += wi;
+
+      for (unsigned int j = 0; j < m_L.getCols(); j++) {
+        m_L[start_index + i][j] *= wi;
+      }
+    }
+
+    start_index += tracker->m_error_depthNormal.getRows();
+  }
+
+  if (tracker->m_trackerType & DEPTH_DENSE_TRACKER) {
+    double factorDepthDense = m_mapOfFeatureFactors.find(DEPTH_DENSE_TRACKER)->second;
+    for (unsigned int i = 0; i < tracker->m_error_depthDense.getRows(); i++) {
+      double wi = tracker->m_w_depthDense[i] * factorDepthDense;
+      W_true[start_index + i] = wi;
+      m_weightedError[start_index + i] = wi * m_error[start_index + i];
+
+      num += wi * vpMath::sqr(m_error[start_index + i]);
+      den += wi;
+
+      for (unsigned int j = 0; j < m_L.getCols(); j++) {
+        m_L[start_index + i][j] *= wi;
+      }
+    }
+  }
+}
+
+/*!
+  Get the number of buffers of the virtual visual servoing workspace whose size changed during the last call to
+  track(), taking into account the buffers of all the cameras. These buffers are only resized, and thus reallocated,
+  when the number of features changes, so that this number is 0 once the number of tracked features is stable.
+  Other heap allocations of the tracker are not counted.
+
+  \return Number of workspace buffer resizes during the last call to track().
+*/
+unsigned int vpMbGenericTracker::getNbVVSResizes() const
+{
+  unsigned int nbResizes = m_vvsWorkspace.getNbResizes();
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
     it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->computeVVSWeights();
+    nbResizes += it->second->m_vvsWorkspace.getNbResizes();
+  }
 
-    m_w.insert(start_index, tracker->m_w);
-    start_index += tracker->m_w.getRows();
+  return nbResizes;
+}
+
+/*!
+  Return the number of threads to use to process the cameras in the VVS scheme, 1 if the parallel scheme is disabled.
+
+  \param nbCameras : Number of cameras to process.
+*/
+int vpMbGenericTracker::getNbVVSThreads(size_t nbCameras) const
+{
+  if (!m_useParallelVVS || nbCameras < 2) {
+    return 1;
   }
+
+#if defined(VISP_HAVE_OPENMP)
+  int nbThreads = m_nbParallelVVSThreads > 0 ? m_nbParallelVVSThreads : omp_get_max_threads();
+  return std::max<int>(1, std::min<int>(nbThreads, static_cast<int>(nbCameras)));
+#else
+  return 1;
+#endif
 }
 
 /*!
@@ -3182,6 +3450,28 @@ void vpMbGenericTracker::loadConfigFile(const std::map<std::string, std::string>
   }
 }
 
+/*!
+  Return true if the model of all the cameras was read from the compiled model cache by the last call to
+  loadModel().
+
+  \sa setCompiledModelCache()
+*/
+bool vpMbGenericTracker::isModelLoadedFromCache() const
+{
+  if (m_mapOfTrackers.empty()) {
+    return false;
+  }
+
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+    it != m_mapOfTrackers.end(); ++it) {
+    if (!it->second->isModelLoadedFromCache()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 /*!
   Load a 3D model from the file in parameter. This file must either be a vrml
   file (.wrl) or a CAO file (.cao). CAO format is described in the
@@ -4042,6 +4332,26 @@ void vpMbGenericTracker::setClipping(const std::map<std::string, unsigned int> &
   }
 }
 
+/*!
+  Enable or disable the compiled model cache used by loadModel(), see vpMbTracker::setCompiledModelCache().
+
+  \param enable : If true, enable the cache.
+  \param directory : Directory where the cache files are written. If empty, the cache file is written next to
+  the model file.
+
+  \note This function will set the new parameter for all the cameras.
+*/
+void vpMbGenericTracker::setCompiledModelCache(bool enable, const std::string &directory)
+{
+  vpMbTracker::setCompiledModelCache(enable, directory);
+
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+    it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->setCompiledModelCache(enable, directory);
+  }
+}
+
 /*!
   Set maximum distance to consider a face.
   You should use the maximum depth range of the sensor used.
@@ -4163,6 +4473,25 @@ void vpMbGenericTracker::setDepthNormalFeatureEstimationMethod(
   }
 }
 
+/*!
+  Set the number of threads used to extract the depth normal features of the
+  faces.
+
+  \param nbThreads : Number of threads. 1 (default) processes the faces
+  sequentially, a value lower or equal to 0 uses the number of threads given
+  by OpenMP.
+
+  \note This function will set the new parameter for all the cameras.
+*/
+void vpMbGenericTracker::setDepthNormalNbThreads(int nbThreads)
+{
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+    it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->setDepthNormalNbThreads(nbThreads);
+  }
+}
+
 /*!
   Set depth PCL plane estimation method.
 
@@ -5968,7 +6297,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
 
 /** TrackerWrapper **/
 vpMbGenericTracker::TrackerWrapper::TrackerWrapper()
-  : m_error(), m_L(), m_trackerType(EDGE_TRACKER), m_w(), m_weightedError()
+  : m_error(), m_L(), m_trackerType(EDGE_TRACKER), m_w(), m_weightedError(), m_useNormalEquations(false)
 {
   m_lambda = 1.0;
   m_maxIter = 30;
@@ -5981,7 +6310,7 @@ vpMbGenericTracker::TrackerWrapper::TrackerWrapper()
 }
 
 vpMbGenericTracker::TrackerWrapper::TrackerWrapper(int trackerType)
-  : m_error(), m_L(), m_trackerType(trackerType), m_w(), m_weightedError()
+  : m_error(), m_L(), m_trackerType(trackerType), m_w(), m_weightedError(), m_useNormalEquations(false)
 {
   if ((m_trackerType & (EDGE_TRACKER |
 #if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
@@ -6004,6 +6333,7 @@ vpMbGenericTracker::TrackerWrapper::TrackerWrapper(int trackerType)
 // Implemented only for debugging purposes: use TrackerWrapper as a standalone tracker
 void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char> *const ptr_I)
 {
+  m_useNormalEquations = false;
   computeVVSInit(ptr_I);
 
   if (m_error.getRows() < 4) {
@@ -6249,8 +6579,16 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSInit(const vpImage<unsigned c
     m_w_depthNormal.clear();
   }
 
+  // When the normal equations are accumulated, the interaction matrix of the dense depth features is not built
+  unsigned int nbFeaturesL = nbFeatures;
   if (m_trackerType & DEPTH_DENSE_TRACKER) {
-    vpMbDepthDenseTracker::computeVVSInit();
+    if (m_useNormalEquations) {
+      vpMbDepthDenseTracker::computeVVSInitResidu();
+    }
+    else {
+      vpMbDepthDenseTracker::computeVVSInit();
+      nbFeaturesL += m_error_depthDense.getRows();
+    }
     nbFeatures += m_error_depthDense.getRows();
   }
   else {
@@ -6260,11 +6598,11 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSInit(const vpImage<unsigned c
     m_w_depthDense.clear();
   }
 
-  m_L.resize(nbFeatures, 6, false, false);
-  m_error.resize(nbFeatures, false);
+  m_vvsWorkspace.resize(m_L, nbFeaturesL, 6);
+  m_vvsWorkspace.resize(m_error, nbFeatures);
 
-  m_weightedError.resize(nbFeatures, false);
-  m_w.resize(nbFeatures, false);
+  m_vvsWorkspace.resize(m_weightedError, nbFeatures);
+  m_vvsWorkspace.resize(m_w, nbFeatures);
   m_w = 1;
 }
 
@@ -6293,7 +6631,12 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSInteractionMatrixAndResidu(co
   }
 
   if (m_trackerType & DEPTH_DENSE_TRACKER) {
-    vpMbDepthDenseTracker::computeVVSInteractionMatrixAndResidu();
+    if (m_useNormalEquations) {
+      vpMbDepthDenseTracker::computeVVSResidu();
+    }
+    else {
+      vpMbDepthDenseTracker::computeVVSInteractionMatrixAndResidu();
+    }
   }
 
   unsigned int start_index = 0;
@@ -6321,7 +6664,9 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSInteractionMatrixAndResidu(co
   }
 
   if (m_trackerType & DEPTH_DENSE_TRACKER) {
-    m_L.insert(m_L_depthDense, start_index, 0);
+    if (!m_useNormalEquations) {
+      m_L.insert(m_L_depthDense, start_index, 0);
+    }
     m_error.insert(start_index, m_error_depthDense);
 
     //    start_index += m_error_depthDense.getRows();
@@ -46,6 +46,10 @@
 #include <visp3/core/vpMeterPixelConversion.h>
 #include <visp3/mbt/vpMbScanLine.h>
 
+#if defined(VISP_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
 #if (defined(VISP_HAVE_X11) || defined(VISP_HAVE_GDI)) && defined(DEBUG_DISP)
 #include <visp3/gui/vpDisplayGDI.h>
 #include <visp3/gui/vpDisplayX.h>
@@ -54,7 +58,7 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 BEGIN_VISP_NAMESPACE
 vpMbScanLine::vpMbScanLine()
-  : w(0), h(0), K(), maskBorder(0), mask(), primitive_ids(), visibility_samples(), depthTreshold(1e-06)
+  : w(0), h(0), K(), maskBorder(0), mask(), primitive_ids(), visibility_samples(), depthTreshold(1e-06), m_nbThreads(-1)
 #if (defined(VISP_HAVE_X11) || defined(VISP_HAVE_GDI)) && defined(DEBUG_DISP)
   ,
   dispMaskDebug(nullptr), dispLineDebug(nullptr), linedebugImg()
@@ -95,6 +99,7 @@ vpMbScanLine &vpMbScanLine::operator=(const vpMbScanLine &scanline)
   primitive_ids = scanline.primitive_ids;
   visibility_samples = scanline.visibility_samples;
   depthTreshold = scanline.depthTreshold;
+  m_nbThreads = scanline.m_nbThreads;
 
 #if (defined(VISP_HAVE_X11) || defined(VISP_HAVE_GDI)) && defined(DEBUG_DISP)
   dispLineDebug = scanline.dispLineDebug;
@@ -104,192 +109,151 @@ vpMbScanLine &vpMbScanLine::operator=(const vpMbScanLine &scanline)
   return *this;
 }
 
+
 /*!
-  Compute the intersections between Y-axis scanlines and a given line (two
-  points polygon).
+  Set the number of stripes of scanlines rendered in parallel by drawScene().
+  The result of the rendering does not depend on the number of threads.
 
-  \param a : First point of the line.
-  \param b : Second point of the line.
-  \param edge : Pair with the two points of the line.
-  \param ID : Id of the given line (has to be know when using queries).
-  \param scanlines : Resulting intersections.
+  \param nbThreads : Number of threads. A value lower or equal to 0 uses the
+  number of threads given by OpenMP. Without OpenMP the rendering is
+  sequential.
 */
-void vpMbScanLine::drawLineY(const vpColVector &a, const vpColVector &b, const vpMbScanLineEdge &edge, const int ID,
-                             std::vector<std::vector<vpMbScanLineSegment> > &scanlines)
-{
-  double x0 = a[0] / a[2];
-  double y0 = a[1] / a[2];
-  double z0 = a[2];
-  double x1 = b[0] / b[2];
-  double y1 = b[1] / b[2];
-  double z1 = b[2];
-  if (y0 > y1) {
-    std::swap(x0, x1);
-    std::swap(y0, y1);
-    std::swap(z0, z1);
-  }
-
-  // if (y0 >= h - 1 || y1 < 0 || y1 == y0)
-  if (y0 >= h - 1 || y1 < 0 || std::fabs(y1 - y0) <= std::numeric_limits<double>::epsilon())
-    return;
-
-  const unsigned int _y0 = std::max<unsigned int>(static_cast<unsigned int>(0), static_cast<unsigned int>(std::ceil(y0)));
-  const double _y1 = std::min<double>(static_cast<double>(h), static_cast<double>(y1));
-
-  const bool b_sample_Y = (std::fabs(y0 - y1) > std::fabs(x0 - x1));
-
-  for (unsigned int y = _y0; y < _y1; ++y) {
-    double x = x0 + (x1 - x0) * (y - y0) / (y1 - y0);
-    const double alpha = getAlpha(y, y0 * z0, z0, y1 * z1, z1);
-    vpMbScanLineSegment s;
-    s.p = x;
-    s.type = POINT;
-    s.Z2 = s.Z1 = mix(z0, z1, alpha);
-    s.P2 = s.P1 = s.p * s.Z1;
-    s.ID = ID;
-    s.edge = edge;
-    s.b_sample_Y = b_sample_Y;
-    scanlines[y].push_back(s);
-  }
-}
+void vpMbScanLine::setNbThreads(int nbThreads) { m_nbThreads = nbThreads; }
 
 /*!
-  Compute the intersections between X-axis scanlines and a given line (two
-  points polygon).
-
-  \param a : First point of the line.
-  \param b : Second point of the line.
-  \param edge : Pair with the two points of the line.
+  Compute the intersections between the scanlines of an axis and a given line
+  (two points polygon).
+
+  \param axis : 0 for Y-axis scanlines (one per image row), 1 for X-axis
+  scanlines (one per image column).
+  \param a : First point of the line, as returned by createVectorFromPoint().
+  \param b : Second point of the line, as returned by createVectorFromPoint().
+  \param edge : Index of the edge of the line.
   \param ID : Id of the given line (has to be know when using queries).
+  \param first : First scanline to compute.
+  \param last : Scanline after the last one to compute.
   \param scanlines : Resulting intersections.
 */
-void vpMbScanLine::drawLineX(const vpColVector &a, const vpColVector &b, const vpMbScanLineEdge &edge, const int ID,
-                             std::vector<std::vector<vpMbScanLineSegment> > &scanlines)
+void vpMbScanLine::drawLine(unsigned int axis, const double *a, const double *b, unsigned int edge, const int ID,
+                            unsigned int first, unsigned int last,
+                            std::vector<std::vector<vpMbScanLineSegment> > &scanlines)
 {
-  double x0 = a[0] / a[2];
-  double y0 = a[1] / a[2];
+  // Coordinate along which the scanlines are taken (u) and sampled coordinate (v)
+  const unsigned int u = (axis == 0) ? 1 : 0;
+  const unsigned int v = 1 - u;
+  const unsigned int size = (axis == 0) ? h : w;
+  double u0 = a[u] / a[2];
+  double v0 = a[v] / a[2];
   double z0 = a[2];
-  double x1 = b[0] / b[2];
-  double y1 = b[1] / b[2];
+  double u1 = b[u] / b[2];
+  double v1 = b[v] / b[2];
   double z1 = b[2];
-  if (x0 > x1) {
-    std::swap(x0, x1);
-    std::swap(y0, y1);
+  if (u0 > u1) {
+    std::swap(u0, u1);
+    std::swap(v0, v1);
     std::swap(z0, z1);
   }
 
-  // if (x0 >= w - 1 || x1 < 0 || x1 == x0)
-  if (x0 >= w - 1 || x1 < 0 || std::fabs(x1 - x0) <= std::numeric_limits<double>::epsilon())
+  // if (u0 >= size - 1 || u1 < 0 || u1 == u0)
+  if (u0 >= size - 1 || u1 < 0 || std::fabs(u1 - u0) <= std::numeric_limits<double>::epsilon())
     return;
 
-  const unsigned int _x0 = std::max<unsigned int>(static_cast<unsigned int>(0), static_cast<unsigned int>(std::ceil(x0)));
-  const double _x1 = std::min<double>(static_cast<double>(w), static_cast<double>(x1));
+  const unsigned int _u0 = std::max<unsigned int>(first, (u0 > 0) ? static_cast<unsigned int>(std::ceil(u0)) : 0);
+  const double _u1 = std::min<double>(static_cast<double>(last), u1);
 
-  const bool b_sample_Y = (std::fabs(y0 - y1) > std::fabs(x0 - x1));
+  const bool b_sample_Y = (std::fabs(a[1] / a[2] - b[1] / b[2]) > std::fabs(a[0] / a[2] - b[0] / b[2]));
 
-  for (unsigned int x = _x0; x < _x1; ++x) {
-    double y = y0 + (y1 - y0) * (x - x0) / (x1 - x0);
-    const double alpha = getAlpha(x, x0 * z0, z0, x1 * z1, z1);
+  for (unsigned int y = _u0; y < _u1; ++y) {
+    double x = v0 + (v1 - v0) * (y - u0) / (u1 - u0);
+    const double alpha = getAlpha(y, u0 * z0, z0, u1 * z1, z1);
     vpMbScanLineSegment s;
-    s.p = y;
+    s.p = x;
     s.type = POINT;
     s.Z2 = s.Z1 = mix(z0, z1, alpha);
     s.P2 = s.P1 = s.p * s.Z1;
     s.ID = ID;
     s.edge = edge;
     s.b_sample_Y = b_sample_Y;
-    scanlines[x].push_back(s);
+    scanlines[y].push_back(s);
   }
 }
 
 /*!
-  Compute the Y-axis scanlines intersections of a polygon.
+  Compute the scanlines intersections of a polygon.
 
-  \param polygon : Polygon composed by an array of lines.
+  \param axis : 0 for Y-axis scanlines (one per image row), 1 for X-axis
+  scanlines (one per image column).
+  \param points : Points of the polygon, as returned by
+  createVectorFromPoint() and stored contiguously.
+  \param edges : Index of the edges of the polygon.
   \param ID : ID of the polygon (has to be know when using queries).
+  \param first : First scanline to compute.
+  \param last : Scanline after the last one to compute.
   \param scanlines : Resulting intersections.
+  \param localScanlines : Buffer of the intersections of the polygon, with
+  empty scanlines.
 */
-void vpMbScanLine::drawPolygonY(const std::vector<std::pair<vpPoint, unsigned int> > &polygon, const int ID,
-                                std::vector<std::vector<vpMbScanLineSegment> > &scanlines)
+void vpMbScanLine::drawPolygon(unsigned int axis, const std::vector<double> &points,
+                               const std::vector<unsigned int> &edges, const int ID, unsigned int first,
+                               unsigned int last, std::vector<std::vector<vpMbScanLineSegment> > &scanlines,
+                               std::vector<std::vector<vpMbScanLineSegment> > &localScanlines)
 {
-  if (polygon.size() < 2)
+  const size_t nbPoints = points.size() / 3;
+  if (nbPoints < 2)
     return;
 
-  if (polygon.size() == 2) {
-    vpColVector p1, p2;
-    createVectorFromPoint(polygon.front().first, p1, K);
-    createVectorFromPoint(polygon.back().first, p2, K);
-
-    drawLineY(p1, p2, makeMbScanLineEdge(polygon.front().first, polygon.back().first), ID, scanlines);
+  if (nbPoints == 2) {
+    drawLine(axis, &points[0], &points[3], edges[0], ID, first, last, scanlines);
     return;
   }
 
-  std::vector<std::vector<vpMbScanLineSegment> > local_scanlines;
-  local_scanlines.resize(h);
-
-  for (size_t i = 0; i < polygon.size(); ++i) {
-    vpColVector p1, p2;
-    createVectorFromPoint(polygon[i].first, p1, K);
-    createVectorFromPoint(polygon[(i + 1) % polygon.size()].first, p2, K);
-
-    drawLineY(p1, p2, makeMbScanLineEdge(polygon[i].first, polygon[(i + 1) % polygon.size()].first), ID,
-              local_scanlines);
+  // Only the scanlines spanned by the polygon are computed
+  const unsigned int u = (axis == 0) ? 1 : 0;
+  const unsigned int size = (axis == 0) ? h : w;
+  double umin = points[u] / points[2];
+  double umax = umin;
+  for (size_t i = 1; i < nbPoints; ++i) {
+    const double ui = points[(3 * i) + u] / points[(3 * i) + 2];
+    umin = std::min<double>(umin, ui);
+    umax = std::max<double>(umax, ui);
   }
-
-  createScanLinesFromLocals(scanlines, local_scanlines, h);
-}
-
-/*!
-  Compute the X-axis scanlines intersections of a polygon.
-
-  \param polygon : Polygon composed by an array of lines.
-  \param ID : ID of the polygon (has to be know when using queries).
-  \param scanlines : Resulting intersections.
-*/
-void vpMbScanLine::drawPolygonX(const std::vector<std::pair<vpPoint, unsigned int> > &polygon, const int ID,
-                                std::vector<std::vector<vpMbScanLineSegment> > &scanlines)
-{
-  if (polygon.size() < 2)
-    return;
-
-  if (polygon.size() == 2) {
-    vpColVector p1, p2;
-    createVectorFromPoint(polygon.front().first, p1, K);
-    createVectorFromPoint(polygon.back().first, p2, K);
-
-    drawLineX(p1, p2, makeMbScanLineEdge(polygon.front().first, polygon.back().first), ID, scanlines);
-    return;
+  unsigned int polygonFirst = first, polygonLast = last;
+  if (vpMath::isFinite(umin) && vpMath::isFinite(umax)) {
+    if (umax < 0) {
+      return;
+    }
+    if (umin > 0) {
+      polygonFirst = std::max<unsigned int>(first, static_cast<unsigned int>(std::min<double>(std::ceil(umin), size)));
+    }
+    polygonLast = std::min<unsigned int>(last, static_cast<unsigned int>(std::min<double>(umax + 1, size)));
   }
+  if (polygonFirst >= polygonLast)
+    return;
 
-  std::vector<std::vector<vpMbScanLineSegment> > local_scanlines;
-  local_scanlines.resize(w);
-
-  for (size_t i = 0; i < polygon.size(); ++i) {
-    vpColVector p1, p2;
-    createVectorFromPoint(polygon[i].first, p1, K);
-    createVectorFromPoint(polygon[(i + 1) % polygon.size()].first, p2, K);
-
-    drawLineX(p1, p2, makeMbScanLineEdge(polygon[i].first, polygon[(i + 1) % polygon.size()].first), ID,
-              local_scanlines);
+  for (size_t i = 0; i < nbPoints; ++i) {
+    drawLine(axis, &points[3 * i], &points[3 * ((i + 1) % nbPoints)], edges[i], ID, polygonFirst, polygonLast,
+             localScanlines);
   }
 
-  createScanLinesFromLocals(scanlines, local_scanlines, w);
+  createScanLinesFromLocals(scanlines, localScanlines, polygonFirst, polygonLast);
 }
 
 /*!
   Organise local scanlines in a global scanline vector.
   It also marks the computed intersections as starting or ending points.
-  This function will only be called by the drawPolygons functions.
+  This function will only be called by drawPolygon(). The local scanlines
+  are emptied.
 
   \param scanlines : Global scanline vector.
   \param localScanlines : Local scanline vector (X or Y-axis).
-  \param size : Corresponding size (typically the width or the height).
+  \param first : First scanline to organise.
+  \param last : Scanline after the last one to organise.
 */
 void vpMbScanLine::createScanLinesFromLocals(std::vector<std::vector<vpMbScanLineSegment> > &scanlines,
                                              std::vector<std::vector<vpMbScanLineSegment> > &localScanlines,
-                                             const unsigned int &size)
+                                             unsigned int first, unsigned int last)
 {
-  for (unsigned int j = 0; j < size; ++j) {
+  for (unsigned int j = first; j < last; ++j) {
     std::vector<vpMbScanLineSegment> &scanline = localScanlines[j];
     sort(scanline.begin(), scanline.end(),
          vpMbScanLineSegmentComparator()); // Not sure its necessary
@@ -314,6 +278,7 @@ void vpMbScanLine::createScanLinesFromLocals(std::vector<std::vector<vpMbScanLin
       }
       scanlines[j].push_back(s);
     }
+    scanline.clear();
   }
 }
 
@@ -321,6 +286,9 @@ void vpMbScanLine::createScanLinesFromLocals(std::vector<std::vector<vpMbScanLin
   Render a scene of polygons and compute scanlines intersections in order to
   use queries.
 
+  The scanlines are split in stripes that are rendered in parallel, see
+  setNbThreads(). Each polygon only contributes to the scanlines it spans.
+
   \param polygons : List of polygons composed by arrays of lines.
   \param listPolyIndices : List of polygons IDs (has to be know when using
   queries). \param cam : Camera parameters. \param width : Width of the image
@@ -336,6 +304,31 @@ void vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, un
 
   visibility_samples.clear();
 
+  // Projected points of the polygons and index of their edges. The edges are
+  // referenced by index in the scanlines to avoid copying them for each sample
+  std::vector<std::vector<double> > polygonPoints(polygons.size());
+  std::vector<std::vector<unsigned int> > polygonEdges(polygons.size());
+  std::vector<vpMbScanLineEdge> edges;
+  for (size_t ID = 0; ID < polygons.size(); ++ID) {
+    const std::vector<std::pair<vpPoint, unsigned int> > &polygon = *(polygons[ID]);
+    if (polygon.size() < 2)
+      continue;
+
+    polygonPoints[ID].resize(3 * polygon.size());
+    for (size_t i = 0; i < polygon.size(); ++i) {
+      const vpPoint &P = polygon[i].first;
+      polygonPoints[ID][3 * i] = P.get_X() * K.get_px() + K.get_u0() * P.get_Z();
+      polygonPoints[ID][(3 * i) + 1] = P.get_Y() * K.get_py() + K.get_v0() * P.get_Z();
+      polygonPoints[ID][(3 * i) + 2] = P.get_Z();
+    }
+
+    const size_t nbEdges = (polygon.size() == 2) ? 1 : polygon.size();
+    for (size_t i = 0; i < nbEdges; ++i) {
+      polygonEdges[ID].push_back(static_cast<unsigned int>(edges.size()));
+      edges.push_back(makeMbScanLineEdge(polygon[i].first, polygon[(i + 1) % polygon.size()].first));
+    }
+  }
+
   std::vector<std::vector<vpMbScanLineSegment> > scanlinesY;
   scanlinesY.resize(h);
   std::vector<std::vector<vpMbScanLineSegment> > scanlinesX;
@@ -348,159 +341,209 @@ void vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, un
 
   primitive_ids.resize(h, w, -1);
 
-  for (unsigned int ID = 0; ID < polygons.size(); ++ID) {
-    drawPolygonY(*(polygons[ID]), listPolyIndices[ID], scanlinesY);
-    drawPolygonX(*(polygons[ID]), listPolyIndices[ID], scanlinesX);
-  }
+  int nbThreads = 1;
+#if defined(VISP_HAVE_OPENMP)
+  nbThreads = (m_nbThreads > 0) ? m_nbThreads : omp_get_max_threads();
+#endif
+  const unsigned int nbStripesY = std::max<unsigned int>(std::min<unsigned int>(static_cast<unsigned int>(nbThreads), h), 1);
+  const unsigned int nbStripesX = std::max<unsigned int>(std::min<unsigned int>(static_cast<unsigned int>(nbThreads), w), 1);
+  // Visibility samples of each stripe, as (edge, scanline) pairs
+  std::vector<std::vector<std::pair<unsigned int, int> > > samples(nbStripesY + nbStripesX);
 
   // Y
-  int last_ID = -1;
-  vpMbScanLineSegment last_visible;
-  for (unsigned int y = 0; y < scanlinesY.size(); ++y) {
-    std::vector<vpMbScanLineSegment> &scanline = scanlinesY[y];
-    sort(scanline.begin(), scanline.end(), vpMbScanLineSegmentComparator());
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for num_threads(static_cast<int>(nbStripesY)) schedule(static, 1) if (nbStripesY > 1)
+#endif
+  for (int stripe = 0; stripe < static_cast<int>(nbStripesY); ++stripe) {
+    const unsigned int s = static_cast<unsigned int>(stripe);
+    const unsigned int first = (s * (h / nbStripesY)) + std::min<unsigned int>(s, h % nbStripesY);
+    const unsigned int last = first + (h / nbStripesY) + ((s < (h % nbStripesY)) ? 1 : 0);
+    std::vector<std::pair<unsigned int, int> > &stripeSamples = samples[s];
+
+    std::vector<std::vector<vpMbScanLineSegment> > localScanlines(h);
+    for (size_t ID = 0; ID < polygons.size(); ++ID) {
+      drawPolygon(0, polygonPoints[ID], polygonEdges[ID], listPolyIndices[ID], first, last, scanlinesY,
+                  localScanlines);
+    }
 
-    std::vector<std::pair<double, vpMbScanLineSegment> > stack;
-    for (size_t i = 0; i < scanline.size(); ++i) {
-      const vpMbScanLineSegment &s = scanline[i];
-
-      switch (s.type) {
-      case START:
-        stack.push_back(std::make_pair(s.Z1, s));
-        break;
-      case END:
-        for (size_t j = 0; j < stack.size(); ++j)
-          if (stack[j].second.ID == s.ID) {
-            if (j != stack.size() - 1)
-              stack[j] = stack.back();
-            stack.pop_back();
-            break;
-          }
-        break;
-      case POINT:
-        break;
-      }
+    for (unsigned int y = first; y < last; ++y) {
+      std::vector<vpMbScanLineSegment> &scanline = scanlinesY[y];
+      sort(scanline.begin(), scanline.end(), vpMbScanLineSegmentComparator());
+
+      int last_ID = -1;
+      vpMbScanLineSegment last_visible;
+      std::vector<std::pair<double, vpMbScanLineSegment> > stack;
+      for (size_t i = 0; i < scanline.size(); ++i) {
+        const vpMbScanLineSegment &s = scanline[i];
+
+        switch (s.type) {
+        case START:
+          stack.push_back(std::make_pair(s.Z1, s));
+          break;
+        case END:
+          for (size_t j = 0; j < stack.size(); ++j)
+            if (stack[j].second.ID == s.ID) {
+              if (j != stack.size() - 1)
+                stack[j] = stack.back();
+              stack.pop_back();
+              break;
+            }
+          break;
+        case POINT:
+          break;
+        }
 
-      for (size_t j = 0; j < stack.size(); ++j) {
-        const vpMbScanLineSegment &s0 = stack[j].second;
-        stack[j].first = mix(s0.Z1, s0.Z2, getAlpha(s.type == POINT ? s.p : (s.p + 0.5), s0.P1, s0.Z1, s0.P2, s0.Z2));
-      }
-      sort(stack.begin(), stack.end(), vpMbScanLineSegmentComparator());
-
-      int new_ID = stack.empty() ? -1 : stack.front().second.ID;
-
-      if (new_ID != last_ID || s.type == POINT) {
-        if (s.b_sample_Y)
-          switch (s.type) {
-          case POINT:
-            if (new_ID == -1 || s.Z1 - depthTreshold <= stack.front().first)
-              visibility_samples[s.edge].insert(static_cast<int>(y));
-            break;
-          case START:
-            if (new_ID == s.ID)
-              visibility_samples[s.edge].insert(static_cast<int>(y));
-            break;
-          case END:
-            if (last_ID == s.ID)
-              visibility_samples[s.edge].insert(static_cast<int>(y));
-            break;
+        for (size_t j = 0; j < stack.size(); ++j) {
+          const vpMbScanLineSegment &s0 = stack[j].second;
+          stack[j].first = mix(s0.Z1, s0.Z2, getAlpha(s.type == POINT ? s.p : (s.p + 0.5), s0.P1, s0.Z1, s0.P2, s0.Z2));
+        }
+        sort(stack.begin(), stack.end(), vpMbScanLineSegmentComparator());
+
+        int new_ID = stack.empty() ? -1 : stack.front().second.ID;
+
+        if (new_ID != last_ID || s.type == POINT) {
+          if (s.b_sample_Y)
+            switch (s.type) {
+            case POINT:
+              if (new_ID == -1 || s.Z1 - depthTreshold <= stack.front().first)
+                stripeSamples.push_back(std::make_pair(s.edge, static_cast<int>(y)));
+              break;
+            case START:
+              if (new_ID == s.ID)
+                stripeSamples.push_back(std::make_pair(s.edge, static_cast<int>(y)));
+              break;
+            case END:
+              if (last_ID == s.ID)
+                stripeSamples.push_back(std::make_pair(s.edge, static_cast<int>(y)));
+              break;
+            }
+
+          // This part will only be used for MbKltTracking
+          if (last_ID != -1) {
+            const unsigned int x0 = (last_visible.p > 0) ? static_cast<unsigned int>(std::ceil(last_visible.p)) : 0;
+            double x1 = std::min<double>(static_cast<double>(w), static_cast<double>(s.p));
+            for (unsigned int x = x0 + maskBorder; x < x1 - maskBorder; ++x) {
+              primitive_ids[static_cast<unsigned int>(y)][static_cast<unsigned int>(x)] = last_visible.ID;
+
+              if (maskBorder != 0)
+                maskY[static_cast<unsigned int>(y)][static_cast<unsigned int>(x)] = 255;
+              else
+                mask[static_cast<unsigned int>(y)][static_cast<unsigned int>(x)] = 255;
+            }
           }
 
-        // This part will only be used for MbKltTracking
-        if (last_ID != -1) {
-          const unsigned int x0 = std::max<unsigned int>(static_cast<unsigned int>(0), static_cast<unsigned int>(std::ceil(last_visible.p)));
-          double x1 = std::min<double>(static_cast<double>(w), static_cast<double>(s.p));
-          for (unsigned int x = x0 + maskBorder; x < x1 - maskBorder; ++x) {
-            primitive_ids[static_cast<unsigned int>(y)][static_cast<unsigned int>(x)] = last_visible.ID;
-
-            if (maskBorder != 0)
-              maskY[static_cast<unsigned int>(y)][static_cast<unsigned int>(x)] = 255;
-            else
-              mask[static_cast<unsigned int>(y)][static_cast<unsigned int>(x)] = 255;
+          last_ID = new_ID;
+          if (!stack.empty()) {
+            last_visible = stack.front().second;
+            last_visible.p = s.p;
           }
         }
-
-        last_ID = new_ID;
-        if (!stack.empty()) {
-          last_visible = stack.front().second;
-          last_visible.p = s.p;
-        }
       }
     }
   }
 
   // X
-  last_ID = -1;
-  for (unsigned int x = 0; x < scanlinesX.size(); ++x) {
-    std::vector<vpMbScanLineSegment> &scanline = scanlinesX[x];
-    sort(scanline.begin(), scanline.end(), vpMbScanLineSegmentComparator());
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for num_threads(static_cast<int>(nbStripesX)) schedule(static, 1) if (nbStripesX > 1)
+#endif
+  for (int stripe = 0; stripe < static_cast<int>(nbStripesX); ++stripe) {
+    const unsigned int s = static_cast<unsigned int>(stripe);
+    const unsigned int first = (s * (w / nbStripesX)) + std::min<unsigned int>(s, w % nbStripesX);
+    const unsigned int last = first + (w / nbStripesX) + ((s < (w % nbStripesX)) ? 1 : 0);
+    std::vector<std::pair<unsigned int, int> > &stripeSamples = samples[nbStripesY + s];
+
+    std::vector<std::vector<vpMbScanLineSegment> > localScanlines(w);
+    for (size_t ID = 0; ID < polygons.size(); ++ID) {
+      drawPolygon(1, polygonPoints[ID], polygonEdges[ID], listPolyIndices[ID], first, last, scanlinesX,
+                  localScanlines);
+    }
 
-    std::vector<std::pair<double, vpMbScanLineSegment> > stack;
-    for (size_t i = 0; i < scanline.size(); ++i) {
-      const vpMbScanLineSegment &s = scanline[i];
-
-      switch (s.type) {
-      case START:
-        stack.push_back(std::make_pair(s.Z1, s));
-        break;
-      case END:
-        for (size_t j = 0; j < stack.size(); ++j)
-          if (stack[j].second.ID == s.ID) {
-            if (j != stack.size() - 1)
-              stack[j] = stack.back();
-            stack.pop_back();
-            break;
-          }
-        break;
-      case POINT:
-        break;
-      }
+    for (unsigned int x = first; x < last; ++x) {
+      std::vector<vpMbScanLineSegment> &scanline = scanlinesX[x];
+      sort(scanline.begin(), scanline.end(), vpMbScanLineSegmentComparator());
+
+      int last_ID = -1;
+      vpMbScanLineSegment last_visible;
+      std::vector<std::pair<double, vpMbScanLineSegment> > stack;
+      for (size_t i = 0; i < scanline.size(); ++i) {
+        const vpMbScanLineSegment &s = scanline[i];
+
+        switch (s.type) {
+        case START:
+          stack.push_back(std::make_pair(s.Z1, s));
+          break;
+        case END:
+          for (size_t j = 0; j < stack.size(); ++j)
+            if (stack[j].second.ID == s.ID) {
+              if (j != stack.size() - 1)
+                stack[j] = stack.back();
+              stack.pop_back();
+              break;
+            }
+          break;
+        case POINT:
+          break;
+        }
 
-      for (size_t j = 0; j < stack.size(); ++j) {
-        const vpMbScanLineSegment &s0 = stack[j].second;
-        stack[j].first = mix(s0.Z1, s0.Z2, getAlpha(s.type == POINT ? s.p : (s.p + 0.5), s0.P1, s0.Z1, s0.P2, s0.Z2));
-      }
-      sort(stack.begin(), stack.end(), vpMbScanLineSegmentComparator());
-
-      int new_ID = stack.empty() ? -1 : stack.front().second.ID;
-
-      if (new_ID != last_ID || s.type == POINT) {
-        if (!s.b_sample_Y)
-          switch (s.type) {
-          case POINT:
-            if (new_ID == -1 || s.Z1 - depthTreshold <= stack.front().first)
-              visibility_samples[s.edge].insert(static_cast<int>(x));
-            break;
-          case START:
-            if (new_ID == s.ID)
-              visibility_samples[s.edge].insert(static_cast<int>(x));
-            break;
-          case END:
-            if (last_ID == s.ID)
-              visibility_samples[s.edge].insert(static_cast<int>(x));
-            break;
+        for (size_t j = 0; j < stack.size(); ++j) {
+          const vpMbScanLineSegment &s0 = stack[j].second;
+          stack[j].first = mix(s0.Z1, s0.Z2, getAlpha(s.type == POINT ? s.p : (s.p + 0.5), s0.P1, s0.Z1, s0.P2, s0.Z2));
+        }
+        sort(stack.begin(), stack.end(), vpMbScanLineSegmentComparator());
+
+        int new_ID = stack.empty() ? -1 : stack.front().second.ID;
+
+        if (new_ID != last_ID || s.type == POINT) {
+          if (!s.b_sample_Y)
+            switch (s.type) {
+            case POINT:
+              if (new_ID == -1 || s.Z1 - depthTreshold <= stack.front().first)
+                stripeSamples.push_back(std::make_pair(s.edge, static_cast<int>(x)));
+              break;
+            case START:
+              if (new_ID == s.ID)
+                stripeSamples.push_back(std::make_pair(s.edge, static_cast<int>(x)));
+              break;
+            case END:
+              if (last_ID == s.ID)
+                stripeSamples.push_back(std::make_pair(s.edge, static_cast<int>(x)));
+              break;
+            }
+
+          // This part will only be used for MbKltTracking
+          if (maskBorder != 0 && last_ID != -1) {
+            const unsigned int y0 = (last_visible.p > 0) ? static_cast<unsigned int>(std::ceil(last_visible.p)) : 0;
+            double y1 = std::min<double>(static_cast<double>(h), static_cast<double>(s.p));
+            for (unsigned int y = y0 + maskBorder; y < y1 - maskBorder; ++y) {
+              // primitive_ids[static_cast<unsigned int>(y)][static_cast<unsigned int>(x)] =
+              // last_visible.ID;
+              maskX[static_cast<unsigned int>(y)][static_cast<unsigned int>(x)] = 255;
+            }
           }
 
-        // This part will only be used for MbKltTracking
-        if (maskBorder != 0 && last_ID != -1) {
-          const unsigned int y0 = std::max<unsigned int>(static_cast<unsigned int>(0), static_cast<unsigned int>(std::ceil(last_visible.p)));
-          double y1 = std::min<double>(static_cast<double>(h), static_cast<double>(s.p));
-          for (unsigned int y = y0 + maskBorder; y < y1 - maskBorder; ++y) {
-            // primitive_ids[static_cast<unsigned int>(y)][static_cast<unsigned int>(x)] =
-            // last_visible.ID;
-            maskX[static_cast<unsigned int>(y)][static_cast<unsigned int>(x)] = 255;
+          last_ID = new_ID;
+          if (!stack.empty()) {
+            last_visible = stack.front().second;
+            last_visible.p = s.p;
           }
         }
-
-        last_ID = new_ID;
-        if (!stack.empty()) {
-          last_visible = stack.front().second;
-          last_visible.p = s.p;
-        }
       }
     }
   }
 
+  // Gather the visibility samples of the stripes, edge by edge
+  std::vector<std::vector<int> > edgeSamples(edges.size());
+  for (size_t s = 0; s < samples.size(); ++s) {
+    for (size_t i = 0; i < samples[s].size(); ++i) {
+      edgeSamples[samples[s][i].first].push_back(samples[s][i].second);
+    }
+  }
+  for (size_t e = 0; e < edges.size(); ++e) {
+    if (!edgeSamples[e].empty()) {
+      visibility_samples[edges[e]].insert(edgeSamples[e].begin(), edgeSamples[e].end());
+    }
+  }
+
   if (maskBorder != 0)
     for (unsigned int i = 0; i < h; i++)
       for (unsigned int j = 0; j < w; j++)
@@ -578,7 +621,10 @@ void vpMbScanLine::queryLineVisibility(const vpPoint &a, const vpPoint &b,
 #endif
   }
 
-  if (!visibility_samples.count(edge))
+  // Only const lookups here, the query can be run concurrently for several faces
+  std::map<vpMbScanLineEdge, std::set<int>, vpMbScanLineEdgeComparator>::const_iterator it_samples =
+    visibility_samples.find(edge);
+  if (it_samples == visibility_samples.end())
     return;
 
   // Initialized as the biggest difference between the two points is on the
@@ -620,7 +666,7 @@ void vpMbScanLine::queryLineVisibility(const vpPoint &a, const vpPoint &b,
   const int _v0 = std::max<int>(0, int(std::ceil(*v0)));
   const int _v1 = std::min<int>(static_cast<int>(size - 1), static_cast<int>(std::ceil(*v1) - 1));
 
-  const std::set<int> &visible_samples = visibility_samples[edge];
+  const std::set<int> &visible_samples = it_samples->second;
   int last = _v0;
   vpPoint line_start;
   vpPoint line_end;
@@ -37,6 +37,7 @@
 */
 
 #include <algorithm>
+#include <iomanip>
 #include <iostream>
 #include <limits>
 #include <sstream>
@@ -106,10 +107,13 @@ std::mutex g_mutex_cout;
  */
 struct SegmentInfo
 {
-  SegmentInfo() : extremities(), name(), useLod(false), minLineLengthThresh(0.) {}
+  SegmentInfo() : extremities(), name(), parameters(vpMbtCompiledModel::NO_PARAMETER), useLod(false),
+    minLineLengthThresh(0.)
+  { }
 
-  std::vector<vpPoint> extremities;
+  std::vector<unsigned int> extremities;
   std::string name;
+  unsigned int parameters;
   bool useLod;
   double minLineLengthThresh;
 };
@@ -190,11 +194,12 @@ vpMbTracker::vpMbTracker()
   nbPolygonPoints(0), nbCylinders(0), nbCircles(0), useLodGeneral(false), applyLodSettingInConfig(false),
   minLineLengthThresholdGeneral(50.0), minPolygonAreaThresholdGeneral(2500.0), mapOfParameterNames(),
   m_computeInteraction(true), m_lambda(1.0), m_maxIter(30), m_stopCriteriaEpsilon(1e-8), m_initialMu(0.01),
-  m_projectionErrorLines(), m_projectionErrorCylinders(), m_projectionErrorCircles(), m_projectionErrorFaces(),
+  m_projectionErrorLines(), m_projectionErrorLinesIndex(), m_projectionErrorCylinders(), m_projectionErrorCircles(), m_projectionErrorFaces(),
   m_projectionErrorOgreShowConfigDialog(false), m_projectionErrorMe(), m_projectionErrorKernelSize(2), m_SobelX(5, 5),
   m_SobelY(5, 5), m_projectionErrorDisplay(false), m_projectionErrorDisplayLength(20),
   m_projectionErrorDisplayThickness(1), m_projectionErrorCam(), m_mask(nullptr), m_I(), m_sodb_init_called(false),
-  m_rand()
+  m_rand(), m_vvsWorkspace(), m_compiledModelCache(false), m_compiledModelCacheDirectory(),
+  m_modelLoadedFromCache(false)
 {
   oJo.eye();
   // Map used to parse additional information in CAO model files,
@@ -264,6 +269,7 @@ vpMbTracker &vpMbTracker::operator=(const vpMbTracker &tracker)
   m_stopCriteriaEpsilon = tracker.m_stopCriteriaEpsilon;
   m_initialMu = tracker.m_initialMu;
   m_projectionErrorLines = tracker.m_projectionErrorLines;
+  m_projectionErrorLinesIndex = tracker.m_projectionErrorLinesIndex;
   m_projectionErrorCylinders = tracker.m_projectionErrorCylinders;
   m_projectionErrorCircles = tracker.m_projectionErrorCircles;
   m_projectionErrorFaces = tracker.m_projectionErrorFaces;
@@ -280,6 +286,9 @@ vpMbTracker &vpMbTracker::operator=(const vpMbTracker &tracker)
   m_I = tracker.m_I;
   m_sodb_init_called = tracker.m_sodb_init_called;
   m_rand = tracker.m_rand;
+  m_compiledModelCache = tracker.m_compiledModelCache;
+  m_compiledModelCacheDirectory = tracker.m_compiledModelCacheDirectory;
+  m_modelLoadedFromCache = tracker.m_modelLoadedFromCache;
   return *this;
 }
 
@@ -1721,24 +1730,17 @@ void vpMbTracker::addPolygon(const std::vector<std::vector<vpPoint> > &listFaces
 void vpMbTracker::loadModel(const std::string &modelFile, bool verbose, const vpHomogeneousMatrix &od_M_o)
 {
   std::string::const_iterator it;
+  bool isCao = false;
 
   if (vpIoTools::checkFilename(modelFile)) {
     it = modelFile.end();
     if ((*(it - 1) == 'o' && *(it - 2) == 'a' && *(it - 3) == 'c' && *(it - 4) == '.') ||
         (*(it - 1) == 'O' && *(it - 2) == 'A' && *(it - 3) == 'C' && *(it - 4) == '.')) {
-      std::vector<std::string> vectorOfModelFilename;
-      int startIdFace = static_cast<int>(faces.size());
-      nbPoints = 0;
-      nbLines = 0;
-      nbPolygonLines = 0;
-      nbPolygonPoints = 0;
-      nbCylinders = 0;
-      nbCircles = 0;
-      loadCAOModel(modelFile, vectorOfModelFilename, startIdFace, verbose, true, od_M_o);
+      isCao = true;
     }
     else if ((*(it - 1) == 'l' && *(it - 2) == 'r' && *(it - 3) == 'w' && *(it - 4) == '.') ||
             (*(it - 1) == 'L' && *(it - 2) == 'R' && *(it - 3) == 'W' && *(it - 4) == '.')) {
-      loadVRMLModel(modelFile);
+      isCao = false;
     }
     else {
       throw vpException(vpException::ioError, "Error: File %s doesn't contain a cao or wrl model", modelFile.c_str());
@@ -1748,6 +1750,59 @@ void vpMbTracker::loadModel(const std::string &modelFile, bool verbose, const vp
     throw vpException(vpException::ioError, "Error: File %s doesn't exist", modelFile.c_str());
   }
 
+  vpMbtCompiledModel model;
+  std::string compiledModelFile;
+  bool fromCache = false;
+  if (m_compiledModelCache) {
+    // The transformation is only applied to cao models
+    compiledModelFile = getCompiledModelFilename(modelFile);
+    fromCache = model.load(compiledModelFile) && model.isUpToDate(isCao ? od_M_o : vpHomogeneousMatrix());
+  }
+
+  if (fromCache) {
+    if (isCao) {
+      model.getStatistics(nbPoints, nbLines, nbPolygonLines, nbPolygonPoints, nbCylinders, nbCircles);
+      // Same information as the one printed when a cao model including other models is parsed
+      if (model.getSources().size() > 1) {
+        printModelStatistics(modelFile, verbose);
+      }
+    }
+  }
+  else {
+    model.clear();
+    if (isCao) {
+      std::vector<std::string> vectorOfModelFilename;
+      int idFace = 0;
+      nbPoints = 0;
+      nbLines = 0;
+      nbPolygonLines = 0;
+      nbPolygonPoints = 0;
+      nbCylinders = 0;
+      nbCircles = 0;
+      parseCAOModel(modelFile, vectorOfModelFilename, model, idFace, verbose, true, od_M_o);
+      model.setStatistics(nbPoints, nbLines, nbPolygonLines, nbPolygonPoints, nbCylinders, nbCircles);
+      model.setTransformation(od_M_o);
+    }
+    else {
+      parseVRMLModel(modelFile, model);
+    }
+
+    if (m_compiledModelCache) {
+      model.computeTopology();
+      try {
+        model.save(compiledModelFile);
+      }
+      catch (const vpException &e) {
+        // The model is still usable, it will be parsed again next time
+        std::cerr << "Warning: " << e.getStringMessage() << std::endl;
+      }
+    }
+  }
+
+  int startIdFace = static_cast<int>(faces.size());
+  initFromCompiledModel(model, startIdFace);
+
+  m_modelLoadedFromCache = fromCache;
   this->modelInitialised = true;
   this->modelFileName = modelFile;
 }
@@ -1771,6 +1826,24 @@ geometry DEF cyl_cylinder1 IndexedFaceSet
   \param modelFile : The full name of the file containing the 3D model.
 */
 void vpMbTracker::loadVRMLModel(const std::string &modelFile)
+{
+  vpMbtCompiledModel model;
+  parseVRMLModel(modelFile, model);
+
+  int startIdFace = static_cast<int>(faces.size());
+  initFromCompiledModel(model, startIdFace);
+}
+
+/*!
+  Parse a vrml file and add its points and primitives to a compiled model.
+  See loadVRMLModel() for the supported content.
+
+  \throw vpException::fatalError if the file cannot be open, or if ViSP is built without Coin3D.
+
+  \param modelFile : The full name of the file containing the 3D model.
+  \param model : Compiled model to fill.
+*/
+void vpMbTracker::parseVRMLModel(const std::string &modelFile, vpMbtCompiledModel &model)
 {
 #ifdef VISP_HAVE_COIN3D
   m_sodb_init_called = true;
@@ -1784,6 +1857,7 @@ void vpMbTracker::loadVRMLModel(const std::string &modelFile)
     vpERROR_TRACE("can't open file to load model");
     throw vpException(vpException::fatalError, "can't open file to load model");
   }
+  model.addSource(modelFile);
 
   if (!in.isFileVRML2()) {
     SoSeparator *sceneGraph = SoDB::readAll(&in);
@@ -1808,16 +1882,204 @@ void vpMbTracker::loadVRMLModel(const std::string &modelFile)
   in.closeFile();
 
   vpHomogeneousMatrix transform;
-  int indexFace = static_cast<int>(faces.size());
-  extractGroup(sceneGraphVRML2, transform, indexFace);
+  int indexFace = 0;
+  extractGroup(sceneGraphVRML2, transform, indexFace, model);
 
   sceneGraphVRML2->unref();
 #else
+  (void)model;
   vpERROR_TRACE("coin not detected with ViSP, cannot load model : %s", modelFile.c_str());
   throw vpException(vpException::fatalError, "coin not detected with ViSP, cannot load model");
 #endif
 }
 
+/*!
+  Enable or disable the compiled model cache used by loadModel().
+
+  When the cache is enabled, the result of the parsing of a .cao or a .wrl model is saved in a binary file
+  (see vpMbtCompiledModel) the first time the model is loaded. The next calls to loadModel() with the same model
+  read this file instead of parsing the model again, as long as the model file, the files it includes and the
+  transformation given to loadModel() are unchanged. Otherwise the model is parsed and the cache file is
+  rewritten. The tracker obtained from the cache is the same as the one obtained by parsing the model.
+
+  \param enable : If true, enable the cache.
+  \param directory : Directory where the cache files are written. If empty, the cache file is written next to
+  the model file, with the \c .cmodel extension appended to its name. The directory is created if needed.
+
+  \sa getCompiledModelCache(), isModelLoadedFromCache()
+*/
+void vpMbTracker::setCompiledModelCache(bool enable, const std::string &directory)
+{
+  m_compiledModelCache = enable;
+  m_compiledModelCacheDirectory = directory;
+  if (enable && !directory.empty() && !vpIoTools::checkDirectory(directory)) {
+    vpIoTools::makeDirectory(directory);
+  }
+}
+
+/*!
+  Return the name of the compiled model cache file of a model file.
+
+  \param modelFile : Name of the .cao or .wrl model file.
+*/
+std::string vpMbTracker::getCompiledModelFilename(const std::string &modelFile) const
+{
+  if (m_compiledModelCacheDirectory.empty()) {
+    return modelFile + ".cmodel";
+  }
+
+  // Models with the same name in different directories share the cache directory
+  const std::string absolutePath = vpIoTools::getAbsolutePathname(modelFile);
+  const uint32_t crc = visp::vp_mz_crc32(0, reinterpret_cast<const unsigned char *>(absolutePath.c_str()),
+                                         absolutePath.size());
+  std::ostringstream oss;
+  oss << vpIoTools::getName(modelFile) << "." << std::hex << std::setw(8) << std::setfill('0') << crc << ".cmodel";
+  return vpIoTools::createFilePath(m_compiledModelCacheDirectory, oss.str());
+}
+
+/*!
+  Print the number of primitives of the last loaded cao model.
+
+  \param modelFile : Name of the model file.
+  \param verbose : If true, print the detailed information.
+*/
+void vpMbTracker::printModelStatistics(const std::string &modelFile, bool verbose) const
+{
+#if defined(VISP_HAVE_THREADS)
+  std::lock_guard<std::mutex> lock(g_mutex_cout);
+#endif
+  if (verbose) {
+    std::cout << "Global information for " << vpIoTools::getName(modelFile) << " :" << std::endl;
+    std::cout << "Total nb of points : " << nbPoints << std::endl;
+    std::cout << "Total nb of lines : " << nbLines << std::endl;
+    std::cout << "Total nb of polygon lines : " << nbPolygonLines << std::endl;
+    std::cout << "Total nb of polygon points : " << nbPolygonPoints << std::endl;
+    std::cout << "Total nb of cylinders : " << nbCylinders << std::endl;
+    std::cout << "Total nb of circles : " << nbCircles << std::endl;
+  }
+  else {
+    std::cout << "> " << nbPoints << " points" << std::endl;
+    std::cout << "> " << nbLines << " lines" << std::endl;
+    std::cout << "> " << nbPolygonLines << " polygon lines" << std::endl;
+    std::cout << "> " << nbPolygonPoints << " polygon points" << std::endl;
+    std::cout << "> " << nbCylinders << " cylinders" << std::endl;
+    std::cout << "> " << nbCircles << " circles" << std::endl;
+  }
+}
+
+/*!
+  Create the faces, lines, cylinders and circles of the tracker from the primitives of a compiled model.
+  The level of detail parameters that are not given in the model are resolved with the current tracker settings.
+
+  \param model : Compiled model.
+  \param startIdFace : Index of the first face of the model. Updated with the index of the face that follows
+  the last face of the model.
+*/
+void vpMbTracker::initFromCompiledModel(const vpMbtCompiledModel &model, int &startIdFace)
+{
+  const std::vector<vpMbtCompiledModel::vpPrimitive> &primitives = model.getPrimitives();
+  const std::vector<unsigned int> &indices = model.getIndices();
+  int nbFaces = 0;
+  std::vector<vpPoint> points;
+
+  for (size_t i = 0; i < primitives.size(); ++i) {
+    const vpMbtCompiledModel::vpPrimitive &primitive = primitives[i];
+    const int idFace = startIdFace + primitive.m_idFace;
+    points.resize(primitive.m_nbIndices);
+    for (unsigned int k = 0; k < primitive.m_nbIndices; ++k) {
+      points[k] = model.getPoint(indices[primitive.m_firstIndex + k]);
+    }
+
+    const bool useLod = (primitive.m_parameters & vpMbtCompiledModel::USE_LOD)
+      ? primitive.m_useLod : (!applyLodSettingInConfig ? useLodGeneral : false);
+    const bool hasMinPolygonArea = (primitive.m_parameters & vpMbtCompiledModel::MIN_POLYGON_AREA) != 0;
+    const bool hasMinLineLength = (primitive.m_parameters & vpMbtCompiledModel::MIN_LINE_LENGTH) != 0;
+
+    switch (primitive.m_type) {
+    case vpMbtCompiledModel::POLYGON_FROM_LINES:
+    case vpMbtCompiledModel::POLYGON_FROM_POINTS: {
+      const double minPolygonAreaThreshold = hasMinPolygonArea ? primitive.m_minPolygonAreaThreshold
+        : (!applyLodSettingInConfig ? minPolygonAreaThresholdGeneral : 2500.0);
+      const double minLineLengthThreshold = hasMinLineLength ? primitive.m_minLineLengthThreshold
+        : minLineLengthThresholdGeneral;
+      const bool fromLines = (primitive.m_type == vpMbtCompiledModel::POLYGON_FROM_LINES);
+
+      addPolygon(points, idFace, primitive.m_name, useLod, minPolygonAreaThreshold, minLineLengthThreshold);
+      if (fromLines) {
+        initFaceFromLines(*(faces.getPolygon().back())); // Init from the last polygon that was added
+      }
+      else {
+        initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
+      }
+
+      addProjectionErrorPolygon(points, idFace, primitive.m_name, useLod, minPolygonAreaThreshold,
+                                minLineLengthThreshold);
+      if (fromLines) {
+        initProjectionErrorFaceFromLines(*(m_projectionErrorFaces.getPolygon().back()));
+      }
+      else {
+        initProjectionErrorFaceFromCorners(*(m_projectionErrorFaces.getPolygon().back()));
+      }
+      nbFaces = std::max<int>(nbFaces, primitive.m_idFace + 1);
+      break;
+    }
+    case vpMbtCompiledModel::SEGMENT: {
+      const double minPolygonAreaThreshold = hasMinPolygonArea ? primitive.m_minPolygonAreaThreshold
+        : minPolygonAreaThresholdGeneral;
+      const double minLineLengthThreshold = hasMinLineLength ? primitive.m_minLineLengthThreshold
+        : (!applyLodSettingInConfig ? minLineLengthThresholdGeneral : 50.0);
+
+      addPolygon(points, idFace, primitive.m_name, useLod, minPolygonAreaThreshold, minLineLengthThreshold);
+      initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
+
+      addProjectionErrorPolygon(points, idFace, primitive.m_name, useLod, minPolygonAreaThreshold,
+                                minLineLengthThreshold);
+      initProjectionErrorFaceFromCorners(*(m_projectionErrorFaces.getPolygon().back()));
+      nbFaces = std::max<int>(nbFaces, primitive.m_idFace + 1);
+      break;
+    }
+    case vpMbtCompiledModel::CYLINDER: {
+      const double minLineLengthThreshold = hasMinLineLength ? primitive.m_minLineLengthThreshold
+        : (!applyLodSettingInConfig ? minLineLengthThresholdGeneral : 50.0);
+
+      // The revolution axis, followed by the 4 faces of the bounding box
+      addPolygon(points[0], points[1], idFace, primitive.m_name, useLod, minLineLengthThreshold);
+      addProjectionErrorPolygon(points[0], points[1], idFace, primitive.m_name, useLod, minLineLengthThreshold);
+
+      std::vector<std::vector<vpPoint> > listFaces;
+      createCylinderBBox(points[0], points[1], primitive.m_radius, listFaces);
+      addPolygon(listFaces, idFace + 1, primitive.m_name, useLod, minLineLengthThreshold);
+
+      initCylinder(points[0], points[1], primitive.m_radius, idFace, primitive.m_name);
+
+      addProjectionErrorPolygon(listFaces, idFace + 1, primitive.m_name, useLod, minLineLengthThreshold);
+      initProjectionErrorCylinder(points[0], points[1], primitive.m_radius, idFace, primitive.m_name);
+      nbFaces = std::max<int>(nbFaces, primitive.m_idFace + 5);
+      break;
+    }
+    case vpMbtCompiledModel::CIRCLE: {
+      const double minPolygonAreaThreshold = hasMinPolygonArea ? primitive.m_minPolygonAreaThreshold
+        : (!applyLodSettingInConfig ? minPolygonAreaThresholdGeneral : 2500.0);
+
+      addPolygon(points[0], points[1], points[2], primitive.m_radius, idFace, primitive.m_name, useLod,
+                 minPolygonAreaThreshold);
+
+      initCircle(points[0], points[1], points[2], primitive.m_radius, idFace, primitive.m_name);
+
+      addProjectionErrorPolygon(points[0], points[1], points[2], primitive.m_radius, idFace, primitive.m_name,
+                                useLod, minPolygonAreaThreshold);
+      initProjectionErrorCircle(points[0], points[1], points[2], primitive.m_radius, idFace, primitive.m_name);
+      nbFaces = std::max<int>(nbFaces, primitive.m_idFace + 1);
+      break;
+    }
+    default:
+      break;
+    }
+  }
+
+  startIdFace += nbFaces;
+}
+
 /*!
  * Skip lines starting with # as comment or empty lines
  * @param fileId : File id.
@@ -1942,6 +2204,30 @@ std::map<std::string, std::string> vpMbTracker::parseParameters(std::string &end
 */
 void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::string> &vectorOfModelFilename,
                                int &startIdFace, bool verbose, bool parent, const vpHomogeneousMatrix &od_M_o)
+{
+  vpMbtCompiledModel model;
+  int idFace = 0;
+  parseCAOModel(modelFile, vectorOfModelFilename, model, idFace, verbose, parent, od_M_o);
+  initFromCompiledModel(model, startIdFace);
+}
+
+/*!
+  Parse a *.cao file and the files it includes, and add their points and primitives to a compiled model.
+  See loadCAOModel() for the description of the format.
+
+  \param modelFile : Full name of the *.cao file.
+  \param vectorOfModelFilename : A vector of *.cao files.
+  \param model : Compiled model to fill.
+  \param startIdFace : Index of the next face, relative to the model. Updated with the faces of the file.
+  \param verbose : If true, will print additional information with CAO model
+  files which include other CAO model files.
+  \param parent : This parameter is set to true when parsing a parent CAO model file,
+  and false when parsing an included CAO model file.
+  \param od_M_o : Transformation matrix applied to the 3D points of the file.
+*/
+void vpMbTracker::parseCAOModel(const std::string &modelFile, std::vector<std::string> &vectorOfModelFilename,
+                                vpMbtCompiledModel &model, int &startIdFace, bool verbose, bool parent,
+                                const vpHomogeneousMatrix &od_M_o)
 {
   const unsigned int maxDataCAO = 100000; // arbitrary value
 
@@ -1957,6 +2243,7 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
     std::cout << "Model file : " << modelFile << std::endl;
   }
   vectorOfModelFilename.push_back(modelFile);
+  model.addSource(modelFile);
 
   try {
     char c;
@@ -2100,7 +2387,8 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
           if (!cyclic) {
             if (vpIoTools::checkFilename(headerPath)) {
               header = true;
-              loadCAOModel(headerPath, vectorOfModelFilename, startIdFace, verbose, false, od_M_o * o_M_o_from_cao);
+              parseCAOModel(headerPath, vectorOfModelFilename, model, startIdFace, verbose, false,
+                            od_M_o * o_M_o_from_cao);
             }
             else {
               fileId.close();
@@ -2150,7 +2438,8 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
       fileId.close();
       throw vpException(vpException::badValue, "in vpMbTracker::loadCAOModel() -> no points are defined");
     }
-    std::vector<vpPoint> caoPoints(caoNbrPoint);
+    // Index of the points in the compiled model
+    std::vector<unsigned int> caoPoints(caoNbrPoint);
 
     for (unsigned int k = 0; k < caoNbrPoint; k++) {
       removeCommentsAndEmptyLines(fileId);
@@ -2170,7 +2459,7 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
       fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n')); // skip the rest of the line
 
       vpColVector pt_3d_tf = od_M_o * pt_3d;
-      caoPoints[k].setWorldCoordinates(pt_3d_tf[0], pt_3d_tf[1], pt_3d_tf[2]);
+      caoPoints[k] = model.addPoint(pt_3d_tf[0], pt_3d_tf[1], pt_3d_tf[2]);
     }
 
     removeCommentsAndEmptyLines(fileId);
@@ -2216,29 +2505,24 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
       if (safeGetline(fileId, endLine).good()) {
         std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
 
-        std::string segmentName = "";
-        double minLineLengthThresh = !applyLodSettingInConfig ? minLineLengthThresholdGeneral : 50.0;
-        bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
+        SegmentInfo segmentInfo;
         if (mapOfParams.find("name") != mapOfParams.end()) {
-          segmentName = mapOfParams["name"];
+          segmentInfo.name = mapOfParams["name"];
         }
         if (mapOfParams.find("minLineLengthThreshold") != mapOfParams.end()) {
-          minLineLengthThresh = std::atof(mapOfParams["minLineLengthThreshold"].c_str());
+          segmentInfo.minLineLengthThresh = std::atof(mapOfParams["minLineLengthThreshold"].c_str());
+          segmentInfo.parameters |= vpMbtCompiledModel::MIN_LINE_LENGTH;
         }
         if (mapOfParams.find("useLod") != mapOfParams.end()) {
-          useLod = vpIoTools::parseBoolean(mapOfParams["useLod"]);
+          segmentInfo.useLod = vpIoTools::parseBoolean(mapOfParams["useLod"]);
+          segmentInfo.parameters |= vpMbtCompiledModel::USE_LOD;
         }
 
-        SegmentInfo segmentInfo;
-        segmentInfo.name = segmentName;
-        segmentInfo.useLod = useLod;
-        segmentInfo.minLineLengthThresh = minLineLengthThresh;
-
         caoLinePoints[2 * k] = index1;
         caoLinePoints[2 * k + 1] = index2;
 
         if (index1 < caoNbrPoint && index2 < caoNbrPoint) {
-          std::vector<vpPoint> extremities;
+          std::vector<unsigned int> extremities;
           extremities.push_back(caoPoints[index1]);
           extremities.push_back(caoPoints[index2]);
           segmentInfo.extremities = extremities;
@@ -2284,7 +2568,7 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
 
       unsigned int nbLinePol;
       fileId >> nbLinePol;
-      std::vector<vpPoint> corners;
+      std::vector<unsigned int> corners;
       if (nbLinePol > maxDataCAO) {
         fileId.close();
         throw vpException(vpException::badValue, "Exceed the max number of lines.");
@@ -2311,24 +2595,23 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
         std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
 
         std::string polygonName = "";
-        bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-        double minPolygonAreaThreshold = !applyLodSettingInConfig ? minPolygonAreaThresholdGeneral : 2500.0;
+        unsigned int parameters = vpMbtCompiledModel::NO_PARAMETER;
+        bool useLod = false;
+        double minPolygonAreaThreshold = 0.;
         if (mapOfParams.find("name") != mapOfParams.end()) {
           polygonName = mapOfParams["name"];
         }
         if (mapOfParams.find("minPolygonAreaThreshold") != mapOfParams.end()) {
           minPolygonAreaThreshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
+          parameters |= vpMbtCompiledModel::MIN_POLYGON_AREA;
         }
         if (mapOfParams.find("useLod") != mapOfParams.end()) {
           useLod = vpIoTools::parseBoolean(mapOfParams["useLod"]);
+          parameters |= vpMbtCompiledModel::USE_LOD;
         }
 
-        addPolygon(corners, idFace, polygonName, useLod, minPolygonAreaThreshold, minLineLengthThresholdGeneral);
-        initFaceFromLines(*(faces.getPolygon().back())); // Init from the last polygon that was added
-
-        addProjectionErrorPolygon(corners, idFace++, polygonName, useLod, minPolygonAreaThreshold,
-                                  minLineLengthThresholdGeneral);
-        initProjectionErrorFaceFromLines(*(m_projectionErrorFaces.getPolygon().back()));
+        model.addPrimitive(vpMbtCompiledModel::POLYGON_FROM_LINES, idFace++, corners, 0., polygonName, parameters,
+                           useLod, minPolygonAreaThreshold, 0.);
       }
     }
 
@@ -2337,13 +2620,8 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
          it != segmentTemporaryMap.end(); ++it) {
       if (std::find(faceSegmentKeyVector.begin(), faceSegmentKeyVector.end(), it->first) ==
           faceSegmentKeyVector.end()) {
-        addPolygon(it->second.extremities, idFace, it->second.name, it->second.useLod, minPolygonAreaThresholdGeneral,
-                   it->second.minLineLengthThresh);
-        initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
-
-        addProjectionErrorPolygon(it->second.extremities, idFace++, it->second.name, it->second.useLod,
-                                  minPolygonAreaThresholdGeneral, it->second.minLineLengthThresh);
-        initProjectionErrorFaceFromCorners(*(m_projectionErrorFaces.getPolygon().back()));
+        model.addPrimitive(vpMbtCompiledModel::SEGMENT, idFace++, it->second.extremities, 0., it->second.name,
+                           it->second.parameters, it->second.useLod, 0., it->second.minLineLengthThresh);
       }
     }
 
@@ -2377,7 +2655,7 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
         fileId.close();
         throw vpException(vpException::badValue, "Exceed the max number of points.");
       }
-      std::vector<vpPoint> corners;
+      std::vector<unsigned int> corners;
       for (unsigned int n = 0; n < nbPointPol; n++) {
         fileId >> index;
         if (index > caoNbrPoint - 1) {
@@ -2394,24 +2672,23 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
         std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
 
         std::string polygonName = "";
-        bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-        double minPolygonAreaThreshold = !applyLodSettingInConfig ? minPolygonAreaThresholdGeneral : 2500.0;
+        unsigned int parameters = vpMbtCompiledModel::NO_PARAMETER;
+        bool useLod = false;
+        double minPolygonAreaThreshold = 0.;
         if (mapOfParams.find("name") != mapOfParams.end()) {
           polygonName = mapOfParams["name"];
         }
         if (mapOfParams.find("minPolygonAreaThreshold") != mapOfParams.end()) {
           minPolygonAreaThreshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
+          parameters |= vpMbtCompiledModel::MIN_POLYGON_AREA;
         }
         if (mapOfParams.find("useLod") != mapOfParams.end()) {
           useLod = vpIoTools::parseBoolean(mapOfParams["useLod"]);
+          parameters |= vpMbtCompiledModel::USE_LOD;
         }
 
-        addPolygon(corners, idFace, polygonName, useLod, minPolygonAreaThreshold, minLineLengthThresholdGeneral);
-        initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
-
-        addProjectionErrorPolygon(corners, idFace++, polygonName, useLod, minPolygonAreaThreshold,
-                                  minLineLengthThresholdGeneral);
-        initProjectionErrorFaceFromCorners(*(m_projectionErrorFaces.getPolygon().back()));
+        model.addPrimitive(vpMbtCompiledModel::POLYGON_FROM_POINTS, idFace++, corners, 0., polygonName, parameters,
+                           useLod, minPolygonAreaThreshold, 0.);
       }
     }
 
@@ -2457,34 +2734,31 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
           std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
 
           std::string polygonName = "";
-          bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-          double minLineLengthThreshold = !applyLodSettingInConfig ? minLineLengthThresholdGeneral : 50.0;
+          unsigned int parameters = vpMbtCompiledModel::NO_PARAMETER;
+          bool useLod = false;
+          double minLineLengthThreshold = 0.;
           if (mapOfParams.find("name") != mapOfParams.end()) {
             polygonName = mapOfParams["name"];
           }
           if (mapOfParams.find("minLineLengthThreshold") != mapOfParams.end()) {
             minLineLengthThreshold = std::atof(mapOfParams["minLineLengthThreshold"].c_str());
+            parameters |= vpMbtCompiledModel::MIN_LINE_LENGTH;
           }
           if (mapOfParams.find("useLod") != mapOfParams.end()) {
             useLod = vpIoTools::parseBoolean(mapOfParams["useLod"]);
+            parameters |= vpMbtCompiledModel::USE_LOD;
+          }
+          if ((indexP1 >= caoNbrPoint) || (indexP2 >= caoNbrPoint)) {
+            throw vpException(vpException::badValue, "Exceed the max number of points.");
           }
 
-          int idRevolutionAxis = idFace;
-          addPolygon(caoPoints[indexP1], caoPoints[indexP2], idFace, polygonName, useLod, minLineLengthThreshold);
-
-          addProjectionErrorPolygon(caoPoints[indexP1], caoPoints[indexP2], idFace++, polygonName, useLod,
-                                    minLineLengthThreshold);
-
-          std::vector<std::vector<vpPoint> > listFaces;
-          createCylinderBBox(caoPoints[indexP1], caoPoints[indexP2], radius, listFaces);
-          addPolygon(listFaces, idFace, polygonName, useLod, minLineLengthThreshold);
-
-          initCylinder(caoPoints[indexP1], caoPoints[indexP2], radius, idRevolutionAxis, polygonName);
-
-          addProjectionErrorPolygon(listFaces, idFace, polygonName, useLod, minLineLengthThreshold);
-          initProjectionErrorCylinder(caoPoints[indexP1], caoPoints[indexP2], radius, idRevolutionAxis, polygonName);
-
-          idFace += 4;
+          // The revolution axis and the 4 faces of the bounding box
+          std::vector<unsigned int> axis;
+          axis.push_back(caoPoints[indexP1]);
+          axis.push_back(caoPoints[indexP2]);
+          model.addPrimitive(vpMbtCompiledModel::CYLINDER, idFace, axis, radius, polygonName, parameters, useLod, 0.,
+                             minLineLengthThreshold);
+          idFace += 5;
         }
       }
 
@@ -2549,27 +2823,30 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
             std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
 
             std::string polygonName = "";
-            bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-            double minPolygonAreaThreshold = !applyLodSettingInConfig ? minPolygonAreaThresholdGeneral : 2500.0;
+            unsigned int parameters = vpMbtCompiledModel::NO_PARAMETER;
+            bool useLod = false;
+            double minPolygonAreaThreshold = 0.;
             if (mapOfParams.find("name") != mapOfParams.end()) {
               polygonName = mapOfParams["name"];
             }
             if (mapOfParams.find("minPolygonAreaThreshold") != mapOfParams.end()) {
               minPolygonAreaThreshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
+              parameters |= vpMbtCompiledModel::MIN_POLYGON_AREA;
             }
             if (mapOfParams.find("useLod") != mapOfParams.end()) {
               useLod = vpIoTools::parseBoolean(mapOfParams["useLod"]);
+              parameters |= vpMbtCompiledModel::USE_LOD;
+            }
+            if ((indexP1 >= caoNbrPoint) || (indexP2 >= caoNbrPoint) || (indexP3 >= caoNbrPoint)) {
+              throw vpException(vpException::badValue, "Exceed the max number of points.");
             }
 
-            addPolygon(caoPoints[indexP1], caoPoints[indexP2], caoPoints[indexP3], radius, idFace, polygonName, useLod,
-                      minPolygonAreaThreshold);
-
-            initCircle(caoPoints[indexP1], caoPoints[indexP2], caoPoints[indexP3], radius, idFace, polygonName);
-
-            addProjectionErrorPolygon(caoPoints[indexP1], caoPoints[indexP2], caoPoints[indexP3], radius, idFace,
-                                      polygonName, useLod, minPolygonAreaThreshold);
-            initProjectionErrorCircle(caoPoints[indexP1], caoPoints[indexP2], caoPoints[indexP3], radius, idFace++,
-                                      polygonName);
+            std::vector<unsigned int> circlePoints;
+            circlePoints.push_back(caoPoints[indexP1]);
+            circlePoints.push_back(caoPoints[indexP2]);
+            circlePoints.push_back(caoPoints[indexP3]);
+            model.addPrimitive(vpMbtCompiledModel::CIRCLE, idFace++, circlePoints, radius, polygonName, parameters,
+                               useLod, minPolygonAreaThreshold, 0.);
           }
         }
       }
@@ -2583,29 +2860,7 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
     startIdFace = idFace;
 
     if (header && parent) {
-      if (verbose) {
-#if defined(VISP_HAVE_THREADS)
-        std::lock_guard<std::mutex> lock(g_mutex_cout);
-#endif
-        std::cout << "Global information for " << vpIoTools::getName(modelFile) << " :" << std::endl;
-        std::cout << "Total nb of points : " << nbPoints << std::endl;
-        std::cout << "Total nb of lines : " << nbLines << std::endl;
-        std::cout << "Total nb of polygon lines : " << nbPolygonLines << std::endl;
-        std::cout << "Total nb of polygon points : " << nbPolygonPoints << std::endl;
-        std::cout << "Total nb of cylinders : " << nbCylinders << std::endl;
-        std::cout << "Total nb of circles : " << nbCircles << std::endl;
-      }
-      else {
-#if defined(VISP_HAVE_THREADS)
-        std::lock_guard<std::mutex> lock(g_mutex_cout);
-#endif
-        std::cout << "> " << nbPoints << " points" << std::endl;
-        std::cout << "> " << nbLines << " lines" << std::endl;
-        std::cout << "> " << nbPolygonLines << " polygon lines" << std::endl;
-        std::cout << "> " << nbPolygonPoints << " polygon points" << std::endl;
-        std::cout << "> " << nbCylinders << " cylinders" << std::endl;
-        std::cout << "> " << nbCircles << " circles" << std::endl;
-      }
+      printModelStatistics(modelFile, verbose);
     }
 
     // Go up: remove current model
@@ -2628,8 +2883,10 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
   \param sceneGraphVRML2 : Current node (either Transform, or Group node).
   \param transform : Transformation matrix for this group.
   \param idFace : Index of the face.
+  \param model : Compiled model to fill.
 */
-void vpMbTracker::extractGroup(SoVRMLGroup *sceneGraphVRML2, vpHomogeneousMatrix &transform, int &idFace)
+void vpMbTracker::extractGroup(SoVRMLGroup *sceneGraphVRML2, vpHomogeneousMatrix &transform, int &idFace,
+                               vpMbtCompiledModel &model)
 {
   vpHomogeneousMatrix transformCur;
   SoVRMLTransform *sceneGraphVRML2Trasnform = dynamic_cast<SoVRMLTransform *>(sceneGraphVRML2);
@@ -2678,11 +2935,11 @@ void vpMbTracker::extractGroup(SoVRMLGroup *sceneGraphVRML2, vpHomogeneousMatrix
     child = sceneGraphVRML2->getChild(i);
 
     if (child->getTypeId() == SoVRMLGroup::getClassTypeId()) {
-      extractGroup((SoVRMLGroup *)child, transform_recursive, idFace);
+      extractGroup((SoVRMLGroup *)child, transform_recursive, idFace, model);
     }
 
     if (child->getTypeId() == SoVRMLTransform::getClassTypeId()) {
-      extractGroup((SoVRMLTransform *)child, transform_recursive, idFace);
+      extractGroup((SoVRMLTransform *)child, transform_recursive, idFace, model);
     }
 
     if (child->getTypeId() == SoVRMLShape::getClassTypeId()) {
@@ -2694,16 +2951,16 @@ void vpMbTracker::extractGroup(SoVRMLGroup *sceneGraphVRML2, vpHomogeneousMatrix
           SoVRMLIndexedFaceSet *face_set;
           face_set = (SoVRMLIndexedFaceSet *)child2list->get(j);
           if (!strncmp(face_set->getName().getString(), "cyl", 3)) {
-            extractCylinders(face_set, transform, idFace, name);
+            extractCylinders(face_set, transform, idFace, model, name);
           }
           else {
-            extractFaces(face_set, transform, idFace, name);
+            extractFaces(face_set, transform, idFace, model, name);
           }
         }
         if (((SoNode *)child2list->get(j))->getTypeId() == SoVRMLIndexedLineSet::getClassTypeId()) {
           SoVRMLIndexedLineSet *line_set;
           line_set = (SoVRMLIndexedLineSet *)child2list->get(j);
-          extractLines(line_set, idFace, name);
+          extractLines(line_set, idFace, model, name);
         }
       }
     }
@@ -2711,35 +2968,33 @@ void vpMbTracker::extractGroup(SoVRMLGroup *sceneGraphVRML2, vpHomogeneousMatrix
 }
 
 /*!
-  Extract a face of the object to track from the VMRL model. This method calls
-  the initFaceFromCorners() method implemented in the child class.
+  Extract a face of the object to track from the VMRL model. The face is
+  initialized with the initFaceFromCorners() method implemented in the child class.
 
   \param face_set : Pointer to the face in the vrml format.
   \param transform : Transformation matrix applied to the face.
   \param idFace : Face id.
+  \param model : Compiled model to fill.
   \param polygonName: Name of the polygon.
 */
 void vpMbTracker::extractFaces(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
-                               const std::string &polygonName)
+                               vpMbtCompiledModel &model, const std::string &polygonName)
 {
-  std::vector<vpPoint> corners;
+  std::vector<unsigned int> corners;
 
   //  SoMFInt32 indexList = _face_set->coordIndex;
   //  int indexListSize = indexList.getNum();
   int indexListSize = face_set->coordIndex.getNum();
 
   vpColVector pointTransformed(4);
-  vpPoint pt;
   SoVRMLCoordinate *coord;
 
   for (int i = 0; i < indexListSize; i++) {
     if (face_set->coordIndex[i] == -1) {
       if (corners.size() > 1) {
-        addPolygon(corners, idFace, polygonName);
-        initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
-
-        addProjectionErrorPolygon(corners, idFace++, polygonName);
-        initProjectionErrorFaceFromCorners(*(m_projectionErrorFaces.getPolygon().back()));
+        model.addPrimitive(vpMbtCompiledModel::POLYGON_FROM_POINTS, idFace++, corners, 0., polygonName,
+                           vpMbtCompiledModel::USE_LOD | vpMbtCompiledModel::MIN_POLYGON_AREA |
+                           vpMbtCompiledModel::MIN_LINE_LENGTH, false, 2500.0, 50.0);
         corners.resize(0);
       }
     }
@@ -2753,8 +3008,7 @@ void vpMbTracker::extractFaces(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatr
 
       pointTransformed = transform * pointTransformed;
 
-      pt.setWorldCoordinates(pointTransformed[0], pointTransformed[1], pointTransformed[2]);
-      corners.push_back(pt);
+      corners.push_back(model.addPoint(pointTransformed[0], pointTransformed[1], pointTransformed[2]));
     }
   }
 }
@@ -2771,10 +3025,11 @@ void vpMbTracker::extractFaces(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatr
   \param face_set : Pointer to the cylinder in the vrml format.
   \param transform : Transformation matrix applied to the cylinder.
   \param idFace : Id of the face.
+  \param model : Compiled model to fill.
   \param polygonName: Name of the polygon.
 */
 void vpMbTracker::extractCylinders(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
-                                   const std::string &polygonName)
+                                   vpMbtCompiledModel &model, const std::string &polygonName)
 {
   std::vector<vpPoint> corners_c1, corners_c2; // points belonging to the
                                                // first circle and to the
@@ -2831,53 +3086,42 @@ void vpMbTracker::extractCylinders(SoVRMLIndexedFaceSet *face_set, vpHomogeneous
     throw vpException(vpException::badValue, "Radius from the two circles of the cylinders are different.");
   }
 
-  // addPolygon(p1, p2, idFace, polygonName);
-  // initCylinder(p1, p2, radius_c1, idFace++);
-
-  int idRevolutionAxis = idFace;
-  addPolygon(p1, p2, idFace, polygonName);
-
-  addProjectionErrorPolygon(p1, p2, idFace++, polygonName);
-
-  std::vector<std::vector<vpPoint> > listFaces;
-  createCylinderBBox(p1, p2, radius_c1, listFaces);
-  addPolygon(listFaces, idFace, polygonName);
-
-  initCylinder(p1, p2, radius_c1, idRevolutionAxis, polygonName);
-
-  addProjectionErrorPolygon(listFaces, idFace, polygonName);
-  initProjectionErrorCylinder(p1, p2, radius_c1, idRevolutionAxis, polygonName);
-
-  idFace += 4;
+  // The revolution axis and the 4 faces of the bounding box
+  std::vector<unsigned int> axis;
+  axis.push_back(model.addPoint(p1.get_oX(), p1.get_oY(), p1.get_oZ()));
+  axis.push_back(model.addPoint(p2.get_oX(), p2.get_oY(), p2.get_oZ()));
+  model.addPrimitive(vpMbtCompiledModel::CYLINDER, idFace, axis, radius_c1, polygonName,
+                     vpMbtCompiledModel::USE_LOD | vpMbtCompiledModel::MIN_POLYGON_AREA |
+                     vpMbtCompiledModel::MIN_LINE_LENGTH, false, 2500.0, 50.0);
+  idFace += 5;
 }
 
 /*!
-  Extract a line of the object to track from the VMRL model. This method calls
-  the initFaceFromCorners() method implemented in the child class.
+  Extract a line of the object to track from the VMRL model. The line is
+  initialized with the initFaceFromCorners() method implemented in the child class.
 
   \param line_set : Pointer to the line in the vrml format.
   \param idFace : Id of the face.
+  \param model : Compiled model to fill.
   \param polygonName: Name of the polygon.
 */
-void vpMbTracker::extractLines(SoVRMLIndexedLineSet *line_set, int &idFace, const std::string &polygonName)
+void vpMbTracker::extractLines(SoVRMLIndexedLineSet *line_set, int &idFace, vpMbtCompiledModel &model,
+                               const std::string &polygonName)
 {
-  std::vector<vpPoint> corners;
+  std::vector<unsigned int> corners;
   corners.resize(0);
 
   int indexListSize = line_set->coordIndex.getNum();
 
   SbVec3f point(0, 0, 0);
-  vpPoint pt;
   SoVRMLCoordinate *coord;
 
   for (int i = 0; i < indexListSize; i++) {
     if (line_set->coordIndex[i] == -1) {
       if (corners.size() > 1) {
-        addPolygon(corners, idFace, polygonName);
-        initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
-
-        addProjectionErrorPolygon(corners, idFace++, polygonName);
-        initProjectionErrorFaceFromCorners(*(m_projectionErrorFaces.getPolygon().back()));
+        model.addPrimitive(vpMbtCompiledModel::POLYGON_FROM_POINTS, idFace++, corners, 0., polygonName,
+                           vpMbtCompiledModel::USE_LOD | vpMbtCompiledModel::MIN_POLYGON_AREA |
+                           vpMbtCompiledModel::MIN_LINE_LENGTH, false, 2500.0, 50.0);
         corners.resize(0);
       }
     }
@@ -2888,8 +3132,7 @@ void vpMbTracker::extractLines(SoVRMLIndexedLineSet *line_set, int &idFace, cons
       point[1] = coord->point[index].getValue()[1];
       point[2] = coord->point[index].getValue()[2];
 
-      pt.setWorldCoordinates(point[0], point[1], point[2]);
-      corners.push_back(pt);
+      corners.push_back(model.addPoint(point[0], point[1], point[2]));
     }
   }
 }
@@ -3242,62 +3485,156 @@ void vpMbTracker::computeVVSPoseEstimation(const bool isoJoIdentity, unsigned in
                                            vpColVector &LTR, double &mu, vpColVector &v, const vpColVector *const w,
                                            vpColVector *const m_w_prev)
 {
-  if (isoJoIdentity) {
-    LTL = L.AtA();
-    computeJTR(L, R, LTR);
+  // All the temporaries are taken from the workspace to avoid reallocations from one iteration to another
+  vpMbtVVSWorkspace &ws = m_vvsWorkspace;
+
+  if (!isoJoIdentity) {
+    ws.cVo.buildFrom(m_cMo);
+    ws.resize(ws.VJ, 6, 6);
+    ws.resize(ws.LVJ, L.getRows(), 6);
+    for (unsigned int i = 0; i < 6; ++i) {
+      for (unsigned int j = 0; j < 6; ++j) {
+        double s = 0;
+        for (unsigned int k = 0; k < 6; ++k) {
+          s += ws.cVo[i][k] * oJo[k][j];
+        }
+        ws.VJ[i][j] = s;
+      }
+    }
+    vpMatrix::mult2Matrices(L, ws.VJ, ws.LVJ);
 
-    switch (m_optimizationMethod) {
-    case vpMbTracker::LEVENBERG_MARQUARDT_OPT: {
-      vpMatrix LMA(LTL.getRows(), LTL.getCols());
-      LMA.eye();
-      vpMatrix LTLmuI = LTL + (LMA * mu);
-      v = -m_lambda * LTLmuI.pseudoInverse(LTLmuI.getRows() * std::numeric_limits<double>::epsilon()) * LTR;
+    // When some dof are not estimated, LTL and LTR are computed from L * (cVo * oJo)
+    ws.resize(LTL, 6, 6);
+    ws.resize(LTR, 6);
+    ws.LVJ.AtA(LTL);
+    computeJTR(ws.LVJ, R, LTR);
+  }
+  else {
+    ws.resize(LTL, L.getCols(), L.getCols());
+    ws.resize(LTR, 6);
+    L.AtA(LTL);
+    computeJTR(L, R, LTR);
+  }
 
-      if (iter != 0)
-        mu /= 10.0;
+  computeVVSPoseUpdate(isoJoIdentity, iter, LTL, LTR, error, error_prev, mu, v, w, m_w_prev);
+}
 
-      error_prev = error;
-      if (w != nullptr && m_w_prev != nullptr)
-        *m_w_prev = *w;
-      break;
+/*!
+  Compute the pose update from normal equations that have already been accumulated, that is from
+  \f$ \mathbf{L}^T \mathbf{W} \mathbf{L} \f$ and \f$ \mathbf{L}^T \mathbf{W} \mathbf{e} \f$ expressed in the
+  camera frame. This is equivalent to computeVVSPoseEstimation() without the need to build the stacked
+  interaction matrix.
+
+  \param isoJoIdentity : If false, only the degrees of freedom given by oJo are estimated.
+  \param iter : Current iteration.
+  \param LTL : 6x6 normal matrix. Modified when isoJoIdentity is false.
+  \param LTR : Right-hand side of the normal equations. Modified when isoJoIdentity is false.
+  \param error : Current residuals.
+  \param error_prev : Residuals of the previous iteration, updated with the Levenberg-Marquardt method.
+  \param mu : Levenberg-Marquardt damping factor.
+  \param v : Computed velocity.
+  \param w : Current weights, saved with the Levenberg-Marquardt method.
+  \param m_w_prev : Weights of the previous iteration.
+*/
+void vpMbTracker::computeVVSPoseEstimationFromNormalEquations(const bool isoJoIdentity, unsigned int iter,
+                                                              vpMatrix &LTL, vpColVector &LTR,
+                                                              const vpColVector &error, vpColVector &error_prev,
+                                                              double &mu, vpColVector &v, const vpColVector *const w,
+                                                              vpColVector *const m_w_prev)
+{
+  vpMbtVVSWorkspace &ws = m_vvsWorkspace;
+
+  if (!isoJoIdentity) {
+    // (L VJ)^T W (L VJ) = VJ^T (L^T W L) VJ and (L VJ)^T W e = VJ^T (L^T W e)
+    ws.cVo.buildFrom(m_cMo);
+    ws.resize(ws.VJ, 6, 6);
+    ws.resize(ws.LVJ, 6, 6);
+    for (unsigned int i = 0; i < 6; ++i) {
+      for (unsigned int j = 0; j < 6; ++j) {
+        double s = 0;
+        for (unsigned int k = 0; k < 6; ++k) {
+          s += ws.cVo[i][k] * oJo[k][j];
+        }
+        ws.VJ[i][j] = s;
+      }
     }
-
-    case vpMbTracker::GAUSS_NEWTON_OPT:
-    default:
-      v = -m_lambda * LTL.pseudoInverse(LTL.getRows() * std::numeric_limits<double>::epsilon()) * LTR;
-      break;
+    for (unsigned int i = 0; i < 6; ++i) {
+      for (unsigned int j = 0; j < 6; ++j) {
+        double s = 0;
+        for (unsigned int k = 0; k < 6; ++k) {
+          s += LTL[i][k] * ws.VJ[k][j];
+        }
+        ws.LVJ[i][j] = s;
+      }
+    }
+    double VJTLTR[6];
+    for (unsigned int i = 0; i < 6; ++i) {
+      double s = 0;
+      for (unsigned int k = 0; k < 6; ++k) {
+        s += ws.VJ[k][i] * LTR[k];
+      }
+      VJTLTR[i] = s;
+      for (unsigned int j = 0; j < 6; ++j) {
+        s = 0;
+        for (unsigned int k = 0; k < 6; ++k) {
+          s += ws.VJ[k][i] * ws.LVJ[k][j];
+        }
+        LTL[i][j] = s;
+      }
+    }
+    for (unsigned int i = 0; i < 6; ++i) {
+      LTR[i] = VJTLTR[i];
     }
   }
-  else {
-    vpVelocityTwistMatrix cVo;
-    cVo.buildFrom(m_cMo);
-    vpMatrix LVJ = (L * (cVo * oJo));
-    vpMatrix LVJTLVJ = (LVJ).AtA();
-    vpColVector LVJTR;
-    computeJTR(LVJ, R, LVJTR);
-
-    switch (m_optimizationMethod) {
-    case vpMbTracker::LEVENBERG_MARQUARDT_OPT: {
-      vpMatrix LMA(LVJTLVJ.getRows(), LVJTLVJ.getCols());
-      LMA.eye();
-      vpMatrix LTLmuI = LVJTLVJ + (LMA * mu);
-      v = -m_lambda * LTLmuI.pseudoInverse(LTLmuI.getRows() * std::numeric_limits<double>::epsilon()) * LVJTR;
-      v = cVo * v;
-
-      if (iter != 0)
-        mu /= 10.0;
-
-      error_prev = error;
-      if (w != nullptr && m_w_prev != nullptr)
-        *m_w_prev = *w;
-      break;
+
+  computeVVSPoseUpdate(isoJoIdentity, iter, LTL, LTR, error, error_prev, mu, v, w, m_w_prev);
+}
+
+/*!
+  Solve the normal equations with the Gauss-Newton or the Levenberg-Marquardt method and compute the velocity
+  to apply to the current pose.
+*/
+void vpMbTracker::computeVVSPoseUpdate(const bool isoJoIdentity, unsigned int iter, const vpMatrix &LTL,
+                                       const vpColVector &LTR, const vpColVector &error, vpColVector &error_prev,
+                                       double &mu, vpColVector &v, const vpColVector *const w,
+                                       vpColVector *const m_w_prev)
+{
+  vpMbtVVSWorkspace &ws = m_vvsWorkspace;
+
+  ws.resize(ws.LTL_pinv, LTL.getRows(), LTL.getCols());
+  switch (m_optimizationMethod) {
+  case vpMbTracker::LEVENBERG_MARQUARDT_OPT: {
+    ws.resize(ws.LTLmuI, LTL.getRows(), LTL.getCols());
+    ws.LTLmuI = LTL;
+    for (unsigned int i = 0; i < ws.LTLmuI.getRows(); ++i) {
+      ws.LTLmuI[i][i] += mu;
     }
-    case vpMbTracker::GAUSS_NEWTON_OPT:
-    default:
-      v = -m_lambda * LVJTLVJ.pseudoInverse(LVJTLVJ.getRows() * std::numeric_limits<double>::epsilon()) * LVJTR;
-      v = cVo * v;
-      break;
+    ws.LTLmuI.pseudoInverse(ws.LTL_pinv, ws.LTLmuI.getRows() * std::numeric_limits<double>::epsilon());
+
+    if (iter != 0)
+      mu /= 10.0;
+
+    ws.resize(error_prev, error.getRows());
+    error_prev = error;
+    if (w != nullptr && m_w_prev != nullptr) {
+      ws.resize(*m_w_prev, w->getRows());
+      *m_w_prev = *w;
     }
+    break;
+  }
+
+  case vpMbTracker::GAUSS_NEWTON_OPT:
+  default:
+    LTL.pseudoInverse(ws.LTL_pinv, LTL.getRows() * std::numeric_limits<double>::epsilon());
+    break;
+  }
+
+  ws.LTL_pinv *= -m_lambda;
+  ws.resize(v, 6);
+  vpMatrix::multMatrixVector(ws.LTL_pinv, LTR, v);
+
+  if (!isoJoIdentity) {
+    v = ws.cVo * v;
   }
 }
 
@@ -3457,6 +3794,37 @@ void vpMbTracker::createCylinderBBox(const vpPoint &p1, const vpPoint &p2, const
   \param P1 : The first point to compare
   \param P2 : The second point to compare
 */
+/*!
+  Find the lines that join two points, with the same tolerance as samePoint().
+
+  \param index : Lines sorted by the X coordinate of their first extremity.
+  \param P1 : The first extremity.
+  \param P2 : The second extremity.
+  \param matches : Lines whose extremities are P1 and P2, in any order.
+*/
+void vpMbTracker::findLines(const std::multimap<double, vpMbtDistanceLine *> &index, const vpPoint &P1,
+                            const vpPoint &P2, std::vector<vpMbtDistanceLine *> &matches) const
+{
+  matches.clear();
+  const double eps = std::numeric_limits<double>::epsilon();
+  const double x1 = std::min<double>(P1.get_oX(), P2.get_oX()), x2 = std::max<double>(P1.get_oX(), P2.get_oX());
+
+  // The first extremity of a matching line is close to P1 or to P2 along X
+  const bool overlap = (x2 - eps) <= (x1 + eps);
+  const double ranges[2][2] = { { x1 - eps, overlap ? (x2 + eps) : (x1 + eps) }, { x2 - eps, x2 + eps } };
+  const unsigned int nbRanges = overlap ? 1 : 2;
+  for (unsigned int r = 0; r < nbRanges; ++r) {
+    std::multimap<double, vpMbtDistanceLine *>::const_iterator it = index.lower_bound(ranges[r][0]);
+    for (; (it != index.end()) && (it->first <= ranges[r][1]); ++it) {
+      const vpMbtDistanceLine *l = it->second;
+      if ((samePoint(*(l->p1), P1) && samePoint(*(l->p2), P2)) ||
+          (samePoint(*(l->p1), P2) && samePoint(*(l->p2), P1))) {
+        matches.push_back(it->second);
+      }
+    }
+  }
+}
+
 bool vpMbTracker::samePoint(const vpPoint &P1, const vpPoint &P2) const
 {
   double dx = fabs(P1.get_oX() - P2.get_oX());
@@ -3657,16 +4025,24 @@ void vpMbTracker::addProjectionErrorLine(vpPoint &P1, vpPoint &P2, int polygon,
   bool already_here = false;
   vpMbtDistanceLine *l;
 
-  for (std::vector<vpMbtDistanceLine *>::const_iterator it = m_projectionErrorLines.begin();
-       it != m_projectionErrorLines.end(); ++it) {
-    l = *it;
-    if ((samePoint(*(l->p1), P1) && samePoint(*(l->p2), P2)) || (samePoint(*(l->p1), P2) && samePoint(*(l->p2), P1))) {
-      already_here = true;
-      l->addPolygon(polygon);
-      l->hiddenface = &m_projectionErrorFaces;
+  // The index is rebuilt if the lines were modified without this function
+  if (m_projectionErrorLinesIndex.size() != m_projectionErrorLines.size()) {
+    m_projectionErrorLinesIndex.clear();
+    for (std::vector<vpMbtDistanceLine *>::const_iterator it = m_projectionErrorLines.begin();
+         it != m_projectionErrorLines.end(); ++it) {
+      m_projectionErrorLinesIndex.insert(std::make_pair((*it)->p1->get_oX(), *it));
     }
   }
 
+  std::vector<vpMbtDistanceLine *> matches;
+  findLines(m_projectionErrorLinesIndex, P1, P2, matches);
+  for (size_t i = 0; i < matches.size(); ++i) {
+    l = matches[i];
+    already_here = true;
+    l->addPolygon(polygon);
+    l->hiddenface = &m_projectionErrorFaces;
+  }
+
   if (!already_here) {
     l = new vpMbtDistanceLine;
 
@@ -3690,6 +4066,7 @@ void vpMbTracker::addProjectionErrorLine(vpPoint &P1, vpPoint &P2, int polygon,
       l->getPolygon().setFarClippingDistance(distFarClip);
 
     m_projectionErrorLines.push_back(l);
+    m_projectionErrorLinesIndex.insert(std::make_pair(l->p1->get_oX(), l));
   }
 }
 
@@ -0,0 +1,528 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2026 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bounding volume hierarchy over the polygons of a model-based tracker CAD model.
+ */
+
+#include <visp3/mbt/vpMbtBoundingVolumeHierarchy.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <visp3/core/vpMath.h>
+
+BEGIN_VISP_NAMESPACE
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Maximal number of polygons in a leaf
+const unsigned int g_leafSize = 4;
+// Angular margin in radian under which a facing decision is left to the per-polygon test
+const double g_angleMargin = 1e-6;
+// Relative margin under which a clipping decision is left to the per-polygon test
+const double g_distanceMargin = 1e-9;
+
+// Sort polygon indexes along an axis of their bounding sphere center
+class vpSphereCenterComparator
+{
+public:
+  vpSphereCenterComparator(const std::vector<double> &spheres, unsigned int axis) : m_spheres(spheres), m_axis(axis) { }
+  bool operator()(unsigned int a, unsigned int b) const
+  {
+    return m_spheres[(4 * a) + m_axis] < m_spheres[(4 * b) + m_axis];
+  }
+
+private:
+  const std::vector<double> &m_spheres;
+  unsigned int m_axis;
+};
+
+inline double dot(const double a[3], const double b[3]) { return (a[0] * b[0]) + (a[1] * b[1]) + (a[2] * b[2]); }
+}
+#endif
+
+/*!
+ * Default constructor, the hierarchy is empty.
+ */
+vpMbtBoundingVolumeHierarchy::vpMbtBoundingVolumeHierarchy()
+  : m_nodes(), m_order(), m_spheres(), m_normals(), m_hasNormal(), m_viewOffsets(), m_lastAngleAppears(0.),
+  m_lastAngleDisappears(0.), m_lastSafeDistance(0.), m_lastFacing()
+{
+  m_lastCameraPos[0] = m_lastCameraPos[1] = m_lastCameraPos[2] = 0.;
+  m_lastViewAxis[0] = m_lastViewAxis[1] = m_lastViewAxis[2] = 0.;
+}
+
+/*!
+ * Build the hierarchy from the object frame coordinates of the polygons. The index of a polygon in the results of
+ * computeFacing() and computeOutsideFrustum() is its index in \e polygons.
+ *
+ * \param polygons : Polygons of the model.
+ */
+void vpMbtBoundingVolumeHierarchy::build(const std::vector<const vpPolygon3D *> &polygons)
+{
+  clear();
+  const unsigned int nbPolygons = static_cast<unsigned int>(polygons.size());
+  m_spheres.resize(4 * nbPolygons);
+  m_normals.resize(3 * nbPolygons, 0.);
+  m_hasNormal.resize(nbPolygons, false);
+  m_viewOffsets.resize(nbPolygons, 0.);
+  m_order.resize(nbPolygons);
+  // Bounding box of each polygon, as (xmin, ymin, zmin, xmax, ymax, zmax)
+  std::vector<double> bounds(6 * nbPolygons, 0.);
+
+  for (unsigned int i = 0; i < nbPolygons; ++i) {
+    const vpPolygon3D &polygon = *polygons[i];
+    m_order[i] = i;
+    double *box = &bounds[6 * i];
+    double *sphere = &m_spheres[4 * i];
+    for (unsigned int k = 0; k < polygon.nbpt; ++k) {
+      const double X[3] = { polygon.p[k].get_oX(), polygon.p[k].get_oY(), polygon.p[k].get_oZ() };
+      for (unsigned int c = 0; c < 3; ++c) {
+        box[c] = (k == 0) ? X[c] : std::min<double>(box[c], X[c]);
+        box[c + 3] = (k == 0) ? X[c] : std::max<double>(box[c + 3], X[c]);
+      }
+    }
+    double radius = 0.;
+    for (unsigned int c = 0; c < 3; ++c) {
+      sphere[c] = 0.5 * (box[c] + box[c + 3]);
+    }
+    for (unsigned int k = 0; k < polygon.nbpt; ++k) {
+      radius = std::max<double>(radius, std::sqrt(vpMath::sqr(polygon.p[k].get_oX() - sphere[0]) +
+                                                  vpMath::sqr(polygon.p[k].get_oY() - sphere[1]) +
+                                                  vpMath::sqr(polygon.p[k].get_oZ() - sphere[2])));
+    }
+    sphere[3] = radius;
+
+    // Newell's method, as in vpMbtPolygon::isVisible()
+    if (polygon.nbpt > 2) {
+      m_viewOffsets[i] = 1. / polygon.nbpt;
+      double *normal = &m_normals[3 * i];
+      for (unsigned int k = 0; k < polygon.nbpt; ++k) {
+        const vpPoint &cur = polygon.p[k];
+        const vpPoint &next = polygon.p[(k + 1) % polygon.nbpt];
+        normal[0] += (cur.get_oY() - next.get_oY()) * (cur.get_oZ() + next.get_oZ());
+        normal[1] += (cur.get_oZ() - next.get_oZ()) * (cur.get_oX() + next.get_oX());
+        normal[2] += (cur.get_oX() - next.get_oX()) * (cur.get_oY() + next.get_oY());
+      }
+      const double norm = std::sqrt(dot(normal, normal));
+      // The normal of a polygon with aligned points is left to the per-polygon test
+      if ((norm > (std::numeric_limits<double>::epsilon() * radius * radius)) && vpMath::isFinite(norm)) {
+        normal[0] /= norm;
+        normal[1] /= norm;
+        normal[2] /= norm;
+        m_hasNormal[i] = true;
+      }
+    }
+  }
+
+  if (nbPolygons > 0) {
+    m_nodes.reserve((2 * nbPolygons) / g_leafSize + 1);
+    buildNode(0, nbPolygons, bounds);
+  }
+}
+
+/*!
+ * Remove all the polygons.
+ */
+void vpMbtBoundingVolumeHierarchy::clear()
+{
+  m_nodes.clear();
+  m_order.clear();
+  m_spheres.clear();
+  m_normals.clear();
+  m_hasNormal.clear();
+  m_viewOffsets.clear();
+  m_lastFacing.clear();
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+int vpMbtBoundingVolumeHierarchy::buildNode(unsigned int first, unsigned int count, const std::vector<double> &bounds)
+{
+  vpNode node;
+  node.m_first = first;
+  node.m_count = count;
+  node.m_left = -1;
+  node.m_right = -1;
+
+  // Bounding sphere from the bounding box of the polygons
+  double box[6], centers[6];
+  for (unsigned int c = 0; c < 3; ++c) {
+    box[c] = centers[c] = std::numeric_limits<double>::max();
+    box[c + 3] = centers[c + 3] = -std::numeric_limits<double>::max();
+  }
+  for (unsigned int i = first; i < first + count; ++i) {
+    const unsigned int id = m_order[i];
+    for (unsigned int c = 0; c < 3; ++c) {
+      const double center = m_spheres[(4 * id) + c];
+      box[c] = std::min<double>(box[c], bounds[(6 * id) + c]);
+      box[c + 3] = std::max<double>(box[c + 3], bounds[(6 * id) + c + 3]);
+      centers[c] = std::min<double>(centers[c], center);
+      centers[c + 3] = std::max<double>(centers[c + 3], center);
+    }
+  }
+  node.m_sphere[3] = 0.;
+  for (unsigned int c = 0; c < 3; ++c) {
+    node.m_sphere[c] = 0.5 * (box[c] + box[c + 3]);
+  }
+  for (unsigned int i = first; i < first + count; ++i) {
+    const double *sphere = &m_spheres[4 * m_order[i]];
+    node.m_sphere[3] = std::max<double>(node.m_sphere[3], std::sqrt(vpMath::sqr(sphere[0] - node.m_sphere[0]) +
+                                                                    vpMath::sqr(sphere[1] - node.m_sphere[1]) +
+                                                                    vpMath::sqr(sphere[2] - node.m_sphere[2])) +
+                                        sphere[3]);
+  }
+
+  // Cone of the normals
+  node.m_axis[0] = node.m_axis[1] = node.m_axis[2] = 0.;
+  node.m_viewOffset[0] = node.m_viewOffset[1] = 0.;
+  unsigned int nbNormals = 0;
+  for (unsigned int i = first; i < first + count; ++i) {
+    const unsigned int id = m_order[i];
+    if (m_hasNormal[id]) {
+      for (unsigned int c = 0; c < 3; ++c) {
+        node.m_axis[c] += m_normals[(3 * id) + c];
+      }
+      const double offset = m_viewOffsets[id];
+      node.m_viewOffset[0] = (nbNormals == 0) ? offset : std::min<double>(node.m_viewOffset[0], offset);
+      node.m_viewOffset[1] = (nbNormals == 0) ? offset : std::max<double>(node.m_viewOffset[1], offset);
+      ++nbNormals;
+    }
+  }
+  const double axisNorm = std::sqrt(dot(node.m_axis, node.m_axis));
+  if (nbNormals == 0) {
+    node.m_coneAngle = -1.;
+  }
+  else if (axisNorm <= (std::numeric_limits<double>::epsilon() * nbNormals)) {
+    // Opposite normals, the cone contains all the directions
+    node.m_axis[0] = 1.;
+    node.m_axis[1] = node.m_axis[2] = 0.;
+    node.m_coneAngle = M_PI;
+  }
+  else {
+    node.m_coneAngle = 0.;
+    for (unsigned int c = 0; c < 3; ++c) {
+      node.m_axis[c] /= axisNorm;
+    }
+    for (unsigned int i = first; i < first + count; ++i) {
+      const unsigned int id = m_order[i];
+      if (m_hasNormal[id]) {
+        const double cosAngle = std::max<double>(-1., std::min<double>(1., dot(node.m_axis, &m_normals[3 * id])));
+        node.m_coneAngle = std::max<double>(node.m_coneAngle, std::acos(cosAngle));
+      }
+    }
+  }
+
+  const int nodeId = static_cast<int>(m_nodes.size());
+  m_nodes.push_back(node);
+
+  if (count > g_leafSize) {
+    // Median split along the largest extent of the polygon centers
+    unsigned int axis = 0;
+    for (unsigned int c = 1; c < 3; ++c) {
+      if ((centers[c + 3] - centers[c]) > (centers[axis + 3] - centers[axis])) {
+        axis = c;
+      }
+    }
+    const unsigned int half = count / 2;
+    std::nth_element(m_order.begin() + first, m_order.begin() + first + half, m_order.begin() + first + count,
+                     vpSphereCenterComparator(m_spheres, axis));
+    const int left = buildNode(first, half, bounds);
+    const int right = buildNode(first + half, count - half, bounds);
+    m_nodes[static_cast<size_t>(nodeId)].m_left = left;
+    m_nodes[static_cast<size_t>(nodeId)].m_right = right;
+  }
+
+  return nodeId;
+}
+#endif
+
+/*!
+ * Classify the polygons as back-facing, front-facing or undetermined with respect to the camera, using the same
+ * criterion as vpMbtPolygon::isVisible(): a polygon is front-facing when the angle between its normal and the
+ * direction from its center to its viewpoint is smaller than both \e angleAppears and \e angleDisappears, and
+ * back-facing when this angle is larger than both of them plus one degree, so that a back-facing polygon is neither
+ * visible nor appearing in the sense of vpMbtPolygon::isAppearing(). The polygons without orientation (less than
+ * three points or aligned points) are always undetermined.
+ *
+ * As in vpMbtPolygon::isVisible(), the viewpoint of a polygon with \f$n\f$ points is located \f$1/n\f$ meter behind
+ * the optical center, along the optical axis.
+ *
+ * \param cMo : Pose of the camera.
+ * \param angleAppears : Angle used to test the appearance of a face.
+ * \param angleDisappears : Angle used to test the disappearance of a face.
+ * \param facing : Classification of each polygon, as a vpFacingType.
+ */
+void vpMbtBoundingVolumeHierarchy::computeFacing(const vpHomogeneousMatrix &cMo, double angleAppears,
+                                                 double angleDisappears, std::vector<unsigned char> &facing)
+{
+  // Camera position in the object frame: -R^T t, and optical axis: third row of R
+  double cameraPos[3], viewAxis[3];
+  for (unsigned int c = 0; c < 3; ++c) {
+    cameraPos[c] = -((cMo[0][c] * cMo[0][3]) + (cMo[1][c] * cMo[1][3]) + (cMo[2][c] * cMo[2][3]));
+    viewAxis[c] = cMo[2][c];
+  }
+
+  // The viewpoints are at most 1/3 meter behind the camera: they move by less than this distance
+  const unsigned int nbPolygons = getNbPolygons();
+  const double moved = std::sqrt(vpMath::sqr(cameraPos[0] - m_lastCameraPos[0]) +
+                                 vpMath::sqr(cameraPos[1] - m_lastCameraPos[1]) +
+                                 vpMath::sqr(cameraPos[2] - m_lastCameraPos[2])) +
+    (std::sqrt(vpMath::sqr(viewAxis[0] - m_lastViewAxis[0]) + vpMath::sqr(viewAxis[1] - m_lastViewAxis[1]) +
+               vpMath::sqr(viewAxis[2] - m_lastViewAxis[2])) / 3.);
+  if ((m_lastFacing.size() == nbPolygons) && (nbPolygons > 0) && (moved < m_lastSafeDistance) &&
+      (angleAppears == m_lastAngleAppears) && (angleDisappears == m_lastAngleDisappears)) {
+    facing = m_lastFacing;
+    return;
+  }
+
+  facing.assign(nbPolygons, static_cast<unsigned char>(UNDETERMINED));
+  m_lastFacing.clear();
+  if (nbPolygons == 0) {
+    return;
+  }
+
+  // The undetermined polygons may become decidable when the camera moves: the classification is not reused once the
+  // camera moved by more than a small fraction of its distance to the model
+  const vpNode &root = m_nodes[0];
+  double safeDistance = 0.01 * std::sqrt(vpMath::sqr(cameraPos[0] - root.m_sphere[0]) +
+                                         vpMath::sqr(cameraPos[1] - root.m_sphere[1]) +
+                                         vpMath::sqr(cameraPos[2] - root.m_sphere[2]));
+  // A polygon is appearing when the angle is smaller than the angle used to test its visibility plus one degree
+  computeFacing(0, cameraPos, viewAxis, std::min<double>(angleAppears, angleDisappears),
+                std::max<double>(angleAppears, angleDisappears) + vpMath::rad(1), facing, safeDistance);
+
+  m_lastFacing = facing;
+  m_lastSafeDistance = safeDistance;
+  m_lastAngleAppears = angleAppears;
+  m_lastAngleDisappears = angleDisappears;
+  for (unsigned int c = 0; c < 3; ++c) {
+    m_lastCameraPos[c] = cameraPos[c];
+    m_lastViewAxis[c] = viewAxis[c];
+  }
+}
+
+/*!
+ * Find the polygons that are entirely outside one of the clipping planes, using the same criteria as
+ * vpPolygon3D::computePolygonClipped(): the clipped polygon of these polygons is empty. A polygon that is not
+ * reported as outside may still be clipped away.
+ *
+ * \param cMo : Pose of the camera.
+ * \param cam : Camera parameters. The field of view clipping planes are only used when the field of view has been
+ * computed, see vpCameraParameters::computeFov().
+ * \param clippingFlag : Clipping flags, see vpPolygon3D::vpPolygon3DClippingType.
+ * \param distNearClip : Distance of the near clipping plane.
+ * \param distFarClip : Distance of the far clipping plane.
+ * \param outside : True for each polygon that is entirely outside one of the clipping planes.
+ */
+void vpMbtBoundingVolumeHierarchy::computeOutsideFrustum(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam,
+                                                         unsigned int clippingFlag, double distNearClip,
+                                                         double distFarClip, std::vector<bool> &outside) const
+{
+  outside.assign(getNbPolygons(), false);
+  if ((clippingFlag == vpPolygon3D::NO_CLIPPING) || m_nodes.empty()) {
+    return;
+  }
+
+  // Planes given in the camera frame as (n, d), a point X being outside when n.X + d > 0
+  std::vector<double> cameraPlanes;
+  if (((clippingFlag & vpPolygon3D::NEAR_CLIPPING) == vpPolygon3D::NEAR_CLIPPING) ||
+      (clippingFlag > vpPolygon3D::FAR_CLIPPING)) {
+    const double plane[4] = { 0., 0., -1., distNearClip };
+    cameraPlanes.insert(cameraPlanes.end(), plane, plane + 4);
+  }
+  if ((clippingFlag & vpPolygon3D::FAR_CLIPPING) == vpPolygon3D::FAR_CLIPPING) {
+    const double plane[4] = { 0., 0., 1., -distFarClip };
+    cameraPlanes.insert(cameraPlanes.end(), plane, plane + 4);
+  }
+  if (cam.isFovComputed()) {
+    const std::vector<vpColVector> &fovNormals = cam.getFovNormals();
+    const unsigned int fovFlags[4] = { vpPolygon3D::LEFT_CLIPPING, vpPolygon3D::RIGHT_CLIPPING,
+                                      vpPolygon3D::UP_CLIPPING, vpPolygon3D::DOWN_CLIPPING };
+    for (unsigned int k = 0; (k < 4) && (k < fovNormals.size()); ++k) {
+      if ((clippingFlag & fovFlags[k]) == fovFlags[k]) {
+        const double plane[4] = { fovNormals[k][0], fovNormals[k][1], fovNormals[k][2], 0. };
+        cameraPlanes.insert(cameraPlanes.end(), plane, plane + 4);
+      }
+    }
+  }
+  if (cameraPlanes.empty()) {
+    return;
+  }
+
+  // Planes in the object frame: (R^T n, n.t + d), with the norm of n as fifth element
+  std::vector<double> planes;
+  for (size_t k = 0; k < cameraPlanes.size(); k += 4) {
+    const double *n = &cameraPlanes[k];
+    double plane[5];
+    for (unsigned int c = 0; c < 3; ++c) {
+      plane[c] = (cMo[0][c] * n[0]) + (cMo[1][c] * n[1]) + (cMo[2][c] * n[2]);
+    }
+    plane[3] = (n[0] * cMo[0][3]) + (n[1] * cMo[1][3]) + (n[2] * cMo[2][3]) + n[3];
+    plane[4] = std::sqrt(dot(n, n));
+    planes.insert(planes.end(), plane, plane + 5);
+  }
+
+  computeOutsideFrustum(0, planes, outside);
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+void vpMbtBoundingVolumeHierarchy::computeFacing(int nodeId, const double cameraPos[3], const double viewAxis[3],
+                                                 double angleMin, double angleMax, std::vector<unsigned char> &facing,
+                                                 double &safeDistance) const
+{
+  const vpNode &node = m_nodes[static_cast<size_t>(nodeId)];
+  if (node.m_coneAngle < 0.) {
+    return;
+  }
+
+  // The viewpoints of the polygons of the node are in a ball centered on the viewpoint of the mean offset
+  const double offset = 0.5 * (node.m_viewOffset[0] + node.m_viewOffset[1]);
+  const double viewpoint[3] = { cameraPos[0] - (offset * viewAxis[0]), cameraPos[1] - (offset * viewAxis[1]),
+                               cameraPos[2] - (offset * viewAxis[2]) };
+  const vpFacingType type = facingOf(node.m_sphere, node.m_axis, node.m_coneAngle, viewpoint,
+                                     0.5 * (node.m_viewOffset[1] - node.m_viewOffset[0]), angleMin, angleMax,
+                                     safeDistance);
+  if (type != UNDETERMINED) {
+    setRange(node, type, facing);
+  }
+  else if (node.m_left < 0) {
+    for (unsigned int i = node.m_first; i < node.m_first + node.m_count; ++i) {
+      const unsigned int id = m_order[i];
+      if (m_hasNormal[id]) {
+        const double polygonViewpoint[3] = { cameraPos[0] - (m_viewOffsets[id] * viewAxis[0]),
+                                            cameraPos[1] - (m_viewOffsets[id] * viewAxis[1]),
+                                            cameraPos[2] - (m_viewOffsets[id] * viewAxis[2]) };
+        facing[id] = static_cast<unsigned char>(facingOf(&m_spheres[4 * id], &m_normals[3 * id], 0., polygonViewpoint,
+                                                         0., angleMin, angleMax, safeDistance));
+      }
+    }
+  }
+  else {
+    computeFacing(node.m_left, cameraPos, viewAxis, angleMin, angleMax, facing, safeDistance);
+    computeFacing(node.m_right, cameraPos, viewAxis, angleMin, angleMax, facing, safeDistance);
+  }
+}
+
+void vpMbtBoundingVolumeHierarchy::computeOutsideFrustum(int nodeId, const std::vector<double> &planes,
+                                                         std::vector<bool> &outside) const
+{
+  const vpNode &node = m_nodes[static_cast<size_t>(nodeId)];
+  if (isOutsideOf(node.m_sphere, planes)) {
+    for (unsigned int i = node.m_first; i < node.m_first + node.m_count; ++i) {
+      outside[m_order[i]] = true;
+    }
+    return;
+  }
+
+  // Nothing to cull if the sphere is inside all the planes
+  bool inside = true;
+  for (size_t k = 0; (k < planes.size()) && inside; k += 5) {
+    inside = ((dot(&planes[k], node.m_sphere) + planes[k + 3]) < -(node.m_sphere[3] * planes[k + 4]));
+  }
+  if (inside) {
+    return;
+  }
+
+  if (node.m_left < 0) {
+    for (unsigned int i = node.m_first; i < node.m_first + node.m_count; ++i) {
+      const unsigned int id = m_order[i];
+      outside[id] = isOutsideOf(&m_spheres[4 * id], planes);
+    }
+  }
+  else {
+    computeOutsideFrustum(node.m_left, planes, outside);
+    computeOutsideFrustum(node.m_right, planes, outside);
+  }
+}
+
+vpMbtBoundingVolumeHierarchy::vpFacingType
+vpMbtBoundingVolumeHierarchy::facingOf(const double sphere[4], const double axis[3], double coneAngle,
+                                       const double viewpoint[3], double viewpointRadius, double angleMin,
+                                       double angleMax, double &safeDistance) const
+{
+  // A direction from a point of the sphere to a point of the ball of the viewpoints is a direction from a point of
+  // the sphere grown by the radius of the ball to its center
+  const double radius = sphere[3] + viewpointRadius;
+  const double v[3] = { viewpoint[0] - sphere[0], viewpoint[1] - sphere[1], viewpoint[2] - sphere[2] };
+  const double d = std::sqrt(dot(v, v));
+  if (d <= radius) {
+    return UNDETERMINED;
+  }
+
+  // Bounds of the angle between the normal of a polygon of the sphere and the direction from its center to the
+  // camera
+  const double beta = std::acos(std::max<double>(-1., std::min<double>(1., dot(axis, v) / d)));
+  const double delta = std::asin(radius / d);
+  const double angleLow = beta - coneAngle - delta;
+  const double angleHigh = beta + coneAngle + delta;
+
+  double margin = 0.;
+  vpFacingType type = UNDETERMINED;
+  if (angleLow >= (angleMax + g_angleMargin)) {
+    margin = angleLow - angleMax;
+    type = BACK_FACING;
+  }
+  else if (angleHigh < (angleMin - g_angleMargin)) {
+    margin = angleMin - angleHigh;
+    type = FRONT_FACING;
+  }
+
+  if (type != UNDETERMINED) {
+    // When the viewpoints move by less than (d - r) sin(margin), the line of sight of each polygon rotates by less
+    // than the margin
+    safeDistance = std::min<double>(safeDistance, (d - radius) * std::sin(std::min<double>(margin, M_PI_2)));
+  }
+  return type;
+}
+
+bool vpMbtBoundingVolumeHierarchy::isOutsideOf(const double sphere[4], const std::vector<double> &planes) const
+{
+  for (size_t k = 0; k < planes.size(); k += 5) {
+    const double distance = dot(&planes[k], sphere) + planes[k + 3];
+    if ((distance - (sphere[3] * planes[k + 4])) > (g_distanceMargin * (1. + std::fabs(distance) + sphere[3]))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void vpMbtBoundingVolumeHierarchy::setRange(const vpNode &node, vpFacingType type,
+                                            std::vector<unsigned char> &facing) const
+{
+  for (unsigned int i = node.m_first; i < node.m_first + node.m_count; ++i) {
+    const unsigned int id = m_order[i];
+    if (m_hasNormal[id]) {
+      facing[id] = static_cast<unsigned char>(type);
+    }
+  }
+}
+#endif
+END_VISP_NAMESPACE
@@ -0,0 +1,631 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Compiled representation of a model-based tracker CAD model.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/mbt/vpMbtCompiledModel.h>
+
+BEGIN_VISP_NAMESPACE
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+const char g_magic[8] = { 'V', 'P', 'M', 'B', 'T', 'C', 'M', '\0' };
+const uint32_t g_byteOrderMark = 0x01020304;
+
+template <typename Type> void writeValue(std::vector<char> &buffer, const Type &value)
+{
+  const char *ptr = reinterpret_cast<const char *>(&value);
+  buffer.insert(buffer.end(), ptr, ptr + sizeof(Type));
+}
+
+template <typename Type> void writeArray(std::vector<char> &buffer, const std::vector<Type> &values)
+{
+  writeValue(buffer, static_cast<uint32_t>(values.size()));
+  if (!values.empty()) {
+    const char *ptr = reinterpret_cast<const char *>(&values[0]);
+    buffer.insert(buffer.end(), ptr, ptr + (values.size() * sizeof(Type)));
+  }
+}
+
+void writeString(std::vector<char> &buffer, const std::string &str)
+{
+  writeValue(buffer, static_cast<uint32_t>(str.size()));
+  buffer.insert(buffer.end(), str.begin(), str.end());
+}
+
+/*!
+ * Bounds-checked reader on the content of a compiled model file.
+ */
+class vpBufferReader
+{
+public:
+  vpBufferReader(const std::vector<char> &buffer, size_t pos) : m_buffer(buffer), m_pos(pos) { }
+
+  template <typename Type> bool read(Type &value)
+  {
+    if ((m_buffer.size() - m_pos) < sizeof(Type)) {
+      return false;
+    }
+    memcpy(&value, &m_buffer[m_pos], sizeof(Type));
+    m_pos += sizeof(Type);
+    return true;
+  }
+
+  template <typename Type> bool readArray(std::vector<Type> &values)
+  {
+    uint32_t size;
+    if (!read(size) || (((m_buffer.size() - m_pos) / sizeof(Type)) < size)) {
+      return false;
+    }
+    values.resize(size);
+    if (size > 0) {
+      memcpy(&values[0], &m_buffer[m_pos], size * sizeof(Type));
+      m_pos += size * sizeof(Type);
+    }
+    return true;
+  }
+
+  bool readString(std::string &str)
+  {
+    uint32_t size;
+    if (!read(size) || ((m_buffer.size() - m_pos) < size)) {
+      return false;
+    }
+    str.assign(m_buffer.begin() + m_pos, m_buffer.begin() + m_pos + size);
+    m_pos += size;
+    return true;
+  }
+
+  size_t getPosition() const { return m_pos; }
+
+private:
+  const std::vector<char> &m_buffer;
+  size_t m_pos;
+};
+
+bool lessPoint(const double *p1, const double *p2)
+{
+  return std::lexicographical_compare(p1, p1 + 3, p2, p2 + 3);
+}
+}
+
+const uint32_t vpMbtCompiledModel::formatVersion = 1;
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+ * Default constructor. The model is empty.
+ */
+vpMbtCompiledModel::vpMbtCompiledModel()
+  : m_points(), m_primitives(), m_indices(), m_sources(), m_od_M_o(), m_weldedPoints(), m_edges(),
+  m_primitiveEdgesOffsets(), m_primitiveEdges(), m_edgeFacesOffsets(), m_edgeFaces(), m_normals()
+{
+  std::fill(m_statistics, m_statistics + 6, 0u);
+}
+
+/*!
+ * Add a point to the model.
+ *
+ * \param oX, oY, oZ : Coordinates of the point in the object frame.
+ * \return Index of the point.
+ */
+unsigned int vpMbtCompiledModel::addPoint(double oX, double oY, double oZ)
+{
+  m_points.push_back(oX);
+  m_points.push_back(oY);
+  m_points.push_back(oZ);
+  return getNbPoints() - 1;
+}
+
+/*!
+ * Add a primitive at the end of the list of primitives.
+ *
+ * \param type : Type of the primitive.
+ * \param idFace : Index of the first face of the primitive, relative to the model.
+ * \param indices : Indexes of the points of the primitive. Faces described by a list of segments give the two
+ * extremities of each segment. Cylinders give the two points on their axis and circles their center followed by two
+ * points on their plane.
+ * \param radius : Radius of a cylinder or of a circle, unused for the other primitives.
+ * \param name : Name of the primitive.
+ * \param parameters : Combination of vpParameterFlag telling which of the next parameters are given.
+ * \param useLod : Value of the \c useLod parameter.
+ * \param minPolygonAreaThreshold : Value of the \c minPolygonAreaThreshold parameter.
+ * \param minLineLengthThreshold : Value of the \c minLineLengthThreshold parameter.
+ */
+void vpMbtCompiledModel::addPrimitive(vpPrimitiveType type, int idFace, const std::vector<unsigned int> &indices,
+                                      double radius, const std::string &name, unsigned int parameters, bool useLod,
+                                      double minPolygonAreaThreshold, double minLineLengthThreshold)
+{
+  vpPrimitive primitive;
+  primitive.m_type = type;
+  primitive.m_idFace = idFace;
+  primitive.m_firstIndex = static_cast<unsigned int>(m_indices.size());
+  primitive.m_nbIndices = static_cast<unsigned int>(indices.size());
+  primitive.m_radius = radius;
+  primitive.m_parameters = parameters;
+  primitive.m_useLod = useLod;
+  primitive.m_minPolygonAreaThreshold = minPolygonAreaThreshold;
+  primitive.m_minLineLengthThreshold = minLineLengthThreshold;
+  primitive.m_name = name;
+  m_primitives.push_back(primitive);
+  m_indices.insert(m_indices.end(), indices.begin(), indices.end());
+}
+
+/*!
+ * Add a source file of the model. Its size and CRC-32 are computed and stored in the compiled model to check
+ * later if the file was modified.
+ *
+ * \param filename : Path to the source file.
+ *
+ * \exception vpException::ioError : If the file cannot be read.
+ */
+void vpMbtCompiledModel::addSource(const std::string &filename)
+{
+  for (size_t i = 0; i < m_sources.size(); ++i) {
+    if (m_sources[i].m_filename == filename) {
+      return;
+    }
+  }
+
+  vpSource source;
+  source.m_filename = filename;
+  if (!computeChecksum(filename, source.m_size, source.m_crc)) {
+    throw vpException(vpException::ioError, "Cannot read model file %s", filename.c_str());
+  }
+  m_sources.push_back(source);
+}
+
+/*!
+ * Remove all the points, primitives and source files of the model.
+ */
+void vpMbtCompiledModel::clear()
+{
+  m_points.clear();
+  m_primitives.clear();
+  m_indices.clear();
+  m_sources.clear();
+  m_od_M_o.eye();
+  std::fill(m_statistics, m_statistics + 6, 0u);
+  m_weldedPoints.clear();
+  m_edges.clear();
+  m_primitiveEdgesOffsets.clear();
+  m_primitiveEdges.clear();
+  m_edgeFacesOffsets.clear();
+  m_edgeFaces.clear();
+  m_normals.clear();
+}
+
+/*!
+ * Compute the topology of the model from its primitives:
+ * - the points with exactly the same coordinates are welded,
+ * - the segments of the faces and the single segments are deduplicated, taking into account that the tracker
+ *   ignores consecutive duplicated points of a face,
+ * - the faces and segments that share each unique segment are listed,
+ * - the normal of each face is computed with the Newell method, following the order of its points.
+ */
+void vpMbtCompiledModel::computeTopology()
+{
+  const unsigned int nbPoints = getNbPoints();
+  const unsigned int nbPrimitives = static_cast<unsigned int>(m_primitives.size());
+
+  // Weld the points that have the same coordinates to the first one
+  std::vector<unsigned int> order(nbPoints);
+  for (unsigned int i = 0; i < nbPoints; ++i) {
+    order[i] = i;
+  }
+  const double *points = m_points.empty() ? nullptr : &m_points[0];
+  std::stable_sort(order.begin(), order.end(), [points](unsigned int a, unsigned int b) {
+    return lessPoint(points + (3 * a), points + (3 * b));
+  });
+  m_weldedPoints.resize(nbPoints);
+  for (unsigned int i = 0; i < nbPoints; ++i) {
+    const bool sameAsPrevious = (i > 0) && !lessPoint(points + (3 * order[i - 1]), points + (3 * order[i]));
+    m_weldedPoints[order[i]] = sameAsPrevious ? m_weldedPoints[order[i - 1]] : order[i];
+  }
+
+  // Unique segments and their adjacent primitives
+  std::map<std::pair<unsigned int, unsigned int>, unsigned int> edgesMap;
+  std::vector<std::vector<unsigned int> > edgeFaces;
+  m_edges.clear();
+  m_primitiveEdges.clear();
+  m_primitiveEdgesOffsets.assign(1, 0);
+  m_normals.assign(3 * nbPrimitives, 0.);
+  for (unsigned int i = 0; i < nbPrimitives; ++i) {
+    const vpPrimitive &primitive = m_primitives[i];
+    if ((primitive.m_type == POLYGON_FROM_LINES) || (primitive.m_type == POLYGON_FROM_POINTS) ||
+        (primitive.m_type == SEGMENT)) {
+      std::vector<unsigned int> corners;
+      for (unsigned int j = 0; j < primitive.m_nbIndices; ++j) {
+        const unsigned int index = m_weldedPoints[m_indices[primitive.m_firstIndex + j]];
+        if (corners.empty() || (corners.back() != index)) {
+          corners.push_back(index);
+        }
+      }
+      const bool closed = (primitive.m_type != POLYGON_FROM_LINES);
+      const size_t nbSegments = closed ? corners.size() : (corners.empty() ? 0 : corners.size() - 1);
+      for (size_t j = 0; j < nbSegments; ++j) {
+        const unsigned int p1 = corners[j], p2 = corners[(j + 1) % corners.size()];
+        if (p1 == p2) {
+          continue;
+        }
+        const std::pair<unsigned int, unsigned int> key(std::min(p1, p2), std::max(p1, p2));
+        std::map<std::pair<unsigned int, unsigned int>, unsigned int>::const_iterator it = edgesMap.find(key);
+        unsigned int edge;
+        if (it == edgesMap.end()) {
+          edge = getNbEdges();
+          edgesMap[key] = edge;
+          m_edges.push_back(key.first);
+          m_edges.push_back(key.second);
+          edgeFaces.push_back(std::vector<unsigned int>());
+        }
+        else {
+          edge = it->second;
+        }
+        if (edgeFaces[edge].empty() || (edgeFaces[edge].back() != i)) {
+          edgeFaces[edge].push_back(i);
+          m_primitiveEdges.push_back(edge);
+        }
+      }
+
+      if ((primitive.m_type != SEGMENT) && (corners.size() > 2)) {
+        double *normal = &m_normals[3 * i];
+        for (size_t j = 0; j < corners.size(); ++j) {
+          const double *p1 = points + (3 * corners[j]), *p2 = points + (3 * corners[(j + 1) % corners.size()]);
+          normal[0] += (p1[1] - p2[1]) * (p1[2] + p2[2]);
+          normal[1] += (p1[2] - p2[2]) * (p1[0] + p2[0]);
+          normal[2] += (p1[0] - p2[0]) * (p1[1] + p2[1]);
+        }
+        const double norm = std::sqrt((normal[0] * normal[0]) + (normal[1] * normal[1]) + (normal[2] * normal[2]));
+        if (norm > std::numeric_limits<double>::epsilon()) {
+          normal[0] /= norm;
+          normal[1] /= norm;
+          normal[2] /= norm;
+        }
+      }
+    }
+    m_primitiveEdgesOffsets.push_back(static_cast<unsigned int>(m_primitiveEdges.size()));
+  }
+
+  m_edgeFacesOffsets.assign(1, 0);
+  m_edgeFaces.clear();
+  for (size_t i = 0; i < edgeFaces.size(); ++i) {
+    m_edgeFaces.insert(m_edgeFaces.end(), edgeFaces[i].begin(), edgeFaces[i].end());
+    m_edgeFacesOffsets.push_back(static_cast<unsigned int>(m_edgeFaces.size()));
+  }
+}
+
+/*!
+ * Return the unit normal of a face computed by computeTopology(), or a null vector if the primitive is not a face
+ * or if the face is degenerated.
+ *
+ * \param primitive : Index of the primitive in getPrimitives().
+ */
+vpColVector vpMbtCompiledModel::getNormal(unsigned int primitive) const
+{
+  vpColVector normal(3, 0.);
+  if ((3 * primitive) < m_normals.size()) {
+    for (unsigned int i = 0; i < 3; ++i) {
+      normal[i] = m_normals[(3 * primitive) + i];
+    }
+  }
+  return normal;
+}
+
+/*!
+ * Return a point of the model.
+ *
+ * \param index : Index of the point in [0, getNbPoints()-1].
+ */
+vpPoint vpMbtCompiledModel::getPoint(unsigned int index) const
+{
+  vpPoint P;
+  P.setWorldCoordinates(m_points[3 * index], m_points[(3 * index) + 1], m_points[(3 * index) + 2]);
+  return P;
+}
+
+/*!
+ * Return the unique segments of a primitive computed by computeTopology(), in the order they are added to the
+ * tracker.
+ *
+ * \param primitive : Index of the primitive in getPrimitives().
+ */
+std::vector<unsigned int> vpMbtCompiledModel::getPrimitiveEdges(unsigned int primitive) const
+{
+  if ((primitive + 1) >= m_primitiveEdgesOffsets.size()) {
+    return std::vector<unsigned int>();
+  }
+  return std::vector<unsigned int>(m_primitiveEdges.begin() + m_primitiveEdgesOffsets[primitive],
+                                   m_primitiveEdges.begin() + m_primitiveEdgesOffsets[primitive + 1]);
+}
+
+/*!
+ * Get the statistics printed by vpMbTracker when the model is loaded.
+ */
+void vpMbtCompiledModel::getStatistics(unsigned int &nbPoints, unsigned int &nbLines, unsigned int &nbPolygonLines,
+                                       unsigned int &nbPolygonPoints, unsigned int &nbCylinders,
+                                       unsigned int &nbCircles) const
+{
+  nbPoints = m_statistics[0];
+  nbLines = m_statistics[1];
+  nbPolygonLines = m_statistics[2];
+  nbPolygonPoints = m_statistics[3];
+  nbCylinders = m_statistics[4];
+  nbCircles = m_statistics[5];
+}
+
+/*!
+ * Check if the compiled model matches its source files and the transformation applied to the model points.
+ *
+ * \param od_M_o : Transformation that would be applied to the points of the model file.
+ * \return true if the model has at least one source file, none of the source files changed and the transformation
+ * is the same as the one used to compile the model.
+ */
+bool vpMbtCompiledModel::isUpToDate(const vpHomogeneousMatrix &od_M_o) const
+{
+  if (m_sources.empty()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < 4; ++i) {
+    for (unsigned int j = 0; j < 4; ++j) {
+      if (!vpMath::equal(od_M_o[i][j], m_od_M_o[i][j], std::numeric_limits<double>::epsilon())) {
+        return false;
+      }
+    }
+  }
+  for (size_t i = 0; i < m_sources.size(); ++i) {
+    uint64_t size;
+    uint32_t crc;
+    if ((!computeChecksum(m_sources[i].m_filename, size, crc)) || (size != m_sources[i].m_size) ||
+        (crc != m_sources[i].m_crc)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*!
+ * Load a compiled model saved with save().
+ *
+ * \param filename : Path to the compiled model file.
+ * \return false if the file does not exist, was written with another version of the format or on a machine with
+ * another byte order, or is corrupted. In that case the model is cleared.
+ */
+bool vpMbtCompiledModel::load(const std::string &filename)
+{
+  clear();
+
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+  file.seekg(0, std::ios::end);
+  const std::streamoff fileSize = file.tellg();
+  file.seekg(0, std::ios::beg);
+  if (fileSize < static_cast<std::streamoff>(sizeof(g_magic) + (3 * sizeof(uint32_t)))) {
+    return false;
+  }
+  std::vector<char> buffer(static_cast<size_t>(fileSize));
+  if (!file.read(&buffer[0], fileSize)) {
+    return false;
+  }
+
+  // Header
+  vpBufferReader reader(buffer, 0);
+  char magic[sizeof(g_magic)];
+  uint32_t version = 0, byteOrderMark = 0;
+  for (size_t i = 0; i < sizeof(g_magic); ++i) {
+    reader.read(magic[i]);
+  }
+  reader.read(version);
+  reader.read(byteOrderMark);
+  if ((memcmp(magic, g_magic, sizeof(g_magic)) != 0) || (version != formatVersion) ||
+      (byteOrderMark != g_byteOrderMark)) {
+    return false;
+  }
+
+  // The last 4 bytes are the CRC-32 of the content that follows the header
+  uint32_t crc;
+  const size_t contentStart = reader.getPosition();
+  memcpy(&crc, &buffer[buffer.size() - sizeof(uint32_t)], sizeof(uint32_t));
+  if (visp::vp_mz_crc32(0, reinterpret_cast<const unsigned char *>(&buffer[contentStart]),
+                        buffer.size() - contentStart - sizeof(uint32_t)) != crc) {
+    return false;
+  }
+
+  bool success = true;
+  for (unsigned int i = 0; i < 4; ++i) {
+    for (unsigned int j = 0; j < 4; ++j) {
+      success = success && reader.read(m_od_M_o[i][j]);
+    }
+  }
+  for (unsigned int i = 0; i < 6; ++i) {
+    success = success && reader.read(m_statistics[i]);
+  }
+
+  uint32_t nbSources = 0;
+  success = success && reader.read(nbSources);
+  for (uint32_t i = 0; success && (i < nbSources); ++i) {
+    vpSource source;
+    success = reader.readString(source.m_filename) && reader.read(source.m_size) && reader.read(source.m_crc);
+    m_sources.push_back(source);
+  }
+
+  uint32_t nbPrimitives = 0;
+  success = success && reader.read(nbPrimitives);
+  for (uint32_t i = 0; success && (i < nbPrimitives); ++i) {
+    vpPrimitive primitive;
+    int32_t type = 0, idFace = 0;
+    uint32_t useLod = 0;
+    success = reader.read(type) && reader.read(idFace) && reader.read(primitive.m_firstIndex) &&
+      reader.read(primitive.m_nbIndices) && reader.read(primitive.m_radius) && reader.read(primitive.m_parameters) &&
+      reader.read(useLod) && reader.read(primitive.m_minPolygonAreaThreshold) &&
+      reader.read(primitive.m_minLineLengthThreshold) && reader.readString(primitive.m_name);
+    success = success && (type >= POLYGON_FROM_LINES) && (type <= CIRCLE);
+    primitive.m_type = static_cast<vpPrimitiveType>(type);
+    primitive.m_idFace = idFace;
+    primitive.m_useLod = (useLod != 0);
+    m_primitives.push_back(primitive);
+  }
+
+  success = success && reader.readArray(m_points) && reader.readArray(m_indices) &&
+    reader.readArray(m_weldedPoints) && reader.readArray(m_edges) && reader.readArray(m_primitiveEdgesOffsets) &&
+    reader.readArray(m_primitiveEdges) && reader.readArray(m_edgeFacesOffsets) && reader.readArray(m_edgeFaces) &&
+    reader.readArray(m_normals);
+
+  // Consistency of the indexes
+  const unsigned int nbPoints = getNbPoints();
+  for (size_t i = 0; success && (i < m_primitives.size()); ++i) {
+    success = (static_cast<size_t>(m_primitives[i].m_firstIndex) + m_primitives[i].m_nbIndices) <= m_indices.size();
+  }
+  for (size_t i = 0; success && (i < m_indices.size()); ++i) {
+    success = m_indices[i] < nbPoints;
+  }
+  success = success && (m_weldedPoints.size() == nbPoints) && (m_normals.size() == (3 * m_primitives.size())) &&
+    (m_primitiveEdgesOffsets.size() == (m_primitives.size() + 1)) &&
+    (m_edgeFacesOffsets.size() == (getNbEdges() + 1));
+
+  if (!success) {
+    clear();
+  }
+  return success;
+}
+
+/*!
+ * Save the compiled model in a binary file.
+ *
+ * \param filename : Path to the compiled model file.
+ *
+ * \exception vpException::ioError : If the file cannot be written.
+ */
+void vpMbtCompiledModel::save(const std::string &filename) const
+{
+  std::vector<char> buffer;
+  buffer.insert(buffer.end(), g_magic, g_magic + sizeof(g_magic));
+  writeValue(buffer, formatVersion);
+  writeValue(buffer, g_byteOrderMark);
+  const size_t contentStart = buffer.size();
+
+  for (unsigned int i = 0; i < 4; ++i) {
+    for (unsigned int j = 0; j < 4; ++j) {
+      writeValue(buffer, m_od_M_o[i][j]);
+    }
+  }
+  for (unsigned int i = 0; i < 6; ++i) {
+    writeValue(buffer, static_cast<uint32_t>(m_statistics[i]));
+  }
+
+  writeValue(buffer, static_cast<uint32_t>(m_sources.size()));
+  for (size_t i = 0; i < m_sources.size(); ++i) {
+    writeString(buffer, m_sources[i].m_filename);
+    writeValue(buffer, m_sources[i].m_size);
+    writeValue(buffer, m_sources[i].m_crc);
+  }
+
+  writeValue(buffer, static_cast<uint32_t>(m_primitives.size()));
+  for (size_t i = 0; i < m_primitives.size(); ++i) {
+    const vpPrimitive &primitive = m_primitives[i];
+    writeValue(buffer, static_cast<int32_t>(primitive.m_type));
+    writeValue(buffer, static_cast<int32_t>(primitive.m_idFace));
+    writeValue(buffer, static_cast<uint32_t>(primitive.m_firstIndex));
+    writeValue(buffer, static_cast<uint32_t>(primitive.m_nbIndices));
+    writeValue(buffer, primitive.m_radius);
+    writeValue(buffer, static_cast<uint32_t>(primitive.m_parameters));
+    writeValue(buffer, static_cast<uint32_t>(primitive.m_useLod ? 1 : 0));
+    writeValue(buffer, primitive.m_minPolygonAreaThreshold);
+    writeValue(buffer, primitive.m_minLineLengthThreshold);
+    writeString(buffer, primitive.m_name);
+  }
+
+  writeArray(buffer, m_points);
+  writeArray(buffer, m_indices);
+  writeArray(buffer, m_weldedPoints);
+  writeArray(buffer, m_edges);
+  writeArray(buffer, m_primitiveEdgesOffsets);
+  writeArray(buffer, m_primitiveEdges);
+  writeArray(buffer, m_edgeFacesOffsets);
+  writeArray(buffer, m_edgeFaces);
+  writeArray(buffer, m_normals);
+
+  const uint32_t crc = visp::vp_mz_crc32(0, reinterpret_cast<const unsigned char *>(&buffer[contentStart]),
+                                         buffer.size() - contentStart);
+  writeValue(buffer, crc);
+
+  std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
+  if (!file.is_open() || !file.write(&buffer[0], static_cast<std::streamsize>(buffer.size()))) {
+    throw vpException(vpException::ioError, "Cannot write compiled model file %s", filename.c_str());
+  }
+}
+
+/*!
+ * Set the statistics printed by vpMbTracker when the model is loaded.
+ */
+void vpMbtCompiledModel::setStatistics(unsigned int nbPoints, unsigned int nbLines, unsigned int nbPolygonLines,
+                                       unsigned int nbPolygonPoints, unsigned int nbCylinders, unsigned int nbCircles)
+{
+  m_statistics[0] = nbPoints;
+  m_statistics[1] = nbLines;
+  m_statistics[2] = nbPolygonLines;
+  m_statistics[3] = nbPolygonPoints;
+  m_statistics[4] = nbCylinders;
+  m_statistics[5] = nbCircles;
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+bool vpMbtCompiledModel::computeChecksum(const std::string &filename, uint64_t &size, uint32_t &crc)
+{
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+  size = 0;
+  crc = 0;
+  std::vector<char> chunk(1 << 16);
+  while (file) {
+    file.read(&chunk[0], static_cast<std::streamsize>(chunk.size()));
+    const std::streamsize nbRead = file.gcount();
+    if (nbRead > 0) {
+      crc = visp::vp_mz_crc32(crc, reinterpret_cast<const unsigned char *>(&chunk[0]), static_cast<size_t>(nbRead));
+      size += static_cast<uint64_t>(nbRead);
+    }
+  }
+  return true;
+}
+#endif
+END_VISP_NAMESPACE
@@ -0,0 +1,75 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Workspace of the virtual visual-servoing stage of the model-based trackers.
+ */
+
+#include <visp3/mbt/vpMbtVVSWorkspace.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * Default constructor. The buffers are empty and are sized on first use.
+ */
+vpMbtVVSWorkspace::vpMbtVVSWorkspace()
+  : LTL(), LTR(), v(), error_prev(), w_prev(), cMo_prev(), W_true(), L_true(), LVJ_true(), cVo(), VJ(), LVJ(),
+  LTLmuI(), LTL_pinv(), m_nbResizes(0)
+{ }
+
+/*!
+ * Resize a matrix without initializing its content. The resize counter is increased only when the size of the
+ * matrix changes, since only in that case the memory is reallocated.
+ *
+ * \param M : Matrix to resize.
+ * \param nrows : Number of rows.
+ * \param ncols : Number of columns.
+ */
+void vpMbtVVSWorkspace::resize(vpMatrix &M, unsigned int nrows, unsigned int ncols)
+{
+  if ((M.getRows() != nrows) || (M.getCols() != ncols)) {
+    M.resize(nrows, ncols, false, false);
+    ++m_nbResizes;
+  }
+}
+
+/*!
+ * Resize a column vector without initializing its content. The resize counter is increased only when the size
+ * of the vector changes, since only in that case the memory is reallocated.
+ *
+ * \param v_ : Vector to resize.
+ * \param nrows : Number of rows.
+ */
+void vpMbtVVSWorkspace::resize(vpColVector &v_, unsigned int nrows)
+{
+  if (v_.getRows() != nrows) {
+    v_.resize(nrows, false);
+    ++m_nbResizes;
+  }
+}
+END_VISP_NAMESPACE
@@ -0,0 +1,378 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2026 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the bounding volume hierarchy used to compute the visibility of the faces.
+ */
+
+/*!
+  \example catchMbtBoundingVolumeHierarchy.cpp
+
+  \brief Test the bounding volume hierarchy used to compute the visibility of the faces and the stripe-parallel
+  scan-line rendering: the results must be the ones of the per-polygon computations, and the nearest of overlapping
+  faces must be rendered.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#if defined(VISP_BUILD_CATCH2)
+#include <catch_amalgamated.hpp>
+#else // Since v3.1.1
+#include <catch2/catch_all.hpp>
+#endif
+#include <visp3/core/vpUniRand.h>
+#include <visp3/mbt/vpMbHiddenFaces.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+void addPolygon(vpMbHiddenFaces<vpMbtPolygon> &faces, const std::vector<vpPoint> &points, bool useLod = false,
+                bool oriented = true)
+{
+  vpMbtPolygon polygon;
+  polygon.setNbPoint(static_cast<unsigned int>(points.size()));
+  for (unsigned int k = 0; k < points.size(); ++k) {
+    polygon.addPoint(k, points[k]);
+  }
+  polygon.setIndex(static_cast<int>(faces.size()));
+  polygon.setLod(useLod);
+  polygon.setMinPolygonAreaThresh(200.);
+  polygon.setMinLineLengthThresh(30.);
+  polygon.setIsPolygonOriented(oriented);
+  faces.addPolygon(&polygon);
+}
+
+vpPoint spherePoint(double radius, double theta, double phi)
+{
+  return vpPoint(radius * std::sin(theta) * std::cos(phi), radius * std::sin(theta) * std::sin(phi),
+                 radius * std::cos(theta));
+}
+
+// Tessellated sphere with outward faces, plus a few lines, level of detail faces, a degenerate and a non-oriented
+// polygon
+void createModel(vpMbHiddenFaces<vpMbtPolygon> &faces, unsigned int nbLat, unsigned int nbLon)
+{
+  const double radius = 0.1;
+  for (unsigned int i = 0; i < nbLat; ++i) {
+    const double theta0 = (M_PI * i) / nbLat, theta1 = (M_PI * (i + 1)) / nbLat;
+    for (unsigned int j = 0; j < nbLon; ++j) {
+      const double phi0 = (2 * M_PI * j) / nbLon, phi1 = (2 * M_PI * (j + 1)) / nbLon;
+      std::vector<vpPoint> points;
+      points.push_back(spherePoint(radius, theta0, phi0));
+      if (i > 0) {
+        points.push_back(spherePoint(radius, theta0, phi1));
+      }
+      points.push_back(spherePoint(radius, theta1, phi1));
+      if (i + 1 < nbLat) {
+        points.push_back(spherePoint(radius, theta1, phi0));
+      }
+      // Counter-clockwise seen from the outside
+      std::reverse(points.begin(), points.end());
+      addPolygon(faces, points, (i == nbLat / 2) && (j % 4 == 0));
+    }
+  }
+
+  for (unsigned int j = 0; j < 12; ++j) {
+    std::vector<vpPoint> line;
+    line.push_back(spherePoint(0.12, M_PI / 3, (2 * M_PI * j) / 12));
+    line.push_back(spherePoint(0.12, (2 * M_PI) / 3, (2 * M_PI * j) / 12));
+    addPolygon(faces, line, (j % 2) == 0);
+  }
+
+  std::vector<vpPoint> points;
+  points.push_back(vpPoint(0.15, 0, 0));
+  points.push_back(vpPoint(0.16, 0, 0));
+  points.push_back(vpPoint(0.17, 0, 0));
+  addPolygon(faces, points);
+  points[2] = vpPoint(0.15, 0.01, 0.01);
+  addPolygon(faces, points, false, false);
+}
+
+// Camera at the given position looking at the target
+vpHomogeneousMatrix lookAt(const vpColVector &position, const vpColVector &target)
+{
+  vpColVector z = target - position;
+  z.normalize();
+  vpColVector up(3);
+  up[1] = 1;
+  vpColVector x = vpColVector::crossProd(up, z);
+  x.normalize();
+  const vpColVector y = vpColVector::crossProd(z, x);
+  vpRotationMatrix cRo;
+  for (unsigned int c = 0; c < 3; ++c) {
+    cRo[0][c] = x[c];
+    cRo[1][c] = y[c];
+    cRo[2][c] = z[c];
+  }
+  const vpTranslationVector t(-(cRo * vpTranslationVector(position[0], position[1], position[2])));
+  return vpHomogeneousMatrix(t, cRo);
+}
+
+bool sameVisibility(vpMbHiddenFaces<vpMbtPolygon> &faces, vpMbHiddenFaces<vpMbtPolygon> &facesRef)
+{
+  for (unsigned int i = 0; i < faces.size(); ++i) {
+    if ((faces.isVisible(i) != facesRef.isVisible(i)) || (faces.isAppearing(i) != facesRef.isAppearing(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool sameClipping(vpMbHiddenFaces<vpMbtPolygon> &faces, vpMbHiddenFaces<vpMbtPolygon> &facesRef)
+{
+  for (unsigned int i = 0; i < faces.size(); ++i) {
+    std::vector<std::pair<vpPoint, unsigned int> > poly, polyRef;
+    faces[i]->getPolygonClipped(poly);
+    facesRef[i]->getPolygonClipped(polyRef);
+    if (poly.size() != polyRef.size()) {
+      return false;
+    }
+    for (size_t k = 0; k < poly.size(); ++k) {
+      if ((poly[k].second != polyRef[k].second) || (poly[k].first.get_X() != polyRef[k].first.get_X()) ||
+          (poly[k].first.get_Y() != polyRef[k].first.get_Y()) || (poly[k].first.get_Z() != polyRef[k].first.get_Z())) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool sameRender(vpMbHiddenFaces<vpMbtPolygon> &faces, vpMbHiddenFaces<vpMbtPolygon> &facesRef)
+{
+  return (faces.getMbScanLineRenderer().getMask() == facesRef.getMbScanLineRenderer().getMask()) &&
+    (faces.getMbScanLineRenderer().getPrimitiveIDs() == facesRef.getMbScanLineRenderer().getPrimitiveIDs());
+}
+}
+
+TEST_CASE("Bounding volume hierarchy visibility", "[mbt_bvh]")
+{
+  const unsigned int width = 640, height = 480;
+  vpCameraParameters cam(600, 600, 320, 240);
+  cam.computeFov(width, height);
+  const double angleAppears = vpMath::rad(85), angleDisappears = vpMath::rad(89);
+
+  vpMbHiddenFaces<vpMbtPolygon> faces, facesRef;
+  createModel(faces, 16, 32);
+  createModel(facesRef, 16, 32);
+  facesRef.setUseBoundingVolumeHierarchy(false);
+  CHECK(faces.getUseBoundingVolumeHierarchy());
+  CHECK_FALSE(facesRef.getUseBoundingVolumeHierarchy());
+  for (unsigned int i = 0; i < faces.size(); ++i) {
+    faces[i]->setClipping(vpPolygon3D::NEAR_CLIPPING | vpPolygon3D::FOV_CLIPPING);
+    faces[i]->setNearClippingDistance(0.05);
+    facesRef[i]->setClipping(vpPolygon3D::NEAR_CLIPPING | vpPolygon3D::FOV_CLIPPING);
+    facesRef[i]->setNearClippingDistance(0.05);
+  }
+  faces.getMbScanLineRenderer().setNbThreads(3);
+  facesRef.getMbScanLineRenderer().setNbThreads(1);
+
+  // A smooth trajectory close to the sphere, partly outside of the field of view, followed by random poses
+  vpUniRand rand(42);
+  std::vector<vpHomogeneousMatrix> poses;
+  for (unsigned int n = 0; n < 30; ++n) {
+    const double t = 0.04 * n;
+    vpColVector position(3), target(3);
+    position[0] = 0.3 * std::sin(t);
+    position[1] = 0.05 * t;
+    position[2] = 0.3 * std::cos(t);
+    target[0] = 0.08 * std::cos(3 * t);
+    poses.push_back(lookAt(position, target));
+  }
+  for (unsigned int n = 0; n < 20; ++n) {
+    vpColVector position(3), target(3);
+    for (unsigned int c = 0; c < 3; ++c) {
+      position[c] = rand.uniform(-0.5, 0.5);
+      target[c] = rand.uniform(-0.1, 0.1);
+    }
+    if (position.frobeniusNorm() < 0.2) {
+      position *= 0.2 / position.frobeniusNorm();
+    }
+    poses.push_back(lookAt(position, target));
+  }
+
+  unsigned int nbChanges = 0;
+  for (size_t n = 0; n < poses.size(); ++n) {
+    bool changed = false, changedRef = false;
+    const unsigned int nbVisible =
+      faces.setVisible(width, height, cam, poses[n], angleAppears, angleDisappears, changed);
+    const unsigned int nbVisibleRef =
+      facesRef.setVisible(width, height, cam, poses[n], angleAppears, angleDisappears, changedRef);
+    CHECK(nbVisible == nbVisibleRef);
+    CHECK(changed == changedRef);
+    CHECK(sameVisibility(faces, facesRef));
+    nbChanges += changed ? 1 : 0;
+
+    // Visibility computed again for the same pose
+    faces.setVisible(width, height, cam, poses[n], angleAppears, angleDisappears, changed);
+    facesRef.setVisible(width, height, cam, poses[n], angleAppears, angleDisappears, changedRef);
+    CHECK(changed == changedRef);
+    CHECK(sameVisibility(faces, facesRef));
+
+    // The clipping and the rendering are the most expensive parts
+    if (n % 5 == 0) {
+      faces.computeClippedPolygons(poses[n], cam);
+      facesRef.computeClippedPolygons(poses[n], cam);
+      CHECK(sameClipping(faces, facesRef));
+
+      faces.computeScanLineRender(cam, width, height);
+      facesRef.computeScanLineRender(cam, width, height);
+      CHECK(sameRender(faces, facesRef));
+
+      vpPoint a = spherePoint(0.1, M_PI / 2, 0), b = spherePoint(0.1, M_PI / 2, M_PI / 2);
+      a.changeFrame(poses[n]);
+      b.changeFrame(poses[n]);
+      std::vector<std::pair<vpPoint, vpPoint> > lines, linesRef;
+      faces.computeScanLineQuery(a, b, lines);
+      facesRef.computeScanLineQuery(a, b, linesRef);
+      CHECK(lines.size() == linesRef.size());
+    }
+  }
+  CHECK(nbChanges > 0);
+
+  // About half of the sphere is visible
+  bool changed = false, changedRef = false;
+  const vpHomogeneousMatrix cMo = lookAt(vpColVector(3, 0.5), vpColVector(3, 0.));
+  const unsigned int nbVisible = faces.setVisible(width, height, cam, cMo, angleAppears, angleDisappears, changed);
+  CHECK(nbVisible == facesRef.setVisible(width, height, cam, cMo, angleAppears, angleDisappears, changedRef));
+  CHECK(nbVisible > 0.3 * faces.size());
+  CHECK(nbVisible < 0.7 * faces.size());
+
+  // The hierarchy is built again when polygons are added
+  createModel(faces, 4, 8);
+  createModel(facesRef, 4, 8);
+  for (unsigned int i = 0; i < poses.size(); i += 10) {
+    CHECK(faces.setVisible(width, height, cam, poses[i], angleAppears, angleDisappears, changed) ==
+          facesRef.setVisible(width, height, cam, poses[i], angleAppears, angleDisappears, changedRef));
+    CHECK(sameVisibility(faces, facesRef));
+  }
+
+  // Copy
+  vpMbHiddenFaces<vpMbtPolygon> facesCopy(faces);
+  CHECK(facesCopy.getUseBoundingVolumeHierarchy());
+  bool changedCopy = false;
+  facesCopy.setVisible(width, height, cam, poses[3], angleAppears, angleDisappears, changedCopy);
+  faces.setVisible(width, height, cam, poses[3], angleAppears, angleDisappears, changed);
+  CHECK(sameVisibility(facesCopy, faces));
+}
+
+TEST_CASE("Scan-line rendering of overlapping faces", "[mbt_bvh]")
+{
+  const unsigned int width = 640, height = 480;
+  vpCameraParameters cam(600, 600, 320, 240);
+  cam.computeFov(width, height);
+
+  // Square 0 in front of square 1, and tilted square 2 in front of square 0
+  vpMbHiddenFaces<vpMbtPolygon> faces;
+  std::vector<vpPoint> points(4);
+  points[0] = vpPoint(-0.1, -0.1, 0.5);
+  points[1] = vpPoint(0.1, -0.1, 0.5);
+  points[2] = vpPoint(0.1, 0.1, 0.5);
+  points[3] = vpPoint(-0.1, 0.1, 0.5);
+  addPolygon(faces, points, false, false);
+  points[0] = vpPoint(0., -0.05, 0.6);
+  points[1] = vpPoint(0.2, -0.05, 0.6);
+  points[2] = vpPoint(0.2, 0.15, 0.6);
+  points[3] = vpPoint(0., 0.15, 0.6);
+  addPolygon(faces, points, false, false);
+  points[0] = vpPoint(-0.15, -0.15, 0.4);
+  points[1] = vpPoint(0.05, -0.15, 0.45);
+  points[2] = vpPoint(0.05, -0.05, 0.45);
+  points[3] = vpPoint(-0.15, -0.05, 0.4);
+  addPolygon(faces, points, false, false);
+  // Square 3 entirely hidden by square 0
+  points[0] = vpPoint(-0.1, -0.1, 0.7);
+  points[1] = vpPoint(0.1, -0.1, 0.7);
+  points[2] = vpPoint(0.1, 0.1, 0.7);
+  points[3] = vpPoint(-0.1, 0.1, 0.7);
+  addPolygon(faces, points, false, false);
+  for (unsigned int i = 0; i < faces.size(); ++i) {
+    faces[i]->setClipping(vpPolygon3D::NEAR_CLIPPING | vpPolygon3D::FOV_CLIPPING);
+    faces[i]->setNearClippingDistance(0.05);
+  }
+
+  vpHomogeneousMatrix cMo;
+  faces.computeClippedPolygons(cMo, cam);
+  vpMbScanLine &renderer = faces.getMbScanLineRenderer();
+  renderer.setNbThreads(1);
+  faces.computeScanLineRender(cam, width, height);
+  const vpImage<unsigned char> mask = renderer.getMask();
+  const vpImage<int> ids = renderer.getPrimitiveIDs();
+
+  // Nearest face along the ray of a few pixels
+  CHECK(ids[240][260] == 0);
+  CHECK(mask[240][260] == 255);
+  CHECK(ids[260][380] == 0);
+  CHECK(ids[290][470] == 1);
+  CHECK(ids[132][260] == 2);
+  CHECK(ids[132][140] == 2);
+  CHECK(ids[10][10] == -1);
+  CHECK(mask[10][10] == 0);
+  CHECK(std::find(ids.bitmap, ids.bitmap + ids.getSize(), 3) == ids.bitmap + ids.getSize());
+  // Without mask border, the mask is set where a face is seen
+  bool sameMask = true;
+  for (unsigned int k = 0; k < ids.getSize(); ++k) {
+    sameMask = sameMask && ((mask.bitmap[k] == 255) == (ids.bitmap[k] != -1));
+  }
+  CHECK(sameMask);
+
+  // The rendering does not depend on the number of threads, with or without mask border
+  for (unsigned int maskBorder = 0; maskBorder <= 2; maskBorder += 2) {
+    renderer.setMaskBorder(maskBorder);
+    renderer.setNbThreads(1);
+    faces.computeScanLineRender(cam, width, height);
+    const vpImage<unsigned char> maskRef = renderer.getMask();
+    const vpImage<int> idsRef = renderer.getPrimitiveIDs();
+    renderer.setNbThreads(4);
+    faces.computeScanLineRender(cam, width, height);
+    CHECK(renderer.getMask() == maskRef);
+    CHECK(renderer.getPrimitiveIDs() == idsRef);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  std::cout << (numFailed ? "Test failed" : "Test succeed") << std::endl;
+  return numFailed;
+}
+
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
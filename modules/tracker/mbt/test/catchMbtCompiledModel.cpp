@@ -0,0 +1,286 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2026 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the compiled model cache of the model-based tracker.
+ */
+
+/*!
+  \example catchMbtCompiledModel.cpp
+
+  \brief Test the compiled model cache of the model-based tracker.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+#if defined(VISP_BUILD_CATCH2)
+#include <catch_amalgamated.hpp>
+#else // Since v3.1.1
+#include <catch2/catch_all.hpp>
+#endif
+#include <visp3/core/vpIoTools.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+#include <visp3/mbt/vpMbtCompiledModel.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+// Cube whose bottom face is described with lines, the other faces with points, plus a segment and an included
+// model with a cylinder and a circle
+const char *g_cubeModel = "V1\n"
+"load(\"part.cao\")\n"
+"# Points\n"
+"8\n"
+"0 0 0\n"
+"0.1 0 0\n"
+"0.1 0.1 0\n"
+"0 0.1 0\n"
+"0 0 0.1\n"
+"0.1 0 0.1\n"
+"0.1 0.1 0.1\n"
+"0 0.1 0.1\n"
+"# Lines\n"
+"5\n"
+"0 3\n"
+"3 2\n"
+"2 1\n"
+"1 0\n"
+"0 6 name=diagonal minLineLengthThreshold=10\n"
+"# Faces from lines\n"
+"1\n"
+"4 0 1 2 3 name=bottom\n"
+"# Faces from points\n"
+"5\n"
+"4 4 5 6 7 name=top useLod=true minPolygonAreaThreshold=100\n"
+"4 0 1 5 4\n"
+"4 1 2 6 5\n"
+"4 2 3 7 6\n"
+"4 3 0 4 7\n"
+"# Cylinders\n"
+"0\n"
+"# Circles\n"
+"0\n";
+
+const char *g_partModel = "V1\n"
+"5\n"
+"0.3 0 0\n"
+"0.35 0 0\n"
+"0.3 0.05 0\n"
+"0.5 0 0\n"
+"0.5 0 0.1\n"
+"0\n"
+"0\n"
+"0\n"
+"1\n"
+"3 4 0.02 name=cylinder\n"
+"1\n"
+"0.05 0 1 2 name=circle\n";
+
+void writeFile(const std::string &filename, const std::string &content)
+{
+  std::ofstream file(filename.c_str(), std::ios::binary);
+  file << content;
+}
+
+bool sameTracker(vpMbGenericTracker &tracker, vpMbGenericTracker &trackerRef)
+{
+  std::vector<vpMbtPolygon *> &polygons = tracker.getFaces().getPolygon();
+  std::vector<vpMbtPolygon *> &polygonsRef = trackerRef.getFaces().getPolygon();
+  if (polygons.size() != polygonsRef.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < polygons.size(); ++i) {
+    vpMbtPolygon &p = *polygons[i], &pRef = *polygonsRef[i];
+    if ((p.getIndex() != pRef.getIndex()) || (p.getName() != pRef.getName()) ||
+        (p.getNbPoint() != pRef.getNbPoint()) || (p.useLod != pRef.useLod) ||
+        (p.minLineLengthThresh != pRef.minLineLengthThresh) ||
+        (p.minPolygonAreaThresh != pRef.minPolygonAreaThresh)) {
+      return false;
+    }
+    for (unsigned int k = 0; k < p.getNbPoint(); ++k) {
+      const vpPoint pt = p.getPoint(k), ptRef = pRef.getPoint(k);
+      if ((pt.get_oX() != ptRef.get_oX()) || (pt.get_oY() != ptRef.get_oY()) || (pt.get_oZ() != ptRef.get_oZ())) {
+        return false;
+      }
+    }
+  }
+
+  std::list<vpMbtDistanceLine *> lines, linesRef;
+  tracker.getLline(lines);
+  trackerRef.getLline(linesRef);
+  std::list<vpMbtDistanceCylinder *> cylinders, cylindersRef;
+  tracker.getLcylinder(cylinders);
+  trackerRef.getLcylinder(cylindersRef);
+  std::list<vpMbtDistanceCircle *> circles, circlesRef;
+  tracker.getLcircle(circles);
+  trackerRef.getLcircle(circlesRef);
+  return (lines.size() == linesRef.size()) && (cylinders.size() == cylindersRef.size()) &&
+    (circles.size() == circlesRef.size());
+}
+}
+
+TEST_CASE("Compiled model cache", "[mbt_compiled_model]")
+{
+  const std::string directory = vpIoTools::makeTempDirectory(vpIoTools::getTempPath() + "/visp_test_mbt_model");
+  const std::string cubeFile = vpIoTools::createFilePath(directory, "cube.cao");
+  const std::string partFile = vpIoTools::createFilePath(directory, "part.cao");
+  const std::string cacheDirectory = vpIoTools::createFilePath(directory, "cache");
+  writeFile(cubeFile, g_cubeModel);
+  writeFile(partFile, g_partModel);
+
+  vpMbGenericTracker trackerRef(1, vpMbGenericTracker::EDGE_TRACKER);
+  trackerRef.loadModel(cubeFile);
+  CHECK_FALSE(trackerRef.isModelLoadedFromCache());
+  // 6 faces, 1 segment, 1 circle, the cylinder axis and the 4 faces of its bounding box
+  CHECK(trackerRef.getFaces().size() == 13);
+
+  SECTION("Load from the cache")
+  {
+    for (int n = 0; n < 3; ++n) {
+      vpMbGenericTracker tracker(1, vpMbGenericTracker::EDGE_TRACKER);
+      tracker.setCompiledModelCache(true, cacheDirectory);
+      CHECK(tracker.getCompiledModelCache());
+      tracker.loadModel(cubeFile);
+      CHECK(tracker.isModelLoadedFromCache() == (n > 0));
+      CHECK(sameTracker(tracker, trackerRef));
+    }
+
+    // Cache file next to the model
+    vpMbGenericTracker tracker(1, vpMbGenericTracker::EDGE_TRACKER);
+    tracker.setCompiledModelCache(true);
+    tracker.loadModel(cubeFile);
+    CHECK(vpIoTools::checkFilename(cubeFile + ".cmodel"));
+    tracker.resetTracker();
+    tracker.loadModel(cubeFile);
+    CHECK(tracker.isModelLoadedFromCache());
+    CHECK(sameTracker(tracker, trackerRef));
+  }
+
+  SECTION("Invalidation")
+  {
+    vpMbGenericTracker tracker(1, vpMbGenericTracker::EDGE_TRACKER);
+    tracker.setCompiledModelCache(true, cacheDirectory);
+    tracker.loadModel(cubeFile);
+
+    // Modification of an included file
+    writeFile(partFile, std::string(g_partModel) + "# Comment\n");
+    vpMbGenericTracker tracker2(1, vpMbGenericTracker::EDGE_TRACKER);
+    tracker2.setCompiledModelCache(true, cacheDirectory);
+    tracker2.loadModel(cubeFile);
+    CHECK_FALSE(tracker2.isModelLoadedFromCache());
+    CHECK(sameTracker(tracker2, trackerRef));
+
+    // Other transformation
+    const vpHomogeneousMatrix od_M_o(0.1, 0, 0, 0, 0, 0);
+    vpMbGenericTracker tracker3(1, vpMbGenericTracker::EDGE_TRACKER);
+    tracker3.setCompiledModelCache(true, cacheDirectory);
+    tracker3.loadModel(cubeFile, false, od_M_o);
+    CHECK_FALSE(tracker3.isModelLoadedFromCache());
+    vpMbGenericTracker tracker4(1, vpMbGenericTracker::EDGE_TRACKER);
+    tracker4.setCompiledModelCache(true, cacheDirectory);
+    tracker4.loadModel(cubeFile, false, od_M_o);
+    CHECK(tracker4.isModelLoadedFromCache());
+    const vpPoint pt = tracker4.getFaces()[0]->getPoint(0), ptRef = trackerRef.getFaces()[0]->getPoint(0);
+    CHECK(std::fabs(pt.get_oX() - ptRef.get_oX() - 0.1) < 1e-12);
+
+    // Corrupted cache file
+    tracker.setCompiledModelCache(true);
+    tracker.resetTracker();
+    tracker.loadModel(cubeFile);
+    std::fstream file((cubeFile + ".cmodel").c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(100);
+    file.put('x');
+    file.close();
+    vpMbGenericTracker tracker5(1, vpMbGenericTracker::EDGE_TRACKER);
+    tracker5.setCompiledModelCache(true);
+    tracker5.loadModel(cubeFile);
+    CHECK_FALSE(tracker5.isModelLoadedFromCache());
+    CHECK(sameTracker(tracker5, trackerRef));
+  }
+
+  SECTION("Topology")
+  {
+    vpMbGenericTracker tracker(1, vpMbGenericTracker::EDGE_TRACKER);
+    tracker.setCompiledModelCache(true);
+    tracker.loadModel(cubeFile);
+
+    vpMbtCompiledModel model;
+    REQUIRE(model.load(cubeFile + ".cmodel"));
+    CHECK(model.isUpToDate(vpHomogeneousMatrix()));
+    CHECK(model.getSources().size() == 2);
+    unsigned int nbPoints, nbLines, nbPolygonLines, nbPolygonPoints, nbCylinders, nbCircles;
+    model.getStatistics(nbPoints, nbLines, nbPolygonLines, nbPolygonPoints, nbCylinders, nbCircles);
+    CHECK(nbPoints == 13);
+    CHECK(nbLines == 5);
+    CHECK(nbPolygonLines == 1);
+    CHECK(nbPolygonPoints == 5);
+    CHECK(nbCylinders == 1);
+    CHECK(nbCircles == 1);
+
+    // The 12 edges of the cube and the diagonal
+    CHECK(model.getNbEdges() == 13);
+    const std::vector<vpMbtCompiledModel::vpPrimitive> &primitives = model.getPrimitives();
+    unsigned int nbCubeEdges = 0;
+    for (unsigned int e = 0; e < model.getNbEdges(); ++e) {
+      nbCubeEdges += (model.getEdgeFaces(e).size() == 2) ? 1 : 0;
+    }
+    CHECK(nbCubeEdges == 12);
+    for (unsigned int i = 0; i < primitives.size(); ++i) {
+      if (primitives[i].m_type == vpMbtCompiledModel::POLYGON_FROM_POINTS) {
+        const vpColVector normal = model.getNormal(i);
+        CHECK(std::fabs(normal.frobeniusNorm() - 1.) < 1e-12);
+        CHECK(model.getPrimitiveEdges(i).size() == 4);
+      }
+    }
+  }
+
+  vpIoTools::remove(directory);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  std::cout << (numFailed ? "Test failed" : "Test succeed") << std::endl;
+  return numFailed;
+}
+
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
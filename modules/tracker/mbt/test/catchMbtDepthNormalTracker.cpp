@@ -0,0 +1,267 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2026 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the depth normal model-based tracker on a synthetic point cloud.
+ */
+
+/*!
+  \example catchMbtDepthNormalTracker.cpp
+
+  \brief Test the depth normal model-based tracker on a synthetic point cloud.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+#if defined(VISP_BUILD_CATCH2)
+#include <catch_amalgamated.hpp>
+#else // Since v3.1.1
+#include <catch2/catch_all.hpp>
+#endif
+#include <visp3/core/vpGaussRand.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/mbt/vpMbDepthNormalTracker.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+const double g_cubeSize = 0.042;
+
+// Cube with x in [-0.042, 0], y and z in [0, 0.042]
+const char *g_cubeModel = "V1\n"
+"8\n"
+" 0.000  0.000  0.000\n"
+"-0.042  0.000  0.000\n"
+"-0.042  0.042  0.000\n"
+" 0.000  0.042  0.000\n"
+" 0.000  0.000  0.042\n"
+"-0.042  0.000  0.042\n"
+"-0.042  0.042  0.042\n"
+" 0.000  0.042  0.042\n"
+"0\n"
+"0\n"
+"6\n"
+"4 0 4 5 1\n"
+"4 1 5 6 2\n"
+"4 6 7 3 2\n"
+"4 3 7 4 0\n"
+"4 0 1 2 3\n"
+"4 7 6 5 4\n"
+"0\n"
+"0\n";
+
+/*
+  Ray cast the cube to build the point cloud seen by the camera, with a
+  gaussian noise on the depth and a few outliers. Pixels that do not see the
+  cube are set to a null depth.
+*/
+void renderPointCloud(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam, unsigned int width,
+                      unsigned int height, std::vector<vpColVector> &point_cloud)
+{
+  const vpHomogeneousMatrix oMc = cMo.inverse();
+  const vpRotationMatrix oRc = oMc.getRotationMatrix();
+  const vpTranslationVector oTc = oMc.getTranslationVector();
+  const double boxMin[3] = { -g_cubeSize, 0, 0 };
+  const double boxMax[3] = { 0, g_cubeSize, g_cubeSize };
+  vpGaussRand noise(0.0005, 0, 4212);
+  vpUniRand rng(1234);
+
+  point_cloud.resize(width * height);
+  for (unsigned int i = 0; i < height; ++i) {
+    for (unsigned int j = 0; j < width; ++j) {
+      const double x = (j - cam.get_u0()) / cam.get_px();
+      const double y = (i - cam.get_v0()) / cam.get_py();
+      const vpColVector ray = oRc * vpColVector({ x, y, 1 });
+
+      // Slab intersection, the depth along the optical axis is the ray parameter since the ray has a unit z
+      double tmin = 0, tmax = std::numeric_limits<double>::max();
+      for (unsigned int k = 0; k < 3; ++k) {
+        if (std::fabs(ray[k]) < 1e-12) {
+          if (oTc[k] < boxMin[k] || oTc[k] > boxMax[k]) {
+            tmax = -1;
+          }
+        }
+        else {
+          double t1 = (boxMin[k] - oTc[k]) / ray[k];
+          double t2 = (boxMax[k] - oTc[k]) / ray[k];
+          tmin = std::max(tmin, std::min(t1, t2));
+          tmax = std::min(tmax, std::max(t1, t2));
+        }
+      }
+
+      double Z = 0;
+      if (tmin <= tmax) {
+        Z = tmin + noise();
+        if (rng.uniform(0.0, 1.0) < 0.02) {
+          Z += rng.uniform(-0.05, 0.05);
+        }
+      }
+      point_cloud[i * width + j] = vpColVector({ x * Z, y * Z, Z });
+    }
+  }
+}
+
+vpHomogeneousMatrix track(vpMbtFaceDepthNormal::vpFeatureEstimationType method, int nbThreads,
+                          const std::string &modelFile, const vpCameraParameters &cam, const vpImage<unsigned char> &I,
+                          const vpHomogeneousMatrix &cMo_init, const std::vector<vpColVector> &point_cloud)
+{
+  vpMbDepthNormalTracker tracker;
+  tracker.setCameraParameters(cam);
+  tracker.setDepthNormalFeatureEstimationMethod(method);
+  tracker.setDepthNormalSamplingStep(1, 1);
+  tracker.setDepthNormalNbThreads(nbThreads);
+  CHECK(tracker.getDepthNormalNbThreads() == nbThreads);
+  tracker.loadModel(modelFile);
+  tracker.initFromPose(I, cMo_init);
+
+  vpHomogeneousMatrix cMo;
+  for (int iter = 0; iter < 5; ++iter) {
+    tracker.track(point_cloud, I.getWidth(), I.getHeight());
+    tracker.getPose(cMo);
+  }
+  return cMo;
+}
+}
+
+TEST_CASE("Depth normal tracking", "[mbt_depth_normal]")
+{
+  const std::string directory = vpIoTools::makeTempDirectory(vpIoTools::getTempPath() + "/visp_test_mbt_depth");
+  const std::string modelFile = vpIoTools::createFilePath(directory, "cube.cao");
+  {
+    std::ofstream file(modelFile.c_str());
+    file << g_cubeModel;
+  }
+
+  const unsigned int width = 320, height = 240;
+  const vpCameraParameters cam(300, 300, width / 2., height / 2.);
+  const vpImage<unsigned char> I(height, width);
+
+  // The camera sees three faces of the cube from one of its corners
+  const vpHomogeneousMatrix cMo =
+    vpHomogeneousMatrix(0, 0, 0.25, vpMath::rad(-35), vpMath::rad(-30), 0) *
+    vpHomogeneousMatrix(g_cubeSize / 2, -g_cubeSize / 2, -g_cubeSize / 2, 0, 0, 0);
+  std::vector<vpColVector> point_cloud;
+  renderPointCloud(cMo, cam, width, height, point_cloud);
+
+  // Small displacement as between two successive frames
+  const vpHomogeneousMatrix cMo_init =
+    vpHomogeneousMatrix(0.001, -0.001, 0.002, vpMath::rad(0.5), vpMath::rad(-0.5), vpMath::rad(1)) * cMo;
+
+  const vpMbtFaceDepthNormal::vpFeatureEstimationType methods[2] = { vpMbtFaceDepthNormal::ROBUST_FEATURE_ESTIMATION,
+                                                                     vpMbtFaceDepthNormal::ROBUST_SVD_PLANE_ESTIMATION };
+  for (int m = 0; m < 2; ++m) {
+    INFO("Feature estimation method: " << methods[m]);
+    const vpHomogeneousMatrix cMo_est = track(methods[m], 1, modelFile, cam, I, cMo_init, point_cloud);
+    const vpHomogeneousMatrix cdMc = cMo * cMo_est.inverse();
+    CHECK(cdMc.getTranslationVector().frobeniusNorm() < 1e-3);
+    CHECK(vpThetaUVector(cdMc.getRotationMatrix()).getTheta() < vpMath::rad(0.5));
+
+    // The features of the faces do not depend on the number of threads
+    const vpHomogeneousMatrix cMo_parallel = track(methods[m], 3, modelFile, cam, I, cMo_init, point_cloud);
+    for (unsigned int i = 0; i < 3; ++i) {
+      for (unsigned int j = 0; j < 4; ++j) {
+        CHECK(cMo_parallel[i][j] == cMo_est[i][j]);
+      }
+    }
+  }
+
+  vpIoTools::remove(directory);
+}
+
+TEST_CASE("Virtual visual servoing workspace in steady state", "[mbt_depth_normal]")
+{
+  const std::string directory = vpIoTools::makeTempDirectory(vpIoTools::getTempPath() + "/visp_test_mbt_depth");
+  const std::string modelFile = vpIoTools::createFilePath(directory, "cube.cao");
+  {
+    std::ofstream file(modelFile.c_str());
+    file << g_cubeModel;
+  }
+
+  const unsigned int width = 320, height = 240;
+  const vpCameraParameters cam(300, 300, width / 2., height / 2.);
+  const vpImage<unsigned char> I(height, width);
+  const vpHomogeneousMatrix cMo =
+    vpHomogeneousMatrix(0, 0, 0.25, vpMath::rad(-35), vpMath::rad(-30), 0) *
+    vpHomogeneousMatrix(g_cubeSize / 2, -g_cubeSize / 2, -g_cubeSize / 2, 0, 0, 0);
+  std::vector<vpColVector> point_cloud;
+  renderPointCloud(cMo, cam, width, height, point_cloud);
+
+  vpMbGenericTracker tracker(1, vpMbGenericTracker::DEPTH_NORMAL_TRACKER);
+  tracker.setCameraParameters(cam);
+  tracker.setDepthNormalSamplingStep(2, 2);
+  tracker.loadModel(modelFile);
+  tracker.initFromPose(I, cMo);
+
+  std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+  std::map<std::string, const std::vector<vpColVector> *> mapOfPointClouds;
+  std::map<std::string, unsigned int> mapOfWidths, mapOfHeights;
+  const std::string cameraName = tracker.getReferenceCameraName();
+  mapOfImages[cameraName] = &I;
+  mapOfPointClouds[cameraName] = &point_cloud;
+  mapOfWidths[cameraName] = width;
+  mapOfHeights[cameraName] = height;
+
+  // The buffers are sized by the first frame, then reused as long as the number of features does not change
+  tracker.track(mapOfImages, mapOfPointClouds, mapOfWidths, mapOfHeights);
+  CHECK(tracker.getNbVVSResizes() > 0);
+  const unsigned int nbFeatures = tracker.getNbFeaturesDepthNormal();
+  for (int iter = 0; iter < 3; ++iter) {
+    tracker.track(mapOfImages, mapOfPointClouds, mapOfWidths, mapOfHeights);
+    REQUIRE(tracker.getNbFeaturesDepthNormal() == nbFeatures);
+    CHECK(tracker.getNbVVSResizes() == 0);
+  }
+
+  vpIoTools::remove(directory);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  std::cout << (numFailed ? "Test failed" : "Test succeed") << std::endl;
+  return numFailed;
+}
+
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
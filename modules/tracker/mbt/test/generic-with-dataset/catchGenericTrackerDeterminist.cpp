@@ -285,6 +285,78 @@ TEST_CASE("Check Stereo MBT determinism parallel", "[MBT_determinism]")
   checkPoses(cMo1, cMo2);
 }
 
+TEST_CASE("Check Stereo MBT determinism with parallel VVS", "[MBT_determinism]")
+{
+  // First tracker, cameras processed sequentially in the VVS scheme
+  vpMbGenericTracker tracker1(2);
+  vpCameraParameters cam;
+  configureTracker(tracker1, cam);
+
+  vpImage<unsigned char> I;
+  vpHomogeneousMatrix cMo1;
+  for (int cpt = 0; read_data(cpt, I); cpt++) {
+    tracker1.track(I, I);
+    tracker1.getPose(cMo1);
+  }
+
+  // Second tracker, cameras processed in parallel in the VVS scheme
+  vpMbGenericTracker tracker2(2);
+  configureTracker(tracker2, cam);
+  tracker2.setUseParallelVVS(true);
+  tracker2.setNbParallelVVSThreads(2);
+  CHECK(tracker2.getUseParallelVVS());
+  CHECK(tracker2.getNbParallelVVSThreads() == 2);
+
+  vpHomogeneousMatrix cMo2;
+  for (int cpt = 0; read_data(cpt, I); cpt++) {
+    tracker2.track(I, I);
+    tracker2.getPose(cMo2);
+  }
+  std::cout << "Run stereo trackers with sequential and parallel VVS" << std::endl;
+  std::cout << "First tracker, final cMo:\n" << cMo1 << std::endl;
+  std::cout << "Second tracker, final cMo:\n" << cMo2 << std::endl;
+
+  // Check that both poses are identical
+  checkPoses(cMo1, cMo2);
+}
+
+TEST_CASE("Check Stereo MBT with normal equations", "[MBT_determinism]")
+{
+  // First tracker, pose estimated from the stacked interaction matrix
+  vpMbGenericTracker tracker1(2);
+  vpCameraParameters cam;
+  configureTracker(tracker1, cam);
+
+  vpImage<unsigned char> I;
+  vpHomogeneousMatrix cMo1;
+  for (int cpt = 0; read_data(cpt, I); cpt++) {
+    tracker1.track(I, I);
+    tracker1.getPose(cMo1);
+  }
+
+  // Second tracker, pose estimated from the accumulated normal equations
+  vpMbGenericTracker tracker2(2);
+  configureTracker(tracker2, cam);
+  tracker2.setUseNormalEquations(true);
+  CHECK(tracker2.getUseNormalEquations());
+
+  vpHomogeneousMatrix cMo2;
+  for (int cpt = 0; read_data(cpt, I); cpt++) {
+    tracker2.track(I, I);
+    tracker2.getPose(cMo2);
+  }
+  std::cout << "Run stereo trackers with stacked interaction matrix and normal equations" << std::endl;
+  std::cout << "First tracker, final cMo:\n" << cMo1 << std::endl;
+  std::cout << "Second tracker, final cMo:\n" << cMo2 << std::endl;
+
+  // Both poses are the same up to rounding errors
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 4; j++) {
+      CHECK(cMo1[i][j] == Catch::Approx(cMo2[i][j]).margin(1e-6));
+    }
+  }
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session;
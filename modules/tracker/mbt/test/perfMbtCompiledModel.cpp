@@ -0,0 +1,138 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2026 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark the loading of a CAD model with and without the compiled model cache.
+ */
+
+/*!
+  \example perfMbtCompiledModel.cpp
+ */
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#if defined(VISP_BUILD_CATCH2)
+#include <catch_amalgamated.hpp>
+#else // Since v3.1.1
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <fstream>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+bool runBenchmark = false;
+
+// Grid of size x size square faces described by their points
+void writeGridModel(const std::string &filename, unsigned int size)
+{
+  std::ofstream file(filename.c_str());
+  file << "V1\n" << (size + 1) * (size + 1) << "\n";
+  for (unsigned int i = 0; i <= size; ++i) {
+    for (unsigned int j = 0; j <= size; ++j) {
+      file << 0.01 * j << " " << 0.01 * i << " 0\n";
+    }
+  }
+  file << "0\n0\n" << size * size << "\n";
+  for (unsigned int i = 0; i < size; ++i) {
+    for (unsigned int j = 0; j < size; ++j) {
+      const unsigned int p = (i * (size + 1)) + j;
+      file << "4 " << p << " " << p + 1 << " " << p + size + 2 << " " << p + size + 1 << "\n";
+    }
+  }
+  file << "0\n0\n";
+}
+}
+
+TEST_CASE("Benchmark compiled model cache", "[benchmark]")
+{
+  if (runBenchmark) {
+    const std::string directory = vpIoTools::makeTempDirectory(vpIoTools::getTempPath() + "/visp_perf_mbt_model");
+    const std::string modelFile = vpIoTools::createFilePath(directory, "grid.cao");
+    writeGridModel(modelFile, 60);
+
+    const int trackerTypes[] = { vpMbGenericTracker::EDGE_TRACKER, vpMbGenericTracker::DEPTH_NORMAL_TRACKER };
+    const std::string trackerNames[] = { "edge", "depth normal" };
+    for (size_t i = 0; i < 2; ++i) {
+      {
+        vpMbGenericTracker tracker(1, trackerTypes[i]);
+        tracker.setCompiledModelCache(true);
+        tracker.loadModel(modelFile);
+      }
+
+      BENCHMARK("Parse the model - " + trackerNames[i])
+      {
+        vpMbGenericTracker tracker(1, trackerTypes[i]);
+        tracker.loadModel(modelFile);
+        return tracker.getFaces().size();
+      };
+
+      BENCHMARK("Load the compiled model - " + trackerNames[i])
+      {
+        vpMbGenericTracker tracker(1, trackerTypes[i]);
+        tracker.setCompiledModelCache(true);
+        tracker.loadModel(modelFile);
+        CHECK(tracker.isModelLoadedFromCache());
+        return tracker.getFaces().size();
+      };
+    }
+
+    vpIoTools::remove(directory);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  auto cli = session.cli()         // Get Catch's composite command line parser
+    | Catch::Clara::Opt(runBenchmark)   // bind variable to a new option, with a hint string
+    ["--benchmark"] // the option names it will respond to
+    ("run benchmark comparing the parsing of the model with the compiled model cache"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+
+#else
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+#endif
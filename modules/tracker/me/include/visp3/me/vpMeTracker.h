@@ -173,6 +173,13 @@ public:
    */
   inline int getNbPoints() const { return m_nGoodElement; }
 
+  /*!
+   * Return the number of threads used to track the moving-edges sites.
+   *
+   * \sa setNbThreads()
+   */
+  inline unsigned int getNbThreads() const { return m_nbThreads; }
+
   /*!
    * Initialize the tracker.
    */
@@ -261,6 +268,19 @@ public:
    */
   void setMeList(const std::list<vpMeSite> &meList) { m_meList = meList; }
 
+  /*!
+   * Set the number of threads used to track the moving-edges sites in track(). The sites are
+   * independent, so that they are partitioned between the threads. The result is the same
+   * whatever the number of threads.
+   *
+   * \param[in] nbThreads : Number of threads. When set to 1 (default), the sites are tracked sequentially.
+   * When set to 0, the number of threads is chosen by OpenMP.
+   *
+   * \note Only effective when ViSP is built with OpenMP support. The sites are always tracked sequentially
+   * when a display type is set with setDisplay(), since the display functions are not thread-safe.
+   */
+  void setNbThreads(unsigned int nbThreads) { m_nbThreads = nbThreads; }
+
   /*!
    * Return the total number of moving-edges.
    */
@@ -314,6 +334,8 @@ protected:
   const vpImage<bool> *m_maskCandidates;
   //! Moving-edges display type
   vpMeSite::vpMeSiteDisplayType m_selectDisplay;
+  //! Number of threads used to track the moving-edges sites
+  unsigned int m_nbThreads;
   //@}
 
 };
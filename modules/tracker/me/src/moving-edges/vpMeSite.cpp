@@ -65,6 +65,24 @@ static bool outsideImage(int i, int j, int half, int rows, int cols)
   int half_3 = half + 3;
   return ((0 < (half_1 - i)) || (((i - rows) + half_3) > 0) || (0 < (half_1 - j)) || (((j - cols) + half_3) > 0));
 }
+
+/*!
+ * Convolution of the image with a msize x msize mask centered on pixel (i, j). The mask coefficients are
+ * stored row by row, so that each row of the mask is applied to a contiguous row of the image.
+ */
+static double convolveMask(const vpImage<unsigned char> &I, const double *mask, unsigned int msize, unsigned int i,
+                           unsigned int j)
+{
+  const unsigned int half = (msize - 1) >> 1;
+  double conv = 0.0;
+  for (unsigned int a = 0; a < msize; ++a, mask += msize) {
+    const unsigned char *row = I[(i - half) + a] + (j - half);
+    for (unsigned int b = 0; b < msize; ++b) {
+      conv += mask[b] * row[b];
+    }
+  }
+  return conv;
+}
 #endif
 
 void vpMeSite::init()
@@ -274,19 +292,8 @@ double vpMeSite::convolution(const vpImage<unsigned char> &I, const vpMe *me)
   else {
     unsigned int mask_index = computeMaskIndex(m_alpha, *me);
 
-    unsigned int i_ = static_cast<unsigned int>(m_i);
-    unsigned int j_ = static_cast<unsigned int>(m_j);
-    unsigned int half_ = static_cast<unsigned int>(half);
-
-    unsigned int ihalf = i_ - half_;
-    unsigned int jhalf = j_ - half_;
-
-    for (unsigned int a = 0; a < msize; ++a) {
-      unsigned int ihalfa = ihalf + a;
-      for (unsigned int b = 0; b < msize; ++b) {
-        conv += m_mask_sign * me->getMask()[mask_index][a][b] * I(ihalfa, jhalf + b);
-      }
-    }
+    conv = m_mask_sign * convolveMask(I, me->getMask()[mask_index].data, msize, static_cast<unsigned int>(m_i),
+                                      static_cast<unsigned int>(m_j));
   }
   return conv;
 }
@@ -310,19 +317,8 @@ double vpMeSite::convolution(const vpImage<unsigned char> &I, const vpMe &me, co
     m_j = 0;
   }
   else {
-    unsigned int i_ = static_cast<unsigned int>(m_i);
-    unsigned int j_ = static_cast<unsigned int>(m_j);
-    unsigned int half_ = static_cast<unsigned int>(half);
-
-    unsigned int ihalf = i_ - half_;
-    unsigned int jhalf = j_ - half_;
-
-    for (unsigned int a = 0; a < msize; ++a) {
-      unsigned int ihalfa = ihalf + a;
-      for (unsigned int b = 0; b < msize; ++b) {
-        conv += m_mask_sign * me.getMask()[mask_index][a][b] * I(ihalfa, jhalf + b);
-      }
-    }
+    conv = m_mask_sign * convolveMask(I, me.getMask()[mask_index].data, msize, static_cast<unsigned int>(m_i),
+                                      static_cast<unsigned int>(m_j));
   }
   return conv;
 }
@@ -336,28 +332,52 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, const bool
 
   // range = +/- range of pixels within which the correspondent
   // of the current pixel will be sought
-  unsigned int range = me->getRange();
-  const unsigned int normalSides = 2;
-  const unsigned int numQueries = range * normalSides + 1;
+  const int range = static_cast<int>(me->getRange());
   unsigned int mask_index = computeMaskIndex(m_alpha, *me);
-  vpMeSite *list_query_pixels = getQueryList(I, static_cast<int>(range));
 
   double contrast_max = 1 + me->getMu2();
   double contrast_min = 1 - me->getMu1();
 
   double threshold = computeFinalThreshold(*me);
 
-  if (test_contrast) { // likelihood test
-    double diff = 1e6;
+  if (test_contrast) {
     // Change of mask sign to have a continuity at 0 and 180.
     // Threshold at 120 to be more than the 90 initial value
     if (vpMath::abs(static_cast<int>(mask_index - m_index_prev)) > 120) {
       m_mask_sign = -m_mask_sign;
     }
-    for (unsigned int n = 0; n < numQueries; ++n) {
-      // Convolution results
-      list_query_pixels[n].m_mask_sign = m_mask_sign;
-      double convolution_ = list_query_pixels[n].convolution(I, *me, mask_index);
+  }
+
+  // The query sites along the normal are not stored: their position is computed on the fly and the mask that
+  // corresponds to the site orientation is applied directly to the image
+  const int height = static_cast<int>(I.getHeight());
+  const int width = static_cast<int>(I.getWidth());
+  const unsigned int msize = me->getMaskSize();
+  const int border = static_cast<int>((msize - 1) >> 1) + me->getStrip();
+  const double *mask = me->getMask()[mask_index].data;
+  const double salpha = sin(m_alpha);
+  const double calpha = cos(m_alpha);
+  const bool displayRange = (m_selectDisplay == RANGE_RESULT) || (m_selectDisplay == RANGE);
+  double diff = 1e6;
+
+  for (int k = -range; k <= range; ++k) {
+    double ii = m_ifloat + (k * salpha);
+    double jj = m_jfloat + (k * calpha);
+
+    // Display
+    if (displayRange) {
+      vpDisplay::displayCross(I, vpImagePoint(ii, jj), 1, vpColor::yellow);
+    }
+
+    int i_query = static_cast<int>(ii);
+    int j_query = static_cast<int>(jj);
+    double convolution_ = 0.0;
+    if (!outsideImage(i_query, j_query, border, height, width)) {
+      convolution_ = m_mask_sign * convolveMask(I, mask, msize, static_cast<unsigned int>(i_query),
+                                                static_cast<unsigned int>(j_query));
+    }
+
+    if (test_contrast) { // likelihood test
       // no fabs since m_convlt > 0 and we look for a similar one
       const double likelihood = convolution_ + m_convlt;
 
@@ -367,22 +387,21 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, const bool
           diff = fabs(1 - contrast);
           max_convolution = convolution_;
           max = likelihood;
-          max_rank = static_cast<int>(n);
+          max_rank = k + range;
         }
       }
     }
-  }
-  else { // test on contrast only
-    for (unsigned int n = 0; n < numQueries; ++n) {
-      // Convolution results
-      double convolution_ = list_query_pixels[n].convolution(I, me);
+    else { // test on contrast only
       const double likelihood = fabs(2 * convolution_);
       if ((likelihood > max) && (likelihood > threshold)) {
         max_convolution = convolution_;
         max = likelihood;
-        max_rank = static_cast<int>(n);
+        max_rank = k + range;
       }
     }
+  }
+
+  if (!test_contrast) {
     // in case max_convolution < 0, change of mask sign so that m_convlt > 0
     // for the future likelihood tests
     if (max_convolution < 0) {
@@ -391,28 +410,35 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, const bool
     }
   }
 
-  vpImagePoint ip;
-
   if (max_rank >= 0) {
-    if ((m_selectDisplay == RANGE_RESULT) || (m_selectDisplay == RESULT)) {
-      ip.set_i(list_query_pixels[max_rank].m_i);
-      ip.set_j(list_query_pixels[max_rank].m_j);
-      vpDisplay::displayPoint(I, ip, vpColor::red);
+    // The site is replaced by the query site of max likelihood
+    const int k = max_rank - range;
+    m_ifloat = m_ifloat + (k * salpha);
+    m_jfloat = m_jfloat + (k * calpha);
+    m_i = static_cast<int>(m_ifloat);
+    m_j = static_cast<int>(m_jfloat);
+    if (outsideImage(m_i, m_j, border, height, width)) {
+      m_i = 0;
+      m_j = 0;
     }
 
-    list_query_pixels[max_rank].m_mask_sign = m_mask_sign;
-    list_query_pixels[max_rank].m_index_prev = mask_index;
-    list_query_pixels[max_rank].m_convlt = max_convolution;
-    list_query_pixels[max_rank].m_normGradient = vpMath::sqr(max_convolution);
+    if ((m_selectDisplay == RANGE_RESULT) || (m_selectDisplay == RESULT)) {
+      vpDisplay::displayPoint(I, vpImagePoint(m_i, m_j), vpColor::red);
+    }
 
-    *this = list_query_pixels[max_rank]; // The vpMeSite2 is replaced by the vpMeSite2 of max likelihood
+    m_index_prev = mask_index;
+    m_convlt = max_convolution;
+    m_normGradient = vpMath::sqr(max_convolution);
+    m_weight = 1;
+    m_state = NO_SUPPRESSION;
   }
   else // none of the query sites is better than the threshold
   {
     if ((m_selectDisplay == RANGE_RESULT) || (m_selectDisplay == RESULT)) {
-      ip.set_i(list_query_pixels[0].m_i);
-      ip.set_j(list_query_pixels[0].m_j);
-      vpDisplay::displayPoint(I, ip, vpColor::green);
+      // First query site
+      double ii = m_ifloat - (range * salpha);
+      double jj = m_jfloat - (range * calpha);
+      vpDisplay::displayPoint(I, vpImagePoint(static_cast<int>(ii), static_cast<int>(jj)), vpColor::green);
     }
     m_normGradient = 0;
     if (std::fabs(contrast) > std::numeric_limits<double>::epsilon()) {
@@ -421,9 +447,7 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, const bool
     else {
       m_state = THRESHOLD; // threshold suppression
     }
-
   }
-  delete[] list_query_pixels;
 }
 
 void vpMeSite::trackMultipleHypotheses(const vpImage<unsigned char> &I, const vpMe &me, const bool &test_contrast,
@@ -41,8 +41,13 @@
 #include <visp3/me/vpMeTracker.h>
 
 #include <algorithm>
+#include <vector>
 #include <visp3/core/vpTrackingException.h>
 
+#if defined(VISP_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
 BEGIN_VISP_NAMESPACE
 
 void vpMeTracker::init()
@@ -54,13 +59,15 @@ void vpMeTracker::init()
 }
 
 vpMeTracker::vpMeTracker()
-  : m_meList(), m_me(nullptr), m_nGoodElement(0), m_mask(nullptr), m_maskCandidates(nullptr), m_selectDisplay(vpMeSite::NONE)
+  : m_meList(), m_me(nullptr), m_nGoodElement(0), m_mask(nullptr), m_maskCandidates(nullptr), m_selectDisplay(vpMeSite::NONE),
+  m_nbThreads(1)
 {
   init();
 }
 
 vpMeTracker::vpMeTracker(const vpMeTracker &meTracker)
-  : vpTracker(meTracker), m_meList(), m_me(nullptr), m_nGoodElement(0), m_mask(nullptr), m_maskCandidates(nullptr), m_selectDisplay(vpMeSite::NONE)
+  : vpTracker(meTracker), m_meList(), m_me(nullptr), m_nGoodElement(0), m_mask(nullptr), m_maskCandidates(nullptr), m_selectDisplay(vpMeSite::NONE),
+  m_nbThreads(1)
 {
   init();
 
@@ -68,6 +75,7 @@ vpMeTracker::vpMeTracker(const vpMeTracker &meTracker)
   m_meList = meTracker.m_meList;
   m_nGoodElement = meTracker.m_nGoodElement;
   m_selectDisplay = meTracker.m_selectDisplay;
+  m_nbThreads = meTracker.m_nbThreads;
 }
 
 void vpMeTracker::reset()
@@ -84,6 +92,7 @@ vpMeTracker &vpMeTracker::operator=(vpMeTracker &meTracker)
   m_me = meTracker.m_me;
   m_selectDisplay = meTracker.m_selectDisplay;
   m_nGoodElement = meTracker.m_nGoodElement;
+  m_nbThreads = meTracker.m_nbThreads;
   return *this;
 }
 
@@ -222,6 +231,40 @@ void vpMeTracker::track(const vpImage<unsigned char> &I)
 
   m_nGoodElement = 0;
 
+#if defined(VISP_HAVE_OPENMP)
+  int nbThreads = (m_nbThreads == 0) ? omp_get_max_threads() : static_cast<int>(m_nbThreads);
+  if ((nbThreads > 1) && (m_selectDisplay == vpMeSite::NONE)) {
+    // The sites are stored in a list, that cannot be accessed randomly
+    std::vector<vpMeSite *> sites;
+    sites.reserve(m_meList.size());
+    for (std::list<vpMeSite>::iterator it = m_meList.begin(); it != m_meList.end(); ++it) {
+      if (it->getState() == vpMeSite::NO_SUPPRESSION) {
+        sites.push_back(&(*it));
+      }
+    }
+
+    int nbGoodElement = 0;
+    int nbSites = static_cast<int>(sites.size());
+#pragma omp parallel for num_threads(nbThreads) reduction(+:nbGoodElement)
+    for (int i = 0; i < nbSites; ++i) {
+      vpMeSite &s = *sites[i];
+      s.track(I, m_me, true);
+
+      if (vpMeTracker::inRoiMask(m_mask, static_cast<unsigned int>(s.get_i()), static_cast<unsigned int>(s.get_j()))) {
+        if (s.getState() == vpMeSite::NO_SUPPRESSION) {
+          ++nbGoodElement;
+        }
+      }
+      else {
+        // Site outside mask
+        s.setState(vpMeSite::OUTSIDE_ROI_MASK);
+      }
+    }
+    m_nGoodElement = nbGoodElement;
+    return;
+  }
+#endif
+
   // Loop through list of sites to track
   std::list<vpMeSite>::iterator it = m_meList.begin();
   std::list<vpMeSite>::iterator end = m_meList.end();
@@ -0,0 +1,154 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2026 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the moving-edges tracking on synthetic images.
+ */
+
+/*!
+  \example catchMeTracker.cpp
+
+  \brief Test the moving-edges tracking of a line on synthetic images, with one or several threads.
+*/
+
+#include <iostream>
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <cmath>
+
+#include <visp3/me/vpMeLine.h>
+
+#if defined(VISP_BUILD_CATCH2)
+#include <catch_amalgamated.hpp>
+#else // Since v3.1.1
+#include <catch2/catch_all.hpp>
+#endif
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+/*
+  Image of a straight edge between a dark and a bright area, slightly blurred
+  and textured so that the likelihood of the sites differs along the edge.
+*/
+vpImage<unsigned char> createEdgeImage(double offset)
+{
+  const unsigned int height = 240, width = 320;
+  const double theta = vpMath::rad(20);
+  vpImage<unsigned char> I(height, width);
+  for (unsigned int i = 0; i < height; ++i) {
+    for (unsigned int j = 0; j < width; ++j) {
+      // Signed distance to the line
+      const double d = (j * std::cos(theta)) + (i * std::sin(theta)) - (150 + offset);
+      const double step = 1. / (1. + std::exp(-d));
+      const double texture = 10. * std::sin(0.3 * i) * std::cos(0.2 * j);
+      I[i][j] = static_cast<unsigned char>(vpMath::saturate<unsigned char>(60. + (120. * step) + texture));
+    }
+  }
+  return I;
+}
+
+void trackLine(unsigned int nbThreads, vpMeLine &line, vpMe &me)
+{
+  me.setRange(10);
+  me.setSampleStep(4);
+  me.setLikelihoodThresholdType(vpMe::NORMALIZED_THRESHOLD);
+  me.setThreshold(20);
+  me.setMaskSize(5);
+  me.setMaskNumber(180);
+
+  line.setMe(&me);
+  line.setDisplay(vpMeSite::NONE);
+  line.setNbThreads(nbThreads);
+  CHECK(line.getNbThreads() == nbThreads);
+
+  const double theta = vpMath::rad(20);
+  // Two points of the line j cos(theta) + i sin(theta) = 150
+  const vpImagePoint ip1(30, (150 - (30 * std::sin(theta))) / std::cos(theta));
+  const vpImagePoint ip2(210, (150 - (210 * std::sin(theta))) / std::cos(theta));
+  line.initTracking(createEdgeImage(0), ip1, ip2);
+
+  for (int frame = 1; frame <= 3; ++frame) {
+    line.track(createEdgeImage(1.5 * frame));
+  }
+}
+} // namespace
+
+TEST_CASE("Moving-edges line tracking", "[me]")
+{
+  vpMe me_ref;
+  vpMeLine line_ref;
+  trackLine(1, line_ref, me_ref);
+
+  // The edge moved by 4.5 pixels along the normal of the line
+  CHECK(std::fabs(line_ref.getRho()) == Catch::Approx(154.5).margin(1.));
+  CHECK(line_ref.getNbPoints() > 30);
+
+  SECTION("Independence on the number of threads")
+  {
+    vpMe me;
+    vpMeLine line;
+    trackLine(4, line, me);
+
+    std::list<vpMeSite> &sites_ref = line_ref.getMeList();
+    std::list<vpMeSite> &sites = line.getMeList();
+    REQUIRE(sites.size() == sites_ref.size());
+    std::list<vpMeSite>::const_iterator it_ref = sites_ref.begin();
+    for (std::list<vpMeSite>::const_iterator it = sites.begin(); it != sites.end(); ++it, ++it_ref) {
+      CHECK(it->get_i() == it_ref->get_i());
+      CHECK(it->get_j() == it_ref->get_j());
+      CHECK(it->get_ifloat() == it_ref->get_ifloat());
+      CHECK(it->get_jfloat() == it_ref->get_jfloat());
+      CHECK(it->getState() == it_ref->getState());
+      CHECK(it->getWeight() == it_ref->getWeight());
+    }
+    CHECK(line.getNbPoints() == line_ref.getNbPoints());
+    CHECK(line.getRho() == line_ref.getRho());
+    CHECK(line.getTheta() == line_ref.getTheta());
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  std::cout << (numFailed ? "Test failed" : "Test succeed") << std::endl;
+  return numFailed;
+}
+
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
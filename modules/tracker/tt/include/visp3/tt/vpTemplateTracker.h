@@ -46,6 +46,7 @@
 
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImagePyramid.h>
 #include <visp3/tt/vpTemplateTrackerHeader.h>
 #include <visp3/tt/vpTemplateTrackerWarp.h>
 #include <visp3/tt/vpTemplateTrackerZone.h>
@@ -272,6 +273,7 @@ public:
   void setUseBrent(bool b) { useBrent = b; }
 
   void track(const vpImage<unsigned char> &I);
+  void track(const vpImagePyramid &pyramid);
   void trackRobust(const vpImage<unsigned char> &I);
 
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
@@ -302,6 +304,7 @@ protected:
   virtual void initTrackingPyr(const vpImage<unsigned char> &I, vpTemplateTrackerZone &zone);
   virtual void trackNoPyr(const vpImage<unsigned char> &I) = 0;
   virtual void trackPyr(const vpImage<unsigned char> &I);
+  void trackPyramid(const vpImagePyramid &pyramid);
 };
 END_VISP_NAMESPACE
 #endif
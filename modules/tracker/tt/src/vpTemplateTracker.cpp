@@ -715,17 +715,31 @@ void vpTemplateTracker::track(const vpImage<unsigned char> &I)
     trackNoPyr(I);
 }
 
+/*!
+   Track the template on an image given by its pyramid. The Gaussian levels used by the tracker are computed in the
+   pyramid, so that they are available to its other consumers.
+   \param pyramid : Pyramid of the image to process.
+ */
+void vpTemplateTracker::track(const vpImagePyramid &pyramid)
+{
+  if (nbLvlPyr > 1)
+    trackPyramid(pyramid);
+  else
+    trackNoPyr(pyramid.getImage());
+}
+
 void vpTemplateTracker::trackPyr(const vpImage<unsigned char> &I)
 {
-  vpImage<unsigned char> *pyr_I;
-  pyr_I = new vpImage<unsigned char>[nbLvlPyr]; // Why +1 ?
-  pyr_I[0] = I;
+  vpImagePyramid pyramid(I);
+  trackPyramid(pyramid);
+}
 
+void vpTemplateTracker::trackPyramid(const vpImagePyramid &pyramid)
+{
   try {
     vpColVector ptemp(nbParam);
     if (nbLvlPyr > 1) {
       for (unsigned int i = 1; i < nbLvlPyr; i++) {
-        vpImageFilter::getGaussPyramidal(pyr_I[i - 1], pyr_I[i]);
         Warp->getParamPyramidDown(p, ptemp);
         p = ptemp;
         zoneTracked = &zoneTrackedPyr[i];
@@ -741,7 +755,7 @@ void vpTemplateTracker::trackPyr(const vpImage<unsigned char> &I)
           H = HdesirePyr[i];
           HLM = HLMdesirePyr[i];
           HLMdesireInverse = HLMdesireInversePyr[i];
-          trackRobust(pyr_I[i]);
+          trackRobust(pyramid.getLevel(static_cast<unsigned int>(i)));
         }
         if (i > 0) {
           Warp->getParamPyramidUp(p, ptemp);
@@ -751,12 +765,10 @@ void vpTemplateTracker::trackPyr(const vpImage<unsigned char> &I)
       }
     }
     else {
-      trackRobust(I);
+      trackRobust(pyramid.getImage());
     }
-    delete[] pyr_I;
   }
   catch (const vpException &e) {
-    delete[] pyr_I;
     throw(vpTrackingException(vpTrackingException::badValue, e.getMessage()));
   }
 }
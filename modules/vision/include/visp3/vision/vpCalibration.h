@@ -186,6 +186,39 @@ public:
   static int computeCalibrationMulti(vpCalibrationMethodType method, std::vector<vpCalibration> &table_cal,
                                      vpCameraParameters &cam_est, double &globalReprojectionError, bool verbose = false);
 
+  /*!
+   * Compute the multi-images calibration of a camera mounted on the end-effector
+   * of a robot (eye-in-hand configuration), estimating together the intrinsic
+   * parameters and the hand-eye transformation.
+   *
+   * The calibration is first done with computeCalibrationMulti(), then
+   * vpHandEyeCalibration::calibrate() gives an initial estimation of the hand-eye
+   * transformation from the poses of the images and the \ref rMe positions of
+   * the end-effector. The intrinsic parameters, \f$ ^e{\bf M}_c \f$ and
+   * \f$ ^r{\bf M}_o \f$ are finally refined by minimizing the reprojection
+   * error of all the images, the pose of each image being
+   * \f$ ^c{\bf M}_o = (^r{\bf M}_e \; ^e{\bf M}_c)^{-1} \; ^r{\bf M}_o \f$.
+   *
+   * \param method : Method used to estimate the camera parameters.
+   * \param table_cal : Vector of vpCalibration, with \ref rMe set for each image.
+   * At least 3 images are required. The resulting hand-eye transformation is
+   * also set in \ref eMc, or in \ref eMc_dist with a method estimating the
+   * distortion.
+   * \param cam_est : Estimated intrinsic camera parameters.
+   * \param eMc_est : Estimated transformation between the end-effector and the camera.
+   * \param rMo_est : Estimated transformation between the robot reference frame and the object.
+   * \param globalReprojectionError : Global reprojection error or global
+   * residual.
+   * \param verbose : Set at true if information about the residual at
+   * each loop of the algorithm is hoped.
+   *
+   * \return EXIT_SUCCESS if the calibration succeed, EXIT_FAILURE otherwise.
+   */
+  static int computeCalibrationMultiHandEye(vpCalibrationMethodType method, std::vector<vpCalibration> &table_cal,
+                                            vpCameraParameters &cam_est, vpHomogeneousMatrix &eMc_est,
+                                            vpHomogeneousMatrix &rMo_est, double &globalReprojectionError,
+                                            bool verbose = false);
+
   /*!
    * Compute and return the standard deviation expressed in pixel
    * for pose matrix and camera intrinsic parameters.
@@ -246,6 +279,13 @@ public:
   //! Get the gain of the virtual visual servoing algorithm.
   static double getLambda() { return m_gain; }
 
+  /*!
+   * Get the number of threads used by the multi-images calibration.
+   *
+   * \sa setNbThreads()
+   */
+  static int getNbThreads() { return m_nbThreads; }
+
   /*!
    * Get the residual in pixels.
    */
@@ -297,6 +337,17 @@ public:
    */
   static void setLambda(const double &lambda) { m_gain = lambda; }
 
+  /*!
+   * Set the number of threads used by the multi-images calibration to compute
+   * in parallel the interaction matrices of the images. Their contributions are
+   * always summed in the order of the images, whatever the number of threads.
+   *
+   * \param nbThreads : Number of threads. A value lower or equal to 0 (default)
+   * uses the number of threads given by OpenMP. Without OpenMP the images are
+   * processed sequentially.
+   */
+  static void setNbThreads(int nbThreads) { m_nbThreads = nbThreads; }
+
   /*!
    * Set pixel aspect ratio px/py.
    *
@@ -331,6 +382,11 @@ private:
   static void calibVVSWithDistortionMulti(std::vector<vpCalibration> &table_cal, vpCameraParameters &cam,
                                           double &globalReprojectionError, bool verbose = false,
                                           double aspect_ratio = -1);
+  static void calibVVSMultiSparse(std::vector<vpCalibration> &table_cal, vpCameraParameters &cam,
+                                  double &globalReprojectionError, bool verbose, double aspect_ratio, bool distortion);
+  static void calibVVSHandEyeMulti(std::vector<vpCalibration> &table_cal, vpCameraParameters &cam,
+                                   vpHomogeneousMatrix &eMc, vpHomogeneousMatrix &rMo, double &globalReprojectionError,
+                                   bool verbose, double aspect_ratio, bool distortion);
 
   unsigned int m_npt; //!< number of points used in calibration computation
   std::list<double> m_LoX, m_LoY, m_LoZ; //!< list of points coordinates (3D in meters)
@@ -343,6 +399,7 @@ private:
   static double m_threshold;
   static unsigned int m_nbIterMax;
   static double m_gain;
+  static int m_nbThreads;
 };
 END_VISP_NAMESPACE
 #endif
@@ -333,7 +333,9 @@ public:
    * \return True if we found at least 4 points with a reprojection
    * error below ransacThreshold.
    * \note You can enable a multithreaded version if you have C++11 enabled using setUseParallelRansac().
-   * The number of threads used can then be set with setNbParallelRansacThreads().
+   * The number of threads used can then be set with setNbParallelRansacThreads(). The result of the multithreaded
+   * version only depends on the seed set with setRansacSeed(), not on the number of threads, and the number of
+   * trials can be adapted to the inlier ratio with setRansacProbability().
    * Filter flag can be used  with setRansacFilterFlag().
    */
   bool poseRansac(vpHomogeneousMatrix &cMo, FuncCheckValidityPose func = nullptr);
@@ -485,6 +487,41 @@ public:
    */
   inline void setNbParallelRansacThreads(int nb) { nbParallelRansacThreads = nb; }
 
+  /*!
+   * Get the probability used to adapt the number of trials of the parallel RANSAC implementation.
+   *
+   * \sa setRansacProbability
+   */
+  inline double getRansacProbability() const { return ransacProbability; }
+
+  /*!
+   * Set the probability that at least one of the random samples drawn by the parallel RANSAC implementation is free
+   * from outliers. When positive, the number of trials is adapted to the best inlier ratio found so far
+   * using computeRansacIterations(), and is bounded by the number set with setRansacMaxTrials().
+   *
+   * \param probability : Probability in ]0, 1[, for example 0.99. When 0 (default), the trials only stop when the
+   * consensus is reached or when the maximum number of trials is done.
+   * \note Only used with the parallel version, see setUseParallelRansac().
+   */
+  inline void setRansacProbability(double probability) { ransacProbability = probability; }
+
+  /*!
+   * Get the seed of the random number generator of the parallel RANSAC implementation.
+   *
+   * \sa setRansacSeed
+   */
+  inline unsigned int getRansacSeed() const { return ransacSeed; }
+
+  /*!
+   * Set the seed of the random number generator of the parallel RANSAC implementation. Each trial draws its
+   * random sample from its own stream, so that the estimated pose only depends on the seed and not on the number of
+   * threads.
+   *
+   * \param seed : Seed, 0 by default.
+   * \note Only used with the parallel version, see setUseParallelRansac().
+   */
+  inline void setRansacSeed(unsigned int seed) { ransacSeed = seed; }
+
   /*!
    * \return True if the parallel RANSAC version should be used (depends also to C++11 availability).
    *
@@ -832,6 +869,10 @@ private:
   bool useParallelRansac;
   //! Number of threads to spawn for the parallel RANSAC implementation
   int nbParallelRansacThreads;
+  //! Probability used to adapt the number of trials of the parallel RANSAC implementation, 0 to disable
+  double ransacProbability;
+  //! Seed of the random number generator of the parallel RANSAC implementation
+  unsigned int ransacSeed;
   //! Stop the optimization loop when the residual change (|r-r_prec|) <=
   //! epsilon
   double vvsEpsilon;
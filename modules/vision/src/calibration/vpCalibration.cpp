@@ -39,6 +39,7 @@
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/vision/vpCalibration.h>
+#include <visp3/vision/vpHandEyeCalibration.h>
 #include <visp3/vision/vpPose.h>
 
 BEGIN_VISP_NAMESPACE
@@ -46,6 +47,7 @@ BEGIN_VISP_NAMESPACE
 double vpCalibration::m_threshold = 1e-10f;
 unsigned int vpCalibration::m_nbIterMax = 4000;
 double vpCalibration::m_gain = 0.25;
+int vpCalibration::m_nbThreads = 0;
 
 int vpCalibration::init()
 {
@@ -451,6 +453,74 @@ int vpCalibration::computeCalibrationMulti(vpCalibrationMethodType method, std::
   }
 }
 
+int vpCalibration::computeCalibrationMultiHandEye(vpCalibrationMethodType method, std::vector<vpCalibration> &table_cal,
+                                                  vpCameraParameters &cam_est, vpHomogeneousMatrix &eMc_est,
+                                                  vpHomogeneousMatrix &rMo_est, double &globalReprojectionError,
+                                                  bool verbose)
+{
+  unsigned int nbPose = static_cast<unsigned int>(table_cal.size());
+  if (nbPose < 3) {
+    if (verbose) {
+      std::cout << "At least 3 images are required to estimate the hand-eye transformation." << std::endl;
+    }
+    return EXIT_FAILURE;
+  }
+
+  int ret = computeCalibrationMulti(method, table_cal, cam_est, globalReprojectionError, verbose);
+  if (ret != EXIT_SUCCESS) {
+    return ret;
+  }
+
+  bool distortion = (method == CALIB_VIRTUAL_VS_DIST) || (method == CALIB_LAGRANGE_VIRTUAL_VS_DIST);
+  std::vector<vpHomogeneousMatrix> cMo_vec(nbPose), rMe_vec(nbPose);
+  for (unsigned int i = 0; i < nbPose; i++) {
+    cMo_vec[i] = distortion ? table_cal[i].cMo_dist : table_cal[i].cMo;
+    rMe_vec[i] = table_cal[i].rMe;
+  }
+  if (vpHandEyeCalibration::calibrate(cMo_vec, rMe_vec, eMc_est, rMo_est) != 0) {
+    if (verbose) {
+      std::cout << "Unable to compute the hand-eye transformation." << std::endl;
+    }
+    return EXIT_FAILURE;
+  }
+
+  if (verbose) {
+    std::cout << "Compute camera parameters and hand-eye transformation" << std::endl;
+  }
+  calibVVSHandEyeMulti(table_cal, cam_est, eMc_est, rMo_est, globalReprojectionError, verbose,
+                       table_cal[0].m_aspect_ratio, distortion);
+
+  for (unsigned int p = 0; p < nbPose; p++) {
+    if (distortion) {
+      table_cal[p].cam_dist = cam_est;
+      table_cal[p].computeStdDeviation_dist(table_cal[p].cMo_dist, cam_est);
+    }
+    else {
+      table_cal[p].cMo_dist = table_cal[p].cMo;
+      table_cal[p].eMc_dist = table_cal[p].eMc;
+      table_cal[p].cam = cam_est;
+      table_cal[p].cam_dist = cam_est;
+      double deviation, deviation_dist;
+      table_cal[p].computeStdDeviation(deviation, deviation_dist);
+    }
+  }
+
+  // Print camera parameters
+  if (verbose) {
+    cam_est.printParameters();
+    std::cout << "eMc: " << std::endl << eMc_est << std::endl;
+  }
+
+  if (cam_est.get_px() < 0 || cam_est.get_py() < 0 || cam_est.get_u0() < 0 || cam_est.get_v0() < 0) {
+    if (verbose) {
+      std::cout << "Unable to calibrate the camera. Estimated parameters are negative." << std::endl;
+    }
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
 int vpCalibration::writeData(const std::string &filename)
 {
   std::ofstream f(filename.c_str());
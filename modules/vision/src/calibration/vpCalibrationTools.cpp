@@ -34,12 +34,278 @@
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpVelocityTwistMatrix.h>
 #include <visp3/vision/vpCalibration.h>
 #include <visp3/vision/vpPose.h>
 
+#include <algorithm> // std::min, std::max
 #include <cmath>  // std::fabs
 
+#if defined(VISP_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
 BEGIN_VISP_NAMESPACE
+namespace
+{
+/*!
+  Number of intrinsic parameters estimated by the multi-images calibration:
+  (u0, v0, px) or (u0, v0, px, py), followed by (kdu, kud) with distortion.
+*/
+unsigned int getNbCameraParameters(double aspect_ratio, bool distortion)
+{
+  return (distortion ? 5 : 3) + (aspect_ratio > 0. ? 0 : 1);
+}
+
+/*!
+  Compute the error and the interaction matrix of the points of one image.
+  The interaction matrix is split between the columns related to the pose of
+  the image and the columns related to the intrinsic parameters shared by all
+  the images. Without distortion each point gives 2 rows, with distortion 4
+  rows: 2 for the distorted to undistorted model and 2 for the undistorted to
+  distorted model.
+
+  \return The sum of the squared errors, halved with distortion.
+*/
+double computeImageInteraction(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam, double aspect_ratio,
+                               bool distortion, const vpColVector &oX, const vpColVector &oY, const vpColVector &oZ,
+                               const vpColVector &u, const vpColVector &v, unsigned int first, unsigned int nbPoint,
+                               vpMatrix &L_pose, vpMatrix &L_cam, vpColVector &error)
+{
+  const unsigned int nbRows = (distortion ? 4 : 2) * nbPoint;
+  L_pose.resize(nbRows, 6, false, false);
+  L_cam.resize(nbRows, getNbCameraParameters(aspect_ratio, distortion), true, false);
+  error.resize(nbRows, false);
+
+  double px, py;
+  if (aspect_ratio > 0.) {
+    px = cam.get_px();
+    py = px / aspect_ratio;
+  }
+  else {
+    px = cam.get_px(); // default
+    py = cam.get_py();
+  }
+  double u0 = cam.get_u0();
+  double v0 = cam.get_v0();
+
+  double inv_px = 1 / px;
+  double inv_py = 1 / py;
+
+  double kud = cam.get_kud();
+  double kdu = cam.get_kdu();
+
+  double k2ud = 2 * kud;
+  double k2du = 2 * kdu;
+
+  double r = 0;
+  for (unsigned int i = 0; i < nbPoint; i++) {
+    unsigned int curPoint = first + i;
+    double x = oX[curPoint] * cMo[0][0] + oY[curPoint] * cMo[0][1] + oZ[curPoint] * cMo[0][2] + cMo[0][3];
+    double y = oX[curPoint] * cMo[1][0] + oY[curPoint] * cMo[1][1] + oZ[curPoint] * cMo[1][2] + cMo[1][3];
+    double z = oX[curPoint] * cMo[2][0] + oY[curPoint] * cMo[2][1] + oZ[curPoint] * cMo[2][2] + cMo[2][3];
+
+    double inv_z = 1 / z;
+    double X = x * inv_z;
+    double Y = y * inv_z;
+
+    double X2 = X * X;
+    double Y2 = Y * Y;
+    double XY = X * Y;
+
+    double up = u[curPoint];
+    double vp = v[curPoint];
+
+    if (!distortion) {
+      unsigned int curInd = 2 * i;
+      error[curInd] = X * px + u0 - up;
+      error[curInd + 1] = Y * py + v0 - vp;
+      r += vpMath::sqr(error[curInd]) + vpMath::sqr(error[curInd + 1]);
+
+      L_pose[curInd][0] = px * (-inv_z);
+      L_pose[curInd][1] = 0;
+      L_pose[curInd][2] = px * (X * inv_z);
+      L_pose[curInd][3] = px * XY;
+      L_pose[curInd][4] = -px * (1 + X2);
+      L_pose[curInd][5] = px * Y;
+
+      L_cam[curInd][0] = 1;
+      L_cam[curInd][2] = X;
+
+      curInd++;
+      L_pose[curInd][0] = 0;
+      L_pose[curInd][1] = py * (-inv_z);
+      L_pose[curInd][2] = py * (Y * inv_z);
+      L_pose[curInd][3] = py * (1 + Y2);
+      L_pose[curInd][4] = -py * XY;
+      L_pose[curInd][5] = -py * X;
+
+      L_cam[curInd][1] = 1;
+      L_cam[curInd][aspect_ratio > 0. ? 2 : 3] = Y;
+      continue;
+    }
+
+    double up0 = up - u0;
+    double vp0 = vp - v0;
+
+    double xp0 = up0 * inv_px;
+    double xp02 = xp0 * xp0;
+
+    double yp0 = vp0 * inv_py;
+    double yp02 = yp0 * yp0;
+
+    double r2du = xp02 + yp02;
+    double kr2du = kdu * r2du;
+
+    double r2ud = X2 + Y2;
+    double kr2ud = 1 + kud * r2ud;
+
+    double Axx = px * (kr2ud + k2ud * X2);
+    double Axy = px * k2ud * XY;
+    double Ayy = py * (kr2ud + k2ud * Y2);
+    double Ayx = py * k2ud * XY;
+
+    unsigned int curInd = 4 * i;
+    error[curInd] = u0 + px * X - kr2du * (up0) - up;
+    error[curInd + 1] = v0 + py * Y - kr2du * (vp0) - vp;
+    error[curInd + 2] = u0 + px * X * kr2ud - up;
+    error[curInd + 3] = v0 + py * Y * kr2ud - vp;
+    r += (vpMath::sqr(error[curInd]) + vpMath::sqr(error[curInd + 1]) + vpMath::sqr(error[curInd + 2]) +
+          vpMath::sqr(error[curInd + 3])) *
+      0.5;
+
+    //---distorted to undistorted
+    {
+      L_pose[curInd][0] = px * (-inv_z);
+      L_pose[curInd][1] = 0;
+      L_pose[curInd][2] = px * X * inv_z;
+      L_pose[curInd][3] = px * X * Y;
+      L_pose[curInd][4] = -px * (1 + X2);
+      L_pose[curInd][5] = px * Y;
+    }
+    {
+      L_cam[curInd][0] = 1 + kr2du + k2du * xp02;
+      L_cam[curInd][1] = k2du * up0 * yp0 * inv_py;
+      if (aspect_ratio > 0.) {
+        L_cam[curInd][2] = X + k2du * xp02 * xp0 + k2du * up0 * yp02 * inv_py;
+        L_cam[curInd][3] = -(up0) * (r2du);
+      }
+      else {
+        L_cam[curInd][2] = X + k2du * xp02 * xp0;
+        L_cam[curInd][3] = k2du * up0 * yp02 * inv_py;
+        L_cam[curInd][4] = -(up0) * (r2du);
+      }
+    }
+    curInd++;
+    {
+      L_pose[curInd][0] = 0;
+      L_pose[curInd][1] = py * (-inv_z);
+      L_pose[curInd][2] = py * Y * inv_z;
+      L_pose[curInd][3] = py * (1 + Y2);
+      L_pose[curInd][4] = -py * XY;
+      L_pose[curInd][5] = -py * X;
+    }
+    {
+      L_cam[curInd][0] = k2du * xp0 * vp0 * inv_px;
+      L_cam[curInd][1] = 1 + kr2du + k2du * yp02;
+      if (aspect_ratio > 0.) {
+        L_cam[curInd][2] = k2du * vp0 * xp02 * inv_px + Y + k2du * yp02 * yp0;
+        L_cam[curInd][3] = -vp0 * r2du;
+      }
+      else {
+        L_cam[curInd][2] = k2du * vp0 * xp02 * inv_px;
+        L_cam[curInd][3] = Y + k2du * yp02 * yp0;
+        L_cam[curInd][4] = -vp0 * r2du;
+      }
+    }
+    curInd++;
+    //---undistorted to distorted
+    {
+      L_pose[curInd][0] = Axx * (-inv_z);
+      L_pose[curInd][1] = Axy * (-inv_z);
+      L_pose[curInd][2] = Axx * (X * inv_z) + Axy * (Y * inv_z);
+      L_pose[curInd][3] = Axx * X * Y + Axy * (1 + Y2);
+      L_pose[curInd][4] = -Axx * (1 + X2) - Axy * XY;
+      L_pose[curInd][5] = Axx * Y - Axy * X;
+    }
+    {
+      L_cam[curInd][0] = 1;
+      L_cam[curInd][2] = X * kr2ud;
+      L_cam[curInd][aspect_ratio > 0. ? 4 : 5] = px * X * r2ud;
+    }
+    curInd++;
+    {
+      L_pose[curInd][0] = Ayx * (-inv_z);
+      L_pose[curInd][1] = Ayy * (-inv_z);
+      L_pose[curInd][2] = Ayx * (X * inv_z) + Ayy * (Y * inv_z);
+      L_pose[curInd][3] = Ayx * XY + Ayy * (1 + Y2);
+      L_pose[curInd][4] = -Ayx * (1 + X2) - Ayy * XY;
+      L_pose[curInd][5] = Ayx * Y - Ayy * X;
+    }
+    {
+      L_cam[curInd][1] = 1;
+      L_cam[curInd][aspect_ratio > 0. ? 2 : 3] = Y * kr2ud;
+      L_cam[curInd][aspect_ratio > 0. ? 4 : 5] = py * Y * r2ud;
+    }
+  }
+  return r;
+}
+
+/*!
+  Update the intrinsic parameters with the increment \e Tc of the parameters
+  ordered as in computeImageInteraction().
+*/
+void updateCameraParameters(vpCameraParameters &cam, double aspect_ratio, bool distortion, const vpColVector &Tc)
+{
+  double px, py;
+  if (aspect_ratio > 0.) {
+    px = cam.get_px();
+    py = px / aspect_ratio;
+  }
+  else {
+    px = cam.get_px(); // default
+    py = cam.get_py();
+  }
+  double u0 = cam.get_u0();
+  double v0 = cam.get_v0();
+
+  if (!distortion) {
+    if (aspect_ratio > 0.) {
+      cam.initPersProjWithoutDistortion(px + Tc[2], (px + Tc[2]) / aspect_ratio, u0 + Tc[0], v0 + Tc[1]);
+    }
+    else { // default
+      cam.initPersProjWithoutDistortion(px + Tc[2], py + Tc[3], u0 + Tc[0], v0 + Tc[1]);
+    }
+  }
+  else {
+    double kud = cam.get_kud();
+    double kdu = cam.get_kdu();
+    if (aspect_ratio > 0.) {
+      cam.initPersProjWithDistortion(px + Tc[2], (px + Tc[2]) / aspect_ratio, u0 + Tc[0], v0 + Tc[1], kud + Tc[4],
+                                     kdu + Tc[3]);
+    }
+    else {
+      cam.initPersProjWithDistortion(px + Tc[2], py + Tc[3], u0 + Tc[0], v0 + Tc[1], kud + Tc[5], kdu + Tc[4]);
+    }
+  }
+}
+
+/*!
+  Return the number of threads used to process the images in parallel.
+*/
+int getNbThreadsToUse(int nbThreads, unsigned int nbPose)
+{
+#if defined(VISP_HAVE_OPENMP)
+  int n = nbThreads > 0 ? nbThreads : omp_get_max_threads();
+  return std::max<int>(1, std::min<int>(n, static_cast<int>(nbPose)));
+#else
+  (void)nbThreads;
+  (void)nbPose;
+  return 1;
+#endif
+}
+} // namespace
+
 void vpCalibration::calibLagrange(vpCameraParameters &cam_est, vpHomogeneousMatrix &cMo_est)
 {
 
@@ -378,209 +644,9 @@ void vpCalibration::calibVVS(vpCameraParameters &cam_est, vpHomogeneousMatrix &c
 void vpCalibration::calibVVSMulti(std::vector<vpCalibration> &table_cal, vpCameraParameters &cam_est,
                                   double &globalReprojectionError, bool verbose, double aspect_ratio)
 {
-  std::ios::fmtflags original_flags(std::cout.flags());
-  std::cout.precision(10);
-  unsigned int nbPoint[256];     // number of points by image
-  unsigned int nbPointTotal = 0; // total number of points
-  unsigned int nbPose = static_cast<unsigned int>(table_cal.size());
-  unsigned int nbPose6 = 6 * nbPose;
-
-  for (unsigned int i = 0; i < nbPose; i++) {
-    nbPoint[i] = table_cal[i].m_npt;
-    nbPointTotal += nbPoint[i];
-  }
-
-  if (nbPointTotal < 4) {
-    // vpERROR_TRACE("Not enough point to calibrate");
-    throw(vpCalibrationException(vpCalibrationException::notInitializedError, "Not enough point to calibrate"));
-  }
-
-  vpColVector oX(nbPointTotal), cX(nbPointTotal);
-  vpColVector oY(nbPointTotal), cY(nbPointTotal);
-  vpColVector oZ(nbPointTotal), cZ(nbPointTotal);
-  vpColVector u(nbPointTotal);
-  vpColVector v(nbPointTotal);
-
-  vpColVector P(2 * nbPointTotal);
-  vpColVector Pd(2 * nbPointTotal);
-  vpImagePoint ip;
-
-  unsigned int curPoint = 0; // current point index
-  for (unsigned int p = 0; p < nbPose; p++) {
-    std::list<double>::const_iterator it_LoX = table_cal[p].m_LoX.begin();
-    std::list<double>::const_iterator it_LoY = table_cal[p].m_LoY.begin();
-    std::list<double>::const_iterator it_LoZ = table_cal[p].m_LoZ.begin();
-    std::list<vpImagePoint>::const_iterator it_Lip = table_cal[p].m_Lip.begin();
-
-    for (unsigned int i = 0; i < nbPoint[p]; i++) {
-      oX[curPoint] = *it_LoX;
-      oY[curPoint] = *it_LoY;
-      oZ[curPoint] = *it_LoZ;
-
-      ip = *it_Lip;
-      u[curPoint] = ip.get_u();
-      v[curPoint] = ip.get_v();
-
-      ++it_LoX;
-      ++it_LoY;
-      ++it_LoZ;
-      ++it_Lip;
-
-      curPoint++;
-    }
-  }
-  //  double lambda = 0.1 ;
-  unsigned int iter = 0;
-
-  double residu_1 = 1e12;
-  double r = 1e12 - 1;
-  while (vpMath::equal(residu_1, r, m_threshold) == false && iter < m_nbIterMax) {
-
-    iter++;
-    residu_1 = r;
-
-    double px, py;
-    if (aspect_ratio > 0.) {
-      px = cam_est.get_px();
-      py = px / aspect_ratio;
-    }
-    else {
-      px = cam_est.get_px(); // default
-      py = cam_est.get_py();
-    }
-    double u0 = cam_est.get_u0();
-    double v0 = cam_est.get_v0();
-
-    r = 0;
-    curPoint = 0; // current point index
-    for (unsigned int p = 0; p < nbPose; p++) {
-      vpHomogeneousMatrix cMoTmp = table_cal[p].cMo;
-      for (unsigned int i = 0; i < nbPoint[p]; i++) {
-        unsigned int curPoint2 = 2 * curPoint;
-
-        cX[curPoint] =
-          oX[curPoint] * cMoTmp[0][0] + oY[curPoint] * cMoTmp[0][1] + oZ[curPoint] * cMoTmp[0][2] + cMoTmp[0][3];
-        cY[curPoint] =
-          oX[curPoint] * cMoTmp[1][0] + oY[curPoint] * cMoTmp[1][1] + oZ[curPoint] * cMoTmp[1][2] + cMoTmp[1][3];
-        cZ[curPoint] =
-          oX[curPoint] * cMoTmp[2][0] + oY[curPoint] * cMoTmp[2][1] + oZ[curPoint] * cMoTmp[2][2] + cMoTmp[2][3];
-
-        Pd[curPoint2] = u[curPoint];
-        Pd[curPoint2 + 1] = v[curPoint];
-
-        P[curPoint2] = cX[curPoint] / cZ[curPoint] * px + u0;
-        P[curPoint2 + 1] = cY[curPoint] / cZ[curPoint] * py + v0;
-
-        r += (vpMath::sqr(P[curPoint2] - Pd[curPoint2]) + vpMath::sqr(P[curPoint2 + 1] - Pd[curPoint2 + 1]));
-        curPoint++;
-      }
-    }
-
-    vpColVector error;
-    error = P - Pd;
-    // r = r/nbPointTotal ;
-
-    vpMatrix L(nbPointTotal * 2, nbPose6 + 3 + (aspect_ratio > 0. ? 0 : 1));
-    curPoint = 0; // current point index
-    for (unsigned int p = 0; p < nbPose; p++) {
-      unsigned int q = 6 * p;
-      for (unsigned int i = 0; i < nbPoint[p]; i++) {
-        unsigned int curPoint2 = 2 * curPoint;
-        unsigned int curPoint21 = curPoint2 + 1;
-
-        double x = cX[curPoint];
-        double y = cY[curPoint];
-        double z = cZ[curPoint];
-
-        double inv_z = 1 / z;
-
-        double X = x * inv_z;
-        double Y = y * inv_z;
-
-        //---------------
-        {
-          {
-            L[curPoint2][q] = px * (-inv_z);
-            L[curPoint2][q + 1] = 0;
-            L[curPoint2][q + 2] = px * (X * inv_z);
-            L[curPoint2][q + 3] = px * X * Y;
-            L[curPoint2][q + 4] = -px * (1 + X * X);
-            L[curPoint2][q + 5] = px * Y;
-          }
-          {
-            L[curPoint2][nbPose6] = 1;
-            L[curPoint2][nbPose6 + 1] = 0;
-            if (aspect_ratio > 0.) {
-              L[curPoint2][nbPose6 + 2] = X;
-            }
-            else { // default
-              L[curPoint2][nbPose6 + 2] = X;
-              L[curPoint2][nbPose6 + 3] = 0;
-            }
-          }
-          {
-            L[curPoint21][q] = 0;
-            L[curPoint21][q + 1] = py * (-inv_z);
-            L[curPoint21][q + 2] = py * (Y * inv_z);
-            L[curPoint21][q + 3] = py * (1 + Y * Y);
-            L[curPoint21][q + 4] = -py * X * Y;
-            L[curPoint21][q + 5] = -py * X;
-          }
-          {
-            L[curPoint21][nbPose6] = 0;
-            L[curPoint21][nbPose6 + 1] = 1;
-            if (aspect_ratio > 0.) {
-              L[curPoint21][nbPose6 + 2] = Y;
-            }
-            else { // default
-              L[curPoint21][nbPose6 + 2] = 0;
-              L[curPoint21][nbPose6 + 3] = Y;
-            }
-          }
-        }
-        curPoint++;
-      } // end interaction
-    }
-    vpMatrix Lp;
-    Lp = L.pseudoInverse(1e-10);
-
-    vpColVector e;
-    e = Lp * error;
-
-    vpColVector Tc, Tc_v(nbPose6);
-    Tc = -e * m_gain;
-
-    //   Tc_v =0 ;
-    for (unsigned int i = 0; i < nbPose6; i++)
-      Tc_v[i] = Tc[i];
-
-    if (aspect_ratio > 0.) {
-      cam_est.initPersProjWithoutDistortion(px + Tc[nbPose6 + 2], (px + Tc[nbPose6 + 2]) / aspect_ratio,
-                                            u0 + Tc[nbPose6], v0 + Tc[nbPose6 + 1]);
-    }
-    else // default
-    {
-      cam_est.initPersProjWithoutDistortion(px + Tc[nbPose6 + 2], py + Tc[nbPose6 + 3], u0 + Tc[nbPose6],
-                                            v0 + Tc[nbPose6 + 1]);
-    }
-
-    //    cam.setKd(get_kd() + Tc[10]) ;
-    vpColVector Tc_v_Tmp(6);
+  calibVVSMultiSparse(table_cal, cam_est, globalReprojectionError, verbose, aspect_ratio, false);
 
-    for (unsigned int p = 0; p < nbPose; p++) {
-      for (unsigned int i = 0; i < 6; i++)
-        Tc_v_Tmp[i] = Tc_v[6 * p + i];
-
-      table_cal[p].cMo = vpExponentialMap::direct(Tc_v_Tmp, 1).inverse() * table_cal[p].cMo;
-    }
-
-    if (verbose)
-      std::cout << " std dev " << sqrt(r / nbPointTotal) << std::endl;
-  }
-  if (iter == m_nbIterMax) {
-    vpERROR_TRACE("Iterations number exceed the maximum allowed (%d)", m_nbIterMax);
-    throw(vpCalibrationException(vpCalibrationException::convergencyError, "Maximum number of iterations reached"));
-  }
+  unsigned int nbPose = static_cast<unsigned int>(table_cal.size());
   for (unsigned int p = 0; p < nbPose; p++) {
     table_cal[p].cMo_dist = table_cal[p].cMo;
     table_cal[p].cam = cam_est;
@@ -588,9 +654,6 @@ void vpCalibration::calibVVSMulti(std::vector<vpCalibration> &table_cal, vpCamer
     double deviation, deviation_dist;
     table_cal[p].computeStdDeviation(deviation, deviation_dist);
   }
-  globalReprojectionError = sqrt(r / nbPointTotal);
-  // Restore ostream format
-  std::cout.flags(original_flags);
 }
 
 void vpCalibration::calibVVSWithDistortion(vpCameraParameters &cam_est, vpHomogeneousMatrix &cMo_est, bool verbose)
@@ -874,12 +937,36 @@ void vpCalibration::calibVVSWithDistortionMulti(std::vector<vpCalibration> &tabl
 {
   std::ios::fmtflags original_flags(std::cout.flags());
   std::cout.precision(10);
-  unsigned int nbPoint[1024];    // number of points by image
-  unsigned int nbPointTotal = 0; // total number of points
+
+  calibVVSMultiSparse(table_cal, cam_est, globalReprojectionError, verbose, aspect_ratio, true);
+
+  unsigned int nbPose = static_cast<unsigned int>(table_cal.size());
+  for (unsigned int p = 0; p < nbPose; p++) {
+    table_cal[p].cam_dist = cam_est;
+    table_cal[p].computeStdDeviation_dist(table_cal[p].cMo_dist, cam_est);
+  }
+
+  if (verbose)
+    std::cout << " Global std dev " << globalReprojectionError << std::endl;
+
+  // Restore ostream format
+  std::cout.flags(original_flags);
+}
+
+void vpCalibration::calibVVSMultiSparse(std::vector<vpCalibration> &table_cal, vpCameraParameters &cam_est,
+                                        double &globalReprojectionError, bool verbose, double aspect_ratio,
+                                        bool distortion)
+{
+  std::ios::fmtflags original_flags(std::cout.flags());
+  std::cout.precision(10);
   unsigned int nbPose = static_cast<unsigned int>(table_cal.size());
-  unsigned int nbPose6 = 6 * nbPose;
+  std::vector<unsigned int> nbPoint(nbPose);    // number of points by image
+  std::vector<unsigned int> firstPoint(nbPose); // index of the first point of each image
+  unsigned int nbPointTotal = 0;                 // total number of points
+
   for (unsigned int i = 0; i < nbPose; i++) {
     nbPoint[i] = table_cal[i].m_npt;
+    firstPoint[i] = nbPointTotal;
     nbPointTotal += nbPoint[i];
   }
 
@@ -888,16 +975,12 @@ void vpCalibration::calibVVSWithDistortionMulti(std::vector<vpCalibration> &tabl
     throw(vpCalibrationException(vpCalibrationException::notInitializedError, "Not enough point to calibrate"));
   }
 
-  vpColVector oX(nbPointTotal), cX(nbPointTotal);
-  vpColVector oY(nbPointTotal), cY(nbPointTotal);
-  vpColVector oZ(nbPointTotal), cZ(nbPointTotal);
+  vpColVector oX(nbPointTotal);
+  vpColVector oY(nbPointTotal);
+  vpColVector oZ(nbPointTotal);
   vpColVector u(nbPointTotal);
   vpColVector v(nbPointTotal);
 
-  vpColVector P(4 * nbPointTotal);
-  vpColVector Pd(4 * nbPointTotal);
-  vpImagePoint ip;
-
   unsigned int curPoint = 0; // current point index
   for (unsigned int p = 0; p < nbPose; p++) {
     std::list<double>::const_iterator it_LoX = table_cal[p].m_LoX.begin();
@@ -909,10 +992,8 @@ void vpCalibration::calibVVSWithDistortionMulti(std::vector<vpCalibration> &tabl
       oX[curPoint] = *it_LoX;
       oY[curPoint] = *it_LoY;
       oZ[curPoint] = *it_LoZ;
-
-      ip = *it_Lip;
-      u[curPoint] = ip.get_u();
-      v[curPoint] = ip.get_v();
+      u[curPoint] = it_Lip->get_u();
+      v[curPoint] = it_Lip->get_v();
 
       ++it_LoX;
       ++it_LoY;
@@ -921,7 +1002,33 @@ void vpCalibration::calibVVSWithDistortionMulti(std::vector<vpCalibration> &tabl
       curPoint++;
     }
   }
-  //  double lambda = 0.1 ;
+
+  std::vector<vpHomogeneousMatrix> cMo_est(nbPose);
+  for (unsigned int p = 0; p < nbPose; p++) {
+    cMo_est[p] = distortion ? table_cal[p].cMo_dist : table_cal[p].cMo;
+  }
+
+  // Let L_p and K_p be the interaction matrices of the points of image p with
+  // respect to its pose and to the intrinsic parameters. The normal equations
+  // of the least squares problem have the block structure
+  //   | A_1         W_1 | |dp_1|   |g_1|
+  //   |     ...     ... | |... | = |...|
+  //   |         A_n W_n | |dp_n|   |g_n|
+  //   | W_1^T . W_n^T B | |dk  |   |g_k|
+  // with A_p = L_p^T L_p, W_p = L_p^T K_p and B = sum_p K_p^T K_p. The pose
+  // increments are eliminated with the Schur complement
+  // S = B - sum_p W_p^T A_p^-1 W_p, so that only 6x6 blocks and a system of the
+  // size of the intrinsic parameters have to be inverted, instead of the
+  // pseudo-inverse of the full interaction matrix.
+  const unsigned int nbCamParams = getNbCameraParameters(aspect_ratio, distortion);
+  std::vector<vpMatrix> Ainv(nbPose), W(nbPose), S_pose(nbPose);
+  std::vector<vpColVector> g(nbPose), gs_pose(nbPose);
+  std::vector<double> residual(nbPose);
+  const int nbPoseInt = static_cast<int>(nbPose); // OpenMP on Windows does not support unsigned loop index
+#if defined(VISP_HAVE_OPENMP)
+  const int nbThreads = getNbThreadsToUse(m_nbThreads, nbPose);
+#endif
+
   unsigned int iter = 0;
 
   double residu_1 = 1e12;
@@ -930,258 +1037,205 @@ void vpCalibration::calibVVSWithDistortionMulti(std::vector<vpCalibration> &tabl
     iter++;
     residu_1 = r;
 
-    r = 0;
-    curPoint = 0; // current point index
-    for (unsigned int p = 0; p < nbPose; p++) {
-      vpHomogeneousMatrix cMoTmp = table_cal[p].cMo_dist;
-      for (unsigned int i = 0; i < nbPoint[p]; i++) {
-        cX[curPoint] =
-          oX[curPoint] * cMoTmp[0][0] + oY[curPoint] * cMoTmp[0][1] + oZ[curPoint] * cMoTmp[0][2] + cMoTmp[0][3];
-        cY[curPoint] =
-          oX[curPoint] * cMoTmp[1][0] + oY[curPoint] * cMoTmp[1][1] + oZ[curPoint] * cMoTmp[1][2] + cMoTmp[1][3];
-        cZ[curPoint] =
-          oX[curPoint] * cMoTmp[2][0] + oY[curPoint] * cMoTmp[2][1] + oZ[curPoint] * cMoTmp[2][2] + cMoTmp[2][3];
-
-        curPoint++;
-      }
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nbThreads) schedule(dynamic) if (nbThreads > 1)
+#endif
+    for (int p_ = 0; p_ < nbPoseInt; p_++) {
+      const unsigned int p = static_cast<unsigned int>(p_);
+      vpMatrix L_pose, L_cam;
+      vpColVector error;
+      residual[p] = computeImageInteraction(cMo_est[p], cam_est, aspect_ratio, distortion, oX, oY, oZ, u, v,
+                                            firstPoint[p], nbPoint[p], L_pose, L_cam, error);
+
+      vpMatrix L_poseT = L_pose.t();
+      Ainv[p] = L_pose.AtA().pseudoInverse(1e-20);
+      W[p] = L_poseT * L_cam;
+      g[p] = L_poseT * error;
+
+      vpMatrix WtAinv = W[p].t() * Ainv[p];
+      S_pose[p] = L_cam.AtA() - WtAinv * W[p];
+      gs_pose[p] = L_cam.t() * error - WtAinv * g[p];
     }
 
-    vpMatrix L(nbPointTotal * 4, nbPose6 + 5 + (aspect_ratio > 0. ? 0 : 1));
-    curPoint = 0; // current point index
-    double px, py;
-    if (aspect_ratio > 0.) {
-      px = cam_est.get_px();
-      py = px / aspect_ratio;
-    }
-    else {
-      px = cam_est.get_px(); // default
-      py = cam_est.get_py();
+    // Reduction in the order of the images, the result does not depend on the number of threads
+    vpMatrix S(nbCamParams, nbCamParams);
+    vpColVector gs(nbCamParams);
+    r = 0;
+    for (unsigned int p = 0; p < nbPose; p++) {
+      S += S_pose[p];
+      gs += gs_pose[p];
+      r += residual[p];
     }
-    double u0 = cam_est.get_u0();
-    double v0 = cam_est.get_v0();
-
-    double inv_px = 1 / px;
-    double inv_py = 1 / py;
 
-    double kud = cam_est.get_kud();
-    double kdu = cam_est.get_kdu();
+    vpColVector Tc_cam = -m_gain * (S.pseudoInverse(1e-20) * gs);
+    updateCameraParameters(cam_est, aspect_ratio, distortion, Tc_cam);
 
-    double k2ud = 2 * kud;
-    double k2du = 2 * kdu;
-
-    for (unsigned int p = 0; p < nbPose; p++) {
-      unsigned int q = 6 * p;
-      for (unsigned int i = 0; i < nbPoint[p]; i++) {
-        unsigned int curPoint4 = 4 * curPoint;
-        double x = cX[curPoint];
-        double y = cY[curPoint];
-        double z = cZ[curPoint];
-
-        double inv_z = 1 / z;
-        double X = x * inv_z;
-        double Y = y * inv_z;
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nbThreads) if (nbThreads > 1)
+#endif
+    for (int p_ = 0; p_ < nbPoseInt; p_++) {
+      const unsigned int p = static_cast<unsigned int>(p_);
+      vpColVector Tc_v = Ainv[p] * (-m_gain * g[p] - W[p] * Tc_cam);
+      cMo_est[p] = vpExponentialMap::direct(Tc_v).inverse() * cMo_est[p];
+    }
 
-        double X2 = X * X;
-        double Y2 = Y * Y;
-        double XY = X * Y;
+    if (verbose)
+      std::cout << (distortion ? " std dev: " : " std dev ") << sqrt(r / nbPointTotal) << std::endl;
+  }
+  if (iter == m_nbIterMax) {
+    vpERROR_TRACE("Iterations number exceed the maximum allowed (%d)", m_nbIterMax);
+    throw(vpCalibrationException(vpCalibrationException::convergencyError, "Maximum number of iterations reached"));
+  }
 
-        double up = u[curPoint];
-        double vp = v[curPoint];
+  for (unsigned int p = 0; p < nbPose; p++) {
+    if (distortion) {
+      table_cal[p].cMo_dist = cMo_est[p];
+    }
+    else {
+      table_cal[p].cMo = cMo_est[p];
+    }
+  }
+  globalReprojectionError = sqrt(r / nbPointTotal);
+  // Restore ostream format
+  std::cout.flags(original_flags);
+}
 
-        Pd[curPoint4] = up;
-        Pd[curPoint4 + 1] = vp;
+void vpCalibration::calibVVSHandEyeMulti(std::vector<vpCalibration> &table_cal, vpCameraParameters &cam_est,
+                                         vpHomogeneousMatrix &eMc_est, vpHomogeneousMatrix &rMo_est,
+                                         double &globalReprojectionError, bool verbose, double aspect_ratio,
+                                         bool distortion)
+{
+  std::ios::fmtflags original_flags(std::cout.flags());
+  std::cout.precision(10);
+  unsigned int nbPose = static_cast<unsigned int>(table_cal.size());
+  std::vector<unsigned int> nbPoint(nbPose);    // number of points by image
+  std::vector<unsigned int> firstPoint(nbPose); // index of the first point of each image
+  unsigned int nbPointTotal = 0;                 // total number of points
 
-        double up0 = up - u0;
-        double vp0 = vp - v0;
+  for (unsigned int i = 0; i < nbPose; i++) {
+    nbPoint[i] = table_cal[i].m_npt;
+    firstPoint[i] = nbPointTotal;
+    nbPointTotal += nbPoint[i];
+  }
 
-        double xp0 = up0 * inv_px;
-        double xp02 = xp0 * xp0;
+  if (nbPointTotal < 4) {
+    throw(vpCalibrationException(vpCalibrationException::notInitializedError, "Not enough point to calibrate"));
+  }
 
-        double yp0 = vp0 * inv_py;
-        double yp02 = yp0 * yp0;
+  vpColVector oX(nbPointTotal);
+  vpColVector oY(nbPointTotal);
+  vpColVector oZ(nbPointTotal);
+  vpColVector u(nbPointTotal);
+  vpColVector v(nbPointTotal);
 
-        double r2du = xp02 + yp02;
-        double kr2du = kdu * r2du;
+  unsigned int curPoint = 0; // current point index
+  for (unsigned int p = 0; p < nbPose; p++) {
+    std::list<double>::const_iterator it_LoX = table_cal[p].m_LoX.begin();
+    std::list<double>::const_iterator it_LoY = table_cal[p].m_LoY.begin();
+    std::list<double>::const_iterator it_LoZ = table_cal[p].m_LoZ.begin();
+    std::list<vpImagePoint>::const_iterator it_Lip = table_cal[p].m_Lip.begin();
 
-        P[curPoint4] = u0 + px * X - kr2du * (up0);
-        P[curPoint4 + 1] = v0 + py * Y - kr2du * (vp0);
+    for (unsigned int i = 0; i < nbPoint[p]; i++) {
+      oX[curPoint] = *it_LoX;
+      oY[curPoint] = *it_LoY;
+      oZ[curPoint] = *it_LoZ;
+      u[curPoint] = it_Lip->get_u();
+      v[curPoint] = it_Lip->get_v();
 
-        double r2ud = X2 + Y2;
-        double kr2ud = 1 + kud * r2ud;
+      ++it_LoX;
+      ++it_LoY;
+      ++it_LoZ;
+      ++it_Lip;
+      curPoint++;
+    }
+  }
 
-        double Axx = px * (kr2ud + k2ud * X2);
-        double Axy = px * k2ud * XY;
-        double Ayy = py * (kr2ud + k2ud * Y2);
-        double Ayx = py * k2ud * XY;
+  std::vector<vpHomogeneousMatrix> eMr(nbPose);
+  for (unsigned int p = 0; p < nbPose; p++) {
+    eMr[p] = table_cal[p].rMe.inverse();
+  }
 
-        Pd[curPoint4 + 2] = up;
-        Pd[curPoint4 + 3] = vp;
+  // The pose of each image is given by the robot, cMo = eMc^-1 eMr rMo, so that
+  // the only unknowns are the intrinsic parameters, eMc and rMo. A motion v of
+  // the camera in the end-effector frame, eMc' = eMc exp(v), acts on the points
+  // as the camera motion of the pose block of the interaction matrix, while a
+  // motion w of the object in the robot reference frame, rMo' = rMo exp(w),
+  // acts as the camera motion -cVo w.
+  const unsigned int nbCamParams = getNbCameraParameters(aspect_ratio, distortion);
+  const unsigned int nbParams = nbCamParams + 12;
+  std::vector<vpMatrix> H_pose(nbPose);
+  std::vector<vpColVector> g_pose(nbPose);
+  std::vector<double> residual(nbPose);
+  const int nbPoseInt = static_cast<int>(nbPose); // OpenMP on Windows does not support unsigned loop index
+#if defined(VISP_HAVE_OPENMP)
+  const int nbThreads = getNbThreadsToUse(m_nbThreads, nbPose);
+#endif
 
-        P[curPoint4 + 2] = u0 + px * X * kr2ud;
-        P[curPoint4 + 3] = v0 + py * Y * kr2ud;
+  unsigned int iter = 0;
 
-        r += (vpMath::sqr(P[curPoint4] - Pd[curPoint4]) + vpMath::sqr(P[curPoint4 + 1] - Pd[curPoint4 + 1]) +
-              vpMath::sqr(P[curPoint4 + 2] - Pd[curPoint4 + 2]) + vpMath::sqr(P[curPoint4 + 3] - Pd[curPoint4 + 3])) *
-          0.5;
+  double residu_1 = 1e12;
+  double r = 1e12 - 1;
+  while (vpMath::equal(residu_1, r, m_threshold) == false && iter < m_nbIterMax) {
+    iter++;
+    residu_1 = r;
 
-        unsigned int curInd = curPoint4;
-        //---------------
-        {
-          {
-            L[curInd][q] = px * (-inv_z);
-            L[curInd][q + 1] = 0;
-            L[curInd][q + 2] = px * X * inv_z;
-            L[curInd][q + 3] = px * X * Y;
-            L[curInd][q + 4] = -px * (1 + X2);
-            L[curInd][q + 5] = px * Y;
-          }
-          {
-            L[curInd][nbPose6] = 1 + kr2du + k2du * xp02;
-            L[curInd][nbPose6 + 1] = k2du * up0 * yp0 * inv_py;
-            if (aspect_ratio > 0.) {
-              L[curInd][nbPose6 + 2] = X + k2du * xp02 * xp0 + k2du * up0 * yp02 * inv_py;
-              L[curInd][nbPose6 + 3] = -(up0) * (r2du);
-              L[curInd][nbPose6 + 4] = 0;
-            }
-            else {
-              L[curInd][nbPose6 + 2] = X + k2du * xp02 * xp0;
-              L[curInd][nbPose6 + 3] = k2du * up0 * yp02 * inv_py;
-              L[curInd][nbPose6 + 4] = -(up0) * (r2du);
-              L[curInd][nbPose6 + 5] = 0;
-            }
-          }
-          curInd++;
-          {
-            L[curInd][q] = 0;
-            L[curInd][q + 1] = py * (-inv_z);
-            L[curInd][q + 2] = py * Y * inv_z;
-            L[curInd][q + 3] = py * (1 + Y2);
-            L[curInd][q + 4] = -py * XY;
-            L[curInd][q + 5] = -py * X;
-          }
-          {
-            L[curInd][nbPose6] = k2du * xp0 * vp0 * inv_px;
-            L[curInd][nbPose6 + 1] = 1 + kr2du + k2du * yp02;
-            if (aspect_ratio > 0.) {
-              L[curInd][nbPose6 + 2] = k2du * vp0 * xp02 * inv_px + Y + k2du * yp02 * yp0;
-              L[curInd][nbPose6 + 3] = -vp0 * r2du;
-              L[curInd][nbPose6 + 4] = 0;
-            }
-            else {
-              L[curInd][nbPose6 + 2] = k2du * vp0 * xp02 * inv_px;
-              L[curInd][nbPose6 + 3] = Y + k2du * yp02 * yp0;
-              L[curInd][nbPose6 + 4] = -vp0 * r2du;
-              L[curInd][nbPose6 + 5] = 0;
-            }
-          }
-          curInd++;
-          //---undistorted to distorted
-          {
-            L[curInd][q] = Axx * (-inv_z);
-            L[curInd][q + 1] = Axy * (-inv_z);
-            L[curInd][q + 2] = Axx * (X * inv_z) + Axy * (Y * inv_z);
-            L[curInd][q + 3] = Axx * X * Y + Axy * (1 + Y2);
-            L[curInd][q + 4] = -Axx * (1 + X2) - Axy * XY;
-            L[curInd][q + 5] = Axx * Y - Axy * X;
-          }
-          {
-            L[curInd][nbPose6] = 1;
-            L[curInd][nbPose6 + 1] = 0;
-            if (aspect_ratio > 0.) {
-              L[curInd][nbPose6 + 2] = X * kr2ud;
-              L[curInd][nbPose6 + 3] = 0;
-              L[curInd][nbPose6 + 4] = px * X * r2ud;
-            }
-            else {
-              L[curInd][nbPose6 + 2] = X * kr2ud;
-              L[curInd][nbPose6 + 3] = 0;
-              L[curInd][nbPose6 + 4] = 0;
-              L[curInd][nbPose6 + 5] = px * X * r2ud;
-            }
-          }
-          curInd++;
-          {
-            L[curInd][q] = Ayx * (-inv_z);
-            L[curInd][q + 1] = Ayy * (-inv_z);
-            L[curInd][q + 2] = Ayx * (X * inv_z) + Ayy * (Y * inv_z);
-            L[curInd][q + 3] = Ayx * XY + Ayy * (1 + Y2);
-            L[curInd][q + 4] = -Ayx * (1 + X2) - Ayy * XY;
-            L[curInd][q + 5] = Ayx * Y - Ayy * X;
-          }
-          {
-            L[curInd][nbPose6] = 0;
-            L[curInd][nbPose6 + 1] = 1;
-            if (aspect_ratio > 0.) {
-              L[curInd][nbPose6 + 2] = Y * kr2ud;
-              L[curInd][nbPose6 + 3] = 0;
-              L[curInd][nbPose6 + 4] = py * Y * r2ud;
-            }
-            else {
-              L[curInd][nbPose6 + 2] = 0;
-              L[curInd][nbPose6 + 3] = Y * kr2ud;
-              L[curInd][nbPose6 + 4] = 0;
-              L[curInd][nbPose6 + 5] = py * Y * r2ud;
-            }
-          }
-        } // end interaction
-        curPoint++;
-      } // end interaction
+    const vpHomogeneousMatrix cMe = eMc_est.inverse();
+
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nbThreads) schedule(dynamic) if (nbThreads > 1)
+#endif
+    for (int p_ = 0; p_ < nbPoseInt; p_++) {
+      const unsigned int p = static_cast<unsigned int>(p_);
+      const vpHomogeneousMatrix cMo_p = cMe * eMr[p] * rMo_est;
+      vpMatrix L_pose, L_cam;
+      vpColVector error;
+      residual[p] = computeImageInteraction(cMo_p, cam_est, aspect_ratio, distortion, oX, oY, oZ, u, v,
+                                            firstPoint[p], nbPoint[p], L_pose, L_cam, error);
+
+      vpMatrix L(L_cam.getRows(), nbParams);
+      L.insert(L_cam, 0, 0);
+      L.insert(L_pose, 0, nbCamParams);
+      L.insert(-L_pose * vpVelocityTwistMatrix(cMo_p), 0, nbCamParams + 6);
+
+      H_pose[p] = L.AtA();
+      g_pose[p] = L.t() * error;
     }
 
-    vpColVector error;
-    error = P - Pd;
-    // r = r/nbPointTotal ;
-
-    vpMatrix Lp;
-    /*double rank =*/
-    L.pseudoInverse(Lp, 1e-10);
-    vpColVector e;
-    e = Lp * error;
-    vpColVector Tc, Tc_v(6 * nbPose);
-    Tc = -e * m_gain;
-    for (unsigned int i = 0; i < 6 * nbPose; i++)
-      Tc_v[i] = Tc[i];
-
-    if (aspect_ratio > 0.) {
-      cam_est.initPersProjWithDistortion(px + Tc[nbPose6 + 2], (px + Tc[nbPose6 + 2]) / aspect_ratio, u0 + Tc[nbPose6],
-                                         v0 + Tc[nbPose6 + 1], kud + Tc[nbPose6 + 4], kdu + Tc[nbPose6 + 3]);
-    }
-    else {
-      cam_est.initPersProjWithDistortion(px + Tc[nbPose6 + 2], py + Tc[nbPose6 + 3], u0 + Tc[nbPose6],
-                                         v0 + Tc[nbPose6 + 1], kud + Tc[nbPose6 + 5], kdu + Tc[nbPose6 + 4]);
+    // Reduction in the order of the images, the result does not depend on the number of threads
+    vpMatrix H(nbParams, nbParams);
+    vpColVector g(nbParams);
+    r = 0;
+    for (unsigned int p = 0; p < nbPose; p++) {
+      H += H_pose[p];
+      g += g_pose[p];
+      r += residual[p];
     }
 
-    vpColVector Tc_v_Tmp(6);
-    for (unsigned int p = 0; p < nbPose; p++) {
-      for (unsigned int i = 0; i < 6; i++)
-        Tc_v_Tmp[i] = Tc_v[6 * p + i];
+    vpColVector Tc = -m_gain * (H.pseudoInverse(1e-20) * g);
+    updateCameraParameters(cam_est, aspect_ratio, distortion, Tc.extract(0, nbCamParams));
+    eMc_est = eMc_est * vpExponentialMap::direct(Tc.extract(nbCamParams, 6));
+    rMo_est = rMo_est * vpExponentialMap::direct(Tc.extract(nbCamParams + 6, 6));
 
-      table_cal[p].cMo_dist = vpExponentialMap::direct(Tc_v_Tmp).inverse() * table_cal[p].cMo_dist;
-    }
     if (verbose)
-      std::cout << " std dev: " << sqrt(r / nbPointTotal) << std::endl;
-    // std::cout <<  "   residual: " << r << std::endl;
+      std::cout << " std dev " << sqrt(r / nbPointTotal) << std::endl;
   }
   if (iter == m_nbIterMax) {
     vpERROR_TRACE("Iterations number exceed the maximum allowed (%d)", m_nbIterMax);
     throw(vpCalibrationException(vpCalibrationException::convergencyError, "Maximum number of iterations reached"));
   }
 
-  // double perViewError;
-  // double totalError = 0;
-  // int totalPoints = 0;
+  const vpHomogeneousMatrix cMe = eMc_est.inverse();
   for (unsigned int p = 0; p < nbPose; p++) {
-    table_cal[p].cam_dist = cam_est;
-    // perViewError =
-    table_cal[p].computeStdDeviation_dist(table_cal[p].cMo_dist, cam_est);
-    // totalError += perViewError*perViewError * table_cal[p].npt;
-    // totalPoints += static_cast<int>(table_cal[p].npt);
+    if (distortion) {
+      table_cal[p].cMo_dist = cMe * eMr[p] * rMo_est;
+      table_cal[p].eMc_dist = eMc_est;
+    }
+    else {
+      table_cal[p].cMo = cMe * eMr[p] * rMo_est;
+      table_cal[p].eMc = eMc_est;
+    }
   }
-  globalReprojectionError = sqrt(r / (nbPointTotal));
-
-  if (verbose)
-    std::cout << " Global std dev " << globalReprojectionError << std::endl;
-
+  globalReprojectionError = sqrt(r / nbPointTotal);
   // Restore ostream format
   std::cout.flags(original_flags);
 }
@@ -46,10 +46,12 @@
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpRansac.h>
+#include <visp3/core/vpUniRand.h>
 #include <visp3/vision/vpPose.h>
 #include <visp3/vision/vpPoseException.h>
 
 #if defined(VISP_HAVE_THREADS)
+#include <atomic>
 #include <thread>
 #endif
 
@@ -159,6 +161,251 @@ struct FindDegeneratePoint
 
   vpPoint m_pt;
 };
+
+/*!
+ * Coordinates of the RANSAC points stored as contiguous arrays, to compute the reprojection error of all the points
+ * for a pose hypothesis in a loop that can be vectorized.
+ */
+class RansacPoints
+{
+public:
+  explicit RansacPoints(const std::vector<vpPoint> &points)
+    : m_oX(points.size()), m_oY(points.size()), m_oZ(points.size()), m_x(points.size()), m_y(points.size())
+  {
+    for (size_t i = 0; i < points.size(); ++i) {
+      m_oX[i] = points[i].get_oX();
+      m_oY[i] = points[i].get_oY();
+      m_oZ[i] = points[i].get_oZ();
+      m_x[i] = points[i].get_x();
+      m_y[i] = points[i].get_y();
+    }
+  }
+
+  /*!
+   * Compute the reprojection error of all the points. The operations are the same as vpPoint::track() followed by
+   * the computation of the distance to the measured point.
+   */
+  void computeErrors(const vpHomogeneousMatrix &cMo, std::vector<double> &errors) const
+  {
+    const double r00 = cMo[0][0], r01 = cMo[0][1], r02 = cMo[0][2], t0 = cMo[0][3];
+    const double r10 = cMo[1][0], r11 = cMo[1][1], r12 = cMo[1][2], t1 = cMo[1][3];
+    const double r20 = cMo[2][0], r21 = cMo[2][1], r22 = cMo[2][2], t2 = cMo[2][3];
+    const size_t size = m_oX.size();
+    errors.resize(size);
+    const double *oX = m_oX.data(), *oY = m_oY.data(), *oZ = m_oZ.data(), *x = m_x.data(), *y = m_y.data();
+    double *e = errors.data();
+    for (size_t i = 0; i < size; ++i) {
+      const double X = (r00 * oX[i]) + (r01 * oY[i]) + (r02 * oZ[i]) + t0;
+      const double Y = (r10 * oX[i]) + (r11 * oY[i]) + (r12 * oZ[i]) + t1;
+      const double Z = (r20 * oX[i]) + (r21 * oY[i]) + (r22 * oZ[i]) + t2;
+      const double dx = (X / Z) - x[i];
+      const double dy = (Y / Z) - y[i];
+      e[i] = std::sqrt((dx * dx) + (dy * dy));
+    }
+  }
+
+private:
+  std::vector<double> m_oX, m_oY, m_oZ, m_x, m_y;
+};
+
+/*!
+ * Get the points whose reprojection error is below the threshold, skipping the points degenerate with an already
+ * selected inlier when requested.
+ * \return The number of inliers.
+ */
+unsigned int selectInliers(const std::vector<vpPoint> &points, const std::vector<double> &errors, double threshold,
+                           bool checkDegeneratePoints, std::vector<unsigned int> *consensus)
+{
+  std::vector<vpPoint> inliers;
+  unsigned int nbInliers = 0;
+  const size_t size = errors.size();
+  for (size_t i = 0; i < size; ++i) {
+    if (errors[i] < threshold) {
+      bool degenerate = false;
+      if (checkDegeneratePoints) {
+        if (std::find_if(inliers.begin(), inliers.end(), FindDegeneratePoint(points[i])) != inliers.end()) {
+          degenerate = true;
+        }
+        else {
+          inliers.push_back(points[i]);
+        }
+      }
+
+      if (!degenerate) {
+        ++nbInliers;
+        if (consensus != nullptr) {
+          consensus->push_back(static_cast<unsigned int>(i));
+        }
+      }
+    }
+  }
+  return nbInliers;
+}
+
+#if defined(VISP_HAVE_THREADS)
+/*!
+ * Thread-parallel RANSAC whose result does not depend on the number of threads.
+ *
+ * Each trial draws its minimal sample from its own random stream, selected by the trial index, so that a trial
+ * always gives the same hypothesis whatever the thread that runs it. The threads take the trials in increasing order
+ * and share the index of the last trial to run, lowered as soon as a trial reaches the consensus or, when a
+ * probability is given, when the best inlier ratio makes more trials useless. The result is then the best trial up
+ * to this index, the first one being kept in case of equality, as in the sequential implementation.
+ */
+class ParallelRansac
+{
+public:
+  ParallelRansac(const std::vector<vpPoint> &points, unsigned int nbInlierConsensus, int maxTrials, double threshold,
+                 double probability, unsigned int seed, bool checkDegeneratePoints, vpPose::FuncCheckValidityPose func)
+    : m_points(points), m_ransacPoints(points), m_nbInlierConsensus(nbInlierConsensus), m_maxTrials(maxTrials),
+    m_threshold(threshold), m_probability(probability), m_seed(seed), m_checkDegeneratePoints(checkDegeneratePoints),
+    m_func(func), m_nextTrial(0), m_lastTrial(maxTrials)
+  { }
+
+  /*!
+   * Run the trials.
+   * \param nbThreads : Number of threads.
+   * \param nbInliers : Number of inliers of the best trial.
+   * \param consensus : Index of the inliers of the best trial.
+   * \return true if a hypothesis with inliers is found.
+   */
+  bool run(int nbThreads, unsigned int &nbInliers, std::vector<unsigned int> &consensus)
+  {
+    std::vector<std::vector<std::pair<int, unsigned int> > > results(static_cast<size_t>(nbThreads));
+    std::vector<std::thread> threadpool;
+    for (size_t i = 0; i < static_cast<size_t>(nbThreads); ++i) {
+      threadpool.emplace_back(&ParallelRansac::worker, this, &results[i]);
+    }
+    for (auto &th : threadpool) {
+      th.join();
+    }
+
+    // Best trial among the ones that the sequential order would have run
+    const int lastTrial = m_lastTrial.load();
+    int bestTrial = -1;
+    nbInliers = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+      for (size_t j = 0; j < results[i].size(); ++j) {
+        const int trial = results[i][j].first;
+        const unsigned int nb = results[i][j].second;
+        if ((trial < lastTrial) && ((nb > nbInliers) || ((nb == nbInliers) && (nb > 0) && (trial < bestTrial)))) {
+          nbInliers = nb;
+          bestTrial = trial;
+        }
+      }
+    }
+
+    consensus.clear();
+    if (bestTrial < 0) {
+      return false;
+    }
+    // Run again the best trial to get its consensus set
+    std::vector<double> errors;
+    evaluateTrial(bestTrial, errors, &consensus);
+    return true;
+  }
+
+private:
+  const std::vector<vpPoint> &m_points;
+  const RansacPoints m_ransacPoints;
+  const unsigned int m_nbInlierConsensus;
+  const int m_maxTrials;
+  const double m_threshold;
+  const double m_probability;
+  const unsigned int m_seed;
+  const bool m_checkDegeneratePoints;
+  const vpPose::FuncCheckValidityPose m_func;
+  std::atomic<int> m_nextTrial; //!< Index of the next trial to run
+  std::atomic<int> m_lastTrial; //!< The trials with an index lower than this one have to be run
+
+  /*!
+   * Lower the index of the last trial to run.
+   */
+  void updateLastTrial(int lastTrial)
+  {
+    int current = m_lastTrial.load();
+    while ((lastTrial < current) && (!m_lastTrial.compare_exchange_weak(current, lastTrial))) { }
+  }
+
+  void worker(std::vector<std::pair<int, unsigned int> > *results)
+  {
+    std::vector<double> errors;
+    const unsigned int nbMinRandom = 4;
+    for (int trial = m_nextTrial.fetch_add(1); trial < m_lastTrial.load(); trial = m_nextTrial.fetch_add(1)) {
+      const unsigned int nb = evaluateTrial(trial, errors, nullptr);
+      if (nb == 0) {
+        continue;
+      }
+      results->push_back(std::pair<int, unsigned int>(trial, nb));
+
+      if (nb >= m_nbInlierConsensus) {
+        updateLastTrial(trial + 1);
+      }
+      else if ((m_probability > 0.) && (nb >= nbMinRandom)) {
+        const double epsilon = 1. - (static_cast<double>(nb) / static_cast<double>(m_points.size()));
+        const int nbTrials = vpPose::computeRansacIterations(m_probability, epsilon, nbMinRandom, m_maxTrials);
+        updateLastTrial(std::max<int>(trial + 1, nbTrials));
+      }
+    }
+  }
+
+  /*!
+   * Compute the pose from a random minimal sample and count its inliers.
+   * \return The number of inliers, 0 if the hypothesis is rejected.
+   */
+  unsigned int evaluateTrial(int trial, std::vector<double> &errors, std::vector<unsigned int> *consensus) const
+  {
+    const unsigned int nbMinRandom = 4;
+    const int size = static_cast<int>(m_points.size());
+    vpUniRand uniRand(m_seed, static_cast<uint64_t>(trial));
+
+    // Draw the minimal sample, without picking twice the same point
+    std::vector<vpPoint> sample;
+    std::vector<int> picked;
+    while ((sample.size() < nbMinRandom) && (picked.size() < static_cast<size_t>(size))) {
+      int r = uniRand.uniform(0, size);
+      while (std::find(picked.begin(), picked.end(), r) != picked.end()) {
+        r = uniRand.uniform(0, size);
+      }
+      picked.push_back(r);
+      const vpPoint &pt = m_points[static_cast<size_t>(r)];
+
+      if ((!m_checkDegeneratePoints) ||
+          (std::find_if(sample.begin(), sample.end(), FindDegeneratePoint(pt)) == sample.end())) {
+        sample.push_back(pt);
+      }
+    }
+    if (sample.size() < nbMinRandom) {
+      return 0;
+    }
+
+    vpPose poseMin;
+    poseMin.addPoints(sample);
+
+    vpHomogeneousMatrix cMo;
+    bool is_pose_valid = false;
+    double r_min = DBL_MAX;
+    try {
+      is_pose_valid = poseMin.computePose(vpPose::DEMENTHON_LAGRANGE_VIRTUAL_VS, cMo);
+      r_min = poseMin.computeResidual(cMo);
+    }
+    catch (...) {
+      // no need to take action
+    }
+    if ((!is_pose_valid) || vpMath::isNaN(r_min)) {
+      return 0;
+    }
+
+    const double r = sqrt(r_min) / static_cast<double>(nbMinRandom);
+    if ((r >= m_threshold) || ((m_func != nullptr) && (!m_func(cMo)))) {
+      return 0;
+    }
+
+    m_ransacPoints.computeErrors(cMo, errors);
+    return selectInliers(m_points, errors, m_threshold, m_checkDegeneratePoints, consensus);
+  }
+};
+#endif
 } // namespace
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
@@ -168,19 +415,16 @@ bool vpPose::vpRansacFunctor::poseRansacImpl()
   const unsigned int nbMinRandom = 4;
   int nbTrials = 0;
 
-  vpPoint p; // Point used to project using the estimated pose
+  // Points used to compute the reprojection errors of the pose hypotheses
+  const RansacPoints ransacPoints(m_listOfUniquePoints);
+  std::vector<double> errors;
 
   bool foundSolution = false;
   while ((nbTrials < m_ransacMaxTrials) && (m_nbInliers < m_ransacNbInlierConsensus)) {
     // Hold the list of the index of the inliers (points in the consensus set)
     std::vector<unsigned int> cur_consensus;
-    // Hold the list of the index of the outliers
-    std::vector<unsigned int> cur_outliers;
     // Hold the list of the index of the points randomly picked
     std::vector<unsigned int> cur_randoms;
-    // Hold the list of the current inliers points to avoid to add a
-    // degenerate point if the flag is set
-    std::vector<vpPoint> cur_inliers;
 
     // Use a temporary variable because if not, the cMo passed in parameters
     // will be modified when
@@ -270,38 +514,9 @@ bool vpPose::vpRansacFunctor::poseRansacImpl()
         }
 
         if (isPoseValid && (r < m_ransacThreshold)) {
-          unsigned int nbInliersCur = 0;
-          unsigned int iter = 0;
-          std::vector<vpPoint>::const_iterator m_listofuniquepoints_end = m_listOfUniquePoints.end();
-          for (std::vector<vpPoint>::const_iterator it = m_listOfUniquePoints.begin(); it != m_listofuniquepoints_end;
-               ++it, ++iter) {
-            p.setWorldCoordinates(it->get_oX(), it->get_oY(), it->get_oZ());
-            p.track(m_cMo);
-
-            double error = sqrt(vpMath::sqr(p.get_x() - it->get_x()) + vpMath::sqr(p.get_y() - it->get_y()));
-            if (error < m_ransacThreshold) {
-              bool degenerate = false;
-              if (m_checkDegeneratePoints) {
-                if (std::find_if(cur_inliers.begin(), cur_inliers.end(), FindDegeneratePoint(*it)) != cur_inliers.end()) {
-                  degenerate = true;
-                }
-              }
-
-              if (!degenerate) {
-                // the point is considered as inlier if the error is below the
-                // threshold
-                ++nbInliersCur;
-                cur_consensus.push_back(iter);
-                cur_inliers.push_back(*it);
-              }
-              else {
-                cur_outliers.push_back(iter);
-              }
-            }
-            else {
-              cur_outliers.push_back(iter);
-            }
-          }
+          ransacPoints.computeErrors(m_cMo, errors);
+          unsigned int nbInliersCur =
+            selectInliers(m_listOfUniquePoints, errors, m_ransacThreshold, m_checkDegeneratePoints, &cur_consensus);
 
           if (nbInliersCur > m_nbInliers) {
             foundSolution = true;
@@ -425,47 +640,9 @@ bool vpPose::poseRansac(vpHomogeneousMatrix &cMo, FuncCheckValidityPose func)
 
   if (executeParallelVersion) {
 #if defined(VISP_HAVE_THREADS)
-    std::vector<std::thread> threadpool;
-    std::vector<vpRansacFunctor> ransacWorkers;
-
-    int splitTrials = ransacMaxTrials / nbThreads;
-    for (size_t i = 0; i < static_cast<size_t>(nbThreads); ++i) {
-      unsigned int initial_seed = static_cast<unsigned int>(i);
-      if (i < static_cast<size_t>(nbThreads) - 1) {
-        ransacWorkers.emplace_back(cMo, ransacNbInlierConsensus, splitTrials, ransacThreshold, initial_seed,
-                                   checkDegeneratePoints, listOfUniquePoints, func);
-      }
-      else {
-        int maxTrialsRemainder = ransacMaxTrials - splitTrials * (nbThreads - 1);
-        ransacWorkers.emplace_back(cMo, ransacNbInlierConsensus, maxTrialsRemainder, ransacThreshold, initial_seed,
-                                   checkDegeneratePoints, listOfUniquePoints, func);
-      }
-    }
-
-    for (auto &worker : ransacWorkers) {
-      threadpool.emplace_back(&vpRansacFunctor::operator(), &worker);
-    }
-
-    for (auto &th : threadpool) {
-      th.join();
-    }
-
-    bool successRansac = false;
-    size_t best_consensus_size = 0;
-
-    for (auto &worker : ransacWorkers) {
-      if (worker.getResult()) {
-        successRansac = true;
-
-        if (worker.getBestConsensus().size() > best_consensus_size) {
-          nbInliers = worker.getNbInliers();
-          best_consensus = worker.getBestConsensus();
-          best_consensus_size = worker.getBestConsensus().size();
-        }
-      }
-    }
-
-    foundSolution = successRansac;
+    ParallelRansac parallelRansac(listOfUniquePoints, ransacNbInlierConsensus, ransacMaxTrials, ransacThreshold,
+                                  ransacProbability, ransacSeed, checkDegeneratePoints, func);
+    foundSolution = parallelRansac.run(nbThreads, nbInliers, best_consensus);
 #endif
   }
   else {
@@ -0,0 +1,211 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2026 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Multi-images intrinsic and hand-eye calibration test on simulated data.
+ */
+
+/*!
+  \example catchCalibMulti.cpp
+  \brief Test of the multi-images calibration of the intrinsic camera parameters,
+  alone or together with the hand-eye transformation, on simulated data.
+*/
+#include <cmath>
+#include <iostream>
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <visp3/core/vpUniRand.h>
+#include <visp3/vision/vpCalibration.h>
+
+#if defined(VISP_BUILD_CATCH2)
+#include <catch_amalgamated.hpp>
+#else // Since v3.1.1
+#include <catch2/catch_all.hpp>
+#endif
+
+#if defined(ENABLE_VISP_NAMESPACE)
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+/*
+  Simulate the images of a 9x7 grid of points spaced by 3 cm, seen from poses
+  randomly drawn around the grid.
+*/
+std::vector<vpCalibration> simulateImages(unsigned int nbImages, const vpCameraParameters &cam, uint64_t seed,
+                                          std::vector<vpHomogeneousMatrix> &cMo)
+{
+  vpUniRand rng(seed);
+  std::vector<vpCalibration> table_cal(nbImages);
+  cMo.resize(nbImages);
+  for (unsigned int n = 0; n < nbImages; ++n) {
+    // Camera looking at the center of the grid, rotated around it
+    vpHomogeneousMatrix cMg(rng.uniform(-0.05, 0.05), rng.uniform(-0.05, 0.05), rng.uniform(0.5, 0.8),
+                            vpMath::rad(rng.uniform(-25., 25.)), vpMath::rad(rng.uniform(-25., 25.)),
+                            vpMath::rad(rng.uniform(-180., 180.)));
+    cMo[n] = cMg * vpHomogeneousMatrix(-0.12, -0.09, 0, 0, 0, 0);
+
+    for (unsigned int i = 0; i < 7; ++i) {
+      for (unsigned int j = 0; j < 9; ++j) {
+        vpPoint P(0.03 * j, 0.03 * i, 0);
+        P.project(cMo[n]);
+        double r2 = vpMath::sqr(P.get_x()) + vpMath::sqr(P.get_y());
+        vpImagePoint ip(cam.get_v0() + cam.get_py() * P.get_y() * (1 + cam.get_kud() * r2),
+                        cam.get_u0() + cam.get_px() * P.get_x() * (1 + cam.get_kud() * r2));
+        table_cal[n].addPoint(P.get_oX(), P.get_oY(), P.get_oZ(), ip);
+      }
+    }
+  }
+  return table_cal;
+}
+
+bool sameTransformation(const vpHomogeneousMatrix &M1, const vpHomogeneousMatrix &M2, double epsilon)
+{
+  vpHomogeneousMatrix M = M1.inverse() * M2;
+  return (M.getTranslationVector().frobeniusNorm() < epsilon) && (M.getThetaUVector().getTheta() < epsilon);
+}
+}
+
+TEST_CASE("Multi-images calibration", "[calibration]")
+{
+  const vpCameraParameters cam_gt(600, 590, 320, 240);
+  const vpCameraParameters cam_init(550, 550, 300, 250);
+
+  SECTION("Intrinsic parameters from a large set of images")
+  {
+    // More images than the former limit of the implementation
+    std::vector<vpHomogeneousMatrix> cMo_gt;
+    std::vector<vpCalibration> table_cal = simulateImages(300, cam_gt, 42, cMo_gt);
+
+    vpCameraParameters cam = cam_init;
+    double error = 0;
+    CHECK(vpCalibration::computeCalibrationMulti(vpCalibration::CALIB_VIRTUAL_VS, table_cal, cam, error) ==
+          EXIT_SUCCESS);
+    CHECK(error < 1e-4);
+    CHECK(std::fabs(cam.get_px() - cam_gt.get_px()) < 1e-4);
+    CHECK(std::fabs(cam.get_py() - cam_gt.get_py()) < 1e-4);
+    CHECK(std::fabs(cam.get_u0() - cam_gt.get_u0()) < 1e-4);
+    CHECK(std::fabs(cam.get_v0() - cam_gt.get_v0()) < 1e-4);
+    for (size_t i = 0; i < table_cal.size(); ++i) {
+      CHECK(sameTransformation(table_cal[i].cMo, cMo_gt[i], 1e-6));
+    }
+  }
+
+  SECTION("Independence on the number of threads")
+  {
+    std::vector<vpHomogeneousMatrix> cMo_gt;
+    std::vector<vpCalibration> table_cal = simulateImages(20, vpCameraParameters(600, 590, 320, 240, -0.1, 0.1), 3,
+                                                          cMo_gt);
+
+    std::vector<vpCameraParameters> cam(2, cam_init);
+    std::vector<std::vector<vpCalibration> > results(2, table_cal);
+    const int nbThreads = vpCalibration::getNbThreads();
+    for (int k = 0; k < 2; ++k) {
+      vpCalibration::setNbThreads(k + 1);
+      double error = 0;
+      CHECK(vpCalibration::computeCalibrationMulti(vpCalibration::CALIB_VIRTUAL_VS_DIST, results[k], cam[k], error) ==
+            EXIT_SUCCESS);
+    }
+    vpCalibration::setNbThreads(nbThreads);
+
+    // The contributions of the images are summed in the same order, only the
+    // rounding of the linear algebra backend may differ
+    CHECK(cam[0].get_px() == Catch::Approx(cam[1].get_px()).epsilon(1e-10));
+    CHECK(cam[0].get_py() == Catch::Approx(cam[1].get_py()).epsilon(1e-10));
+    CHECK(cam[0].get_u0() == Catch::Approx(cam[1].get_u0()).epsilon(1e-10));
+    CHECK(cam[0].get_v0() == Catch::Approx(cam[1].get_v0()).epsilon(1e-10));
+    CHECK(cam[0].get_kud() == Catch::Approx(cam[1].get_kud()).epsilon(1e-8));
+    CHECK(cam[0].get_kdu() == Catch::Approx(cam[1].get_kdu()).epsilon(1e-8));
+    CHECK(std::fabs(cam[0].get_kud() + 0.1) < 1e-2);
+    for (size_t i = 0; i < table_cal.size(); ++i) {
+      CHECK(sameTransformation(results[0][i].cMo_dist, results[1][i].cMo_dist, 1e-10));
+    }
+  }
+
+  SECTION("Intrinsic parameters and hand-eye transformation")
+  {
+    const vpHomogeneousMatrix eMc_gt(0.05, -0.03, 0.1, vpMath::rad(5), vpMath::rad(-10), vpMath::rad(90));
+    const vpHomogeneousMatrix rMo_gt(0.6, 0.1, -0.2, vpMath::rad(180), 0, vpMath::rad(20));
+
+    std::vector<vpHomogeneousMatrix> cMo_gt;
+    std::vector<vpCalibration> table_cal = simulateImages(15, cam_gt, 7, cMo_gt);
+    for (size_t i = 0; i < table_cal.size(); ++i) {
+      table_cal[i].rMe = rMo_gt * cMo_gt[i].inverse() * eMc_gt.inverse();
+    }
+
+    vpCameraParameters cam = cam_init;
+    vpHomogeneousMatrix eMc, rMo;
+    double error = 0;
+    CHECK(vpCalibration::computeCalibrationMultiHandEye(vpCalibration::CALIB_VIRTUAL_VS, table_cal, cam, eMc, rMo,
+                                                        error) == EXIT_SUCCESS);
+    CHECK(error < 1e-4);
+    CHECK(std::fabs(cam.get_px() - cam_gt.get_px()) < 1e-4);
+    CHECK(std::fabs(cam.get_py() - cam_gt.get_py()) < 1e-4);
+    CHECK(std::fabs(cam.get_u0() - cam_gt.get_u0()) < 1e-4);
+    CHECK(std::fabs(cam.get_v0() - cam_gt.get_v0()) < 1e-4);
+    CHECK(sameTransformation(eMc, eMc_gt, 1e-6));
+    CHECK(sameTransformation(rMo, rMo_gt, 1e-6));
+    for (size_t i = 0; i < table_cal.size(); ++i) {
+      CHECK(table_cal[i].eMc == eMc);
+      CHECK(sameTransformation(table_cal[i].cMo, cMo_gt[i], 1e-6));
+    }
+
+    // Robot positions perturbed by noise: the poses of the images are constrained by the robot
+    vpUniRand rng(11);
+    for (size_t i = 0; i < table_cal.size(); ++i) {
+      vpHomogeneousMatrix noise(rng.uniform(-1e-4, 1e-4), rng.uniform(-1e-4, 1e-4), rng.uniform(-1e-4, 1e-4),
+                                vpMath::rad(rng.uniform(-0.01, 0.01)), vpMath::rad(rng.uniform(-0.01, 0.01)),
+                                vpMath::rad(rng.uniform(-0.01, 0.01)));
+      table_cal[i].rMe = table_cal[i].rMe * noise;
+    }
+    cam = cam_init;
+    CHECK(vpCalibration::computeCalibrationMultiHandEye(vpCalibration::CALIB_VIRTUAL_VS, table_cal, cam, eMc, rMo,
+                                                        error) == EXIT_SUCCESS);
+    CHECK(error > 1e-2);
+    CHECK(sameTransformation(eMc, eMc_gt, 1e-3));
+    CHECK(sameTransformation(rMo, rMo_gt, 1e-3));
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  std::cout << (numFailed ? "Test failed" : "Test succeed") << std::endl;
+  return numFailed;
+}
+
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
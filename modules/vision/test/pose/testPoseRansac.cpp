@@ -119,6 +119,44 @@ int main()
     }
 
     std::cout << "Pose is " << (test_fail ? "badly" : "well") << " estimated" << std::endl;
+
+#if defined(VISP_HAVE_THREADS)
+    // The parallel version has to give the same result whatever the number of threads
+    std::vector<unsigned int> inlier_index_ref;
+    vpHomogeneousMatrix cMo_parallel_ref;
+    for (int nb_threads = 1; nb_threads <= 4; nb_threads++) {
+      vpPose pose_parallel;
+      pose_parallel.addPoints(P);
+      pose_parallel.setRansacNbInliersToReachConsensus(nbInlierToReachConsensus);
+      pose_parallel.setRansacThreshold(threshold);
+      pose_parallel.setUseParallelRansac(true);
+      pose_parallel.setNbParallelRansacThreads(nb_threads);
+      pose_parallel.setRansacSeed(42);
+
+      vpHomogeneousMatrix cMo_parallel;
+      if (!pose_parallel.computePose(vpPose::RANSAC, cMo_parallel)) {
+        std::cout << "Parallel RANSAC failed with " << nb_threads << " threads" << std::endl;
+        test_fail = 1;
+        continue;
+      }
+      vpPoseVector pose_parallel_est(cMo_parallel);
+      for (unsigned int i = 0; i < 6; i++) {
+        if (std::fabs(pose_ref[i] - pose_parallel_est[i]) > 0.001)
+          test_fail = 1;
+      }
+      if (nb_threads == 1) {
+        inlier_index_ref = pose_parallel.getRansacInlierIndex();
+        cMo_parallel_ref = cMo_parallel;
+      }
+      else if ((pose_parallel.getRansacInlierIndex() != inlier_index_ref) || (cMo_parallel != cMo_parallel_ref)) {
+        std::cout << "Parallel RANSAC with " << nb_threads << " threads differs from the single thread result"
+          << std::endl;
+        test_fail = 1;
+      }
+    }
+    std::cout << "Parallel pose is " << (test_fail ? "badly" : "well") << " estimated" << std::endl;
+#endif
+
     return (test_fail ? EXIT_FAILURE : EXIT_SUCCESS);
   }
   catch (const vpException &e) {
@@ -283,6 +283,7 @@ private:
  *
  * Computes the Discrete Cosine Transform (DCT) representation of the image.
  * Only the K first components are preserved and stored into a vector when calling map. These components correspond to the lowest frequencies of the input image.
+ * Since they lie in the top left corner of the DCT matrix, only the matching rows of the DCT bases are computed and applied.
  */
 class VISP_EXPORT vpLuminanceDCT : public vpLuminanceMapping
 {
@@ -321,6 +322,15 @@ public:
      */
     void setValues(const vpColVector &s, unsigned int start, vpMatrix &m) const;
 
+    /**
+     * \brief Compute the size of the top left submatrix that contains the first values of the zigzag indexing
+     *
+     * @param end The number of values (exclusive end index, as in getValues)
+     * @param rows The number of rows of the submatrix
+     * @param cols The number of cols of the submatrix
+     */
+    void getSubMatrixSize(unsigned int end, unsigned int &rows, unsigned int &cols) const;
+
   private:
     std::vector<unsigned> m_rowIndex; // Contains the row index of the nth value of the zigzag indexing
     std::vector<unsigned> m_colIndex; // Contains the row index of the nth value of the zigzag indexing
@@ -360,14 +370,14 @@ public:
   void interaction(const vpImage<unsigned char> &I, const vpMatrix &LI, const vpColVector &s, vpMatrix &L) VP_OVERRIDE;
 
 private:
-  void computeDCTMatrix(vpMatrix &D, unsigned int n) const;
+  void computeDCTMatrix(vpMatrix &D, unsigned int n, unsigned int nbFrequencies) const;
   void computeDCTMatrices(unsigned int rows, unsigned int cols);
 
 protected:
   unsigned int m_Ih, m_Iw; //! image dimensions (without borders)
   vpMatrix m_Imat; //! Image as a matrix
   vpMatrix m_dct; //! DCT representation of the image
-  vpMatrix m_Dcols, m_Drows; //! the computed DCT matrices. The separable property of DCt is used so that a 1D DCT is computed on rows and another on columns of the result of the first dct;
+  vpMatrix m_Dcols, m_Drows; //! the computed DCT matrices. The separable property of DCt is used so that a 1D DCT is computed on rows and another on columns of the result of the first dct. Only the lowest frequencies that contribute to the K first components are kept;
   std::array<vpMatrix, 6> m_dIdrPlanes; //! Luminance interaction matrix, seen as six image planes
   vpLuminanceDCT::vpMatrixZigZagIndex m_zigzag; //! zigzag indexing helper
 };
@@ -421,6 +421,20 @@ void vpLuminanceDCT::vpMatrixZigZagIndex::setValues(const vpColVector &s, unsign
   }
 }
 
+void vpLuminanceDCT::vpMatrixZigZagIndex::getSubMatrixSize(unsigned int end, unsigned int &rows, unsigned int &cols) const
+{
+  if (end > m_rowIndex.size()) {
+    throw vpException(vpException::dimensionError, "End index exceeds matrix size");
+  }
+
+  rows = 0;
+  cols = 0;
+  for (unsigned index = 0; index < end; ++index) {
+    rows = std::max(rows, m_rowIndex[index] + 1);
+    cols = std::max(cols, m_colIndex[index] + 1);
+  }
+}
+
 // vpLuminanceDCT
 
 vpLuminanceDCT::vpLuminanceDCT(const vpLuminanceDCT &other) : vpLuminanceMapping(other.getProjectionSize())
@@ -430,25 +444,30 @@ vpLuminanceDCT::vpLuminanceDCT(const vpLuminanceDCT &other) : vpLuminanceMapping
 
 void vpLuminanceDCT::map(const vpImage<unsigned char> &I, vpColVector &s)
 {
-  m_Ih = I.getHeight() - 2 * m_border;
-  m_Iw = I.getWidth() - 2 * m_border;
-  if (m_Imat.getCols() != m_Ih || m_Imat.getRows() != m_Iw) {
+  const unsigned int h = I.getHeight() - 2 * m_border;
+  const unsigned int w = I.getWidth() - 2 * m_border;
+  if (h != m_Ih || w != m_Iw) {
+    m_Ih = h;
+    m_Iw = w;
     computeDCTMatrices(m_Ih, m_Iw);
-    m_zigzag.init(m_Ih, m_Iw);
   }
   imageAsMatrix(I, m_Imat, m_border);
-  m_dct = m_Dcols * m_Imat * m_Drows;
+  // Only the top left block of the DCT is computed, the rest of m_dct stays null
+  m_dct.insert(m_Dcols * m_Imat * m_Drows, 0, 0);
   m_zigzag.getValues(m_dct, 0, m_mappingSize, s);
 }
 
-void vpLuminanceDCT::computeDCTMatrix(vpMatrix &D, unsigned int n) const
+void vpLuminanceDCT::computeDCTMatrix(vpMatrix &D, unsigned int n, unsigned int nbFrequencies) const
 {
-  D.resize(n, n, false, false);
+  D.resize(nbFrequencies, n, false, false);
+  if (nbFrequencies == 0) {
+    return;
+  }
   for (unsigned i = 0; i < n; i++) {
     D[0][i] = 1.0 / sqrt(n);
   }
   double alpha = sqrt(2./(n));
-  for (unsigned int i = 1; i < n; i++) {
+  for (unsigned int i = 1; i < nbFrequencies; i++) {
     for (unsigned int j = 0; j < n; j++) {
       D[i][j] = alpha*cos((2 * j + 1) * i * M_PI / (2.0 * n));
     }
@@ -457,16 +476,21 @@ void vpLuminanceDCT::computeDCTMatrix(vpMatrix &D, unsigned int n) const
 
 void vpLuminanceDCT::computeDCTMatrices(unsigned int rows, unsigned int cols)
 {
-  computeDCTMatrix(m_Dcols, rows);
-  computeDCTMatrix(m_Drows, cols);
+  m_zigzag.init(rows, cols);
+  unsigned int dctRows, dctCols;
+  m_zigzag.getSubMatrixSize(m_mappingSize, dctRows, dctCols);
+  computeDCTMatrix(m_Dcols, rows, dctRows);
+  computeDCTMatrix(m_Drows, cols, dctCols);
   m_Drows = m_Drows.transpose();
+  m_dct.resize(rows, cols, true, false);
 }
 
 void vpLuminanceDCT::inverse(const vpColVector &s, vpImage<unsigned char> &I)
 {
   vpMatrix dctCut(m_dct.getRows(), m_dct.getCols(), 0.0);
   m_zigzag.setValues(s, 0, dctCut);
-  const vpMatrix Ir = m_Dcols.t() * dctCut * m_Drows.t();
+  const vpMatrix dctLow = dctCut.extract(0, 0, m_Dcols.getRows(), m_Drows.getCols());
+  const vpMatrix Ir = (m_Dcols.t() * dctLow) * m_Drows.t();
   I.resize(Ir.getRows(), Ir.getCols());
   for (unsigned int i = 0; i < I.getRows(); ++i) {
     for (unsigned int j = 0; j < I.getCols(); ++j) {
@@ -484,10 +508,10 @@ void vpLuminanceDCT::interaction(const vpImage<unsigned char> &, const vpMatrix
   }
 
   L.resize(m_mappingSize, 6, false, false);
-  vpMatrix dTddof(m_Ih, m_Iw);
+  vpMatrix dTddof(m_Ih, m_Iw, 0.0);
   vpColVector column;
   for (unsigned int dof = 0; dof < 6; ++dof) {
-    dTddof = m_Dcols * m_dIdrPlanes[dof] * m_Drows;
+    dTddof.insert(m_Dcols * m_dIdrPlanes[dof] * m_Drows, 0, 0);
     m_zigzag.getValues(dTddof, 0, m_mappingSize, column);
     for (unsigned int row = 0; row < L.getRows(); ++row) {
       L[row][dof] = column[row];
@@ -411,6 +411,15 @@ SCENARIO("Using DCT features", "[visual_features]")
         zigzag.getValues(m2, 0, 3, s2);
         REQUIRE(s2 == contentAsZigzag.extract(0, 3));
       }
+      THEN("Calling getSubMatrixSize returns the block that contains the first values")
+      {
+        unsigned int rows, cols;
+        zigzag.getSubMatrixSize(4, rows, cols);
+        REQUIRE((rows == 3 && cols == 2));
+        zigzag.getSubMatrixSize(m.size(), rows, cols);
+        REQUIRE((rows == m.getRows() && cols == m.getCols()));
+        REQUIRE_THROWS(zigzag.getSubMatrixSize(m.size() + 1, rows, cols));
+      }
     }
 
 
@@ -444,6 +453,88 @@ SCENARIO("Using DCT features", "[visual_features]")
         }
       }
     }
+
+    GIVEN("A random image")
+    {
+      const unsigned int h = 24, w = 40, k = 20;
+      vpImage<unsigned char> I(h, w);
+      vpUniRand rand(17);
+      for (unsigned int i = 0; i < I.getSize(); ++i) {
+        I.bitmap[i] = static_cast<unsigned char>(rand.uniform(0, 256));
+      }
+      // Full DCT-II matrices as reference
+      auto dctMatrix = [](unsigned int n) {
+        vpMatrix D(n, n);
+        for (unsigned int i = 0; i < n; ++i) {
+          for (unsigned int j = 0; j < n; ++j) {
+            D[i][j] = (i == 0 ? sqrt(1.0 / n) : sqrt(2.0 / n)) * cos((2 * j + 1) * i * M_PI / (2.0 * n));
+          }
+        }
+        return D;
+      };
+      const vpMatrix Dh = dctMatrix(h), Dw = dctMatrix(w);
+      vpLuminanceDCT::vpMatrixZigZagIndex zigzag;
+      zigzag.init(h, w);
+
+      WHEN("Computing DCT")
+      {
+        vpLuminanceDCT dct(k);
+        dct.setBorder(0);
+        vpColVector s;
+        dct.map(I, s);
+        THEN("The components are those of the full DCT")
+        {
+          vpMatrix Imat(h, w);
+          for (unsigned int i = 0; i < h; ++i) {
+            for (unsigned int j = 0; j < w; ++j) {
+              Imat[i][j] = I[i][j];
+            }
+          }
+          vpColVector sRef;
+          zigzag.getValues(Dh * Imat * Dw.t(), 0, k, sRef);
+          REQUIRE(s.size() == k);
+          for (unsigned int i = 0; i < k; ++i) {
+            REQUIRE(s[i] == Catch::Approx(sRef[i]).margin(1e-9));
+          }
+        }
+        THEN("The inverse is the one of the full DCT")
+        {
+          vpMatrix dctCut(h, w, 0.0);
+          zigzag.setValues(s, 0, dctCut);
+          const vpMatrix IrRef = Dh.t() * dctCut * Dw;
+          vpImage<unsigned char> Ir;
+          dct.inverse(s, Ir);
+          REQUIRE((Ir.getRows() == h && Ir.getCols() == w));
+          for (unsigned int i = 0; i < h; ++i) {
+            for (unsigned int j = 0; j < w; ++j) {
+              const double ref = std::max(0.0, std::min(IrRef[i][j], 255.0));
+              REQUIRE(std::abs(Ir[i][j] - ref) <= 1.0);
+            }
+          }
+        }
+        THEN("The interaction matrix is the projection of the luminance one")
+        {
+          vpMatrix LI(h * w, 6);
+          for (unsigned int i = 0; i < LI.size(); ++i) {
+            LI.data[i] = rand.uniform(-1.0, 1.0);
+          }
+          vpMatrix L;
+          dct.interaction(I, LI, s, L);
+          REQUIRE((L.getRows() == k && L.getCols() == 6));
+          for (unsigned int dof = 0; dof < 6; ++dof) {
+            vpMatrix plane(h, w);
+            for (unsigned int i = 0; i < h * w; ++i) {
+              plane.data[i] = LI[i][dof];
+            }
+            vpColVector column;
+            zigzag.getValues(Dh * plane * Dw.t(), 0, k, column);
+            for (unsigned int i = 0; i < k; ++i) {
+              REQUIRE(L[i][dof] == Catch::Approx(column[i]).margin(1e-9));
+            }
+          }
+        }
+      }
+    }
   }
 }
 #endif